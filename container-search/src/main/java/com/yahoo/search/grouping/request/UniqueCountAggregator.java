@@ -0,0 +1,29 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+package com.yahoo.search.grouping.request;
+
+/**
+ * This class represents a uniquecount-aggregator in a {@link GroupingExpression}. It evaluates to the estimated number
+ * of unique values that the contained expression evaluated to over all the inputs. The estimate is made using the
+ * HyperLogLog algorithm, and counts each element of multi-value expressions.
+ */
+public class UniqueCountAggregator extends AggregatorNode {
+
+    /**
+     * Constructs a new instance of this class.
+     *
+     * @param expression the expression to aggregate on.
+     */
+    public UniqueCountAggregator(GroupingExpression expression) {
+        this(null, null, expression);
+    }
+
+    private UniqueCountAggregator(String label, Integer level, GroupingExpression expression) {
+        super("uniquecount", label, level, expression);
+    }
+
+    @Override
+    public UniqueCountAggregator copy() {
+        return new UniqueCountAggregator(getLabel(), getLevelOrNull(), getExpression().copy());
+    }
+
+}
@@ -81,6 +81,7 @@ import com.yahoo.search.grouping.request.ToLongFunction;
 import com.yahoo.search.grouping.request.ToRawFunction;
 import com.yahoo.search.grouping.request.ToStringFunction;
 import com.yahoo.search.grouping.request.UcaFunction;
+import com.yahoo.search.grouping.request.UniqueCountAggregator;
 import com.yahoo.search.grouping.request.XorAggregator;
 import com.yahoo.search.grouping.request.XorBitFunction;
 import com.yahoo.search.grouping.request.XorFunction;
@@ -96,6 +97,7 @@ import com.yahoo.searchlib.aggregation.MaxAggregationResult;
 import com.yahoo.searchlib.aggregation.MinAggregationResult;
 import com.yahoo.searchlib.aggregation.StandardDeviationAggregationResult;
 import com.yahoo.searchlib.aggregation.SumAggregationResult;
+import com.yahoo.searchlib.aggregation.UniqueCountAggregationResult;
 import com.yahoo.searchlib.aggregation.XorAggregationResult;
 import com.yahoo.searchlib.expression.AddFunctionNode;
 import com.yahoo.searchlib.expression.AggregationRefNode;
@@ -239,6 +241,10 @@ class ExpressionConverter {
             return new StandardDeviationAggregationResult()
                     .setExpression(toExpressionNode(((StandardDeviationAggregator) exp).getExpression()));
         }
+        if (exp instanceof UniqueCountAggregator) {
+            return new UniqueCountAggregationResult()
+                    .setExpression(toExpressionNode(((UniqueCountAggregator) exp).getExpression()));
+        }
         if (exp instanceof XorAggregator) {
             return new XorAggregationResult()
                     .setExpression(toExpressionNode(((XorAggregator)exp).getExpression()));
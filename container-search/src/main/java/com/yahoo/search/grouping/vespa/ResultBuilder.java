@@ -30,6 +30,7 @@ import com.yahoo.searchlib.aggregation.MaxAggregationResult;
 import com.yahoo.searchlib.aggregation.MinAggregationResult;
 import com.yahoo.searchlib.aggregation.StandardDeviationAggregationResult;
 import com.yahoo.searchlib.aggregation.SumAggregationResult;
+import com.yahoo.searchlib.aggregation.UniqueCountAggregationResult;
 import com.yahoo.searchlib.aggregation.XorAggregationResult;
 import com.yahoo.searchlib.expression.BoolResultNode;
 import com.yahoo.searchlib.expression.ExpressionNode;
@@ -261,6 +262,8 @@ class ResultBuilder {
                 return ((SumAggregationResult) execResult).getSum().getValue();
             } else if (execResult instanceof StandardDeviationAggregationResult) {
                 return ((StandardDeviationAggregationResult) execResult).getStandardDeviation();
+            } else if (execResult instanceof UniqueCountAggregationResult) {
+                return ((UniqueCountAggregationResult) execResult).getEstimatedUniqueCount();
             } else if (execResult instanceof XorAggregationResult) {
                 return ((XorAggregationResult)execResult).getXor();
             } else {
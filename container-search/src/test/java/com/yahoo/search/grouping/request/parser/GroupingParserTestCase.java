@@ -146,6 +146,7 @@ public class GroupingParserTestCase {
                                             "true",
                                             "false",
                                             "uca",
+                                            "uniquecount",
                                             "where",
                                             "x",
                                             "xor",
@@ -580,6 +581,7 @@ public class GroupingParserTestCase {
         assertIllegalArgument("all(group(debugwait(artist, 3.3, lol)))",
                               "Encountered \" <IDENTIFIER> \"lol\"\" at line 1, column 34");
         assertParse("all(group(artist) each(output(stddev(simple))))");
+        assertParse("all(group(artist) each(output(uniquecount(album))))");
 
         // Test max()
         assertTrue(assertParse("all(group(artist) max(inf))").get(0).hasUnlimitedMax());
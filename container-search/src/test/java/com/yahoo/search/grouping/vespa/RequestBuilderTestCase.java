@@ -53,6 +53,7 @@ public class RequestBuilderTestCase {
        assertLayout("all(group(a) each(each(output(summary()))))", "[[{ Attribute, result = [Hits] }]]");
        assertLayout("all(group(a) each(output(xor(b))))", "[[{ Attribute, result = [Xor] }]]");
        assertLayout("all(group(a) each(output(stddev(b))))", "[[{ Attribute, result = [StandardDeviation] }]]");
+       assertLayout("all(group(a) each(output(uniquecount(b))))", "[[{ Attribute, result = [UniqueCount] }]]");
     }
 
     @Test
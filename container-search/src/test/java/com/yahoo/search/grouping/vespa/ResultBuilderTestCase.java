@@ -58,6 +58,7 @@ public class ResultBuilderTestCase {
         assertResult("69", new SumAggregationResult(new IntegerResultNode(69)));
         assertResult("69", new XorAggregationResult(69));
         assertResult("69", new ExpressionCountAggregationResult(new SparseSketch(), sketch -> 69));
+        assertResult("69", new UniqueCountAggregationResult(new SparseSketch(), sketch -> 69));
     }
 
     @Test
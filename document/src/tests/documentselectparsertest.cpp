@@ -26,6 +26,7 @@
 #include <vespa/document/select/invalidconstant.h>
 #include <vespa/document/select/doctype.h>
 #include <vespa/document/select/compare.h>
+#include <vespa/document/select/compiled_selection.h>
 #include <vespa/document/select/operator.h>
 #include <vespa/document/select/parse_utils.h>
 #include <vespa/document/select/parser_limits.h>
@@ -509,6 +510,11 @@ DocumentSelectParserTest::doParse(vespalib::stringref expr,
     EXPECT_EQ(result, clonedResult) << expr;
     EXPECT_EQ(result, tracedResult) << oss.str();
 
+    if constexpr (std::is_same_v<ContainsType, Document>) {
+        select::CompiledSelection compiled(*root, t.getType());
+        EXPECT_EQ(result.combineResults(), compiled.contains(t)) << expr;
+    }
+
     return result;
 }
 
@@ -1017,6 +1023,22 @@ namespace {
 
 }
 
+TEST_F(DocumentSelectParserTest, single_valued_selections_are_compiled)
+{
+    createDocs();
+    const DocumentType& type = _doc[0]->getType();
+    auto is_compiled = [&](vespalib::stringref expr) {
+        std::unique_ptr<select::Node> root(_parser->parse(expr));
+        return select::CompiledSelection(*root, type).is_compiled();
+    };
+    EXPECT_TRUE(is_compiled("testdoctype1"));
+    EXPECT_TRUE(is_compiled("testdoctype1.headerval < 100 and id.namespace == \"myspace\""));
+    EXPECT_TRUE(is_compiled("not (testdoctype1.hstringval == null or testdoctype2.headerval > 3)"));
+    EXPECT_TRUE(is_compiled("id.bucket == 0x4000000000000258 or testdoctype1.content = \"b*\""));
+    EXPECT_FALSE(is_compiled("testdoctype1.structarray[1].key == 16"));
+    EXPECT_FALSE(is_compiled("testdoctype1.structarray[$x].key == 15"));
+}
+
 TEST_F(DocumentSelectParserTest, testVisitor)
 {
     createDocs();
@@ -0,0 +1,645 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "compiled_selection.h"
+#include "branch.h"
+#include "compare.h"
+#include "constant.h"
+#include "doctype.h"
+#include "invalidconstant.h"
+#include "operator.h"
+#include "valuenodes.h"
+#include "visitor.h"
+#include <vespa/document/bucket/bucketid.h>
+#include <vespa/document/bucket/bucketidfactory.h>
+#include <vespa/document/datatype/documenttype.h>
+#include <vespa/document/fieldvalue/boolfieldvalue.h>
+#include <vespa/document/fieldvalue/bytefieldvalue.h>
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/fieldvalue/doublefieldvalue.h>
+#include <vespa/document/fieldvalue/floatfieldvalue.h>
+#include <vespa/document/fieldvalue/intfieldvalue.h>
+#include <vespa/document/fieldvalue/longfieldvalue.h>
+#include <vespa/document/fieldvalue/stringfieldvalue.h>
+#include <array>
+#include <cassert>
+
+namespace document::select {
+
+using Instruction = CompiledSelection::Instruction;
+using Opcode = CompiledSelection::Opcode;
+using Operand = CompiledSelection::Operand;
+using Comparison = CompiledSelection::Comparison;
+using CompareOp = CompiledSelection::CompareOp;
+
+namespace {
+
+// Same encoding as Result::toEnum()
+constexpr uint32_t result_invalid = 0u;
+constexpr uint32_t result_false = 1u;
+constexpr uint32_t result_true = 2u;
+
+constexpr uint8_t and_table[3][3] = {
+    { result_invalid, result_false, result_invalid },
+    { result_false,   result_false, result_false },
+    { result_invalid, result_false, result_true }
+};
+
+constexpr uint8_t or_table[3][3] = {
+    { result_invalid, result_invalid, result_true },
+    { result_invalid, result_false,   result_true },
+    { result_true,    result_true,    result_true }
+};
+
+constexpr uint8_t not_table[3] = { result_invalid, result_true, result_false };
+
+uint32_t get_result(bool value) { return value ? result_true : result_false; }
+
+bool documentTypeEqualsName(const DocumentType& type, vespalib::stringref name)
+{
+    if (type.getName() == name) return true;
+    for (const DocumentType* inherited : type.getInheritedTypes()) {
+        if (documentTypeEqualsName(*inherited, name)) return true;
+    }
+    return false;
+}
+
+bool looks_like_complex_field_path(const vespalib::string& expr) {
+    for (const char c : expr) {
+        switch (c) {
+        case '.':
+        case '[':
+        case '{':
+            return true;
+        default: continue;
+        }
+    }
+    return false;
+}
+
+/*
+ * Value of one side of a lowered comparison, with the same semantics
+ * as the corresponding select::Value.
+ */
+struct Scalar {
+    enum class Type : uint8_t { INVALID, NULL_VALUE, STRING, INTEGER, FLOAT, BUCKET };
+    Type                type;
+    int64_t             int_value;
+    double              float_value;
+    vespalib::stringref string_value;
+    Scalar() noexcept : type(Type::INVALID), int_value(0), float_value(0.0), string_value() {}
+    explicit Scalar(Type type_in) noexcept : Scalar() { type = type_in; }
+    static Scalar make_int(int64_t value, Type type = Type::INTEGER) noexcept {
+        Scalar result(type);
+        result.int_value = value;
+        return result;
+    }
+    static Scalar make_float(double value) noexcept {
+        Scalar result(Type::FLOAT);
+        result.float_value = value;
+        return result;
+    }
+    static Scalar make_string(vespalib::stringref value) noexcept {
+        Scalar result(Type::STRING);
+        result.string_value = value;
+        return result;
+    }
+    bool is_number() const noexcept { return (type == Type::INTEGER) || (type == Type::FLOAT); }
+};
+
+template <typename Cmp>
+bool compare_numbers(const Scalar& lhs, const Scalar& rhs, Cmp cmp) {
+    if (lhs.type == Scalar::Type::INTEGER) {
+        return (rhs.type == Scalar::Type::INTEGER) ? cmp(lhs.int_value, rhs.int_value) : cmp(lhs.int_value, rhs.float_value);
+    }
+    return (rhs.type == Scalar::Type::INTEGER) ? cmp(lhs.float_value, rhs.int_value) : cmp(lhs.float_value, rhs.float_value);
+}
+
+uint32_t equals(const Scalar& lhs, const Scalar& rhs) {
+    switch (lhs.type) {
+    case Scalar::Type::NULL_VALUE:
+        if (rhs.type == Scalar::Type::NULL_VALUE) {
+            return result_true;
+        }
+        return (rhs.type == Scalar::Type::INVALID) ? result_invalid : result_false;
+    case Scalar::Type::STRING:
+        if (rhs.type == Scalar::Type::STRING) {
+            return get_result(lhs.string_value == rhs.string_value);
+        }
+        return (rhs.type == Scalar::Type::NULL_VALUE) ? result_false : result_invalid;
+    case Scalar::Type::INTEGER:
+    case Scalar::Type::FLOAT:
+        if (rhs.is_number()) {
+            return get_result(compare_numbers(lhs, rhs, [](auto a, auto b) { return a == b; }));
+        }
+        return (rhs.type == Scalar::Type::NULL_VALUE) ? result_false : result_invalid;
+    default:
+        return result_invalid;
+    }
+}
+
+uint32_t less_than(const Scalar& lhs, const Scalar& rhs) {
+    switch (lhs.type) {
+    case Scalar::Type::STRING:
+        if (rhs.type == Scalar::Type::STRING) {
+            return get_result(lhs.string_value < rhs.string_value);
+        }
+        return result_invalid;
+    case Scalar::Type::INTEGER:
+    case Scalar::Type::FLOAT:
+        if (rhs.is_number()) {
+            return get_result(compare_numbers(lhs, rhs, [](auto a, auto b) { return a < b; }));
+        }
+        return result_invalid;
+    default:
+        return result_invalid;
+    }
+}
+
+uint32_t compare_scalars(CompareOp op, const Scalar& lhs, const Scalar& rhs) {
+    if ((lhs.type == Scalar::Type::BUCKET) || (rhs.type == Scalar::Type::BUCKET)) {
+        // Same as Compare: check if the bucket is contained in the given super bucket
+        const Scalar& bucket_value = (lhs.type == Scalar::Type::BUCKET) ? lhs : rhs;
+        const Scalar& number_value = (lhs.type == Scalar::Type::BUCKET) ? rhs : lhs;
+        if ((number_value.type == Scalar::Type::INTEGER) && ((op == CompareOp::EQ) || (op == CompareOp::NE))) {
+            BucketId bucket(bucket_value.int_value);
+            BucketId super_bucket(number_value.int_value);
+            bool contained = super_bucket.contains(bucket);
+            return get_result((op == CompareOp::NE) ? !contained : contained);
+        }
+        return result_invalid;
+    }
+    // Null values only support equality, other defaults are from select::Value
+    switch (op) {
+    case CompareOp::EQ:
+        return equals(lhs, rhs);
+    case CompareOp::NE:
+        return not_table[equals(lhs, rhs)];
+    case CompareOp::LT:
+        return less_than(lhs, rhs);
+    case CompareOp::GT:
+        if (lhs.type == Scalar::Type::NULL_VALUE) {
+            return result_invalid;
+        }
+        return and_table[not_table[less_than(lhs, rhs)]][not_table[equals(lhs, rhs)]];
+    case CompareOp::GE:
+        if (lhs.type == Scalar::Type::NULL_VALUE) {
+            return result_invalid;
+        }
+        return not_table[less_than(lhs, rhs)];
+    case CompareOp::LE:
+        if (lhs.type == Scalar::Type::NULL_VALUE) {
+            return result_invalid;
+        }
+        return or_table[less_than(lhs, rhs)][equals(lhs, rhs)];
+    }
+    return result_invalid;
+}
+
+Scalar
+load_field(const Field& field, const Document& doc, StringFieldValue& string_backing)
+{
+    switch (field.getDataType().getId()) {
+    case DataType::T_INT: {
+        IntFieldValue value;
+        return doc.getValue(field, value) ? Scalar::make_int(value.getAsInt()) : Scalar(Scalar::Type::NULL_VALUE);
+    }
+    case DataType::T_LONG: {
+        LongFieldValue value;
+        return doc.getValue(field, value) ? Scalar::make_int(value.getAsLong()) : Scalar(Scalar::Type::NULL_VALUE);
+    }
+    case DataType::T_BYTE: {
+        ByteFieldValue value;
+        return doc.getValue(field, value) ? Scalar::make_int(value.getAsByte()) : Scalar(Scalar::Type::NULL_VALUE);
+    }
+    case DataType::T_BOOL: {
+        BoolFieldValue value;
+        return doc.getValue(field, value) ? Scalar::make_int(value.getAsInt()) : Scalar(Scalar::Type::NULL_VALUE);
+    }
+    case DataType::T_FLOAT: {
+        FloatFieldValue value;
+        return doc.getValue(field, value) ? Scalar::make_float(value.getAsFloat()) : Scalar(Scalar::Type::NULL_VALUE);
+    }
+    case DataType::T_DOUBLE: {
+        DoubleFieldValue value;
+        return doc.getValue(field, value) ? Scalar::make_float(value.getAsDouble()) : Scalar(Scalar::Type::NULL_VALUE);
+    }
+    case DataType::T_STRING:
+        return doc.getValue(field, string_backing) ? Scalar::make_string(string_backing.getValueRef()) : Scalar(Scalar::Type::NULL_VALUE);
+    default:
+        return Scalar();
+    }
+}
+
+// Document is only used for operands that are not constant
+Scalar
+load(const Operand& operand, const Document* doc, const BucketIdFactory* bucket_id_factory, StringFieldValue& string_backing)
+{
+    switch (operand.kind) {
+    case Operand::Kind::INVALID:
+        return Scalar();
+    case Operand::Kind::NULL_VALUE:
+        return Scalar(Scalar::Type::NULL_VALUE);
+    case Operand::Kind::STRING:
+        return Scalar::make_string(operand.string_value);
+    case Operand::Kind::INTEGER:
+        return Scalar::make_int(operand.int_value);
+    case Operand::Kind::FLOAT:
+        return Scalar::make_float(operand.float_value);
+    case Operand::Kind::ID_NAMESPACE:
+        return Scalar::make_string(doc->getId().getScheme().getNamespace());
+    case Operand::Kind::ID_TYPE: {
+        const IdString& id = doc->getId().getScheme();
+        return id.hasDocType() ? Scalar::make_string(id.getDocType()) : Scalar();
+    }
+    case Operand::Kind::ID_SPECIFIC:
+        return Scalar::make_string(doc->getId().getScheme().getNamespaceSpecific());
+    case Operand::Kind::ID_ALL:
+        return Scalar::make_string(doc->getId().getScheme().toString());
+    case Operand::Kind::ID_GROUP: {
+        const IdString& id = doc->getId().getScheme();
+        return id.hasGroup() ? Scalar::make_string(id.getGroup()) : Scalar();
+    }
+    case Operand::Kind::ID_USER: {
+        const IdString& id = doc->getId().getScheme();
+        return id.hasNumber() ? Scalar::make_int(id.getNumber()) : Scalar();
+    }
+    case Operand::Kind::ID_BUCKET:
+        return Scalar::make_int(bucket_id_factory->getBucketId(doc->getId()).getId(), Scalar::Type::BUCKET);
+    case Operand::Kind::FIELD:
+        return load_field(*operand.field, *doc, string_backing);
+    }
+    return Scalar();
+}
+
+/*
+ * Lowers a selection tree for a given document type. Code for each
+ * branch is generated separately, such that the operands of and/or
+ * branches can be reordered before being concatenated.
+ */
+class Compiler : public Visitor
+{
+public:
+    struct Code {
+        std::vector<Instruction> program;
+        uint32_t                 stack_depth;
+        bool                     uses_fields;
+        Code() noexcept : program(), stack_depth(0), uses_fields(false) {}
+    };
+private:
+    const DocumentType&         _doc_type;
+    std::vector<Comparison>&    _comparisons;
+    std::vector<const Node *>&  _nodes;
+    Code                        _code;
+    bool                        _valid;
+    // State for last visited value node
+    Operand                     _operand;
+    bool                        _scalar;      // produces a single value (no variables or collections)
+    bool                        _lowered;     // value is described by _operand
+    bool                        _uses_fields;
+
+    Code compile_child(const Node& node) {
+        node.visit(*this);
+        return std::move(_code);
+    }
+    void visit_value(const ValueNode& node, Operand& operand, bool& scalar, bool& lowered, bool& uses_fields) {
+        _operand = Operand();
+        _scalar = true;
+        _lowered = false;
+        _uses_fields = false;
+        node.visit(*this);
+        operand = std::move(_operand);
+        scalar = _scalar;
+        lowered = _lowered;
+        uses_fields = _uses_fields;
+    }
+    void set_code(Opcode op, uint32_t arg, bool uses_fields) {
+        _code = Code();
+        _code.program.emplace_back(op, arg);
+        _code.stack_depth = 1;
+        _code.uses_fields = uses_fields;
+    }
+    void set_operand(Operand::Kind kind) {
+        _operand.kind = kind;
+        _lowered = true;
+    }
+    void compile_branch(const Node& left, const Node& right, Opcode jump_op, Opcode op);
+    void visit_children(const ValueNode& left, const ValueNode* right);
+
+public:
+    Compiler(const DocumentType& doc_type, std::vector<Comparison>& comparisons, std::vector<const Node *>& nodes);
+    ~Compiler() override;
+
+    bool valid() const noexcept { return _valid && (_code.stack_depth <= CompiledSelection::max_stack_depth); }
+    std::vector<Instruction> steal_program() { return std::move(_code.program); }
+
+    void visitAndBranch(const And& expr) override { compile_branch(expr.getLeft(), expr.getRight(), Opcode::JUMP_IF_FALSE, Opcode::AND); }
+    void visitOrBranch(const Or& expr) override { compile_branch(expr.getLeft(), expr.getRight(), Opcode::JUMP_IF_TRUE, Opcode::OR); }
+    void visitNotBranch(const Not& expr) override;
+    void visitComparison(const Compare& expr) override;
+    void visitConstant(const Constant& expr) override { set_code(Opcode::RESULT, get_result(expr.getConstantValue()), false); }
+    void visitInvalidConstant(const InvalidConstant&) override { set_code(Opcode::RESULT, result_invalid, false); }
+    void visitDocumentType(const DocType& expr) override;
+    void visitArithmeticValueNode(const ArithmeticValueNode& expr) override { visit_children(expr.getLeft(), &expr.getRight()); }
+    void visitFunctionValueNode(const FunctionValueNode& expr) override { visit_children(expr.getChild(), nullptr); }
+    void visitIdValueNode(const IdValueNode& expr) override;
+    void visitFieldValueNode(const FieldValueNode& expr) override;
+    void visitFloatValueNode(const FloatValueNode& expr) override {
+        _operand.float_value = expr.getValue();
+        set_operand(Operand::Kind::FLOAT);
+    }
+    void visitVariableValueNode(const VariableValueNode&) override { _scalar = false; }
+    void visitIntegerValueNode(const IntegerValueNode& expr) override {
+        _operand.int_value = expr.getValue();
+        set_operand(Operand::Kind::INTEGER);
+    }
+    void visitBoolValueNode(const BoolValueNode& expr) override { visitIntegerValueNode(expr); }
+    void visitCurrentTimeValueNode(const CurrentTimeValueNode&) override { }
+    void visitStringValueNode(const StringValueNode& expr) override {
+        _operand.string_value = expr.getValue();
+        set_operand(Operand::Kind::STRING);
+    }
+    void visitNullValueNode(const NullValueNode&) override { set_operand(Operand::Kind::NULL_VALUE); }
+    void visitInvalidValueNode(const InvalidValueNode&) override { set_operand(Operand::Kind::INVALID); }
+};
+
+Compiler::Compiler(const DocumentType& doc_type, std::vector<Comparison>& comparisons, std::vector<const Node *>& nodes)
+    : Visitor(),
+      _doc_type(doc_type),
+      _comparisons(comparisons),
+      _nodes(nodes),
+      _code(),
+      _valid(true),
+      _operand(),
+      _scalar(true),
+      _lowered(false),
+      _uses_fields(false)
+{
+}
+
+Compiler::~Compiler() = default;
+
+void
+Compiler::compile_branch(const Node& left, const Node& right, Opcode jump_op, Opcode op)
+{
+    Code first = compile_child(left);
+    Code second = compile_child(right);
+    if (first.uses_fields && !second.uses_fields) {
+        // and/or are commutative, evaluate operand not needing document fields first
+        std::swap(first, second);
+    }
+    _code = std::move(first);
+    _code.program.emplace_back(jump_op, second.program.size() + 1);
+    _code.program.insert(_code.program.end(), second.program.begin(), second.program.end());
+    _code.program.emplace_back(op, 0u);
+    _code.stack_depth = std::max(_code.stack_depth, second.stack_depth + 1);
+    _code.uses_fields = _code.uses_fields || second.uses_fields;
+}
+
+void
+Compiler::visitNotBranch(const Not& expr)
+{
+    _code = compile_child(expr.getChild());
+    _code.program.emplace_back(Opcode::NOT, 0u);
+}
+
+void
+Compiler::visitDocumentType(const DocType& expr)
+{
+    set_code(Opcode::RESULT, get_result(documentTypeEqualsName(_doc_type, expr.getDocType())), false);
+}
+
+void
+Compiler::visit_children(const ValueNode& left, const ValueNode* right)
+{
+    // Functions and arithmetic are not lowered, but are scalar if their inputs are
+    bool scalar = true;
+    bool uses_fields = false;
+    for (const ValueNode* child : { &left, right }) {
+        if (child != nullptr) {
+            Operand ignore;
+            bool child_scalar = true;
+            bool child_lowered = false;
+            bool child_uses_fields = false;
+            visit_value(*child, ignore, child_scalar, child_lowered, child_uses_fields);
+            scalar = scalar && child_scalar;
+            uses_fields = uses_fields || child_uses_fields;
+        }
+    }
+    _operand = Operand();
+    _scalar = scalar;
+    _lowered = false;
+    _uses_fields = uses_fields;
+}
+
+void
+Compiler::visitIdValueNode(const IdValueNode& expr)
+{
+    switch (expr.getType()) {
+    case IdValueNode::SCHEME:
+        _operand.string_value = "id";
+        set_operand(Operand::Kind::STRING);
+        break;
+    case IdValueNode::NS:
+        set_operand(Operand::Kind::ID_NAMESPACE);
+        break;
+    case IdValueNode::TYPE:
+        set_operand(Operand::Kind::ID_TYPE);
+        break;
+    case IdValueNode::SPEC:
+        set_operand(Operand::Kind::ID_SPECIFIC);
+        break;
+    case IdValueNode::ALL:
+        set_operand(Operand::Kind::ID_ALL);
+        break;
+    case IdValueNode::GROUP:
+        set_operand(Operand::Kind::ID_GROUP);
+        break;
+    case IdValueNode::USER:
+        set_operand(Operand::Kind::ID_USER);
+        break;
+    case IdValueNode::BUCKET:
+        set_operand(Operand::Kind::ID_BUCKET);
+        break;
+    case IdValueNode::GID:
+        break;
+    }
+}
+
+void
+Compiler::visitFieldValueNode(const FieldValueNode& expr)
+{
+    // Mirrors FieldValueNode::getValue() for a document of the compiled type
+    if (!documentTypeEqualsName(_doc_type, expr.getDocType())) {
+        set_operand(Operand::Kind::INVALID);
+        return;
+    }
+    const vespalib::string& field_name = expr.getFieldName();
+    if (looks_like_complex_field_path(field_name)) {
+        _scalar = false;
+        return;
+    }
+    if (_doc_type.has_imported_field_name(field_name)) {
+        set_operand(Operand::Kind::NULL_VALUE);
+        return;
+    }
+    if (!_doc_type.hasField(field_name)) {
+        set_operand(Operand::Kind::INVALID);
+        return;
+    }
+    const Field& field = _doc_type.getField(field_name);
+    switch (field.getDataType().getId()) {
+    case DataType::T_INT:
+    case DataType::T_LONG:
+    case DataType::T_BYTE:
+    case DataType::T_BOOL:
+    case DataType::T_FLOAT:
+    case DataType::T_DOUBLE:
+    case DataType::T_STRING:
+        _operand.field = &field;
+        set_operand(Operand::Kind::FIELD);
+        _uses_fields = true;
+        break;
+    default:
+        _scalar = false;
+    }
+}
+
+bool
+is_bucket(const Operand& operand)
+{
+    return operand.kind == Operand::Kind::ID_BUCKET;
+}
+
+void
+Compiler::visitComparison(const Compare& expr)
+{
+    Comparison cmp;
+    bool left_scalar = true;
+    bool left_lowered = false;
+    bool left_uses_fields = false;
+    bool right_scalar = true;
+    bool right_lowered = false;
+    bool right_uses_fields = false;
+    visit_value(expr.getLeft(), cmp.left, left_scalar, left_lowered, left_uses_fields);
+    visit_value(expr.getRight(), cmp.right, right_scalar, right_lowered, right_uses_fields);
+    bool uses_fields = left_uses_fields || right_uses_fields;
+    if (!left_scalar || !right_scalar) {
+        // Comparison might produce multiple results
+        _valid = false;
+        set_code(Opcode::NODE, 0u, uses_fields);
+        return;
+    }
+    const Operator& op = expr.getOperator();
+    bool lowered = left_lowered && right_lowered;
+    if (op == FunctionOperator::EQ) {
+        cmp.op = CompareOp::EQ;
+    } else if (op == FunctionOperator::NE) {
+        cmp.op = CompareOp::NE;
+    } else if (op == FunctionOperator::LT) {
+        cmp.op = CompareOp::LT;
+    } else if (op == FunctionOperator::GT) {
+        cmp.op = CompareOp::GT;
+    } else if (op == FunctionOperator::LEQ) {
+        cmp.op = CompareOp::LE;
+    } else if (op == FunctionOperator::GEQ) {
+        cmp.op = CompareOp::GE;
+    } else if ((op == GlobOperator::GLOB) && (is_bucket(cmp.left) || is_bucket(cmp.right))) {
+        cmp.op = CompareOp::EQ; // glob against bucket is a containment check, as for equality
+    } else {
+        lowered = false;
+    }
+    if (!lowered) {
+        set_code(Opcode::NODE, _nodes.size(), uses_fields);
+        _nodes.push_back(&expr);
+        return;
+    }
+    cmp.bucket_id_factory = &expr.getBucketIdFactory();
+    if (cmp.left.is_constant() && cmp.right.is_constant()) {
+        StringFieldValue ignore;
+        set_code(Opcode::RESULT, compare_scalars(cmp.op, load(cmp.left, nullptr, nullptr, ignore),
+                                                 load(cmp.right, nullptr, nullptr, ignore)), false);
+        return;
+    }
+    set_code(Opcode::COMPARE, _comparisons.size(), uses_fields);
+    _comparisons.push_back(std::move(cmp));
+}
+
+}
+
+CompiledSelection::CompiledSelection(const Node& root, const DocumentType& doc_type)
+    : _root(root),
+      _doc_type(doc_type),
+      _program(),
+      _comparisons(),
+      _nodes()
+{
+    Compiler compiler(_doc_type, _comparisons, _nodes);
+    root.visit(compiler);
+    if (compiler.valid()) {
+        _program = compiler.steal_program();
+    } else {
+        _comparisons.clear();
+        _nodes.clear();
+    }
+}
+
+CompiledSelection::~CompiledSelection() = default;
+
+uint32_t
+CompiledSelection::compare(const Comparison& cmp, const Document& doc) const
+{
+    StringFieldValue left_string;
+    StringFieldValue right_string;
+    return compare_scalars(cmp.op, load(cmp.left, &doc, cmp.bucket_id_factory, left_string),
+                           load(cmp.right, &doc, cmp.bucket_id_factory, right_string));
+}
+
+const Result&
+CompiledSelection::contains(const Document& doc) const
+{
+    if (_program.empty() || (&doc.getType() != &_doc_type)) {
+        return _root.contains(doc).combineResults();
+    }
+    std::array<uint8_t, max_stack_depth> stack;
+    uint32_t sp = 0;
+    size_t program_size = _program.size();
+    for (size_t pc = 0; pc < program_size; ++pc) {
+        const Instruction& insn = _program[pc];
+        switch (insn.op) {
+        case Opcode::RESULT:
+            stack[sp++] = insn.arg;
+            break;
+        case Opcode::COMPARE:
+            stack[sp++] = compare(_comparisons[insn.arg], doc);
+            break;
+        case Opcode::NODE:
+            stack[sp++] = _nodes[insn.arg]->contains(doc).combineResults().toEnum();
+            break;
+        case Opcode::JUMP_IF_FALSE:
+            if (stack[sp - 1] == result_false) {
+                pc += insn.arg;
+            }
+            break;
+        case Opcode::JUMP_IF_TRUE:
+            if (stack[sp - 1] == result_true) {
+                pc += insn.arg;
+            }
+            break;
+        case Opcode::AND:
+            --sp;
+            stack[sp - 1] = and_table[stack[sp - 1]][stack[sp]];
+            break;
+        case Opcode::OR:
+            --sp;
+            stack[sp - 1] = or_table[stack[sp - 1]][stack[sp]];
+            break;
+        case Opcode::NOT:
+            stack[sp - 1] = not_table[stack[sp - 1]];
+            break;
+        }
+    }
+    assert(sp == 1);
+    return Result::fromEnum(stack[0]);
+}
+
+}
@@ -0,0 +1,119 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <cstdint>
+#include <vector>
+
+namespace document {
+    class BucketIdFactory;
+    class Document;
+    class DocumentId;
+    class DocumentType;
+    class Field;
+}
+
+namespace document::select {
+
+class Node;
+class Result;
+
+/**
+ * A document selection lowered into a flat program specialized for a
+ * single document type, to avoid walking the selection tree with
+ * virtual calls, value allocations and result lists for each document
+ * matched against it.
+ *
+ * Document type checks are resolved when compiling, field lookups are
+ * resolved to fields of the document type, and comparisons between
+ * document id components, primitive fields and constants are evaluated
+ * on the stack. Branches are short-circuited, and operands that only
+ * depend on the document id are evaluated first, so that the fields of
+ * a lazily deserialized document are not touched when the id alone
+ * decides the outcome. Comparisons that are not lowered (e.g. glob and
+ * regex matching, functions and arithmetic) are evaluated using their
+ * part of the selection tree.
+ *
+ * If the selection might produce more than one result for a document
+ * (variables, collection fields or complex field paths), or a document
+ * of another type is matched, the whole selection tree is used instead.
+ * The selection tree must outlive this object, and as with the tree,
+ * an instance must not be used by multiple threads concurrently.
+ */
+class CompiledSelection
+{
+public:
+    enum class Opcode : uint8_t {
+        RESULT,          // push constant result
+        COMPARE,         // push result of lowered comparison
+        NODE,            // push result of evaluating selection tree node
+        JUMP_IF_FALSE,   // skip right operand of and if top is false
+        JUMP_IF_TRUE,    // skip right operand of or if top is true
+        AND,
+        OR,
+        NOT
+    };
+
+    struct Instruction {
+        Opcode   op;
+        uint32_t arg; // result enum, comparison or node index, or jump distance
+        Instruction(Opcode op_in, uint32_t arg_in) noexcept : op(op_in), arg(arg_in) {}
+    };
+
+    /*
+     * Scalar value source for one side of a lowered comparison.
+     */
+    struct Operand {
+        enum class Kind : uint8_t {
+            INVALID, NULL_VALUE, STRING, INTEGER, FLOAT,          // constants
+            ID_NAMESPACE, ID_TYPE, ID_SPECIFIC, ID_ALL, ID_GROUP, // document id components
+            ID_USER, ID_BUCKET,
+            FIELD
+        };
+        Kind             kind;
+        int64_t          int_value;
+        double           float_value;
+        vespalib::string string_value;
+        const Field     *field;
+        Operand() noexcept : kind(Kind::INVALID), int_value(0), float_value(0.0), string_value(), field(nullptr) {}
+        bool is_constant() const noexcept { return kind <= Kind::FLOAT; }
+    };
+
+    enum class CompareOp : uint8_t { EQ, NE, LT, GT, LE, GE };
+
+    struct Comparison {
+        Operand                left;
+        Operand                right;
+        CompareOp              op;
+        const BucketIdFactory *bucket_id_factory; // used for id.bucket
+        Comparison() noexcept : left(), right(), op(CompareOp::EQ), bucket_id_factory(nullptr) {}
+    };
+
+    static constexpr uint32_t max_stack_depth = 64;
+
+private:
+    const Node                &_root;
+    const DocumentType        &_doc_type;
+    std::vector<Instruction>   _program;
+    std::vector<Comparison>    _comparisons;
+    std::vector<const Node *>  _nodes;
+
+    uint32_t compare(const Comparison& cmp, const Document& doc) const;
+public:
+    CompiledSelection(const Node& root, const DocumentType& doc_type);
+    CompiledSelection(const CompiledSelection&) = delete;
+    CompiledSelection& operator=(const CompiledSelection&) = delete;
+    ~CompiledSelection();
+
+    /**
+     * Returns false if the selection could not be lowered, in which
+     * case the selection tree is always used.
+     */
+    bool is_compiled() const noexcept { return !_program.empty(); }
+    const std::vector<Instruction>& program() const noexcept { return _program; }
+    const DocumentType& document_type() const noexcept { return _doc_type; }
+
+    const Result& contains(const Document& doc) const;
+};
+
+}
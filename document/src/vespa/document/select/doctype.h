@@ -29,6 +29,7 @@ public:
 
     Node::UP clone() const override { return wrapParens(new DocType(_doctype)); }
 
+    const vespalib::string& getDocType() const { return _doctype; }
 };
 
 }
@@ -0,0 +1,139 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/fnet/event_queue.h>
+#include <vespa/fnet/packetqueue.h>
+#include <vespa/fnet/controlpacket.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vector>
+
+std::vector<uint32_t> drain(FNET_PacketQueue_NoLock &queue) {
+    std::vector<uint32_t> result;
+    FNET_Context context;
+    while (queue.DequeuePacket_NoLock(&context) != nullptr) {
+        result.push_back(context._value.INT);
+    }
+    return result;
+}
+
+vespalib::string str(const std::vector<uint32_t> &values) {
+    vespalib::string result;
+    for (uint32_t value : values) {
+        if (!result.empty()) {
+            result += ",";
+        }
+        result += vespalib::make_string("%u", value);
+    }
+    return result;
+}
+
+bool post(FNET_EventQueue &queue, uint32_t value, uint32_t eventsBeforeWakeup = 1) {
+    bool wakeup = false;
+    EXPECT_TRUE(queue.push(&FNET_ControlPacket::Execute, FNET_Context(value), eventsBeforeWakeup, wakeup));
+    return wakeup;
+}
+
+TEST("require that events are flushed in the order they were posted") {
+    FNET_EventQueue queue;
+    FNET_PacketQueue_NoLock dst;
+    EXPECT_TRUE(queue.empty());
+    post(queue, 1);
+    post(queue, 2);
+    post(queue, 3);
+    EXPECT_FALSE(queue.empty());
+    queue.flush(dst);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQUAL("1,2,3", str(drain(dst)));
+    post(queue, 4);
+    queue.flush(dst);
+    EXPECT_EQUAL("4", str(drain(dst)));
+}
+
+TEST("require that wakeup is only needed when the consumer is sleeping") {
+    FNET_EventQueue queue;
+    FNET_PacketQueue_NoLock dst;
+    EXPECT_FALSE(post(queue, 1));
+    EXPECT_FALSE(queue.prepareSleep());
+    queue.flush(dst);
+    EXPECT_TRUE(queue.prepareSleep());
+    EXPECT_TRUE(post(queue, 2));
+    EXPECT_FALSE(post(queue, 3));
+    queue.endSleep();
+    queue.flush(dst);
+    EXPECT_TRUE(queue.prepareSleep());
+    queue.endSleep();
+    EXPECT_FALSE(post(queue, 4));
+    EXPECT_EQUAL("1,2,3", str(drain(dst)));
+}
+
+TEST("require that wakeup may be delayed until enough events are queued") {
+    FNET_EventQueue queue;
+    EXPECT_TRUE(queue.prepareSleep());
+    EXPECT_FALSE(post(queue, 1, 3));
+    EXPECT_FALSE(post(queue, 2, 3));
+    EXPECT_TRUE(post(queue, 3, 3));
+    EXPECT_FALSE(post(queue, 4, 3));
+}
+
+TEST("require that closed queue rejects events") {
+    FNET_EventQueue queue;
+    FNET_PacketQueue_NoLock dst;
+    post(queue, 1);
+    queue.close(dst);
+    EXPECT_TRUE(queue.empty());
+    bool wakeup = false;
+    EXPECT_FALSE(queue.push(&FNET_ControlPacket::Execute, FNET_Context(2u), 1, wakeup));
+    queue.flush(dst);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQUAL("1", str(drain(dst)));
+}
+
+TEST("require that events overflowing the ring buffer keep their order") {
+    FNET_EventQueue queue(4);
+    FNET_PacketQueue_NoLock dst;
+    for (uint32_t i = 1; i <= 6; ++i) {
+        post(queue, i);
+    }
+    EXPECT_FALSE(queue.empty());
+    queue.flush(dst);
+    EXPECT_TRUE(queue.empty());
+    post(queue, 7);
+    queue.flush(dst);
+    EXPECT_EQUAL("1,2,3,4,5,6,7", str(drain(dst)));
+}
+
+TEST("require that overflowing events wake up a sleeping consumer") {
+    FNET_EventQueue queue(2);
+    EXPECT_TRUE(queue.prepareSleep());
+    EXPECT_FALSE(post(queue, 1, 10));
+    EXPECT_FALSE(post(queue, 2, 10));
+    EXPECT_TRUE(post(queue, 3, 10));
+}
+
+constexpr uint32_t num_producers = 4;
+constexpr uint32_t events_per_producer = 25000;
+
+TEST_MT_F("require that events from multiple producers are all delivered in order", num_producers + 1, FNET_EventQueue(64)) {
+    if (thread_id < num_producers) {
+        for (uint32_t i = 0; i < events_per_producer; ++i) {
+            bool wakeup = false;
+            ASSERT_TRUE(f1.push(&FNET_ControlPacket::Execute, FNET_Context((thread_id << 24) + i), 1, wakeup));
+        }
+    } else {
+        std::vector<uint32_t> next(num_producers, 0);
+        uint32_t received = 0;
+        FNET_PacketQueue_NoLock dst;
+        while (received < num_producers * events_per_producer) {
+            f1.flush(dst);
+            for (uint32_t value : drain(dst)) {
+                uint32_t producer = (value >> 24);
+                ASSERT_TRUE(producer < num_producers);
+                ASSERT_EQUAL(next[producer], (value & 0xffffff));
+                ++next[producer];
+                ++received;
+            }
+        }
+        EXPECT_TRUE(f1.empty());
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
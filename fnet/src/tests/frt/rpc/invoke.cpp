@@ -3,10 +3,12 @@
 #include <vespa/vespalib/net/socket_spec.h>
 #include <vespa/vespalib/util/benchmark_timer.h>
 #include <vespa/vespalib/util/latch.h>
+#include <vespa/vespalib/util/size_literals.h>
 #include <vespa/fnet/frt/supervisor.h>
 #include <vespa/fnet/frt/target.h>
 #include <vespa/fnet/frt/rpcrequest.h>
 #include <vespa/fnet/frt/invoker.h>
+#include <vespa/fnet/transport.h>
 #include <mutex>
 #include <condition_variable>
 
@@ -201,6 +203,8 @@ public:
                         FRT_METHOD(TestRPC::RPC_GetValue), this);
         rb.DefineMethod("test", "iibb", "i",
                         FRT_METHOD(TestRPC::RPC_Test), this);
+        rb.DefineMethod("copyData", "xX", "xX",
+                        FRT_METHOD(TestRPC::RPC_CopyData), this);
     }
 
     void RPC_Test(FRT_RPCRequest *req)
@@ -223,6 +227,19 @@ public:
         }
     }
 
+    void RPC_CopyData(FRT_RPCRequest *req)
+    {
+        FRT_Values &param = *req->GetParams();
+        FRT_Values &ret = *req->GetReturn();
+        ret.AddData(param[0]._data._buf, param[0]._data._len);
+        uint32_t len = param[1]._data_array._len;
+        FRT_DataValue *dst = ret.AddDataArray(len);
+        for (uint32_t i = 0; i < len; ++i) {
+            const FRT_DataValue &src = param[1]._data_array._pt[i];
+            ret.SetData(&dst[i], src._buf, src._len);
+        }
+    }
+
     void RPC_Inc(FRT_RPCRequest *req)
     {
         req->GetReturn()->AddInt32(req->GetParams()->GetValue(0)._intval32 + 1);
@@ -265,9 +282,9 @@ public:
     RequestLatch &detached_req() { return _testRPC.detached_req(); }
     EchoTest &echo() { return _echoTest; }
 
-    Fixture()
-        : _client(crypto),
-          _server(crypto),
+    explicit Fixture(bool zero_copy = false)
+        : _client(fnet::TransportConfig().crypto(crypto).zero_copy(zero_copy)),
+          _server(fnet::TransportConfig().crypto(crypto).zero_copy(zero_copy)),
           _peerSpec(),
           _target(nullptr),
           _testRPC(&_server.supervisor()),
@@ -421,6 +438,62 @@ TEST_F("require that parameters can be echoed as return values", Fixture()) {
     EXPECT_TRUE(req.get().GetParams()->Equals(req.get().GetReturn()));
 }
 
+vespalib::string make_data(size_t len, char seed) {
+    vespalib::string data;
+    for (size_t i = 0; i < len; ++i) {
+        data.push_back(char(seed + (i % 251)));
+    }
+    return data;
+}
+
+void verify_large_data_round_trip(Fixture &f) {
+    std::vector<vespalib::string> blobs = { make_data(10, 'a'), make_data(64_Ki, 'b'),
+                                            make_data(5, 'c'), make_data(300_Ki, 'd') };
+    vespalib::string large = make_data(3_Mi, 'e');
+    for (size_t i = 0; i < 5; ++i) {
+        MyReq req("copyData");
+        req.get().GetParams()->AddData(large.data(), large.size());
+        FRT_DataValue *arr = req.get().GetParams()->AddDataArray(blobs.size());
+        for (size_t j = 0; j < blobs.size(); ++j) {
+            req.get().GetParams()->SetData(&arr[j], blobs[j].data(), blobs[j].size());
+        }
+        f.target().InvokeSync(req.borrow(), timeout);
+        ASSERT_TRUE(!req.get().IsError());
+        ASSERT_TRUE(req.get().CheckReturnTypes("xX"));
+        FRT_Values &ret = *req.get().GetReturn();
+        EXPECT_TRUE(vespalib::string(ret[0]._data._buf, ret[0]._data._len) == large);
+        ASSERT_EQUAL(ret[1]._data_array._len, blobs.size());
+        for (size_t j = 0; j < blobs.size(); ++j) {
+            const FRT_DataValue &value = ret[1]._data_array._pt[j];
+            EXPECT_TRUE(vespalib::string(value._buf, value._len) == blobs[j]);
+        }
+    }
+}
+
+TEST_F("require that large data values are sent intact", Fixture()) {
+    TEST_DO(verify_large_data_round_trip(f1));
+}
+
+TEST_F("require that large data values are sent intact with zero copy enabled", Fixture(true)) {
+    TEST_DO(verify_large_data_round_trip(f1));
+}
+
+TEST_F("require that requests can be reused after reply with zero copy enabled", Fixture(true)) {
+    vespalib::string large = make_data(1_Mi, 'f');
+    MyReq req("copyData");
+    for (size_t i = 0; i < 5; ++i) {
+        req.get().Reset(); // asserts that the request is no longer referenced
+        req.get().SetMethodName("copyData");
+        req.get().GetParams()->AddData(large.data(), large.size());
+        req.get().GetParams()->AddDataArray(0);
+        f1.target().InvokeSync(req.borrow(), timeout);
+        ASSERT_TRUE(!req.get().IsError());
+        ASSERT_TRUE(req.get().CheckReturnTypes("xX"));
+        FRT_Values &ret = *req.get().GetReturn();
+        EXPECT_TRUE(vespalib::string(ret[0]._data._buf, ret[0]._data._len) == large);
+    }
+}
+
 TEST_MAIN() {
     crypto = my_crypto_engine();
     TEST_RUN_ALL();
@@ -0,0 +1,118 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/net/selector.h>
+#include <vespa/fnet/event_queue.h>
+#include <vespa/fnet/packetqueue.h>
+#include <vespa/fnet/controlpacket.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Measures how many events per second can be posted to a consumer
+// thread that blocks in a selector when idle, comparing the mutex
+// protected packet queue previously used by the transport thread with
+// the lock-free event queue.
+
+using Selector = vespalib::Selector<int>;
+
+constexpr uint32_t num_events = 1000000;
+
+struct Consumer {
+    FNET_PacketQueue_NoLock queue;
+    uint32_t received = 0;
+    uint32_t wakeups = 0;
+    void handle_wakeup() { ++wakeups; }
+    void handle_event(int &, bool, bool) {}
+    void consume() {
+        FNET_Context context;
+        while (queue.DequeuePacket_NoLock(&context) != nullptr) {
+            ++received;
+        }
+    }
+};
+
+struct LockedQueue {
+    std::mutex lock;
+    FNET_PacketQueue_NoLock queue;
+    Selector &selector;
+    explicit LockedQueue(Selector &selector_in) : lock(), queue(), selector(selector_in) {}
+    void post(FNET_Context context) {
+        uint32_t qLen;
+        {
+            std::lock_guard guard(lock);
+            queue.QueuePacket_NoLock(&FNET_ControlPacket::Execute, context);
+            qLen = queue.GetPacketCnt_NoLock();
+        }
+        if (qLen == 1) {
+            selector.wakeup();
+        }
+    }
+    void poll(Consumer &consumer) {
+        selector.poll(10);
+        selector.dispatch(consumer);
+        std::lock_guard guard(lock);
+        queue.FlushPackets_NoLock(&consumer.queue);
+    }
+};
+
+struct LockFreeQueue {
+    FNET_EventQueue queue;
+    Selector &selector;
+    explicit LockFreeQueue(Selector &selector_in) : queue(), selector(selector_in) {}
+    void post(FNET_Context context) {
+        bool wakeup = false;
+        queue.push(&FNET_ControlPacket::Execute, context, 1, wakeup);
+        if (wakeup) {
+            selector.wakeup();
+        }
+    }
+    void poll(Consumer &consumer) {
+        selector.poll(queue.prepareSleep() ? 10 : 0);
+        queue.endSleep();
+        selector.dispatch(consumer);
+        queue.flush(consumer.queue);
+    }
+};
+
+template <typename Q>
+double measure(const char *name, uint32_t num_producers) {
+    using clock = std::chrono::steady_clock;
+    using ms_double = std::chrono::duration<double, std::milli>;
+    Selector selector;
+    Q q(selector);
+    Consumer consumer;
+    uint32_t per_producer = num_events / num_producers;
+    uint32_t total = per_producer * num_producers;
+    clock::time_point start = clock::now();
+    std::vector<std::thread> producers;
+    for (uint32_t t = 0; t < num_producers; ++t) {
+        producers.emplace_back([&q, per_producer]() {
+            for (uint32_t i = 0; i < per_producer; ++i) {
+                q.post(FNET_Context(i));
+            }
+        });
+    }
+    while (consumer.received < total) {
+        q.poll(consumer);
+        consumer.consume();
+    }
+    ms_double ms = (clock::now() - start);
+    for (auto &producer: producers) {
+        producer.join();
+    }
+    double events_per_sec = (total / ms.count()) * 1000.0;
+    fprintf(stderr, "%s, %u producer(s): %1.0f events/s (%u wakeups)\n",
+            name, num_producers, events_per_sec, consumer.wakeups);
+    return events_per_sec;
+}
+
+TEST("event queue speed") {
+    for (uint32_t num_producers: {1, 2, 4, 8}) {
+        EXPECT_GREATER(measure<LockedQueue>("mutex queue", num_producers), 0.0);
+        EXPECT_GREATER(measure<LockFreeQueue>("lock-free queue", num_producers), 0.0);
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
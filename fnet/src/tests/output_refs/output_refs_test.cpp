@@ -0,0 +1,130 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/fnet/databuffer.h>
+#include <vespa/fnet/output_refs.h>
+#include <vespa/fnet/dummypacket.h>
+#include <sys/uio.h>
+
+struct MyPacket : FNET_DummyPacket {
+    bool &freed;
+    explicit MyPacket(bool &freed_in) : freed(freed_in) {}
+    void Free() override { freed = true; }
+};
+
+vespalib::string stream(FNET_OutputRefs &refs, FNET_DataBuffer &output, uint32_t stopLen = 0) {
+    struct iovec iov[16];
+    int cnt = refs.fill(output, iov, 16, stopLen);
+    vespalib::string result;
+    for (int i = 0; i < cnt; ++i) {
+        result.append(static_cast<const char *>(iov[i].iov_base), iov[i].iov_len);
+    }
+    return result;
+}
+
+TEST("require that referenced data is interleaved with buffered data") {
+    bool freed = false;
+    MyPacket packet(freed);
+    FNET_OutputRefs refs(4);
+    FNET_DataBuffer output;
+    EXPECT_FALSE(refs.useRef(3));
+    EXPECT_TRUE(refs.useRef(4));
+    output.WriteBytes("ab", 2);
+    refs.reference(output, "1234", 4);
+    output.WriteBytes("cd", 2);
+    refs.reference(output, "5678", 4);
+    output.WriteBytes("ef", 2);
+    EXPECT_TRUE(refs.hold(&packet));
+    EXPECT_FALSE(refs.hold(&packet));
+    EXPECT_EQUAL(8u, refs.pendingBytes());
+    EXPECT_EQUAL("ab1234cd5678ef", stream(refs, output));
+    refs.consume(output, 3);
+    EXPECT_EQUAL("234cd5678ef", stream(refs, output));
+    refs.consume(output, 6);
+    EXPECT_EQUAL("678ef", stream(refs, output));
+    EXPECT_FALSE(freed);
+    refs.consume(output, 3);
+    EXPECT_TRUE(freed);
+    EXPECT_TRUE(refs.empty());
+    EXPECT_EQUAL("ef", stream(refs, output));
+    refs.consume(output, 2);
+    EXPECT_EQUAL(0u, output.GetDataLen());
+}
+
+TEST("require that output buffer may be relocated while encoding") {
+    bool freed = false;
+    MyPacket packet(freed);
+    FNET_OutputRefs refs(4);
+    FNET_DataBuffer output(16);
+    output.WriteBytes("ab", 2);
+    refs.reference(output, "1234", 4);
+    vespalib::string filler(1000, 'x');
+    output.WriteBytes(filler.data(), filler.size());
+    EXPECT_TRUE(refs.hold(&packet));
+    EXPECT_EQUAL("ab1234" + filler, stream(refs, output));
+}
+
+TEST("require that filling can stop in front of large referenced data") {
+    bool freed = false;
+    MyPacket packet(freed);
+    FNET_OutputRefs refs(2);
+    FNET_DataBuffer output;
+    output.WriteBytes("ab", 2);
+    refs.reference(output, "12", 2);
+    output.WriteBytes("cd", 2);
+    refs.reference(output, "3456", 4);
+    output.WriteBytes("ef", 2);
+    EXPECT_TRUE(refs.hold(&packet));
+    EXPECT_EQUAL("ab12cd", stream(refs, output, 4));
+    refs.consume(output, 6);
+    EXPECT_EQUAL("3456ef", stream(refs, output, 4));
+}
+
+TEST("require that packets sent with zero copy are held until completion") {
+    bool freed1 = false;
+    bool freed2 = false;
+    MyPacket packet1(freed1);
+    MyPacket packet2(freed2);
+    FNET_OutputRefs refs(4);
+    FNET_DataBuffer output;
+    refs.reference(output, "1234", 4);
+    refs.reference(output, "5678", 4);
+    EXPECT_TRUE(refs.hold(&packet1));
+    refs.reference(output, "abcd", 4);
+    EXPECT_TRUE(refs.hold(&packet2));
+    const char *data = nullptr;
+    uint32_t len = 0;
+    EXPECT_FALSE(refs.headRef(5, data, len));
+    EXPECT_TRUE(refs.headRef(4, data, len));
+    EXPECT_EQUAL(4u, len);
+    EXPECT_EQUAL(0u, refs.nextSeq());
+    refs.consumeZeroCopy(4, refs.nextSeq());
+    EXPECT_EQUAL(1u, refs.nextSeq());
+    refs.consume(output, 4);
+    EXPECT_FALSE(freed1);
+    EXPECT_EQUAL(1u, refs.numHeld());
+    refs.consume(output, 4);
+    EXPECT_TRUE(freed2);
+    refs.completed(0);
+    EXPECT_TRUE(freed1);
+    EXPECT_EQUAL(0u, refs.numHeld());
+}
+
+TEST("require that discard frees all packets") {
+    bool freed1 = false;
+    bool freed2 = false;
+    MyPacket packet1(freed1);
+    MyPacket packet2(freed2);
+    FNET_OutputRefs refs(4);
+    FNET_DataBuffer output;
+    refs.reference(output, "1234", 4);
+    EXPECT_TRUE(refs.hold(&packet1));
+    refs.reference(output, "5678", 4);
+    EXPECT_TRUE(refs.hold(&packet2));
+    refs.consumeZeroCopy(4, refs.nextSeq());
+    EXPECT_TRUE(!freed1 && !freed2);
+    refs.discard();
+    EXPECT_TRUE(freed1 && freed2);
+    EXPECT_TRUE(refs.empty());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
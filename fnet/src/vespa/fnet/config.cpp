@@ -7,7 +7,9 @@ FNET_Config::FNET_Config()
       _events_before_wakeup(1),
       _maxInputBufferSize(0x10000),
       _maxOutputBufferSize(0x10000),
+      _vectoredWriteThreshold(0x4000),
       _tcpNoDelay(true),
-      _drop_empty_buffers(false)
+      _drop_empty_buffers(false),
+      _zeroCopy(false)
 {
 }
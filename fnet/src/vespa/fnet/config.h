@@ -15,8 +15,10 @@ public:
     uint32_t  _events_before_wakeup;
     uint32_t  _maxInputBufferSize;
     uint32_t  _maxOutputBufferSize;
+    uint32_t  _vectoredWriteThreshold;
     bool      _tcpNoDelay;
     bool      _drop_empty_buffers;
+    bool      _zeroCopy;
 
     FNET_Config();
 };
@@ -10,6 +10,7 @@
 #include "transport_thread.h"
 #include "transport.h"
 #include <vespa/vespalib/net/socket_spec.h>
+#include <sys/uio.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".fnet");
@@ -244,6 +245,9 @@ FNET_Connection::handshake()
         EnableReadEvent(true);
         EnableWriteEvent(writePendingAfterConnect());
         _flags._framed = (_socket->min_read_buffer_size() > 1);
+        if (getConfig()._zeroCopy && (getConfig()._vectoredWriteThreshold > 0)) {
+            _flags._zero_copy = _socket->enable_zero_copy();
+        }
         size_t chunk_size = std::max(size_t(FNET_READ_SIZE), _socket->min_read_buffer_size());
         ssize_t res = 0;
         do { // drain input pipeline
@@ -365,6 +369,67 @@ done_read:
 }
 
 
+ssize_t
+FNET_Connection::write_output(int &my_errno, bool &complete)
+{
+    ssize_t res;
+    if (_outputRefs.empty()) {
+        uint32_t len = _output.GetDataLen();
+        res = _socket->write(_output.GetData(), len);
+        my_errno = errno;
+        if (res > 0) {
+            _output.DataToDead((uint32_t)res);
+            _output.resetIfEmpty();
+        }
+        complete = (res == ssize_t(len));
+        return res;
+    }
+    const char *data;
+    uint32_t    len;
+    if (_flags._zero_copy && _outputRefs.headRef(FNET_ZERO_COPY_SIZE, data, len)) {
+        res = _socket->write_zero_copy(data, len);
+        my_errno = errno;
+        if (res > 0) {
+            _outputRefs.consumeZeroCopy(res, _outputRefs.nextSeq());
+            complete = (res == ssize_t(len));
+            return res;
+        }
+        if ((res == 0) || (my_errno != ENOBUFS)) {
+            complete = false;
+            return res;
+        }
+        // out of socket option memory, send by copy instead
+    }
+    struct iovec iov[FNET_WRITE_IOV];
+    // leave large referenced data for the next zero copy send
+    uint32_t stopLen = _flags._zero_copy ? uint32_t(FNET_ZERO_COPY_SIZE) : 0;
+    int cnt = _outputRefs.fill(_output, iov, FNET_WRITE_IOV, stopLen);
+    size_t total = 0;
+    for (int i = 0; i < cnt; ++i) {
+        total += iov[i].iov_len;
+    }
+    res = _socket->writev(iov, cnt);
+    my_errno = errno;
+    if (res > 0) {
+        _outputRefs.consume(_output, res);
+        _output.resetIfEmpty();
+    }
+    complete = (res == ssize_t(total));
+    return res;
+}
+
+
+void
+FNET_Connection::reap_zero_copy()
+{
+    uint32_t lo;
+    uint32_t hi;
+    while (_socket->read_zero_copy_completion(lo, hi)) {
+        _outputRefs.completed(hi);
+    }
+}
+
+
 bool
 FNET_Connection::Write()
 {
@@ -373,46 +438,54 @@ FNET_Connection::Write()
     int      writeCnt       = 0;     // write count
     bool     broken         = false; // is this conn broken ?
     int      my_errno       = 0;     // sample and preserve errno
+    bool     complete       = false; // was all data passed to the socket written ?
+    bool     vectored       = (_outputRefs.threshold() > 0);
     ssize_t  res;                    // single write result
 
     FNET_Packet     *packet;
     FNET_Context     context;
 
+    if (_flags._zero_copy) {
+        reap_zero_copy();
+    }
+
     do {
 
         // fill output buffer
 
-        while (_output.GetDataLen() < chunk_size) {
+        while (_output.GetDataLen() + _outputRefs.pendingBytes() < chunk_size) {
             if (_myQueue.IsEmpty_NoLock())
                 break;
 
             packet = _myQueue.DequeuePacket_NoLock(&context);
             if (packet->IsRegularPacket()) { // ignore non-regular packets
-                _streamer->Encode(packet, context._value.INT, &_output);
+                if (vectored) {
+                    _streamer->EncodeVectored(packet, context._value.INT, &_output, _outputRefs);
+                    if (_outputRefs.hold(packet)) {
+                        continue; // freed when referenced data is written
+                    }
+                } else {
+                    _streamer->Encode(packet, context._value.INT, &_output);
+                }
             }
             packet->Free();
         }
 
-        if (_output.GetDataLen() == 0) {
+        if ((_output.GetDataLen() == 0) && _outputRefs.empty()) {
             res = 0;
             break;
         }
 
         // write data
 
-        res = _socket->write(_output.GetData(), _output.GetDataLen());
-        my_errno = errno;
+        res = write_output(my_errno, complete);
         writeCnt++;
-        if (res > 0) {
-            _output.DataToDead((uint32_t)res);
-            _output.resetIfEmpty();
-        }
     } while (res > 0 &&
-             _output.GetDataLen() == 0 &&
-             !_myQueue.IsEmpty_NoLock() &&
+             complete &&
+             ((_output.GetDataLen() > 0) || !_outputRefs.empty() || !_myQueue.IsEmpty_NoLock()) &&
              writeCnt < FNET_WRITE_REDO);
 
-    if ((_output.GetDataLen() > 0)) {
+    if ((_output.GetDataLen() > 0) || !_outputRefs.empty()) {
         ++my_write_work;
     }
 
@@ -485,6 +558,7 @@ FNET_Connection::FNET_Connection(FNET_TransportThread *owner,
       _queue(256),
       _myQueue(256),
       _output(0),
+      _outputRefs(owner->owner().getConfig()._vectoredWriteThreshold),
       _channels(),
       _callbackTarget(nullptr),
       _cleanup(nullptr)
@@ -516,6 +590,7 @@ FNET_Connection::FNET_Connection(FNET_TransportThread *owner,
       _queue(256),
       _myQueue(256),
       _output(0),
+      _outputRefs(owner->owner().getConfig()._vectoredWriteThreshold),
       _channels(),
       _callbackTarget(nullptr),
       _cleanup(nullptr)
@@ -698,6 +773,7 @@ FNET_Connection::Close()
     detach_selector();
     SetState(FNET_CLOSED);
     _ioc_socket_fd = -1;
+    _outputRefs.discard();
     if (!_flags._handshake_work_pending) {
         _socket.reset();
     }
@@ -714,6 +790,12 @@ FNET_Connection::HandleReadEvent()
         broken = !handshake();
         break;
     case FNET_CONNECTED:
+        if (_flags._zero_copy) {
+            // a reply implies that the peer got our data; free held
+            // packets (and the requests they reference) before it is
+            // delivered
+            reap_zero_copy();
+        }
         broken = !Read();
         break;
     case FNET_CLOSING:
@@ -8,6 +8,7 @@
 #include "context.h"
 #include "channellookup.h"
 #include "packetqueue.h"
+#include "output_refs.h"
 #include <vespa/vespalib/net/socket_handle.h>
 #include <vespa/vespalib/net/async_resolver.h>
 #include <vespa/vespalib/net/crypto_socket.h>
@@ -64,7 +65,9 @@ public:
         FNET_READ_SIZE  = 16_Ki,
         FNET_READ_REDO  = 10,
         FNET_WRITE_SIZE = 16_Ki,
-        FNET_WRITE_REDO = 10
+        FNET_WRITE_REDO = 10,
+        FNET_WRITE_IOV  = 64,
+        FNET_ZERO_COPY_SIZE = 16_Ki
     };
 
 private:
@@ -76,7 +79,8 @@ private:
             _discarding(false),
             _framed(false),
             _handshake_work_pending(false),
-            _drop_empty_buffers(cfg._drop_empty_buffers)
+            _drop_empty_buffers(cfg._drop_empty_buffers),
+            _zero_copy(false)
         { }
         bool _gotheader;
         bool _inCallback;
@@ -85,6 +89,7 @@ private:
         bool _framed;
         bool _handshake_work_pending;
         bool _drop_empty_buffers;
+        bool _zero_copy;
     };
     struct ResolveHandler : public vespalib::AsyncResolver::ResultHandler {
         FNET_Connection *connection;
@@ -110,6 +115,7 @@ private:
     FNET_PacketQueue_NoLock  _queue;           // outer output queue
     FNET_PacketQueue_NoLock  _myQueue;         // inner output queue
     FNET_DataBuffer          _output;          // output buffer
+    FNET_OutputRefs          _outputRefs;      // output data sent in place
     FNET_ChannelLookup       _channels;        // channel 'DB'
     FNET_Channel            *_callbackTarget;  // target of current callback
 
@@ -227,6 +233,26 @@ private:
      **/
     bool Read();
 
+    /**
+     * Write pending output data (the output buffer interleaved with
+     * any referenced output data) to the socket. Large referenced
+     * data at the start of the output stream is sent using zero copy
+     * if enabled.
+     *
+     * @return result of the socket write
+     * @param my_errno where to store errno after the socket write
+     * @param complete where to signal that all data passed to the
+     *        socket was written
+     **/
+    ssize_t write_output(int &my_errno, bool &complete);
+
+    /**
+     * Free packets whose zero copy sends have completed. This is done
+     * both before writing and before reading, since a request packet
+     * must not be held after its reply has been delivered.
+     **/
+    void reap_zero_copy();
+
     /**
      * Write outgoing data to socket.
      *
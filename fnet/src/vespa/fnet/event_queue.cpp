@@ -0,0 +1,151 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "event_queue.h"
+#include "controlpacket.h"
+#include <cassert>
+#include <limits>
+#include <thread>
+
+FNET_EventQueue::FNET_EventQueue(uint32_t capacity)
+    : _slots(std::make_unique<Slot[]>(capacity)),
+      _mask(capacity - 1),
+      _tail(0),
+      _head(0),
+      _sleeping(false),
+      _overflowing(false),
+      _lock(),
+      _overflow()
+{
+    assert((capacity > 0) && ((capacity & _mask) == 0));
+    for (uint32_t i = 0; i < capacity; ++i) {
+        _slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+}
+
+
+FNET_EventQueue::~FNET_EventQueue() = default;
+
+
+bool
+FNET_EventQueue::wakeConsumer(uint64_t depth, uint32_t eventsBeforeWakeup)
+{
+    return ((depth >= eventsBeforeWakeup) &&
+            _sleeping.load(std::memory_order_seq_cst) &&
+            _sleeping.exchange(false, std::memory_order_relaxed));
+}
+
+
+bool
+FNET_EventQueue::push(FNET_ControlPacket *packet, FNET_Context context,
+                      uint32_t eventsBeforeWakeup, bool &wakeup)
+{
+    wakeup = false;
+    uint64_t pos = _tail.load(std::memory_order_relaxed);
+    while (!_overflowing.load(std::memory_order_acquire)) {
+        if ((pos & closed_bit) != 0) {
+            return false;
+        }
+        Slot &slot = _slots[pos & _mask];
+        int64_t diff = int64_t(slot.seq.load(std::memory_order_acquire) - pos);
+        if (diff == 0) {
+            if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.packet = packet;
+                slot.context = context;
+                slot.seq.store(pos + 1, std::memory_order_seq_cst);
+                wakeup = wakeConsumer(pos + 1 - _head.load(std::memory_order_relaxed), eventsBeforeWakeup);
+                return true;
+            }
+        } else if (diff < 0) {
+            break; // ring buffer is full
+        } else {
+            pos = _tail.load(std::memory_order_relaxed);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        if ((_tail.load(std::memory_order_relaxed) & closed_bit) != 0) {
+            return false;
+        }
+        _overflow.QueuePacket_NoLock(packet, context);
+        _overflowing.store(true, std::memory_order_seq_cst);
+    }
+    wakeup = wakeConsumer(std::numeric_limits<uint64_t>::max(), eventsBeforeWakeup);
+    return true;
+}
+
+
+bool
+FNET_EventQueue::empty() const
+{
+    uint64_t head = _head.load(std::memory_order_relaxed);
+    return ((_slots[head & _mask].seq.load(std::memory_order_seq_cst) != (head + 1)) &&
+            !_overflowing.load(std::memory_order_seq_cst));
+}
+
+
+bool
+FNET_EventQueue::prepareSleep()
+{
+    _sleeping.store(true, std::memory_order_seq_cst);
+    if (!empty()) {
+        _sleeping.store(false, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+
+bool
+FNET_EventQueue::consumeSlot(uint64_t pos, FNET_PacketQueue_NoLock &dst)
+{
+    Slot &slot = _slots[pos & _mask];
+    if (slot.seq.load(std::memory_order_acquire) != (pos + 1)) {
+        return false;
+    }
+    dst.QueuePacket_NoLock(slot.packet, slot.context);
+    slot.seq.store(pos + _mask + 1, std::memory_order_release);
+    return true;
+}
+
+
+void
+FNET_EventQueue::flushAll(FNET_PacketQueue_NoLock &dst)
+{
+    // Events claimed in the ring buffer before the overflow queue was
+    // used must be consumed first to keep the order of each producer.
+    uint64_t tail = (_tail.load(std::memory_order_acquire) & ~closed_bit);
+    uint64_t head = _head.load(std::memory_order_relaxed);
+    for (; head != tail; ++head) {
+        while (!consumeSlot(head, dst)) {
+            std::this_thread::yield(); // producer is publishing the event
+        }
+    }
+    _head.store(head, std::memory_order_relaxed);
+    _overflow.FlushPackets_NoLock(&dst);
+    _overflowing.store(false, std::memory_order_release);
+}
+
+
+void
+FNET_EventQueue::flush(FNET_PacketQueue_NoLock &dst)
+{
+    uint64_t head = _head.load(std::memory_order_relaxed);
+    uint64_t end = head + _mask + 1;
+    while ((head != end) && consumeSlot(head, dst)) {
+        ++head;
+    }
+    _head.store(head, std::memory_order_relaxed);
+    if (_overflowing.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> guard(_lock);
+        flushAll(dst);
+    }
+}
+
+
+void
+FNET_EventQueue::close(FNET_PacketQueue_NoLock &dst)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _tail.fetch_or(closed_bit, std::memory_order_acq_rel);
+    flushAll(dst);
+}
@@ -0,0 +1,109 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "context.h"
+#include "packetqueue.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+class FNET_ControlPacket;
+
+/**
+ * Lock-free multi-producer single-consumer queue used to post events
+ * (control packets with context) to a transport thread. Events are
+ * stored in a bounded ring buffer where each slot has a sequence
+ * number telling whether it is free or holds a published event, so
+ * posting an event neither locks nor allocates memory. If the ring
+ * buffer is full, events are put in an overflow queue protected by a
+ * lock until the consumer has caught up. Events posted by a single
+ * thread are always consumed in the order they were posted.
+ *
+ * The queue also keeps track of whether the consumer is about to
+ * block waiting for I/O. Producers only need to wake up the consumer
+ * when it is sleeping; an awake consumer will look at the queue
+ * before blocking again.
+ **/
+class FNET_EventQueue
+{
+private:
+    struct Slot {
+        std::atomic<uint64_t> seq;
+        FNET_ControlPacket   *packet;
+        FNET_Context          context;
+        Slot() noexcept : seq(0), packet(nullptr), context() {}
+    };
+    static constexpr uint64_t closed_bit = (uint64_t(1) << 63);
+
+    std::unique_ptr<Slot[]>  _slots;
+    uint64_t                 _mask;
+    alignas(64) std::atomic<uint64_t> _tail; // next position to claim, closed_bit when closed
+    alignas(64) std::atomic<uint64_t> _head; // next position to consume
+    std::atomic<bool>        _sleeping;      // consumer is (about to be) blocked
+    std::atomic<bool>        _overflowing;   // overflow queue is in use
+    std::mutex               _lock;          // protects the overflow queue
+    FNET_PacketQueue_NoLock  _overflow;
+
+    bool wakeConsumer(uint64_t depth, uint32_t eventsBeforeWakeup);
+    bool consumeSlot(uint64_t pos, FNET_PacketQueue_NoLock &dst);
+    void flushAll(FNET_PacketQueue_NoLock &dst);
+
+public:
+    /**
+     * @param capacity number of events that fit in the ring buffer,
+     *        must be a power of 2.
+     **/
+    explicit FNET_EventQueue(uint32_t capacity = 1024);
+    FNET_EventQueue(const FNET_EventQueue &) = delete;
+    FNET_EventQueue &operator=(const FNET_EventQueue &) = delete;
+    ~FNET_EventQueue();
+
+    /**
+     * Post an event on the queue. This method may be called by any
+     * thread.
+     *
+     * @return false if the queue is closed, in which case the event
+     *         was not queued.
+     * @param packet the event command
+     * @param context the event parameter
+     * @param eventsBeforeWakeup how many events should be queued
+     *        before waking up a sleeping consumer.
+     * @param wakeup set to true if the caller should wake up the
+     *        consumer. At most one producer is told to do so each
+     *        time the consumer goes to sleep.
+     **/
+    bool push(FNET_ControlPacket *packet, FNET_Context context,
+              uint32_t eventsBeforeWakeup, bool &wakeup);
+
+    /**
+     * Check whether there are any published events. Only the
+     * consumer may call this method.
+     **/
+    bool empty() const;
+
+    /**
+     * Called by the consumer before blocking. Returns false if events
+     * are already pending, in which case it should not block.
+     **/
+    bool prepareSleep();
+
+    /**
+     * Called by the consumer when it is done blocking.
+     **/
+    void endSleep() { _sleeping.store(false, std::memory_order_relaxed); }
+
+    /**
+     * Move all pending events to the given queue. Only the consumer
+     * may call this method.
+     **/
+    void flush(FNET_PacketQueue_NoLock &dst);
+
+    /**
+     * Close the queue and move all pending events to the given
+     * queue. Events posted after this are rejected. Only the consumer
+     * may call this method.
+     **/
+    void close(FNET_PacketQueue_NoLock &dst);
+};
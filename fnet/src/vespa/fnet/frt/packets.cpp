@@ -4,6 +4,7 @@
 #include "rpcrequest.h"
 #include <vespa/fnet/info.h>
 #include <vespa/fnet/databuffer.h>
+#include <vespa/fnet/output_refs.h>
 #include <vespa/vespalib/util/stringfmt.h>
 
 
@@ -37,7 +38,7 @@ FRT_RPCRequestPacket::GetLength()
 
 
 void
-FRT_RPCRequestPacket::Encode(FNET_DataBuffer *dst)
+FRT_RPCRequestPacket::encode(FNET_DataBuffer *dst, FNET_OutputRefs *refs)
 {
     uint32_t packet_endian = ((_flags & FLAG_FRT_RPC_LITTLE_ENDIAN) != 0)
                              ? FNET_Info::ENDIAN_LITTLE : FNET_Info::ENDIAN_BIG;
@@ -48,17 +49,32 @@ FRT_RPCRequestPacket::Encode(FNET_DataBuffer *dst)
         dst->WriteBytesFast(&tmp, sizeof(tmp));
         dst->WriteBytesFast(_req->GetMethodName(),
                             _req->GetMethodNameLen());
-        _req->GetParams()->EncodeCopy(dst);
+        _req->GetParams()->EncodeCopy(dst, refs);
     } else {
         assert(packet_endian == FNET_Info::ENDIAN_BIG);
         dst->WriteInt32Fast(_req->GetMethodNameLen());
         dst->WriteBytesFast(_req->GetMethodName(),
                             _req->GetMethodNameLen());
-        _req->GetParams()->EncodeBig(dst);
+        _req->GetParams()->EncodeBig(dst, refs);
     }
 }
 
 
+void
+FRT_RPCRequestPacket::Encode(FNET_DataBuffer *dst)
+{
+    encode(dst, nullptr);
+}
+
+
+void
+FRT_RPCRequestPacket::EncodeVectored(FNET_DataBuffer *dst, FNET_OutputRefs &refs)
+{
+    dst->EnsureFree(GetLength() - _req->GetParams()->GetReferencedLength(refs.threshold()));
+    encode(dst, &refs);
+}
+
+
 bool
 FRT_RPCRequestPacket::Decode(FNET_DataBuffer *src, uint32_t len)
 {
@@ -119,21 +135,36 @@ FRT_RPCReplyPacket::GetLength()
 
 
 void
-FRT_RPCReplyPacket::Encode(FNET_DataBuffer *dst)
+FRT_RPCReplyPacket::encode(FNET_DataBuffer *dst, FNET_OutputRefs *refs)
 {
     uint32_t packet_endian = ((_flags & FLAG_FRT_RPC_LITTLE_ENDIAN) != 0)
                              ? FNET_Info::ENDIAN_LITTLE : FNET_Info::ENDIAN_BIG;
     uint32_t host_endian = FNET_Info::GetEndian();
 
     if (packet_endian == host_endian) {
-        _req->GetReturn()->EncodeCopy(dst);
+        _req->GetReturn()->EncodeCopy(dst, refs);
     } else {
         assert(packet_endian == FNET_Info::ENDIAN_BIG);
-        _req->GetReturn()->EncodeBig(dst);
+        _req->GetReturn()->EncodeBig(dst, refs);
     }
 }
 
 
+void
+FRT_RPCReplyPacket::Encode(FNET_DataBuffer *dst)
+{
+    encode(dst, nullptr);
+}
+
+
+void
+FRT_RPCReplyPacket::EncodeVectored(FNET_DataBuffer *dst, FNET_OutputRefs &refs)
+{
+    dst->EnsureFree(GetLength() - _req->GetReturn()->GetReferencedLength(refs.threshold()));
+    encode(dst, &refs);
+}
+
+
 bool
 FRT_RPCReplyPacket::Decode(FNET_DataBuffer *src, uint32_t len)
 {
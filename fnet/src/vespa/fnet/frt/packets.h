@@ -51,6 +51,8 @@ public:
 
 class FRT_RPCRequestPacket : public FRT_RPCPacket
 {
+private:
+    void encode(FNET_DataBuffer *dst, FNET_OutputRefs *refs);
 public:
     FRT_RPCRequestPacket(FRT_RPCRequest *req,
                          uint32_t flags,
@@ -60,6 +62,7 @@ public:
     uint32_t GetPCODE() override;
     uint32_t GetLength() override;
     void Encode(FNET_DataBuffer *dst) override;
+    void EncodeVectored(FNET_DataBuffer *dst, FNET_OutputRefs &refs) override;
     bool Decode(FNET_DataBuffer *src, uint32_t len) override;
     vespalib::string Print(uint32_t indent = 0) override;
 };
@@ -67,6 +70,8 @@ public:
 
 class FRT_RPCReplyPacket : public FRT_RPCPacket
 {
+private:
+    void encode(FNET_DataBuffer *dst, FNET_OutputRefs *refs);
 public:
     FRT_RPCReplyPacket(FRT_RPCRequest *req,
                        uint32_t flags,
@@ -76,6 +81,7 @@ public:
     uint32_t GetPCODE() override;
     uint32_t GetLength() override;
     void Encode(FNET_DataBuffer *dst) override;
+    void EncodeVectored(FNET_DataBuffer *dst, FNET_OutputRefs &refs) override;
     bool Decode(FNET_DataBuffer *src, uint32_t len) override;
     vespalib::string Print(uint32_t indent = 0) override;
 };
@@ -2,6 +2,7 @@
 
 #include "values.h"
 #include <vespa/fnet/databuffer.h>
+#include <vespa/fnet/output_refs.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/stash.h>
 #include <vespa/vespalib/data/databuffer.h>
@@ -26,6 +27,14 @@ char * copyData(char *dst, const void *src, size_t len) {
     return dst;
 }
 
+void writeData(FNET_DataBuffer *dst, FNET_OutputRefs *refs, const char *buf, uint32_t len) {
+    if ((refs != nullptr) && refs->useRef(len)) {
+        refs->reference(*dst, buf, len);
+    } else {
+        dst->WriteBytesFast(buf, len);
+    }
+}
+
 using vespalib::alloc::Alloc;
 class LocalBlob : public FRT_ISharedBlob
 {
@@ -73,6 +82,7 @@ private:
 
 using fnet::BlobRef;
 using fnet::LocalBlob;
+using fnet::writeData;
 
 FRT_Values::FRT_Values(Stash &stash)
     : _maxValues(0),
@@ -495,6 +505,32 @@ FRT_Values::GetLength()
 }
 
 
+uint32_t
+FRT_Values::GetReferencedLength(uint32_t threshold)
+{
+    if (threshold == 0) {
+        return 0;
+    }
+    uint32_t len = 0;
+    for (uint32_t i = 0; i < _numValues; i++) {
+        if (_typeString[i] == FRT_VALUE_DATA) {
+            if (_values[i]._data._len >= threshold) {
+                len += _values[i]._data._len;
+            }
+        } else if (_typeString[i] == FRT_VALUE_DATA_ARRAY) {
+            uint32_t       num = _values[i]._data_array._len;
+            FRT_DataValue *pt  = _values[i]._data_array._pt;
+            for (; num > 0; num--, pt++) {
+                if (pt->_len >= threshold) {
+                    len += pt->_len;
+                }
+            }
+        }
+    }
+    return len;
+}
+
+
 bool
 FRT_Values::DecodeCopy(FNET_DataBuffer *src, uint32_t len)
 {
@@ -1237,7 +1273,7 @@ error:
 
 
 void
-FRT_Values::EncodeCopy(FNET_DataBuffer *dst)
+FRT_Values::EncodeCopy(FNET_DataBuffer *dst, FNET_OutputRefs *refs)
 {
     uint32_t numValues = _numValues;
     const char *p = _typeString;
@@ -1354,8 +1390,7 @@ FRT_Values::EncodeCopy(FNET_DataBuffer *dst)
 
         case FRT_VALUE_DATA:
             dst->WriteBytesFast(&(_values[i]._data._len), sizeof(uint32_t));
-            dst->WriteBytesFast(_values[i]._data._buf,
-                                _values[i]._data._len);
+            writeData(dst, refs, _values[i]._data._buf, _values[i]._data._len);
             break;
 
         case FRT_VALUE_DATA_ARRAY:
@@ -1366,7 +1401,7 @@ FRT_Values::EncodeCopy(FNET_DataBuffer *dst)
             dst->WriteBytesFast(&len, sizeof(len));
             for (; len > 0; len--, pt++) {
                 dst->WriteBytesFast(&(pt->_len), sizeof(uint32_t));
-                dst->WriteBytesFast(pt->_buf, pt->_len);
+                writeData(dst, refs, pt->_buf, pt->_len);
             }
         }
         break;
@@ -1379,7 +1414,7 @@ FRT_Values::EncodeCopy(FNET_DataBuffer *dst)
 
 
 void
-FRT_Values::EncodeBig(FNET_DataBuffer *dst)
+FRT_Values::EncodeBig(FNET_DataBuffer *dst, FNET_OutputRefs *refs)
 {
     uint32_t numValues = _numValues;
     const char *p = _typeString;
@@ -1504,8 +1539,7 @@ FRT_Values::EncodeBig(FNET_DataBuffer *dst)
 
         case FRT_VALUE_DATA:
             dst->WriteInt32Fast(_values[i]._data._len);
-            dst->WriteBytesFast(_values[i]._data._buf,
-                                _values[i]._data._len);
+            writeData(dst, refs, _values[i]._data._buf, _values[i]._data._len);
             break;
 
         case FRT_VALUE_DATA_ARRAY:
@@ -1516,7 +1550,7 @@ FRT_Values::EncodeBig(FNET_DataBuffer *dst)
             dst->WriteInt32Fast(len);
             for (; len > 0; len--, pt++) {
                 dst->WriteInt32Fast(pt->_len);
-                dst->WriteBytesFast(pt->_buf, pt->_len);
+                writeData(dst, refs, pt->_buf, pt->_len);
             }
         }
         break;
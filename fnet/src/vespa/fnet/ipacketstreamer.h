@@ -5,6 +5,7 @@
 #include "context.h"
 
 class FNET_DataBuffer;
+class FNET_OutputRefs;
 class FNET_Packet;
 
 /**
@@ -81,5 +82,24 @@ public:
      **/
     virtual void Encode(FNET_Packet *packet, uint32_t chid,
                         FNET_DataBuffer *dst) = 0;
+
+    /**
+     * This method is called to stream a packet to the given
+     * databuffer, allowing large chunks of packet data to be
+     * referenced in place through the given output refs (see @ref
+     * FNET_Packet::EncodeVectored). The default implementation
+     * references nothing and simply invokes @ref Encode.
+     *
+     * @param packet the packet to stream
+     * @param chid channel id for packet
+     * @param dst the target buffer for streaming
+     * @param refs where to reference data
+     **/
+    virtual void EncodeVectored(FNET_Packet *packet, uint32_t chid,
+                                FNET_DataBuffer *dst, FNET_OutputRefs &refs)
+    {
+        (void) refs;
+        Encode(packet, chid, dst);
+    }
 };
 
@@ -0,0 +1,220 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "output_refs.h"
+#include "databuffer.h"
+#include "packet.h"
+#include <algorithm>
+#include <cassert>
+#include <sys/uio.h>
+
+namespace {
+
+// sequence numbers wrap around
+bool seq_before(uint32_t seq, uint32_t limit) {
+    return (int32_t(seq - limit) < 0);
+}
+
+}
+
+FNET_OutputRefs::FNET_OutputRefs(uint32_t threshold)
+    : _threshold(threshold),
+      _refs(),
+      _held(),
+      _gapTotal(0),
+      _pendingBytes(0),
+      _unowned(0),
+      _nextSeq(0),
+      _completedSeq(0)
+{
+}
+
+
+FNET_OutputRefs::~FNET_OutputRefs()
+{
+    discard();
+}
+
+
+void
+FNET_OutputRefs::release(Ref &ref)
+{
+    if (ref.owner == nullptr) {
+        if (ref.zero_copy && !_refs.empty()) {
+            // data of this ref belongs to the packet owning a later ref
+            Ref &next = _refs.front();
+            if (!next.zero_copy) {
+                next.zero_copy = true;
+                next.seq = ref.seq;
+            }
+        }
+        return;
+    }
+    if (ref.zero_copy && !seq_before(ref.seq, _completedSeq)) {
+        _held.emplace_back(ref.seq, ref.owner);
+    } else {
+        ref.owner->Free();
+    }
+    ref.owner = nullptr;
+}
+
+
+void
+FNET_OutputRefs::reference(FNET_DataBuffer &output, const char *data, uint32_t len)
+{
+    if (len == 0) {
+        return;
+    }
+    assert(output.GetDataLen() >= _gapTotal);
+    uint32_t gap = output.GetDataLen() - _gapTotal;
+    _refs.emplace_back(gap, data, len);
+    _gapTotal += gap;
+    _pendingBytes += len;
+    ++_unowned;
+}
+
+
+bool
+FNET_OutputRefs::hold(FNET_Packet *packet)
+{
+    if (_unowned == 0) {
+        return false;
+    }
+    _refs.back().owner = packet;
+    _unowned = 0;
+    return true;
+}
+
+
+int
+FNET_OutputRefs::fill(FNET_DataBuffer &output, struct iovec *iov, int maxcnt, uint32_t stopLen) const
+{
+    char *pos = output.GetData();
+    int cnt = 0;
+    for (const Ref &ref : _refs) {
+        if (ref.gap > 0) {
+            if (cnt == maxcnt) {
+                return cnt;
+            }
+            iov[cnt].iov_base = pos;
+            iov[cnt].iov_len = ref.gap;
+            pos += ref.gap;
+            ++cnt;
+        }
+        if ((cnt == maxcnt) || ((stopLen > 0) && (ref.len >= stopLen) && (cnt > 0))) {
+            return cnt;
+        }
+        iov[cnt].iov_base = const_cast<char *>(ref.data);
+        iov[cnt].iov_len = ref.len;
+        ++cnt;
+    }
+    uint32_t tail = output.GetDataLen() - _gapTotal;
+    if ((tail > 0) && (cnt < maxcnt)) {
+        iov[cnt].iov_base = pos;
+        iov[cnt].iov_len = tail;
+        ++cnt;
+    }
+    return cnt;
+}
+
+
+bool
+FNET_OutputRefs::headRef(uint32_t minLen, const char *&data, uint32_t &len) const
+{
+    if (_refs.empty()) {
+        return false;
+    }
+    const Ref &ref = _refs.front();
+    if ((ref.gap > 0) || (ref.len < minLen)) {
+        return false;
+    }
+    data = ref.data;
+    len = ref.len;
+    return true;
+}
+
+
+void
+FNET_OutputRefs::consume(FNET_DataBuffer &output, size_t written)
+{
+    while ((written > 0) && !_refs.empty()) {
+        Ref &ref = _refs.front();
+        if (ref.gap > 0) {
+            uint32_t n = std::min(size_t(ref.gap), written);
+            output.DataToDead(n);
+            ref.gap -= n;
+            _gapTotal -= n;
+            written -= n;
+            if (written == 0) {
+                break;
+            }
+        }
+        uint32_t n = std::min(size_t(ref.len), written);
+        ref.data += n;
+        ref.len -= n;
+        _pendingBytes -= n;
+        written -= n;
+        if (ref.len == 0) {
+            Ref done = ref;
+            _refs.pop_front();
+            release(done);
+        }
+    }
+    if (written > 0) {
+        assert(written <= output.GetDataLen());
+        output.DataToDead(written);
+    }
+}
+
+
+void
+FNET_OutputRefs::consumeZeroCopy(size_t written, uint32_t seq)
+{
+    assert(!_refs.empty());
+    Ref &ref = _refs.front();
+    assert((ref.gap == 0) && (written <= ref.len));
+    ref.zero_copy = true;
+    ref.seq = seq;
+    _nextSeq = seq + 1;
+    ref.data += written;
+    ref.len -= written;
+    _pendingBytes -= written;
+    if (ref.len == 0) {
+        Ref done = ref;
+        _refs.pop_front();
+        release(done);
+    }
+}
+
+
+void
+FNET_OutputRefs::completed(uint32_t seq)
+{
+    if (seq_before(seq, _completedSeq)) {
+        return;
+    }
+    _completedSeq = seq + 1;
+    while (!_held.empty() && seq_before(_held.front().seq, _completedSeq)) {
+        _held.front().packet->Free();
+        _held.pop_front();
+    }
+}
+
+
+void
+FNET_OutputRefs::discard()
+{
+    while (!_refs.empty()) {
+        Ref &ref = _refs.front();
+        if (ref.owner != nullptr) {
+            ref.owner->Free();
+        }
+        _refs.pop_front();
+    }
+    for (const Held &held : _held) {
+        held.packet->Free();
+    }
+    _held.clear();
+    _gapTotal = 0;
+    _pendingBytes = 0;
+    _unowned = 0;
+}
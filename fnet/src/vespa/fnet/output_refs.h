@@ -0,0 +1,135 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+
+class FNET_DataBuffer;
+class FNET_Packet;
+struct iovec;
+
+/**
+ * Keeps track of data that is part of the outgoing byte stream of a
+ * connection, but that is referenced in place instead of being copied
+ * into the output databuffer. Packets may reference large chunks of
+ * data (like blobs in rpc values) while encoding themselves, and the
+ * output stream is then made up of the data in the output databuffer
+ * interleaved with the referenced data. Each reference remembers how
+ * many bytes of the output databuffer precede it. A packet holding
+ * references must be handed over with @ref hold after encoding; it
+ * will be freed when all its referenced data has been written (and
+ * when using zero copy send; when the send has completed).
+ *
+ * Note that only the contents of the data part of the output
+ * databuffer is used (by offset), which means that the databuffer is
+ * allowed to relocate its data while packets are being encoded.
+ **/
+class FNET_OutputRefs
+{
+private:
+    struct Ref {
+        uint32_t     gap;   // output databuffer bytes preceding this ref
+        const char  *data;
+        uint32_t     len;
+        FNET_Packet *owner; // set on the last ref of a packet
+        bool         zero_copy;
+        uint32_t     seq;   // last zero copy send covering this ref
+        Ref(uint32_t gap_in, const char *data_in, uint32_t len_in) noexcept
+            : gap(gap_in), data(data_in), len(len_in), owner(nullptr), zero_copy(false), seq(0) {}
+    };
+    struct Held {
+        uint32_t     seq;
+        FNET_Packet *packet;
+        Held(uint32_t seq_in, FNET_Packet *packet_in) noexcept : seq(seq_in), packet(packet_in) {}
+    };
+
+    uint32_t          _threshold;
+    std::deque<Ref>   _refs;
+    std::deque<Held>  _held;
+    uint32_t          _gapTotal;
+    uint64_t          _pendingBytes;
+    uint32_t          _unowned;
+    uint32_t          _nextSeq;
+    uint32_t          _completedSeq; // all sends before this have completed
+
+    void release(Ref &ref);
+
+public:
+    /**
+     * @param threshold minimum size of data to reference rather than
+     *        copy, 0 means nothing should be referenced.
+     **/
+    explicit FNET_OutputRefs(uint32_t threshold);
+    FNET_OutputRefs(const FNET_OutputRefs &) = delete;
+    FNET_OutputRefs &operator=(const FNET_OutputRefs &) = delete;
+    ~FNET_OutputRefs();
+
+    uint32_t threshold() const { return _threshold; }
+
+    /**
+     * @return whether data of the given size should be referenced.
+     **/
+    bool useRef(uint32_t len) const { return ((_threshold > 0) && (len >= _threshold)); }
+
+    /**
+     * Append a reference to the given data to the output stream,
+     * after everything currently in the output databuffer. The data
+     * must stay valid until the packet being encoded is freed.
+     **/
+    void reference(FNET_DataBuffer &output, const char *data, uint32_t len);
+
+    /**
+     * Take ownership of a packet that has just been encoded. Returns
+     * false if the packet did not reference any data, in which case
+     * the caller should free it as usual.
+     **/
+    bool hold(FNET_Packet *packet);
+
+    bool empty() const { return _refs.empty(); }
+    uint64_t pendingBytes() const { return _pendingBytes; }
+    size_t numHeld() const { return _held.size(); }
+
+    /**
+     * Fill in iovecs describing the pending output stream, starting
+     * with the data part of the output databuffer. If stopLen is
+     * given, filling stops in front of the first referenced data of
+     * at least that size not at the start of the stream, so that it
+     * can be sent by itself (using zero copy).
+     *
+     * @return number of iovecs used
+     **/
+    int fill(FNET_DataBuffer &output, struct iovec *iov, int maxcnt, uint32_t stopLen = 0) const;
+
+    /**
+     * Check if the output stream currently starts with referenced
+     * data of at least the given size. If so, the data is returned.
+     **/
+    bool headRef(uint32_t minLen, const char *&data, uint32_t &len) const;
+
+    /**
+     * Consume bytes written from the start of the output stream. If
+     * the bytes were sent using zero copy, the sequence number of the
+     * send should be given.
+     **/
+    void consume(FNET_DataBuffer &output, size_t written);
+    void consumeZeroCopy(size_t written, uint32_t seq);
+
+    /**
+     * @return sequence number to use for the next zero copy send
+     **/
+    uint32_t nextSeq() const { return _nextSeq; }
+
+    /**
+     * Free packets waiting for zero copy sends up to and including
+     * the given sequence number to complete.
+     **/
+    void completed(uint32_t seq);
+
+    /**
+     * Free all packets and drop all references, typically done when
+     * the connection is closed.
+     **/
+    void discard();
+};
@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "packet.h"
+#include "databuffer.h"
 #include <vespa/vespalib/util/stringfmt.h>
 
 vespalib::string
@@ -12,3 +13,11 @@ FNET_Packet::Print(uint32_t indent)
            IsControlPacket()? "true" : "false",
            GetPCODE(), GetCommand(), GetLength());
 }
+
+
+void
+FNET_Packet::EncodeVectored(FNET_DataBuffer *dst, FNET_OutputRefs &)
+{
+    dst->EnsureFree(GetLength());
+    Encode(dst);
+}
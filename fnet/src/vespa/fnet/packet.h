@@ -6,6 +6,7 @@
 #include <memory>
 
 class FNET_DataBuffer;
+class FNET_OutputRefs;
 
 /**
  * This is a general superclass of all packets. Packets are used to
@@ -137,6 +138,21 @@ public:
     virtual void Encode(FNET_DataBuffer *dst) = 0;
 
 
+    /**
+     * Encode this packet into a DataBuffer, with the option of
+     * referencing large chunks of data in place through the given
+     * output refs instead of copying them. Referenced data must stay
+     * valid until this packet is freed. Unlike @ref Encode, this
+     * method must ensure that the databuffer has enough free space
+     * for the data that is copied. The default implementation
+     * references nothing and simply invokes @ref Encode.
+     *
+     * @param dst the target databuffer
+     * @param refs where to reference data
+     **/
+    virtual void EncodeVectored(FNET_DataBuffer *dst, FNET_OutputRefs &refs);
+
+
     /**
      * Decode data from the given DataBuffer and store that information
      * in this object. This method may only be called on regular
@@ -66,3 +66,18 @@ FNET_SimplePacketStreamer::Encode(FNET_Packet *packet, uint32_t chid,
     packet->Encode(dst);
     dst->AssertValid();
 }
+
+
+void
+FNET_SimplePacketStreamer::EncodeVectored(FNET_Packet *packet, uint32_t chid,
+                                          FNET_DataBuffer *dst, FNET_OutputRefs &refs)
+{
+    uint32_t len   = packet->GetLength();
+    uint32_t pcode = packet->GetPCODE();
+    dst->EnsureFree(3 * sizeof(uint32_t));
+    dst->WriteInt32Fast(len + 2 * sizeof(uint32_t));
+    dst->WriteInt32Fast(pcode);
+    dst->WriteInt32Fast(chid);
+    packet->EncodeVectored(dst, refs);
+    dst->AssertValid();
+}
@@ -84,6 +84,16 @@ public:
         _config._drop_empty_buffers = v;
         return *this;
     }
+    // blobs of at least this size are sent in place, 0 means always copy
+    TransportConfig &vectored_write_threshold(uint32_t v) {
+        _config._vectoredWriteThreshold = v;
+        return *this;
+    }
+    // use MSG_ZEROCOPY for large blobs on unencrypted connections
+    TransportConfig &zero_copy(bool v) {
+        _config._zeroCopy = v;
+        return *this;
+    }
 
 private:
     FNET_Config                 _config;
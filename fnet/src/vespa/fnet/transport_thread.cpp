@@ -116,18 +116,12 @@ bool
 FNET_TransportThread::PostEvent(FNET_ControlPacket *cpacket,
                                 FNET_Context context)
 {
-    size_t qLen;
-    {
-        std::unique_lock<std::mutex> guard(_lock);
-        if (IsShutDown()) {
-            guard.unlock();
-            SafeDiscardEvent(cpacket, context);
-            return false;
-        }
-        _queue.QueuePacket_NoLock(cpacket, context);
-        qLen = _queue.GetPacketCnt_NoLock();
+    bool wakeup = false;
+    if (IsShutDown() || !_queue.push(cpacket, context, getConfig()._events_before_wakeup, wakeup)) {
+        SafeDiscardEvent(cpacket, context);
+        return false;
     }
-    if (qLen == getConfig()._events_before_wakeup) {
+    if (wakeup) {
         _selector.wakeup();
     }
     return true;
@@ -242,7 +236,6 @@ FNET_TransportThread::FNET_TransportThread(FNET_Transport &owner_in)
       _selector(),
       _queue(),
       _myQueue(),
-      _lock(),
       _shutdownLock(),
       _shutdownCond(),
       _pseudo_thread(),
@@ -389,15 +382,7 @@ FNET_TransportThread::sync()
 void
 FNET_TransportThread::ShutDown(bool waitFinished)
 {
-    bool wasEmpty = false;
-    {
-        std::lock_guard<std::mutex> guard(_lock);
-        if (!IsShutDown()) {
-            _shutdown.store(true, std::memory_order_relaxed);
-            wasEmpty  = _queue.IsEmpty_NoLock();
-        }
-    }
-    if (wasEmpty) {
+    if (!_shutdown.exchange(true)) {
         _selector.wakeup();
     }
     if (waitFinished) {
@@ -432,10 +417,7 @@ FNET_TransportThread::InitEventLoop()
 void
 FNET_TransportThread::handle_wakeup()
 {
-    {
-        std::lock_guard<std::mutex> guard(_lock);
-        _queue.FlushPackets_NoLock(&_myQueue);
-    }
+    _queue.flush(_myQueue);
 
     FNET_Context context;
     FNET_Packet *packet = nullptr;
@@ -513,8 +495,13 @@ FNET_TransportThread::EventLoopIteration() {
 
     if (!IsShutDown()) {
         int msTimeout = vespalib::count_ms(time_tools().event_timeout());
+        // do not block if events were posted while we were awake
+        if (!_queue.prepareSleep()) {
+            msTimeout = 0;
+        }
         // obtain I/O events
         _selector.poll(msTimeout);
+        _queue.endSleep();
 
         // sample current time (performed once per event loop iteration)
         _now = time_tools().current_time();
@@ -522,7 +509,8 @@ FNET_TransportThread::EventLoopIteration() {
         // handle io-events
         auto dispatchResult = _selector.dispatch(*this);
 
-        if ((dispatchResult == vespalib::SelectorDispatchResult::NO_WAKEUP) && (getConfig()._events_before_wakeup > 1)) {
+        // producers do not wake us up while awake, always check for events
+        if (dispatchResult == vespalib::SelectorDispatchResult::NO_WAKEUP) {
             handle_wakeup();
         }
 
@@ -560,11 +548,8 @@ FNET_TransportThread::checkTimedoutComponents(vespalib::duration timeout) {
 
 void
 FNET_TransportThread::endEventLoop() {
-    // flush event queue
-    {
-        std::lock_guard<std::mutex> guard(_lock);
-        _queue.FlushPackets_NoLock(&_myQueue);
-    }
+    // flush event queue, rejecting further events
+    _queue.close(_myQueue);
 
     // discard remaining events
     FNET_Context context;
@@ -591,7 +576,7 @@ FNET_TransportThread::endEventLoop() {
            _componentsTail == nullptr &&
            _timeOutHead    == nullptr &&
            load_relaxed(_componentCnt) == 0 &&
-           _queue.IsEmpty_NoLock() &&
+           _queue.empty() &&
            _myQueue.IsEmpty_NoLock());
 
     {
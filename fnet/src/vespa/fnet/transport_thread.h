@@ -6,6 +6,7 @@
 #include "config.h"
 #include "task.h"
 #include "packetqueue.h"
+#include "event_queue.h"
 #include <vespa/fastos/thread.h>
 #include <vespa/vespalib/net/socket_handle.h>
 #include <vespa/vespalib/net/selector.h>
@@ -43,9 +44,8 @@ private:
     std::atomic<uint32_t>    _componentCnt;   // # of components
     FNET_IOComponent        *_deleteList;     // IOC delete list
     Selector                 _selector;       // I/O event generator
-    FNET_PacketQueue_NoLock  _queue;          // outer event queue
+    FNET_EventQueue          _queue;          // outer event queue (lock-free)
     FNET_PacketQueue_NoLock  _myQueue;        // inner event queue
-    std::mutex               _lock;           // protects the Q
     std::mutex               _shutdownLock;   // used for synchronization during shutdown
     std::condition_variable  _shutdownCond;   // used for synchronization during shutdown
     std::recursive_mutex     _pseudo_thread;  // used after transport thread has shut down
@@ -107,8 +107,8 @@ private:
      * Post an event (ControlPacket) on the transport thread event
      * queue. This is done to tell the transport thread that it needs to
      * do an operation that could not be performed in other threads due
-     * to thread-safety. If the event queue is empty, invoking this
-     * method will wake up the transport thread in order to reduce
+     * to thread-safety. If the transport thread is blocked waiting
+     * for I/O, invoking this method will wake it up in order to reduce
      * latency. Note that when posting events that have a reference
      * counted object as parameter you need to increase the reference
      * counter to ensure that the object will not be deleted before the
@@ -0,0 +1,753 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/document/config/documenttypes_config_fwd.h>
+#include <vespa/document/repo/configbuilder.h>
+#include <vespa/document/repo/document_type_repo_factory.h>
+#include <vespa/document/repo/documenttyperepo.h>
+#include <vespa/document/datatype/datatype.h>
+#include <vespa/vespalib/util/signalhandler.h>
+#include <vespa/searchcore/bmcluster/avg_sampler.h>
+#include <vespa/searchcore/bmcluster/bm_cluster.h>
+#include <vespa/searchcore/bmcluster/bm_cluster_params.h>
+#include <vespa/searchcore/bmcluster/bm_feed.h>
+#include <vespa/searchcore/bmcluster/bm_feeder.h>
+#include <vespa/searchcore/bmcluster/bm_feed_params.h>
+#include <vespa/searchcore/bmcluster/bm_node.h>
+#include <vespa/searchcore/bmcluster/bm_node_stats_reporter.h>
+#include <vespa/searchcore/bmcluster/bm_range.h>
+#include <vespa/searchcore/bmcluster/bucket_selector.h>
+#include <vespa/searchcore/proton/matchengine/matchengine.h>
+#include <vespa/searchcore/proton/matching/matching_stats.h>
+#include <vespa/searchcore/proton/summaryengine/isearchhandler.h>
+#include <vespa/searchcore/proton/summaryengine/summaryengine.h>
+#include <vespa/searchlib/engine/docsumreply.h>
+#include <vespa/searchlib/engine/docsumrequest.h>
+#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/searchlib/index/dummyfileheadercontext.h>
+#include <vespa/searchlib/query/tree/querybuilder.h>
+#include <vespa/searchlib/query/tree/simplequery.h>
+#include <vespa/searchlib/query/tree/stackdumpcreator.h>
+#include <vespa/vespalib/data/slime/inspector.h>
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <getopt.h>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unistd.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP("vespa-query-bm");
+
+using namespace proton;
+using namespace std::chrono_literals;
+
+using document::DocumentTypeRepo;
+using document::DocumentTypeRepoFactory;
+using search::bmcluster::AvgSampler;
+using search::bmcluster::BmClusterParams;
+using search::bmcluster::BmCluster;
+using search::bmcluster::BmFeed;
+using search::bmcluster::BmFeedParams;
+using search::bmcluster::BmFeeder;
+using search::bmcluster::BmNode;
+using search::bmcluster::BmNodeStatsReporter;
+using search::bmcluster::BmRange;
+using search::bmcluster::BucketSelector;
+using search::engine::DocsumReply;
+using search::engine::DocsumRequest;
+using search::engine::SearchReply;
+using search::engine::SearchRequest;
+using search::index::DummyFileHeaderContext;
+using search::query::QueryBuilder;
+using search::query::Range;
+using search::query::SimpleQueryNodeTypes;
+using search::query::StackDumpCreator;
+using search::query::Weight;
+
+namespace {
+
+vespalib::string base_dir = "testdb";
+constexpr int base_port = 9017;
+
+std::shared_ptr<DocumenttypesConfig> make_document_types() {
+    using Struct = document::config_builder::Struct;
+    using DataType = document::DataType;
+    document::config_builder::DocumenttypesConfigBuilderHelper builder;
+    builder.document(42, "test", Struct("test.header").addField("int", DataType::T_INT), Struct("test.body"));
+    return std::make_shared<DocumenttypesConfig>(builder.config());
+}
+
+class BMParams : public BmClusterParams,
+                 public BmFeedParams
+{
+    uint32_t         _hits;
+    uint32_t         _queries;
+    vespalib::string _query_file;
+    uint32_t         _query_passes;
+    uint32_t         _query_range;
+    uint32_t         _query_rate;
+    uint32_t         _query_threads;
+    vespalib::string _rank_profile;
+    bool             _skip_docsums;
+    uint32_t         _threads_per_search;
+public:
+    BMParams()
+        : BmClusterParams(),
+          BmFeedParams(),
+          _hits(10),
+          _queries(1000),
+          _query_file(),
+          _query_passes(3),
+          _query_range(100),
+          _query_rate(0),
+          _query_threads(1),
+          _rank_profile("default"),
+          _skip_docsums(false),
+          _threads_per_search(1)
+    {
+    }
+    uint32_t get_hits() const { return _hits; }
+    uint32_t get_queries() const { return _queries; }
+    const vespalib::string& get_query_file() const { return _query_file; }
+    uint32_t get_query_passes() const { return _query_passes; }
+    uint32_t get_query_range() const { return _query_range; }
+    uint32_t get_query_rate() const { return _query_rate; }
+    uint32_t get_query_threads() const { return _query_threads; }
+    const vespalib::string& get_rank_profile() const { return _rank_profile; }
+    bool get_skip_docsums() const { return _skip_docsums; }
+    uint32_t get_threads_per_search() const { return _threads_per_search; }
+    void set_hits(uint32_t hits_in) { _hits = hits_in; }
+    void set_queries(uint32_t queries_in) { _queries = queries_in; }
+    void set_query_file(vespalib::stringref query_file_in) { _query_file = query_file_in; }
+    void set_query_passes(uint32_t query_passes_in) { _query_passes = query_passes_in; }
+    void set_query_range(uint32_t query_range_in) { _query_range = query_range_in; }
+    void set_query_rate(uint32_t query_rate_in) { _query_rate = query_rate_in; }
+    void set_query_threads(uint32_t query_threads_in) { _query_threads = query_threads_in; }
+    void set_rank_profile(vespalib::stringref rank_profile_in) { _rank_profile = rank_profile_in; }
+    void set_skip_docsums(bool value) { _skip_docsums = value; }
+    void set_threads_per_search(uint32_t threads_in) { _threads_per_search = threads_in; }
+    bool check() const;
+};
+
+bool
+BMParams::check() const
+{
+    if (!BmClusterParams::check()) {
+        return false;
+    }
+    if (!BmFeedParams::check()) {
+        return false;
+    }
+    if (_query_file.empty() && _queries < 1) {
+        std::cerr << "Too few queries: " << _queries << std::endl;
+        return false;
+    }
+    if (_query_passes < 1) {
+        std::cerr << "Query passes too low: " << _query_passes << std::endl;
+        return false;
+    }
+    if (_query_range < 1) {
+        std::cerr << "Query range too low: " << _query_range << std::endl;
+        return false;
+    }
+    if (_query_threads < 1) {
+        std::cerr << "Too few query threads: " << _query_threads << std::endl;
+        return false;
+    }
+    if (_threads_per_search < 1) {
+        std::cerr << "Too few threads per search: " << _threads_per_search << std::endl;
+        return false;
+    }
+    if (get_groups() > 0 && !needs_distributor()) {
+        std::cerr << "grouped distribution only allowed when using distributor" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+ * A query to be replayed: serialized query stack dump and the rank
+ * profile to use.
+ */
+struct BmQuery {
+    vespalib::string rank_profile;
+    vespalib::string stack_dump;
+    BmQuery(vespalib::stringref rank_profile_in, vespalib::stringref stack_dump_in)
+        : rank_profile(rank_profile_in),
+          stack_dump(stack_dump_in)
+    {
+    }
+};
+
+int hex_digit(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+bool decode_hex(vespalib::stringref hex, vespalib::string& result) {
+    if ((hex.size() % 2) != 0) {
+        return false;
+    }
+    result.clear();
+    for (size_t i = 0; i < hex.size(); i += 2) {
+        int hi = hex_digit(hex[i]);
+        int lo = hex_digit(hex[i + 1]);
+        if (hi < 0 || lo < 0) {
+            return false;
+        }
+        result.push_back(static_cast<char>((hi << 4) | lo));
+    }
+    return true;
+}
+
+/*
+ * Reads queries from a file with one query per line, each line
+ * holding the name of the rank profile and the hex encoded query
+ * stack dump separated by whitespace. Empty lines and lines starting
+ * with '#' are ignored.
+ */
+std::vector<BmQuery> read_queries(const vespalib::string& file_name) {
+    std::vector<BmQuery> queries;
+    std::ifstream is(file_name.c_str());
+    if (!is) {
+        LOG(error, "Could not open query file '%s'", file_name.c_str());
+        return queries;
+    }
+    std::string line;
+    uint32_t line_no = 0;
+    vespalib::string stack_dump;
+    while (std::getline(is, line)) {
+        ++line_no;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        auto sep = line.find_first_of(" \t");
+        auto hex_start = (sep != std::string::npos) ? line.find_first_not_of(" \t", sep) : std::string::npos;
+        if (hex_start == std::string::npos) {
+            LOG(warning, "%s:%u: missing query stack dump, line ignored", file_name.c_str(), line_no);
+            continue;
+        }
+        auto hex_end = line.find_last_not_of(" \t\r");
+        if (!decode_hex(vespalib::stringref(line).substr(hex_start, hex_end + 1 - hex_start), stack_dump)) {
+            LOG(warning, "%s:%u: malformed query stack dump, line ignored", file_name.c_str(), line_no);
+            continue;
+        }
+        queries.emplace_back(vespalib::stringref(line).substr(0, sep), stack_dump);
+    }
+    return queries;
+}
+
+/*
+ * Makes range queries over the generated corpus, each matching
+ * query_range documents (when feeding a single pass).
+ */
+std::vector<BmQuery> make_queries(const BMParams& params) {
+    std::vector<BmQuery> queries;
+    uint32_t documents = params.get_documents();
+    uint32_t range = std::min(params.get_query_range(), documents);
+    for (uint32_t i = 0; i < params.get_queries(); ++i) {
+        uint32_t lo = (static_cast<uint64_t>(i) * 7919) % (documents - range + 1);
+        QueryBuilder<SimpleQueryNodeTypes> builder;
+        builder.addRangeTerm(Range(lo, lo + range - 1), "int", 1, Weight(100));
+        queries.emplace_back(params.get_rank_profile(), StackDumpCreator::create(*builder.build()));
+    }
+    return queries;
+}
+
+double to_ms(vespalib::duration d) {
+    return vespalib::count_ns(d) / 1000000.0;
+}
+
+/*
+ * Statistics for the queries run during a query pass.
+ */
+struct QueryPassStats {
+    std::vector<double> latencies; // ms
+    double              match_time;
+    double              docsum_time;
+    uint64_t            total_hits;
+    uint64_t            docsums;
+    uint32_t            failed;
+    QueryPassStats()
+        : latencies(),
+          match_time(0.0),
+          docsum_time(0.0),
+          total_hits(0),
+          docsums(0),
+          failed(0)
+    {
+    }
+    void merge(const QueryPassStats& rhs) {
+        latencies.insert(latencies.end(), rhs.latencies.begin(), rhs.latencies.end());
+        match_time += rhs.match_time;
+        docsum_time += rhs.docsum_time;
+        total_hits += rhs.total_hits;
+        docsums += rhs.docsums;
+        failed += rhs.failed;
+    }
+};
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t idx = std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()));
+    return sorted[idx];
+}
+
+}
+
+/*
+ * Match and summary engines for a benchmark node, using the same
+ * search handler as proton does for the document db.
+ */
+class QueryNode {
+    std::unique_ptr<MatchEngine>   _match_engine;
+    std::unique_ptr<SummaryEngine> _summary_engine;
+    BmNode&                        _node;
+public:
+    QueryNode(BmNode& node, uint32_t node_idx, const BMParams& params);
+    ~QueryNode();
+    std::unique_ptr<SearchReply> search(std::unique_ptr<SearchRequest> request) { return _match_engine->performSearch(std::move(request)); }
+    std::unique_ptr<DocsumReply> get_docsums(std::unique_ptr<DocsumRequest> request) { return _summary_engine->getDocsums(std::move(request)); }
+    matching::MatchingStats get_matching_stats(const vespalib::string& rank_profile) { return _node.get_matching_stats(rank_profile); }
+};
+
+QueryNode::QueryNode(BmNode& node, uint32_t node_idx, const BMParams& params)
+    : _match_engine(std::make_unique<MatchEngine>(params.get_query_threads(), params.get_threads_per_search(), node_idx, false)),
+      _summary_engine(std::make_unique<SummaryEngine>(params.get_query_threads(), false)),
+      _node(node)
+{
+    DocTypeName doc_type_name("test");
+    auto search_handler = node.get_search_handler();
+    _match_engine->putSearchHandler(doc_type_name, search_handler);
+    _summary_engine->putSearchHandler(doc_type_name, search_handler);
+    _match_engine->setNodeUp(true);
+}
+
+QueryNode::~QueryNode()
+{
+    _summary_engine->close();
+    _match_engine->close();
+}
+
+class Benchmark {
+    BMParams                                   _params;
+    std::shared_ptr<const DocumenttypesConfig> _document_types;
+    std::shared_ptr<const DocumentTypeRepo>    _repo;
+    std::unique_ptr<BmCluster>                 _cluster;
+    BmFeed                                     _feed;
+    std::vector<std::unique_ptr<QueryNode>>    _query_nodes;
+    std::vector<BmQuery>                       _queries;
+
+    struct Hit {
+        document::GlobalId gid;
+        search::HitRank    metric;
+        uint32_t           node_idx;
+        Hit(const document::GlobalId& gid_in, search::HitRank metric_in, uint32_t node_idx_in) noexcept
+            : gid(gid_in), metric(metric_in), node_idx(node_idx_in) {}
+    };
+
+    void feed();
+    void run_query(const BmQuery& query, vespalib::steady_time start_time, QueryPassStats& stats);
+    void query_task(std::atomic<uint32_t>& next_query, vespalib::steady_time pass_start_time, QueryPassStats& stats);
+    void benchmark_queries(uint32_t pass);
+    void report_matching_stats();
+public:
+    explicit Benchmark(const BMParams& params);
+    ~Benchmark();
+    void run();
+};
+
+Benchmark::Benchmark(const BMParams& params)
+    : _params(params),
+      _document_types(make_document_types()),
+      _repo(document::DocumentTypeRepoFactory::make(*_document_types)),
+      _cluster(std::make_unique<BmCluster>(base_dir, base_port, _params, _document_types, _repo)),
+      _feed(_repo),
+      _query_nodes(),
+      _queries()
+{
+    _cluster->make_nodes();
+}
+
+Benchmark::~Benchmark() = default;
+
+void
+Benchmark::feed()
+{
+    vespalib::ThreadStackExecutor executor(_params.get_client_threads(), 128_Ki);
+    BmFeeder feeder(_repo, *_cluster->get_feed_handler(), executor);
+    auto put_feed = _feed.make_feed(executor, _params, [this](BmRange range, BucketSelector bucket_selector) { return _feed.make_put_feed(range, bucket_selector); }, _feed.num_buckets(), "put");
+    int64_t time_bias = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch() - 24h).count();
+    AvgSampler sampler;
+    LOG(info, "--------------------------------");
+    LOG(info, "putAsync: %u small documents", _params.get_documents());
+    feeder.run_feed_tasks(0, time_bias, put_feed, _params, sampler, "put");
+    LOG(info, "putAsync: AVG put/s: %8.2f", sampler.avg());
+}
+
+void
+Benchmark::run_query(const BmQuery& query, vespalib::steady_time start_time, QueryPassStats& stats)
+{
+    std::vector<Hit> hits;
+    bool failed = false;
+    for (uint32_t node_idx = 0; node_idx < _query_nodes.size(); ++node_idx) {
+        auto request = std::make_unique<SearchRequest>();
+        request->setTimeout(10s);
+        request->ranking = query.rank_profile;
+        request->maxhits = _params.get_hits();
+        request->stackDump.assign(query.stack_dump.data(), query.stack_dump.data() + query.stack_dump.size());
+        auto reply = _query_nodes[node_idx]->search(std::move(request));
+        if (!reply || reply->my_issues) {
+            failed = true;
+            continue;
+        }
+        stats.total_hits += reply->totalHitCount;
+        for (const auto& hit : reply->hits) {
+            hits.emplace_back(hit.gid, hit.metric, node_idx);
+        }
+    }
+    auto match_done_time = vespalib::steady_clock::now();
+    std::sort(hits.begin(), hits.end(), [](const Hit& lhs, const Hit& rhs) { return lhs.metric > rhs.metric; });
+    if (hits.size() > _params.get_hits()) {
+        hits.erase(hits.begin() + _params.get_hits(), hits.end());
+    }
+    if (!_params.get_skip_docsums()) {
+        for (uint32_t node_idx = 0; node_idx < _query_nodes.size(); ++node_idx) {
+            auto request = std::make_unique<DocsumRequest>();
+            request->setTimeout(10s);
+            request->ranking = query.rank_profile;
+            request->resultClassName = "default";
+            for (const auto& hit : hits) {
+                if (hit.node_idx == node_idx) {
+                    request->hits.emplace_back(hit.gid);
+                }
+            }
+            if (request->hits.empty()) {
+                continue;
+            }
+            auto reply = _query_nodes[node_idx]->get_docsums(std::move(request));
+            if (!reply || reply->hasIssues()) {
+                failed = true;
+                continue;
+            }
+            stats.docsums += reply->root()["docsums"].entries();
+        }
+    }
+    auto end_time = vespalib::steady_clock::now();
+    stats.latencies.push_back(to_ms(end_time - start_time));
+    stats.match_time += to_ms(match_done_time - start_time);
+    stats.docsum_time += to_ms(end_time - match_done_time);
+    if (failed) {
+        ++stats.failed;
+    }
+}
+
+void
+Benchmark::query_task(std::atomic<uint32_t>& next_query, vespalib::steady_time pass_start_time, QueryPassStats& stats)
+{
+    uint32_t num_queries = _queries.size();
+    uint32_t rate = _params.get_query_rate();
+    for (;;) {
+        uint32_t query_idx = next_query.fetch_add(1, std::memory_order_relaxed);
+        if (query_idx >= num_queries) {
+            break;
+        }
+        auto start_time = vespalib::steady_clock::now();
+        if (rate != 0) {
+            // Latency is measured from when the query was scheduled to start, to include any queueing delay.
+            start_time = pass_start_time + std::chrono::duration_cast<vespalib::duration>(std::chrono::duration<double>(static_cast<double>(query_idx) / rate));
+            std::this_thread::sleep_until(start_time);
+        }
+        run_query(_queries[query_idx], start_time, stats);
+    }
+}
+
+void
+Benchmark::benchmark_queries(uint32_t pass)
+{
+    LOG(info, "--------------------------------");
+    LOG(info, "query pass %u: %zu queries, %u threads, %s", pass, _queries.size(), _params.get_query_threads(),
+        (_params.get_query_rate() != 0) ? vespalib::make_string("rate %u/s", _params.get_query_rate()).c_str() : "fixed concurrency");
+    std::atomic<uint32_t> next_query(0);
+    std::vector<QueryPassStats> thread_stats(_params.get_query_threads());
+    std::vector<std::thread> threads;
+    auto pass_start_time = vespalib::steady_clock::now();
+    for (auto& stats : thread_stats) {
+        threads.emplace_back([this, &next_query, pass_start_time, &stats]() { query_task(next_query, pass_start_time, stats); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double elapsed_s = vespalib::to_s(vespalib::steady_clock::now() - pass_start_time);
+    QueryPassStats stats;
+    for (const auto& s : thread_stats) {
+        stats.merge(s);
+    }
+    std::sort(stats.latencies.begin(), stats.latencies.end());
+    size_t num_queries = stats.latencies.size();
+    double avg_latency = 0.0;
+    for (double latency : stats.latencies) {
+        avg_latency += latency;
+    }
+    if (num_queries > 0) {
+        avg_latency /= num_queries;
+    }
+    LOG(info, "query pass %u: %8.2f queries/s (%zu queries in %.3f s, %u failed)", pass, num_queries / elapsed_s, num_queries, elapsed_s, stats.failed);
+    LOG(info, "query pass %u: latency ms: avg=%.3f p50=%.3f p90=%.3f p99=%.3f p99.9=%.3f max=%.3f", pass, avg_latency,
+        percentile(stats.latencies, 0.5), percentile(stats.latencies, 0.9), percentile(stats.latencies, 0.99),
+        percentile(stats.latencies, 0.999), stats.latencies.empty() ? 0.0 : stats.latencies.back());
+    LOG(info, "query pass %u: avg match ms=%.3f, avg docsum ms=%.3f, avg total hits=%.1f, avg docsums=%.1f", pass,
+        (num_queries > 0) ? stats.match_time / num_queries : 0.0,
+        (num_queries > 0) ? stats.docsum_time / num_queries : 0.0,
+        (num_queries > 0) ? static_cast<double>(stats.total_hits) / num_queries : 0.0,
+        (num_queries > 0) ? static_cast<double>(stats.docsums) / num_queries : 0.0);
+    report_matching_stats();
+}
+
+void
+Benchmark::report_matching_stats()
+{
+    std::set<vespalib::string> rank_profiles;
+    for (const auto& query : _queries) {
+        rank_profiles.insert(query.rank_profile);
+    }
+    for (const auto& rank_profile : rank_profiles) {
+        matching::MatchingStats stats;
+        for (auto& query_node : _query_nodes) {
+            stats.add(query_node->get_matching_stats(rank_profile));
+        }
+        LOG(info, "rank profile '%s': queries=%zu, docs matched=%zu, docs ranked=%zu, docs reranked=%zu, soft doomed=%zu",
+            rank_profile.c_str(), stats.queries(), stats.docsMatched(), stats.docsRanked(), stats.docsReRanked(), stats.softDoomed());
+        LOG(info, "rank profile '%s': avg ms: query setup=%.3f, match=%.3f, grouping=%.3f, rerank=%.3f, query latency=%.3f",
+            rank_profile.c_str(), stats.querySetupTimeAvg() * 1000.0, stats.matchTimeAvg() * 1000.0,
+            stats.groupingTimeAvg() * 1000.0, stats.rerankTimeAvg() * 1000.0, stats.queryLatencyAvg() * 1000.0);
+    }
+}
+
+void
+Benchmark::run()
+{
+    _queries = _params.get_query_file().empty() ? make_queries(_params) : read_queries(_params.get_query_file());
+    if (_queries.empty()) {
+        LOG(error, "No queries to run");
+        return;
+    }
+    _cluster->start(_feed);
+    BmNodeStatsReporter reporter(*_cluster, false);
+    reporter.start(500ms);
+    feed();
+    reporter.report_now();
+    reporter.stop();
+    for (uint32_t node_idx = 0; node_idx < _cluster->get_num_nodes(); ++node_idx) {
+        _query_nodes.emplace_back(std::make_unique<QueryNode>(*_cluster->get_node(node_idx), node_idx, _params));
+    }
+    report_matching_stats(); // Discard matching stats from before benchmark
+    for (uint32_t pass = 0; pass < _params.get_query_passes(); ++pass) {
+        benchmark_queries(pass);
+    }
+    LOG(info, "--------------------------------");
+    _query_nodes.clear();
+    _cluster->stop();
+}
+
+class App
+{
+    BMParams _bm_params;
+public:
+    App();
+    ~App();
+    void usage();
+    bool get_options(int argc, char **argv);
+    int main(int argc, char **argv);
+};
+
+App::App()
+    : _bm_params()
+{
+}
+
+App::~App() = default;
+
+void
+App::usage()
+{
+    std::cerr <<
+        "vespa-query-bm version 0.0\n"
+        "\n"
+        "USAGE:\n";
+    std::cerr <<
+        "vespa-query-bm\n"
+        "[--client-threads threads]\n"
+        "[--documents documents]\n"
+        "[--enable-distributor]\n"
+        "[--enable-service-layer]\n"
+        "[--hits hits]\n"
+        "[--indexing-sequencer [latency,throughput,adaptive]]\n"
+        "[--max-pending max-pending]\n"
+        "[--nodes-per-group nodes-per-group]\n"
+        "[--queries queries]\n"
+        "[--query-file file]\n"
+        "[--query-passes query-passes]\n"
+        "[--query-range range]\n"
+        "[--query-rate queries-per-second]\n"
+        "[--query-threads threads]\n"
+        "[--rank-profile rank-profile]\n"
+        "[--skip-docsums]\n"
+        "[--threads-per-search threads]\n"
+        "\n"
+        "Each line in the query file holds a rank profile name and a hex encoded\n"
+        "query stack dump, separated by whitespace. Without a query file, range\n"
+        "queries over the generated documents are used." << std::endl;
+}
+
+bool
+App::get_options(int argc, char **argv)
+{
+    int c;
+    int long_opt_index = 0;
+    static struct option long_opts[] = {
+        { "client-threads", 1, nullptr, 0 },
+        { "documents", 1, nullptr, 0 },
+        { "enable-distributor", 0, nullptr, 0 },
+        { "enable-service-layer", 0, nullptr, 0 },
+        { "hits", 1, nullptr, 0 },
+        { "indexing-sequencer", 1, nullptr, 0 },
+        { "max-pending", 1, nullptr, 0 },
+        { "nodes-per-group", 1, nullptr, 0 },
+        { "queries", 1, nullptr, 0 },
+        { "query-file", 1, nullptr, 0 },
+        { "query-passes", 1, nullptr, 0 },
+        { "query-range", 1, nullptr, 0 },
+        { "query-rate", 1, nullptr, 0 },
+        { "query-threads", 1, nullptr, 0 },
+        { "rank-profile", 1, nullptr, 0 },
+        { "skip-docsums", 0, nullptr, 0 },
+        { "threads-per-search", 1, nullptr, 0 },
+        { nullptr, 0, nullptr, 0 }
+    };
+    enum longopts_enum {
+        LONGOPT_CLIENT_THREADS,
+        LONGOPT_DOCUMENTS,
+        LONGOPT_ENABLE_DISTRIBUTOR,
+        LONGOPT_ENABLE_SERVICE_LAYER,
+        LONGOPT_HITS,
+        LONGOPT_INDEXING_SEQUENCER,
+        LONGOPT_MAX_PENDING,
+        LONGOPT_NODES_PER_GROUP,
+        LONGOPT_QUERIES,
+        LONGOPT_QUERY_FILE,
+        LONGOPT_QUERY_PASSES,
+        LONGOPT_QUERY_RANGE,
+        LONGOPT_QUERY_RATE,
+        LONGOPT_QUERY_THREADS,
+        LONGOPT_RANK_PROFILE,
+        LONGOPT_SKIP_DOCSUMS,
+        LONGOPT_THREADS_PER_SEARCH
+    };
+    optind = 1;
+    while ((c = getopt_long(argc, argv, "", long_opts, &long_opt_index)) != -1) {
+        switch (c) {
+        case 0:
+            switch(long_opt_index) {
+            case LONGOPT_CLIENT_THREADS:
+                _bm_params.set_client_threads(atoi(optarg));
+                break;
+            case LONGOPT_DOCUMENTS:
+                _bm_params.set_documents(atoi(optarg));
+                break;
+            case LONGOPT_ENABLE_DISTRIBUTOR:
+                _bm_params.set_enable_distributor(true);
+                break;
+            case LONGOPT_ENABLE_SERVICE_LAYER:
+                _bm_params.set_enable_service_layer(true);
+                break;
+            case LONGOPT_HITS:
+                _bm_params.set_hits(atoi(optarg));
+                break;
+            case LONGOPT_INDEXING_SEQUENCER:
+                _bm_params.set_indexing_sequencer(optarg);
+                break;
+            case LONGOPT_MAX_PENDING:
+                _bm_params.set_max_pending(atoi(optarg));
+                break;
+            case LONGOPT_NODES_PER_GROUP:
+                _bm_params.set_nodes_per_group(atoi(optarg));
+                break;
+            case LONGOPT_QUERIES:
+                _bm_params.set_queries(atoi(optarg));
+                break;
+            case LONGOPT_QUERY_FILE:
+                _bm_params.set_query_file(optarg);
+                break;
+            case LONGOPT_QUERY_PASSES:
+                _bm_params.set_query_passes(atoi(optarg));
+                break;
+            case LONGOPT_QUERY_RANGE:
+                _bm_params.set_query_range(atoi(optarg));
+                break;
+            case LONGOPT_QUERY_RATE:
+                _bm_params.set_query_rate(atoi(optarg));
+                break;
+            case LONGOPT_QUERY_THREADS:
+                _bm_params.set_query_threads(atoi(optarg));
+                break;
+            case LONGOPT_RANK_PROFILE:
+                _bm_params.set_rank_profile(optarg);
+                break;
+            case LONGOPT_SKIP_DOCSUMS:
+                _bm_params.set_skip_docsums(true);
+                break;
+            case LONGOPT_THREADS_PER_SEARCH:
+                _bm_params.set_threads_per_search(atoi(optarg));
+                break;
+            default:
+                return false;
+            }
+            break;
+        default:
+            return false;
+        }
+    }
+    return _bm_params.check();
+}
+
+int
+App::main(int argc, char **argv)
+{
+    if (!get_options(argc, argv)) {
+        usage();
+        return 1;
+    }
+    vespalib::rmdir(base_dir, true);
+    Benchmark bm(_bm_params);
+    bm.run();
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    vespalib::SignalHandler::PIPE.ignore();
+    DummyFileHeaderContext::setCreator("vespa-query-bm");
+    App app;
+    auto exit_value = app.main(argc, argv);
+    vespalib::rmdir(base_dir, true);
+    return exit_value;
+}
@@ -8,6 +8,7 @@
 #include <vespa/searchcore/proton/attribute/attributemanager.h>
 #include <vespa/searchcore/proton/common/hw_info.h>
 #include <vespa/searchcore/proton/test/test.h>
+#include <vespa/searchcommon/common/undefinedvalues.h>
 #include <vespa/searchlib/attribute/interlock.h>
 #include <vespa/searchlib/index/dummyfileheadercontext.h>
 #include <vespa/searchlib/test/directory_handler.h>
@@ -86,7 +87,10 @@ struct Fixture
           _ctx()
     {
         _mgr->addAttribute({ "a1", AVConfig(AVBasicType::INT32)}, CREATE_SERIAL_NUM);
-        _pop = std::make_unique<AttributePopulator>(_mgr, 1, "test", CREATE_SERIAL_NUM);
+        make_populator(1);
+    }
+    void make_populator(uint32_t commit_interval) {
+        _pop = std::make_unique<AttributePopulator>(_mgr, 1, "test", CREATE_SERIAL_NUM, commit_interval);
     }
     AttributeGuard::UP getAttr() {
         return _mgr->getAttribute("a1");
@@ -111,6 +115,24 @@ TEST_F("require that reprocess with document populates attribute", Fixture)
     EXPECT_EQUAL(CREATE_SERIAL_NUM, attr->get()->getStatus().getLastSyncToken());
 }
 
+TEST_F("require that reprocessed documents are committed in batches", Fixture)
+{
+    f.make_populator(2);
+    AttributeGuard::UP attr = f.getAttr();
+    int64_t undefined = search::attribute::getUndefined<int32_t>();
+    f._pop->handleExisting(5, f._ctx.create(0, 33));
+    EXPECT_EQUAL(6u, attr->get()->getNumDocs());
+    EXPECT_EQUAL(undefined, attr->get()->getInt(5));
+    f._pop->handleExisting(6, f._ctx.create(1, 44));
+    EXPECT_EQUAL(33, attr->get()->getInt(5));
+    EXPECT_EQUAL(44, attr->get()->getInt(6));
+    f._pop->handleExisting(7, f._ctx.create(2, 55));
+    EXPECT_EQUAL(undefined, attr->get()->getInt(7));
+    f._pop->done();
+    EXPECT_EQUAL(55, attr->get()->getInt(7));
+    EXPECT_EQUAL(CREATE_SERIAL_NUM, attr->get()->getStatus().getLastSyncToken());
+}
+
 TEST_MAIN()
 {
     vespalib::rmdir(TEST_DIR, true);
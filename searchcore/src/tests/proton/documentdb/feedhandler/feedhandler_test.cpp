@@ -118,6 +118,7 @@ struct MyOwner : public IFeedHandlerOwner
     void onPerformPrune(SerialNum) override {}
 
     bool getAllowPrune() const override { return _allowPrune; }
+    void onCommitDone() override {}
 };
 
 
@@ -3,14 +3,18 @@
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/searchlib/engine/docsumreply.h>
 #include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/util/numa_topology.h>
 #include <mutex>
 #include <condition_variable>
 #include <chrono>
+#include <numeric>
+#include <sched.h>
 
 using namespace proton;
 using namespace search::engine;
 using namespace vespalib::slime;
 using vespalib::Slime;
+using vespalib::NumaTopology;
 
 class MySearchHandler : public ISearchHandler {
     size_t _numHits;
@@ -146,6 +150,75 @@ TEST("requireThatBundlesAreUsed")
     EXPECT_EQUAL(5u, handler->bundleSize);
 }
 
+struct ObserveCpuMatchHandler : MySearchHandler {
+    mutable int cpu;
+    mutable const vespalib::ThreadBundle *bundle;
+    ObserveCpuMatchHandler() : cpu(-1), bundle(nullptr) {}
+
+    search::engine::SearchReply::UP match(
+            const search::engine::SearchRequest &,
+            vespalib::ThreadBundle &threadBundle) const override
+    {
+        cpu = sched_getcpu();
+        bundle = &threadBundle;
+        return std::make_unique<SearchReply>();
+    }
+};
+
+TEST("requireThatNumaAwareBundlesAreUsed")
+{
+    std::vector<uint32_t> cpus(16);
+    std::iota(cpus.begin(), cpus.end(), 0);
+    NumaTopology topology(TEST_PATH("../../../../../vespalib/src/tests/util/numa_topology/two_nodes"), cpus);
+    ASSERT_EQUAL(2u, topology.num_nodes());
+    MatchEngine engine(15, 5, 7, true, true, topology);
+    engine.setNodeUp(true);
+    EXPECT_EQUAL(2u, engine.get_num_thread_bundle_pools());
+
+    auto handler = std::make_shared<ObserveCpuMatchHandler>();
+    DocTypeName dtnvfoo("foo");
+    engine.putSearchHandler(dtnvfoo, handler);
+
+    for (size_t i = 0; i < 4; ++i) {
+        LocalSearchClient client;
+        auto *request = new SearchRequest();
+        request->setTraceLevel(3);
+        engine.search(SearchRequest::Source(request), client);
+        SearchReply::UP reply = client.getReply(10000);
+        ASSERT_TRUE(reply);
+        EXPECT_EQUAL(7u, reply->getDistributionKey());
+        EXPECT_EQUAL(5u, handler->bundle->size());
+        // The search thread is bound to the node it was scheduled on, which selects the thread bundle pool.
+        ASSERT_TRUE(handler->cpu >= 0);
+        size_t node = topology.node_of_cpu(handler->cpu);
+        EXPECT_EQUAL(int64_t(node), reply->request->trace().getRoot()["numa-node"].asLong());
+        auto bundle = engine.get_thread_bundle_pool(node).obtain();
+        EXPECT_EQUAL(handler->bundle, bundle.get());
+        engine.get_thread_bundle_pool(node).release(std::move(bundle));
+    }
+}
+
+TEST("requireThatNumaAwareBundlesAreNotUsedOnSingleNode")
+{
+    NumaTopology topology(TEST_PATH("no_topology"), {0, 1, 2, 3});
+    ASSERT_EQUAL(1u, topology.num_nodes());
+    MatchEngine engine(15, 5, 7, true, true, topology);
+    engine.setNodeUp(true);
+    EXPECT_EQUAL(1u, engine.get_num_thread_bundle_pools());
+
+    auto handler = std::make_shared<ObserveCpuMatchHandler>();
+    engine.putSearchHandler(DocTypeName("foo"), handler);
+
+    LocalSearchClient client;
+    auto *request = new SearchRequest();
+    request->setTraceLevel(3);
+    engine.search(SearchRequest::Source(request), client);
+    SearchReply::UP reply = client.getReply(10000);
+    ASSERT_TRUE(reply);
+    EXPECT_EQUAL(7, reply->request->trace().getRoot()["distribution-key"].asLong());
+    EXPECT_FALSE(reply->request->trace().getRoot()["numa-node"].valid());
+}
+
 TEST("requireThatHandlersCanBeRemoved")
 {
     MatchEngine engine(1, 1, 7);
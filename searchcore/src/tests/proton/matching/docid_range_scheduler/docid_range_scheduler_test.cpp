@@ -287,4 +287,97 @@ TEST_MT_FF("require that the adaptive scheduler handles fewer documents than thr
 
 //-----------------------------------------------------------------------------
 
+TEST("require that the work-stealing scheduler starts by dividing the docid space equally") {
+    WorkStealingDocidRangeScheduler scheduler(2, 1, 1601, 1.0);
+    EXPECT_EQUAL(scheduler.chunk_size(), 100u);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 1600u);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 101)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(801, 901)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(101, 201)));
+    EXPECT_EQUAL(scheduler.total_size(0), 200u);
+    EXPECT_EQUAL(scheduler.total_size(1), 100u);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 1300u);
+}
+
+TEST("require that the work-stealing scheduler derives chunk size from the hit ratio") {
+    EXPECT_EQUAL(WorkStealingDocidRangeScheduler(1, 1, 1000001, 1.0).chunk_size(), 256u);
+    EXPECT_EQUAL(WorkStealingDocidRangeScheduler(1, 1, 1000001, 0.01).chunk_size(), 25600u);
+    // leave enough chunks for others to steal
+    EXPECT_EQUAL(WorkStealingDocidRangeScheduler(1, 1, 1000001, 0.0).chunk_size(), 125000u);
+    EXPECT_EQUAL(WorkStealingDocidRangeScheduler(1, 1000, 1001, 1.0).chunk_size(), 1000u);
+}
+
+TEST("require that the work-stealing scheduler steals the second half of remaining work") {
+    WorkStealingDocidRangeScheduler scheduler(2, 1, 1601, 1.0);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 101)));
+    for (DocidRange range = scheduler.first_range(1); range.begin < 1501; range = scheduler.next_range(1)) {
+        EXPECT_EQUAL(range.size(), 100u);
+    }
+    // thread 0 has [101,801) left
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange(451, 551)));
+    EXPECT_EQUAL(scheduler.total_size(1), 900u);
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(101, 201)));
+    EXPECT_EQUAL(scheduler.unassigned_size(), 500u);
+}
+
+TEST("require that the work-stealing scheduler does not split small ranges") {
+    WorkStealingDocidRangeScheduler scheduler(2, 10, 21, 1.0);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 11)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(11, 21)));
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange()));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange()));
+}
+
+TEST_MT_FF("require that the work-stealing scheduler handles no documents",
+           4, WorkStealingDocidRangeScheduler(num_threads, 1, 1, 1.0), TimeBomb(60))
+{
+    for (DocidRange docid_range = f1.first_range(thread_id);
+         !docid_range.empty();
+         docid_range = f1.next_range(thread_id))
+    {
+        TEST_ERROR("no threads should get any work");
+    }
+}
+
+struct DocidCoverage {
+    std::vector<std::atomic<uint32_t>> seen;
+    DocidCoverage(uint32_t docid_limit) : seen(docid_limit) {}
+};
+
+TEST_MT_FFF("require that the work-stealing scheduler assigns each docid exactly once",
+            4, WorkStealingDocidRangeScheduler(num_threads, 1, 100001, 0.1), DocidCoverage(100001), TimeBomb(60))
+{
+    for (DocidRange docid_range = f1.first_range(thread_id);
+         !docid_range.empty();
+         docid_range = f1.next_range(thread_id))
+    {
+        for (uint32_t docid = docid_range.begin; docid < docid_range.end; ++docid) {
+            f2.seen[docid].fetch_add(1, std::memory_order_relaxed);
+            if ((docid > 75000) && ((docid % 16) == 0)) {
+                // documents with high docids are more expensive
+                std::this_thread::sleep_for(std::chrono::microseconds(1));
+            }
+        }
+    }
+    TEST_BARRIER();
+    if (thread_id == 0) {
+        size_t total = 0;
+        for (size_t i = 0; i < num_threads; ++i) {
+            total += f1.total_size(i);
+        }
+        EXPECT_EQUAL(total, 100000u);
+        EXPECT_EQUAL(f1.unassigned_size(), 0u);
+        EXPECT_EQUAL(f2.seen[0].load(), 0u);
+        size_t bad_docids = 0;
+        for (uint32_t docid = 1; docid < 100001; ++docid) {
+            if (f2.seen[docid].load() != 1) {
+                ++bad_docids;
+            }
+        }
+        EXPECT_EQUAL(bad_docids, 0u);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 TEST_MAIN() { TEST_RUN_ALL(); }
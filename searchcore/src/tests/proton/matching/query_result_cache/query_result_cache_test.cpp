@@ -0,0 +1,183 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcore/proton/matching/query_result_cache.h>
+#include <vespa/searchlib/common/unique_issues.h>
+#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using proton::matching::QueryResultCache;
+using Visibility = QueryResultCache::Visibility;
+using search::MapNames;
+using search::UniqueIssues;
+using search::engine::SearchReply;
+using search::engine::SearchRequest;
+
+namespace {
+
+const UniqueIssues no_issues;
+
+std::unique_ptr<SearchRequest>
+make_request(const vespalib::string &query, const vespalib::string &ranking = "default")
+{
+    auto request = std::make_unique<SearchRequest>();
+    request->ranking = ranking;
+    request->stackDump.assign(query.begin(), query.end());
+    request->maxhits = 10;
+    return request;
+}
+
+SearchReply
+make_reply(uint32_t num_hits)
+{
+    SearchReply reply;
+    reply.totalHitCount = num_hits * 10;
+    for (uint32_t i = 0; i < num_hits; ++i) {
+        reply.hits.emplace_back();
+        reply.hits.back().metric = 100.0 - i;
+    }
+    return reply;
+}
+
+}
+
+TEST(QueryResultCacheTest, cache_is_disabled_when_max_bytes_is_zero)
+{
+    EXPECT_FALSE(QueryResultCache(0).enabled());
+    EXPECT_TRUE(QueryResultCache(1000).enabled());
+}
+
+TEST(QueryResultCacheTest, key_depends_on_query_rank_profile_properties_hit_window_and_serial_num)
+{
+    auto request = make_request("foo");
+    auto key = QueryResultCache::make_key(*request, Visibility(7));
+    EXPECT_EQ(key, QueryResultCache::make_key(*make_request("foo"), Visibility(7)));
+    EXPECT_NE(key, QueryResultCache::make_key(*request, Visibility(8)));
+    EXPECT_NE(key, QueryResultCache::make_key(*make_request("bar"), Visibility(7)));
+    EXPECT_NE(key, QueryResultCache::make_key(*make_request("foo", "other"), Visibility(7)));
+    auto paged = make_request("foo");
+    paged->offset = 10;
+    EXPECT_NE(key, QueryResultCache::make_key(*paged, Visibility(7)));
+    auto with_props = make_request("foo");
+    with_props->propertiesMap.lookupCreate(MapNames::RANK).add("query(weight)", "2");
+    EXPECT_NE(key, QueryResultCache::make_key(*with_props, Visibility(7)));
+}
+
+TEST(QueryResultCacheTest, key_depends_on_active_lids_generation_and_parent_generations)
+{
+    auto request = make_request("foo");
+    Visibility visibility(7);
+    auto key = QueryResultCache::make_key(*request, visibility);
+    visibility.active_lids_generation = 1;
+    auto activated = QueryResultCache::make_key(*request, visibility);
+    EXPECT_NE(key, activated);
+    visibility.parent_generations = {3, 4};
+    auto with_parent = QueryResultCache::make_key(*request, visibility);
+    EXPECT_NE(activated, with_parent);
+    visibility.parent_generations = {3, 5};
+    EXPECT_NE(with_parent, QueryResultCache::make_key(*request, visibility));
+}
+
+TEST(QueryResultCacheTest, key_does_not_depend_on_property_insert_order)
+{
+    auto a = make_request("foo");
+    a->propertiesMap.lookupCreate(MapNames::RANK).add("x", "1").add("y", "2");
+    auto b = make_request("foo");
+    b->propertiesMap.lookupCreate(MapNames::RANK).add("y", "2").add("x", "1");
+    EXPECT_EQ(QueryResultCache::make_key(*a, Visibility(1)), QueryResultCache::make_key(*b, Visibility(1)));
+}
+
+TEST(QueryResultCacheTest, grouping_sessions_and_tracing_are_not_cacheable)
+{
+    EXPECT_TRUE(QueryResultCache::is_cacheable(*make_request("foo")));
+    auto grouping = make_request("foo");
+    grouping->groupSpec.push_back('g');
+    EXPECT_FALSE(QueryResultCache::is_cacheable(*grouping));
+    auto session = make_request("foo");
+    session->sessionId.push_back('s');
+    EXPECT_FALSE(QueryResultCache::is_cacheable(*session));
+    auto traced = make_request("foo");
+    traced->setTraceLevel(1);
+    EXPECT_FALSE(QueryResultCache::is_cacheable(*traced));
+}
+
+TEST(QueryResultCacheTest, inserted_reply_is_returned_by_lookup)
+{
+    QueryResultCache cache(100000);
+    auto key = QueryResultCache::make_key(*make_request("foo"), Visibility(1));
+    EXPECT_FALSE(cache.lookup(key));
+    cache.insert(key, cache.generation(), make_reply(3), no_issues);
+    auto reply = cache.lookup(key);
+    ASSERT_TRUE(reply);
+    EXPECT_EQ(30u, reply->totalHitCount);
+    ASSERT_EQ(3u, reply->hits.size());
+    EXPECT_EQ(98.0, reply->hits[2].metric);
+    auto stats = cache.get_stats();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(1u, stats.misses);
+    EXPECT_EQ(1u, stats.elements);
+    EXPECT_LT(0u, stats.memory_used);
+}
+
+TEST(QueryResultCacheTest, invalidate_removes_all_entries_and_rejects_replies_from_older_generations)
+{
+    QueryResultCache cache(100000);
+    auto key = QueryResultCache::make_key(*make_request("foo"), Visibility(1));
+    uint64_t generation = cache.generation();
+    cache.insert(key, generation, make_reply(3), no_issues);
+    cache.invalidate();
+    EXPECT_FALSE(cache.lookup(key));
+    EXPECT_EQ(1u, cache.get_stats().invalidations);
+    cache.insert(key, generation, make_reply(3), no_issues);
+    EXPECT_FALSE(cache.lookup(key));
+    cache.insert(key, cache.generation(), make_reply(3), no_issues);
+    EXPECT_TRUE(cache.lookup(key));
+}
+
+TEST(QueryResultCacheTest, replies_degraded_by_timeout_are_not_cached)
+{
+    QueryResultCache cache(100000);
+    auto key = QueryResultCache::make_key(*make_request("foo"), Visibility(1));
+    auto reply = make_reply(3);
+    reply.coverage.degradeTimeout();
+    cache.insert(key, cache.generation(), reply, no_issues);
+    EXPECT_FALSE(cache.lookup(key));
+}
+
+TEST(QueryResultCacheTest, replies_for_queries_reporting_issues_are_not_cached)
+{
+    QueryResultCache cache(100000);
+    auto key = QueryResultCache::make_key(*make_request("foo"), Visibility(1));
+    UniqueIssues issues;
+    issues.handle(vespalib::Issue("invalid query"));
+    cache.insert(key, cache.generation(), make_reply(3), issues);
+    EXPECT_FALSE(cache.lookup(key));
+    cache.insert(key, cache.generation(), make_reply(3), no_issues);
+    EXPECT_TRUE(cache.lookup(key));
+}
+
+TEST(QueryResultCacheTest, oldest_entries_are_evicted_to_stay_within_max_bytes)
+{
+    auto key_a = QueryResultCache::make_key(*make_request("a"), Visibility(1));
+    auto key_b = QueryResultCache::make_key(*make_request("b"), Visibility(1));
+    auto key_c = QueryResultCache::make_key(*make_request("c"), Visibility(1));
+    QueryResultCache probe(100000);
+    probe.insert(key_a, probe.generation(), make_reply(100), no_issues);
+    size_t entry_size = probe.get_stats().memory_used;
+
+    QueryResultCache cache(entry_size * 2);
+    cache.insert(key_a, cache.generation(), make_reply(100), no_issues);
+    cache.insert(key_b, cache.generation(), make_reply(100), no_issues);
+    cache.insert(key_c, cache.generation(), make_reply(100), no_issues);
+    EXPECT_FALSE(cache.lookup(key_a));
+    EXPECT_TRUE(cache.lookup(key_b));
+    EXPECT_TRUE(cache.lookup(key_c));
+    EXPECT_EQ(2u, cache.get_stats().elements);
+    EXPECT_LE(cache.get_stats().memory_used, entry_size * 2);
+    // Replies larger than the cache are never inserted
+    QueryResultCache tiny(entry_size / 2);
+    tiny.insert(key_a, tiny.generation(), make_reply(100), no_issues);
+    EXPECT_FALSE(tiny.lookup(key_a));
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -1167,6 +1167,21 @@ Test::global_filter_is_calculated_and_handled()
         EXPECT_TRUE(bv->testBit(5));
         EXPECT_TRUE(bv->testBit(7));
     }
+    { // sparse global filter is compressed
+        GlobalFilterBlueprint bp(result, true);
+        auto res = Query::handle_global_filter(bp, 1000000, 0, 1, nullptr);
+        EXPECT_TRUE(res);
+        EXPECT_TRUE(bp.filter->has_filter());
+        EXPECT_FALSE(bp.filter->filter());
+        auto* cbv = bp.filter->compressed_filter();
+        ASSERT_TRUE(cbv != nullptr);
+        EXPECT_EQUAL(1000000u, bp.filter->size());
+        EXPECT_EQUAL(3u, bp.filter->count());
+        EXPECT_TRUE(bp.filter->check(3));
+        EXPECT_FALSE(bp.filter->check(4));
+        EXPECT_TRUE(bp.filter->check(5));
+        EXPECT_TRUE(bp.filter->check(7));
+    }
     { // estimated_hit_ratio > global_filter_upper_limit
         GlobalFilterBlueprint bp(result, true);
         auto res = Query::handle_global_filter(bp, docid_limit, 0, 0.29, nullptr);
@@ -70,7 +70,7 @@ TEST("require that SessionManager can be explored") {
     session_manager.insert(std::make_shared<SearchSession>("baz", start, doom,
                                                            MatchToolsFactory::UP(), SearchSession::OwnershipBundle()));
     SessionManagerExplorer explorer(session_manager);
-    EXPECT_EQUAL(std::vector<vespalib::string>({"search"}),
+    EXPECT_EQUAL(std::vector<vespalib::string>({"search", "query_result_cache"}),
                  explorer.get_children_names());
     std::unique_ptr<StateExplorer> search = explorer.get_child("search");
     ASSERT_TRUE(search.get() != nullptr);
@@ -84,6 +84,19 @@ TEST("require that SessionManager can be explored") {
     EXPECT_EQUAL(3u, full_state.get()["sessions"].entries());
 }
 
+TEST("require that query result cache can be explored") {
+    SessionManager session_manager(10, 1024);
+    SessionManagerExplorer explorer(session_manager);
+    std::unique_ptr<StateExplorer> cache = explorer.get_child("query_result_cache");
+    ASSERT_TRUE(cache.get() != nullptr);
+    vespalib::Slime state;
+    cache->get_state(vespalib::slime::SlimeInserter(state), false);
+    EXPECT_TRUE(state.get()["enabled"].asBool());
+    EXPECT_EQUAL(1024, state.get()["maxBytes"].asLong());
+    EXPECT_EQUAL(0, state.get()["elements"].asLong());
+    EXPECT_EQUAL(0.0, state.get()["hitRatio"].asDouble());
+}
+
 }  // namespace
 
 TEST_MAIN() { TEST_RUN_ALL(); }
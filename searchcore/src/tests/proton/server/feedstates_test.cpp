@@ -14,6 +14,8 @@
 #include <vespa/searchlib/common/serialnum.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/util/foreground_thread_executor.h>
+#include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/vespalib/util/buffer.h>
 #include <vespa/searchcore/proton/bucketdb/bucketdbhandler.h>
@@ -31,6 +33,7 @@ using storage::spi::Timestamp;
 using vespalib::ConstBufferRef;
 using vespalib::nbostream;
 using vespalib::ForegroundThreadExecutor;
+using vespalib::ThreadStackExecutor;
 using namespace proton;
 
 namespace {
@@ -90,7 +93,7 @@ Fixture::Fixture()
       _bucketDBHandler(_bucketDB),
       _replay_throttling_policy({}),
       _inc_serial_num(9u),
-      state("doctypename", feed_view_ptr, _bucketDBHandler, replay_config, config_store, _replay_throttling_policy, _inc_serial_num)
+      state("doctypename", feed_view_ptr, _bucketDBHandler, replay_config, config_store, _replay_throttling_policy, _inc_serial_num, 2)
 {
 }
 Fixture::~Fixture() = default;
@@ -152,6 +155,38 @@ TEST_F("require that replay progress is tracked", Fixture)
     EXPECT_EQUAL(0.5, progress.getProgress());
 }
 
+TEST_F("require that packets are decoded in parallel and replayed in order", Fixture)
+{
+    ThreadStackExecutor executor(1, 128_Ki);
+    std::vector<std::unique_ptr<RemoveOperationContext>> op_contexts;
+    std::vector<std::shared_ptr<PacketWrapper>> wraps;
+    for (SerialNum serial = 10; serial < 30; ++serial) {
+        op_contexts.push_back(std::make_unique<RemoveOperationContext>(serial));
+        wraps.push_back(std::make_shared<PacketWrapper>(*op_contexts.back()->packet, nullptr));
+        f.state.receive(wraps.back(), executor);
+    }
+    for (auto &wrap : wraps) {
+        wrap->gate.await();
+        EXPECT_EQUAL(search::transactionlog::client::RPC::OK, wrap->result);
+    }
+    EXPECT_EQUAL(20, f.feed_view1.remove_handled);
+    EXPECT_EQUAL(29u, f._inc_serial_num._serial_num);
+}
+
+TEST_F("require that replay failure is attached to the failing packet", Fixture)
+{
+    ForegroundThreadExecutor executor;
+    vespalib::string data("junk");
+    Packet packet(0xf000);
+    packet.add(Packet::Entry(10, 1000, ConstBufferRef(data.data(), data.size())));
+    auto wrap = std::make_shared<PacketWrapper>(packet, nullptr);
+    EXPECT_EXCEPTION(f.state.receive(wrap, executor), vespalib::IllegalStateException,
+                     "Failed to replay transaction log entry with serial 10");
+    EXPECT_EQUAL(0u, wrap->gate.getCount());
+    EXPECT_EQUAL(search::transactionlog::client::RPC::ERROR, wrap->result);
+    EXPECT_TRUE(wrap->error.find("Failed to replay transaction log entry with serial 10: ") == 0);
+}
+
 }  // namespace
 
 TEST_MAIN() { TEST_RUN_ALL(); }
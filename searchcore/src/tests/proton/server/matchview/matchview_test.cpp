@@ -0,0 +1,151 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/document/base/documentid.h>
+#include <vespa/searchcore/proton/bucketdb/bucket_db_owner.h>
+#include <vespa/searchcore/proton/documentmetastore/documentmetastorecontext.h>
+#include <vespa/searchcore/proton/matching/sessionmanager.h>
+#include <vespa/searchcore/proton/server/matchview.h>
+#include <vespa/searchcore/proton/test/mock_attribute_manager.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/imported_attribute_vector.h>
+#include <vespa/searchlib/common/unique_issues.h>
+#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/stringfmt.h>
+
+using document::BucketId;
+using document::DocumentId;
+using document::GlobalId;
+using proton::DocIdLimit;
+using proton::DocumentMetaStoreContext;
+using proton::IDocumentMetaStore;
+using proton::ImportedAttributesRepo;
+using proton::MatchView;
+using proton::matching::QueryResultCache;
+using proton::matching::SessionManager;
+using search::AttributeFactory;
+using search::AttributeVector;
+using search::CommitParam;
+using search::UniqueIssues;
+using search::attribute::BasicType;
+using search::attribute::Config;
+using search::attribute::ImportedAttributeVector;
+using search::engine::SearchReply;
+using search::engine::SearchRequest;
+using storage::spi::Timestamp;
+
+namespace {
+
+const UniqueIssues no_issues;
+
+GlobalId
+make_gid(uint32_t user_id, uint32_t doc)
+{
+    return DocumentId(vespalib::make_string("id:ns:searchdocument:n=%u:%u", user_id, doc)).getGlobalId();
+}
+
+BucketId
+make_bucket_id(const GlobalId &gid)
+{
+    return BucketId(8, gid.convertToBucketId().getRawId());
+}
+
+std::unique_ptr<SearchRequest>
+make_request()
+{
+    auto request = std::make_unique<SearchRequest>();
+    vespalib::string query("foo");
+    request->stackDump.assign(query.begin(), query.end());
+    request->maxhits = 10;
+    return request;
+}
+
+}
+
+class MatchViewTest : public ::testing::Test {
+protected:
+    std::shared_ptr<DocumentMetaStoreContext>          _dmsc;
+    std::shared_ptr<proton::test::MockAttributeManager> _attr_mgr;
+    std::shared_ptr<SessionManager>                    _session_mgr;
+    DocIdLimit                                         _doc_id_limit;
+    MatchView                                          _view;
+    std::unique_ptr<SearchRequest>                     _request;
+
+    MatchViewTest();
+    ~MatchViewTest() override;
+
+    IDocumentMetaStore &dms() { return _dmsc->get(); }
+    QueryResultCache &cache() { return _session_mgr->getQueryResultCache(); }
+
+    void put(const GlobalId &gid, uint32_t lid, search::SerialNum serial_num) {
+        ASSERT_TRUE(dms().put(gid, make_bucket_id(gid), Timestamp(lid), 1, lid, serial_num).ok());
+        dms().commit(CommitParam(serial_num));
+    }
+    void insert_reply() {
+        auto key = _view.makeQueryResultCacheKey(*_request);
+        ASSERT_TRUE(key);
+        cache().insert(*key, cache().generation(), SearchReply(), no_issues);
+    }
+    bool cache_hit() {
+        auto key = _view.makeQueryResultCacheKey(*_request);
+        return key && cache().lookup(*key);
+    }
+};
+
+MatchViewTest::MatchViewTest()
+    : _dmsc(std::make_shared<DocumentMetaStoreContext>(std::make_shared<proton::bucketdb::BucketDBOwner>())),
+      _attr_mgr(std::make_shared<proton::test::MockAttributeManager>()),
+      _session_mgr(std::make_shared<SessionManager>(1, 100000)),
+      _doc_id_limit(1),
+      _view(proton::Matchers::SP(), searchcorespi::IndexSearchable::SP(), _attr_mgr, _session_mgr, _dmsc, _doc_id_limit),
+      _request(make_request())
+{
+    dms().constructFreeList();
+}
+
+MatchViewTest::~MatchViewTest() = default;
+
+TEST_F(MatchViewTest, query_result_cache_misses_after_bucket_state_change)
+{
+    auto gid = make_gid(10, 1);
+    put(gid, 1, 1);
+    insert_reply();
+    EXPECT_TRUE(cache_hit());
+    dms().setBucketState(make_bucket_id(gid), true);
+    EXPECT_EQ(1u, dms().getLastSerialNum());
+    EXPECT_FALSE(cache_hit());
+    insert_reply();
+    EXPECT_TRUE(cache_hit());
+    dms().setBucketState(make_bucket_id(gid), false);
+    EXPECT_FALSE(cache_hit());
+}
+
+TEST_F(MatchViewTest, query_result_cache_misses_after_change_in_parent_of_imported_attribute)
+{
+    auto parent_dmsc = std::make_shared<DocumentMetaStoreContext>(std::make_shared<proton::bucketdb::BucketDBOwner>());
+    parent_dmsc->get().constructFreeList();
+    auto target = AttributeFactory::createAttribute("target", Config(BasicType::INT32));
+    auto repo = std::make_unique<ImportedAttributesRepo>();
+    repo->add("imported", std::make_shared<ImportedAttributeVector>("imported", nullptr, _dmsc, target, parent_dmsc, false));
+    _attr_mgr->setImportedAttributes(std::move(repo));
+    insert_reply();
+    EXPECT_TRUE(cache_hit());
+    target->incGeneration();
+    EXPECT_FALSE(cache_hit());
+    insert_reply();
+    auto gid = make_gid(10, 1);
+    ASSERT_TRUE(parent_dmsc->get().put(gid, make_bucket_id(gid), Timestamp(1), 1, 1, 1).ok());
+    parent_dmsc->get().commit(CommitParam(1));
+    EXPECT_FALSE(cache_hit());
+}
+
+TEST_F(MatchViewTest, query_result_cache_is_not_used_when_imported_attribute_target_is_unknown)
+{
+    auto repo = std::make_unique<ImportedAttributesRepo>();
+    repo->add("imported", std::make_shared<ImportedAttributeVector>("imported", nullptr, _dmsc, nullptr, nullptr, false));
+    _attr_mgr->setImportedAttributes(std::move(repo));
+    EXPECT_FALSE(_view.makeQueryResultCacheKey(*_request));
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
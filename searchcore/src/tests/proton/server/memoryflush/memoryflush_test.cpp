@@ -279,6 +279,28 @@ requireThatWeHandleLargeSerialNumbersWhenOrderingByTlsSize()
     EXPECT_TRUE(assertOrder(StringList().add("t2").add("t1"), flush.getFlushTargets(builder.list(), builder.tlsStats())));
 }
 
+void
+requireThatOnlyTargetsSelectedByMemoryGainAreReportedAsSuch()
+{
+    ContextBuilder cb;
+    cb.addTls("myhandler", {20_Gi, 1001, 2000});
+    cb.add(createTargetS("tls", 1000), 2000)
+      .add(std::make_shared<MyFlushTarget>("m1", MemoryGain(100, 0), DiskGain(), 1900, system_time(), false), 2000)
+      .add(std::make_shared<MyFlushTarget>("m2", MemoryGain(90, 0), DiskGain(), 1950, system_time(), false), 2000);
+    { // sum of tls sizes above limit, no target has memoryGain >= maxMemoryGain
+        MemoryFlush flush({1000, 3_Gi, 1.0, 1000, 1.0, minutes(1)});
+        EXPECT_TRUE(assertOrder(StringList().add("tls").add("m1").add("m2"),
+                                flush.getFlushTargets(cb.list(), cb.tlsStats())));
+        EXPECT_FALSE(flush.selectsByMemoryGain(cb.list(), cb.tlsStats()));
+    }
+    { // target m1 has memoryGain >= maxMemoryGain
+        MemoryFlush flush({1000, 3_Gi, 1.0, 100, 1.0, minutes(1)});
+        EXPECT_TRUE(assertOrder(StringList().add("m1").add("m2").add("tls"),
+                                flush.getFlushTargets(cb.list(), cb.tlsStats())));
+        EXPECT_TRUE(flush.selectsByMemoryGain(cb.list(), cb.tlsStats()));
+    }
+}
+
 void
 requireThatOrderTypeIsPreserved()
 {
@@ -317,4 +339,5 @@ TEST_MAIN()
     TEST_DO(requireThatWeCanOrderByTlsSize());
     TEST_DO(requireThatWeHandleLargeSerialNumbersWhenOrderingByTlsSize());
     TEST_DO(requireThatOrderTypeIsPreserved());
+    TEST_DO(requireThatOnlyTargetsSelectedByMemoryGainAreReportedAsSuch());
 }
@@ -34,6 +34,7 @@
 #include <vespa/metrics/config-metricsmanager.h>
 #include <vespa/searchcommon/common/schemaconfigurer.h>
 #include <vespa/searchcore/proton/common/alloc_config.h>
+#include <vespa/searchcore/proton/matching/matching_stats.h>
 #include <vespa/searchcore/proton/matching/querylimiter.h>
 #include <vespa/searchcore/proton/metrics/metricswireservice.h>
 #include <vespa/searchcore/proton/persistenceengine/i_resource_write_filter.h>
@@ -45,8 +46,10 @@
 #include <vespa/searchcore/proton/server/documentdb.h>
 #include <vespa/searchcore/proton/server/documentdbconfigmanager.h>
 #include <vespa/searchcore/proton/server/fileconfigmanager.h>
+#include <vespa/searchcore/proton/server/idocumentsubdb.h>
 #include <vespa/searchcore/proton/server/memoryconfigstore.h>
 #include <vespa/searchcore/proton/server/persistencehandlerproxy.h>
+#include <vespa/searchcore/proton/server/searchhandlerproxy.h>
 #include <vespa/searchcore/proton/test/disk_mem_usage_notifier.h>
 #include <vespa/searchcore/proton/test/mock_shared_threading_service.h>
 #include <vespa/searchlib/attribute/interlock.h>
@@ -120,7 +123,9 @@ using vespa::config::search::AttributesConfigBuilder;
 using vespa::config::search::ImportedFieldsConfig;
 using vespa::config::search::IndexschemaConfig;
 using vespa::config::search::RankProfilesConfig;
+using vespa::config::search::RankProfilesConfigBuilder;
 using vespa::config::search::SummaryConfig;
+using vespa::config::search::SummaryConfigBuilder;
 using vespa::config::search::SummarymapConfig;
 using vespa::config::search::core::ProtonConfig;
 using vespa::config::search::core::ProtonConfigBuilder;
@@ -175,18 +180,44 @@ std::shared_ptr<AttributesConfig> make_attributes_config() {
     return std::make_shared<AttributesConfig>(builder);
 }
 
+std::shared_ptr<RankProfilesConfig> make_rank_profiles_config() {
+    RankProfilesConfigBuilder builder;
+    builder.rankprofile.resize(1);
+    auto& profile = builder.rankprofile.back();
+    profile.name = "default";
+    RankProfilesConfigBuilder::Rankprofile::Fef::Property first_phase;
+    first_phase.name = "vespa.rank.firstphase";
+    first_phase.value = "attribute(int)";
+    profile.fef.property.emplace_back(first_phase);
+    return std::make_shared<RankProfilesConfig>(builder);
+}
+
+std::shared_ptr<SummaryConfig> make_summary_config() {
+    SummaryConfigBuilder builder;
+    SummaryConfigBuilder::Classes summary_class;
+    summary_class.id = 1;
+    summary_class.name = "default";
+    SummaryConfigBuilder::Classes::Fields field;
+    field.name = "int";
+    field.type = "integer";
+    summary_class.fields.emplace_back(field);
+    builder.classes.emplace_back(summary_class);
+    builder.defaultsummaryid = summary_class.id;
+    return std::make_shared<SummaryConfig>(builder);
+}
+
 std::shared_ptr<DocumentDBConfig> make_document_db_config(std::shared_ptr<DocumenttypesConfig> document_types, std::shared_ptr<const DocumentTypeRepo> repo, const DocTypeName& doc_type_name)
 {
     auto indexschema = std::make_shared<IndexschemaConfig>();
     auto attributes = make_attributes_config();
-    auto summary = std::make_shared<SummaryConfig>();
+    auto summary = make_summary_config();
     std::shared_ptr<Schema> schema(new Schema());
     SchemaBuilder::build(*indexschema, *schema);
     SchemaBuilder::build(*attributes, *schema);
     SchemaBuilder::build(*summary, *schema);
     return std::make_shared<DocumentDBConfig>(
             1,
-            std::make_shared<RankProfilesConfig>(),
+            make_rank_profiles_config(),
             std::make_shared<proton::matching::RankingConstants>(),
             std::make_shared<proton::matching::RankingExpressions>(),
             std::make_shared<proton::matching::OnnxModels>(),
@@ -486,6 +517,8 @@ public:
     bool has_storage_layer(bool distributor) const override;
     PersistenceProvider* get_persistence_provider() override;
     void merge_node_stats(std::vector<BmNodeStats>& node_stats, storage::lib::ClusterState &baseline_state) override;
+    std::shared_ptr<proton::ISearchHandler> get_search_handler() override;
+    proton::matching::MatchingStats get_matching_stats(const vespalib::string& rank_profile) override;
 };
 
 MyBmNode::MyBmNode(const vespalib::string& base_dir, int base_port, uint32_t node_idx, BmCluster& cluster, const BmClusterParams& params, std::shared_ptr<DocumenttypesConfig> document_types, int slobrok_port)
@@ -716,6 +749,18 @@ MyBmNode::wait_distributor_slobrok()
     _cluster.wait_slobrok(s.str());
 }
 
+std::shared_ptr<proton::ISearchHandler>
+MyBmNode::get_search_handler()
+{
+    return std::make_shared<proton::SearchHandlerProxy>(_document_db);
+}
+
+proton::matching::MatchingStats
+MyBmNode::get_matching_stats(const vespalib::string& rank_profile)
+{
+    return _document_db->getReadySubDB()->getMatcherStats(rank_profile);
+}
+
 unsigned int
 BmNode::num_ports()
 {
@@ -15,6 +15,8 @@ class Field;
 
 };
 
+namespace proton { class ISearchHandler; }
+namespace proton::matching { class MatchingStats; }
 namespace storage::lib { class ClusterState; }
 namespace storage::spi { struct PersistenceProvider; }
 
@@ -49,6 +51,8 @@ public:
     virtual bool has_storage_layer(bool distributor) const = 0;
     virtual storage::spi::PersistenceProvider *get_persistence_provider() = 0;
     virtual void merge_node_stats(std::vector<BmNodeStats>& node_stats, storage::lib::ClusterState &baseline_state) = 0;
+    virtual std::shared_ptr<proton::ISearchHandler> get_search_handler() = 0;
+    virtual proton::matching::MatchingStats get_matching_stats(const vespalib::string& rank_profile) = 0;
     static unsigned int num_ports();
     static std::unique_ptr<BmNode> create(const vespalib::string &base_dir, int base_port, uint32_t node_idx, BmCluster& cluster, const BmClusterParams& params, std::shared_ptr<DocumenttypesConfig> document_types, int slobrok_port);
 };
@@ -53,12 +53,15 @@ AttributePopulator::getNames() const
 AttributePopulator::AttributePopulator(const proton::IAttributeManager::SP &mgr,
                                        search::SerialNum initSerialNum,
                                        const vespalib::string &subDbName,
-                                       search::SerialNum configSerialNum)
+                                       search::SerialNum configSerialNum,
+                                       uint32_t commit_interval)
     : _writer(mgr),
       _initSerialNum(initSerialNum),
       _currSerialNum(initSerialNum),
       _configSerialNum(configSerialNum),
-      _subDbName(subDbName)
+      _subDbName(subDbName),
+      _commit_interval(std::max(commit_interval, 1u)),
+      _uncommitted(0)
 {
     if (LOG_WOULD_LOG(event)) {
         EventLogger::populateAttributeStart(getNames());
@@ -77,14 +80,27 @@ AttributePopulator::handleExisting(uint32_t lid, const std::shared_ptr<document:
 {
     search::SerialNum serialNum(nextSerialNum());
     _writer.put(serialNum, *doc, lid, std::make_shared<PopulateDoneContext>(doc));
+    if (++_uncommitted >= _commit_interval) {
+        commit();
+    }
+}
+
+void
+AttributePopulator::commit()
+{
+    if (_uncommitted == 0) {
+        return;
+    }
     vespalib::Gate gate;
-    _writer.forceCommit(serialNum, std::make_shared<vespalib::GateCallback>(gate));
+    _writer.forceCommit(_currSerialNum - 1, std::make_shared<vespalib::GateCallback>(gate));
     gate.await();
+    _uncommitted = 0;
 }
 
 void
 AttributePopulator::done()
 {
+    commit();
     auto mgr = _writer.getAttributeManager();
     auto flushTargets = mgr->getFlushTargets();
     for (const auto &flushTarget : flushTargets) {
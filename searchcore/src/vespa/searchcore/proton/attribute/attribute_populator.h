@@ -9,6 +9,11 @@ namespace proton {
 
 /**
  * Class used to populate attribute vectors based on visiting the content of a document store.
+ *
+ * Documents are put without waiting for each of them to be written, and the attribute vectors are
+ * committed for every commit_interval documents. This lets attributes using two-phase put
+ * (e.g. tensor attributes with a hnsw index) prepare several documents in parallel using the
+ * shared executor, while the number of documents in flight is bounded by the commit interval.
  */
 class AttributePopulator : public IReprocessingReader
 {
@@ -18,18 +23,24 @@ private:
     search::SerialNum _currSerialNum;
     search::SerialNum _configSerialNum;
     vespalib::string  _subDbName;
+    uint32_t          _commit_interval;
+    uint32_t          _uncommitted;
 
     search::SerialNum nextSerialNum();
+    void commit();
 
     std::vector<vespalib::string> getNames() const;
 
 public:
     typedef std::shared_ptr<AttributePopulator> SP;
 
+    static constexpr uint32_t default_commit_interval = 1000;
+
     AttributePopulator(const proton::IAttributeManager::SP &mgr,
                        search::SerialNum initSerialNum,
                        const vespalib::string &subDbName,
-                       search::SerialNum configSerialNum);
+                       search::SerialNum configSerialNum,
+                       uint32_t commit_interval = default_commit_interval);
     ~AttributePopulator() override;
 
     const IAttributeWriter &getWriter() const { return _writer; }
@@ -5,6 +5,8 @@
 #include "select_utils.h"
 #include "selectcontext.h"
 #include "selectpruner.h"
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/select/compiled_selection.h>
 #include <vespa/document/select/parser.h>
 #include <vespa/searchlib/attribute/attributevector.h>
 #include <vespa/searchlib/attribute/attribute_read_guard.h>
@@ -121,13 +123,20 @@ AttrVisitor::visitFieldValueNode(const FieldValueNode &expr)
 
 CachedSelect::Session::Session(std::unique_ptr<document::select::Node> docSelect,
                                std::unique_ptr<document::select::Node> preDocOnlySelect,
-                               std::unique_ptr<document::select::Node> preDocSelect)
+                               std::unique_ptr<document::select::Node> preDocSelect,
+                               const document::DocumentType *docType)
     : _docSelect(std::move(docSelect)),
       _preDocOnlySelect(std::move(preDocOnlySelect)),
-      _preDocSelect(std::move(preDocSelect))
+      _preDocSelect(std::move(preDocSelect)),
+      _compiledDocSelect()
 {
+    if (_docSelect && docType != nullptr) {
+        _compiledDocSelect = std::make_unique<document::select::CompiledSelection>(*_docSelect, *docType);
+    }
 }
 
+CachedSelect::Session::~Session() = default;
+
 bool
 CachedSelect::Session::contains(const SelectContext &context) const
 {
@@ -141,8 +150,13 @@ CachedSelect::Session::contains(const SelectContext &context) const
 bool
 CachedSelect::Session::contains(const document::Document &doc) const
 {
-    return (_preDocOnlySelect) ||
-            (_docSelect && (_docSelect->contains(doc) == document::select::Result::True));
+    if (_preDocOnlySelect) {
+        return true;
+    }
+    if (_compiledDocSelect) {
+        return (_compiledDocSelect->contains(doc) == document::select::Result::True);
+    }
+    return (_docSelect && (_docSelect->contains(doc) == document::select::Result::True));
 }
 
 const document::select::Node &
@@ -193,7 +207,8 @@ CachedSelect::CachedSelect()
       _allTrue(false),
       _allInvalid(false),
       _preDocOnlySelect(),
-      _preDocSelect()
+      _preDocSelect(),
+      _docType(nullptr)
 { }
 
 CachedSelect::~CachedSelect() = default;
@@ -211,6 +226,7 @@ CachedSelect::set(const vespalib::string &selection,
     _allFalse = !_docSelect;
     _allTrue = false;
     _allInvalid = false;
+    _docType = nullptr;
 }
 
                   
@@ -235,6 +251,7 @@ CachedSelect::set(const vespalib::string &selection,
                             true);
     docsPruner.process(*parsed);
     setDocumentSelect(docsPruner);
+    _docType = &emptyDoc.getType();
     if (amgr == nullptr || _attrFieldNodes == 0u) {
         return;
     }
@@ -254,7 +271,8 @@ CachedSelect::createSession() const
 {
     return std::make_unique<Session>((_docSelect ? _docSelect->clone() : NodeUP()),
                                      (_preDocOnlySelect ? _preDocOnlySelect->clone() : NodeUP()),
-                                     (_preDocSelect ? _preDocSelect->clone() : NodeUP()));
+                                     (_preDocSelect ? _preDocSelect->clone() : NodeUP()),
+                                     _docType);
 }
 
 }
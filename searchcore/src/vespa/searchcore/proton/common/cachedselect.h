@@ -6,9 +6,13 @@
 #include <vector>
 
 namespace document {
+    class DocumentType;
     class DocumentTypeRepo;
     class Document;
-    namespace select { class Node; }
+    namespace select {
+        class CompiledSelection;
+        class Node;
+    }
 }
 namespace search {
     class AttributeVector;
@@ -36,11 +40,14 @@ public:
         std::unique_ptr<document::select::Node> _docSelect;
         std::unique_ptr<document::select::Node> _preDocOnlySelect;
         std::unique_ptr<document::select::Node> _preDocSelect;
+        std::unique_ptr<document::select::CompiledSelection> _compiledDocSelect;
 
     public:
         Session(std::unique_ptr<document::select::Node> docSelect,
                 std::unique_ptr<document::select::Node> preDocOnlySelect,
-                std::unique_ptr<document::select::Node> preDocSelect);
+                std::unique_ptr<document::select::Node> preDocSelect,
+                const document::DocumentType *docType);
+        ~Session();
         bool contains(const SelectContext &context) const;
         bool contains(const document::Document &doc) const;
         const document::select::Node &selectNode() const;
@@ -76,6 +83,10 @@ private:
      */
     std::unique_ptr<document::select::Node> _preDocSelect;
 
+    // Document type of selection, used to compile selection expression
+    // for each session. Only set when selection is pruned for a document type.
+    const document::DocumentType *_docType;
+
     void setDocumentSelect(SelectPruner &docsPruner);
     void setPreDocumentSelect(const search::IAttributeManager &amgr,
                               SelectPruner &noDocsPruner);
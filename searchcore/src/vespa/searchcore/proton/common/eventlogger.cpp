@@ -55,7 +55,7 @@ EventLogger::transactionLogReplayStart(const string &domainName, SerialNum first
 
 void
 EventLogger::transactionLogReplayProgress(const string &domainName, float progress,
-                                          SerialNum first, SerialNum last, SerialNum current)
+                                          SerialNum first, SerialNum last, SerialNum current, double throughput)
 {
     JSONStringer jstr;
     jstr.beginObject();
@@ -67,6 +67,7 @@ EventLogger::transactionLogReplayProgress(const string &domainName, float progre
         .appendKey("last").appendInt64(last)
         .appendKey("current").appendInt64(current)
         .endObject();
+    jstr.appendKey("throughput").appendDouble(throughput);
     jstr.endObject();
     EV_STATE("transactionlog.replay.progress", jstr.toString().data());
 }
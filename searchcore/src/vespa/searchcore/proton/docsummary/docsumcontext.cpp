@@ -71,6 +71,9 @@ makeSlimeParams(size_t chunkSize) {
     return params;
 }
 
+// Number of documents fetched from the document store in a single batch
+constexpr uint32_t PREFETCH_WINDOW = 128;
+
 }
 
 vespalib::Slime::UP
@@ -86,7 +89,12 @@ DocsumContext::createSlimeReply()
                                                                          _docsumStore.getSummaryClassId());
     _docsumState._omit_summary_features = rci.outputClass->omit_summary_features();
     uint32_t i(0);
+    const bool prefetch = !rci.mustSkip && !rci.allGenerated;
     for (i = 0; (i < _docsumState._docsumcnt) && !_request.expired(); ++i) {
+        if (prefetch && ((i % PREFETCH_WINDOW) == 0)) {
+            uint32_t count = std::min(PREFETCH_WINDOW, _docsumState._docsumcnt - i);
+            _docsumStore.prefetch(vespalib::ConstArrayRef<uint32_t>(_docsumState._docsumbuf + i, count));
+        }
         uint32_t docId = _docsumState._docsumbuf[i];
         Cursor & docSumC = array.addObject();
         ObjectSymbolInserter inserter(docSumC, docsumSym);
@@ -6,6 +6,8 @@
 #include <vespa/eval/eval/value_codec.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/document/fieldvalue/tensorfieldvalue.h>
+#include <vespa/searchlib/queryeval/begin_and_end_id.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.docsummary.documentstoreadapter");
@@ -19,6 +21,18 @@ namespace {
 
 const vespalib::string DOCUMENT_ID_FIELD("documentid");
 
+class PrefetchVisitor : public search::IDocumentVisitor {
+    vespalib::hash_map<uint32_t, search::IDocumentStore::DocumentUP> & _prefetched;
+public:
+    explicit PrefetchVisitor(vespalib::hash_map<uint32_t, search::IDocumentStore::DocumentUP> & prefetched)
+        : _prefetched(prefetched)
+    { }
+    void visit(uint32_t lid, search::IDocumentStore::DocumentUP doc) override {
+        _prefetched[lid] = std::move(doc);
+    }
+    bool allowVisitCaching() const override { return false; }
+};
+
 }
 
 bool
@@ -153,7 +167,8 @@ DocumentStoreAdapter(const search::IDocumentStore & docStore,
                    LookupResultClass(resultConfig.LookupResultClassId(resultClassName.c_str()))),
       _resultPacker(&_resultConfig),
       _fieldCache(fieldCache),
-      _markupFields(markupFields)
+      _markupFields(markupFields),
+      _prefetched()
 {
 }
 
@@ -166,7 +181,14 @@ DocumentStoreAdapter::getMappedDocsum(uint32_t docId)
         LOG(warning, "Error during init of result class '%s' with class id %u", _resultClass->GetClassName(), getSummaryClassId());
         return DocsumStoreValue();
     }
-    Document::UP document = _docStore.read(docId, _repo);
+    Document::UP document;
+    auto found = _prefetched.find(docId);
+    if (found != _prefetched.end()) {
+        document = std::move(found->second);
+        _prefetched.erase(docId);
+    } else {
+        document = _docStore.read(docId, _repo);
+    }
     if ( ! document) {
         LOG(debug, "Did not find summary document for docId %u. Returning empty docsum", docId);
         return DocsumStoreValue();
@@ -182,4 +204,22 @@ DocumentStoreAdapter::getMappedDocsum(uint32_t docId)
     return DocsumStoreValue(buf, buflen, std::move(document));
 }
 
+void
+DocumentStoreAdapter::prefetch(vespalib::ConstArrayRef<uint32_t> docIds)
+{
+    _prefetched.clear();
+    if ( ! _docStore.readsInBatches()) {
+        return; // Reading one document at a time when needed is just as cheap
+    }
+    search::IDocumentStore::LidVector lids;
+    lids.reserve(docIds.size());
+    for (uint32_t docId : docIds) {
+        if (docId != search::endDocId) {
+            lids.push_back(docId);
+        }
+    }
+    PrefetchVisitor visitor(_prefetched);
+    _docStore.readBatch(lids, _repo, visitor);
+}
+
 } // namespace proton
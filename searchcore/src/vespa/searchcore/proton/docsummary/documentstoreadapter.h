@@ -8,6 +8,7 @@
 #include <vespa/searchsummary/docsummary/resultpacker.h>
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/searchlib/docstore/idocumentstore.h>
+#include <vespa/vespalib/stllike/hash_map.h>
 
 namespace proton {
 
@@ -21,6 +22,7 @@ private:
     search::docsummary::ResultPacker         _resultPacker;
     FieldCache::CSP                          _fieldCache;
     const std::set<vespalib::string>       & _markupFields;
+    vespalib::hash_map<uint32_t, search::IDocumentStore::DocumentUP> _prefetched;
 
     bool
     writeStringField(const char * buf,
@@ -49,6 +51,7 @@ public:
 
     uint32_t getNumDocs() const override { return _docStore.getDocIdLimit(); }
     search::docsummary::DocsumStoreValue getMappedDocsum(uint32_t docId) override;
+    void prefetch(vespalib::ConstArrayRef<uint32_t> docIds) override;
     uint32_t getSummaryClassId() const override { return _resultClass->GetClassID(); }
 
 };
@@ -200,6 +200,7 @@ public:
     void getMetaData(const BucketId &bucketId, search::DocumentMetaData::Vector &result) const override;
     DocId   getNumUsedLids() const override { return _lidAlloc.getNumUsedLids(); }
     DocId getNumActiveLids() const override { return _lidAlloc.getNumActiveLids(); }
+    uint64_t getActiveLidsGeneration() const override { return _lidAlloc.getActiveLidsGeneration(); }
     search::LidUsageStats getLidUsageStats() const override;
     search::queryeval::Blueprint::UP createWhiteListBlueprint() const override;
 
@@ -72,6 +72,13 @@ struct IDocumentMetaStore : public search::IDocumentMetaStore,
     virtual bool canShrinkLidSpace() const = 0;
     virtual SerialNum getLastSerialNum() const = 0;
 
+    /*
+     * Returns a counter incremented each time a lid is activated or
+     * deactivated, e.g. by a bucket changing its active state. Such
+     * changes are visible for search without any commit.
+     */
+    virtual uint64_t getActiveLidsGeneration() const = 0;
+
     /*
      * Adjust committedDocIdLimit downwards and prepare for shrinking
      * of lid space.
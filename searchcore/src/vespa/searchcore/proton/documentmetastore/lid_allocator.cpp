@@ -27,7 +27,8 @@ LidAllocator::LidAllocator(uint32_t size,
       _pendingHoldLids(size, capacity, genHolder, false, false),
       _lidFreeListConstructed(false),
       _activeLids(size, capacity, genHolder, false, false),
-      _numActiveLids(0u)
+      _numActiveLids(0u),
+      _activeLidsGeneration(0u)
 {
 
 }
@@ -76,6 +77,7 @@ LidAllocator::unregisterLid(DocId lid)
     if (_activeLids.testBit(lid)) {
         _activeLids.clearBit(lid);
         _numActiveLids.store(_activeLids.count(), std::memory_order_relaxed);
+        _activeLidsGeneration.fetch_add(1, std::memory_order_release);
     }
 }
 
@@ -238,6 +240,7 @@ LidAllocator::updateActiveLids(DocId lid, bool active)
             _activeLids.clearBit(lid);
         }
         _numActiveLids.store(_activeLids.count(), std::memory_order_relaxed);
+        _activeLidsGeneration.fetch_add(1, std::memory_order_release);
     }
 }
 
@@ -27,6 +27,7 @@ private:
     bool                        _lidFreeListConstructed;
     LidStateVector              _activeLids;
     std::atomic<uint32_t>       _numActiveLids;
+    std::atomic<uint64_t>       _activeLidsGeneration;
 
 public:
     LidAllocator(uint32_t size,
@@ -58,6 +59,10 @@ public:
     uint32_t getNumActiveLids() const noexcept {
         return _numActiveLids.load(std::memory_order_relaxed);
     }
+    // Incremented each time a lid is activated or deactivated.
+    uint64_t getActiveLidsGeneration() const noexcept {
+        return _activeLidsGeneration.load(std::memory_order_acquire);
+    }
     void setFreeListConstructed() {
         _lidFreeListConstructed = true;
     }
@@ -35,8 +35,50 @@ sortTargetList(FlushContext::List &allTargets)
     });
 }
 
+void
+convertToSlime(const flushengine::FlushPrediction &prediction, Cursor &object)
+{
+    object.setLong("writeBytes", prediction.writeBytes);
+    object.setDouble("duration", vespalib::to_s(prediction.duration));
+    object.setLong("memoryRelease", prediction.memoryRelease);
+    object.setBool("fromHistory", prediction.fromHistory);
+}
+
+void
+convertToSlime(const flushengine::FlushScheduler &scheduler, Cursor &object)
+{
+    object.setLong("diskWriteBudget", scheduler.getConfig().diskWriteBudget);
+    object.setDouble("inFlightWriteRate", scheduler.getInFlightWriteRate());
+    Cursor &inFlight = object.setArray("inFlight");
+    for (const auto &entry : scheduler.getInFlight()) {
+        Cursor &flush = inFlight.addObject();
+        flush.setString("name", entry.second.name);
+        convertToSlime(entry.second.prediction, flush.setObject("predicted"));
+    }
+    Cursor &history = object.setArray("history");
+    for (const auto &entry : scheduler.getHistory()) {
+        Cursor &target = history.addObject();
+        target.setString("name", entry.first);
+        target.setLong("numFlushes", entry.second.numFlushes);
+        target.setDouble("avgWriteBytes", entry.second.avgWriteBytes);
+        target.setDouble("avgDuration", entry.second.avgDurationSecs);
+        target.setDouble("avgWriteRate", entry.second.avgWriteRate);
+        target.setDouble("memoryReleaseFactor", entry.second.memoryReleaseFactor);
+    }
+    Cursor &decisions = object.setArray("decisions");
+    for (const auto &decision : scheduler.getDecisions()) {
+        Cursor &entry = decisions.addObject();
+        entry.setString("name", decision.name);
+        entry.setString("time", vespalib::to_string(decision.time));
+        entry.setBool("admitted", decision.admitted);
+        entry.setDouble("inFlightWriteRate", decision.inFlightWriteRate);
+        convertToSlime(decision.prediction, entry.setObject("predicted"));
+    }
+}
+
 void
 convertToSlime(const FlushContext::List &allTargets,
+               const flushengine::FlushScheduler &scheduler,
                const vespalib::system_time &now,
                Cursor &array)
 {
@@ -51,6 +93,7 @@ convertToSlime(const FlushContext::List &allTargets,
         vespalib::duration timeSinceLastFlush = now - target->getLastFlushTime();
         object.setDouble("timeSinceLastFlush", vespalib::to_s(timeSinceLastFlush));
         object.setBool("needUrgentFlush", target->needUrgentFlush());
+        convertToSlime(scheduler.predict(*ctx), object.setObject("predicted"));
     }
 }
 
@@ -70,7 +113,8 @@ FlushEngineExplorer::get_state(const Inserter &inserter, bool full) const
         convertToSlime(_engine.getCurrentlyFlushingSet(), object.setArray("flushingTargets"));
         FlushContext::List allTargets = _engine.getTargetList(true);
         sortTargetList(allTargets);
-        convertToSlime(allTargets, now, object.setArray("allTargets"));
+        convertToSlime(allTargets, _engine.getScheduler(), now, object.setArray("allTargets"));
+        convertToSlime(_engine.getScheduler(), object.setObject("scheduler"));
     }
 }
 
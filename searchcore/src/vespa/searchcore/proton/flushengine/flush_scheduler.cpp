@@ -0,0 +1,301 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "flush_scheduler.h"
+#include <algorithm>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".proton.flushengine.flush_scheduler");
+
+using searchcorespi::IFlushTarget;
+
+namespace proton::flushengine {
+
+namespace {
+
+double
+movingAverage(size_t numSamples, double average, double sample)
+{
+    if (numSamples == 0) {
+        return sample;
+    }
+    return (1.0 - FlushScheduler::history_weight) * average + FlushScheduler::history_weight * sample;
+}
+
+}
+
+FlushPrediction::FlushPrediction() noexcept
+    : FlushPrediction(0, vespalib::duration::zero(), 0, false)
+{ }
+
+FlushPrediction::FlushPrediction(uint64_t writeBytes_in, vespalib::duration duration_in,
+                                 int64_t memoryRelease_in, bool fromHistory_in) noexcept
+    : writeBytes(writeBytes_in),
+      duration(duration_in),
+      memoryRelease(memoryRelease_in),
+      fromHistory(fromHistory_in)
+{ }
+
+double
+FlushPrediction::efficiency() const noexcept
+{
+    return double(std::max(INT64_C(0), memoryRelease)) / std::max(UINT64_C(1), writeBytes);
+}
+
+double
+FlushPrediction::writeRate() const noexcept
+{
+    double secs = vespalib::to_s(duration);
+    return (secs > 0.0) ? (writeBytes / secs) : 0.0;
+}
+
+FlushScheduler::Config::Config() noexcept
+    : Config(0)
+{ }
+
+FlushScheduler::Config::Config(uint64_t diskWriteBudget_in) noexcept
+    : diskWriteBudget(diskWriteBudget_in)
+{ }
+
+FlushScheduler::TargetHistory::TargetHistory() noexcept
+    : numFlushes(0),
+      avgWriteBytes(0.0),
+      avgDurationSecs(0.0),
+      avgWriteRate(0.0),
+      memoryReleaseFactor(1.0)
+{ }
+
+void
+FlushScheduler::TargetHistory::add(uint64_t writeBytes, vespalib::duration duration,
+                                   int64_t predictedGain, int64_t released) noexcept
+{
+    double secs = vespalib::to_s(duration);
+    avgWriteBytes = movingAverage(numFlushes, avgWriteBytes, writeBytes);
+    avgDurationSecs = movingAverage(numFlushes, avgDurationSecs, secs);
+    if ((writeBytes > 0) && (secs > 0.0)) {
+        avgWriteRate = movingAverage((avgWriteRate > 0.0) ? numFlushes : 0, avgWriteRate, writeBytes / secs);
+    }
+    if (predictedGain > 0) {
+        double factor = std::min(2.0, double(released) / predictedGain);
+        memoryReleaseFactor = movingAverage(numFlushes, memoryReleaseFactor, factor);
+    }
+    ++numFlushes;
+}
+
+FlushScheduler::InFlight::InFlight() noexcept
+    : name(),
+      prediction(),
+      approxWriteBytes(0),
+      approxMemoryGain(0),
+      memoryBefore(0)
+{ }
+
+FlushScheduler::InFlight::InFlight(const vespalib::string &name_in, const FlushPrediction &prediction_in,
+                                   uint64_t approxWriteBytes_in, int64_t approxMemoryGain_in, int64_t memoryBefore_in)
+    : name(name_in),
+      prediction(prediction_in),
+      approxWriteBytes(approxWriteBytes_in),
+      approxMemoryGain(approxMemoryGain_in),
+      memoryBefore(memoryBefore_in)
+{ }
+
+FlushScheduler::InFlight::~InFlight() = default;
+
+FlushScheduler::Decision::Decision(const vespalib::string &name_in, bool admitted_in, const FlushPrediction &prediction_in,
+                                   double inFlightWriteRate_in, vespalib::system_time time_in)
+    : name(name_in),
+      admitted(admitted_in),
+      prediction(prediction_in),
+      inFlightWriteRate(inFlightWriteRate_in),
+      time(time_in)
+{ }
+
+FlushScheduler::Decision::~Decision() = default;
+
+FlushScheduler::FlushScheduler()
+    : FlushScheduler(Config())
+{ }
+
+FlushScheduler::FlushScheduler(const Config &config)
+    : _lock(),
+      _config(config),
+      _history(),
+      _global(),
+      _inFlight(),
+      _decisions()
+{ }
+
+FlushScheduler::~FlushScheduler() = default;
+
+void
+FlushScheduler::setConfig(const Config &config)
+{
+    Guard guard(_lock);
+    _config = config;
+}
+
+FlushScheduler::Config
+FlushScheduler::getConfig() const
+{
+    Guard guard(_lock);
+    return _config;
+}
+
+FlushPrediction
+FlushScheduler::predict(const FlushContext &ctx) const
+{
+    Guard guard(_lock);
+    return predict(guard, ctx);
+}
+
+FlushPrediction
+FlushScheduler::predict(const Guard &, const FlushContext &ctx) const
+{
+    const IFlushTarget &target = *ctx.getTarget();
+    uint64_t writeBytes = target.getApproxBytesToWriteToDisk();
+    int64_t memoryGain = std::max(INT64_C(0), target.getApproxMemoryGain().gain());
+    auto itr = _history.find(ctx.getName());
+    const TargetHistory *history = (itr != _history.end()) ? &itr->second : nullptr;
+    if ((writeBytes == 0) && (history != nullptr)) {
+        writeBytes = history->avgWriteBytes;
+    }
+    double rate = ((history != nullptr) && (history->avgWriteRate > 0.0)) ? history->avgWriteRate : _global.avgWriteRate;
+    vespalib::duration duration = vespalib::duration::zero();
+    if ((rate > 0.0) && (writeBytes > 0)) {
+        duration = vespalib::from_s(writeBytes / rate);
+    } else if (history != nullptr) {
+        duration = vespalib::from_s(history->avgDurationSecs);
+    }
+    int64_t memoryRelease = (history != nullptr) ? int64_t(memoryGain * history->memoryReleaseFactor) : memoryGain;
+    return FlushPrediction(writeBytes, duration, memoryRelease, history != nullptr);
+}
+
+double
+FlushScheduler::writeRate(const Guard &, const FlushPrediction &prediction) const
+{
+    if (prediction.writeBytes == 0) {
+        return 0.0;
+    }
+    if (prediction.duration <= vespalib::duration::zero()) {
+        // Unknown duration, assume the flush uses the whole budget.
+        return _config.diskWriteBudget;
+    }
+    return prediction.writeRate();
+}
+
+double
+FlushScheduler::inFlightWriteRate(const Guard &guard) const
+{
+    double rate = 0.0;
+    for (const auto &entry : _inFlight) {
+        rate += writeRate(guard, entry.second.prediction);
+    }
+    return rate;
+}
+
+FlushContext::List
+FlushScheduler::order(const FlushContext::List &targets, bool memoryTriggered) const
+{
+    Guard guard(_lock);
+    if ((_config.diskWriteBudget == 0) || !memoryTriggered) {
+        return targets;
+    }
+    std::vector<std::pair<double, FlushContext::SP>> candidates;
+    candidates.reserve(targets.size());
+    for (const auto &ctx : targets) {
+        candidates.emplace_back(predict(guard, *ctx).efficiency(), ctx);
+    }
+    std::stable_sort(candidates.begin(), candidates.end(), [](const auto &lhs, const auto &rhs) {
+        bool lhsUrgent = lhs.second->getTarget()->needUrgentFlush();
+        bool rhsUrgent = rhs.second->getTarget()->needUrgentFlush();
+        if (lhsUrgent != rhsUrgent) {
+            return lhsUrgent;
+        }
+        return lhs.first > rhs.first;
+    });
+    FlushContext::List result;
+    result.reserve(candidates.size());
+    for (auto &candidate : candidates) {
+        result.push_back(std::move(candidate.second));
+    }
+    return result;
+}
+
+bool
+FlushScheduler::admit(const FlushContext &ctx, bool memoryTriggered)
+{
+    Guard guard(_lock);
+    FlushPrediction prediction = predict(guard, ctx);
+    double inFlightRate = inFlightWriteRate(guard);
+    bool admitted = (_config.diskWriteBudget == 0) ||
+                    !memoryTriggered ||
+                    _inFlight.empty() ||
+                    ctx.getTarget()->needUrgentFlush() ||
+                    (inFlightRate + writeRate(guard, prediction) <= _config.diskWriteBudget);
+    if (!admitted) {
+        LOG(debug, "Deferring flush of '%s': predicted write rate %1.0f + %1.0f exceeds budget %" PRIu64 " bytes/s",
+            ctx.getName().c_str(), inFlightRate, writeRate(guard, prediction), _config.diskWriteBudget);
+    }
+    _decisions.emplace_back(ctx.getName(), admitted, prediction, inFlightRate, vespalib::system_clock::now());
+    while (_decisions.size() > max_decisions) {
+        _decisions.pop_front();
+    }
+    return admitted;
+}
+
+void
+FlushScheduler::flushStarted(uint32_t taskId, const FlushContext &ctx)
+{
+    Guard guard(_lock);
+    const IFlushTarget &target = *ctx.getTarget();
+    IFlushTarget::MemoryGain memoryGain = target.getApproxMemoryGain();
+    _inFlight[taskId] = InFlight(ctx.getName(), predict(guard, ctx), target.getApproxBytesToWriteToDisk(),
+                                 std::max(INT64_C(0), memoryGain.gain()), memoryGain.getBefore());
+}
+
+void
+FlushScheduler::flushDone(uint32_t taskId, vespalib::duration duration, int64_t memoryAfter)
+{
+    Guard guard(_lock);
+    auto itr = _inFlight.find(taskId);
+    if (itr == _inFlight.end()) {
+        return;
+    }
+    const InFlight &flush = itr->second;
+    int64_t released = std::max(INT64_C(0), flush.memoryBefore - memoryAfter);
+    LOG(debug, "Flush of '%s' done: wrote ~%" PRIu64 " bytes in %1.3f s (predicted %1.3f s), released %" PRId64 " bytes (predicted %" PRId64 ")",
+        flush.name.c_str(), flush.approxWriteBytes, vespalib::to_s(duration), vespalib::to_s(flush.prediction.duration),
+        released, flush.prediction.memoryRelease);
+    _history[flush.name].add(flush.approxWriteBytes, duration, flush.approxMemoryGain, released);
+    _global.add(flush.approxWriteBytes, duration, flush.approxMemoryGain, released);
+    _inFlight.erase(itr);
+}
+
+double
+FlushScheduler::getInFlightWriteRate() const
+{
+    Guard guard(_lock);
+    return inFlightWriteRate(guard);
+}
+
+FlushScheduler::HistoryMap
+FlushScheduler::getHistory() const
+{
+    Guard guard(_lock);
+    return _history;
+}
+
+FlushScheduler::InFlightMap
+FlushScheduler::getInFlight() const
+{
+    Guard guard(_lock);
+    return _inFlight;
+}
+
+FlushScheduler::DecisionList
+FlushScheduler::getDecisions() const
+{
+    Guard guard(_lock);
+    return _decisions;
+}
+
+}
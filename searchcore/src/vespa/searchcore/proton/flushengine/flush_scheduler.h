@@ -0,0 +1,148 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "flushcontext.h"
+#include <vespa/vespalib/util/time.h>
+#include <deque>
+#include <map>
+#include <mutex>
+
+namespace proton::flushengine {
+
+/**
+ * Predicted cost and benefit of flushing a single target.
+ */
+struct FlushPrediction {
+    uint64_t           writeBytes;
+    vespalib::duration duration;
+    int64_t            memoryRelease;
+    bool               fromHistory;
+
+    FlushPrediction() noexcept;
+    FlushPrediction(uint64_t writeBytes_in, vespalib::duration duration_in, int64_t memoryRelease_in, bool fromHistory_in) noexcept;
+    /// Bytes of memory released per byte written to disk.
+    double efficiency() const noexcept;
+    /// Average disk write rate (bytes per second) while the flush is running.
+    double writeRate() const noexcept;
+};
+
+/**
+ * Schedules flushes selected by the flush strategy according to a
+ * disk write budget.
+ *
+ * For each flush target (identified by handler and target name) a
+ * history of completed flushes is kept, tracking bytes written, flush
+ * duration and memory actually released as moving averages. This is
+ * used to predict the cost and benefit of the next flush of the same
+ * target. When a disk write budget is configured and the strategy
+ * selected the candidates to release memory, they are ordered to maximize
+ * memory released per byte written (urgent targets first), and a new
+ * flush is only started if the predicted write rate of all running
+ * flushes, including fusion and other GC targets, stays within the
+ * budget. A single flush is always allowed to run to avoid starvation.
+ * Candidates selected for other reasons (e.g. transaction log size, age
+ * or disk bloat) are neither reordered nor deferred.
+ */
+class FlushScheduler {
+public:
+    struct Config {
+        /// Disk write budget in bytes per second. 0 means unlimited.
+        uint64_t diskWriteBudget;
+        Config() noexcept;
+        explicit Config(uint64_t diskWriteBudget_in) noexcept;
+        bool operator==(const Config &rhs) const noexcept { return diskWriteBudget == rhs.diskWriteBudget; }
+    };
+
+    struct TargetHistory {
+        size_t   numFlushes;
+        double   avgWriteBytes;
+        double   avgDurationSecs;
+        double   avgWriteRate;
+        double   memoryReleaseFactor;
+        TargetHistory() noexcept;
+        void add(uint64_t writeBytes, vespalib::duration duration, int64_t predictedGain, int64_t released) noexcept;
+    };
+
+    struct InFlight {
+        vespalib::string   name;
+        FlushPrediction    prediction;
+        uint64_t           approxWriteBytes;
+        int64_t            approxMemoryGain;
+        int64_t            memoryBefore;
+        InFlight() noexcept;
+        InFlight(const vespalib::string &name_in, const FlushPrediction &prediction_in,
+                 uint64_t approxWriteBytes_in, int64_t approxMemoryGain_in, int64_t memoryBefore_in);
+        ~InFlight();
+    };
+
+    struct Decision {
+        vespalib::string      name;
+        bool                  admitted;
+        FlushPrediction       prediction;
+        double                inFlightWriteRate;
+        vespalib::system_time time;
+        Decision(const vespalib::string &name_in, bool admitted_in, const FlushPrediction &prediction_in,
+                 double inFlightWriteRate_in, vespalib::system_time time_in);
+        ~Decision();
+    };
+
+    using HistoryMap = std::map<vespalib::string, TargetHistory>;
+    using InFlightMap = std::map<uint32_t, InFlight>;
+    using DecisionList = std::deque<Decision>;
+
+    static constexpr double history_weight = 0.3;
+    static constexpr size_t max_decisions = 32;
+
+    FlushScheduler();
+    explicit FlushScheduler(const Config &config);
+    ~FlushScheduler();
+
+    void setConfig(const Config &config);
+    Config getConfig() const;
+
+    /**
+     * Predict the outcome of flushing the given target, based on its current
+     * estimates and the history of previous flushes.
+     */
+    FlushPrediction predict(const FlushContext &ctx) const;
+
+    /**
+     * Order the candidates selected by the strategy. Without a budget, or
+     * when the candidates were not selected to release memory only, the
+     * order is left as is.
+     */
+    FlushContext::List order(const FlushContext::List &targets, bool memoryTriggered) const;
+
+    /**
+     * Returns whether the given target can start flushing now without
+     * exceeding the disk write budget. Targets not selected to release
+     * memory only are always admitted. The decision is recorded.
+     */
+    bool admit(const FlushContext &ctx, bool memoryTriggered);
+
+    void flushStarted(uint32_t taskId, const FlushContext &ctx);
+    /**
+     * Update the history of a completed flush. memoryAfter is the memory
+     * used by the target after the flush completed.
+     */
+    void flushDone(uint32_t taskId, vespalib::duration duration, int64_t memoryAfter);
+
+    double getInFlightWriteRate() const;
+    HistoryMap getHistory() const;
+    InFlightMap getInFlight() const;
+    DecisionList getDecisions() const;
+private:
+    using Guard = std::lock_guard<std::mutex>;
+    FlushPrediction predict(const Guard &guard, const FlushContext &ctx) const;
+    double inFlightWriteRate(const Guard &guard) const;
+    double writeRate(const Guard &guard, const FlushPrediction &prediction) const;
+
+    mutable std::mutex _lock;
+    Config             _config;
+    HistoryMap         _history;
+    TargetHistory      _global;
+    InFlightMap        _inFlight;
+    DecisionList       _decisions;
+};
+
+}
@@ -98,7 +98,8 @@ FlushEngine::FlushEngine(std::shared_ptr<flushengine::ITlsStatsFactory> tlsStats
       _tlsStatsFactory(std::move(tlsStatsFactory)),
       _pendingPrune(),
       _normal_flush_token(std::make_shared<search::FlushToken>()),
-      _gc_flush_token(std::make_shared<search::FlushToken>())
+      _gc_flush_token(std::make_shared<search::FlushToken>()),
+      _scheduler()
 { }
 
 FlushEngine::~FlushEngine()
@@ -260,17 +261,21 @@ FlushEngine::getTargetList(bool includeFlushingTargets) const
     return ret;
 }
 
-std::pair<FlushContext::List,bool>
+FlushEngine::SortedTargets
 FlushEngine::getSortedTargetList()
 {
     FlushContext::List unsortedTargets = getTargetList(false);
     flushengine::TlsStatsMap tlsStatsMap(_tlsStatsFactory->create());
     std::lock_guard<std::mutex> strategyGuard(_strategyLock);
-    std::pair<FlushContext::List, bool> ret;
+    SortedTargets ret;
     if (_priorityStrategy) {
-        ret = std::make_pair(_priorityStrategy->getFlushTargets(unsortedTargets, tlsStatsMap), true);
+        ret.targets = _priorityStrategy->getFlushTargets(unsortedTargets, tlsStatsMap);
+        ret.fromPriorityStrategy = true;
+        ret.memoryTriggered = false;
     } else {
-        ret = std::make_pair(_strategy->getFlushTargets(unsortedTargets, tlsStatsMap), false);
+        ret.targets = _strategy->getFlushTargets(unsortedTargets, tlsStatsMap);
+        ret.fromPriorityStrategy = false;
+        ret.memoryTriggered = _strategy->selectsByMemoryGain(unsortedTargets, tlsStatsMap);
     }
     return ret;
 }
@@ -286,10 +291,13 @@ FlushEngine::get_flush_token(const FlushContext& ctx)
 }
 
 FlushContext::SP
-FlushEngine::initNextFlush(const FlushContext::List &lst)
+FlushEngine::initNextFlush(const FlushContext::List &lst, bool memoryTriggered)
 {
     FlushContext::SP ctx;
     for (const FlushContext::SP & it : lst) {
+        if ( ! _scheduler.admit(*it, memoryTriggered)) {
+            continue;
+        }
         if (LOG_WOULD_LOG(event)) {
             EventLogger::flushInit(it->getName());
         }
@@ -323,10 +331,10 @@ FlushEngine::flushAll(const FlushContext::List &lst)
 vespalib::string
 FlushEngine::flushNextTarget(const vespalib::string & name)
 {
-    std::pair<FlushContext::List,bool> lst = getSortedTargetList();
-    if (lst.second) {
+    SortedTargets lst = getSortedTargetList();
+    if (lst.fromPriorityStrategy) {
         // Everything returned from a priority strategy should be flushed
-        flushAll(lst.first);
+        flushAll(lst.targets);
         _executor.sync();
         prune();
         std::lock_guard<std::mutex> strategyGuard(_strategyLock);
@@ -334,19 +342,19 @@ FlushEngine::flushNextTarget(const vespalib::string & name)
         _strategyCond.notify_all();
         return "";
     }
-    if (lst.first.empty()) {
+    if (lst.targets.empty()) {
         LOG(debug, "No target to flush.");
         return "";
     }
-    FlushContext::SP ctx = initNextFlush(lst.first);
+    FlushContext::SP ctx = initNextFlush(_scheduler.order(lst.targets, lst.memoryTriggered), lst.memoryTriggered);
     if ( ! ctx) {
-        LOG(debug, "All targets refused to flush.");
+        LOG(debug, "All targets refused or were deferred by the flush scheduler.");
         return "";
     }
     if ( name == ctx->getName()) {
         LOG(info, "The same target %s out of %ld has been asked to flush again. "
                   "This might indicate flush logic flaw so I will wait 100 ms before doing it.",
-                  name.c_str(), lst.first.size());
+                  name.c_str(), lst.targets.size());
         std::this_thread::sleep_for(100ms);
     }
     _executor.execute(std::make_unique<FlushTask>(initFlush(*ctx), *this, ctx));
@@ -361,7 +369,9 @@ FlushEngine::initFlush(const FlushContext &ctx)
         EventLogger::flushStart(ctx.getName(), mgain.getBefore(), mgain.getAfter(), mgain.gain(),
                                 ctx.getTarget()->getFlushedSerialNum() + 1, ctx.getHandler()->getCurrentSerialNumber());
     }
-    return initFlush(ctx.getHandler(), ctx.getTarget());
+    uint32_t taskId = initFlush(ctx.getHandler(), ctx.getTarget());
+    _scheduler.flushStarted(taskId, ctx);
+    return taskId;
 }
 
 void
@@ -377,6 +387,11 @@ FlushEngine::flushDone(const FlushContext &ctx, uint32_t taskId)
         EventLogger::flushComplete(ctx.getName(), duration, ctx.getTarget()->getFlushedSerialNum(),
                                    stats.getPath(), stats.getPathElementsToLog());
     }
+    const IFlushTarget *target = ctx.getTarget().get();
+    if (auto cached = dynamic_cast<CachedFlushTarget *>(ctx.getTarget().get())) {
+        target = cached->getFlushTarget().get();
+    }
+    _scheduler.flushDone(taskId, duration, target->getApproxMemoryGain().getBefore());
     LOG(debug, "FlushEngine::flushDone(taskId='%d') took '%f' secs", taskId, vespalib::to_s(duration));
     std::lock_guard<std::mutex> guard(_lock);
     _flushing.erase(taskId);
@@ -435,6 +450,13 @@ FlushEngine::initFlush(const IFlushHandler::SP &handler, const IFlushTarget::SP
     return taskId;
 }
 
+void
+FlushEngine::setSchedulerConfig(const flushengine::FlushScheduler::Config &config)
+{
+    _scheduler.setConfig(config);
+    kick();
+}
+
 void
 FlushEngine::setStrategy(IFlushStrategy::SP strategy)
 {
@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include "flush_scheduler.h"
 #include "flushcontext.h"
 #include "iflushstrategy.h"
 #include <vespa/searchcore/proton/common/handlermap.hpp>
@@ -46,6 +47,12 @@ private:
 
         IFlushTarget::SP  _target;
     };
+    struct SortedTargets
+    {
+        FlushContext::List targets;
+        bool               fromPriorityStrategy; // all targets should be flushed
+        bool               memoryTriggered;      // may be reordered and deferred by the flush scheduler
+    };
     typedef std::map<uint32_t, FlushInfo> FlushMap;
     typedef HandlerMap<IFlushHandler> FlushHandlerMap;
     bool                           _closed;
@@ -67,11 +74,12 @@ private:
     std::set<IFlushHandler::SP>    _pendingPrune;
     std::shared_ptr<search::FlushToken> _normal_flush_token;
     std::shared_ptr<search::FlushToken> _gc_flush_token;
+    flushengine::FlushScheduler    _scheduler;
 
     FlushContext::List getTargetList(bool includeFlushingTargets) const;
-    std::pair<FlushContext::List,bool> getSortedTargetList();
+    SortedTargets getSortedTargetList();
     std::shared_ptr<search::IFlushToken> get_flush_token(const FlushContext& ctx);
-    FlushContext::SP initNextFlush(const FlushContext::List &lst);
+    FlushContext::SP initNextFlush(const FlushContext::List &lst, bool memoryTriggered);
     vespalib::string flushNextTarget(const vespalib::string & name);
     void flushAll(const FlushContext::List &lst);
     bool prune();
@@ -171,6 +179,14 @@ public:
     FlushMetaSet getCurrentlyFlushingSet() const;
 
     void setStrategy(IFlushStrategy::SP strategy);
+
+    /**
+     * Sets the disk write budget used when scheduling flushes selected by
+     * the normal strategy. Flushes requested by a priority strategy are not
+     * limited by the budget.
+     */
+    void setSchedulerConfig(const flushengine::FlushScheduler::Config &config);
+    const flushengine::FlushScheduler &getScheduler() const { return _scheduler; }
 };
 
 } // namespace proton
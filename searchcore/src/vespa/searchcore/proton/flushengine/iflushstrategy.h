@@ -30,6 +30,16 @@ public:
      */
     virtual FlushContext::List getFlushTargets(const FlushContext::List & targetList,
                                                const flushengine::TlsStatsMap & tlsStatsMap) const = 0;
+
+    /**
+     * Returns whether the targets returned from getFlushTargets() for the same
+     * input are selected to release memory only. Only then may the flush
+     * scheduler reorder and defer them to stay within the disk write budget.
+     * Targets selected due to e.g. transaction log size, age or disk bloat
+     * are flushed in the order given by the strategy.
+     */
+    virtual bool selectsByMemoryGain(const FlushContext::List &,
+                                     const flushengine::TlsStatsMap &) const { return false; }
 protected:
     IFlushStrategy() = default;
 };
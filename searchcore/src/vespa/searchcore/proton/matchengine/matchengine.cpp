@@ -7,6 +7,7 @@
 #include <vespa/vespalib/data/slime/binary_format.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/util/cpu_usage.h>
+#include <optional>
 
 #include <vespa/log/log.h>
 
@@ -43,8 +44,10 @@ namespace proton {
 
 using namespace vespalib::slime;
 using vespalib::CpuUsage;
+using vespalib::NumaTopology;
 
-MatchEngine::MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool async)
+MatchEngine::MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool async, bool numaAware,
+                         NumaTopology numaTopology)
     : _lock(),
       _distributionKey(distributionKey),
       _async(async),
@@ -53,11 +56,21 @@ MatchEngine::MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t di
       _handlers(),
       _executor(std::max(size_t(1), numThreads / threadsPerSearch), 256_Ki,
                 CpuUsage::wrap(match_engine_executor, CpuUsage::Category::READ)),
-      _threadBundlePool(std::max(size_t(1), threadsPerSearch),
-                        CpuUsage::wrap(match_engine_thread_bundle, CpuUsage::Category::READ)),
+      _numaTopology(std::move(numaTopology)),
+      _threadBundlePools(),
       _nodeUp(false),
       _nodeMaintenance(false)
 {
+    auto init_fun = CpuUsage::wrap(match_engine_thread_bundle, CpuUsage::Category::READ);
+    if (numaAware && _numaTopology.num_nodes() > 1) {
+        for (size_t node = 0; node < _numaTopology.num_nodes(); ++node) {
+            _threadBundlePools.push_back(std::make_unique<vespalib::SimpleThreadBundle::Pool>(std::max(size_t(1), threadsPerSearch),
+                                                                                              NumaTopology::wrap(init_fun, _numaTopology.cpus(node))));
+        }
+        LOG(info, "Using separate thread bundles for each of %zu numa nodes", _numaTopology.num_nodes());
+    } else {
+        _threadBundlePools.push_back(std::make_unique<vespalib::SimpleThreadBundle::Pool>(std::max(size_t(1), threadsPerSearch), init_fun));
+    }
 }
 
 MatchEngine::~MatchEngine()
@@ -128,12 +141,21 @@ MatchEngine::performSearch(search::engine::SearchRequest::Source req)
 
     auto ret = std::make_unique<search::engine::SearchReply>();
 
+    const bool numaAware = (_threadBundlePools.size() > 1);
+    size_t numaNode = 0;
     const search::engine::SearchRequest * searchRequest = req.get();
     if (searchRequest) {
         // 3 is the minimum level required for backend tracing.
         searchRequest->setTraceLevel(search::fef::indexproperties::trace::Level::lookup(searchRequest->propertiesMap.modelOverrides(), searchRequest->getTraceLevel()), 3);
+        // Match on the numa node we are running on, binding this thread to it as it runs part of the match.
+        std::optional<NumaTopology::BindGuard> bindGuard;
+        if (numaAware) {
+            numaNode = _numaTopology.current_node();
+            bindGuard.emplace(_numaTopology.cpus(numaNode));
+        }
+        auto &threadBundlePool = *_threadBundlePools[numaNode];
         ISearchHandler::SP searchHandler;
-        vespalib::SimpleThreadBundle::UP threadBundle = _threadBundlePool.obtain();
+        vespalib::SimpleThreadBundle::UP threadBundle = threadBundlePool.obtain();
         { // try to find the match handler corresponding to the specified search doc type
             DocTypeName docTypeName(*searchRequest);
             std::lock_guard<std::mutex> guard(_lock);
@@ -151,7 +173,7 @@ MatchEngine::performSearch(search::engine::SearchRequest::Source req)
                 ret = snapshot.get()->match(*searchRequest, *threadBundle); // use the first handler
             }
         }
-        _threadBundlePool.release(std::move(threadBundle));
+        threadBundlePool.release(std::move(threadBundle));
         if (searchRequest->expired()) {
             vespalib::Issue::report("search request timed out; results may be incomplete");
         }
@@ -167,6 +189,9 @@ MatchEngine::performSearch(search::engine::SearchRequest::Source req)
     ret->setDistributionKey(_distributionKey);
     if ((ret->request->trace().getLevel() > 0) && ret->request->trace().hasTrace()) {
         ret->request->trace().getRoot().setLong("distribution-key", _distributionKey);
+        if (numaAware) {
+            ret->request->trace().getRoot().setLong("numa-node", numaNode);
+        }
         ret->request->trace().done();
         search::fef::Properties & trace = ret->propertiesMap.lookupCreate("trace");
         vespalib::SmartBuffer output(4_Ki);
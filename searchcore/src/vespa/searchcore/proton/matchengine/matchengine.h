@@ -9,6 +9,7 @@
 #include <vespa/vespalib/net/http/state_explorer.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/util/simple_thread_bundle.h>
+#include <vespa/vespalib/util/numa_topology.h>
 #include <mutex>
 
 namespace proton {
@@ -24,7 +25,8 @@ private:
     std::atomic<bool>                  _forward_issues;
     HandlerMap<ISearchHandler>         _handlers;
     vespalib::ThreadStackExecutor      _executor;
-    vespalib::SimpleThreadBundle::Pool _threadBundlePool;
+    vespalib::NumaTopology             _numaTopology;
+    std::vector<std::unique_ptr<vespalib::SimpleThreadBundle::Pool>> _threadBundlePools; // one per numa node
     std::atomic<bool>                  _nodeUp;
     std::atomic<bool>                  _nodeMaintenance;
 
@@ -47,8 +49,17 @@ public:
      * @param threadsPerSearch number of threads used for each search
      * @param distributionKey distributionkey of this node.
      * @param async if query is dispatched to threadpool
+     * @param numaAware if the threads used for each search are bound to a single numa node
+     * @param numaTopology the numa topology of the host
      */
-    MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool async);
+    MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool async, bool numaAware,
+                vespalib::NumaTopology numaTopology);
+    MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool async, bool numaAware)
+        : MatchEngine(numThreads, threadsPerSearch, distributionKey, async, numaAware, vespalib::NumaTopology())
+    {}
+    MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool async)
+        : MatchEngine(numThreads, threadsPerSearch, distributionKey, async, false)
+    {}
     MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey)
         : MatchEngine(numThreads, threadsPerSearch, distributionKey, true)
     {}
@@ -71,6 +82,16 @@ public:
      */
     const vespalib::ThreadExecutor& get_executor() const { return _executor; }
 
+    /**
+     * Returns the number of thread bundle pools, one per numa node when numa aware.
+     */
+    size_t get_num_thread_bundle_pools() const { return _threadBundlePools.size(); }
+
+    /**
+     * Returns the thread bundle pool used for searches on the given numa node. Only used for testing.
+     */
+    vespalib::SimpleThreadBundle::Pool& get_thread_bundle_pool(size_t numaNode) { return *_threadBundlePools[numaNode]; }
+
     /**
      * Closes the request handler interface. This will prevent any more data
      * from entering this object, allowing you to flush all pending operations
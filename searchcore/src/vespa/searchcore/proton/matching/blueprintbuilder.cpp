@@ -10,6 +10,7 @@
 #include <vespa/searchlib/queryeval/intermediate_blueprints.h>
 #include <vespa/searchlib/queryeval/equiv_blueprint.h>
 #include <vespa/searchlib/queryeval/get_weight_from_node.h>
+#include <vespa/searchlib/queryeval/irequestcontext.h>
 
 using namespace search::queryeval;
 
@@ -74,13 +75,25 @@ private:
         _result.reset(blueprint.release());
     }
 
+    double getAverageFieldLength(search::query::Node &node) {
+        const auto *termData = dynamic_cast<const ProtonTermData *>(&node);
+        if (termData == nullptr || termData->numFields() != 1 || termData->field(0).attribute_field) {
+            return 0.0;
+        }
+        return _context.getIndexes().get_field_length_info(termData->field(0).field_name).get_average_field_length();
+    }
+
     void buildWeakAnd(ProtonWeakAnd &n) {
-        WeakAndBlueprint *wand = new WeakAndBlueprint(n.getMinHits());
+        const auto *bm25 = _requestContext.get_weak_and_bm25_params();
+        WeakAndBlueprint *wand = (bm25 != nullptr)
+                                 ? new WeakAndBlueprint(n.getMinHits(), *bm25)
+                                 : new WeakAndBlueprint(n.getMinHits());
         Blueprint::UP result(wand);
         for (size_t i = 0; i < n.getChildren().size(); ++i) {
             search::query::Node &node = *n.getChildren()[i];
             uint32_t weight = getWeightFromNode(node).percent();
-            wand->addTerm(BlueprintBuilder::build(_requestContext, node, _context), weight);
+            double avgFieldLength = (bm25 != nullptr) ? getAverageFieldLength(node) : 0.0;
+            wand->addTerm(BlueprintBuilder::build(_requestContext, node, _context), weight, avgFieldLength);
         }
         _result = std::move(result);
     }
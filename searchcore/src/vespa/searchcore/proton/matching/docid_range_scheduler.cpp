@@ -1,7 +1,9 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "docid_range_scheduler.h"
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 
 namespace proton::matching {
 
@@ -164,4 +166,141 @@ AdaptiveDocidRangeScheduler::share_range(size_t thread_id, DocidRange todo)
 
 //-----------------------------------------------------------------------------
 
+WorkStealingDocidRangeScheduler::Worker::Worker() noexcept
+    : todo(pack(DocidRange())),
+      ns_per_docid(0.0),
+      assigned(0),
+      chunk_start(),
+      chunk_size(0)
+{
+}
+
+WorkStealingDocidRangeScheduler::WorkStealingDocidRangeScheduler(size_t num_threads, uint32_t min_task,
+                                                                 uint32_t docid_limit, double hit_ratio)
+    : _min_task(std::max(1u, min_task)),
+      _chunk_size(_min_task),
+      _workers(num_threads)
+{
+    DocidRangeSplitter splitter(DocidRange(1, docid_limit), num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        _workers[i].todo.store(pack(splitter.get(i)), std::memory_order_relaxed);
+    }
+    // aim for a fixed number of hits per chunk, but leave enough chunks in each
+    // partition for the other threads to steal
+    double chunk = hits_per_chunk / std::clamp(hit_ratio, 1e-6, 1.0);
+    double max_chunk = std::max(_min_task, uint32_t(splitter.get(0).size() / 8));
+    _chunk_size = std::max(_min_task, uint32_t(std::min(chunk, max_chunk)));
+}
+
+WorkStealingDocidRangeScheduler::~WorkStealingDocidRangeScheduler() = default;
+
+DocidRange
+WorkStealingDocidRangeScheduler::take_chunk(size_t thread_id)
+{
+    Worker &worker = _workers[thread_id];
+    uint64_t old_todo = worker.todo.load(std::memory_order_acquire);
+    for (;;) {
+        DocidRange todo = unpack(old_todo);
+        if (todo.empty()) {
+            return DocidRange();
+        }
+        // avoid leaving a rest that is too small to be worth stealing
+        uint32_t size = (todo.size() < (_chunk_size + _min_task)) ? todo.size() : _chunk_size;
+        DocidRange chunk(todo.begin, todo.begin + size);
+        if (worker.todo.compare_exchange_weak(old_todo, pack(DocidRange(chunk.end, todo.end)),
+                                              std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            worker.assigned += chunk.size();
+            return chunk;
+        }
+    }
+}
+
+bool
+WorkStealingDocidRangeScheduler::steal(size_t thread_id)
+{
+    double my_cost = _workers[thread_id].ns_per_docid.load(std::memory_order_relaxed);
+    double fallback_cost = (my_cost > 0.0) ? my_cost : 1.0;
+    for (;;) {
+        size_t victim = thread_id;
+        uint64_t victim_todo = 0;
+        double max_cost = 0.0;
+        for (size_t i = 0; i < _workers.size(); ++i) {
+            if (i == thread_id) {
+                continue;
+            }
+            uint64_t todo = _workers[i].todo.load(std::memory_order_acquire);
+            size_t size = unpack(todo).size();
+            if (size == 0) {
+                continue;
+            }
+            double cost = _workers[i].ns_per_docid.load(std::memory_order_relaxed);
+            double remaining = size * ((cost > 0.0) ? cost : fallback_cost);
+            if (remaining > max_cost) {
+                victim = i;
+                victim_todo = todo;
+                max_cost = remaining;
+            }
+        }
+        if (victim == thread_id) {
+            return false;
+        }
+        DocidRange todo = unpack(victim_todo);
+        uint32_t mid = (todo.size() <= _min_task) ? todo.begin : (todo.begin + todo.size() / 2);
+        if (_workers[victim].todo.compare_exchange_strong(victim_todo, pack(DocidRange(todo.begin, mid)),
+                                                          std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            _workers[thread_id].todo.store(pack(DocidRange(mid, todo.end)), std::memory_order_release);
+            return true;
+        }
+    }
+}
+
+void
+WorkStealingDocidRangeScheduler::chunk_done(size_t thread_id)
+{
+    Worker &worker = _workers[thread_id];
+    if (worker.chunk_size == 0) {
+        return;
+    }
+    double ns = vespalib::count_ns(vespalib::steady_clock::now() - worker.chunk_start);
+    double ns_per_docid = ns / worker.chunk_size;
+    double prev = worker.ns_per_docid.load(std::memory_order_relaxed);
+    worker.ns_per_docid.store((prev > 0.0) ? (prev + ns_per_docid) / 2 : ns_per_docid, std::memory_order_relaxed);
+    worker.chunk_size = 0;
+}
+
+DocidRange
+WorkStealingDocidRangeScheduler::first_range(size_t thread_id)
+{
+    return next_range(thread_id);
+}
+
+DocidRange
+WorkStealingDocidRangeScheduler::next_range(size_t thread_id)
+{
+    chunk_done(thread_id);
+    DocidRange chunk = take_chunk(thread_id);
+    while (chunk.empty() && steal(thread_id)) {
+        chunk = take_chunk(thread_id);
+    }
+    if (!chunk.empty()) {
+        _workers[thread_id].chunk_start = vespalib::steady_clock::now();
+        _workers[thread_id].chunk_size = chunk.size();
+    }
+    return chunk;
+}
+
+size_t
+WorkStealingDocidRangeScheduler::unassigned_size() const
+{
+    size_t sum = 0;
+    for (const Worker &worker : _workers) {
+        sum += unpack(worker.todo.load(std::memory_order_relaxed)).size();
+    }
+    return sum;
+}
+
+//-----------------------------------------------------------------------------
+
 }
@@ -4,6 +4,7 @@
 
 #include <vespa/searchlib/queryeval/begin_and_end_id.h>
 #include <vespa/fastos/types.h>
+#include <vespa/vespalib/util/time.h>
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
@@ -200,4 +201,58 @@ public:
     DocidRange share_range(size_t, DocidRange todo) override;
 };
 
+/**
+ * A work-stealing scheduler that begins by giving each thread an
+ * equal part of the docid space. Each thread processes its own part
+ * in chunks taken from the front, while idle threads steal the second
+ * half of the remaining part of a busy thread. Both operations are a
+ * single compare-and-swap on the packed remaining range of the
+ * affected thread, so no thread ever blocks waiting for work, and
+ * busy threads are never interrupted to share their work.
+ *
+ * The chunk size is derived from the estimated hit ratio of the
+ * query, aiming at a fixed number of hits per chunk. Each thread
+ * tracks its observed cost per docid, and thieves pick the victim
+ * with the highest estimated remaining cost, not the one with the
+ * largest remaining range. This makes the scheduler handle corpora
+ * where the cost per document varies a lot across the docid space.
+ **/
+class WorkStealingDocidRangeScheduler : public DocidRangeScheduler
+{
+private:
+    struct alignas(64) Worker {
+        std::atomic<uint64_t> todo;
+        std::atomic<double>   ns_per_docid;
+        size_t                assigned;
+        vespalib::steady_time chunk_start;
+        uint32_t              chunk_size;
+        Worker() noexcept;
+    };
+    static constexpr uint32_t hits_per_chunk = 256;
+
+    uint32_t            _min_task;
+    uint32_t            _chunk_size;
+    std::vector<Worker> _workers;
+
+    static uint64_t pack(DocidRange range) noexcept {
+        return ((uint64_t(range.begin) << 32) | range.end);
+    }
+    static DocidRange unpack(uint64_t value) noexcept {
+        return DocidRange(uint32_t(value >> 32), uint32_t(value));
+    }
+    VESPA_DLL_LOCAL DocidRange take_chunk(size_t thread_id);
+    VESPA_DLL_LOCAL bool steal(size_t thread_id);
+    VESPA_DLL_LOCAL void chunk_done(size_t thread_id);
+public:
+    WorkStealingDocidRangeScheduler(size_t num_threads, uint32_t min_task, uint32_t docid_limit, double hit_ratio);
+    ~WorkStealingDocidRangeScheduler() override;
+    DocidRange first_range(size_t thread_id) override;
+    DocidRange next_range(size_t thread_id) override;
+    size_t total_size(size_t thread_id) const override { return _workers[thread_id].assigned; }
+    size_t unassigned_size() const override;
+    IdleObserver make_idle_observer() const override { return IdleObserver(); }
+    DocidRange share_range(size_t, DocidRange todo) override { return todo; }
+    uint32_t chunk_size() const noexcept { return _chunk_size; }
+};
+
 }
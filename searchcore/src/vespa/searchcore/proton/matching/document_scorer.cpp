@@ -26,8 +26,10 @@ extractScoreFeature(const RankProgram &rankProgram)
 
 DocumentScorer::DocumentScorer(RankProgram &rankProgram,
                                SearchIterator &searchItr)
-    : _searchItr(searchItr),
-      _scoreFeature(extractScoreFeature(rankProgram))
+    : _rankProgram(rankProgram),
+      _searchItr(searchItr),
+      _scoreFeature(extractScoreFeature(rankProgram)),
+      _use_batch(rankProgram.setup_batch())
 {
 }
 
@@ -36,6 +38,23 @@ DocumentScorer::score(TaggedHits &hits)
 {
     auto sort_on_docid = [](const TaggedHit &a, const TaggedHit &b){ return (a.first.first < b.first.first); };
     std::sort(hits.begin(), hits.end(), sort_on_docid);
+    if (_use_batch) {
+        std::vector<uint32_t> docids;
+        docids.reserve(RankProgram::default_batch_size);
+        for (size_t offset = 0; offset < hits.size(); offset += RankProgram::default_batch_size) {
+            size_t end = std::min(hits.size(), offset + RankProgram::default_batch_size);
+            docids.clear();
+            for (size_t i = offset; i < end; ++i) {
+                docids.push_back(hits[i].first.first);
+            }
+            _rankProgram.execute_batch(docids);
+            const feature_t *scores = _rankProgram.get_batch_seed(0);
+            for (size_t i = offset; i < end; ++i) {
+                hits[i].first.second = scores[i - offset];
+            }
+        }
+        return;
+    }
     for (auto &hit: hits) {
         hit.first.second = doScore(hit.first.first);
     }
@@ -12,13 +12,17 @@ namespace proton::matching {
  * Class used to calculate the rank score for a set of documents using
  * a rank program for calculation and a search iterator for unpacking
  * match data. The doScore function must be called with increasing
- * docid.
+ * docid. If the rank program supports batch execution, score will
+ * calculate the rank score for batches of documents without
+ * unpacking match data.
  */
 class DocumentScorer
 {
 private:
+    search::fef::RankProgram &_rankProgram;
     search::queryeval::SearchIterator &_searchItr;
     search::fef::LazyValue _scoreFeature;
+    bool _use_batch;
 
 public:
     using TaggedHit = IMatchLoopCommunicator::TaggedHit;
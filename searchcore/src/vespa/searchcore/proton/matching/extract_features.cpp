@@ -10,6 +10,7 @@
 #include <vespa/searchlib/fef/feature_resolver.h>
 #include <vespa/searchlib/fef/rank_program.h>
 #include <vespa/searchlib/queryeval/searchiterator.h>
+#include <algorithm>
 
 using vespalib::Doom;
 using vespalib::Runnable;
@@ -57,6 +58,18 @@ void extract_values(const FeatureResolver &resolver, uint32_t docid, FeatureSet:
     }
 }
 
+// Calculate features for a batch of documents, rank_program must be set up for batch execution
+template <typename DstFn>
+void extract_batch_values(RankProgram &rank_program, size_t num_features, vespalib::ConstArrayRef<uint32_t> docids, DstFn &&get_dst) {
+    rank_program.execute_batch(docids);
+    for (size_t doc = 0; doc < docids.size(); ++doc) {
+        FeatureSet::Value *dst = get_dst(doc);
+        for (uint32_t i = 0; i < num_features; ++i) {
+            dst[i].set_double(rank_program.get_batch_seed(i)[doc]);
+        }
+    }
+}
+
 struct MyChunk : Runnable {
     const std::pair<uint32_t,uint32_t> *begin;
     const std::pair<uint32_t,uint32_t> *end;
@@ -66,9 +79,26 @@ struct MyChunk : Runnable {
             const std::pair<uint32_t,uint32_t> *end_in,
             FeatureValues &result_in, const Doom &doom_in)
       : begin(begin_in), end(end_in), result(result_in), doom(doom_in) {}
-    void calculate_features(SearchIterator &search, const FeatureResolver &resolver) {
+    void calculate_features(SearchIterator &search, RankProgram &rank_program, const FeatureResolver &resolver) {
         assert(end > begin);
         assert(resolver.num_features() == result.names.size());
+        if (rank_program.setup_batch()) {
+            std::vector<uint32_t> docids;
+            docids.reserve(RankProgram::default_batch_size);
+            for (auto pos = begin; pos < end; pos += docids.size()) {
+                if (doom.hard_doom()) {
+                    return;
+                }
+                docids.clear();
+                for (auto doc = pos; doc < end && docids.size() < RankProgram::default_batch_size; ++doc) {
+                    docids.push_back(doc->first);
+                }
+                extract_batch_values(rank_program, resolver.num_features(), docids, [&](size_t doc) {
+                    return &result.values[pos[doc].second * resolver.num_features()];
+                });
+            }
+            return;
+        }
         search.initRange(begin[0].first, end[-1].first + 1);
         for (auto pos = begin; pos != end; ++pos) {
             if (doom.hard_doom()) {
@@ -83,17 +113,20 @@ struct MyChunk : Runnable {
 
 struct FirstChunk : MyChunk {
     SearchIterator &search;
+    RankProgram &rank_program;
     const FeatureResolver &resolver;
     FirstChunk(const std::pair<uint32_t,uint32_t> *begin_in,
                const std::pair<uint32_t,uint32_t> *end_in,
                FeatureValues &result_in,
                const Doom &doom_in,
                SearchIterator &search_in,
+               RankProgram &rank_program_in,
                const FeatureResolver &resolver_in)
       : MyChunk(begin_in, end_in, result_in, doom_in),
         search(search_in),
+        rank_program(rank_program_in),
         resolver(resolver_in) {}
-    void run() override { calculate_features(search, resolver); }
+    void run() override { calculate_features(search, rank_program, resolver); }
 };
 
 struct LaterChunk : MyChunk {
@@ -109,7 +142,7 @@ struct LaterChunk : MyChunk {
         auto tools = mtf.createMatchTools();
         tools->setup_match_features();
         FeatureResolver resolver(tools->rank_program().get_seeds(false));
-        calculate_features(tools->search(), resolver);
+        calculate_features(tools->search(), tools->rank_program(), resolver);
     }
 };
 
@@ -137,7 +170,18 @@ ExtractFeatures::get_feature_set(SearchIterator &search, RankProgram &rank_progr
 {
     FeatureResolver resolver(rank_program.get_seeds(false));
     auto result = std::make_unique<FeatureSet>(extract_names(resolver, renames), docs.size());
-    if (!docs.empty()) {
+    if (!docs.empty() && rank_program.setup_batch()) {
+        for (size_t offset = 0; offset < docs.size(); offset += RankProgram::default_batch_size) {
+            if (doom.hard_doom()) {
+                return result;
+            }
+            size_t batch_size = std::min(RankProgram::default_batch_size, docs.size() - offset);
+            vespalib::ConstArrayRef<uint32_t> docids(&docs[offset], batch_size);
+            extract_batch_values(rank_program, resolver.num_features(), docids, [&](size_t doc) {
+                return result->getFeaturesByIndex(result->addDocId(docids[doc]));
+            });
+        }
+    } else if (!docs.empty()) {
         search.initRange(docs.front(), docs.back()+1);
         for (uint32_t docid: docs) {
             if (doom.hard_doom()) {
@@ -170,7 +214,7 @@ ExtractFeatures::get_match_features(const MatchToolsFactory &mtf, const OrderedD
             break;
         }
         if (i == 0) {
-            work.chunks.push_back(std::make_unique<FirstChunk>(&docs[idx], &docs[idx + chunk_size], result, tools->getDoom(), tools->search(), resolver));
+            work.chunks.push_back(std::make_unique<FirstChunk>(&docs[idx], &docs[idx + chunk_size], result, tools->getDoom(), tools->search(), tools->rank_program(), resolver));
         } else {
             work.chunks.push_back(std::make_unique<LaterChunk>(&docs[idx], &docs[idx + chunk_size], result, tools->getDoom(), mtf));
         }
@@ -48,9 +48,12 @@ struct TimedMatchLoopCommunicator : IMatchLoopCommunicator {
 };
 
 DocidRangeScheduler::UP
-createScheduler(uint32_t numThreads, uint32_t numSearchPartitions, uint32_t numDocs)
+createScheduler(uint32_t numThreads, uint32_t numSearchPartitions, uint32_t numDocs, bool workStealing, double hitRatio)
 {
     if (numSearchPartitions == 0) {
+        if (workStealing) {
+            return std::make_unique<WorkStealingDocidRangeScheduler>(numThreads, 1, numDocs, hitRatio);
+        }
         return std::make_unique<AdaptiveDocidRangeScheduler>(numThreads, 1, numDocs);
     }
     if (numSearchPartitions <= numThreads) {
@@ -82,13 +85,16 @@ MatchMaster::match(search::engine::Trace & trace,
                    const MatchToolsFactory &mtf,
                    ResultProcessor &resultProcessor,
                    uint32_t distributionKey,
-                   uint32_t numSearchPartitions)
+                   uint32_t numSearchPartitions,
+                   bool workStealing)
 {
     vespalib::Timer query_latency_time;
     vespalib::DualMergeDirector mergeDirector(threadBundle.size());
     MatchLoopCommunicator communicator(threadBundle.size(), params.heapSize, mtf.createDiversifier(params.heapSize));
     TimedMatchLoopCommunicator timedCommunicator(communicator);
-    DocidRangeScheduler::UP scheduler = createScheduler(threadBundle.size(), numSearchPartitions, params.numDocs);
+    double hitRatio = (params.numDocs > 0) ? std::min(1.0, double(mtf.estimate().estHits) / params.numDocs) : 1.0;
+    DocidRangeScheduler::UP scheduler = createScheduler(threadBundle.size(), numSearchPartitions, params.numDocs,
+                                                        workStealing, hitRatio);
 
     std::vector<MatchThread::UP> threadState;
     std::vector<vespalib::Runnable*> targets;
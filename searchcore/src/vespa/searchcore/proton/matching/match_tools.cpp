@@ -20,6 +20,7 @@ LOG_SETUP(".proton.matching.match_tools");
 using search::attribute::IAttributeContext;
 using search::queryeval::IRequestContext;
 using search::queryeval::IDiversifier;
+using search::queryeval::wand::Bm25Params;
 using search::attribute::diversity::DiversityFilter;
 using search::attribute::BasicType;
 using search::attribute::AttributeBlueprintParams;
@@ -175,7 +176,8 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
                   bool                         is_search)
     : _queryLimiter(queryLimiter),
       _global_filter_params(extract_global_filter_params(rankSetup, rankProperties, metaStore.getNumActiveLids(), searchContext.getDocIdLimit())),
-      _requestContext(doom, attributeContext, rankProperties, _global_filter_params),
+      _requestContext(doom, attributeContext, rankProperties, _global_filter_params,
+                      extract_weak_and_bm25_params(rankSetup, rankProperties, searchContext.getDocIdLimit())),
       _query(),
       _match_limiter(),
       _queryEnv(indexEnv, attributeContext, rankProperties, searchContext.getIndexes()),
@@ -321,6 +323,19 @@ MatchToolsFactory::extract_global_filter_params(const search::fef::RankSetup& ra
             upper_limit * active_hit_ratio};
 }
 
+std::optional<Bm25Params>
+MatchToolsFactory::extract_weak_and_bm25_params(const search::fef::RankSetup& rank_setup,
+                                                const search::fef::Properties& rank_properties,
+                                                uint32_t docid_limit)
+{
+    if (!WeakAndBm25::check(rank_properties, rank_setup.get_weak_and_bm25())) {
+        return std::nullopt;
+    }
+    return Bm25Params(WeakAndBm25K1::lookup(rank_properties, rank_setup.get_weak_and_bm25_k1()),
+                      WeakAndBm25B::lookup(rank_properties, rank_setup.get_weak_and_bm25_b()),
+                      docid_limit);
+}
+
 AttributeOperationTask::AttributeOperationTask(const RequestContext & requestContext,
                                                vespalib::stringref attribute, vespalib::stringref operation)
     : _requestContext(requestContext),
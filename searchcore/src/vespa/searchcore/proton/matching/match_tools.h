@@ -156,6 +156,15 @@ public:
                                        const search::fef::Properties& rank_properties,
                                        uint32_t active_docids,
                                        uint32_t docid_limit);
+
+    /**
+     * Extracts the parameters used when WeakAnd scores with BM25 from the
+     * rank-profile and query. Returns an empty optional when not enabled.
+     */
+    static std::optional<search::queryeval::wand::Bm25Params>
+    extract_weak_and_bm25_params(const search::fef::RankSetup& rank_setup,
+                                 const search::fef::Properties& rank_properties,
+                                 uint32_t docid_limit);
 };
 
 }
@@ -8,6 +8,7 @@
 #include "termdataextractor.h"
 #include "unpacking_iterators_optimizer.h"
 #include <vespa/document/datatype/positiondatatype.h>
+#include <vespa/searchlib/common/compressedbitvector.h>
 #include <vespa/searchlib/common/geo_location_parser.h>
 #include <vespa/searchlib/common/geo_location_spec.h>
 #include <vespa/searchlib/engine/trace.h>
@@ -289,7 +290,17 @@ Query::handle_global_filter(Blueprint& blueprint, uint32_t docid_limit,
         auto filter_iterator = blueprint.createFilterSearch(strict, constraint);
         filter_iterator->initRange(1, docid_limit);
         auto white_list = filter_iterator->get_hits(1);
-        global_filter = GlobalFilter::create(std::move(white_list));
+        // Sparse filters use a compressed representation to reduce memory usage
+        auto compressed = search::CompressedBitVector::createIfCompact(*white_list);
+        if (compressed) {
+            if (trace && trace->shouldTrace(5)) {
+                trace->addEvent(5, vespalib::make_string("Use compressed global filter (%zu bytes instead of %zu)",
+                                                         compressed->sizeBytes(), white_list->getFileBytes()));
+            }
+            global_filter = GlobalFilter::create(std::move(compressed));
+        } else {
+            global_filter = GlobalFilter::create(std::move(white_list));
+        }
     } else {
         if (trace && trace->shouldTrace(5)) {
             trace->addEvent(5, vespalib::make_string("Create match all global filter (estimated_hit_ratio (%f) > upper_limit (%f))",
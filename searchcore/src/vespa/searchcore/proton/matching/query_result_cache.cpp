@@ -0,0 +1,196 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "query_result_cache.h"
+#include <vespa/searchlib/common/unique_issues.h>
+#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/searchlib/fef/properties.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/stllike/lrucache_map.hpp>
+
+using search::engine::SearchReply;
+using search::engine::SearchRequest;
+using search::fef::Properties;
+using search::fef::Property;
+
+namespace proton::matching {
+
+namespace {
+
+class PropertiesSerializer : public search::fef::IPropertiesVisitor {
+    vespalib::nbostream &_os;
+public:
+    PropertiesSerializer(vespalib::nbostream &os) : _os(os) {}
+    void visitProperty(const Property::Value &key, const Property &values) override {
+        _os << key << uint32_t(values.size());
+        for (uint32_t i = 0; i < values.size(); ++i) {
+            _os << values.getAt(i);
+        }
+    }
+};
+
+void
+serialize(vespalib::nbostream &os, const Properties &props)
+{
+    // keys are visited in sorted order, making the serialized form independent of insert order
+    os << props.numKeys();
+    PropertiesSerializer serializer(os);
+    props.visitProperties(serializer);
+}
+
+size_t
+estimate_memory_usage(const QueryResultCache::Key &key, const SearchReply &reply)
+{
+    size_t result = key.size() + sizeof(SearchReply);
+    result += reply.hits.size() * sizeof(SearchReply::Hit);
+    result += reply.sortIndex.size() * sizeof(uint32_t) + reply.sortData.size();
+    result += reply.match_features.values.size() * sizeof(search::FeatureValues::Value);
+    for (const auto &value : reply.match_features.values) {
+        if (value.is_data()) {
+            result += value.as_data().size;
+        }
+    }
+    for (const auto &name : reply.match_features.names) {
+        result += sizeof(vespalib::string) + name.size();
+    }
+    return result;
+}
+
+}
+
+struct QueryResultCache::Entry {
+    SearchReply reply;
+    size_t      memory_usage;
+    Entry(const Key &key, const SearchReply &reply_in)
+        : reply(reply_in),
+          memory_usage(estimate_memory_usage(key, reply_in))
+    {}
+};
+
+class QueryResultCache::Lru : public vespalib::lrucache_map<vespalib::LruParam<Key, std::shared_ptr<const Entry>>> {
+    using Param = vespalib::LruParam<Key, std::shared_ptr<const Entry>>;
+    using Parent = vespalib::lrucache_map<Param>;
+    using value_type = Param::value_type;
+    size_t _max_bytes;
+    size_t _bytes;
+public:
+    Lru(size_t max_bytes) : Parent(UNLIMITED), _max_bytes(max_bytes), _bytes(0) {}
+    size_t bytes() const noexcept { return _bytes; }
+    bool fits(const Entry &entry) const noexcept { return entry.memory_usage <= _max_bytes; }
+    void add(const Key &key, std::shared_ptr<const Entry> entry) {
+        _bytes += entry->memory_usage;
+        insert(key, std::move(entry));
+    }
+    bool removeOldest(const value_type &v) override {
+        if (_bytes > _max_bytes) {
+            _bytes -= v.second._value->memory_usage;
+            return true;
+        }
+        return false;
+    }
+};
+
+QueryResultCache::QueryResultCache(size_t max_bytes)
+    : _max_bytes(max_bytes),
+      _lock(),
+      _lru(std::make_unique<Lru>(max_bytes)),
+      _generation(0),
+      _hits(0),
+      _misses(0),
+      _invalidations(0)
+{
+}
+
+QueryResultCache::~QueryResultCache() = default;
+
+bool
+QueryResultCache::is_cacheable(const SearchRequest &request)
+{
+    return request.groupSpec.empty() && request.sessionId.empty() &&
+           (request.getTraceLevel() == 0) && !request.dumpFeatures;
+}
+
+QueryResultCache::Key
+QueryResultCache::make_key(const SearchRequest &request, const Visibility &visibility)
+{
+    vespalib::nbostream os;
+    os << visibility.serial_num << visibility.active_lids_generation;
+    os << uint32_t(visibility.parent_generations.size());
+    for (uint64_t generation : visibility.parent_generations) {
+        os << generation;
+    }
+    os << request.ranking << request.location << request.sortSpec;
+    os << request.offset << request.maxhits;
+    vespalib::stringref stack = request.getStackRef();
+    os << uint32_t(stack.size());
+    os.write(stack.data(), stack.size());
+    serialize(os, request.propertiesMap.rankProperties());
+    serialize(os, request.propertiesMap.featureOverrides());
+    serialize(os, request.propertiesMap.matchProperties());
+    return Key(os.data(), os.size());
+}
+
+uint64_t
+QueryResultCache::generation() const
+{
+    std::lock_guard guard(_lock);
+    return _generation;
+}
+
+std::unique_ptr<SearchReply>
+QueryResultCache::lookup(const Key &key)
+{
+    std::shared_ptr<const Entry> entry;
+    {
+        std::lock_guard guard(_lock);
+        auto *found = _lru->findAndRef(key);
+        if (found == nullptr) {
+            ++_misses;
+            return {};
+        }
+        ++_hits;
+        entry = *found;
+    }
+    return std::make_unique<SearchReply>(entry->reply);
+}
+
+void
+QueryResultCache::insert(const Key &key, uint64_t generation, const SearchReply &reply, const search::UniqueIssues &issues)
+{
+    if ((issues.size() > 0) || reply.coverage.wasDegradedByTimeout() ||
+        ((reply.coverage.getDegradeReason() & SearchReply::Coverage::ADAPTIVE_TIMEOUT) != 0))
+    {
+        return;
+    }
+    auto entry = std::make_shared<const Entry>(key, reply);
+    std::lock_guard guard(_lock);
+    if ((generation != _generation) || !_lru->fits(*entry) || _lru->hasKey(key)) {
+        return;
+    }
+    _lru->add(key, std::move(entry));
+}
+
+void
+QueryResultCache::invalidate()
+{
+    std::unique_ptr<Lru> old_lru;
+    {
+        std::lock_guard guard(_lock);
+        ++_generation;
+        if (_lru->empty()) {
+            return;
+        }
+        _invalidations += _lru->size();
+        old_lru = std::make_unique<Lru>(_max_bytes);
+        old_lru.swap(_lru);
+    }
+}
+
+vespalib::CacheStats
+QueryResultCache::get_stats() const
+{
+    std::lock_guard guard(_lock);
+    return vespalib::CacheStats(_hits, _misses, _lru->size(), _lru->bytes(), _invalidations);
+}
+
+}
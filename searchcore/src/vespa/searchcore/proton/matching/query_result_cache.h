@@ -0,0 +1,101 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/cache_stats.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace search { class UniqueIssues; }
+namespace search::engine {
+    class SearchRequest;
+    class SearchReply;
+}
+
+namespace proton::matching {
+
+/**
+ * Cache of search replies for identical queries against a document db.
+ *
+ * The cache key is made from the serialized query stack dump, the rank
+ * profile, rank properties, feature overrides, match properties, sorting,
+ * location and the requested hit window, together with the visibility of
+ * the document db (see Visibility). The cache is invalidated when fed
+ * changes become visible for search. Replies for queries started before an
+ * invalidation are never inserted. Changes visible for search without a
+ * commit in this document db, i.e. bucket activation and changes in parent
+ * document dbs of imported attributes, are covered by the key instead,
+ * leaving replies for the old state to be evicted.
+ *
+ * Requests using grouping, search sessions or tracing are not cached, and
+ * neither are replies with coverage degraded by timeout. Issues are not
+ * part of the reply, thus replies for queries reporting issues are not
+ * cached either, as they would be lost on a cache hit.
+ *
+ * The cache is bounded by the estimated memory used by keys and replies,
+ * and a max size of 0 disables it.
+ */
+class QueryResultCache {
+public:
+    using Key = vespalib::string;
+    using SearchRequest = search::engine::SearchRequest;
+    using SearchReply = search::engine::SearchReply;
+
+    /**
+     * What is visible for search in a document db: the last serial number
+     * committed, the active lids generation of the document meta store and
+     * the generations of the parent document meta stores and target
+     * attributes of imported attributes.
+     **/
+    struct Visibility {
+        uint64_t              serial_num;
+        uint64_t              active_lids_generation;
+        std::vector<uint64_t> parent_generations;
+        explicit Visibility(uint64_t serial_num_in) noexcept
+            : serial_num(serial_num_in),
+              active_lids_generation(0),
+              parent_generations()
+        {}
+    };
+
+private:
+    struct Entry;
+    class Lru;
+
+    const size_t         _max_bytes;
+    mutable std::mutex   _lock;
+    std::unique_ptr<Lru> _lru;
+    uint64_t             _generation;
+    size_t               _hits;
+    size_t               _misses;
+    size_t               _invalidations;
+
+public:
+    QueryResultCache(size_t max_bytes);
+    ~QueryResultCache();
+
+    bool enabled() const noexcept { return _max_bytes > 0; }
+    size_t max_bytes() const noexcept { return _max_bytes; }
+
+    static bool is_cacheable(const SearchRequest &request);
+    static Key make_key(const SearchRequest &request, const Visibility &visibility);
+
+    /**
+     * Returns the current generation of the cache. It must be sampled
+     * before the query is executed, and passed back when inserting the
+     * reply.
+     **/
+    uint64_t generation() const;
+    std::unique_ptr<SearchReply> lookup(const Key &key);
+    /**
+     * Inserts the reply unless the query reported any of the given
+     * issues while producing it.
+     **/
+    void insert(const Key &key, uint64_t generation, const SearchReply &reply, const search::UniqueIssues &issues);
+    void invalidate();
+    vespalib::CacheStats get_stats() const;
+};
+
+}
@@ -21,11 +21,13 @@ using search::attribute::IAttributeVector;
 
 RequestContext::RequestContext(const Doom & doom, IAttributeContext & attributeContext,
                                const search::fef::Properties& rank_properties,
-                               const search::attribute::AttributeBlueprintParams& attribute_blueprint_params)
+                               const search::attribute::AttributeBlueprintParams& attribute_blueprint_params,
+                               const std::optional<search::queryeval::wand::Bm25Params>& weak_and_bm25_params)
     : _doom(doom),
       _attributeContext(attributeContext),
       _rank_properties(rank_properties),
-      _attribute_blueprint_params(attribute_blueprint_params)
+      _attribute_blueprint_params(attribute_blueprint_params),
+      _weak_and_bm25_params(weak_and_bm25_params)
 {
 }
 
@@ -71,4 +73,10 @@ RequestContext::get_attribute_blueprint_params() const
     return _attribute_blueprint_params;
 }
 
+const search::queryeval::wand::Bm25Params *
+RequestContext::get_weak_and_bm25_params() const
+{
+    return _weak_and_bm25_params ? &_weak_and_bm25_params.value() : nullptr;
+}
+
 }
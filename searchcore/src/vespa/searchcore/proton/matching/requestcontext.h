@@ -6,7 +6,9 @@
 #include <vespa/searchlib/queryeval/irequestcontext.h>
 #include <vespa/searchcommon/attribute/iattributecontext.h>
 #include <vespa/searchlib/attribute/attribute_blueprint_params.h>
+#include <vespa/searchlib/queryeval/wand/bm25_params.h>
 #include <vespa/vespalib/util/doom.h>
+#include <optional>
 
 namespace search::fef { class Properties; }
 
@@ -21,7 +23,8 @@ public:
     using Doom = vespalib::Doom;
     RequestContext(const Doom & softDoom, IAttributeContext & attributeContext,
                    const search::fef::Properties& rank_properties,
-                   const search::attribute::AttributeBlueprintParams& attribute_blueprint_params);
+                   const search::attribute::AttributeBlueprintParams& attribute_blueprint_params,
+                   const std::optional<search::queryeval::wand::Bm25Params>& weak_and_bm25_params);
 
     const Doom & getDoom() const override { return _doom; }
     const search::attribute::IAttributeVector *getAttribute(const vespalib::string &name) const override;
@@ -34,11 +37,14 @@ public:
 
     const search::attribute::AttributeBlueprintParams& get_attribute_blueprint_params() const override;
 
+    const search::queryeval::wand::Bm25Params *get_weak_and_bm25_params() const override;
+
 private:
     const Doom                      _doom;
     IAttributeContext             & _attributeContext;
     const search::fef::Properties & _rank_properties;
     search::attribute::AttributeBlueprintParams _attribute_blueprint_params;
+    std::optional<search::queryeval::wand::Bm25Params> _weak_and_bm25_params;
 };
 
 }
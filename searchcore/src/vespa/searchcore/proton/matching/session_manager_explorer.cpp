@@ -13,6 +13,7 @@ namespace proton::matching {
 namespace {
 
 const vespalib::string SEARCH = "search";
+const vespalib::string QUERY_RESULT_CACHE = "query_result_cache";
 
 class SearchSessionExplorer : public vespalib::StateExplorer
 {
@@ -37,6 +38,27 @@ public:
     }
 };
 
+class QueryResultCacheExplorer : public vespalib::StateExplorer
+{
+private:
+    const QueryResultCache &_cache;
+
+public:
+    QueryResultCacheExplorer(const QueryResultCache &cache) : _cache(cache) {}
+    void get_state(const vespalib::slime::Inserter &inserter, bool) const override {
+        Cursor &state = inserter.insertObject();
+        vespalib::CacheStats stats = _cache.get_stats();
+        state.setBool("enabled", _cache.enabled());
+        state.setLong("maxBytes", _cache.max_bytes());
+        state.setLong("memoryUsed", stats.memory_used);
+        state.setLong("elements", stats.elements);
+        state.setLong("hits", stats.hits);
+        state.setLong("misses", stats.misses);
+        state.setLong("invalidations", stats.invalidations);
+        state.setDouble("hitRatio", (stats.lookups() > 0) ? (double(stats.hits) / stats.lookups()) : 0.0);
+    }
+};
+
 } // namespace proton::matching::<unnamed>
 
 void
@@ -47,7 +69,7 @@ SessionManagerExplorer::get_state(const Inserter &, bool) const
 std::vector<vespalib::string>
 SessionManagerExplorer::get_children_names() const
 {
-    return std::vector<vespalib::string>({SEARCH});
+    return std::vector<vespalib::string>({SEARCH, QUERY_RESULT_CACHE});
 }
 
 std::unique_ptr<StateExplorer>
@@ -55,6 +77,8 @@ SessionManagerExplorer::get_child(vespalib::stringref name) const
 {
     if (name == SEARCH) {
         return std::make_unique<SearchSessionExplorer>(_manager);
+    } else if (name == QUERY_RESULT_CACHE) {
+        return std::make_unique<QueryResultCacheExplorer>(_manager.getQueryResultCache());
     }
     return std::unique_ptr<StateExplorer>();
 }
@@ -168,9 +168,10 @@ struct SearchSessionCache : public SessionMap<SearchSession> {
 };
 
 
-SessionManager::SessionManager(uint32_t maxSize)
+SessionManager::SessionManager(uint32_t maxSize, size_t queryResultCacheMaxBytes)
     : _grouping_cache(std::make_unique<GroupingSessionCache>(maxSize)),
-      _search_map(std::make_unique<SearchSessionCache>()) {
+      _search_map(std::make_unique<SearchSessionCache>()),
+      _query_result_cache(queryResultCacheMaxBytes) {
 }
 
 SessionManager::~SessionManager() = default;
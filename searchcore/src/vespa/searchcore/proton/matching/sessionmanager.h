@@ -3,6 +3,7 @@
 
 #include "search_session.h"
 #include "isessioncachepruner.h"
+#include "query_result_cache.h"
 #include <vespa/searchcore/grouping/groupingsession.h>
 #include <vespa/searchcore/grouping/sessionid.h>
 #include <vespa/vespalib/stllike/lrucache_map.h>
@@ -44,12 +45,13 @@ public:
 private:
     std::unique_ptr<GroupingSessionCache> _grouping_cache;
     std::unique_ptr<SearchSessionCache> _search_map;
+    QueryResultCache _query_result_cache;
 
 public:
     typedef std::unique_ptr<SessionManager> UP;
     typedef std::shared_ptr<SessionManager> SP;
 
-    SessionManager(uint32_t maxSizeGrouping);
+    SessionManager(uint32_t maxSizeGrouping, size_t queryResultCacheMaxBytes = 0);
     ~SessionManager() override;
 
     void insert(search::grouping::GroupingSession::UP session);
@@ -62,6 +64,9 @@ public:
     size_t getNumSearchSessions() const;
     std::vector<SearchSessionInfo> getSortedSearchSessionInfo() const;
 
+    QueryResultCache &getQueryResultCache() { return _query_result_cache; }
+    const QueryResultCache &getQueryResultCache() const { return _query_result_cache; }
+
     void pruneTimedOutSessions(vespalib::steady_time currentTime) override;
     void close();
 };
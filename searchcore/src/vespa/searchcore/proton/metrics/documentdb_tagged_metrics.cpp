@@ -135,12 +135,25 @@ DocumentDBTaggedMetrics::MatchingMetrics::MatchingMetrics(MetricSet *parent)
       softDoomedQueries("soft_doomed_queries", {}, "Number of queries hitting the soft timeout", this),
       queryCollateralTime("query_collateral_time", {}, "Average time (sec) spent setting up and tearing down queries", this),
       querySetupTime("query_setup_time", {}, "Average time (sec) spent setting up and tearing down queries", this),
-      queryLatency("query_latency", {}, "Total average latency (sec) when matching and ranking a query", this)
+      queryLatency("query_latency", {}, "Total average latency (sec) when matching and ranking a query", this),
+      resultCache(this)
 {
 }
 
 DocumentDBTaggedMetrics::MatchingMetrics::~MatchingMetrics() = default;
 
+DocumentDBTaggedMetrics::MatchingMetrics::ResultCacheMetrics::ResultCacheMetrics(MetricSet *parent)
+    : MetricSet("result_cache", {}, "Metrics for the cache of replies for identical queries", parent),
+      memoryUsage("memory_usage", {}, "Memory usage of the cache (in bytes)", this),
+      elements("elements", {}, "Number of elements in the cache", this),
+      hitRate("hit_rate", {}, "Rate of hits in the cache compared to number of lookups", this),
+      lookups("lookups", {}, "Number of lookups in the cache (hits + misses)", this),
+      invalidations("invalidations", {}, "Number of invalidations (erased elements) in the cache", this)
+{
+}
+
+DocumentDBTaggedMetrics::MatchingMetrics::ResultCacheMetrics::~ResultCacheMetrics() = default;
+
 DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::RankProfileMetrics(const vespalib::string &name,
                                                                                  size_t numDocIdPartitions,
                                                                                  MetricSet *parent)
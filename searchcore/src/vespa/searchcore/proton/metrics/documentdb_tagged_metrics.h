@@ -162,6 +162,18 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
         using  RankProfileMap = std::map<vespalib::string, RankProfileMetrics::UP>;
         RankProfileMap rank_profiles;
 
+        struct ResultCacheMetrics : metrics::MetricSet {
+            metrics::LongValueMetric memoryUsage;
+            metrics::LongValueMetric elements;
+            metrics::LongAverageMetric hitRate;
+            metrics::LongCountMetric lookups;
+            metrics::LongCountMetric invalidations;
+
+            ResultCacheMetrics(metrics::MetricSet *parent);
+            ~ResultCacheMetrics() override;
+        };
+        ResultCacheMetrics resultCache;
+
         void update(const matching::MatchingStats &stats);
         MatchingMetrics(metrics::MetricSet *parent);
         ~MatchingMetrics() override;
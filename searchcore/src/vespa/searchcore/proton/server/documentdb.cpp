@@ -89,6 +89,16 @@ make_replay_throttling_policy(const ProtonConfig::ReplayThrottlingPolicy& cfg) {
     return ReplayThrottlingPolicy(params);
 }
 
+size_t
+query_result_cache_max_bytes(const ProtonConfig & protonCfg, const DocTypeName & docTypeName) {
+    for (const auto & ddbConfig : protonCfg.documentdb) {
+        if (ddbConfig.inputdoctypename == docTypeName.getName()) {
+            return ddbConfig.search.querycache.maxbytes;
+        }
+    }
+    return 0;
+}
+
 class MetricsUpdateHook : public metrics::UpdateHook {
     DocumentDB &_db;
 public:
@@ -204,7 +214,8 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
       _indexCfg(makeIndexConfig(protonCfg.index)),
       _replay_throttling_policy(std::make_unique<ReplayThrottlingPolicy>(make_replay_throttling_policy(protonCfg.replayThrottlingPolicy))),
       _config_store(std::move(config_store)),
-      _sessionManager(std::make_shared<matching::SessionManager>(protonCfg.grouping.sessionmanager.maxentries)),
+      _sessionManager(std::make_shared<matching::SessionManager>(protonCfg.grouping.sessionmanager.maxentries,
+                                                                  query_result_cache_max_bytes(protonCfg, docTypeName))),
       _metricsWireService(metricsWireService),
       _metrics(_docTypeName.getName(), protonCfg.numthreadspersearch),
       _metricsHook(std::make_unique<MetricsUpdateHook>(*this)),
@@ -522,6 +533,8 @@ DocumentDB::applyConfig(DocumentDBConfig::SP configSnapshot, SerialNum serialNum
         _state.clearDelayedConfig();
     }
     setActiveConfig(configSnapshot, generation);
+    // Cached query results might depend on the old rank profiles
+    _sessionManager->getQueryResultCache().invalidate();
     if (params.shouldMaintenanceControllerChange() || _maintenanceController.getPaused()) {
         forwardMaintenanceConfig();
     }
@@ -713,6 +726,12 @@ DocumentDB::getAllowPrune() const
     return _state.getAllowPrune();
 }
 
+void
+DocumentDB::onCommitDone()
+{
+    _sessionManager->getQueryResultCache().invalidate();
+}
+
 void
 DocumentDB::start()
 {
@@ -864,8 +883,8 @@ DocumentDB::reportStatus() const
                 message("DocumentDB initializing components"));
     } else if (_feedHandler->isDoingReplay()) {
         float progress = _feedHandler->getReplayProgress() * 100.0f;
-        vespalib::string msg = vespalib::make_string("DocumentDB replay transaction log on startup (%u%% done)",
-                static_cast<uint32_t>(progress));
+        vespalib::string msg = vespalib::make_string("DocumentDB replay transaction log on startup (%u%% done, %.0f ops/s)",
+                static_cast<uint32_t>(progress), _feedHandler->getReplayThroughput());
         return StatusReport::create(params.state(StatusReport::PARTIAL).progress(progress).message(msg));
     } else if (rawState == DDBState::State::APPLY_LIVE_CONFIG) {
         return StatusReport::create(params.state(StatusReport::PARTIAL)
@@ -169,6 +169,7 @@ private:
      * Implements IFeedHandlerOwner
      **/
     bool getAllowPrune() const override;
+    void onCommitDone() override;
     void startTransactionLogReplay();
 
 
@@ -12,7 +12,7 @@
 #include <vespa/searchcore/proton/attribute/i_attribute_manager.h>
 #include <vespa/searchcore/proton/docsummary/isummarymanager.h>
 #include <vespa/searchcore/proton/matching/matching_stats.h>
-#include <vespa/searchcore/proton/matching/matching_stats.h>
+#include <vespa/searchcore/proton/matching/sessionmanager.h>
 #include <vespa/searchcore/proton/metrics/documentdb_job_trackers.h>
 #include <vespa/searchcore/proton/metrics/executor_threading_service_stats.h>
 #include <vespa/searchlib/attribute/attributevector.h>
@@ -44,6 +44,7 @@ DocumentDBMetricsUpdater::DocumentDBMetricsUpdater(const DocumentSubDBCollection
       _writeFilter(writeFilter),
       _feed_handler(feed_handler),
       _lastDocStoreCacheStats(),
+      _lastQueryResultCacheStats(),
       _last_feed_handler_stats()
 {
 }
@@ -213,20 +214,20 @@ updateDocumentsMetrics(DocumentDBTaggedMetrics &metrics, const DocumentSubDBColl
 }
 
 void
-updateDocumentStoreCacheHitRate(const CacheStats &current, const CacheStats &last,
-                                metrics::LongAverageMetric &cacheHitRate)
+updateCacheHitRate(const char *cacheName, const CacheStats &current, const CacheStats &last,
+                   metrics::LongAverageMetric &cacheHitRate)
 {
     if (current.lookups() < last.lookups() || current.hits < last.hits) {
-        LOG(warning, "Not adding document store cache hit rate metrics as values calculated "
+        LOG(warning, "Not adding %s cache hit rate metrics as values calculated "
                      "are corrupt. current.lookups=%zu, last.lookups=%zu, current.hits=%zu, last.hits=%zu.",
-            current.lookups(), last.lookups(), current.hits, last.hits);
+            cacheName, current.lookups(), last.lookups(), current.hits, last.hits);
     } else {
         if ((current.lookups() - last.lookups()) > 0xffffffffull
             || (current.hits - last.hits) > 0xffffffffull)
         {
-            LOG(warning, "Document store cache hit rate metrics to add are suspiciously high."
+            LOG(warning, "%s cache hit rate metrics to add are suspiciously high."
                          " lookups diff=%zu, hits diff=%zu.",
-                current.lookups() - last.lookups(), current.hits - last.hits);
+                cacheName, current.lookups() - last.lookups(), current.hits - last.hits);
         }
         cacheHitRate.addTotalValueWithCount(current.hits - last.hits, current.lookups() - last.lookups());
     }
@@ -257,12 +258,27 @@ updateDocumentStoreMetrics(DocumentDBTaggedMetrics::SubDBMetrics::DocumentStoreM
     totalStats.memoryUsage.incAllocatedBytes(cacheStats.memory_used);
     metrics.cache.memoryUsage.set(cacheStats.memory_used);
     metrics.cache.elements.set(cacheStats.elements);
-    updateDocumentStoreCacheHitRate(cacheStats, lastCacheStats, metrics.cache.hitRate);
+    updateCacheHitRate("document store", cacheStats, lastCacheStats, metrics.cache.hitRate);
     updateCountMetric(cacheStats.lookups(), lastCacheStats.lookups(), metrics.cache.lookups);
     updateCountMetric(cacheStats.invalidations, lastCacheStats.invalidations, metrics.cache.invalidations);
     lastCacheStats = cacheStats;
 }
 
+void
+updateQueryResultCacheMetrics(DocumentDBTaggedMetrics::MatchingMetrics::ResultCacheMetrics &metrics,
+                              const matching::QueryResultCache &cache, CacheStats &lastCacheStats,
+                              TotalStats &totalStats)
+{
+    CacheStats cacheStats = cache.get_stats();
+    totalStats.memoryUsage.incAllocatedBytes(cacheStats.memory_used);
+    metrics.memoryUsage.set(cacheStats.memory_used);
+    metrics.elements.set(cacheStats.elements);
+    updateCacheHitRate("query result", cacheStats, lastCacheStats, metrics.hitRate);
+    updateCountMetric(cacheStats.lookups(), lastCacheStats.lookups(), metrics.lookups);
+    updateCountMetric(cacheStats.invalidations, lastCacheStats.invalidations, metrics.invalidations);
+    lastCacheStats = cacheStats;
+}
+
 void
 updateDocumentStoreMetrics(DocumentDBTaggedMetrics &metrics, const DocumentSubDBCollection &subDBs,
                            DocumentDBMetricsUpdater::DocumentStoreCacheStats &lastDocStoreCacheStats, TotalStats &totalStats)
@@ -319,6 +335,8 @@ DocumentDBMetricsUpdater::updateMetrics(const metrics::MetricLockGuard & guard,
     updateSessionCacheMetrics(metrics, _sessionManager);
     updateDocumentsMetrics(metrics, _subDBs);
     updateDocumentStoreMetrics(metrics, _subDBs, _lastDocStoreCacheStats, totalStats);
+    updateQueryResultCacheMetrics(metrics.matching.resultCache, _sessionManager.getQueryResultCache(),
+                                  _lastQueryResultCacheStats, totalStats);
     updateMiscMetrics(metrics, threadingServiceStats);
 
     metrics.totalMemoryUsage.update(totalStats.memoryUsage);
@@ -40,6 +40,7 @@ private:
     FeedHandler                   &_feed_handler;
     // Last updated document store cache statistics. Necessary due to metrics implementation is upside down.
     DocumentStoreCacheStats        _lastDocStoreCacheStats;
+    vespalib::CacheStats           _lastQueryResultCacheStats;
     std::optional<FeedHandlerStats> _last_feed_handler_stats;
 
     void updateMiscMetrics(DocumentDBTaggedMetrics &metrics, const ExecutorThreadingServiceStats &threadingServiceStats);
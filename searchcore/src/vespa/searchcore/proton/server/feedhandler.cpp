@@ -6,6 +6,7 @@
 #include "i_feed_handler_owner.h"
 #include "ifeedview.h"
 #include "configstore.h"
+#include "packetwrapper.h"
 #include <vespa/document/util/feed_reject_helper.h>
 #include <vespa/document/base/exceptions.h>
 #include <vespa/document/datatype/documenttype.h>
@@ -50,6 +51,17 @@ namespace {
 
 using search::SerialNum;
 
+/*
+ * Max number of replayed packets being decoded or waiting to be handled
+ * by the master thread before the transaction log client thread blocks.
+ */
+constexpr size_t max_pending_replay_packets = 16;
+
+/*
+ * Number of threads deserializing replayed packets ahead of the master thread.
+ */
+constexpr uint32_t replay_decode_threads = 4;
+
 bool
 ignoreOperation(const DocumentOperation &op) {
     return (op.getPrevTimestamp() != 0) && (op.getTimestamp() < op.getPrevTimestamp());
@@ -417,6 +429,7 @@ FeedHandler::FeedHandler(IThreadingService &writeService,
       _tlsMgrWriter(),
       _tlsWriter(tlsWriter),
       _tlsReplayProgress(),
+      _pendingReplayPackets(),
       _serialNum(0),
       _prunedSerialNum(0),
       _replay_end_serial_num(0),
@@ -475,7 +488,8 @@ FeedHandler::replayTransactionLog(SerialNum flushedIndexMgrSerial, SerialNum flu
     assert(_activeFeedView);
     assert(_bucketDBHandler);
     auto state = make_shared<ReplayTransactionLogState>
-                          (getDocTypeName(), _activeFeedView, *_bucketDBHandler, _replayConfig, config_store, replay_throttling_policy, *this);
+                          (getDocTypeName(), _activeFeedView, *_bucketDBHandler, _replayConfig, config_store, replay_throttling_policy, *this,
+                           replay_decode_threads);
     changeFeedState(state);
     // Resurrected attribute vector might cause oldestFlushedSerial to
     // be lower than _prunedSerialNum, so don't warn for now.
@@ -523,6 +537,7 @@ FeedHandler::getTransactionLogReplayDone() const {
 void
 FeedHandler::onCommitDone(size_t numOperations, vespalib::steady_time start_time) {
     _numOperations.commitCompleted(numOperations);
+    _owner.onCommitDone();
     if (_numOperations.shouldScheduleCommit()) {
         enqueCommitTask();
     }
@@ -784,14 +799,33 @@ FeedHandler::receive(const Packet &packet)
     FeedStateSP state = getFeedState();
     auto wrap = make_shared<PacketWrapper>(packet, _tlsReplayProgress.get());
     state->receive(wrap, _writeService.master());
-    wrap->gate.await();
-    return wrap->result;
+    // Let packets be decoded and replayed while receiving the next ones
+    _pendingReplayPackets.push_back(std::move(wrap));
+    return awaitPendingReplayPackets(max_pending_replay_packets);
+}
+
+FeedHandler::RPC::Result
+FeedHandler::awaitPendingReplayPackets(size_t maxPending)
+{
+    RPC::Result result = RPC::OK;
+    while (_pendingReplayPackets.size() > maxPending) {
+        const auto &wrap = _pendingReplayPackets.front();
+        wrap->gate.await();
+        if (wrap->result != RPC::OK) {
+            LOG(error, "Replay of transaction log packet with serial range [%" PRIu64 ", %" PRIu64 "] failed: %s",
+                wrap->packet.range().from(), wrap->packet.range().to(), wrap->error.c_str());
+            result = wrap->result;
+        }
+        _pendingReplayPackets.pop_front();
+    }
+    return result;
 }
 
 void
 FeedHandler::eof()
 {
     // Only called by visit, subscription gets one or more inSync() callbacks.
+    (void) awaitPendingReplayPackets(0);
     _writeService.master().execute(makeLambdaTask([this]() { performEof(); }));
 }
 
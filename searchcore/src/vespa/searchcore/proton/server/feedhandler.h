@@ -15,6 +15,7 @@
 #include <vespa/searchcore/proton/common/doctypename.h>
 #include <vespa/searchcore/proton/common/feedtoken.h>
 #include <vespa/searchlib/transactionlog/client_common.h>
+#include <deque>
 #include <shared_mutex>
 
 namespace searchcorespi::index { struct IThreadingService; }
@@ -33,6 +34,7 @@ class IFeedView;
 struct IResourceWriteFilter;
 class IReplayConfig;
 class JoinBucketsOperation;
+struct PacketWrapper;
 class PutOperation;
 class RemoveOperation;
 class ReplayThrottlingPolicy;
@@ -75,6 +77,8 @@ private:
     std::unique_ptr<TlsWriter>             _tlsMgrWriter;
     TlsWriter                             *_tlsWriter;
     TlsReplayProgress::UP                  _tlsReplayProgress;
+    // replayed packets not yet known to be handled, only used by transaction log client thread
+    std::deque<std::shared_ptr<PacketWrapper>> _pendingReplayPackets;
     // the serial num of the last feed operation processed by feed handler.
     std::atomic<SerialNum>                 _serialNum;
     // the serial num considered to be fully procssessed and flushed to stable storage. Used to prune transaction log.
@@ -124,6 +128,7 @@ private:
     void performSplit(FeedToken token, SplitBucketOperation &op);
     void performJoin(FeedToken token, JoinBucketsOperation &op);
     void performEof();
+    RPC::Result awaitPendingReplayPackets(size_t maxPending);
 
     /**
      * Used when flushing is done
@@ -232,6 +237,9 @@ public:
     float getReplayProgress() const {
         return _tlsReplayProgress ? _tlsReplayProgress->getProgress() : 0;
     }
+    double getReplayThroughput() const {
+        return _tlsReplayProgress ? _tlsReplayProgress->getThroughput() : 0;
+    }
     bool getTransactionLogReplayDone() const;
     vespalib::string getDocTypeName() const { return _docTypeName.getName(); }
     void tlsPrune(SerialNum oldest_to_keep);
@@ -10,18 +10,28 @@
 #include <vespa/searchcore/proton/feedoperation/operations.h>
 #include <vespa/searchcore/proton/common/eventlogger.h>
 #include <vespa/searchcore/proton/common/replay_feed_token_factory.h>
+#include <vespa/document/repo/documenttyperepo.h>
+#include <vespa/vespalib/util/cpu_usage.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/gate.h>
 #include <vespa/vespalib/util/idestructorcallback.h>
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/shared_operation_throttler.h>
+#include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 #include <cassert>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.server.feedstates");
 
+VESPA_THREAD_STACK_TAG(proton_replay_decode_executor)
+
 using search::transactionlog::Packet;
 using search::transactionlog::client::RPC;
 using search::SerialNum;
+using vespalib::CpuUsage;
 using vespalib::Executor;
+using vespalib::IllegalStateException;
 using vespalib::makeLambdaTask;
 using vespalib::IDestructorCallback;
 using vespalib::SharedOperationThrottler;
@@ -45,7 +55,8 @@ handleProgress(TlsReplayProgress &progress, SerialNum currentSerial)
                                                   progress.getProgress(),
                                                   progress.getFirst(),
                                                   progress.getLast(),
-                                                  progress.getCurrent());
+                                                  progress.getCurrent(),
+                                                  progress.getThroughput());
     }
 }
 
@@ -147,43 +158,135 @@ public:
     }
 };
 
+/**
+ * Packet entries deserialized ahead of replay. Entries without an
+ * operation (config changes and entries that failed to deserialize)
+ * are deserialized again when replayed. If the packet itself could not
+ * be deserialized, the entries before the failure are kept and the
+ * failure is reported by error().
+ */
+class DecodedPacket {
+public:
+    using DocumentTypeRepoSP = std::shared_ptr<const document::DocumentTypeRepo>;
+    struct DecodedEntry {
+        Packet::Entry entry;
+        std::unique_ptr<FeedOperation> op;
+        explicit DecodedEntry(const Packet::Entry &entry_in) noexcept : entry(entry_in), op() {}
+    };
+
+    DecodedPacket(PacketWrapper::SP wrap, DocumentTypeRepoSP repo)
+        : _wrap(std::move(wrap)),
+          _repo(std::move(repo)),
+          _entries(),
+          _error(),
+          _decoded()
+    {}
+    void decode();
+    void await_decoded() { _decoded.await(); }
+    PacketWrapper &wrap() { return *_wrap; }
+    const document::DocumentTypeRepo *repo() const { return _repo.get(); }
+    std::vector<DecodedEntry> &entries() { return _entries; }
+    const vespalib::string &error() const { return _error; }
+private:
+    PacketWrapper::SP _wrap;
+    DocumentTypeRepoSP _repo;
+    std::vector<DecodedEntry> _entries;
+    vespalib::string _error;
+    vespalib::Gate _decoded;
+};
+
+void
+DecodedPacket::decode()
+{
+    // Called by decode executor thread.
+    const Packet &packet = _wrap->packet;
+    vespalib::nbostream_longlivedbuf handle(packet.getHandle().data(), packet.getHandle().size());
+    _entries.reserve(packet.size());
+    try {
+        while ( !handle.empty() ) {
+            Packet::Entry entry;
+            entry.deserialize(handle);
+            _entries.emplace_back(entry);
+            if (_repo) {
+                try {
+                    _entries.back().op = ReplayPacketDispatcher::decodeEntry(entry, *_repo);
+                } catch (const std::exception &e) {
+                    // Deserialized again (and failing again) in the replay thread
+                    LOG(debug, "Failed to decode packet entry with serial %" PRIu64 " ahead of replay: %s", entry.serial(), e.what());
+                }
+            }
+        }
+    } catch (const std::exception &e) {
+        _error = make_string("Failed to deserialize entry %zu (after serial %" PRIu64 ") of transaction log packet "
+                             "with serial range [%" PRIu64 ", %" PRIu64 "]: %s",
+                             _entries.size(), (_entries.empty() ? 0 : _entries.back().entry.serial()),
+                             packet.range().from(), packet.range().to(), e.what());
+    }
+    _decoded.countDown();
+}
+
 class PacketDispatcher {
 public:
     PacketDispatcher(IReplayPacketHandler *packet_handler)
         : _packet_handler(packet_handler)
     {}
 
-    void handlePacket(PacketWrapper & wrap);
+    void handlePacket(DecodedPacket & decoded);
 private:
-    void handleEntry(const Packet::Entry &entry);
+    void handleEntry(DecodedPacket::DecodedEntry &decoded_entry, const document::DocumentTypeRepo *decode_repo);
+    [[noreturn]] static void fail(PacketWrapper &wrap, const vespalib::string &error);
     IReplayPacketHandler *_packet_handler;
 };
 
 void
-PacketDispatcher::handlePacket(PacketWrapper & wrap)
+PacketDispatcher::handlePacket(DecodedPacket & decoded)
 {
-    vespalib::nbostream_longlivedbuf handle(wrap.packet.getHandle().data(), wrap.packet.getHandle().size());
-    while ( !handle.empty() ) {
-        Packet::Entry entry;
-        entry.deserialize(handle);
-        handleEntry(entry);
+    decoded.await_decoded();
+    PacketWrapper &wrap = decoded.wrap();
+    for (auto &decoded_entry : decoded.entries()) {
+        try {
+            handleEntry(decoded_entry, decoded.repo());
+        } catch (const std::exception &e) {
+            fail(wrap, make_string("Failed to replay transaction log entry with serial %" PRIu64 ": %s",
+                                   decoded_entry.entry.serial(), e.what()));
+        }
         if (wrap.progress != nullptr) {
-            handleProgress(*wrap.progress, entry.serial());
+            handleProgress(*wrap.progress, decoded_entry.entry.serial());
         }
     }
+    if ( ! decoded.error().empty()) {
+        fail(wrap, decoded.error());
+    }
     wrap.result = RPC::OK;
     wrap.gate.countDown();
 }
 
 void
-PacketDispatcher::handleEntry(const Packet::Entry &entry) {
+PacketDispatcher::fail(PacketWrapper &wrap, const vespalib::string &error)
+{
+    // Replay cannot continue past a packet that is not fully replayed.
+    wrap.error = error;
+    wrap.result = RPC::ERROR;
+    wrap.gate.countDown();
+    throw IllegalStateException(error, VESPA_STRLOC);
+}
+
+void
+PacketDispatcher::handleEntry(DecodedPacket::DecodedEntry &decoded_entry, const document::DocumentTypeRepo *decode_repo) {
     // Called by handlePacket() in executor thread.
+    const Packet::Entry &entry = decoded_entry.entry;
     LOG(spam, "replay packet entry: entrySerial(%" PRIu64 "), entryType(%u)", entry.serial(), entry.type());
 
     auto entry_serial_num = entry.serial();
     _packet_handler->check_serial_num(entry_serial_num);
     ReplayPacketDispatcher dispatcher(*_packet_handler);
-    dispatcher.replayEntry(entry);
+    // A config change replayed after decoding can have changed the document type repo
+    if (decoded_entry.op && decode_repo == &_packet_handler->getDeserializeRepo()) {
+        dispatcher.replayDecoded(*decoded_entry.op);
+    } else {
+        dispatcher.replayEntry(entry);
+    }
+    decoded_entry.op.reset();
     _packet_handler->optionalCommit(entry_serial_num);
 }
 
@@ -196,19 +299,51 @@ ReplayTransactionLogState::ReplayTransactionLogState(
         IReplayConfig &replay_config,
         FeedConfigStore &config_store,
         const ReplayThrottlingPolicy &replay_throttling_policy,
-        IIncSerialNum& inc_serial_num)
+        IIncSerialNum& inc_serial_num,
+        uint32_t decode_threads)
     : FeedState(REPLAY_TRANSACTION_LOG),
       _doc_type_name(name),
-      _packet_handler(std::make_unique<TransactionLogReplayPacketHandler>(feed_view_ptr, bucketDBHandler, replay_config, config_store, replay_throttling_policy, inc_serial_num))
-{ }
+      _feed_view_ptr(feed_view_ptr),
+      _packet_handler(std::make_unique<TransactionLogReplayPacketHandler>(feed_view_ptr, bucketDBHandler, replay_config, config_store, replay_throttling_policy, inc_serial_num)),
+      _decode_executor(std::make_unique<vespalib::ThreadStackExecutor>(decode_threads, 128_Ki,
+                                                                       CpuUsage::wrap(proton_replay_decode_executor, CpuUsage::Category::SETUP))),
+      _decode_repo_lock(),
+      _decode_repo()
+{
+    update_decode_repo();
+}
 
 ReplayTransactionLogState::~ReplayTransactionLogState() = default;
 
+ReplayTransactionLogState::DocumentTypeRepoSP
+ReplayTransactionLogState::get_decode_repo()
+{
+    std::lock_guard guard(_decode_repo_lock);
+    return _decode_repo;
+}
+
+void
+ReplayTransactionLogState::update_decode_repo()
+{
+    // Called in executor thread, where the active feed view can change.
+    DocumentTypeRepoSP repo = (_feed_view_ptr != nullptr) ? _feed_view_ptr->getDocumentTypeRepo() : DocumentTypeRepoSP();
+    std::lock_guard guard(_decode_repo_lock);
+    _decode_repo = std::move(repo);
+}
+
 void
 ReplayTransactionLogState::receive(const PacketWrapper::SP &wrap, Executor &executor) {
-    executor.execute(makeLambdaTask([this, wrap = wrap] () {
+    auto decoded = std::make_shared<DecodedPacket>(wrap, get_decode_repo());
+    auto rejected = _decode_executor->execute(makeLambdaTask([decoded] () {
+        decoded->decode();
+    }));
+    if (rejected) {
+        rejected->run();
+    }
+    executor.execute(makeLambdaTask([this, decoded = std::move(decoded)] () {
         PacketDispatcher dispatcher(_packet_handler.get());
-        dispatcher.handlePacket(*wrap);
+        dispatcher.handlePacket(*decoded);
+        update_decode_repo();
     }));
 }
 
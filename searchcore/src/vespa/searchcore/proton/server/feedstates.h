@@ -7,6 +7,10 @@
 #include "packetwrapper.h"
 #include "ireplaypackethandler.h"
 #include <vespa/searchcore/proton/common/commit_time_tracker.h>
+#include <mutex>
+
+namespace document { class DocumentTypeRepo; }
+namespace vespalib { class ThreadStackExecutor; }
 
 namespace proton {
 
@@ -44,10 +48,24 @@ public:
 /**
  * The feed handler is replaying the transaction log.
  * Replayed messages from the transaction log are sent to the active feed view.
+ *
+ * Packet entries are deserialized by a decode executor owned by this
+ * state, allowing multiple packets to be deserialized in parallel, while
+ * the resulting operations are replayed in serial number order by the
+ * given executor. The decode executor is dedicated to replay since the
+ * replaying executor waits for packets to be decoded.
  */
 class ReplayTransactionLogState : public FeedState {
+    using DocumentTypeRepoSP = std::shared_ptr<const document::DocumentTypeRepo>;
     vespalib::string _doc_type_name;
+    IFeedView *& _feed_view_ptr;
     std::unique_ptr<IReplayPacketHandler> _packet_handler;
+    std::unique_ptr<vespalib::ThreadStackExecutor> _decode_executor;
+    std::mutex _decode_repo_lock;
+    DocumentTypeRepoSP _decode_repo;
+
+    DocumentTypeRepoSP get_decode_repo();
+    void update_decode_repo();
 
 public:
     ReplayTransactionLogState(const vespalib::string &name,
@@ -56,7 +74,8 @@ public:
             IReplayConfig &replay_config,
             FeedConfigStore &config_store,
             const ReplayThrottlingPolicy &replay_throttling_policy,
-            IIncSerialNum &inc_serial_num);
+            IIncSerialNum &inc_serial_num,
+            uint32_t decode_threads);
 
     ~ReplayTransactionLogState() override;
     void handleOperation(FeedToken, FeedOperationUP op) override {
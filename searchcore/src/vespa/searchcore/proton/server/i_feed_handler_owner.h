@@ -16,6 +16,11 @@ struct IFeedHandlerOwner {
     virtual void enterRedoReprocessState() = 0;
     virtual void onPerformPrune(search::SerialNum flushedSerial) = 0;
     virtual bool getAllowPrune() const = 0;
+    /**
+     * Called by the master thread when a commit is done and the fed
+     * changes are visible for search.
+     */
+    virtual void onCommitDone() = 0;
 };
 
 } // namespace proton
@@ -2,7 +2,11 @@
 
 #include "matchview.h"
 #include "searchcontext.h"
+#include <vespa/searchcore/proton/attribute/imported_attributes_repo.h>
 #include <vespa/searchcore/proton/matching/matcher.h>
+#include <vespa/searchcore/proton/matching/sessionmanager.h>
+#include <vespa/searchlib/attribute/imported_attribute_vector.h>
+#include <vespa/searchlib/common/unique_issues.h>
 #include <vespa/searchlib/engine/searchrequest.h>
 #include <vespa/searchlib/engine/searchreply.h>
 #include <vespa/vespalib/util/stringfmt.h>
@@ -12,10 +16,12 @@
 LOG_SETUP(".proton.server.matchview");
 
 using proton::matching::MatchContext;
+using proton::matching::QueryResultCache;
 using proton::matching::SearchSession;
 using search::AttributeGuard;
 using search::AttributeVector;
 using search::attribute::IAttributeContext;
+using search::attribute::ImportedAttributeVector;
 using search::engine::SearchReply;
 using search::engine::SearchRequest;
 using search::queryeval::Blueprint;
@@ -62,9 +68,62 @@ MatchView::createContext() const {
     return std::make_unique<MatchContext>(std::move(attrCtx), std::move(searchCtx));
 }
 
+std::optional<QueryResultCache::Key>
+MatchView::makeQueryResultCacheKey(const SearchRequest &req) const
+{
+    const IDocumentMetaStore &dms = _metaStore->get();
+    QueryResultCache::Visibility visibility(dms.getLastSerialNum());
+    visibility.active_lids_generation = dms.getActiveLidsGeneration();
+    // imported attributes change when their parent document db commits, which does not invalidate the cache
+    const ImportedAttributesRepo *importedAttributes = _attrMgr->getImportedAttributes();
+    if (importedAttributes != nullptr) {
+        std::vector<std::shared_ptr<ImportedAttributeVector>> attrs;
+        importedAttributes->getAll(attrs);
+        for (const auto &attr : attrs) {
+            const auto *target = dynamic_cast<const AttributeVector *>(attr->getTargetAttribute().get());
+            const auto &targetMetaStore = attr->getTargetDocumentMetaStore();
+            if ((target == nullptr) || !targetMetaStore) {
+                return std::nullopt;
+            }
+            visibility.parent_generations.push_back(targetMetaStore->getReadGuard()->get().getCurrentGeneration());
+            visibility.parent_generations.push_back(target->getCurrentGeneration());
+        }
+    }
+    return QueryResultCache::make_key(req, visibility);
+}
+
 std::unique_ptr<SearchReply>
 MatchView::match(std::shared_ptr<const ISearchHandler> searchHandler, const SearchRequest &req,
                  vespalib::ThreadBundle &threadBundle) const
+{
+    QueryResultCache &cache = _sessionMgr->getQueryResultCache();
+    if (!cache.enabled() || !QueryResultCache::is_cacheable(req)) {
+        return matchUncached(std::move(searchHandler), req, threadBundle);
+    }
+    // generation must be sampled before the serial number to detect feed becoming visible during matching
+    uint64_t cacheGeneration = cache.generation();
+    auto cacheKey = makeQueryResultCacheKey(req);
+    if (!cacheKey) {
+        return matchUncached(std::move(searchHandler), req, threadBundle);
+    }
+    auto reply = cache.lookup(*cacheKey);
+    if (reply) {
+        return reply;
+    }
+    // issues are captured to keep replies for queries reporting them out of the cache, then passed on
+    search::UniqueIssues issues;
+    {
+        auto capture_issues = vespalib::Issue::listen(issues);
+        reply = matchUncached(std::move(searchHandler), req, threadBundle);
+    }
+    cache.insert(*cacheKey, cacheGeneration, *reply, issues);
+    issues.for_each_message([](const auto &msg){ vespalib::Issue::report(msg); });
+    return reply;
+}
+
+std::unique_ptr<SearchReply>
+MatchView::matchUncached(std::shared_ptr<const ISearchHandler> searchHandler, const SearchRequest &req,
+                         vespalib::ThreadBundle &threadBundle) const
 {
     Matcher::SP matcher = getMatcher(req.ranking);
     SearchSession::OwnershipBundle owned_objects;
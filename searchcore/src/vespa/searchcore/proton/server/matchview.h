@@ -7,9 +7,11 @@
 #include <vespa/searchcore/proton/common/docid_limit.h>
 #include <vespa/searchcore/proton/documentmetastore/documentmetastorecontext.h>
 #include <vespa/searchcore/proton/matching/match_context.h>
+#include <vespa/searchcore/proton/matching/query_result_cache.h>
 #include <vespa/searchcore/proton/summaryengine/isearchhandler.h>
 #include <vespa/searchcorespi/index/indexsearchable.h>
 #include <vespa/searchlib/attribute/attributevector.h>
+#include <optional>
 
 namespace proton {
 
@@ -31,6 +33,11 @@ class MatchView {
         return _metaStore->get().getNumActiveLids();
     }
 
+    std::unique_ptr<search::engine::SearchReply>
+    matchUncached(std::shared_ptr<const ISearchHandler> searchHandler,
+                  const search::engine::SearchRequest &req,
+                  vespalib::ThreadBundle &threadBundle) const;
+
 public:
     typedef std::shared_ptr<MatchView> SP;
     MatchView(const MatchView &) = delete;
@@ -61,6 +68,14 @@ public:
 
     matching::MatchContext::UP createContext() const;
 
+    /**
+     * Makes the query result cache key for the given request from what is
+     * currently visible for search. Returns an empty optional if that can
+     * not be determined, in which case the reply must not be cached.
+     */
+    std::optional<matching::QueryResultCache::Key>
+    makeQueryResultCacheKey(const search::engine::SearchRequest &req) const;
+
     std::unique_ptr<search::engine::SearchReply>
     match(std::shared_ptr<const ISearchHandler> searchHandler,
           const search::engine::SearchRequest &req,
@@ -135,24 +135,17 @@ computeGain(const IFlushTarget::DiskGain & gain) {
 
 }
 
-FlushContext::List
-MemoryFlush::getFlushTargets(const FlushContext::List &targetList,
-                             const flushengine::TlsStatsMap & tlsStatsMap) const
+MemoryFlush::OrderType
+MemoryFlush::getOrder(const FlushContext::List &targetList,
+                      const flushengine::TlsStatsMap & tlsStatsMap,
+                      const Config &config) const
 {
     OrderType order(DEFAULT);
     uint64_t totalMemory(0);
     IFlushTarget::DiskGain totalDisk;
     uint64_t totalTlsSize(0);
-    const Config config(getConfig());
     vespalib::hash_set<const void *> visitedHandlers;
     vespalib::system_time now(vespalib::system_clock::now());
-    LOG(debug,
-        "getFlushTargets(): globalMaxMemory(%" PRIu64 "), maxGlobalTlsSize(%" PRIu64 "), globalDiskBloatFactor(%f), "
-        "maxMemoryGain(%" PRIu64 "), diskBloatFactor(%f), maxTimeGain(%f), startTime(%f)",
-        config.maxGlobalMemory, config.maxGlobalTlsSize, config.globalDiskBloatFactor,
-        config.maxMemoryGain, config.diskBloatFactor,
-        vespalib::to_s(config.maxTimeGain),
-        vespalib::to_s(_startTime.time_since_epoch()));
     for (size_t i(0), m(targetList.size()); i < m; i++) {
         const IFlushTarget & target(*targetList[i]->getTarget());
         const IFlushHandler & handler(*targetList[i]->getHandler());
@@ -208,6 +201,22 @@ MemoryFlush::getFlushTargets(const FlushContext::List &targetList,
             order = DISKBLOAT;
         }
     }
+    return order;
+}
+
+FlushContext::List
+MemoryFlush::getFlushTargets(const FlushContext::List &targetList,
+                             const flushengine::TlsStatsMap & tlsStatsMap) const
+{
+    const Config config(getConfig());
+    LOG(debug,
+        "getFlushTargets(): globalMaxMemory(%" PRIu64 "), maxGlobalTlsSize(%" PRIu64 "), globalDiskBloatFactor(%f), "
+        "maxMemoryGain(%" PRIu64 "), diskBloatFactor(%f), maxTimeGain(%f), startTime(%f)",
+        config.maxGlobalMemory, config.maxGlobalTlsSize, config.globalDiskBloatFactor,
+        config.maxMemoryGain, config.diskBloatFactor,
+        vespalib::to_s(config.maxTimeGain),
+        vespalib::to_s(_startTime.time_since_epoch()));
+    OrderType order = getOrder(targetList, tlsStatsMap, config);
     FlushContext::List fv(targetList);
     std::sort(fv.begin(), fv.end(), CompareTarget(order, tlsStatsMap));
     // No desired order and no urgent needs; no flush required at this moment.
@@ -230,6 +239,12 @@ MemoryFlush::getFlushTargets(const FlushContext::List &targetList,
     return fv;
 }
 
+bool
+MemoryFlush::selectsByMemoryGain(const FlushContext::List &targetList,
+                                 const flushengine::TlsStatsMap & tlsStatsMap) const
+{
+    return (getOrder(targetList, tlsStatsMap, getConfig()) == MEMORY);
+}
 
 bool
 MemoryFlush::CompareTarget::operator()(const FlushContext::SP &lfc, const FlushContext::SP &rfc) const
@@ -70,6 +70,10 @@ private:
         const flushengine::TlsStatsMap &_tlsStatsMap;
     };
 
+    OrderType getOrder(const FlushContext::List &targetList,
+                       const flushengine::TlsStatsMap &tlsStatsMap,
+                       const Config &config) const;
+
 public:
     using SP = std::shared_ptr<MemoryFlush>;
 
@@ -81,6 +85,8 @@ public:
     FlushContext::List
     getFlushTargets(const FlushContext::List &targetList,
                     const flushengine::TlsStatsMap &tlsStatsMap) const override;
+    bool selectsByMemoryGain(const FlushContext::List &targetList,
+                             const flushengine::TlsStatsMap &tlsStatsMap) const override;
 
     void setConfig(const Config &config);
     Config getConfig() const;
@@ -10,20 +10,23 @@
 namespace proton {
 /**
  * Wrapper of transaction log packet to use when handing over to
- * executor thread.
+ * executor thread. The packet is copied, since it can be handled
+ * after the receiver has returned.
  */
 struct PacketWrapper {
     typedef std::shared_ptr<PacketWrapper> SP;
 
-    const search::transactionlog::Packet &packet;
+    const search::transactionlog::Packet packet;
     TlsReplayProgress *progress;
     search::transactionlog::client::RPC::Result result;
+    vespalib::string error;
     vespalib::Gate gate;
 
-    PacketWrapper(const search::transactionlog::Packet &p, TlsReplayProgress *progress_) noexcept
-        : packet(p),
+    PacketWrapper(const search::transactionlog::Packet &p, TlsReplayProgress *progress_)
+        : packet(p.getHandle().data(), p.getHandle().size()),
           progress(progress_),
           result(search::transactionlog::client::RPC::ERROR),
+          error(),
           gate()
     {
     }
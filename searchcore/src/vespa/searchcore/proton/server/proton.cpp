@@ -292,7 +292,8 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
     _matchEngine = std::make_unique<MatchEngine>(protonConfig.numsearcherthreads,
                                                  protonConfig.numthreadspersearch,
                                                  protonConfig.distributionkey,
-                                                 protonConfig.search.async);
+                                                 protonConfig.search.async,
+                                                 protonConfig.search.numaAware);
     _matchEngine->set_issue_forwarding(protonConfig.forwardIssues);
     _distributionKey = protonConfig.distributionkey;
     _summaryEngine = std::make_unique<SummaryEngine>(protonConfig.numsummarythreads, protonConfig.docsum.async);
@@ -320,6 +321,7 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
     _tls->start(_transport, hwInfo.cpu().cores());
     _flushEngine = std::make_unique<FlushEngine>(std::make_shared<flushengine::TlsStatsFactory>(_tls->getTransLogServer()),
                                                  strategy, flush.maxconcurrent, vespalib::from_s(flush.idleinterval));
+    _flushEngine->setSchedulerConfig(flushengine::FlushScheduler::Config(flush.diskwritebudget));
     _metricsEngine->addExternalMetrics(_summaryEngine->getMetrics());
 
     char tmp[1024];
@@ -393,6 +395,9 @@ Proton::applyConfig(const BootstrapConfig::SP & configSnapshot)
         _memoryFlushConfigUpdater->setConfig(protonConfig.flush.memory);
         _flushEngine->kick();
     }
+    if (_flushEngine) {
+        _flushEngine->setSchedulerConfig(flushengine::FlushScheduler::Config(protonConfig.flush.diskwritebudget));
+    }
 }
 
 std::shared_ptr<DocumentDBConfigOwner>
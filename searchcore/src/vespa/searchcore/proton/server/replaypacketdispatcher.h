@@ -4,6 +4,9 @@
 
 #include "ireplaypackethandler.h"
 #include <vespa/searchlib/transactionlog/common.h>
+#include <memory>
+
+namespace document { class DocumentTypeRepo; }
 
 namespace proton {
 
@@ -12,6 +15,9 @@ class FeedOperation;
  * Utility class that deserializes packet entries into feed operations
  * during replay from the transaction log and dispatches the feed operations
  * to a given handler class.
+ *
+ * Deserialization can be done up front (in another thread) using
+ * decodeEntry(), followed by replayDecoded() in the replay thread.
  */
 class ReplayPacketDispatcher
 {
@@ -19,9 +25,6 @@ private:
     typedef search::transactionlog::Packet Packet;
     IReplayPacketHandler &_handler;
 
-    template <typename OperationType>
-    void replay(OperationType &op, vespalib::nbostream &is, const Packet::Entry &entry);
-
 protected:
     virtual void store(const FeedOperation &op);
 
@@ -30,6 +33,14 @@ public:
     virtual ~ReplayPacketDispatcher();
 
     void replayEntry(const Packet::Entry &entry);
+    void replayDecoded(const FeedOperation &op);
+
+    /**
+     * Deserialize the given packet entry using the given repo. Returns an
+     * empty pointer for entries that can only be handled by replayEntry()
+     * (config changes).
+     */
+    static std::unique_ptr<FeedOperation> decodeEntry(const Packet::Entry &entry, const document::DocumentTypeRepo &repo);
 };
 
 } // namespace proton
@@ -4,6 +4,7 @@
 
 #include <vespa/searchlib/common/serialnum.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/time.h>
 #include <atomic>
 
 namespace proton {
@@ -15,6 +16,7 @@ private:
     const search::SerialNum _first;
     const search::SerialNum _last;
     std::atomic<search::SerialNum> _current;
+    const vespalib::steady_time _start_time;
 
 public:
     typedef std::unique_ptr<TlsReplayProgress> UP;
@@ -25,7 +27,8 @@ public:
         : _domainName(domainName),
           _first(first),
           _last(last),
-          _current(first)
+          _current(first),
+          _start_time(vespalib::steady_clock::now())
     {
     }
     const vespalib::string &getDomainName() const noexcept { return _domainName; }
@@ -39,6 +42,11 @@ public:
             return ((float)(getCurrent() - _first)/float(_last - _first));
         }
     }
+    // Number of replayed operations per second since replay started
+    double getThroughput() const noexcept {
+        double elapsed = vespalib::to_s(vespalib::steady_clock::now() - _start_time);
+        return (elapsed > 0.0) ? (double(getCurrent() - _first) / elapsed) : 0.0;
+    }
     void updateCurrent(search::SerialNum current) noexcept { _current.store(current, std::memory_order_relaxed); }
 };
 
@@ -145,6 +145,9 @@ struct DocumentMetaStoreObserver : public IDocumentMetaStore
     DocId getNumActiveLids() const override {
         return _store.getNumActiveLids();
     }
+    uint64_t getActiveLidsGeneration() const override {
+        return _store.getActiveLidsGeneration();
+    }
     bool getFreeListActive() const override {
         return _store.getFreeListActive();
     }
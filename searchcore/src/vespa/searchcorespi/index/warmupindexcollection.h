@@ -84,6 +84,7 @@ private:
         const IAttributeVector *getAttributeStableEnum(const vespalib::string &) const override { return nullptr; }
         std::unique_ptr<vespalib::eval::Value> get_query_tensor(const vespalib::string&) const override;
         const AttributeBlueprintParams& get_attribute_blueprint_params() const override { return _params; }
+        const search::queryeval::wand::Bm25Params *get_weak_and_bm25_params() const override { return nullptr; }
     private:
         const vespalib::Doom _doom;
         const AttributeBlueprintParams _params;
@@ -25,6 +25,7 @@ public class ForceLoad {
                 "CountAggregationResult",
                 "AverageAggregationResult",
                 "ExpressionCountAggregationResult",
+                "UniqueCountAggregationResult",
                 "hll.SparseSketch",
                 "hll.NormalSketch"
         };
@@ -0,0 +1,71 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+package com.yahoo.searchlib.aggregation;
+
+import com.yahoo.searchlib.aggregation.hll.*;
+import com.yahoo.vespa.objects.BufferSerializer;
+import com.yahoo.vespa.objects.Identifiable;
+import org.junit.Test;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+public class UniqueCountAggregationResultTest {
+
+    @Test
+    public void requireThatSketchesAreMerged() {
+        UniqueCountAggregationResult aggr1 = createAggregationWithSparseSketch(42);
+        UniqueCountAggregationResult aggr2 = createAggregationWithSparseSketch(1337);
+
+        aggr1.merge(aggr2);
+
+        SparseSketch sketch = (SparseSketch) aggr1.getSketch();
+        SketchUtils.assertSparseSketchContains(sketch, 42, 1337);
+    }
+
+    @Test
+    public void requireThatMergeUpdatesEstimate() {
+        UniqueCountAggregationResult aggr = createAggregationWithSparseSketch(1337);
+        assertEquals(1, aggr.getEstimatedUniqueCount());
+        assertEquals(1, aggr.getRank().getInteger());
+        aggr.merge(createAggregationWithSparseSketch(9001));
+        assertEquals(2, aggr.getEstimatedUniqueCount());
+        assertEquals(2, aggr.getRank().getInteger());
+    }
+
+    @Test
+    public void requireThatDefaultEstimatorIsHyperLogLog() {
+        UniqueCountAggregationResult aggr = new UniqueCountAggregationResult();
+        assertEquals(0, aggr.getEstimatedUniqueCount());
+        aggr.merge(new UniqueCountAggregationResult(SketchUtils.createSparseSketch(1, 2, 3), new HyperLogLogEstimator()));
+        assertEquals(3, aggr.getEstimatedUniqueCount());
+    }
+
+    @Test
+    public void requireThatSerializationDeserializationMatchSparseSketch() {
+        testSerialization(createAggregationWithSparseSketch(42));
+    }
+
+    @Test
+    public void requireThatSerializationDeserializationMatchNormalSketch() {
+        testSerialization(new UniqueCountAggregationResult(SketchUtils.createNormalSketch(42), sketch -> 42));
+    }
+
+    private void testSerialization(UniqueCountAggregationResult from) {
+        BufferSerializer buffer = new BufferSerializer();
+        from.serializeWithId(buffer);
+        buffer.flip();
+        Identifiable obj = Identifiable.create(buffer);
+        assertTrue(obj instanceof UniqueCountAggregationResult);
+        UniqueCountAggregationResult to = (UniqueCountAggregationResult) obj;
+        assertEquals(from.getSketch(), to.getSketch());
+        assertEquals(from, to);
+    }
+
+    private static UniqueCountAggregationResult createAggregationWithSparseSketch(int sketchValue) {
+        return new UniqueCountAggregationResult(
+                SketchUtils.createSparseSketch(sketchValue),
+                sketch -> ((SparseSketch) sketch).size()
+        );
+    }
+
+}
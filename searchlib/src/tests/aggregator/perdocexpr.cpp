@@ -250,6 +250,77 @@ TEST("require that StandardDeviationAggregationResult aggregates multi-value exp
     EXPECT_APPROX(41.5, aggr.getRank().getFloat(), 0.1);
 }
 
+UniqueCountAggregationResult createUniqueCount(int64_t first, int64_t last) {
+    UniqueCountAggregationResult aggr;
+    for (int64_t v = first; v < last; ++v) {
+        aggr.setExpression(MU<ConstantNode>(MU<Int64ResultNode>(v))).aggregate(DocId(v), HitRank(1));
+    }
+    return aggr;
+}
+
+TEST("require that UniqueCountAggregationResult counts unique values") {
+    UniqueCountAggregationResult aggr;
+    EXPECT_EQUAL(0, aggr.getEstimatedUniqueCount());
+    aggr.setExpression(MU<ConstantNode>(MU<Int64ResultNode>(67))).aggregate(DocId(1), HitRank(1));
+    aggr.setExpression(MU<ConstantNode>(MU<StringResultNode>("67"))).aggregate(DocId(2), HitRank(1));
+    aggr.setExpression(MU<ConstantNode>(MU<Int64ResultNode>(67))).aggregate(DocId(3), HitRank(1));
+    EXPECT_EQUAL(2, aggr.getEstimatedUniqueCount());
+    EXPECT_EQUAL(2, aggr.getRank().getInteger());
+    EXPECT_EQUAL(uint32_t(SparseSketch<>::classId), aggr.getSketch().getClassId());
+}
+
+TEST("require that UniqueCountAggregationResult counts each value of multi-value expressions") {
+    UniqueCountAggregationResult aggr;
+    aggr.setExpression(createVectorInt(std::vector<double>({3, 5, 7, 5}))).aggregate(DocId(1), HitRank(1));
+    aggr.setExpression(createVectorInt(std::vector<double>({7, 9}))).aggregate(DocId(2), HitRank(1));
+    EXPECT_EQUAL(4, aggr.getEstimatedUniqueCount());
+}
+
+TEST("require that UniqueCountAggregationResult estimates large unique counts") {
+    UniqueCountAggregationResult aggr = createUniqueCount(0, 100000);
+    EXPECT_EQUAL(uint32_t(NormalSketch<>::classId), aggr.getSketch().getClassId());
+    EXPECT_APPROX(100000.0, double(aggr.getEstimatedUniqueCount()), 10000.0);
+    UniqueCountAggregationResult small = createUniqueCount(0, 500);
+    EXPECT_EQUAL(uint32_t(NormalSketch<>::classId), small.getSketch().getClassId());
+    EXPECT_APPROX(500.0, double(small.getEstimatedUniqueCount()), 50.0);
+}
+
+TEST("require that UniqueCountAggregationResult can be merged") {
+    UniqueCountAggregationResult aggr1 = createUniqueCount(0, 100);
+    UniqueCountAggregationResult aggr2 = createUniqueCount(50, 150);
+    EXPECT_EQUAL(100, aggr1.getEstimatedUniqueCount());
+    aggr1.merge(aggr2);
+    EXPECT_EQUAL(150, aggr1.getEstimatedUniqueCount());
+    UniqueCountAggregationResult aggr3 = createUniqueCount(100, 20000);
+    aggr1.merge(aggr3);
+    EXPECT_APPROX(20000.0, double(aggr1.getEstimatedUniqueCount()), 2000.0);
+}
+
+TEST("require that UniqueCountAggregationResult is merged as part of groupings") {
+    Grouping g1;
+    g1.setRoot(Group().addResult(createUniqueCount(0, 100)));
+    Grouping g2;
+    g2.setRoot(Group().addResult(createUniqueCount(50, 150)));
+    g1.merge(g2);
+    const auto &aggr = dynamic_cast<const UniqueCountAggregationResult &>(g1.getRoot().getAggregationResult(0));
+    EXPECT_EQUAL(150, aggr.getEstimatedUniqueCount());
+}
+
+TEST("require that UniqueCountAggregationResult can be serialized") {
+    for (int64_t count : {10, 10000}) {
+        UniqueCountAggregationResult aggr1 = createUniqueCount(0, count);
+        nbostream os;
+        NBOSerializer nos(os);
+        nos << aggr1;
+        Identifiable::UP obj = Identifiable::create(nos);
+        auto *aggr2 = dynamic_cast<UniqueCountAggregationResult *>(obj.get());
+        ASSERT_TRUE(aggr2);
+        EXPECT_TRUE(os.empty());
+        EXPECT_EQUAL(aggr1.getSketch(), aggr2->getSketch());
+        EXPECT_EQUAL(aggr1.getEstimatedUniqueCount(), aggr2->getEstimatedUniqueCount());
+    }
+}
+
 void testAdd(const ResultNode &a, const ResultNode &b, const ResultNode &c) {
     AddFunctionNode func;
     func.appendArg(MU<ConstantNode>(ResultNode::UP(a.clone())))
@@ -1691,6 +1762,7 @@ TEST("testStreamingAll") {
     testStreaming(CountAggregationResult());
     testStreaming(ExpressionCountAggregationResult());
     testStreaming(StandardDeviationAggregationResult());
+    testStreaming(UniqueCountAggregationResult());
     testStreaming(SumAggregationResult());
     testStreaming(MinAggregationResult());
     testStreaming(MaxAggregationResult());
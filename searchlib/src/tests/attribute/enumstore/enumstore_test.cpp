@@ -463,6 +463,117 @@ TEST_F(BatchUpdaterTest, unused_new_value_is_removed)
     expect_value_not_in_store(7, i7);
 }
 
+using TrigramIndex = enumstore::TrigramIndex;
+
+TEST(TrigramIndexTest, trigrams_are_extracted_with_ascii_letters_folded)
+{
+    EXPECT_EQ(TrigramIndex::TrigramVector(), TrigramIndex::extract_trigrams("ab"));
+    EXPECT_EQ(TrigramIndex::extract_trigrams("abcd"), TrigramIndex::extract_trigrams("ABcD"));
+    EXPECT_EQ(2u, TrigramIndex::extract_trigrams("abcd").size());
+    EXPECT_EQ(1u, TrigramIndex::extract_trigrams("aaaaa").size());
+}
+
+TEST(TrigramIndexTest, uncased_query_trigrams_skip_characters_folded_to_non_ascii)
+{
+    std::vector<vespalib::string> literals({"abcd", "xsyz"});
+    EXPECT_EQ(TrigramIndex::extract_trigrams("abcd"), TrigramIndex::extract_query_trigrams(literals, false));
+    EXPECT_EQ(4u, TrigramIndex::extract_query_trigrams(literals, true).size());
+    EXPECT_EQ(TrigramIndex::TrigramVector(), TrigramIndex::extract_query_trigrams({"a\xc3\xa5bc"}, false));
+}
+
+class TrigramIndexTest : public ::testing::Test {
+public:
+    StringEnumStore store;
+    generation_t gen;
+
+    TrigramIndexTest()
+        : store(true, DictionaryConfig(DictionaryConfig::Type::BTREE, DictionaryConfig::Match::UNCASED, true)),
+          gen(1)
+    {
+    }
+
+    EnumIndex insert(const char* value) {
+        auto updater = store.make_batch_updater();
+        EnumIndex idx = updater.insert(value);
+        updater.inc_ref_count(idx);
+        updater.commit();
+        inc_generation();
+        return idx;
+    }
+
+    void remove(EnumIndex idx) {
+        auto updater = store.make_batch_updater();
+        updater.dec_ref_count(idx);
+        updater.commit();
+        inc_generation();
+    }
+
+    void inc_generation() {
+        store.freeze_dictionary();
+        store.transfer_hold_lists(gen);
+        ++gen;
+        store.trim_hold_lists(gen);
+    }
+
+    std::vector<std::string> find(const std::vector<vespalib::string>& literals, size_t max_candidates = 100) {
+        std::vector<EnumIndex> candidates;
+        std::vector<std::string> values;
+        if (!store.get_trigram_index()->find_candidates(TrigramIndex::extract_query_trigrams(literals, false),
+                                                        max_candidates, candidates)) {
+            values.emplace_back("<too many>");
+            return values;
+        }
+        for (auto idx : candidates) {
+            values.emplace_back(store.get_value(idx));
+        }
+        std::sort(values.begin(), values.end());
+        return values;
+    }
+};
+
+TEST_F(TrigramIndexTest, index_is_only_created_when_configured)
+{
+    EXPECT_NE(nullptr, store.get_trigram_index());
+    EXPECT_EQ(nullptr, StringEnumStore(false, DictionaryConfig(DictionaryConfig::Type::BTREE, DictionaryConfig::Match::UNCASED, true)).get_trigram_index());
+    EXPECT_EQ(nullptr, StringEnumStore(true, DictionaryConfig(DictionaryConfig::Type::HASH, DictionaryConfig::Match::UNCASED, true)).get_trigram_index());
+    EXPECT_EQ(nullptr, StringEnumStore(true, DictionaryConfig::Type::BTREE).get_trigram_index());
+}
+
+TEST_F(TrigramIndexTest, candidates_contain_all_trigrams)
+{
+    insert("abcdef");
+    insert("xABCx");
+    insert("bcdxyz");
+    EXPECT_EQ(std::vector<std::string>({"abcdef", "xABCx"}), find({"abc"}));
+    EXPECT_EQ(std::vector<std::string>({"abcdef"}), find({"abc", "def"}));
+    EXPECT_EQ(std::vector<std::string>({"abcdef", "bcdxyz"}), find({"bcd"}));
+    EXPECT_EQ(std::vector<std::string>(), find({"abcxyz"}));
+    EXPECT_EQ(std::vector<std::string>({"<too many>"}), find({"bcd"}, 1));
+}
+
+TEST_F(TrigramIndexTest, removed_values_are_removed_from_index)
+{
+    insert("abcdef");
+    auto idx = insert("abcxyz");
+    EXPECT_EQ(std::vector<std::string>({"abcdef", "abcxyz"}), find({"abc"}));
+    remove(idx);
+    EXPECT_EQ(std::vector<std::string>({"abcdef"}), find({"abc"}));
+    EXPECT_EQ(std::vector<std::string>(), find({"xyz"}));
+}
+
+TEST_F(TrigramIndexTest, index_is_built_when_loading)
+{
+    auto loader = store.make_non_enumerated_loader();
+    loader.insert("abcdef", 1);
+    loader.set_ref_count_for_last_value(1);
+    loader.insert("bcdxyz", 2);
+    loader.set_ref_count_for_last_value(1);
+    loader.build_dictionary();
+    inc_generation();
+    EXPECT_EQ(std::vector<std::string>({"abcdef", "bcdxyz"}), find({"bcd"}));
+    EXPECT_EQ(std::vector<std::string>({"bcdxyz"}), find({"xyz"}));
+}
+
 template <typename EnumStoreT>
 struct LoaderTestValues {
     using EnumStoreType = EnumStoreT;
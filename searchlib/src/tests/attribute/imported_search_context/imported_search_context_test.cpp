@@ -2,6 +2,7 @@
 
 #include <vespa/searchcommon/attribute/search_context_params.h>
 #include <vespa/searchlib/attribute/imported_search_context.h>
+#include <vespa/searchlib/common/compressedbitvector.h>
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
 #include <vespa/searchlib/query/query_term_ucs4.h>
 #include <vespa/searchlib/queryeval/simpleresult.h>
@@ -429,6 +430,21 @@ TEST_F("Bit vector from search cache is used if found", SearchCacheFixture)
     EXPECT_EQUAL(0u, f.document_meta_store->get_read_guard_cnt);
 }
 
+TEST_F("Compressed bit vector from search cache is used if found", SearchCacheFixture)
+{
+    auto entry = makeSearchCacheEntry({2, 6}, f.get_imported_attr()->getNumDocs());
+    auto compressed = std::make_shared<BitVectorSearchCache::Entry>(IDocumentMetaStoreContext::IReadGuard::UP(),
+                                                                    BitVectorSearchCache::CompressedBitVectorSP(CompressedBitVector::create(*entry->bitVector)),
+                                                                    entry->docIdLimit);
+    f.imported_attr->getSearchCache()->insert("5678", std::move(compressed));
+    auto ctx = f.create_context(word_term("5678"));
+    ctx->fetchPostings(queryeval::ExecuteInfo::TRUE);
+    TermFieldMatchData match;
+    auto iter = f.create_strict_iterator(*ctx, match);
+    TEST_DO(f.assertSearch({2, 6}, *iter));
+    EXPECT_EQUAL(0u, f.document_meta_store->get_read_guard_cnt);
+}
+
 void
 assertBitVector(const std::vector<uint32_t> &expDocIds, const BitVector &bitVector)
 {
@@ -16,8 +16,10 @@
 #include <vespa/searchlib/queryeval/hitcollector.h>
 #include <vespa/searchlib/queryeval/simpleresult.h>
 #include <vespa/searchlib/test/searchiteratorverifier.h>
+#include <vespa/vespalib/fuzzy/fuzzy_matcher.h>
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/vespalib/util/compress.h>
+#include <vespa/vespalib/util/regexp.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <set>
 
@@ -233,6 +235,7 @@ private:
     void testCaseInsensitiveSearch(const AttributePtr & ptr);
     void testCaseInsensitiveSearch();
     void testRegexSearch(const AttributePtr & ptr);
+    void testRegexSearchUsingTrigramIndex(const AttributePtr & ptr);
     void testRegexSearch();
 
 
@@ -246,6 +249,7 @@ private:
     void performFuzzySearch(const StringAttribute & vec, const vespalib::string & term,
                              const DocSet & expected, TermType termType);
     void testFuzzySearch(const AttributePtr & ptr);
+    void testFuzzySearchSkipsDictionaryEntries(const AttributePtr & ptr);
     void testFuzzySearch();
 
     // test that search is working after clear doc
@@ -1433,11 +1437,62 @@ SearchContextTest::testCaseInsensitiveSearch()
     }
 }
 
+void
+SearchContextTest::testRegexSearchUsingTrigramIndex(const AttributePtr & ptr)
+{
+    LOG(info, "testRegexSearchUsingTrigramIndex: vector '%s'", ptr->getName().c_str());
+
+    auto & vec = dynamic_cast<StringAttribute &>(*ptr.get());
+
+    // Many unique values where only a few contain the literals of the terms
+    std::vector<vespalib::string> values;
+    for (char a = 'a'; a <= 'z'; ++a) {
+        for (char b = 'a'; b <= 'z'; ++b) {
+            const char value[] = {'x', a, b, 'y', '\0'};
+            values.emplace_back(value);
+        }
+    }
+    values.emplace_back("abc1def");
+    values.emplace_back("ABC2def");
+    values.emplace_back("zabc3defz");
+    values.emplace_back("abc4xyz");
+    uint32_t numDocs = values.size();
+    addDocs(*ptr.get(), numDocs);
+    for (uint32_t doc = 1; doc < numDocs + 1; ++doc) {
+        EXPECT_TRUE(vec.update(doc, values[doc - 1]));
+    }
+    ptr->commit(true);
+
+    uint32_t first = numDocs - 3;
+    DocSet abc_def = DocSet().put(first).put(first + 1).put(first + 2);
+    performSearch(vec, "abc.def", abc_def, TermType::REGEXP);
+    performSearch(vec, "^abc.def$", DocSet().put(first).put(first + 1), TermType::REGEXP);
+    performSearch(vec, "abc[0-9]+xyz", DocSet().put(numDocs), TermType::REGEXP);
+    performSearch(vec, "xaby", DocSet().put(2), TermType::REGEXP);
+    performSearch(vec, "abcdef", DocSet(), TermType::REGEXP);
+    // Substring and suffix terms are searched as regexes
+    performSearch(vec, vespalib::RegexpUtil::make_from_substring("c1d"), DocSet().put(first), TermType::REGEXP);
+    performSearch(vec, vespalib::RegexpUtil::make_from_suffix("xyz"), DocSet().put(numDocs), TermType::REGEXP);
+
+    // Values added and removed after the index was built
+    EXPECT_TRUE(vec.update(1, "abc7def"));
+    EXPECT_TRUE(vec.update(first, "abc8ghi"));
+    ptr->commit(true);
+    performSearch(vec, "abc.def", DocSet().put(1).put(first + 1).put(first + 2), TermType::REGEXP);
+    performSearch(vec, "abc.ghi", DocSet().put(first), TermType::REGEXP);
+    performSearch(vec, "xaay", DocSet(), TermType::REGEXP);
+}
+
 void
 SearchContextTest::testRegexSearch()
 {
     for (const auto & cfg : _stringCfg) {
         testRegexSearch(AttributeFactory::createAttribute(cfg.first, cfg.second));
+        if (cfg.second.fastSearch()) {
+            Config trigram_cfg(cfg.second);
+            trigram_cfg.set_dictionary_config(DictionaryConfig(DictionaryConfig::Type::BTREE, DictionaryConfig::Match::UNCASED, true));
+            testRegexSearchUsingTrigramIndex(AttributeFactory::createAttribute(cfg.first + "-trigram", trigram_cfg));
+        }
     }
 }
 
@@ -1567,11 +1622,50 @@ SearchContextTest::testFuzzySearch(const AttributePtr & ptr)
     }
 }
 
+void
+SearchContextTest::testFuzzySearchSkipsDictionaryEntries(const AttributePtr & ptr)
+{
+    LOG(info, "testFuzzySearchSkipsDictionaryEntries: vector '%s'", ptr->getName().c_str());
+
+    auto & vec = dynamic_cast<StringAttribute &>(*ptr.get());
+
+    // Dictionary with many entries that share no prefix with the term, so
+    // that matching entries are spread out between non-matching ones.
+    std::vector<vespalib::string> values;
+    for (char a = 'a'; a <= 'z'; ++a) {
+        for (char b = 'a'; b <= 'z'; ++b) {
+            const char value[] = {a, b, 'r', 'c', 'h', '\0'};
+            values.emplace_back(value);
+        }
+    }
+    values.emplace_back("SEARCH");
+    values.emplace_back("sarch");
+    values.emplace_back("searches");
+    uint32_t numDocs = values.size();
+    addDocs(*ptr.get(), numDocs);
+    for (uint32_t doc = 1; doc < numDocs + 1; ++doc) {
+        EXPECT_TRUE(vec.update(doc, values[doc - 1]));
+    }
+    ptr->commit(true);
+
+    vespalib::FuzzyMatcher expected_matcher("search", 2, 0, false);
+    DocSet expected;
+    for (uint32_t doc = 1; doc < numDocs + 1; ++doc) {
+        if (expected_matcher.isMatch(values[doc - 1].c_str())) {
+            expected.insert(doc);
+        }
+    }
+    EXPECT_EQUAL(103u, expected.size());
+    performFuzzySearch(vec, "search", expected, TermType::FUZZYTERM);
+    performFuzzySearch(vec, "SEARCH", expected, TermType::FUZZYTERM);
+}
+
 void
 SearchContextTest::testFuzzySearch()
 {
     for (const auto & cfg : _stringCfg) {
         testFuzzySearch(AttributeFactory::createAttribute(cfg.first, cfg.second));
+        testFuzzySearchSkipsDictionaryEntries(AttributeFactory::createAttribute(cfg.first + "-skip", cfg.second));
     }
 }
 
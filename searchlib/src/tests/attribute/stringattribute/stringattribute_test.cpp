@@ -512,4 +512,16 @@ TEST("test fuzzy match") {
     EXPECT_FALSE(helper.isMatch("vvv"));
 }
 
+TEST("test fuzzy match produces dictionary successor") {
+    QueryTermUCS4 xyz("xyz", QueryTermSimple::Type::FUZZYTERM);
+    StringSearchHelper helper(xyz, false);
+    EXPECT_TRUE(helper.hasFuzzyDfa());
+    std::string successor;
+    EXPECT_TRUE(helper.isFuzzyMatch("XYZ", successor));
+    EXPECT_FALSE(helper.isFuzzyMatch("aaa", successor));
+    EXPECT_EQUAL("aaxyz", successor);
+    EXPECT_FALSE(helper.isFuzzyMatch("vvv", successor));
+    EXPECT_EQUAL("vvxyz", successor);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
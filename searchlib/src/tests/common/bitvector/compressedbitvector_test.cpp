@@ -0,0 +1,241 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/common/compressedbitvector.h>
+#include <vespa/searchlib/common/compressedbitvectoriterator.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/log/log.h>
+
+LOG_SETUP("compressedbitvector_test");
+
+using search::BitVector;
+using search::CompressedBitVector;
+using search::CompressedBitVectorIterator;
+using search::fef::TermFieldMatchData;
+using ChunkType = CompressedBitVector::ChunkType;
+
+namespace {
+
+constexpr uint32_t chunk_size = CompressedBitVector::chunk_size;
+
+/*
+ * Bit vector with one sparse chunk, one dense chunk, one chunk with
+ * a few long runs, one empty chunk and a partial last chunk.
+ */
+BitVector::UP
+make_mixed(uint32_t size = 4 * chunk_size + 1000)
+{
+    auto bv = BitVector::create(size);
+    for (uint32_t i = 1; i < chunk_size; i += 1000) {
+        bv->setBit(i);
+    }
+    for (uint32_t i = chunk_size; i < 2 * chunk_size; i += 3) {
+        bv->setBit(i);
+    }
+    bv->setInterval(2 * chunk_size + 100, 2 * chunk_size + 20000);
+    bv->setInterval(2 * chunk_size + 30000, 3 * chunk_size);
+    for (uint32_t i = 4 * chunk_size; i < size; i += 7) {
+        bv->setBit(i);
+    }
+    bv->invalidateCachedCount();
+    return bv;
+}
+
+std::vector<uint32_t>
+true_bits(const BitVector &bv, uint32_t start = 0, uint32_t end = std::numeric_limits<uint32_t>::max())
+{
+    std::vector<uint32_t> result;
+    bv.foreach_truebit([&](uint32_t idx) { result.push_back(idx); }, start, std::min(end, bv.size()));
+    return result;
+}
+
+std::vector<uint32_t>
+true_bits(const CompressedBitVector &cbv, uint32_t start = 0, uint32_t end = std::numeric_limits<uint32_t>::max())
+{
+    std::vector<uint32_t> result;
+    cbv.foreach_truebit([&](uint32_t idx) { result.push_back(idx); }, start, end);
+    return result;
+}
+
+void
+assert_equal(const BitVector &bv, const CompressedBitVector &cbv)
+{
+    EXPECT_EQUAL(bv.size(), cbv.size());
+    EXPECT_EQUAL(bv.countTrueBits(), cbv.countTrueBits());
+    for (uint32_t i = 0; i < bv.size(); ++i) {
+        if (bv.testBit(i) != cbv.testBit(i)) {
+            TEST_ERROR(vespalib::make_string("bit %u differs", i).c_str());
+            return;
+        }
+    }
+    EXPECT_TRUE(true_bits(bv) == true_bits(cbv));
+}
+
+}
+
+TEST("require that chunk types are selected by density")
+{
+    auto bv = make_mixed();
+    auto cbv = CompressedBitVector::create(*bv);
+    EXPECT_EQUAL(5u, cbv->numChunks());
+    EXPECT_TRUE(ChunkType::ARRAY == cbv->getChunkType(0));
+    EXPECT_TRUE(ChunkType::BITMAP == cbv->getChunkType(1));
+    EXPECT_TRUE(ChunkType::RUN == cbv->getChunkType(2));
+    EXPECT_TRUE(ChunkType::ARRAY == cbv->getChunkType(3));
+    TEST_DO(assert_equal(*bv, *cbv));
+    EXPECT_FALSE(cbv->testBit(cbv->size()));
+}
+
+TEST("require that sparse bit vectors are compact")
+{
+    auto bv = BitVector::create(10 * chunk_size);
+    for (uint32_t i = 0; i < bv->size(); i += 997) {
+        bv->setBit(i);
+    }
+    bv->invalidateCachedCount();
+    auto cbv = CompressedBitVector::createIfCompact(*bv);
+    ASSERT_TRUE(cbv);
+    EXPECT_LESS(cbv->sizeBytes() * 4, bv->getFileBytes());
+    TEST_DO(assert_equal(*bv, *cbv));
+    auto mixed = make_mixed();
+    EXPECT_FALSE(CompressedBitVector::createIfCompact(*mixed));
+}
+
+TEST("require that next true and false bits are found")
+{
+    auto bv = make_mixed();
+    auto cbv = CompressedBitVector::create(*bv);
+    for (uint32_t i = 0; i < bv->size(); i += 13) {
+        EXPECT_EQUAL(bv->getNextTrueBit(i), cbv->getNextTrueBit(i));
+        EXPECT_EQUAL(bv->getNextFalseBit(i), cbv->getNextFalseBit(i));
+    }
+    EXPECT_EQUAL(cbv->size(), cbv->getNextTrueBit(cbv->size() - 5));
+}
+
+TEST("require that true bits can be iterated in a range")
+{
+    auto bv = make_mixed();
+    auto cbv = CompressedBitVector::create(*bv);
+    EXPECT_TRUE(true_bits(*bv, 500, chunk_size + 500) == true_bits(*cbv, 500, chunk_size + 500));
+    EXPECT_TRUE(true_bits(*bv, 2 * chunk_size + 150, 2 * chunk_size + 35000) ==
+                true_bits(*cbv, 2 * chunk_size + 150, 2 * chunk_size + 35000));
+    EXPECT_TRUE(true_bits(*bv, 3 * chunk_size + 5) == true_bits(*cbv, 3 * chunk_size + 5));
+}
+
+TEST("require that dense words can be decoded")
+{
+    auto bv = make_mixed();
+    auto cbv = CompressedBitVector::create(*bv);
+    uint32_t num_words = (bv->size() + 63) / 64;
+    for (uint32_t word_idx = 0; word_idx < num_words + 8; word_idx += 5) {
+        uint64_t words[8];
+        cbv->getWords(word_idx, 8, words);
+        for (uint32_t i = 0; i < 8; ++i) {
+            uint64_t expected = 0;
+            for (uint32_t bit = 0; bit < 64; ++bit) {
+                uint64_t idx = uint64_t(word_idx + i) * 64 + bit;
+                if (idx < bv->size() && bv->testBit(idx)) {
+                    expected |= (uint64_t(1) << bit);
+                }
+            }
+            EXPECT_EQUAL(expected, words[i]);
+        }
+    }
+}
+
+TEST("require that compressed bit vector can be combined into partial bit vector")
+{
+    auto bv = make_mixed();
+    auto cbv = CompressedBitVector::create(*bv);
+    uint32_t begin = chunk_size - 77;
+    uint32_t end = 3 * chunk_size + 33;
+    auto other = BitVector::create(begin, end);
+    for (uint32_t i = begin; i < end; i += 2) {
+        other->setBit(i);
+    }
+    auto or_result = BitVector::create(*other, begin, end);
+    auto and_result = BitVector::create(*other, begin, end);
+    auto and_not_result = BitVector::create(*other, begin, end);
+    cbv->orInto(*or_result);
+    cbv->andInto(*and_result);
+    cbv->andNotInto(*and_not_result);
+    for (uint32_t i = begin; i < end; ++i) {
+        bool a = bv->testBit(i);
+        bool b = other->testBit(i);
+        EXPECT_EQUAL(a || b, or_result->testBit(i));
+        EXPECT_EQUAL(a && b, and_result->testBit(i));
+        EXPECT_EQUAL(!a && b, and_not_result->testBit(i));
+    }
+}
+
+TEST("require that compressed bit vectors can be combined")
+{
+    auto a = make_mixed();
+    auto b = BitVector::create(a->size());
+    for (uint32_t i = 0; i < b->size(); i += 5) {
+        b->setBit(i);
+    }
+    b->invalidateCachedCount();
+    auto ca = CompressedBitVector::create(*a);
+    auto cb = CompressedBitVector::create(*b);
+    auto and_result = CompressedBitVector::createAnd(*ca, *cb);
+    auto or_result = CompressedBitVector::createOr(*ca, *cb);
+    auto expected_and = BitVector::create(*a);
+    expected_and->andWith(*b);
+    expected_and->invalidateCachedCount();
+    auto expected_or = BitVector::create(*a);
+    expected_or->orWith(*b);
+    expected_or->invalidateCachedCount();
+    TEST_DO(assert_equal(*expected_and, *and_result));
+    TEST_DO(assert_equal(*expected_or, *or_result));
+    EXPECT_TRUE(true_bits(*a) == true_bits(*ca->createBitVector()));
+}
+
+void
+verify_iterator(const BitVector &bv, const CompressedBitVector &cbv, bool strict, bool inverted)
+{
+    TermFieldMatchData tfmd;
+    auto itr = CompressedBitVectorIterator::create(&cbv, cbv.size(), tfmd, strict, inverted);
+    EXPECT_TRUE(itr->isCompressedBitVector());
+    itr->initRange(1, cbv.size());
+    std::vector<uint32_t> expected;
+    for (uint32_t i = 1; i < bv.size(); ++i) {
+        if (bv.testBit(i) != inverted) {
+            expected.push_back(i);
+        }
+    }
+    std::vector<uint32_t> actual;
+    if (strict) {
+        while (!itr->isAtEnd()) {
+            actual.push_back(itr->getDocId());
+            itr->seek(itr->getDocId() + 1);
+        }
+    } else {
+        for (uint32_t i = 1; i < cbv.size(); ++i) {
+            if (itr->seek(i)) {
+                actual.push_back(i);
+            }
+        }
+    }
+    EXPECT_TRUE(expected == actual);
+    itr->initRange(1, cbv.size());
+    auto hits = itr->get_hits(1);
+    hits->invalidateCachedCount();
+    EXPECT_EQUAL(expected.size(), hits->countTrueBits());
+    EXPECT_TRUE(expected == true_bits(*hits));
+}
+
+TEST("require that compressed bit vector iterator finds all hits")
+{
+    auto bv = make_mixed(3 * chunk_size);
+    auto cbv = CompressedBitVector::create(*bv);
+    for (bool strict : {false, true}) {
+        for (bool inverted : {false, true}) {
+            TEST_STATE(vespalib::make_string("strict=%d, inverted=%d", strict, inverted).c_str());
+            TEST_DO(verify_iterator(*bv, *cbv, strict, inverted));
+        }
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,84 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/log/log.h>
+LOG_SETUP("chunk_compression_benchmark");
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/searchlib/docstore/chunk.h>
+#include <vespa/searchlib/test/docstore_test_utils.h>
+#include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
+
+using namespace search;
+using vespalib::compression::CompressionConfig;
+using vespalib::compression::ZStdDictionary;
+using search::test::makeDocument;
+using search::test::trainDictionary;
+
+namespace {
+
+constexpr uint32_t NumChunks = 200;
+constexpr uint32_t DocsPerChunk = 4;
+
+struct PackedChunks {
+    std::vector<vespalib::DataBuffer> buffers;
+    size_t rawBytes;
+    size_t packedBytes;
+    PackedChunks() : buffers(), rawBytes(0), packedBytes(0) {}
+};
+
+PackedChunks
+packChunks(CompressionConfig::Type type, const ZStdDictionary * dictionary)
+{
+    // Small chunks of a few documents each, which is where a shared dictionary matters most
+    PackedChunks result;
+    for (uint32_t chunkId(0); chunkId < NumChunks; chunkId++) {
+        Chunk chunk(chunkId, Chunk::Config(64_Ki));
+        for (uint32_t i(0); i < DocsPerChunk; i++) {
+            uint32_t lid = chunkId * DocsPerChunk + i + 1;
+            vespalib::string doc = makeDocument(lid);
+            chunk.append(lid, doc.data(), doc.size());
+            result.rawBytes += doc.size();
+        }
+        result.buffers.emplace_back();
+        chunk.pack(1, result.buffers.back(), CompressionConfig(type, 3, 100), dictionary);
+        result.packedBytes += result.buffers.back().getDataLen();
+    }
+    return result;
+}
+
+size_t
+unpackChunks(const PackedChunks & packed, const ZStdDictionary * dictionary)
+{
+    size_t count(0);
+    for (const auto & buffer : packed.buffers) {
+        Chunk chunk(0, buffer.getData(), buffer.getDataLen(), false, dictionary);
+        count += chunk.count();
+    }
+    return count;
+}
+
+void
+benchmark(const char * name, CompressionConfig::Type type, const ZStdDictionary * dictionary)
+{
+    PackedChunks packed = packChunks(type, dictionary);
+    size_t count(0);
+    double minTime = vespalib::BenchmarkTimer::benchmark([&]() { count = unpackChunks(packed, dictionary); }, 1.0);
+    EXPECT_EQUAL(NumChunks * DocsPerChunk, count);
+    fprintf(stderr, "%-10s: ratio %5.2f, %8zu -> %8zu bytes, decode %8.1f MB/s\n", name,
+            double(packed.rawBytes) / double(packed.packedBytes), packed.rawBytes, packed.packedBytes,
+            double(packed.rawBytes) / (minTime * 1e6));
+}
+
+}
+
+TEST("compression ratio and decode speed for small chunks with lz4, zstd and zstd with dictionary") {
+    auto dictionary = trainDictionary(100000, 10000, 16_Ki);
+    ASSERT_TRUE(dictionary);
+    benchmark("lz4", CompressionConfig::LZ4, nullptr);
+    benchmark("zstd", CompressionConfig::ZSTD, nullptr);
+    benchmark("zstd+dict", CompressionConfig::ZSTD, dictionary.get());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
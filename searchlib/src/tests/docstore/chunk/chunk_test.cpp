@@ -6,14 +6,19 @@
 #include <vespa/searchlib/docstore/chunk.h>
 #include <vespa/searchlib/docstore/chunkformat.h>
 #include <vespa/searchlib/docstore/chunkformats.h>
+#include <vespa/searchlib/test/docstore_test_utils.h>
 #include <vespa/vespalib/objects/hexdump.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <zstd.h>
 
 LOG_SETUP("chunk_test");
 
 using namespace search;
 using vespalib::compression::CompressionConfig;
+using vespalib::compression::ZStdDictionary;
+using search::test::makeDocument;
+using search::test::trainDictionary;
 
 TEST("require that Chunk obey limits")
 {
@@ -100,4 +105,94 @@ TEST("require that V2 can create and handle lz4, zstd, and none") {
     verifyChunkCompression(CompressionConfig::ZSTD, MY_LONG_STRING, strlen(MY_LONG_STRING), zstd_compressed_length);
 }
 
+TEST("require that chunk can be compressed with zstd dictionary") {
+    auto dictionary = trainDictionary(10000, 2000, 4096);
+    ASSERT_TRUE(dictionary);
+    // A chunk can only be packed once
+    Chunk chunk(0, Chunk::Config(4096));
+    Chunk plainChunk(0, Chunk::Config(4096));
+    for (uint32_t lid(1); lid <= 5; lid++) {
+        vespalib::string doc = makeDocument(lid);
+        chunk.append(lid, doc.data(), doc.size());
+        plainChunk.append(lid, doc.data(), doc.size());
+    }
+    CompressionConfig cfg(CompressionConfig::ZSTD);
+    vespalib::DataBuffer plain;
+    vespalib::DataBuffer withDictionary;
+    plainChunk.pack(7, plain, cfg);
+    chunk.pack(7, withDictionary, cfg, dictionary.get());
+    EXPECT_LESS(withDictionary.getDataLen(), plain.getDataLen());
+
+    Chunk deserialized(0, withDictionary.getData(), withDictionary.getDataLen(), false, dictionary.get());
+    EXPECT_EQUAL(7u, deserialized.getLastSerial());
+    for (uint32_t lid(1); lid <= 5; lid++) {
+        vespalib::string doc = makeDocument(lid);
+        vespalib::ConstBufferRef buf = deserialized.getLid(lid);
+        EXPECT_EQUAL(doc, vespalib::string(buf.c_str(), buf.size()));
+    }
+    // Chunks compressed without a dictionary can still be read when a dictionary is given
+    Chunk fromPlain(0, plain.getData(), plain.getDataLen(), false, dictionary.get());
+    EXPECT_EQUAL(5u, fromPlain.count());
+}
+
+TEST("require that chunk compressed with zstd dictionary can not be read without the same dictionary") {
+    auto dictionary = trainDictionary(10000, 2000, 4096);
+    auto other = trainDictionary(20000, 1000, 4096);
+    ASSERT_TRUE(dictionary && other);
+    ASSERT_NOT_EQUAL(dictionary->getId(), other->getId());
+    Chunk chunk(0, Chunk::Config(4096));
+    vespalib::string doc = makeDocument(1);
+    chunk.append(1, doc.data(), doc.size());
+    vespalib::DataBuffer buffer;
+    chunk.pack(7, buffer, CompressionConfig(CompressionConfig::ZSTD), dictionary.get());
+    EXPECT_EXCEPTION(Chunk(0, buffer.getData(), buffer.getDataLen()), ChunkException, "not available");
+    EXPECT_EXCEPTION(Chunk(0, buffer.getData(), buffer.getDataLen(), false, other.get()), ChunkException, "not available");
+}
+
+namespace {
+
+// Version, magic, length, compression type and uncompressed length precede the compressed data.
+constexpr size_t CompressedDataOffset = 1 + 4 + 4 + 1 + 4;
+constexpr size_t CrcSize = 4;
+
+uint32_t
+getDictionaryId(const vespalib::DataBuffer & buffer)
+{
+    return ZStdDictionary::getFrameDictionaryId(buffer.getData() + CompressedDataOffset,
+                                                buffer.getDataLen() - CompressedDataOffset - CrcSize);
+}
+
+}
+
+TEST("require that dictionary id is stored in the zstd frame header of the chunk") {
+    auto dictionary = trainDictionary(10000, 2000, 4096);
+    ASSERT_TRUE(dictionary);
+    EXPECT_NOT_EQUAL(0u, dictionary->getId());
+    Chunk chunk(0, Chunk::Config(4096));
+    Chunk plainChunk(0, Chunk::Config(4096));
+    vespalib::string doc = makeDocument(1);
+    chunk.append(1, doc.data(), doc.size());
+    plainChunk.append(1, doc.data(), doc.size());
+    vespalib::DataBuffer withDictionary;
+    vespalib::DataBuffer plain;
+    chunk.pack(7, withDictionary, CompressionConfig(CompressionConfig::ZSTD), dictionary.get());
+    plainChunk.pack(7, plain, CompressionConfig(CompressionConfig::ZSTD));
+    EXPECT_EQUAL(CompressionConfig::ZSTD, CompressionConfig::Type(withDictionary.getData()[CompressedDataOffset - 5]));
+    EXPECT_EQUAL(dictionary->getId(), getDictionaryId(withDictionary));
+    EXPECT_EQUAL(0u, getDictionaryId(plain));
+}
+
+TEST("require that zstd dictionary is ignored for other compression types") {
+    auto dictionary = trainDictionary(10000, 2000, 4096);
+    ASSERT_TRUE(dictionary);
+    Chunk chunk(0, Chunk::Config(4096));
+    vespalib::string doc = makeDocument(1);
+    chunk.append(1, doc.data(), doc.size());
+    vespalib::DataBuffer buffer;
+    chunk.pack(7, buffer, CompressionConfig(CompressionConfig::LZ4), dictionary.get());
+    Chunk deserialized(0, buffer.getData(), buffer.getDataLen());
+    vespalib::ConstBufferRef buf = deserialized.getLid(1);
+    EXPECT_EQUAL(doc, vespalib::string(buf.c_str(), buf.size()));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
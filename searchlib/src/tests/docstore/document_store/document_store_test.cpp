@@ -4,7 +4,9 @@
 #include <vespa/searchlib/docstore/value.h>
 #include <vespa/vespalib/stllike/cache_stats.h>
 #include <vespa/document/repo/documenttyperepo.h>
+#include <vespa/document/datatype/documenttype.h>
 #include <vespa/document/fieldvalue/document.h>
+#include <vespa/vespalib/objects/nbostream.h>
 
 using namespace search;
 using CompressionConfig = vespalib::compression::CompressionConfig;
@@ -67,6 +69,64 @@ TEST_FFF("require that cached docstore lookups are counted",
     EXPECT_EQUAL(1u, f3.getCacheStats().misses);
 }
 
+struct BatchDataStore : NullDataStore {
+    vespalib::nbostream blob;
+    mutable size_t batch_reads;
+    BatchDataStore();
+    ~BatchDataStore() override;
+    void read(const LidVector &lids, IBufferVisitor &visitor) const override {
+        ++batch_reads;
+        for (uint32_t lid : lids) {
+            visitor.visit(lid, vespalib::ConstBufferRef(blob.peek(), blob.size()));
+        }
+    }
+    bool readsInBatches() const override { return true; }
+};
+
+BatchDataStore::BatchDataStore()
+    : NullDataStore(),
+      blob(),
+      batch_reads(0)
+{
+    document::Document doc(*repo.getDefaultDocType(), document::DocumentId("id:ns:document::1"));
+    doc.serialize(blob);
+}
+
+BatchDataStore::~BatchDataStore() = default;
+
+struct CollectingVisitor : IDocumentVisitor {
+    std::vector<uint32_t> lids;
+    void visit(uint32_t lid, IDocumentStore::DocumentUP doc) override {
+        if (doc) {
+            lids.push_back(lid);
+        }
+    }
+    bool allowVisitCaching() const override { return false; }
+};
+
+TEST_FFF("require that batch read documents are added to the cache",
+         DocumentStore::Config(CompressionConfig::NONE, 100000, 100),
+         BatchDataStore(), DocumentStore(f1, f2))
+{
+    EXPECT_TRUE(f3.readsInBatches());
+    CollectingVisitor visitor;
+    f3.readBatch({1, 2}, repo, visitor);
+    EXPECT_EQUAL(2u, visitor.lids.size());
+    EXPECT_EQUAL(1u, f2.batch_reads);
+    EXPECT_EQUAL(2u, f3.getCacheStats().elements);
+    f3.readBatch({1, 2}, repo, visitor);
+    EXPECT_EQUAL(4u, visitor.lids.size());
+    EXPECT_EQUAL(1u, f2.batch_reads);
+    EXPECT_EQUAL(2u, f3.getCacheStats().hits);
+}
+
+TEST_FFF("require that docstore does not read in batches by default",
+         DocumentStore::Config(CompressionConfig::NONE, 100000, 100),
+         NullDataStore(), DocumentStore(f1, f2))
+{
+    EXPECT_FALSE(f3.readsInBatches());
+}
+
 TEST("require that DocumentStore::Config equality operator detects inequality") {
     using C = DocumentStore::Config;
     EXPECT_TRUE(C() == C());
@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/searchlib/docstore/visitcache.h>
+#include <vespa/searchlib/test/docstore_test_utils.h>
 
 using namespace search;
 using namespace search::docstore;
@@ -67,4 +68,21 @@ TEST("require that BlobSet can be built") {
     verifyAB(b);
 }
 
+TEST("require that CompressedBlobSet can be compressed with a zstd dictionary") {
+    using CompressionConfig = vespalib::compression::CompressionConfig;
+    BlobSet a;
+    for (uint32_t lid = 1; lid < 10; ++lid) {
+        vespalib::string doc = search::test::makeDocument(lid);
+        a.append(lid, B(doc.data(), doc.size()));
+    }
+    CompressionConfig cfg(CompressionConfig::ZSTD);
+    CompressedBlobSet plain(cfg, a);
+    CompressedBlobSet ca(cfg, a, search::test::trainDictionary(10000, 2000, 4096));
+    EXPECT_LESS(ca.size(), plain.size());
+    BlobSet b = ca.getBlobSet();
+    EXPECT_EQUAL(a.getPositions().size(), b.getPositions().size());
+    EXPECT_EQUAL(vespalib::string(a.getBuffer().c_str(), a.getBuffer().size()),
+                 vespalib::string(b.getBuffer().c_str(), b.getBuffer().size()));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -2,13 +2,16 @@
 
 #include <vespa/searchlib/common/fileheadercontext.h>
 #include <vespa/searchlib/docstore/filechunk.h>
+#include <vespa/searchlib/docstore/randreaders.h>
 #include <vespa/searchlib/docstore/writeablefilechunk.h>
 #include <vespa/searchlib/test/directory_handler.h>
 #include <vespa/vespalib/test/insertion_operators.h>
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/util/cpu_usage.h>
 #include <vespa/vespalib/util/compressionconfig.h>
+#include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
+#include <vespa/fastos/file.h>
 #include <iomanip>
 #include <iostream>
 
@@ -250,5 +253,62 @@ TEST("require that operator == detects inequality") {
     EXPECT_FALSE(C({CompressionConfig::LZ4, 9, 60}, 2) == C({}, 2));
 }
 
+TEST("require that io_uring reader returns same data as normal reader for a batch of reads") {
+    test::DirectoryHandler dir("tmp");
+    vespalib::string fileName("tmp/randread.dat");
+    std::vector<char> data(0x30000);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = char(i * 31 + (i >> 8));
+    }
+    {
+        FastOS_File file(fileName.c_str());
+        ASSERT_TRUE(file.OpenWriteOnlyTruncate());
+        file.WriteBuf(data.data(), data.size());
+        ASSERT_TRUE(file.Close());
+    }
+    IoUringRandRead ioUring(fileName);
+    NormalRandRead normal(fileName);
+    EXPECT_EQUAL(normal.getSize(), ioUring.getSize());
+    std::vector<std::pair<size_t, size_t>> ranges = {{0, 100}, {0x1000, 0x2000}, {77, 1}, {0x2ff00, 0x100},
+                                                     {0x10000, 0x20000}, {12345, 4321}};
+    // More reads than fit in a single submission
+    for (size_t i = 0; i < 200; ++i) {
+        ranges.emplace_back((i * 997) % 0x2fe00, 1 + (i * 13) % 512);
+    }
+    std::vector<vespalib::DataBuffer> buffers(ranges.size());
+    std::vector<FileRandRead::ReadRequest> requests;
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        requests.emplace_back(ranges[i].first, ranges[i].second, buffers[i]);
+    }
+    ioUring.readBatch(requests);
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        vespalib::DataBuffer expected;
+        normal.read(ranges[i].first, expected, ranges[i].second);
+        ASSERT_EQUAL(ranges[i].second, buffers[i].getDataLen());
+        EXPECT_EQUAL(0, memcmp(expected.getData(), buffers[i].getData(), ranges[i].second));
+        EXPECT_EQUAL(0, memcmp(data.data() + ranges[i].first, buffers[i].getData(), ranges[i].second));
+    }
+}
+
+TEST("require that default batch read performs each read") {
+    test::DirectoryHandler dir("tmp");
+    vespalib::string fileName("tmp/randread.dat");
+    vespalib::string data("0123456789abcdef");
+    {
+        FastOS_File file(fileName.c_str());
+        ASSERT_TRUE(file.OpenWriteOnlyTruncate());
+        file.WriteBuf(data.data(), data.size());
+        ASSERT_TRUE(file.Close());
+    }
+    NormalRandRead normal(fileName);
+    std::vector<vespalib::DataBuffer> buffers(2);
+    std::vector<FileRandRead::ReadRequest> requests;
+    requests.emplace_back(10, 6, buffers[0]);
+    requests.emplace_back(2, 3, buffers[1]);
+    normal.readBatch(requests);
+    EXPECT_EQUAL("abcdef", vespalib::string(buffers[0].getData(), buffers[0].getDataLen()));
+    EXPECT_EQUAL("234", vespalib::string(buffers[1].getData(), buffers[1].getDataLen()));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
 
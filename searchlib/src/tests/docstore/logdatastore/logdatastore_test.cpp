@@ -12,12 +12,18 @@
 #include <vespa/searchlib/docstore/visitcache.h>
 #include <vespa/searchlib/index/dummyfileheadercontext.h>
 #include <vespa/searchlib/test/directory_handler.h>
+#include <vespa/searchlib/test/docstore_test_utils.h>
+#include <vespa/fastos/file.h>
+#include <vespa/vespalib/data/fileheader.h>
+#include <vespa/vespalib/encoding/base64.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/stllike/cache_stats.h>
 #include <vespa/vespalib/test/insertion_operators.h>
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/util/size_literals.h>
+#include <filesystem>
+#include <map>
 #include <iomanip>
 
 using document::BucketId;
@@ -1026,6 +1032,229 @@ TEST_F("require that lid space can be shrunk only after read guards are deleted"
     EXPECT_EQUAL(8u, f.store.getEstimatedShrinkLidSpaceGain());
 }
 
+struct CollectingVisitor : public IBufferVisitor {
+    std::map<uint32_t, vespalib::string> docs;
+    void visit(uint32_t lid, vespalib::ConstBufferRef buf) override {
+        docs[lid] = vespalib::string(buf.c_str(), buf.size());
+    }
+};
+
+vespalib::string
+makeIncompressibleDocument(uint32_t lid, size_t size)
+{
+    vespalib::string doc(size, '\0');
+    uint64_t state = lid;
+    for (char & c : doc) {
+        state = state * 6364136223846793005ul + 1442695040888963407ul;
+        c = char(state >> 56);
+    }
+    return doc;
+}
+
+TEST("require that reading more lids than fit in one batch with io_uring gives all documents")
+{
+    DirectoryHandler dir("iouring");
+    DummyFileHeaderContext fileHeaderContext;
+    vespalib::ThreadStackExecutor executor(1, 128_Ki);
+    MyTlSyncer tlSyncer;
+    TuneFileSummary tune;
+    tune._randRead.setWantIoUring();
+    LogDataStore datastore(executor, dir.getDir(), LogDataStore::Config(), GrowStrategy(),
+                           tune, fileHeaderContext, tlSyncer, nullptr);
+    EXPECT_TRUE(datastore.readsInBatches());
+    // 16MiB in chunks of 64KiB, while at most 4MiB is read in one batch.
+    IDataStore::LidVector lids;
+    for (uint32_t lid = 1; lid <= 2048; ++lid) {
+        vespalib::string doc = makeIncompressibleDocument(lid, 8_Ki);
+        datastore.write(lid, lid, doc.data(), doc.size());
+        lids.push_back(lid);
+    }
+    datastore.initFlush(2048);
+    datastore.flush(2048);
+    CollectingVisitor visitor;
+    datastore.read(lids, visitor);
+    ASSERT_EQUAL(lids.size(), visitor.docs.size());
+    for (uint32_t lid : lids) {
+        if (!EXPECT_EQUAL(makeIncompressibleDocument(lid, 8_Ki), visitor.docs[lid])) {
+            break;
+        }
+    }
+}
+
+LogDataStore::Config
+getDictionaryConfig(size_t maxFileSize, size_t maxDictionaryBytes)
+{
+    return LogDataStore::Config().setMaxFileSize(maxFileSize)
+            .setFileConfig(WriteableFileChunk::Config({CompressionConfig::ZSTD, 3, 100}, 4_Ki, maxDictionaryBytes));
+}
+
+struct DictionaryFixture {
+    vespalib::ThreadStackExecutor executor;
+    search::test::DirectoryHandler dir;
+    DummyFileHeaderContext fileHeaderCtx;
+    MyTlSyncer tlSyncer;
+    LogDataStore store;
+    uint64_t serialNum;
+
+    DictionaryFixture(size_t maxDictionaryBytes, size_t maxFileSize = 64_Mi, bool dirCleanup = true)
+        : executor(1, 0x20000),
+          dir("dictionary"),
+          fileHeaderCtx(),
+          tlSyncer(),
+          store(executor, "dictionary", getDictionaryConfig(maxFileSize, maxDictionaryBytes), GrowStrategy(),
+                TuneFileSummary(), fileHeaderCtx, tlSyncer, nullptr),
+          serialNum(store.lastSyncToken() + 1)
+    {
+        dir.cleanup(dirCleanup);
+    }
+    ~DictionaryFixture();
+    void flush() {
+        store.initFlush(serialNum);
+        store.flush(serialNum);
+    }
+    void write(uint32_t lid) {
+        vespalib::string doc = search::test::makeDocument(lid);
+        store.write(serialNum++, lid, doc.data(), doc.size());
+    }
+    void write(uint32_t startLid, uint32_t endLid) {
+        for (uint32_t lid = startLid; lid < endLid; ++lid) {
+            write(lid);
+        }
+    }
+    uint32_t writeUntilNewFile(uint32_t startLid) {
+        size_t numFiles = store.getFileChunkStats().size();
+        for (uint32_t lid = startLid; ; ++lid) {
+            write(lid);
+            // The dictionary is trained on the executor, and is used from the first write after it is ready.
+            executor.sync();
+            if (store.getFileChunkStats().size() > numFiles) {
+                return lid;
+            }
+        }
+    }
+    void assertContent(uint32_t startLid, uint32_t endLid) {
+        for (uint32_t lid = startLid; lid < endLid; ++lid) {
+            vespalib::DataBuffer buffer;
+            store.read(lid, buffer);
+            if (!EXPECT_EQUAL(search::test::makeDocument(lid), vespalib::string(buffer.getData(), buffer.getDataLen()))) {
+                break;
+            }
+        }
+    }
+    // Id of the dictionary stored in the header of each .dat file, 0 if none.
+    std::vector<uint32_t> dictionaryIdsInFiles() const {
+        std::vector<vespalib::string> names;
+        for (const auto &entry : std::filesystem::directory_iterator("dictionary")) {
+            if (entry.path().extension() == ".dat") {
+                names.push_back(entry.path().string());
+            }
+        }
+        std::sort(names.begin(), names.end());
+        std::vector<uint32_t> result;
+        for (const auto &name : names) {
+            FastOS_File file(name.c_str());
+            ASSERT_TRUE(file.OpenReadOnly());
+            vespalib::FileHeader header;
+            header.readFile(file);
+            uint32_t id = 0;
+            if (header.hasTag("compression.zstd.dictionary")) {
+                std::string content = vespalib::Base64::decode(header.getTag("compression.zstd.dictionary").asString());
+                id = vespalib::compression::ZStdDictionary(vespalib::ConstBufferRef(content.data(), content.size())).getId();
+            }
+            result.push_back(id);
+        }
+        return result;
+    }
+};
+
+DictionaryFixture::~DictionaryFixture() = default;
+
+TEST("require that documents are sampled until a dictionary can be trained and the file is rotated")
+{
+    constexpr size_t maxDictionaryBytes = 1_Ki;
+    DictionaryFixture f(maxDictionaryBytes);
+    uint32_t rotatedAt = f.writeUntilNewFile(1);
+    // Samples of 100 times the dictionary size are needed for training.
+    // The file is rotated by the first write after training is done.
+    size_t sampledBytes = 0;
+    for (uint32_t lid = 1; (lid + 1) < rotatedAt; ++lid) {
+        sampledBytes += search::test::makeDocument(lid).size();
+    }
+    EXPECT_LESS(sampledBytes, 100 * maxDictionaryBytes);
+    EXPECT_GREATER_EQUAL(sampledBytes + search::test::makeDocument(rotatedAt - 1).size(), 100 * maxDictionaryBytes);
+    f.flush();
+    std::vector<uint32_t> ids = f.dictionaryIdsInFiles();
+    ASSERT_EQUAL(2u, ids.size());
+    EXPECT_EQUAL(0u, ids[0]);
+    EXPECT_NOT_EQUAL(0u, ids[1]);
+
+    // The dictionary is only trained once, so the file is not rotated again.
+    f.write(rotatedAt + 1, 3 * rotatedAt);
+    f.flush();
+    EXPECT_EQUAL(2u, f.store.getFileChunkStats().size());
+    TEST_DO(f.assertContent(1, 3 * rotatedAt));
+}
+
+TEST("require that visit cache compresses with the dictionary of the store")
+{
+    DictionaryFixture f(1_Ki);
+    uint32_t endLid = f.writeUntilNewFile(1) + 1;
+    EXPECT_TRUE(f.store.getDictionary());
+    VisitCache visitCache(f.store, 1_Mi, CompressionConfig::ZSTD);
+    CompressedBlobSet cbs = visitCache.read({1, 2, 3});
+    BlobSet bs(cbs.getBlobSet());
+    EXPECT_LESS(cbs.size(), CompressedBlobSet(CompressionConfig::ZSTD, bs).size());
+    for (uint32_t lid : {1u, 2u, 3u}) {
+        EXPECT_EQUAL(search::test::makeDocument(lid), vespalib::string(bs.get(lid).c_str(), bs.get(lid).size()));
+    }
+    TEST_DO(f.assertContent(1, endLid));
+}
+
+TEST("require that no documents are sampled when dictionary is disabled")
+{
+    DictionaryFixture f(0);
+    f.write(1, 2000);
+    f.flush();
+    EXPECT_EQUAL(1u, f.store.getFileChunkStats().size());
+    EXPECT_EQUAL(std::vector<uint32_t>({0u}), f.dictionaryIdsInFiles());
+}
+
+TEST("require that files written with an earlier dictionary are read after restart")
+{
+    uint32_t endLid = 0;
+    uint32_t dictionaryId = 0;
+    {
+        DictionaryFixture f(1_Ki, 64_Mi, false);
+        endLid = f.writeUntilNewFile(1) + 100;
+        f.write(endLid - 99, endLid);
+        f.flush();
+        dictionaryId = f.dictionaryIdsInFiles().back();
+        EXPECT_NOT_EQUAL(0u, dictionaryId);
+    }
+    {
+        // New files use the dictionary found when loading, without training a new one.
+        DictionaryFixture f(1_Ki, 32_Ki, false);
+        TEST_DO(f.assertContent(1, endLid));
+        uint32_t lid = f.writeUntilNewFile(endLid);
+        endLid = f.writeUntilNewFile(lid + 1) + 1;
+        f.flush();
+        std::vector<uint32_t> ids = f.dictionaryIdsInFiles();
+        ASSERT_EQUAL(4u, ids.size());
+        EXPECT_EQUAL(std::vector<uint32_t>({0u, dictionaryId, dictionaryId, dictionaryId}), ids);
+        TEST_DO(f.assertContent(1, endLid));
+    }
+    {
+        // Files compressed with the dictionary are still read when the dictionary is disabled.
+        DictionaryFixture f(0, 32_Ki);
+        TEST_DO(f.assertContent(1, endLid));
+        f.writeUntilNewFile(endLid);
+        f.flush();
+        std::vector<uint32_t> ids = f.dictionaryIdsInFiles();
+        ASSERT_EQUAL(5u, ids.size());
+        EXPECT_EQUAL(0u, ids.back());
+    }
+}
+
 LogDataStore::NameIdSet create(std::vector<size_t> list) {
     LogDataStore::NameIdSet l;
     for (size_t id : list) {
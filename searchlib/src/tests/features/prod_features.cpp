@@ -1182,6 +1182,29 @@ verifyCorrectDotProductExecutor(BlueprintFactory & factory, vespalib::stringref
     EXPECT_EQUAL(1u, deps.output.size());
 }
 
+void
+verifyDotProductBatch(BlueprintFactory & factory, vespalib::stringref attrName,
+                      vespalib::stringref queryVector, feature_t expected)
+{
+    ParameterList params = {{ParameterType::ATTRIBUTE, attrName}, {ParameterType::STRING, "vector"}};
+    FtFeatureTest ft(factory, "value(0)");
+    Test::setupForDotProductTest(ft);
+    ft.getQueryEnv().getProperties().add("dotProduct.vector", queryVector);
+    DotProductBlueprint bp;
+    DummyDependencyHandler deps(bp);
+    EXPECT_TRUE(bp.setup(ft.getIndexEnv(), params));
+    vespalib::Stash stash;
+    FeatureExecutor &exc = bp.createExecutor(ft.getQueryEnv(), stash);
+    ASSERT_TRUE(exc.supports_batch());
+    std::vector<uint32_t> docids = {1, 2, 1};
+    std::vector<feature_t> values(docids.size(), -1.0);
+    feature_t *outputs[] = {values.data()};
+    exc.execute_batch(docids, FeatureExecutor::BatchInputs(), FeatureExecutor::BatchOutputs(outputs, 1));
+    EXPECT_EQUAL(expected, values[0]);
+    EXPECT_EQUAL(0.0, values[1]);
+    EXPECT_EQUAL(expected, values[2]);
+}
+
 template<typename T>
 void verifyArrayParser()
 {
@@ -1360,6 +1383,13 @@ Test::testDotProduct()
     TEST_DO(verifyCorrectDotProductExecutor(_factory, "wsint", "{1:1}", "search::features::dotproduct::wset::(anonymous namespace)::SingleDotProductByWeightedValueExecutor<int>"));
     TEST_DO(verifyCorrectDotProductExecutor(_factory, "wsint", "{}", "search::features::SingleZeroValueExecutor"));
 
+    TEST_DO(verifyDotProductBatch(_factory, "wsstr", "{a:1,b:2}", 5));
+    TEST_DO(verifyDotProductBatch(_factory, "wsstr", "{b:3}", 6));
+    TEST_DO(verifyDotProductBatch(_factory, "wsint", "{1:1, 2:3}", 7));
+    TEST_DO(verifyDotProductBatch(_factory, "wsint", "{4:4.5}", 18));
+    TEST_DO(verifyDotProductBatch(_factory, "arrint", "[1 2 3 4 5]", 55));
+    TEST_DO(verifyDotProductBatch(_factory, "arrfloat", "(0:1,3:4,50:97)", 17));
+
 }
 
 void
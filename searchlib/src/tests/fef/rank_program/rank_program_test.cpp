@@ -391,4 +391,58 @@ TEST_F("require that fast-forest gbdt evaluation is pure", Fixture()) {
     EXPECT_EQUAL(f1.final_executor_name(), "search::features::FastForestExecutor");
 }
 
+void verify_batch(Fixture &f, const std::vector<uint32_t> &docids) {
+    ASSERT_TRUE(f.program.setup_batch(4));
+    auto seeds = f.program.get_seeds();
+    for (size_t offset = 0; offset < docids.size(); offset += 4) {
+        size_t n = std::min(size_t(4), docids.size() - offset);
+        f.program.execute_batch(vespalib::ConstArrayRef<uint32_t>(&docids[offset], n));
+        for (size_t seed = 0; seed < seeds.num_features(); ++seed) {
+            const search::feature_t *values = f.program.get_batch_seed(seed);
+            for (size_t i = 0; i < n; ++i) {
+                EXPECT_EQUAL(seeds.resolve(seed).as_number(docids[offset + i]), values[i]);
+            }
+        }
+    }
+}
+
+const std::vector<uint32_t> batch_docids = {1, 2, 3, 5, 8, 13, 21, 34, 55};
+
+TEST_F("require that compiled ranking expressions can be executed in batches", Fixture()) {
+    f1.lazy_expressions(false).add_expr("rank", "docid*2+ivalue(3)+value(1)").add("docid").compile();
+    TEST_DO(verify_batch(f1, batch_docids));
+}
+
+TEST_F("require that lazy compiled ranking expressions can be executed in batches", Fixture()) {
+    f1.lazy_expressions(true).add_expr("rank", "if(docid<10,ivalue(1),docid)").compile();
+    TEST_DO(verify_batch(f1, batch_docids));
+}
+
+TEST_F("require that fast-forest gbdt evaluation can be executed in batches", Fixture()) {
+    f1.use_fast_forest().add_expr("rank", "if(docid<10,1,2)+if(ivalue(2)<1,10,20)").compile();
+    EXPECT_EQUAL(f1.final_executor_name(), "search::features::FastForestExecutor");
+    TEST_DO(verify_batch(f1, batch_docids));
+}
+
+TEST_F("require that overridden features can be executed in batches", Fixture()) {
+    f1.lazy_expressions(false).add_expr("rank", "docid+ivalue(3)").override("ivalue(3)", 10.0).compile();
+    TEST_DO(verify_batch(f1, batch_docids));
+    EXPECT_EQUAL(f1.program.get_batch_seed(0)[0], 65.0);
+}
+
+TEST_F("require that batch execution is not possible for executors without batch support", Fixture()) {
+    f1.add("mysum(docid,ivalue(1))").compile();
+    EXPECT_FALSE(f1.program.setup_batch(4));
+}
+
+TEST_F("require that batch execution is not possible with object seeds", Fixture()) {
+    f1.add("box(docid)").compile();
+    EXPECT_FALSE(f1.program.setup_batch(4));
+}
+
+TEST_F("require that const features only need batch support when not const", Fixture()) {
+    f1.lazy_expressions(false).add_expr("rank", "mysum(value(1),value(2))+docid").compile();
+    TEST_DO(verify_batch(f1, batch_docids));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -8,6 +8,9 @@
 #include <vespa/searchlib/aggregation/hitsaggregationresult.h>
 #include <vespa/searchlib/aggregation/fs4hit.h>
 #include <vespa/searchlib/aggregation/predicates.h>
+#include <vespa/searchlib/aggregation/columnargrouper.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/stringbase.h>
 #include <vespa/searchlib/expression/fixedwidthbucketfunctionnode.h>
 #include <vespa/searchlib/test/make_attribute_map_lookup_node.h>
 #include <vespa/searchcommon/common/undefinedvalues.h>
@@ -185,6 +188,7 @@ public:
     void testThatNanIsConverted();
     void testNanSorting();
     void testAttributeMapLookup();
+    void testColumnarGrouping();
     int Main() override;
 private:
     void testAggregationSimple(AggregationContext & ctx, const AggregationResult & aggr, const ResultNode & ir, const vespalib::string &name);
@@ -1946,6 +1950,75 @@ Test::testAttributeMapLookup()
     testAggregationSimple(ctx, MaxAggregationResult(), Int64ResultNode(100), "smap{attribute(key2)}.weight");
 }
 
+/**
+ * Verify that single level groupings on single value attributes use
+ * the columnar path, and that it gives the same result as the generic
+ * path.
+ **/
+void
+Test::testColumnarGrouping()
+{
+    const uint32_t numDocs = 1000;
+    AggregationContext ctx;
+    IntAttrBuilder key("key");
+    IntAttrBuilder ival("ival");
+    FloatAttrBuilder fval("fval");
+    auto skey = AttributeFactory::createAttribute("skey", Config(BasicType::STRING));
+    auto & sattr = dynamic_cast<StringAttribute &>(*skey);
+    sattr.addReservedDoc();
+    key.add(0);
+    ival.add(0);
+    fval.add(0);
+    for (uint32_t i = 1; i < numDocs; ++i) {
+        DocId docId;
+        ASSERT_TRUE(sattr.addDoc(docId));
+        sattr.update(docId, make_string("s%u", i % 13).c_str());
+        key.add(i % 37);
+        ival.add(int64_t(i * 7) - 3000);
+        fval.add(i * 0.5);
+        ctx.result().add(i);
+    }
+    sattr.commit();
+    ctx.add(key.sp());
+    ctx.add(ival.sp());
+    ctx.add(fval.sp());
+    ctx.add(skey);
+
+    for (const char * keyName : {"key", "skey"}) {
+        TEST_STATE(keyName);
+        GroupingLevel level = createGL(MU<AttributeNode>(keyName));
+        level.addResult(CountAggregationResult().setExpression(MU<ConstantNode>(MU<Int64ResultNode>(0))))
+             .addResult(SumAggregationResult().setExpression(MU<AttributeNode>("ival")))
+             .addResult(MinAggregationResult().setExpression(MU<AttributeNode>("fval")))
+             .addResult(MaxAggregationResult().setExpression(MU<AttributeNode>("ival")));
+        Grouping request = Grouping().setLastLevel(1).addLevel(std::move(level));
+
+        Grouping columnar = request;
+        ctx.setup(columnar);
+        EXPECT_TRUE(ColumnarGrouper::create(columnar));
+        columnar.aggregate(ctx.result().hits(), ctx.result().size());
+
+        Grouping generic = request;
+        ctx.setup(generic);
+        generic.aggregate(1u, numDocs);
+
+        EXPECT_EQUAL((strcmp(keyName, "key") == 0) ? 37u : 13u, columnar.getRoot().getChildrenSize());
+        EXPECT_EQUAL(generic.getRoot().asString(), columnar.getRoot().asString());
+    }
+    { // grouping on a float attribute is not handled
+        Grouping request = Grouping().setLastLevel(1).addLevel(createGL(MU<AttributeNode>("fval"), MU<AttributeNode>("ival")));
+        ctx.setup(request);
+        EXPECT_FALSE(ColumnarGrouper::create(request));
+    }
+    { // multiple levels are not handled
+        Grouping request = Grouping().setLastLevel(2)
+                           .addLevel(createGL(MU<AttributeNode>("key"), MU<AttributeNode>("ival")))
+                           .addLevel(createGL(MU<AttributeNode>("skey"), MU<AttributeNode>("ival")));
+        ctx.setup(request);
+        EXPECT_FALSE(ColumnarGrouper::create(request));
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 struct RunDiff { ~RunDiff() { system("diff -u lhs.out rhs.out > diff.txt"); }};
@@ -1979,6 +2052,7 @@ Test::Main()
     testThatNanIsConverted();
     testNanSorting();
     testAttributeMapLookup();
+    TEST_DO(testColumnarGrouping());
     TEST_DONE();
 }
 
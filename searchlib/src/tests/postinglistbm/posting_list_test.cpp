@@ -5,12 +5,15 @@
 #include <vespa/searchlib/test/fakedata/fakeword.h>
 #include <vespa/searchlib/test/fakedata/fakewordset.h>
 #include <vespa/searchlib/test/fakedata/fpfactory.h>
+#include <vespa/searchlib/queryeval/block_max_features.h>
 #include <vespa/vespalib/util/rand48.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <cinttypes>
 
 using search::fef::TermFieldMatchData;
 using search::fef::TermFieldMatchDataArray;
+using search::queryeval::BlockMaxFeatures;
+using search::queryeval::IBlockMaxFeatures;
 using search::queryeval::SearchIterator;
 
 using namespace search::index;
@@ -57,6 +60,39 @@ test_fake(const std::string& posting_type,
     validate_posting_list_for_word(*posting, word);
 }
 
+void
+validate_block_max_features(const FakePosting& posting, const FakeWord& word, uint32_t stride)
+{
+    TermFieldMatchData md;
+    TermFieldMatchDataArray tfmda;
+    tfmda.add(&md);
+    md.setNeedInterleavedFeatures(true);
+    std::unique_ptr<SearchIterator> iterator(posting.createIterator(tfmda));
+    auto block_max = dynamic_cast<const IBlockMaxFeatures*>(iterator.get());
+    ASSERT_TRUE(block_max != nullptr);
+    iterator->initFullRange();
+    BlockMaxFeatures features;
+    uint32_t blocks = 0;
+    uint32_t last_doc_id = 0;
+    for (size_t i = 0; i < word._postings.size(); i += stride) {
+        const auto& doc = word._postings[i];
+        ASSERT_TRUE(iterator->seek(doc._docId));
+        ASSERT_TRUE(block_max->get_block_max_features(features));
+        EXPECT_LE(doc._docId, features.last_doc_id);
+        EXPECT_LE(doc._collapsedDocWordFeatures._num_occs, features.max_num_occs);
+        EXPECT_GE(doc._collapsedDocWordFeatures._field_len, features.min_field_length);
+        if (features.last_doc_id != last_doc_id) {
+            EXPECT_LT(last_doc_id, doc._docId);
+            last_doc_id = features.last_doc_id;
+            ++blocks;
+        }
+    }
+    EXPECT_LT(1u, blocks);
+    iterator->seek(word._postings.back()._docId + 1);
+    EXPECT_TRUE(iterator->isAtEnd());
+    EXPECT_FALSE(block_max->get_block_max_features(features));
+}
+
 struct PostingListTest : public ::testing::Test {
     uint32_t num_docs;
     std::vector<std::string> posting_types;
@@ -139,4 +175,32 @@ TEST_F(PostingListTest, verify_posting_list_iterators_over_weighted_set_field)
     run();
 }
 
+TEST_F(PostingListTest, block_max_features_are_exposed_by_skip_iterator_with_interleaved_features)
+{
+    setup(false, false);
+    std::unique_ptr<FPFactory> factory(getFPFactory("Zc4SkipPosOccBE.cf", word_set.getSchema()));
+    std::vector<const FakeWord *> words{word3.get(), word4.get()};
+    factory->setup(words);
+    for (auto word : words) {
+        auto posting = factory->make(*word);
+        validate_block_max_features(*posting, *word, 1);
+        validate_block_max_features(*posting, *word, 37);
+        validate_block_max_features(*posting, *word, 1001);
+    }
+}
+
+TEST_F(PostingListTest, block_max_features_are_exposed_by_block_iterator_with_interleaved_features)
+{
+    setup(false, false);
+    std::unique_ptr<FPFactory> factory(getFPFactory("Zc4BlockPosOccBE.cf", word_set.getSchema()));
+    std::vector<const FakeWord *> words{word3.get(), word4.get()};
+    factory->setup(words);
+    for (auto word : words) {
+        auto posting = factory->make(*word);
+        validate_block_max_features(*posting, *word, 1);
+        validate_block_max_features(*posting, *word, 37);
+        validate_block_max_features(*posting, *word, 1001);
+    }
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -4,6 +4,7 @@
 #include <vespa/searchlib/queryeval/emptysearch.h>
 #include <vespa/searchlib/queryeval/truesearch.h>
 #include <vespa/searchlib/common/bitvectoriterator.h>
+#include <vespa/searchlib/common/compressedbitvector.h>
 #include <vespa/searchlib/queryeval/andsearch.h>
 #include <vespa/searchlib/queryeval/andnotsearch.h>
 #include <vespa/searchlib/queryeval/orsearch.h>
@@ -43,6 +44,8 @@ public:
     void testOptimizeAndOr(bool invert);
     template <typename T>
     void testSearch(bool strict, bool invert);
+    template <typename T>
+    void testSearchWithCompressed(bool strict, bool invert);
     int Main() override;
 private:
     void verifyUnpackOfOr(const UnpackInfo & unpackInfo);
@@ -52,6 +55,10 @@ private:
     SearchIterator::UP createIter(size_t index, bool inverted, TermFieldMatchData & tfmd, bool strict) {
         return BitVectorIterator::create(getBV(index, inverted), tfmd, strict, inverted);
     }
+    SearchIterator::UP createCompressedIter(size_t index, bool inverted, TermFieldMatchData & tfmd, bool strict) {
+        const CompressedBitVector *cbv = (inverted ? _cbvs_inverted[index] : _cbvs[index]).get();
+        return BitVectorIterator::create(cbv, cbv->size(), tfmd, strict, inverted);
+    }
     BitVector * getBV(size_t index, bool inverted) {
         return inverted ? _bvs_inverted[index].get() : _bvs[index].get();
     }
@@ -67,6 +74,8 @@ private:
     }
     std::vector< BitVector::UP > _bvs;
     std::vector< BitVector::UP > _bvs_inverted;
+    std::vector< CompressedBitVector::UP > _cbvs;
+    std::vector< CompressedBitVector::UP > _cbvs_inverted;
 };
 
 Test::Test() = default;
@@ -87,6 +96,8 @@ void Test::setup()
         auto inverted = BitVector::create(bv);
         inverted->notSelf();
         _bvs_inverted.push_back(std::move(inverted));
+        _cbvs.push_back(CompressedBitVector::create(*_bvs.back()));
+        _cbvs_inverted.push_back(CompressedBitVector::create(*_bvs_inverted.back()));
     }
 }
 
@@ -374,6 +385,47 @@ Test::testSearch(bool strict, bool invert)
     }
 }
 
+template <typename T>
+void
+Test::testSearchWithCompressed(bool strict, bool invert)
+{
+    TermFieldMatchData tfmd;
+    uint32_t docIdLimit(_bvs[0]->size());
+    {
+        MultiSearch::Children children;
+        children.push_back(createIter(0, invert, tfmd, strict));
+        children.push_back(createCompressedIter(1, invert, tfmd, strict));
+        SearchIterator::UP s = T::create(std::move(children), strict);
+        searchAndCompare(std::move(s), docIdLimit);
+    }
+    {
+        MultiSearch::Children children;
+        children.push_back(createCompressedIter(0, invert, tfmd, strict));
+        children.push_back(createCompressedIter(1, invert, tfmd, strict));
+        children.push_back(createIter(2, invert, tfmd, strict));
+        SearchIterator::UP s = T::create(std::move(children), strict);
+        searchAndCompare(std::move(s), docIdLimit);
+    }
+    {
+        MultiSearch::Children children;
+        children.push_back(createCompressedIter(0, invert, tfmd, strict));
+        children.push_back(createCompressedIter(1, invert, tfmd, strict));
+        SearchIterator::UP s = T::create(std::move(children), strict);
+        SearchIterator * p = s.get();
+        SearchIterator::UP optimized = MultiBitVectorIteratorBase::optimize(std::move(s));
+        EXPECT_TRUE(optimized.get() != p);
+        EXPECT_TRUE(dynamic_cast<const MultiBitVectorIteratorBase *>(optimized.get()) != nullptr);
+        MultiSearch::Children expected_children;
+        expected_children.push_back(createCompressedIter(0, invert, tfmd, strict));
+        expected_children.push_back(createCompressedIter(1, invert, tfmd, strict));
+        SearchIterator::UP expected = T::create(std::move(expected_children), strict);
+        H a = seek(*expected, docIdLimit);
+        H b = seek(*optimized, docIdLimit);
+        EXPECT_FALSE(a.empty());
+        EXPECT_TRUE(a == b);
+    }
+}
+
 template <typename T>
 void
 Test::testOptimizeCommon(bool isAnd, bool invert)
@@ -659,6 +711,13 @@ Test::Main()
     testAndWith(false);
     testAndWith(true);
     TEST_FLUSH();
+    for (bool strict : {false, true}) {
+        for (bool invert : {false, true}) {
+            testSearchWithCompressed<AndSearch>(strict, invert);
+            testSearchWithCompressed<OrSearch>(strict, invert);
+        }
+    }
+    TEST_FLUSH();
     testIteratorConformance();
     TEST_FLUSH();
     TEST_DONE();
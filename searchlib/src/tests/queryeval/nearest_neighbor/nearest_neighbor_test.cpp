@@ -6,6 +6,7 @@
 #include <vespa/eval/eval/simple_value.h>
 #include <vespa/eval/eval/tensor_spec.h>
 #include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/common/compressedbitvector.h>
 #include <vespa/searchlib/common/feature.h>
 #include <vespa/searchlib/fef/matchdata.h>
 #include <vespa/searchlib/queryeval/nearest_neighbor_iterator.h>
@@ -24,6 +25,7 @@ using search::feature_t;
 using search::tensor::DenseTensorAttribute;
 using search::AttributeVector;
 using search::BitVector;
+using search::CompressedBitVector;
 using vespalib::eval::Value;
 using vespalib::eval::ValueType;
 using vespalib::eval::CellType;
@@ -61,7 +63,7 @@ struct Fixture
     vespalib::string _typeSpec;
     std::shared_ptr<DenseTensorAttribute> _tensorAttr;
     std::shared_ptr<AttributeVector> _attr;
-    std::unique_ptr<BitVector> _global_filter;
+    std::shared_ptr<GlobalFilter> _global_filter;
 
     Fixture(const vespalib::string &typeSpec)
         : _cfg(BasicType::TENSOR, CollectionType::SINGLE),
@@ -91,12 +93,17 @@ struct Fixture
         }
     }
 
-    void setFilter(std::vector<uint32_t> docids) {
+    void setFilter(std::vector<uint32_t> docids, bool compressed = false) {
         uint32_t sz = _attr->getNumDocs();
-        _global_filter = BitVector::create(sz);
+        auto bv = BitVector::create(sz);
         for (uint32_t id : docids) {
             EXPECT_LESS(id, sz);
-            _global_filter->setBit(id);
+            bv->setBit(id);
+        }
+        if (compressed) {
+            _global_filter = GlobalFilter::create(CompressedBitVector::create(*bv));
+        } else {
+            _global_filter = GlobalFilter::create(std::move(bv));
         }
     }
 
@@ -127,7 +134,7 @@ SimpleResult find_matches(Fixture &env, const Value &qtv, double threshold = std
     auto &attr = *(env._tensorAttr);
     NearestNeighborDistanceHeap dh(2);
     dh.set_distance_threshold(env.dist_fun()->convert_threshold(threshold));
-    const BitVector *filter = env._global_filter.get();
+    const GlobalFilter *filter = env._global_filter.get();
     auto search = NearestNeighborIterator::create(strict, tfmd, qtv, attr, dh, filter, env.dist_fun());
     if (strict) {
         return SimpleResult().searchStrict(*search, attr.getNumDocs());
@@ -182,11 +189,12 @@ TEST("require that NearestNeighborIterator returns expected results") {
 
 void
 verify_iterator_returns_filtered_results(const vespalib::string& attribute_tensor_type_spec,
-                                         const vespalib::string& query_tensor_type_spec)
+                                         const vespalib::string& query_tensor_type_spec,
+                                         bool compressed_filter = false)
 {
     Fixture fixture(attribute_tensor_type_spec);
     fixture.ensureSpace(6);
-    fixture.setFilter({1,3,4});
+    fixture.setFilter({1,3,4}, compressed_filter);
     fixture.setTensor(1, 3.0, 4.0);
     fixture.setTensor(2, 6.0, 8.0);
     fixture.setTensor(3, 5.0, 12.0);
@@ -212,6 +220,11 @@ TEST("require that NearestNeighborIterator returns filtered results") {
     TEST_DO(verify_iterator_returns_filtered_results(denseSpecFloat, denseSpecFloat));
 }
 
+TEST("require that NearestNeighborIterator returns filtered results with compressed filter") {
+    TEST_DO(verify_iterator_returns_filtered_results(denseSpecDouble, denseSpecDouble, true));
+    TEST_DO(verify_iterator_returns_filtered_results(denseSpecFloat, denseSpecFloat, true));
+}
+
 template <bool strict>
 std::vector<feature_t> get_rawscores(Fixture &env, const Value &qtv) {
     auto md = MatchData::makeTestInstance(2, 2);
@@ -1,6 +1,8 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/searchlib/fef/matchdatalayout.h>
 #include <vespa/searchlib/queryeval/fake_search.h>
+#include <vespa/searchlib/queryeval/intermediate_blueprints.h>
 #include <vespa/searchlib/queryeval/wand/weak_and_search.h>
 #include <vespa/searchlib/queryeval/simpleresult.h>
 #include <vespa/searchlib/queryeval/simplesearch.h>
@@ -8,6 +10,8 @@
 #include <vespa/searchlib/queryeval/test/leafspec.h>
 #include <vespa/searchlib/queryeval/test/wandspec.h>
 #include <vespa/searchlib/test/weightedchildrenverifiers.h>
+#include <vespa/vespalib/test/insertion_operators.h>
+#include <vespa/vespalib/util/rand48.h>
 
 using namespace search::fef;
 using namespace search::queryeval;
@@ -58,6 +62,163 @@ struct WeightOrder {
     }
 };
 
+struct BlockMaxPosting {
+    uint32_t docid;
+    uint32_t num_occs;
+    uint32_t field_length;
+};
+
+class BlockMaxSearch : public SearchIterator, public IBlockMaxFeatures
+{
+private:
+    const std::vector<BlockMaxPosting> &_postings;
+    uint32_t                            _block_size;
+    bool                                _expose_block_max;
+    TermFieldMatchData                 &_tfmd;
+    size_t                             &_unpack_cnt;
+    size_t                              _pos;
+
+    void update_docid() {
+        if (_pos < _postings.size()) {
+            setDocId(_postings[_pos].docid);
+        } else {
+            setAtEnd();
+        }
+    }
+public:
+    BlockMaxSearch(const std::vector<BlockMaxPosting> &postings, uint32_t block_size, bool expose_block_max,
+                   TermFieldMatchData &tfmd, size_t &unpack_cnt)
+        : _postings(postings), _block_size(block_size), _expose_block_max(expose_block_max),
+          _tfmd(tfmd), _unpack_cnt(unpack_cnt), _pos(0)
+    {}
+    void initRange(uint32_t begin, uint32_t end) override {
+        SearchIterator::initRange(begin, end);
+        _pos = 0;
+    }
+    void doSeek(uint32_t docid) override {
+        while (_pos < _postings.size() && _postings[_pos].docid < docid) {
+            ++_pos;
+        }
+        update_docid();
+    }
+    void doUnpack(uint32_t docid) override {
+        ++_unpack_cnt;
+        _tfmd.resetOnlyDocId(docid);
+        _tfmd.setNumOccs(_postings[_pos].num_occs);
+        _tfmd.setFieldLength(_postings[_pos].field_length);
+    }
+    bool get_block_max_features(BlockMaxFeatures &features) const override {
+        if (!_expose_block_max || _pos >= _postings.size()) {
+            return false;
+        }
+        size_t begin = (_pos / _block_size) * _block_size;
+        size_t end = std::min(begin + _block_size, _postings.size());
+        features.last_doc_id = _postings[end - 1].docid;
+        features.max_num_occs = 0;
+        features.min_field_length = std::numeric_limits<uint32_t>::max();
+        for (size_t i = begin; i < end; ++i) {
+            features.max_num_occs = std::max(features.max_num_occs, _postings[i].num_occs);
+            features.min_field_length = std::min(features.min_field_length, _postings[i].field_length);
+        }
+        return true;
+    }
+};
+
+class BlockMaxBlueprint : public SimpleLeafBlueprint
+{
+private:
+    const std::vector<BlockMaxPosting> &_postings;
+    size_t                             &_unpack_cnt;
+public:
+    BlockMaxBlueprint(const FieldSpec &field, const std::vector<BlockMaxPosting> &postings, size_t &unpack_cnt)
+        : SimpleLeafBlueprint(field), _postings(postings), _unpack_cnt(unpack_cnt)
+    {
+        setEstimate(HitEstimate(postings.size(), postings.empty()));
+    }
+    SearchIterator::UP createLeafSearch(const TermFieldMatchDataArray &tfmda, bool) const override {
+        return std::make_unique<BlockMaxSearch>(_postings, 16, true, *tfmda[0], _unpack_cnt);
+    }
+};
+
+struct Bm25WandFixture {
+    static constexpr uint32_t num_docs = 5000;
+    std::vector<std::vector<BlockMaxPosting>> postings;
+    std::vector<TermFieldMatchData> tfmds;
+    size_t unpack_cnt;
+
+    Bm25WandFixture() : postings(3), tfmds(3), unpack_cnt(0) {
+        vespalib::Rand48 rnd;
+        rnd.srand48(42);
+        uint32_t freq[] = { 2, 5, 50 };
+        for (uint32_t docid = 1; docid < num_docs; ++docid) {
+            for (size_t i = 0; i < postings.size(); ++i) {
+                if ((rnd.lrand48() % freq[i]) == 0) {
+                    // mostly low term frequencies with a few peaks, giving blocks with quite different bounds
+                    uint32_t num_occs = ((rnd.lrand48() % 100) == 0) ? 8 : (1 + uint32_t(rnd.lrand48() % 2));
+                    postings[i].push_back({docid, num_occs, 50 + uint32_t(rnd.lrand48() % 100)});
+                }
+            }
+        }
+    }
+    std::vector<uint32_t> search(bool expose_block_max) {
+        wand::Terms terms;
+        for (size_t i = 0; i < postings.size(); ++i) {
+            terms.emplace_back(new BlockMaxSearch(postings[i], 16, expose_block_max, tfmds[i], unpack_cnt),
+                               100, postings[i].size(), &tfmds[i]);
+            terms.back().avgFieldLength = 100.0;
+        }
+        auto search = WeakAndSearch::create(terms, 10, true, wand::Bm25Params(1.2, 0.75, num_docs));
+        std::vector<uint32_t> hits;
+        search->initFullRange();
+        for (uint32_t docid = search->seekFirst(1); !search->isAtEnd(); docid = search->seekNext(docid + 1)) {
+            search->unpack(docid);
+            hits.push_back(docid);
+        }
+        return hits;
+    }
+    std::vector<uint32_t> search_blueprint(double avg_field_length) {
+        MatchDataLayout mdl;
+        WeakAndBlueprint blueprint(10, wand::Bm25Params(1.2, 0.75, num_docs));
+        for (size_t i = 0; i < postings.size(); ++i) {
+            FieldSpec field("foo", i, mdl.allocTermField(i));
+            blueprint.addTerm(std::make_unique<BlockMaxBlueprint>(field, postings[i], unpack_cnt), 100, avg_field_length);
+        }
+        blueprint.setDocIdLimit(num_docs);
+        blueprint.fetchPostings(ExecuteInfo::TRUE);
+        auto md = mdl.createMatchData();
+        for (size_t i = 0; i < postings.size(); ++i) {
+            md->resolveTermField(i)->setNeedInterleavedFeatures(true);
+        }
+        auto search = blueprint.createSearch(*md, true);
+        std::vector<uint32_t> hits;
+        search->initFullRange();
+        for (uint32_t docid = search->seekFirst(1); !search->isAtEnd(); docid = search->seekNext(docid + 1)) {
+            search->unpack(docid);
+            hits.push_back(docid);
+        }
+        return hits;
+    }
+    std::vector<double> top_scores(const std::vector<uint32_t> &hits) const {
+        std::vector<double> scores;
+        for (uint32_t docid : hits) {
+            double score = 0.0;
+            for (const auto &term_postings : postings) {
+                for (const auto &posting : term_postings) {
+                    if (posting.docid == docid) {
+                        double idf = wand::Bm25Scorer::calculate_idf(term_postings.size(), num_docs);
+                        double norm_field_length = posting.field_length / 100.0;
+                        score += idf * posting.num_occs * 2.2 / (posting.num_occs + 1.2 * (0.25 + 0.75 * norm_field_length));
+                    }
+                }
+            }
+            scores.push_back(score);
+        }
+        std::sort(scores.begin(), scores.end(), std::greater<>());
+        scores.resize(std::min(scores.size(), size_t(10)));
+        return scores;
+    }
+};
+
 } // namespace <unnamed>
 
 TEST_F("require that wand prunes bad hits after enough good ones are obtained", SimpleWandFixture) {
@@ -99,6 +260,34 @@ TEST("require that initial docid for subsearches are taken into account") {
                  history);
 }
 
+TEST_F("require that bm25 wand with block max pruning finds the same top hits with fewer evaluations", Bm25WandFixture) {
+    auto plain_hits = f.search(false);
+    size_t plain_unpack_cnt = f.unpack_cnt;
+    f.unpack_cnt = 0;
+    auto block_max_hits = f.search(true);
+    size_t block_max_unpack_cnt = f.unpack_cnt;
+    EXPECT_LESS(block_max_hits.size(), plain_hits.size());
+    EXPECT_LESS(block_max_unpack_cnt, plain_unpack_cnt);
+    EXPECT_TRUE(std::includes(plain_hits.begin(), plain_hits.end(), block_max_hits.begin(), block_max_hits.end()));
+    auto plain_scores = f.top_scores(plain_hits);
+    auto block_max_scores = f.top_scores(block_max_hits);
+    ASSERT_EQUAL(10u, block_max_scores.size());
+    for (size_t i = 0; i < block_max_scores.size(); ++i) {
+        EXPECT_APPROX(plain_scores[i], block_max_scores[i], 1e-9);
+    }
+}
+
+TEST_F("require that weak and blueprint scores with bm25 using the features of its terms", Bm25WandFixture) {
+    auto direct_hits = f.search(true);
+    size_t direct_unpack_cnt = f.unpack_cnt;
+    f.unpack_cnt = 0;
+    auto blueprint_hits = f.search_blueprint(100.0);
+    EXPECT_EQUAL(direct_hits, blueprint_hits);
+    EXPECT_EQUAL(direct_unpack_cnt, f.unpack_cnt);
+    // the average field length of the terms is used to normalize field lengths
+    EXPECT_NOT_EQUAL(direct_hits, f.search_blueprint(10.0));
+}
+
 class IteratorChildrenVerifier : public search::test::IteratorChildrenVerifier {
 private:
     SearchIterator::UP create(bool strict) const override {
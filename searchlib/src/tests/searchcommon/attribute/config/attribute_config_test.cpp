@@ -123,12 +123,15 @@ TEST("DictionaryConfig") {
 
     EXPECT_EQUAL(Type::HASH, DictionaryConfig(Type::HASH).getType());
     EXPECT_EQUAL(Type::BTREE_AND_HASH, DictionaryConfig(Type::BTREE_AND_HASH).getType());
+    EXPECT_FALSE(DictionaryConfig(Type::BTREE, Match::UNCASED).get_trigram_index());
+    EXPECT_TRUE(DictionaryConfig(Type::BTREE, Match::UNCASED, true).get_trigram_index());
 
     EXPECT_EQUAL(DictionaryConfig(Type::BTREE), DictionaryConfig(Type::BTREE));
     EXPECT_EQUAL(DictionaryConfig(Type::HASH), DictionaryConfig(Type::HASH));
     EXPECT_EQUAL(DictionaryConfig(Type::BTREE_AND_HASH), DictionaryConfig(Type::BTREE_AND_HASH));
     EXPECT_NOT_EQUAL(DictionaryConfig(Type::HASH), DictionaryConfig(Type::BTREE));
     EXPECT_NOT_EQUAL(DictionaryConfig(Type::BTREE), DictionaryConfig(Type::HASH));
+    EXPECT_NOT_EQUAL(DictionaryConfig(Type::BTREE), DictionaryConfig(Type::BTREE, Match::UNCASED, true));
     EXPECT_TRUE(Config().set_dictionary_config(DictionaryConfig(Type::HASH)) ==
                 Config().set_dictionary_config(DictionaryConfig(Type::HASH)));
     EXPECT_FALSE(Config().set_dictionary_config(DictionaryConfig(Type::HASH)) ==
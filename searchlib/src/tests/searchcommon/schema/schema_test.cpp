@@ -33,6 +33,8 @@ assertIndexField(const Schema::IndexField& exp,
     assertField(exp, act);
     EXPECT_EQ(exp.getAvgElemLen(), act.getAvgElemLen());
     EXPECT_EQ(exp.use_interleaved_features(), act.use_interleaved_features());
+    EXPECT_EQ(exp.use_block_postings(), act.use_block_postings());
+    EXPECT_EQ(exp.use_block_max(), act.use_block_max());
 }
 
 void
@@ -182,8 +184,8 @@ TEST(SchemaTest, test_load_and_save)
         SchemaConfigurer configurer(s, "dir:load-save-cfg");
         EXPECT_EQ(3u, s.getNumIndexFields());
         assertIndexField(SIF("a", SDT::STRING), s.getIndexField(0));
-        assertIndexField(SIF("b", SDT::INT64), s.getIndexField(1));
-        assertIndexField(SIF("c", SDT::STRING).set_interleaved_features(true), s.getIndexField(2));
+        assertIndexField(SIF("b", SDT::INT64).set_block_postings(true), s.getIndexField(1));
+        assertIndexField(SIF("c", SDT::STRING).set_interleaved_features(true).set_block_max(true), s.getIndexField(2));
 
         EXPECT_EQ(9u, s.getNumAttributeFields());
         assertField(SAF("a", SDT::STRING, SCT::SINGLE),
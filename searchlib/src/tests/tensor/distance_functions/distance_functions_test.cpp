@@ -5,12 +5,16 @@
 #include <vespa/searchlib/tensor/distance_functions.h>
 #include <vespa/searchlib/tensor/distance_function_factory.h>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/bfloat16.h>
+#include <cmath>
 #include <vector>
 
 #include <vespa/log/log.h>
 LOG_SETUP("distance_function_test");
 
 using namespace search::tensor;
+using vespalib::BFloat16;
+using vespalib::eval::CellType;
 using vespalib::eval::Int8Float;
 using vespalib::eval::TypedCells;
 using search::attribute::DistanceMetric;
@@ -252,6 +256,48 @@ TEST(DistanceFunctionsTest, hamming_gives_expected_score)
     EXPECT_EQ(hamming->calc(TypedCells(bytes_a), TypedCells(bytes_b)), 12.0);
 }
 
+TEST(DistanceFunctionsTest, bfloat16_distances_match_double_distances)
+{
+    // Values chosen to be exactly representable as bfloat16; odd size exercises the scalar tail
+    std::vector<double> a_d, b_d;
+    for (size_t i = 0; i < 35; ++i) {
+        a_d.push_back((int(i % 7) - 3) * 0.125);
+        b_d.push_back((int(i % 5) - 2) * 0.25);
+    }
+    std::vector<BFloat16> a_bf(a_d.begin(), a_d.end());
+    std::vector<BFloat16> b_bf(b_d.begin(), b_d.end());
+    std::vector<float> b_f(b_d.begin(), b_d.end());
+    for (auto metric : {DistanceMetric::Euclidean, DistanceMetric::Angular, DistanceMetric::InnerProduct}) {
+        auto reference = make_distance_function(metric, CellType::DOUBLE);
+        auto dist_fun = make_distance_function(metric, CellType::BFLOAT16);
+        EXPECT_EQ(dist_fun->expected_cell_type(), CellType::FLOAT);
+        double expected = reference->calc(t(a_d), t(b_d));
+        EXPECT_NEAR(dist_fun->calc(t(a_bf), t(b_bf)), expected, 1e-5);
+        EXPECT_NEAR(dist_fun->calc(t(a_bf), t(b_f)), expected, 1e-5);
+        EXPECT_NEAR(dist_fun->calc(t(b_f), t(a_bf)), expected, 1e-5);
+    }
+}
+
+TEST(DistanceFunctionsTest, angular_and_innerproduct_int8_smoketest)
+{
+    auto angular = make_distance_function(DistanceMetric::Angular, CellType::INT8);
+    auto innerproduct = make_distance_function(DistanceMetric::InnerProduct, CellType::INT8);
+    EXPECT_EQ(angular->expected_cell_type(), CellType::INT8);
+    EXPECT_EQ(innerproduct->expected_cell_type(), CellType::INT8);
+
+    std::vector<Int8Float> p1{1.0, 0.0, 0.0};
+    std::vector<Int8Float> p2{0.0, 1.0, 0.0};
+    std::vector<Int8Float> p5{0.0,-1.0, 0.0};
+    std::vector<Int8Float> p6{1.0, 2.0, 2.0};
+
+    EXPECT_DOUBLE_EQ(1.0, angular->calc(t(p1), t(p2)));
+    EXPECT_DOUBLE_EQ(2.0, angular->calc(t(p2), t(p5)));
+    EXPECT_FLOAT_EQ(1.0 - (2.0/3.0), angular->calc(t(p2), t(p6)));
+    EXPECT_DOUBLE_EQ(1.0, innerproduct->calc(t(p1), t(p2)));
+    EXPECT_DOUBLE_EQ(2.0, innerproduct->calc(t(p2), t(p5)));
+    EXPECT_DOUBLE_EQ(0.0, innerproduct->calc(t(p1), t(p6)));
+}
+
 TEST(GeoDegreesTest, gives_expected_score)
 {
     auto ct = vespalib::eval::CellType::DOUBLE;
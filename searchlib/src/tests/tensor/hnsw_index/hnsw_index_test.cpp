@@ -1,6 +1,9 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/common/compressedbitvector.h>
+#include <vespa/searchlib/queryeval/global_filter.h>
+#include <vespa/searchlib/tensor/distance_function_factory.h>
 #include <vespa/searchlib/tensor/distance_functions.h>
 #include <vespa/searchlib/tensor/doc_vector_access.h>
 #include <vespa/searchlib/tensor/hnsw_index.h>
@@ -22,8 +25,12 @@ using namespace search::tensor;
 using namespace vespalib::slime;
 using vespalib::Slime;
 using search::BitVector;
+using search::CompressedBitVector;
+using search::queryeval::GlobalFilter;
 using vespalib::datastore::CompactionSpec;
 using vespalib::datastore::CompactionStrategy;
+using search::attribute::DistanceMetric;
+using search::attribute::VectorQuantization;
 
 template <typename FloatType>
 class MyDocVectorAccess : public DocVectorAccess {
@@ -61,7 +68,7 @@ using HnswIndexUP = std::unique_ptr<HnswIndex>;
 class HnswIndexTest : public ::testing::Test {
 public:
     FloatVectors vectors;
-    std::unique_ptr<BitVector> global_filter;
+    std::shared_ptr<GlobalFilter> global_filter;
     LevelGenerator* level_generator;
     GenerationHandler gen_handler;
     HnswIndexUP index;
@@ -80,12 +87,12 @@ public:
 
     ~HnswIndexTest() {}
 
-    void init(bool heuristic_select_neighbors) {
+    void init(bool heuristic_select_neighbors, VectorQuantization quantization = VectorQuantization::None) {
         auto generator = std::make_unique<LevelGenerator>();
         level_generator = generator.get();
         index = std::make_unique<HnswIndex>(vectors, std::make_unique<SquaredEuclideanDistance>(vespalib::eval::CellType::FLOAT),
                                             std::move(generator),
-                                            HnswIndex::Config(5, 2, 10, 0, heuristic_select_neighbors));
+                                            HnswIndex::Config(5, 2, 10, 0, heuristic_select_neighbors, quantization, 10));
     }
     void add_document(uint32_t docid, uint32_t max_level = 0) {
         level_generator->level = max_level;
@@ -102,12 +109,17 @@ public:
         gen_handler.updateFirstUsedGeneration();
         index->trim_hold_lists(gen_handler.getFirstUsedGeneration());
     }
-    void set_filter(std::vector<uint32_t> docids) {
+    void set_filter(std::vector<uint32_t> docids, bool compressed = false) {
         uint32_t sz = 10;
-        global_filter = BitVector::create(sz);
+        auto bv = BitVector::create(sz);
         for (uint32_t id : docids) {
             EXPECT_LT(id, sz);
-            global_filter->setBit(id);
+            bv->setBit(id);
+        }
+        if (compressed) {
+            global_filter = GlobalFilter::create(CompressedBitVector::create(*bv));
+        } else {
+            global_filter = GlobalFilter::create(std::move(bv));
         }
     }
     GenerationHandler::Guard take_read_guard() {
@@ -237,14 +249,16 @@ TEST_F(HnswIndexTest, 2d_vectors_inserted_in_level_0_graph_with_simple_select_ne
     expect_top_3(8, {4, 3, 1});
     expect_top_3(9, {7, 3, 2});
 
-    set_filter({2,3,4,6});
-    expect_top_3(2, {2, 3});
-    expect_top_3(4, {4, 3});
-    expect_top_3(5, {6, 2});
-    expect_top_3(6, {6, 2});
-    expect_top_3(7, {3, 2});
-    expect_top_3(8, {4, 3});
-    expect_top_3(9, {3, 2});
+    for (bool compressed : {false, true}) {
+        set_filter({2,3,4,6}, compressed);
+        expect_top_3(2, {2, 3});
+        expect_top_3(4, {4, 3});
+        expect_top_3(5, {6, 2});
+        expect_top_3(6, {6, 2});
+        expect_top_3(7, {3, 2});
+        expect_top_3(8, {4, 3});
+        expect_top_3(9, {3, 2});
+    }
 }
 
 TEST_F(HnswIndexTest, 2d_vectors_inserted_and_removed)
@@ -654,6 +668,94 @@ TEST_F(HnswIndexTest, hnsw_graph_is_compacted)
     EXPECT_LT(mem_3.usedBytes(), mem_2.usedBytes());
 }
 
+TEST_F(HnswIndexTest, quantized_vectors_are_used_for_search_and_candidates_are_rescored)
+{
+    for (auto quantization : {VectorQuantization::Int8, VectorQuantization::Binary}) {
+        SCOPED_TRACE(quantization == VectorQuantization::Int8 ? "int8" : "binary");
+        init(true, quantization);
+        get_vectors().clear();
+        uint32_t doc_id = 1;
+        for (uint32_t x = 0; x < 10; ++x) {
+            for (uint32_t y = 0; y < 10; ++y) {
+                get_vectors().set(doc_id, { float(x) - 4.3f, float(y) * 0.7f - 3.1f });
+                ++doc_id;
+            }
+        }
+        uint32_t doc_id_end = doc_id;
+        for (doc_id = 1; doc_id < doc_id_end; ++doc_id) {
+            add_document(doc_id);
+            if (doc_id == 5) {
+                EXPECT_EQ(quantization == VectorQuantization::Binary, index->quantized_vectors()->ready());
+            }
+        }
+        ASSERT_TRUE(index->quantized_vectors()->ready());
+        SquaredEuclideanDistance distance_func(vespalib::eval::CellType::FLOAT);
+        for (uint32_t query_docid : {1u, 37u, 55u, 100u}) {
+            auto qv = get_vectors().get_vector(query_docid);
+            std::vector<double> exact;
+            for (doc_id = 1; doc_id < doc_id_end; ++doc_id) {
+                exact.push_back(distance_func.calc(qv, get_vectors().get_vector(doc_id)));
+            }
+            std::sort(exact.begin(), exact.end());
+            auto result = index->find_top_k(5, qv, 100, 1000.0);
+            ASSERT_EQ(5u, result.size());
+            std::vector<double> got;
+            for (const auto& hit : result) {
+                // Distances are calculated on the original vectors
+                EXPECT_EQ(distance_func.calc(qv, get_vectors().get_vector(hit.docid)), hit.distance);
+                got.push_back(hit.distance);
+            }
+            std::sort(got.begin(), got.end());
+            EXPECT_EQ(std::vector<double>(exact.begin(), exact.begin() + 5), got);
+        }
+        EXPECT_GT(index->quantized_vectors()->memory_usage().usedBytes(), 0u);
+    }
+}
+
+TEST(QuantizedVectorStoreTest, int8_distances_are_calculated_on_quantized_query_and_document_vectors)
+{
+    std::vector<std::vector<float>> vectors;
+    for (uint32_t i = 0; i < 50; ++i) {
+        std::vector<float> vector;
+        double norm_sq = 0.0;
+        for (uint32_t dim = 0; dim < 16; ++dim) {
+            vector.push_back(std::sin(i * 16 + dim + 1));
+            norm_sq += vector.back() * vector.back();
+        }
+        // Unit vectors, as assumed by the innerproduct distance metric
+        for (auto& value : vector) {
+            value /= std::sqrt(norm_sq);
+        }
+        vectors.push_back(std::move(vector));
+    }
+    for (auto metric : {DistanceMetric::Euclidean, DistanceMetric::Angular, DistanceMetric::InnerProduct}) {
+        SCOPED_TRACE(static_cast<int>(metric));
+        auto store = QuantizedVectorStore::make(VectorQuantization::Int8, metric, vespalib::eval::CellType::FLOAT, vectors.size());
+        ASSERT_TRUE(store);
+        for (const auto& vector : vectors) {
+            store->add_sample(vespalib::eval::TypedCells(vector));
+        }
+        ASSERT_TRUE(store->has_enough_samples());
+        store->train();
+        for (uint32_t docid = 0; docid < vectors.size(); ++docid) {
+            store->set(docid, vespalib::eval::TypedCells(vectors[docid]));
+        }
+        store->publish();
+        auto distance_func = make_distance_function(metric, vespalib::eval::CellType::FLOAT);
+        for (uint32_t query_docid : {0u, 17u, 42u}) {
+            vespalib::eval::TypedCells query_vector(vectors[query_docid]);
+            auto query = store->make_query(query_vector);
+            for (uint32_t docid = 0; docid < vectors.size(); ++docid) {
+                double exact = distance_func->calc(query_vector, vespalib::eval::TypedCells(vectors[docid]));
+                EXPECT_NEAR(exact, query.calc(docid), 0.02);
+            }
+        }
+    }
+    EXPECT_FALSE(QuantizedVectorStore::make(VectorQuantization::Int8, DistanceMetric::GeoDegrees, vespalib::eval::CellType::DOUBLE, 10));
+    EXPECT_FALSE(QuantizedVectorStore::make(VectorQuantization::Int8, DistanceMetric::Euclidean, vespalib::eval::CellType::INT8, 10));
+    EXPECT_TRUE(QuantizedVectorStore::make(VectorQuantization::Binary, DistanceMetric::Hamming, vespalib::eval::CellType::INT8, 10));
+}
+
 TEST(LevelGeneratorTest, gives_various_levels)
 {
     InvLogLevelGenerator generator(4);
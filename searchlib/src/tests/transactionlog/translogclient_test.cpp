@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include <vespa/searchlib/transactionlog/translogclient.h>
 #include <vespa/searchlib/transactionlog/translogserver.h>
+#include <vespa/searchlib/transactionlog/groupcommitter.h>
 #include <vespa/searchlib/test/directory_handler.h>
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/vespalib/objects/identifiable.h>
@@ -913,6 +914,114 @@ TEST("testSync") {
     EXPECT_EQUAL(syncedTo, TOTAL_NUM_ENTRIES);
 }
 
+TEST("test group commit over several domains") {
+    const unsigned int NUM_PACKETS = 20;
+    const unsigned int NUM_ENTRIES = 50;
+    const unsigned int TOTAL_NUM_ENTRIES = NUM_PACKETS * NUM_ENTRIES;
+
+    DummyFileHeaderContext fileHeaderContext;
+    test::DirectoryHandler testDir("test12");
+    DomainConfig domainConfig = createDomainConfig(0x1000000).setGroupCommit(true).setGroupCommitInterval(20ms);
+    {
+        TLS tlss(testDir.getDir(), 18377, ".", fileHeaderContext, domainConfig);
+        TransLogClient tls(tlss.transport, "tcp/localhost:18377");
+
+        createDomainTest(tls, "group1", 0);
+        createDomainTest(tls, "group2", 1);
+        fillDomainTest(tlss.tls, "group1", NUM_PACKETS, NUM_ENTRIES);
+        fillDomainTest(tlss.tls, "group2", NUM_PACKETS, NUM_ENTRIES);
+
+        // Every packet is committed as a separate chunk, and chunks arriving within the interval share a round.
+        size_t numCommits = 0;
+        for (const char * name : {"group1", "group2"}) {
+            numCommits += tlss.tls.getDomainStats()[name].commitLatency.count();
+        }
+        EXPECT_EQUAL(2 * NUM_PACKETS, numCommits);
+        ASSERT_TRUE(tlss.tls.getGroupCommitter() != nullptr);
+        EXPECT_GREATER(tlss.tls.getGroupCommitter()->getNumRounds(), 0u);
+        EXPECT_LESS(tlss.tls.getGroupCommitter()->getNumRounds(), numCommits);
+
+        for (const char * name : {"group1", "group2"}) {
+            auto s1 = openDomainTest(tls, name);
+            TEST_DO(assertStatus(*s1, 1, TOTAL_NUM_ENTRIES, TOTAL_NUM_ENTRIES));
+            TEST_DO(assertVisitStats(tls, name, 0, TOTAL_NUM_ENTRIES, 1, TOTAL_NUM_ENTRIES, TOTAL_NUM_ENTRIES, TOTAL_NUM_ENTRIES));
+            SerialNum syncedTo(0);
+            EXPECT_TRUE(s1->sync(TOTAL_NUM_ENTRIES, syncedTo));
+            EXPECT_EQUAL(syncedTo, TOTAL_NUM_ENTRIES);
+            const LatencyHistogram & latency = tlss.tls.getDomainStats()[name].commitLatency;
+            EXPECT_GREATER(latency.count(), 0u);
+            EXPECT_TRUE(latency.max() <= latency.total());
+        }
+    }
+    {
+        TLS tlss(testDir.getDir(), 18377, ".", fileHeaderContext, domainConfig);
+        TransLogClient tls(tlss.transport, "tcp/localhost:18377");
+        for (const char * name : {"group1", "group2"}) {
+            auto s1 = openDomainTest(tls, name);
+            TEST_DO(assertStatus(*s1, 1, TOTAL_NUM_ENTRIES, TOTAL_NUM_ENTRIES));
+            TEST_DO(assertVisitStats(tls, name, 0, TOTAL_NUM_ENTRIES, 1, TOTAL_NUM_ENTRIES, TOTAL_NUM_ENTRIES, TOTAL_NUM_ENTRIES));
+        }
+    }
+}
+
+TEST("test group commit rotates parts within a round") {
+    const unsigned int NUM_PACKETS = 40;
+    const unsigned int NUM_ENTRIES = 50;
+    const unsigned int TOTAL_NUM_ENTRIES = NUM_PACKETS * NUM_ENTRIES;
+    const size_t PART_SIZE_LIMIT = 0x1000;
+
+    DummyFileHeaderContext fileHeaderContext;
+    test::DirectoryHandler testDir("test12");
+    // A long interval lets many chunks share a round, which must still be split over several parts.
+    DomainConfig domainConfig = createDomainConfig(PART_SIZE_LIMIT).setGroupCommit(true).setGroupCommitInterval(100ms);
+    {
+        TLS tlss(testDir.getDir(), 18377, ".", fileHeaderContext, domainConfig);
+        TransLogClient tls(tlss.transport, "tcp/localhost:18377");
+
+        createDomainTest(tls, "rotate", 0);
+        fillDomainTest(tlss.tls, "rotate", NUM_PACKETS, NUM_ENTRIES);
+
+        DomainInfo domainInfo = tlss.tls.getDomainStats()["rotate"];
+        EXPECT_LESS(tlss.tls.getGroupCommitter()->getNumRounds(), domainInfo.commitLatency.count());
+        size_t numParts = domainInfo.parts.size();
+        ASSERT_LESS(2u, numParts);
+        size_t maxChunkSize = (domainInfo.byteSize / NUM_PACKETS) * 2;
+        for (size_t partId = 0; partId + 1 < numParts; ++partId) {
+            const PartInfo &part = domainInfo.parts[partId];
+            // Rotated after the first chunk taking it past the limit, as when committing chunk by chunk.
+            EXPECT_GREATER(part.byteSize, PART_SIZE_LIMIT);
+            EXPECT_LESS_EQUAL(part.byteSize, PART_SIZE_LIMIT + maxChunkSize);
+            EXPECT_EQUAL(part.range.to() + 1, domainInfo.parts[partId + 1].range.from());
+        }
+    }
+    {
+        TLS tlss(testDir.getDir(), 18377, ".", fileHeaderContext, domainConfig);
+        TransLogClient tls(tlss.transport, "tcp/localhost:18377");
+        auto s1 = openDomainTest(tls, "rotate");
+        TEST_DO(assertStatus(*s1, 1, TOTAL_NUM_ENTRIES, TOTAL_NUM_ENTRIES));
+        TEST_DO(assertVisitStats(tls, "rotate", 0, TOTAL_NUM_ENTRIES, 1, TOTAL_NUM_ENTRIES, TOTAL_NUM_ENTRIES, TOTAL_NUM_ENTRIES));
+    }
+}
+
+TEST("require that latency histogram uses power of two microsecond buckets") {
+    LatencyHistogram histogram;
+    histogram.add(0us);
+    histogram.add(3us);
+    histogram.add(1000us);
+    histogram.add(1h);
+    EXPECT_EQUAL(4u, histogram.count());
+    EXPECT_EQUAL(1u, histogram.bucketCount(0));
+    EXPECT_EQUAL(1u, histogram.bucketCount(2));
+    EXPECT_EQUAL(1u, histogram.bucketCount(10));
+    EXPECT_EQUAL(1u, histogram.bucketCount(LatencyHistogram::num_buckets - 1));
+    EXPECT_TRUE(histogram.max() == std::chrono::hours(1));
+    LatencyHistogram other;
+    other.add(3us);
+    histogram.merge(other);
+    EXPECT_EQUAL(5u, histogram.count());
+    EXPECT_EQUAL(2u, histogram.bucketCount(2));
+}
+
 TEST("test truncate on version mismatch") {
     const unsigned int NUM_PACKETS = 3;
     const unsigned int NUM_ENTRIES = 4;
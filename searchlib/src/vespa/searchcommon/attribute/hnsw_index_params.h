@@ -3,6 +3,7 @@
 #pragma once
 
 #include "distance_metric.h"
+#include "vector_quantization.h"
 
 namespace search::attribute {
 
@@ -17,28 +18,33 @@ private:
     // This is always the same as in the attribute config, and is duplicated here to simplify usage.
     DistanceMetric _distance_metric;
     bool _multi_threaded_indexing;
+    VectorQuantization _quantization;
 
 public:
     HnswIndexParams(uint32_t max_links_per_node_in,
                     uint32_t neighbors_to_explore_at_insert_in,
                     DistanceMetric distance_metric_in,
-                    bool multi_threaded_indexing_in = false) noexcept
+                    bool multi_threaded_indexing_in = false,
+                    VectorQuantization quantization_in = VectorQuantization::None) noexcept
             : _max_links_per_node(max_links_per_node_in),
               _neighbors_to_explore_at_insert(neighbors_to_explore_at_insert_in),
               _distance_metric(distance_metric_in),
-              _multi_threaded_indexing(multi_threaded_indexing_in)
+              _multi_threaded_indexing(multi_threaded_indexing_in),
+              _quantization(quantization_in)
     {}
 
     uint32_t max_links_per_node() const { return _max_links_per_node; }
     uint32_t neighbors_to_explore_at_insert() const { return _neighbors_to_explore_at_insert; }
     DistanceMetric distance_metric() const { return _distance_metric; }
     bool multi_threaded_indexing() const { return _multi_threaded_indexing; }
+    VectorQuantization quantization() const { return _quantization; }
 
     bool operator==(const HnswIndexParams& rhs) const {
         return (_max_links_per_node == rhs._max_links_per_node &&
                 _neighbors_to_explore_at_insert == rhs._neighbors_to_explore_at_insert &&
                 _distance_metric == rhs._distance_metric &&
-                _multi_threaded_indexing == rhs._multi_threaded_indexing);
+                _multi_threaded_indexing == rhs._multi_threaded_indexing &&
+                _quantization == rhs._quantization);
     }
 };
 
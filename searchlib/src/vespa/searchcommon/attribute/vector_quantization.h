@@ -0,0 +1,12 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+namespace search::attribute {
+
+/**
+ * Quantization of the in-memory vector copies used when traversing a nearest neighbor index.
+ */
+enum class VectorQuantization { None, Int8, Binary };
+
+}
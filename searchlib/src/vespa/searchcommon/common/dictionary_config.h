@@ -13,15 +13,21 @@ class DictionaryConfig {
 public:
     enum class Type { BTREE, HASH, BTREE_AND_HASH };
     enum class Match { CASED, UNCASED };
-    DictionaryConfig() noexcept : _type(Type::BTREE), _match(Match::UNCASED) {}
-    DictionaryConfig(Type type) noexcept : _type(type), _match(Match::UNCASED) {}
-    DictionaryConfig(Type type, Match match) noexcept : _type(type), _match(match) {}
+    DictionaryConfig() noexcept : _type(Type::BTREE), _match(Match::UNCASED), _trigram_index(false) {}
+    DictionaryConfig(Type type) noexcept : _type(type), _match(Match::UNCASED), _trigram_index(false) {}
+    DictionaryConfig(Type type, Match match) noexcept : _type(type), _match(match), _trigram_index(false) {}
+    DictionaryConfig(Type type, Match match, bool trigram_index) noexcept : _type(type), _match(match), _trigram_index(trigram_index) {}
     Type getType() const { return _type; }
     Match getMatch() const { return _match; }
-    bool operator == (const DictionaryConfig & b) const { return (_type == b._type) && (_match == b._match); }
+    // Index unique string values by trigrams, used to speed up regex, substring and suffix search
+    bool get_trigram_index() const { return _trigram_index; }
+    bool operator == (const DictionaryConfig & b) const {
+        return (_type == b._type) && (_match == b._match) && (_trigram_index == b._trigram_index);
+    }
 private:
     Type  _type;
     Match _match;
+    bool  _trigram_index;
 };
 
 std::ostream& operator<<(std::ostream& os, const DictionaryConfig & cfg);
@@ -127,7 +127,9 @@ Schema::Field::operator!=(const Field &rhs) const
 Schema::IndexField::IndexField(vespalib::stringref name, DataType dt) noexcept
     : Field(name, dt),
       _avgElemLen(512),
-      _interleaved_features(false)
+      _interleaved_features(false),
+      _block_postings(false),
+      _block_max(false)
 {
 }
 
@@ -135,14 +137,18 @@ Schema::IndexField::IndexField(vespalib::stringref name, DataType dt,
                                CollectionType ct) noexcept
     : Field(name, dt, ct),
       _avgElemLen(512),
-      _interleaved_features(false)
+      _interleaved_features(false),
+      _block_postings(false),
+      _block_max(false)
 {
 }
 
 Schema::IndexField::IndexField(const config::StringVector &lines)
     : Field(lines),
       _avgElemLen(ConfigParser::parse<int32_t>("averageelementlen", lines, 512)),
-      _interleaved_features(ConfigParser::parse<bool>("interleavedfeatures", lines, false))
+      _interleaved_features(ConfigParser::parse<bool>("interleavedfeatures", lines, false)),
+      _block_postings(ConfigParser::parse<bool>("blockpostings", lines, false)),
+      _block_max(ConfigParser::parse<bool>("blockmax", lines, false))
 {
 }
 
@@ -157,6 +163,8 @@ Schema::IndexField::write(vespalib::asciistream & os, vespalib::stringref prefix
     Field::write(os, prefix);
     os << prefix << "averageelementlen " << static_cast<int32_t>(_avgElemLen) << "\n";
     os << prefix << "interleavedfeatures " << (_interleaved_features ? "true" : "false") << "\n";
+    os << prefix << "blockpostings " << (_block_postings ? "true" : "false") << "\n";
+    os << prefix << "blockmax " << (_block_max ? "true" : "false") << "\n";
 
     // TODO: Remove prefix, phrases and positions when breaking downgrade is no longer an issue.
     os << prefix << "prefix false" << "\n";
@@ -169,7 +177,9 @@ Schema::IndexField::operator==(const IndexField &rhs) const
 {
     return Field::operator==(rhs) &&
             _avgElemLen == rhs._avgElemLen &&
-            _interleaved_features == rhs._interleaved_features;
+            _interleaved_features == rhs._interleaved_features &&
+            _block_postings == rhs._block_postings &&
+            _block_max == rhs._block_max;
 }
 
 bool
@@ -177,7 +187,9 @@ Schema::IndexField::operator!=(const IndexField &rhs) const
 {
     return Field::operator!=(rhs) ||
             _avgElemLen != rhs._avgElemLen ||
-            _interleaved_features != rhs._interleaved_features;
+            _interleaved_features != rhs._interleaved_features ||
+            _block_postings != rhs._block_postings ||
+            _block_max != rhs._block_max;
 }
 
 Schema::FieldSet::FieldSet(const config::StringVector & lines) :
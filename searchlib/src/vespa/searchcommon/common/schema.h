@@ -79,6 +79,8 @@ public:
         uint32_t _avgElemLen;
         // TODO: Remove when posting list format with interleaved features is made default
         bool _interleaved_features;
+        bool _block_postings;
+        bool _block_max;
 
     public:
         IndexField(vespalib::stringref name, DataType dt) noexcept;
@@ -97,12 +99,22 @@ public:
             _interleaved_features = value;
             return *this;
         }
+        IndexField &set_block_postings(bool value) {
+            _block_postings = value;
+            return *this;
+        }
+        IndexField &set_block_max(bool value) {
+            _block_max = value;
+            return *this;
+        }
 
         void write(vespalib::asciistream &os,
                    vespalib::stringref prefix) const override;
 
         uint32_t getAvgElemLen() const { return _avgElemLen; }
         bool use_interleaved_features() const { return _interleaved_features; }
+        bool use_block_postings() const { return _block_postings; }
+        bool use_block_max() const { return _block_max; }
 
         bool operator==(const IndexField &rhs) const;
         bool operator!=(const IndexField &rhs) const;
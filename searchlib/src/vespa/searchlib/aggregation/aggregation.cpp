@@ -6,6 +6,7 @@
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/vespalib/objects/visit.hpp>
 #include <xxhash.h>
+#include <cmath>
 
 using namespace search::expression;
 
@@ -45,6 +46,7 @@ IMPLEMENT_AGGREGATIONRESULT(AverageAggregationResult, AggregationResult);
 IMPLEMENT_AGGREGATIONRESULT(XorAggregationResult,     AggregationResult);
 IMPLEMENT_AGGREGATIONRESULT(ExpressionCountAggregationResult, AggregationResult);
 IMPLEMENT_AGGREGATIONRESULT(StandardDeviationAggregationResult, AggregationResult);
+IMPLEMENT_AGGREGATIONRESULT(UniqueCountAggregationResult, AggregationResult);
 
 AggregationResult::AggregationResult() :
     _expressionTree(std::make_shared<ExpressionTree>()),
@@ -547,6 +549,105 @@ ExpressionCountAggregationResult::onDeserialize(Deserializer &is) {
 ExpressionCountAggregationResult::ExpressionCountAggregationResult() = default;
 ExpressionCountAggregationResult::~ExpressionCountAggregationResult() = default;
 
+namespace {
+// Estimates the number of unique hashes in the sketch. This is the
+// HyperLogLog estimate used by the QR server, except that the raw
+// estimate is not bias corrected for medium cardinalities.
+template <int BucketBits, typename HashT>
+int64_t
+estimateUniqueCount(const Sketch<BucketBits, HashT> &sketch) {
+    if (sketch.getClassId() == SparseSketch<BucketBits, HashT>::classId) {
+        return static_cast<const SparseSketch<BucketBits, HashT>&>(sketch)
+            .getSize();
+    }
+    const auto &normal = static_cast<const NormalSketch<BucketBits, HashT>&>(sketch);
+    const double m = sketch.BUCKET_COUNT;
+    const double linear_counting_threshold = 900; // for 10 bucket bits
+    double sum = 0.0;
+    size_t zero_buckets = 0;
+    for (size_t i = 0; i < sketch.BUCKET_COUNT; ++i) {
+        sum += std::ldexp(1.0, -normal.bucket[i]);
+        if (normal.bucket[i] == 0) {
+            ++zero_buckets;
+        }
+    }
+    double estimate = (0.7213 / (1 + 1.079 / m)) * m * m / sum;
+    if (zero_buckets > 0) {
+        double linear_counting = m * std::log(m / zero_buckets);
+        if (linear_counting <= linear_counting_threshold) {
+            estimate = linear_counting;
+        }
+    }
+    return std::llround(estimate);
+}
+}  // namespace
+
+void
+UniqueCountAggregationResult::aggregateHash(const ResultNode &result) {
+    size_t hash = result.hash();
+    const unsigned int seed = 42;
+    hash = XXH32(&hash, sizeof(hash), seed);
+    if (_hll.aggregate(hash) != 0) {
+        _estimateValid = false;
+    }
+}
+void
+UniqueCountAggregationResult::onAggregate(const ResultNode &result) {
+    if (result.isMultiValue()) {
+        const auto & v = static_cast<const ResultNodeVector &>(result);
+        for (size_t i(0), m(v.size()); i < m; i++) {
+            aggregateHash(v.get(i));
+        }
+    } else {
+        aggregateHash(result);
+    }
+}
+void
+UniqueCountAggregationResult::onMerge(const AggregationResult &r) {
+    const auto & result = Identifiable::cast<const UniqueCountAggregationResult &>(r);
+    _hll.merge(result._hll);
+    _estimateValid = false;
+}
+void
+UniqueCountAggregationResult::onReset() {
+    _hll = HyperLogLog<PRECISION>();
+    _estimateValid = false;
+}
+const ResultNode &
+UniqueCountAggregationResult::onGetRank() const {
+    // The estimate looks at all buckets, so it is only recalculated
+    // when asked for after the sketch has changed.
+    if (!_estimateValid) {
+        _estimate.set(estimateUniqueCount(_hll.getSketch()));
+        _estimateValid = true;
+    }
+    return _estimate;
+}
+Serializer &
+UniqueCountAggregationResult::onSerialize(Serializer &os) const {
+    AggregationResult::onSerialize(os);
+    _hll.serialize(os);
+    return os;
+}
+Deserializer &
+UniqueCountAggregationResult::onDeserialize(Deserializer &is) {
+    AggregationResult::onDeserialize(is);
+    _hll.deserialize(is);
+    _estimateValid = false;
+    return is;
+}
+void
+UniqueCountAggregationResult::visitMembers(vespalib::ObjectVisitor &visitor) const
+{
+    AggregationResult::visitMembers(visitor);
+    visit(visitor, "estimatedUniqueCount", getEstimatedUniqueCount());
+}
+
+UniqueCountAggregationResult::UniqueCountAggregationResult()
+    : AggregationResult(), _hll(), _estimate(), _estimateValid(true)
+{ }
+UniqueCountAggregationResult::~UniqueCountAggregationResult() = default;
+
 StandardDeviationAggregationResult::StandardDeviationAggregationResult()
     : AggregationResult(), _count(), _sum(), _sumOfSquared(), _stdDevScratchPad()
 {
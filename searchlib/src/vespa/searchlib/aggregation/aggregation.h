@@ -9,6 +9,7 @@
 #include "xoraggregationresult.h"
 #include "hitsaggregationresult.h"
 #include "standarddeviationaggregationresult.h"
+#include "uniquecountaggregationresult.h"
 #include "grouping.h"
 #include <vespa/searchlib/common/identifiable.h>
 #include <vespa/searchlib/common/rankedhit.h>
@@ -0,0 +1,242 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "columnargrouper.h"
+#include "grouping.h"
+#include "countaggregationresult.h"
+#include "sumaggregationresult.h"
+#include "minaggregationresult.h"
+#include "maxaggregationresult.h"
+#include <vespa/searchlib/expression/attributenode.h>
+#include <vespa/searchlib/expression/integerresultnode.h>
+#include <vespa/searchlib/expression/floatresultnode.h>
+#include <vespa/searchcommon/attribute/iattributevector.h>
+#include <cmath>
+#include <limits>
+
+namespace search::aggregation {
+
+using search::expression::AttributeNode;
+using search::expression::ExpressionNode;
+using search::expression::FloatResultNode;
+using search::expression::Int64ResultNode;
+
+namespace {
+
+/**
+ * Returns the attribute read by the given expression if it is a plain
+ * attribute node over a single value attribute, otherwise nullptr.
+ **/
+const attribute::IAttributeVector *
+singleValueAttribute(const ExpressionNode * expr)
+{
+    if ((expr == nullptr) || (expr->getClass().id() != AttributeNode::classId)) {
+        return nullptr;
+    }
+    const auto * attr = static_cast<const AttributeNode *>(expr)->getAttribute();
+    return ((attr != nullptr) && !attr->hasMultiValue()) ? attr : nullptr;
+}
+
+}
+
+ColumnarGrouper::Column::Column(Op op_, const IAttributeVector * attr_, bool isFloat_)
+    : op(op_),
+      attr(attr_),
+      isFloat(isFloat_),
+      intAcc(),
+      floatAcc()
+{ }
+
+ColumnarGrouper::Column::Column(Column &&) noexcept = default;
+ColumnarGrouper::Column::~Column() = default;
+
+ColumnarGrouper::ColumnarGrouper(const IAttributeVector & key, bool keyIsEnum)
+    : _key(key),
+      _keyIsEnum(keyIsEnum),
+      _slots(),
+      _firstDoc(),
+      _rank(),
+      _count(),
+      _columns()
+{ }
+
+ColumnarGrouper::~ColumnarGrouper() = default;
+
+ColumnarGrouper::UP
+ColumnarGrouper::create(const Grouping & grouping)
+{
+    if ((grouping.getLevels().size() != 1) || (grouping.getFirstLevel() != 0) || (grouping.getLastLevel() < 1)) {
+        return {};
+    }
+    const Group & root = grouping.getRoot();
+    if ((root.getAggrSize() != 0) || (root.getChildrenSize() != 0)) {
+        return {};
+    }
+    const GroupingLevel & level = grouping.getLevels()[0];
+    const IAttributeVector * key = singleValueAttribute(level.getExpression().getRoot());
+    if (key == nullptr) {
+        return {};
+    }
+    bool keyIsEnum = key->isStringType() && key->hasEnum();
+    if (!keyIsEnum && !key->isIntegerType()) {
+        return {};
+    }
+    const Group & proto = level.getGroupPrototype();
+    if (proto.getChildrenSize() != 0) {
+        return {};
+    }
+    UP grouper(new ColumnarGrouper(*key, keyIsEnum));
+    for (size_t i(0), m(proto.getAggrSize()); i < m; i++) {
+        const AggregationResult & aggr = proto.getAggregationResult(i);
+        const ExpressionNode * expr = aggr.getExpression();
+        uint32_t classId = aggr.getClass().id();
+        if (classId == CountAggregationResult::classId) {
+            if ((expr != nullptr) && expr->getResult().isMultiValue()) {
+                return {};
+            }
+            grouper->addColumn(Op::COUNT, nullptr, false);
+            continue;
+        }
+        Op op;
+        if (classId == SumAggregationResult::classId) {
+            op = Op::SUM;
+        } else if (classId == MinAggregationResult::classId) {
+            op = Op::MIN;
+        } else if (classId == MaxAggregationResult::classId) {
+            op = Op::MAX;
+        } else {
+            return {};
+        }
+        const IAttributeVector * attr = singleValueAttribute(expr);
+        if (attr == nullptr) {
+            return {};
+        }
+        uint32_t resultClassId = aggr.getResult().getClass().id();
+        if (attr->isIntegerType() && (resultClassId == Int64ResultNode::classId)) {
+            grouper->addColumn(op, attr, false);
+        } else if (attr->isFloatingPointType() && (resultClassId == FloatResultNode::classId)) {
+            grouper->addColumn(op, attr, true);
+        } else {
+            return {};
+        }
+    }
+    return grouper;
+}
+
+uint64_t
+ColumnarGrouper::getKey(DocId docId) const
+{
+    return _keyIsEnum ? _key.getEnum(docId) : static_cast<uint64_t>(_key.getInt(docId));
+}
+
+uint32_t
+ColumnarGrouper::getSlot(DocId docId, HitRank rank)
+{
+    uint32_t nextSlot = _firstDoc.size();
+    auto res = _slots.insert(std::make_pair(getKey(docId), nextSlot));
+    uint32_t slot = res.first->second;
+    if (slot == nextSlot) {
+        // Same rank handling as Group::setRank() and Group::updateRank().
+        _firstDoc.push_back(docId);
+        _rank.push_back(std::isnan(rank) ? -HUGE_VAL : rank);
+        _count.push_back(0);
+        for (Column & c : _columns) {
+            if (c.isFloat) {
+                c.floatAcc.push_back((c.op == Op::MIN) ? std::numeric_limits<double>::max()
+                                     : (c.op == Op::MAX) ? -std::numeric_limits<double>::max() : 0.0);
+            } else {
+                c.intAcc.push_back((c.op == Op::MIN) ? std::numeric_limits<int64_t>::max()
+                                   : (c.op == Op::MAX) ? std::numeric_limits<int64_t>::min() : 0);
+            }
+        }
+    } else {
+        _rank[slot] = std::max(_rank[slot], rank);
+    }
+    return slot;
+}
+
+template <typename T, typename F>
+void
+ColumnarGrouper::accumulate(std::vector<T> & acc, const uint32_t * slots, const T * values, uint32_t num, F op)
+{
+    T * a = acc.data();
+    for (uint32_t i(0); i < num; i++) {
+        op(a[slots[i]], values[i]);
+    }
+}
+
+template <typename T>
+void
+ColumnarGrouper::apply(Op op, std::vector<T> & acc, const uint32_t * slots, const T * values, uint32_t num)
+{
+    switch (op) {
+    case Op::SUM:
+        accumulate(acc, slots, values, num, [](T & a, T v) { a += v; });
+        break;
+    case Op::MIN:
+        accumulate(acc, slots, values, num, [](T & a, T v) { if (v < a) { a = v; } });
+        break;
+    case Op::MAX:
+        accumulate(acc, slots, values, num, [](T & a, T v) { if (v > a) { a = v; } });
+        break;
+    case Op::COUNT:
+        break;
+    }
+}
+
+void
+ColumnarGrouper::aggregate(const DocId * docIds, const HitRank * ranks, uint32_t num)
+{
+    uint32_t slots[block_size];
+    for (uint32_t i(0); i < num; i++) {
+        slots[i] = getSlot(docIds[i], ranks[i]);
+    }
+    for (uint32_t i(0); i < num; i++) {
+        _count[slots[i]]++;
+    }
+    int64_t intValues[block_size];
+    double floatValues[block_size];
+    for (Column & c : _columns) {
+        if (c.op == Op::COUNT) {
+            continue;
+        }
+        if (c.isFloat) {
+            for (uint32_t i(0); i < num; i++) {
+                floatValues[i] = c.attr->getFloat(docIds[i]);
+            }
+            apply(c.op, c.floatAcc, slots, floatValues, num);
+        } else {
+            for (uint32_t i(0); i < num; i++) {
+                intValues[i] = c.attr->getInt(docIds[i]);
+            }
+            apply(c.op, c.intAcc, slots, intValues, num);
+        }
+    }
+}
+
+void
+ColumnarGrouper::materialize(Group & root, const GroupingLevel & level) const
+{
+    const auto & selector = level.getExpression();
+    for (uint32_t slot(0), m(getNumGroups()); slot < m; slot++) {
+        if (!selector.execute(_firstDoc[slot], _rank[slot])) {
+            throw std::runtime_error("Does not know how to handle failed select statements");
+        }
+        Group * group = root.groupSingle(selector.getResult(), _rank[slot], level);
+        if (group == nullptr) {
+            continue;
+        }
+        for (size_t i(0), n(_columns.size()); i < n; i++) {
+            const Column & c = _columns[i];
+            AggregationResult & aggr = group->getAggregationResult(i);
+            if (c.op == Op::COUNT) {
+                static_cast<CountAggregationResult &>(aggr).setCount(_count[slot]);
+            } else if (c.isFloat) {
+                aggr.getResult().set(FloatResultNode(c.floatAcc[slot]));
+            } else {
+                aggr.getResult().set(Int64ResultNode(c.intAcc[slot]));
+            }
+        }
+    }
+}
+
+}
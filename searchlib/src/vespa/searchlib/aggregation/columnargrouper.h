@@ -0,0 +1,80 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/searchlib/common/hitrank.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <memory>
+#include <vector>
+
+namespace search::attribute { class IAttributeVector; }
+
+namespace search::aggregation {
+
+class Group;
+class Grouping;
+class GroupingLevel;
+
+/**
+ * Columnar fast path for single level groupings like
+ * all(group(a) each(output(count(), sum(b), min(c), max(d)))) where
+ * the group key is a single value integer or enumerated string
+ * attribute and the aggregators only read single value numeric
+ * attributes.
+ *
+ * Hits are processed in blocks. Group keys and aggregated values are
+ * read directly from the attribute vectors and accumulated into dense
+ * per group arrays, avoiding expression evaluation and group hash
+ * lookups for each hit. Groups are created in the order they were
+ * first seen when the result is materialized into the grouping tree,
+ * so the outcome is the same as with the generic path.
+ **/
+class ColumnarGrouper
+{
+public:
+    using UP = std::unique_ptr<ColumnarGrouper>;
+    using DocId = uint32_t;
+    using IAttributeVector = attribute::IAttributeVector;
+    static constexpr uint32_t block_size = 128;
+
+    /**
+     * Returns a grouper for the given grouping, or nullptr if the
+     * grouping is not eligible for the columnar path. Must be called
+     * after the grouping has been configured and prepared.
+     **/
+    static UP create(const Grouping & grouping);
+
+    ~ColumnarGrouper();
+    void aggregate(const DocId * docIds, const HitRank * ranks, uint32_t num);
+    void materialize(Group & root, const GroupingLevel & level) const;
+    uint32_t getNumGroups() const { return _firstDoc.size(); }
+private:
+    enum class Op { COUNT, SUM, MIN, MAX };
+    struct Column {
+        Column(Op op_, const IAttributeVector * attr_, bool isFloat_);
+        Column(Column &&) noexcept;
+        ~Column();
+        Op                       op;
+        const IAttributeVector * attr;
+        bool                     isFloat;
+        std::vector<int64_t>     intAcc;
+        std::vector<double>      floatAcc;
+    };
+    ColumnarGrouper(const IAttributeVector & key, bool keyIsEnum);
+    void addColumn(Op op, const IAttributeVector * attr, bool isFloat) { _columns.emplace_back(op, attr, isFloat); }
+    uint64_t getKey(DocId docId) const;
+    uint32_t getSlot(DocId docId, HitRank rank);
+    template <typename T, typename F>
+    static void accumulate(std::vector<T> & acc, const uint32_t * slots, const T * values, uint32_t num, F op);
+    template <typename T>
+    static void apply(Op op, std::vector<T> & acc, const uint32_t * slots, const T * values, uint32_t num);
+
+    const IAttributeVector             & _key;
+    bool                                 _keyIsEnum;
+    vespalib::hash_map<uint64_t, uint32_t> _slots;
+    std::vector<DocId>                   _firstDoc;
+    std::vector<HitRank>                 _rank;
+    std::vector<uint64_t>                _count;
+    std::vector<Column>                  _columns;
+};
+
+}
@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "grouping.h"
+#include "columnargrouper.h"
 #include "hitsaggregationresult.h"
 #include <vespa/searchlib/expression/stringresultnode.h>
 #include <vespa/searchlib/expression/enumresultnode.h>
@@ -214,13 +215,50 @@ void Grouping::aggregateWithClock(const RankedHit * rankedHit, unsigned int len)
     }
 }
 
+/**
+ * Feed hits to the columnar grouper one block at a time. When a clock is
+ * given, the time of doom is checked between blocks.
+ **/
+void Grouping::aggregateColumnar(ColumnarGrouper & grouper, const RankedHit * rankedHit, unsigned int len) {
+    DocId docIds[ColumnarGrouper::block_size];
+    HitRank ranks[ColumnarGrouper::block_size];
+    for (unsigned int i(0); (i < len) && ((_clock == NULL) || !hasExpired()); ) {
+        uint32_t n(0);
+        for (; (n < ColumnarGrouper::block_size) && (i < len); n++, i++) {
+            docIds[n] = rankedHit[i].getDocId();
+            ranks[n] = rankedHit[i].getRank();
+        }
+        grouper.aggregate(docIds, ranks, n);
+    }
+}
+
+void Grouping::aggregateColumnar(ColumnarGrouper & grouper, const BitVector & bVec) {
+    DocId docIds[ColumnarGrouper::block_size];
+    HitRank ranks[ColumnarGrouper::block_size] = {};
+    unsigned int sz(bVec.size());
+    size_t maxHits = (getTopN() > 0) ? getMaxN(sz) : sz;
+    size_t seen(0);
+    DocId d(bVec.getFirstTrueBit());
+    while ((d < sz) && (seen < maxHits) && ((_clock == NULL) || !hasExpired())) {
+        uint32_t n(0);
+        for (; (n < ColumnarGrouper::block_size) && (d < sz) && (seen < maxHits); n++, seen++, d = bVec.getNextTrueBit(d+1)) {
+            docIds[n] = d;
+        }
+        grouper.aggregate(docIds, ranks, n);
+    }
+}
+
 void Grouping::aggregate(const RankedHit * rankedHit, unsigned int len)
 {
     bool isOrdered(! needResort());
     preAggregate(isOrdered);
     HitsAggregationResult::SetOrdered pred;
     select(pred, pred);
-    if (_clock == NULL) {
+    auto columnar = ColumnarGrouper::create(*this);
+    if (columnar) {
+        aggregateColumnar(*columnar, rankedHit, getMaxN(len));
+        columnar->materialize(_root, _levels[0]);
+    } else if (_clock == NULL) {
         aggregateWithoutClock(rankedHit, getMaxN(len));
     } else {
         aggregateWithClock(rankedHit, getMaxN(len));
@@ -231,6 +269,16 @@ void Grouping::aggregate(const RankedHit * rankedHit, unsigned int len)
 void Grouping::aggregate(const RankedHit * rankedHit, unsigned int len, const BitVector * bVec)
 {
     preAggregate(false);
+    auto columnar = ColumnarGrouper::create(*this);
+    if (columnar) {
+        aggregateColumnar(*columnar, rankedHit, getMaxN(len));
+        if (bVec != NULL) {
+            aggregateColumnar(*columnar, *bVec);
+        }
+        columnar->materialize(_root, _levels[0]);
+        postProcess();
+        return;
+    }
     if (_clock == NULL) {
         aggregateWithoutClock(rankedHit, getMaxN(len));
     } else {
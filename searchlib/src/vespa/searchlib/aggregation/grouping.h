@@ -12,6 +12,8 @@ namespace search {
 
 namespace search::aggregation {
 
+class ColumnarGrouper;
+
 /**
  * This class represents a top-level grouping request.
  **/
@@ -36,6 +38,8 @@ private:
     bool hasExpired() const { return _clock->getTimeNS() > _timeOfDoom; }
     void aggregateWithoutClock(const RankedHit * rankedHit, unsigned int len);
     void aggregateWithClock(const RankedHit * rankedHit, unsigned int len);
+    void aggregateColumnar(ColumnarGrouper & grouper, const RankedHit * rankedHit, unsigned int len);
+    void aggregateColumnar(ColumnarGrouper & grouper, const BitVector & bVec);
     void postProcess();
 public:
     DECLARE_IDENTIFIABLE_NS2(search, aggregation, Grouping);
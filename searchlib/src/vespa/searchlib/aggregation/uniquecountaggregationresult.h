@@ -0,0 +1,38 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "aggregationresult.h"
+#include <vespa/searchlib/grouping/hyperloglog.h>
+#include <vespa/searchlib/expression/integerresultnode.h>
+
+namespace search::aggregation {
+
+/**
+ * Estimates the number of unique values of an expression within a
+ * group. Each element of a multi-value result is counted. The
+ * HyperLogLog sketch is serialized with the result, so that results
+ * from different nodes can be merged before the final estimate is
+ * made on the QR server. The rank is the estimated unique count.
+ */
+class UniqueCountAggregationResult : public AggregationResult {
+    static const int PRECISION = 10;
+
+    HyperLogLog<PRECISION> _hll;
+    mutable expression::Int64ResultNode _estimate;
+    mutable bool _estimateValid;
+
+    const ResultNode & onGetRank() const override;
+    void onPrepare(const ResultNode &, bool) override { }
+    void aggregateHash(const ResultNode &result);
+public:
+    DECLARE_AGGREGATIONRESULT(UniqueCountAggregationResult);
+    UniqueCountAggregationResult();
+    ~UniqueCountAggregationResult();
+
+    void visitMembers(vespalib::ObjectVisitor &visitor) const override;
+    const Sketch<PRECISION, uint32_t> &getSketch() const { return _hll.getSketch(); }
+    int64_t getEstimatedUniqueCount() const { return onGetRank().getInteger(); }
+};
+
+}
@@ -8,17 +8,22 @@
 #include <memory>
 #include <mutex>
 
-namespace search { class BitVector; }
+namespace search {
+class BitVector;
+class CompressedBitVector;
+}
 namespace search::attribute {
 
 /**
  * Class that caches posting lists (as bit vectors) for a set of search terms.
+ * Sparse posting lists are cached as compressed bit vectors.
  *
  * Lifetime of cached bit vectors is controlled by calling clear() at regular intervals.
  */
 class BitVectorSearchCache {
 public:
     using BitVectorSP = std::shared_ptr<BitVector>;
+    using CompressedBitVectorSP = std::shared_ptr<CompressedBitVector>;
     using ReadGuardUP = IDocumentMetaStoreContext::IReadGuard::UP;
 
     struct Entry {
@@ -26,10 +31,14 @@ public:
         // We need to keep a document meta store read guard to ensure that no lids that are cached
         // in the bit vector are re-used until the guard is released.
         ReadGuardUP dmsReadGuard;
+        // Exactly one of bitVector and compressedBitVector is set.
         BitVectorSP bitVector;
+        CompressedBitVectorSP compressedBitVector;
         uint32_t docIdLimit;
         Entry(ReadGuardUP dmsReadGuard_, BitVectorSP bitVector_, uint32_t docIdLimit_) noexcept
-            : dmsReadGuard(std::move(dmsReadGuard_)), bitVector(std::move(bitVector_)), docIdLimit(docIdLimit_) {}
+            : dmsReadGuard(std::move(dmsReadGuard_)), bitVector(std::move(bitVector_)), compressedBitVector(), docIdLimit(docIdLimit_) {}
+        Entry(ReadGuardUP dmsReadGuard_, CompressedBitVectorSP compressedBitVector_, uint32_t docIdLimit_) noexcept
+            : dmsReadGuard(std::move(dmsReadGuard_)), bitVector(), compressedBitVector(std::move(compressedBitVector_)), docIdLimit(docIdLimit_) {}
     };
 
 private:
@@ -76,7 +76,7 @@ convert(AttributesConfig::Attribute::Dictionary::Match match_cfg) {
 
 DictionaryConfig
 convert_dictionary(const AttributesConfig::Attribute::Dictionary & dictionary) {
-    return DictionaryConfig(convert(dictionary.type), convert(dictionary.match));
+    return DictionaryConfig(convert(dictionary.type), convert(dictionary.match), dictionary.trigramindex);
 }
 
 Config::Match
@@ -137,9 +137,23 @@ ConfigConverter::convert(const AttributesConfig::Attribute & cfg)
     }
     retval.set_distance_metric(dm);
     if (cfg.index.hnsw.enabled) {
+        using CfgQuantization = AttributesConfig::Attribute::Index::Hnsw::Quantization;
+        VectorQuantization quantization(VectorQuantization::None);
+        switch (cfg.index.hnsw.quantization) {
+            case CfgQuantization::NONE:
+                quantization = VectorQuantization::None;
+                break;
+            case CfgQuantization::INT8:
+                quantization = VectorQuantization::Int8;
+                break;
+            case CfgQuantization::BINARY:
+                quantization = VectorQuantization::Binary;
+                break;
+        }
         retval.set_hnsw_index_params(HnswIndexParams(cfg.index.hnsw.maxlinkspernode,
                                                      cfg.index.hnsw.neighborstoexploreatinsert,
-                                                     dm, cfg.index.hnsw.multithreadedindexing));
+                                                     dm, cfg.index.hnsw.multithreadedindexing,
+                                                     quantization));
     }
     if (retval.basicType().type() == BasicType::Type::TENSOR) {
         if (!cfg.tensortype.empty()) {
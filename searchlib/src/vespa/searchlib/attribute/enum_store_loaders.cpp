@@ -92,6 +92,7 @@ void
 EnumeratedLoader::build_dictionary()
 {
     _store.get_dictionary().build(_indexes);
+    _store.build_trigram_index();
     release_enum_indexes();
 }
 
@@ -129,6 +130,7 @@ EnumeratedPostingsLoader::build_dictionary()
 {
     attribute::LoadedEnumAttributeVector().swap(_loaded_enums);
     _store.get_dictionary().build_with_payload(_indexes, _posting_indexes);
+    _store.build_trigram_index();
     release_enum_indexes();
     EntryRefVector().swap(_posting_indexes);
 }
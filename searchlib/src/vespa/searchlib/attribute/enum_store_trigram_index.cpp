@@ -0,0 +1,210 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "enum_store_trigram_index.h"
+#include <vespa/vespalib/btree/btree.hpp>
+#include <vespa/vespalib/btree/btreebuilder.hpp>
+#include <vespa/vespalib/btree/btreeiterator.hpp>
+#include <vespa/vespalib/btree/btreenode.hpp>
+#include <vespa/vespalib/btree/btreenodeallocator.hpp>
+#include <vespa/vespalib/btree/btreenodestore.hpp>
+#include <vespa/vespalib/btree/btreeroot.hpp>
+#include <vespa/vespalib/datastore/unique_store_remapper.h>
+#include <vespa/vespalib/util/memoryusage.h>
+#include <algorithm>
+
+namespace search::enumstore {
+
+namespace {
+
+uint8_t
+fold(char c) noexcept
+{
+    return ((c >= 'A') && (c <= 'Z')) ? (c + ('a' - 'A')) : static_cast<uint8_t>(c);
+}
+
+// Letters that are case folded together with non-ascii characters (long s and kelvin sign)
+bool
+is_foldable_to_non_ascii(char c) noexcept
+{
+    return (c == 's') || (c == 'S') || (c == 'k') || (c == 'K');
+}
+
+void
+append_trigrams(vespalib::stringref value, TrigramIndex::TrigramVector &trigrams)
+{
+    for (size_t i = 2; i < value.size(); ++i) {
+        trigrams.push_back((fold(value[i - 2]) << 16) | (fold(value[i - 1]) << 8) | fold(value[i]));
+    }
+}
+
+void
+sort_unique(TrigramIndex::TrigramVector &trigrams)
+{
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+}
+
+}
+
+TrigramIndex::TrigramIndex()
+    : _tree()
+{
+}
+
+TrigramIndex::~TrigramIndex() = default;
+
+TrigramIndex::TrigramVector
+TrigramIndex::extract_trigrams(vespalib::stringref value)
+{
+    TrigramVector trigrams;
+    append_trigrams(value, trigrams);
+    sort_unique(trigrams);
+    return trigrams;
+}
+
+TrigramIndex::TrigramVector
+TrigramIndex::extract_query_trigrams(const std::vector<vespalib::string> &literals, bool cased)
+{
+    TrigramVector trigrams;
+    for (const auto &literal : literals) {
+        if (cased) {
+            append_trigrams(literal, trigrams);
+            continue;
+        }
+        size_t start = 0;
+        for (size_t i = 0; i <= literal.size(); ++i) {
+            if ((i == literal.size()) || (static_cast<uint8_t>(literal[i]) >= 0x80) || is_foldable_to_non_ascii(literal[i])) {
+                append_trigrams(vespalib::stringref(literal.data() + start, i - start), trigrams);
+                start = i + 1;
+            }
+        }
+    }
+    sort_unique(trigrams);
+    return trigrams;
+}
+
+void
+TrigramIndex::add(Index idx, vespalib::stringref value)
+{
+    for (Trigram trigram : extract_trigrams(value)) {
+        _tree.insert(make_key(trigram, idx), vespalib::btree::BTreeNoLeafData());
+    }
+}
+
+void
+TrigramIndex::remove(Index idx, vespalib::stringref value)
+{
+    for (Trigram trigram : extract_trigrams(value)) {
+        _tree.remove(make_key(trigram, idx));
+    }
+}
+
+void
+TrigramIndex::build(vespalib::ConstArrayRef<Index> indexes, const std::function<vespalib::stringref(Index)> &get_value)
+{
+    std::vector<uint64_t> keys;
+    for (Index idx : indexes) {
+        for (Trigram trigram : extract_trigrams(get_value(idx))) {
+            keys.push_back(make_key(trigram, idx));
+        }
+    }
+    std::sort(keys.begin(), keys.end());
+    Tree::Builder builder(_tree.getAllocator());
+    for (uint64_t key : keys) {
+        builder.insert(key, vespalib::btree::BTreeNoLeafData());
+    }
+    _tree.assign(builder);
+}
+
+void
+TrigramIndex::remap(const EnumIndexRemapper &remapper)
+{
+    const auto &filter = remapper.get_entry_ref_filter();
+    std::vector<uint64_t> moved;
+    for (auto itr = _tree.begin(); itr.valid(); ++itr) {
+        if (filter.has(get_index(itr.getKey()))) {
+            moved.push_back(itr.getKey());
+        }
+    }
+    for (uint64_t key : moved) {
+        _tree.remove(key);
+    }
+    for (uint64_t key : moved) {
+        _tree.insert(make_key(get_trigram(key), remapper.remap(get_index(key))), vespalib::btree::BTreeNoLeafData());
+    }
+}
+
+bool
+TrigramIndex::find_candidates(const TrigramVector &trigrams, size_t max_candidates, std::vector<Index> &candidates) const
+{
+    using ConstIterator = Tree::ConstIterator;
+    struct Range {
+        Trigram       trigram;
+        ConstIterator itr;
+        size_t        size;
+    };
+    auto frozen_view = _tree.getFrozenView();
+    std::vector<Range> ranges;
+    ranges.reserve(trigrams.size());
+    for (Trigram trigram : trigrams) {
+        auto itr = frozen_view.lowerBound(make_key(trigram, Index()));
+        auto end = frozen_view.lowerBound(make_key(trigram + 1, Index()));
+        ranges.push_back({trigram, itr, static_cast<size_t>(end - itr)});
+    }
+    if (ranges.empty()) {
+        return false;
+    }
+    std::sort(ranges.begin(), ranges.end(), [](const Range &lhs, const Range &rhs) { return lhs.size < rhs.size; });
+    if (ranges[0].size > max_candidates) {
+        return false;
+    }
+    candidates.clear();
+    for (auto itr = ranges[0].itr; itr.valid() && get_trigram(itr.getKey()) == ranges[0].trigram; ++itr) {
+        Index idx = get_index(itr.getKey());
+        bool match = true;
+        for (size_t i = 1; match && i < ranges.size(); ++i) {
+            auto &range = ranges[i];
+            uint64_t key = make_key(range.trigram, idx);
+            if (range.itr.valid() && range.itr.getKey() < key) {
+                range.itr.seek(key);
+            }
+            match = range.itr.valid() && (range.itr.getKey() == key);
+        }
+        if (match) {
+            candidates.push_back(idx);
+        }
+    }
+    return true;
+}
+
+void
+TrigramIndex::freeze()
+{
+    _tree.getAllocator().freeze();
+}
+
+void
+TrigramIndex::transfer_hold_lists(generation_t generation)
+{
+    _tree.getAllocator().transferHoldLists(generation);
+}
+
+void
+TrigramIndex::trim_hold_lists(generation_t first_used)
+{
+    _tree.getAllocator().trimHoldLists(first_used);
+}
+
+size_t
+TrigramIndex::size() const
+{
+    return _tree.size();
+}
+
+vespalib::MemoryUsage
+TrigramIndex::get_memory_usage() const
+{
+    return _tree.getMemoryUsage();
+}
+
+}
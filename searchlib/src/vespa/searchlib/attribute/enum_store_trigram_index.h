@@ -0,0 +1,87 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "enum_store_types.h"
+#include <vespa/vespalib/btree/btree.h>
+#include <vespa/vespalib/btree/btreeroot.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/arrayref.h>
+#include <vespa/vespalib/util/generationhandler.h>
+#include <functional>
+
+namespace vespalib { class MemoryUsage; }
+namespace vespalib::datastore { template <typename> class UniqueStoreRemapper; }
+
+namespace search::enumstore {
+
+/*
+ * Index from trigrams to the unique string values in an enum store
+ * containing them, used to find the candidate dictionary entries for
+ * regex terms instead of matching the regex against all unique values.
+ *
+ * A trigram is 3 consecutive bytes of a value, with ascii letters
+ * folded to lower case. The index is a single btree keyed on trigram
+ * and enum index, i.e. the enum indexes containing a trigram are
+ * stored together and in enum index order, which allows trigrams to be
+ * intersected by seeking.
+ *
+ * Only the writer thread modifies the index. Readers use the frozen
+ * view, which must be frozen before the dictionary to ensure that it
+ * covers all values visible in the frozen dictionary.
+ */
+class TrigramIndex {
+public:
+    using EnumIndexRemapper = vespalib::datastore::UniqueStoreRemapper<InternalIndex>;
+    using generation_t = vespalib::GenerationHandler::generation_t;
+    using Trigram = uint32_t;
+    using TrigramVector = std::vector<Trigram>;
+
+private:
+    using Tree = vespalib::btree::BTree<uint64_t, vespalib::btree::BTreeNoLeafData>;
+    Tree _tree;
+
+    static uint64_t make_key(Trigram trigram, Index idx) noexcept {
+        return (static_cast<uint64_t>(trigram) << 32) | idx.ref();
+    }
+    static Trigram get_trigram(uint64_t key) noexcept { return key >> 32; }
+    static Index get_index(uint64_t key) noexcept { return Index(static_cast<uint32_t>(key)); }
+
+public:
+    TrigramIndex();
+    ~TrigramIndex();
+
+    /*
+     * Returns the sorted, unique trigrams in the given value.
+     */
+    static TrigramVector extract_trigrams(vespalib::stringref value);
+
+    /*
+     * Returns the sorted, unique trigrams in the given literals, where
+     * each literal is a substring that must be present in a matching
+     * value. For uncased matching, only ascii characters that are not
+     * case folded to non-ascii characters can be used.
+     */
+    static TrigramVector extract_query_trigrams(const std::vector<vespalib::string> &literals, bool cased);
+
+    void add(Index idx, vespalib::stringref value);
+    void remove(Index idx, vespalib::stringref value);
+    void build(vespalib::ConstArrayRef<Index> indexes, const std::function<vespalib::stringref(Index)> &get_value);
+    void remap(const EnumIndexRemapper &remapper);
+
+    /*
+     * Finds the enum indexes of the values containing all the given
+     * trigrams, using the frozen view. Returns false if the trigram
+     * occurring in the fewest values occurs in more than max_candidates
+     * values.
+     */
+    bool find_candidates(const TrigramVector &trigrams, size_t max_candidates, std::vector<Index> &candidates) const;
+
+    void freeze();
+    void transfer_hold_lists(generation_t generation);
+    void trim_hold_lists(generation_t first_used);
+    size_t size() const;
+    vespalib::MemoryUsage get_memory_usage() const;
+};
+
+}
@@ -4,6 +4,7 @@
 
 #include "enum_store_compaction_spec.h"
 #include "enum_store_dictionary.h"
+#include "enum_store_trigram_index.h"
 #include "enumcomparator.h"
 #include "i_enum_store.h"
 #include "loadedenumvalue.h"
@@ -56,11 +57,13 @@ private:
     ComparatorType         _comparator;
     ComparatorType         _foldedComparator;
     enumstore::EnumStoreCompactionSpec _compaction_spec;
+    std::unique_ptr<enumstore::TrigramIndex> _trigram_index;
 
     EnumStoreT(const EnumStoreT & rhs) = delete;
     EnumStoreT & operator=(const EnumStoreT & rhs) = delete;
 
     void free_value_if_unused(Index idx, IndexList &unused) override;
+    void add_to_trigram_index(Index idx);
 
     const vespalib::datastore::UniqueStoreEntryBase& get_entry_base(Index idx) const {
         return _store.get_allocator().get_wrapped(idx);
@@ -101,7 +104,14 @@ public:
 
     ssize_t load_unique_values(const void* src, size_t available, IndexVector& idx) override;
 
-    void freeze_dictionary() { _store.freeze(); }
+    void freeze_dictionary() {
+        if (_trigram_index) {
+            _trigram_index->freeze(); // must cover all values in the frozen dictionary
+        }
+        _store.freeze();
+    }
+    void build_trigram_index() override;
+    const enumstore::TrigramIndex* get_trigram_index() const noexcept { return _trigram_index.get(); }
 
     IEnumStoreDictionary& get_dictionary() override { return *_dict; }
     const IEnumStoreDictionary& get_dictionary() const override { return *_dict; }
@@ -115,14 +125,16 @@ public:
      */
     class NonEnumeratedLoader {
     private:
+        EnumStoreType& _store;
         AllocatorType& _allocator;
         vespalib::datastore::IUniqueStoreDictionary& _dict;
         std::vector<EntryRef, vespalib::allocator_large<EntryRef>> _refs;
         std::vector<EntryRef, vespalib::allocator_large<EntryRef>> _payloads;
 
     public:
-        NonEnumeratedLoader(AllocatorType& allocator, vespalib::datastore::IUniqueStoreDictionary& dict)
-            : _allocator(allocator),
+        NonEnumeratedLoader(EnumStoreType& store, AllocatorType& allocator, vespalib::datastore::IUniqueStoreDictionary& dict)
+            : _store(store),
+              _allocator(allocator),
               _dict(dict),
               _refs(),
               _payloads()
@@ -141,11 +153,12 @@ public:
         }
         void build_dictionary() {
             _dict.build_with_payload(_refs, _payloads);
+            _store.build_trigram_index();
         }
     };
 
     NonEnumeratedLoader make_non_enumerated_loader() {
-        return NonEnumeratedLoader(_store.get_allocator(), *_dict);
+        return NonEnumeratedLoader(*this, _store.get_allocator(), *_dict);
     }
 
     class BatchUpdater {
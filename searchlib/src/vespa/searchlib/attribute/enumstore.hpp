@@ -36,10 +36,42 @@ void EnumStoreT<EntryT>::free_value_if_unused(Index idx, IndexList& unused)
     const auto& entry = get_entry_base(idx);
     if (entry.get_ref_count() == 0) {
         unused.push_back(idx);
+        if constexpr (std::is_same_v<EntryT, const char *>) {
+            if (_trigram_index) {
+                _trigram_index->remove(idx, get_value(idx));
+            }
+        }
         _store.get_allocator().hold(idx);
     }
 }
 
+template <typename EntryT>
+void
+EnumStoreT<EntryT>::add_to_trigram_index(Index idx)
+{
+    if constexpr (std::is_same_v<EntryT, const char *>) {
+        if (_trigram_index) {
+            _trigram_index->add(idx, get_value(idx));
+        }
+    }
+}
+
+template <typename EntryT>
+void
+EnumStoreT<EntryT>::build_trigram_index()
+{
+    if constexpr (std::is_same_v<EntryT, const char *>) {
+        if (_trigram_index) {
+            std::vector<Index> indexes;
+            indexes.reserve(_dict->get_num_uniques());
+            for (auto itr = _dict->get_posting_dictionary().begin(); itr.valid(); ++itr) {
+                indexes.push_back(itr.getKey().load_relaxed());
+            }
+            _trigram_index->build(indexes, [this](Index idx) { return vespalib::stringref(get_value(idx)); });
+        }
+    }
+}
+
 template <typename EntryT>
 ssize_t
 EnumStoreT<EntryT>::load_unique_values_internal(const void* src, size_t available, IndexVector& idx)
@@ -78,12 +110,17 @@ EnumStoreT<EntryT>::EnumStoreT(bool has_postings, const DictionaryConfig& dict_c
       _is_folded(dict_cfg.getMatch() == DictionaryConfig::Match::UNCASED),
       _comparator(_store.get_data_store()),
       _foldedComparator(make_optionally_folded_comparator(is_folded())),
-      _compaction_spec()
+      _compaction_spec(),
+      _trigram_index()
 {
     _store.set_dictionary(make_enum_store_dictionary(*this, has_postings, dict_cfg,
                                                      allocate_comparator(),
                                                      allocate_optionally_folded_comparator(is_folded())));
     _dict = static_cast<IEnumStoreDictionary*>(&_store.get_dictionary());
+    // The trigram index is only used when searching posting lists via the btree dictionary
+    if (has_string_type() && has_postings && dict_cfg.get_trigram_index() && _dict->get_has_btree_dictionary()) {
+        _trigram_index = std::make_unique<enumstore::TrigramIndex>();
+    }
 }
 
 template <typename EntryT>
@@ -106,6 +143,9 @@ template <typename EntryT>
 void
 EnumStoreT<EntryT>::transfer_hold_lists(generation_t generation)
 {
+    if (_trigram_index) {
+        _trigram_index->transfer_hold_lists(generation);
+    }
     _store.transferHoldLists(generation);
 }
 
@@ -114,6 +154,9 @@ void
 EnumStoreT<EntryT>::trim_hold_lists(generation_t firstUsed)
 {
     // remove generations in the range [0, firstUsed>
+    if (_trigram_index) {
+        _trigram_index->trim_hold_lists(firstUsed);
+    }
     _store.trimHoldLists(firstUsed);
 }
 
@@ -147,6 +190,7 @@ EnumStoreT<EntryT>::BatchUpdater::insert(EntryType value)
     auto result = _store._dict->add(cmp, [this, &value]() -> EntryRef { return _store._store.get_allocator().allocate(value); });
     if (result.inserted()) {
         _possibly_unused.push_back(result.ref());
+        _store.add_to_trigram_index(result.ref());
     }
     return result.ref();
 }
@@ -212,14 +256,22 @@ template <typename EntryT>
 IEnumStore::Index
 EnumStoreT<EntryT>::insert(EntryType value)
 {
-    return _store.add(value).ref();
+    auto result = _store.add(value);
+    if (result.inserted()) {
+        add_to_trigram_index(result.ref());
+    }
+    return result.ref();
 }
 
 template <typename EntryT>
 vespalib::MemoryUsage
 EnumStoreT<EntryT>::update_stat(const CompactionStrategy& compaction_strategy)
 {
-    return _compaction_spec.update_stat(*this, compaction_strategy);
+    auto retval = _compaction_spec.update_stat(*this, compaction_strategy);
+    if (_trigram_index) {
+        retval.merge(_trigram_index->get_memory_usage());
+    }
+    return retval;
 }
 
 template <typename EntryT>
@@ -236,7 +288,11 @@ template <typename EntryT>
 std::unique_ptr<IEnumStore::EnumIndexRemapper>
 EnumStoreT<EntryT>::compact_worst_values(CompactionSpec compaction_spec, const CompactionStrategy& compaction_strategy)
 {
-    return _store.compact_worst(compaction_spec, compaction_strategy);
+    auto remapper = _store.compact_worst(compaction_spec, compaction_strategy);
+    if (remapper && _trigram_index) {
+        _trigram_index->remap(*remapper);
+    }
+    return remapper;
 }
 
 template <typename EntryT>
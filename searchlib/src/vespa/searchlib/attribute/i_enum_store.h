@@ -54,6 +54,8 @@ public:
     virtual void set_ref_count(Index idx, uint32_t ref_count) = 0;
     virtual void free_value_if_unused(Index idx, IndexList& unused) = 0;
     virtual void free_unused_values() = 0;
+    // Builds the optional trigram index from the dictionary, after the dictionary has been built when loading.
+    virtual void build_trigram_index() = 0;
     virtual bool is_folded_change(Index idx1, Index idx2) const = 0;
     virtual IEnumStoreDictionary& get_dictionary() = 0;
     virtual const IEnumStoreDictionary& get_dictionary() const = 0;
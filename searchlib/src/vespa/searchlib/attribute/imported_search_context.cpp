@@ -5,6 +5,7 @@
 #include "imported_attribute_vector.h"
 #include "reference_attribute.h"
 #include <vespa/searchlib/common/bitvectoriterator.h>
+#include <vespa/searchlib/common/compressedbitvector.h>
 #include <vespa/searchlib/query/query_term_ucs4.h>
 #include <vespa/searchlib/queryeval/emptysearch.h>
 #include <vespa/searchlib/queryeval/executeinfo.h>
@@ -57,6 +58,9 @@ unsigned int ImportedSearchContext::approximateHits() const {
 std::unique_ptr<queryeval::SearchIterator>
 ImportedSearchContext::createIterator(fef::TermFieldMatchData* matchData, bool strict) {
     if (_searchCacheLookup) {
+        if (_searchCacheLookup->compressedBitVector) {
+            return BitVectorIterator::create(_searchCacheLookup->compressedBitVector.get(), _searchCacheLookup->docIdLimit, *matchData, strict);
+        }
         return BitVectorIterator::create(_searchCacheLookup->bitVector.get(), _searchCacheLookup->docIdLimit, *matchData, strict);
     }
     if (_merger.hasArray()) {
@@ -232,7 +236,12 @@ ImportedSearchContext::considerAddSearchCacheEntry()
 {
     if (_useSearchCache && _merger.hasBitVector()) {
         assert(_dmsReadGuard);
-        auto cacheEntry = std::make_shared<BitVectorSearchCache::Entry>(std::move(_dmsReadGuard), _merger.getBitVectorSP(), _merger.getDocIdLimit());
+        BitVectorSearchCache::Entry::SP cacheEntry;
+        if (auto compressed = CompressedBitVector::createIfCompact(*_merger.getBitVectorSP())) {
+            cacheEntry = std::make_shared<BitVectorSearchCache::Entry>(std::move(_dmsReadGuard), BitVectorSearchCache::CompressedBitVectorSP(std::move(compressed)), _merger.getDocIdLimit());
+        } else {
+            cacheEntry = std::make_shared<BitVectorSearchCache::Entry>(std::move(_dmsReadGuard), _merger.getBitVectorSP(), _merger.getDocIdLimit());
+        }
         _imported_attribute.getSearchCache()->insert(_queryTerm, std::move(cacheEntry));
     }
 }
@@ -57,7 +57,12 @@ protected:
     void lookupTerm(const vespalib::datastore::EntryComparator &comp);
     void lookupRange(const vespalib::datastore::EntryComparator &low, const vespalib::datastore::EntryComparator &high);
     void lookupSingle();
-    virtual bool useThis(const DictionaryConstIterator & it) const {
+    /*
+     * Returns true if the dictionary entry at the iterator position should be used.
+     * Otherwise the iterator is advanced to the next candidate entry, which might be
+     * the end of the dictionary range.
+     */
+    virtual bool use_dictionary_entry(DictionaryConstIterator & it) const {
         (void) it;
         return true;
     }
@@ -182,7 +187,14 @@ private:
     using Parent = PostingSearchContext<BaseSC, PostingListFoldedSearchContextT<DataT>, AttrT>;
     using RegexpUtil = vespalib::RegexpUtil;
     using Parent::_enumStore;
-    bool useThis(const PostingListSearchContext::DictionaryConstIterator & it) const override;
+    using Parent::_upperDictItr;
+    mutable std::string _fuzzy_successor; // scratch buffer for dictionary skipping
+    std::vector<vespalib::datastore::EntryRef> _regex_candidates; // in dictionary order
+    bool _use_regex_candidates;
+    bool use_dictionary_entry(PostingListSearchContext::DictionaryConstIterator & it) const override;
+    bool use_fuzzy_dictionary_skip() const noexcept;
+    void lookup_regex_candidates();
+    bool seek_regex_candidate(PostingListSearchContext::DictionaryConstIterator & it) const;
 public:
     StringPostingSearchContext(BaseSC&& base_sc, bool useBitVector, const AttrT &toBeSearched);
 };
@@ -259,7 +271,10 @@ PostingSearchContext<BaseSC, BaseSC2, AttrT>::~PostingSearchContext() = default;
 template <typename BaseSC, typename AttrT, typename DataT>
 StringPostingSearchContext<BaseSC, AttrT, DataT>::
 StringPostingSearchContext(BaseSC&& base_sc, bool useBitVector, const AttrT &toBeSearched)
-    : Parent(std::move(base_sc), useBitVector, toBeSearched)
+    : Parent(std::move(base_sc), useBitVector, toBeSearched),
+      _fuzzy_successor(),
+      _regex_candidates(),
+      _use_regex_candidates(false)
 {
     // after benchmarking prefix search performance on single, array, and weighted set fast-aggregate string attributes
     // with 1M values the following constant has been derived:
@@ -277,6 +292,7 @@ StringPostingSearchContext(BaseSC&& base_sc, bool useBitVector, const AttrT &toB
             vespalib::string prefix(RegexpUtil::get_prefix(this->queryTerm()->getTerm()));
             auto comp = _enumStore.make_folded_comparator_prefix(prefix.c_str());
             this->lookupRange(comp, comp);
+            lookup_regex_candidates();
         } else if (this->isFuzzy()) {
             vespalib::string prefix(this->getFuzzyMatcher().getPrefix());
             auto comp = _enumStore.make_folded_comparator_prefix(prefix.c_str());
@@ -293,15 +309,104 @@ StringPostingSearchContext(BaseSC&& base_sc, bool useBitVector, const AttrT &toB
 
 template <typename BaseSC, typename AttrT, typename DataT>
 bool
-StringPostingSearchContext<BaseSC, AttrT, DataT>::useThis(const PostingListSearchContext::DictionaryConstIterator & it) const {
+StringPostingSearchContext<BaseSC, AttrT, DataT>::use_fuzzy_dictionary_skip() const noexcept
+{
+    // Successors are produced in folded order, which only matches the dictionary order
+    // used by the folded comparator for uncased matching.
+    return this->isFuzzy() && this->has_fuzzy_dfa() && !this->isCased() && _enumStore.is_folded();
+}
+
+template <typename BaseSC, typename AttrT, typename DataT>
+void
+StringPostingSearchContext<BaseSC, AttrT, DataT>::lookup_regex_candidates()
+{
+    const auto *trigram_index = _enumStore.get_trigram_index();
+    if ((trigram_index == nullptr) || (this->_uniqueValues < 2u) || !this->getRegex().valid()) {
+        return;
+    }
+    auto literals = RegexpUtil::get_required_literals(this->queryTerm()->getTerm());
+    auto trigrams = enumstore::TrigramIndex::extract_query_trigrams(literals, this->isCased());
+    // Only worth it when there are considerably fewer candidates than unique values in the dictionary range
+    if (trigrams.empty() || !trigram_index->find_candidates(trigrams, this->_uniqueValues / 2, _regex_candidates)) {
+        return;
+    }
+    const auto & comp = _enumStore.get_comparator();
+    std::sort(_regex_candidates.begin(), _regex_candidates.end(),
+              [&comp](vespalib::datastore::EntryRef lhs, vespalib::datastore::EntryRef rhs) { return comp.less(lhs, rhs); });
+    _use_regex_candidates = true;
+    uint32_t num_candidates = _regex_candidates.size();
+    if (num_candidates == 0u) {
+        this->_uniqueValues = 0u;
+    } else if (num_candidates < this->_uniqueValues) {
+        // A single candidate must still be matched against the regex, thus avoid the single value optimization
+        this->_uniqueValues = std::max(num_candidates, 2u);
+    }
+}
+
+template <typename BaseSC, typename AttrT, typename DataT>
+bool
+StringPostingSearchContext<BaseSC, AttrT, DataT>::seek_regex_candidate(PostingListSearchContext::DictionaryConstIterator & it) const
+{
+    // Candidates are compared by value since the trigram index and the dictionary might be frozen
+    // at different generations, with different enum indexes for values moved by compaction.
+    const auto & comp = _enumStore.get_comparator();
+    auto key = it.getKey().load_acquire();
+    auto candidate = std::lower_bound(_regex_candidates.begin(), _regex_candidates.end(), key,
+                                      [&comp](vespalib::datastore::EntryRef lhs, vespalib::datastore::EntryRef rhs) { return comp.less(lhs, rhs); });
+    if (candidate == _regex_candidates.end()) {
+        it = _upperDictItr; // no remaining dictionary entry can match
+        return false;
+    }
+    if (!comp.less(key, *candidate)) {
+        return true;
+    }
+    it.seek(vespalib::datastore::AtomicEntryRef(*candidate), comp);
+    if ((_upperDictItr - it) <= 0) {
+        it = _upperDictItr;
+    }
+    return false;
+}
+
+template <typename BaseSC, typename AttrT, typename DataT>
+bool
+StringPostingSearchContext<BaseSC, AttrT, DataT>::use_dictionary_entry(PostingListSearchContext::DictionaryConstIterator & it) const {
     if ( this->isRegex() ) {
-        return this->getRegex().valid()
-            ? this->getRegex().partial_match(_enumStore.get_value(it.getKey().load_acquire()))
-            : false;
+        if (_use_regex_candidates && !seek_regex_candidate(it)) {
+            return false;
+        }
+        if (this->getRegex().valid() && this->getRegex().partial_match(_enumStore.get_value(it.getKey().load_acquire()))) {
+            return true;
+        }
+        ++it;
+        return false;
     } else if ( this->isCased() ) {
-        return this->match(_enumStore.get_value(it.getKey().load_acquire()));
+        if (this->match(_enumStore.get_value(it.getKey().load_acquire()))) {
+            return true;
+        }
+        ++it;
+        return false;
     } else if (this->isFuzzy()) {
-        return this->getFuzzyMatcher().isMatch(_enumStore.get_value(it.getKey().load_acquire()));
+        if (!use_fuzzy_dictionary_skip()) {
+            if (this->getFuzzyMatcher().isMatch(_enumStore.get_value(it.getKey().load_acquire()))) {
+                return true;
+            }
+            ++it;
+            return false;
+        }
+        if (this->fuzzy_match(_enumStore.get_value(it.getKey().load_acquire()), _fuzzy_successor)) {
+            return true;
+        }
+        if (_fuzzy_successor.empty()) {
+            it = _upperDictItr; // no remaining dictionary entry can match
+        } else {
+            // Skip all entries that sort before the smallest string that can possibly match
+            auto comp = _enumStore.make_folded_comparator(_fuzzy_successor.c_str());
+            it.seek(vespalib::datastore::AtomicEntryRef(), comp);
+            if ((_upperDictItr - it) <= 0) {
+                it = _upperDictItr;
+            }
+        }
+        return false;
     }
     return true;
 }
@@ -24,6 +24,8 @@ public:
 protected:
     bool isValid() const;
     bool match(const char *src) const { return _helper.isMatch(src); }
+    bool fuzzy_match(const char *src, std::string &successor) const { return _helper.isFuzzyMatch(src, successor); }
+    bool has_fuzzy_dfa() const noexcept { return _helper.hasFuzzyDfa(); }
     bool isPrefix() const { return _helper.isPrefix(); }
     bool isRegex() const { return _helper.isRegex(); }
     bool isCased() const { return _helper.isCased(); }
@@ -2,6 +2,7 @@
 
 #include "string_search_helper.h"
 #include <vespa/searchlib/query/query_term_ucs4.h>
+#include <vespa/vespalib/fuzzy/levenshtein_dfa.h>
 #include <vespa/vespalib/text/lowercase.h>
 #include <vespa/vespalib/text/utf8.h>
 
@@ -10,6 +11,7 @@ namespace search::attribute {
 StringSearchHelper::StringSearchHelper(QueryTermUCS4 & term, bool cased)
     : _regex(),
       _fuzzyMatcher(),
+      _dfaFuzzyMatcher(),
       _term(),
       _termLen(),
       _isPrefix(term.isPrefix()),
@@ -29,6 +31,14 @@ StringSearchHelper::StringSearchHelper(QueryTermUCS4 & term, bool cased)
                 term.getFuzzyMaxEditDistance(),
                 term.getFuzzyPrefixLength(),
                 isCased());
+        if (term.getFuzzyMaxEditDistance() <= vespalib::LevenshteinDfa::MaxSupportedEdits) {
+            _dfaFuzzyMatcher = std::make_unique<vespalib::LevenshteinDfa>(
+                    vespalib::LevenshteinDfa::build(term.getTerm(),
+                                                    term.getFuzzyMaxEditDistance(),
+                                                    isCased() ? vespalib::LevenshteinDfa::Casing::Cased
+                                                              : vespalib::LevenshteinDfa::Casing::Uncased,
+                                                    term.getFuzzyPrefixLength()));
+        }
     } else if (isCased()) {
         _term._char = term.getTerm();
         _termLen = term.getTermLen();
@@ -47,7 +57,9 @@ StringSearchHelper::isMatch(const char *src) const {
         return getRegex().valid() ? getRegex().partial_match(std::string_view(src)) : false;
     }
     if (__builtin_expect(isFuzzy(), false)) {
-        return getFuzzyMatcher().isMatch(src);
+        return hasFuzzyDfa()
+            ? _dfaFuzzyMatcher->match(src, nullptr).matches()
+            : getFuzzyMatcher().isMatch(src);
     }
     if (__builtin_expect(isCased(), false)) {
         int res = strncmp(_term._char, src, _termLen);
@@ -66,4 +78,10 @@ StringSearchHelper::isMatch(const char *src) const {
     return (_term._ucs4[j] == 0 && (val == 0 || isPrefix()));
 }
 
+bool
+StringSearchHelper::isFuzzyMatch(const char *src, std::string &successor) const
+{
+    return _dfaFuzzyMatcher->match(src, &successor).matches();
+}
+
 }
@@ -5,7 +5,10 @@
 #include <vespa/fastlib/text/unicodeutil.h>
 #include <vespa/vespalib/regex/regex.h>
 #include <vespa/vespalib/fuzzy/fuzzy_matcher.h>
+#include <memory>
+#include <string>
 
+namespace vespalib { class LevenshteinDfa; }
 namespace search { class QueryTermUCS4; }
 
 namespace search::attribute {
@@ -20,6 +23,13 @@ public:
     StringSearchHelper(StringSearchHelper&&) noexcept;
     ~StringSearchHelper();
     bool isMatch(const char *src) const;
+    /**
+     * Fuzzy match using the Levenshtein automaton. If src does not match, successor is
+     * set to the smallest (folded) string greater than src that can match, or cleared if
+     * no such string exists. Only valid when hasFuzzyDfa() returns true.
+     */
+    bool isFuzzyMatch(const char *src, std::string &successor) const;
+    bool hasFuzzyDfa() const noexcept { return static_cast<bool>(_dfaFuzzyMatcher); }
     bool isPrefix() const { return _isPrefix; }
     bool isRegex() const { return _isRegex; }
     bool isCased() const { return _isCased; }
@@ -29,6 +39,7 @@ public:
 private:
     vespalib::Regex                _regex;
     vespalib::FuzzyMatcher         _fuzzyMatcher;
+    std::unique_ptr<vespalib::LevenshteinDfa> _dfaFuzzyMatcher;
     union {
         const ucs4_t *_ucs4;
         const char   *_char;
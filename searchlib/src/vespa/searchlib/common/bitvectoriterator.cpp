@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "bitvectoriterator.h"
+#include "compressedbitvectoriterator.h"
 #include <vespa/searchlib/queryeval/emptysearch.h>
 #include <vespa/searchlib/fef/termfieldmatchdataarray.h>
 #include <vespa/vespalib/objects/visit.h>
@@ -151,6 +152,13 @@ BitVectorIterator::create(const BitVector *const bv, uint32_t docIdLimit,
     }
 }
 
+queryeval::SearchIterator::UP
+BitVectorIterator::create(const CompressedBitVector *const bv, uint32_t docIdLimit,
+                          TermFieldMatchData &matchData, bool strict, bool inverted)
+{
+    return CompressedBitVectorIterator::create(bv, docIdLimit, matchData, strict, inverted);
+}
+
 template<bool inverse>
 BitVector::UP
 BitVectorIteratorT<inverse>::get_hits(uint32_t begin_id) {
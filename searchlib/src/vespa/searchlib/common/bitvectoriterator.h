@@ -9,6 +9,7 @@
 namespace search {
 
 namespace fef { class TermFieldMatchDataArray; }
+class CompressedBitVector;
 
 class BitVectorIterator : public queryeval::SearchIterator
 {
@@ -34,6 +35,8 @@ public:
     static UP create(const BitVector *const other, fef::TermFieldMatchData &matchData, bool strict, bool inverted = false);
     static UP create(const BitVector *const other, uint32_t docIdLimit,
                      fef::TermFieldMatchData &matchData, bool strict, bool inverted = false);
+    static UP create(const CompressedBitVector *const other, uint32_t docIdLimit,
+                     fef::TermFieldMatchData &matchData, bool strict, bool inverted = false);
 };
 
 } // namespace search
@@ -0,0 +1,459 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "compressedbitvector.h"
+#include "bitvector.h"
+#include <cassert>
+#include <cstring>
+
+using vespalib::Optimized;
+
+namespace search {
+
+namespace {
+
+using Word = BitWord::Word;
+constexpr size_t WordLen = BitWord::WordLen;
+
+// Set bits [first, last] in dst, relative to bit 0 of dst[0]
+void
+setBits(Word *dst, uint64_t first, uint64_t last)
+{
+    uint64_t first_word = first / WordLen;
+    uint64_t last_word = last / WordLen;
+    Word first_mask = BitWord::checkTab(first);
+    Word last_mask = ~BitWord::endBits(last);
+    if (first_word == last_word) {
+        dst[first_word] |= (first_mask & last_mask);
+        return;
+    }
+    dst[first_word] |= first_mask;
+    for (uint64_t word_num = first_word + 1; word_num < last_word; ++word_num) {
+        dst[word_num] = BitWord::allBits();
+    }
+    dst[last_word] |= last_mask;
+}
+
+// Index of first run ending at or after offset, runs are stored as [first, last] pairs
+uint32_t
+findRun(const uint16_t *v, uint32_t num_runs, uint32_t offset)
+{
+    uint32_t lo = 0;
+    uint32_t hi = num_runs;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        if (v[2 * mid + 1] < offset) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+struct OrOp {
+    static Word apply(Word dst, Word src) { return dst | src; }
+};
+
+struct AndOp {
+    static Word apply(Word dst, Word src) { return dst & src; }
+};
+
+struct AndNotOp {
+    static Word apply(Word dst, Word src) { return dst & ~src; }
+};
+
+}
+
+CompressedBitVector::CompressedBitVector(Index sz)
+    : _size(sz),
+      _numTrueBits(0),
+      _chunks(),
+      _values(),
+      _words()
+{
+}
+
+CompressedBitVector::~CompressedBitVector() = default;
+
+size_t
+CompressedBitVector::sizeBytes() const
+{
+    return sizeof(CompressedBitVector) +
+        _chunks.capacity() * sizeof(Chunk) +
+        _values.capacity() * sizeof(uint16_t) +
+        _words.capacity() * sizeof(Word);
+}
+
+void
+CompressedBitVector::addChunk(const Word *src, uint32_t num_words)
+{
+    uint32_t count = 0;
+    uint32_t num_runs = 0;
+    Word prev_msb = 0;
+    for (uint32_t i = 0; i < num_words; ++i) {
+        Word word = src[i];
+        count += Optimized::popCount(word);
+        // Bits starting a run are set bits with a cleared bit before them
+        num_runs += Optimized::popCount(word & ~((word << 1) | prev_msb));
+        prev_msb = word >> (WordLen - 1);
+    }
+    size_t array_bytes = count * sizeof(uint16_t);
+    size_t run_bytes = num_runs * 2 * sizeof(uint16_t);
+    size_t bitmap_bytes = num_words * sizeof(Word);
+    _numTrueBits += count;
+    if (count == 0) {
+        _chunks.emplace_back(0, 0, 0, ChunkType::ARRAY);
+    } else if (run_bytes < array_bytes && run_bytes < bitmap_bytes) {
+        _chunks.emplace_back(_values.size(), num_runs, count, ChunkType::RUN);
+        uint32_t offset = 0;
+        uint32_t end = num_words * WordLen;
+        while (offset < end) {
+            Word word = src[offset / WordLen] & checkTab(offset);
+            if (word == 0) {
+                offset = (offset / WordLen + 1) * WordLen;
+                continue;
+            }
+            uint32_t first = (offset / WordLen) * WordLen + Optimized::lsbIdx(word);
+            offset = first;
+            Word inverted = ~src[offset / WordLen] & checkTab(offset);
+            while (inverted == 0 && (offset / WordLen + 1) < num_words) {
+                offset = (offset / WordLen + 1) * WordLen;
+                inverted = ~src[offset / WordLen];
+            }
+            offset = (inverted == 0) ? end : (offset / WordLen) * WordLen + Optimized::lsbIdx(inverted);
+            _values.push_back(first);
+            _values.push_back(offset - 1);
+        }
+    } else if (array_bytes < bitmap_bytes) {
+        _chunks.emplace_back(_values.size(), count, count, ChunkType::ARRAY);
+        for (uint32_t i = 0; i < num_words; ++i) {
+            for (Word word = src[i]; word != 0; word &= word - 1) {
+                _values.push_back(i * WordLen + Optimized::lsbIdx(word));
+            }
+        }
+    } else {
+        _chunks.emplace_back(_words.size(), num_words, count, ChunkType::BITMAP);
+        _words.insert(_words.end(), src, src + num_words);
+    }
+}
+
+void
+CompressedBitVector::shrink()
+{
+    _chunks.shrink_to_fit();
+    _values.shrink_to_fit();
+    _words.shrink_to_fit();
+}
+
+bool
+CompressedBitVector::testBit(Index idx) const
+{
+    if (idx >= _size) {
+        return false;
+    }
+    const Chunk &chunk = _chunks[chunkNum(idx)];
+    uint32_t offset = chunkOffset(idx);
+    switch (chunk.type) {
+    case ChunkType::ARRAY:
+        return std::binary_search(values(chunk), values(chunk) + chunk.length, offset);
+    case ChunkType::RUN: {
+        const uint16_t *v = values(chunk);
+        uint32_t run = findRun(v, chunk.length, offset);
+        return (run < chunk.length) && (v[2 * run] <= offset);
+    }
+    case ChunkType::BITMAP:
+        return (words(chunk)[offset / WordLen] & mask(offset)) != 0;
+    }
+    return false;
+}
+
+uint32_t
+CompressedBitVector::nextTrueBitInChunk(const Chunk &chunk, uint32_t offset) const
+{
+    if (chunk.count == 0) {
+        return chunk_size;
+    }
+    switch (chunk.type) {
+    case ChunkType::ARRAY: {
+        const uint16_t *v_end = values(chunk) + chunk.length;
+        const uint16_t *v = std::lower_bound(values(chunk), v_end, offset);
+        return (v != v_end) ? *v : chunk_size;
+    }
+    case ChunkType::RUN: {
+        const uint16_t *v = values(chunk);
+        uint32_t run = findRun(v, chunk.length, offset);
+        return (run < chunk.length) ? std::max(uint32_t(v[2 * run]), offset) : chunk_size;
+    }
+    case ChunkType::BITMAP: {
+        const Word *w = words(chunk);
+        uint32_t word_num = offset / WordLen;
+        Word word = w[word_num] & checkTab(offset);
+        while (word == 0) {
+            if (++word_num >= chunk.length) {
+                return chunk_size;
+            }
+            word = w[word_num];
+        }
+        return word_num * WordLen + Optimized::lsbIdx(word);
+    }
+    }
+    return chunk_size;
+}
+
+uint32_t
+CompressedBitVector::nextFalseBitInChunk(const Chunk &chunk, uint32_t offset) const
+{
+    if (chunk.count == 0) {
+        return offset;
+    }
+    switch (chunk.type) {
+    case ChunkType::ARRAY: {
+        const uint16_t *v_end = values(chunk) + chunk.length;
+        for (const uint16_t *v = std::lower_bound(values(chunk), v_end, offset); v != v_end && *v == offset; ++v) {
+            ++offset;
+        }
+        return offset;
+    }
+    case ChunkType::RUN: {
+        const uint16_t *v = values(chunk);
+        uint32_t run = findRun(v, chunk.length, offset);
+        // Runs are maximal, the bit after a run is cleared
+        return ((run < chunk.length) && (v[2 * run] <= offset)) ? (v[2 * run + 1] + 1) : offset;
+    }
+    case ChunkType::BITMAP: {
+        const Word *w = words(chunk);
+        uint32_t word_num = offset / WordLen;
+        Word word = ~w[word_num] & checkTab(offset);
+        while (word == 0) {
+            if (++word_num >= chunk.length) {
+                return word_num * WordLen;
+            }
+            word = ~w[word_num];
+        }
+        return word_num * WordLen + Optimized::lsbIdx(word);
+    }
+    }
+    return offset;
+}
+
+CompressedBitVector::Index
+CompressedBitVector::getNextTrueBit(Index start) const
+{
+    for (Index chunk_num = chunkNum(start); start < _size && chunk_num < _chunks.size(); ++chunk_num) {
+        Index base = chunkStart(chunk_num);
+        uint32_t offset = nextTrueBitInChunk(_chunks[chunk_num], (start > base) ? chunkOffset(start) : 0);
+        if (offset < chunk_size) {
+            return std::min(base + offset, _size);
+        }
+    }
+    return _size;
+}
+
+CompressedBitVector::Index
+CompressedBitVector::getNextFalseBit(Index start) const
+{
+    for (Index chunk_num = chunkNum(start); start < _size && chunk_num < _chunks.size(); ++chunk_num) {
+        Index base = chunkStart(chunk_num);
+        uint32_t offset = nextFalseBitInChunk(_chunks[chunk_num], (start > base) ? chunkOffset(start) : 0);
+        if (offset < chunk_size) {
+            return std::min(base + offset, _size);
+        }
+    }
+    return _size;
+}
+
+void
+CompressedBitVector::getChunkWords(const Chunk &chunk, uint64_t begin, uint64_t end, Word *dst) const
+{
+    // [begin, end> is the bit range to decode, relative to start of chunk and dst[0] is
+    // the word containing bit begin.
+    uint64_t dst_base = (begin / WordLen) * WordLen;
+    switch (chunk.type) {
+    case ChunkType::ARRAY: {
+        const uint16_t *v_end = values(chunk) + chunk.length;
+        for (const uint16_t *v = std::lower_bound(values(chunk), v_end, begin); v != v_end && *v < end; ++v) {
+            uint64_t bit = *v - dst_base;
+            dst[bit / WordLen] |= (Word(1) << (bit % WordLen));
+        }
+        break;
+    }
+    case ChunkType::RUN: {
+        const uint16_t *v = values(chunk);
+        for (uint32_t run = findRun(v, chunk.length, begin); run < chunk.length && v[2 * run] < end; ++run) {
+            uint64_t first = std::max(uint64_t(v[2 * run]), begin);
+            uint64_t last = std::min(uint64_t(v[2 * run + 1]), end - 1);
+            if (first <= last) {
+                setBits(dst, first - dst_base, last - dst_base);
+            }
+        }
+        break;
+    }
+    case ChunkType::BITMAP: {
+        uint64_t first_word = begin / WordLen;
+        uint64_t last_word = std::min((end + WordLen - 1) / WordLen, uint64_t(chunk.length));
+        if (last_word > first_word) {
+            memcpy(dst, words(chunk) + first_word, (last_word - first_word) * sizeof(Word));
+        }
+        break;
+    }
+    }
+}
+
+void
+CompressedBitVector::getWords(Index word_idx, uint32_t num_words, Word *dst) const
+{
+    memset(dst, 0, num_words * sizeof(Word));
+    uint64_t begin = uint64_t(word_idx) * WordLen;
+    uint64_t end = begin + uint64_t(num_words) * WordLen;
+    for (uint64_t chunk_num = begin >> chunk_bits; chunk_num < _chunks.size() && (chunk_num << chunk_bits) < end; ++chunk_num) {
+        const Chunk &chunk = _chunks[chunk_num];
+        if (chunk.count == 0) {
+            continue;
+        }
+        uint64_t base = chunk_num << chunk_bits;
+        uint64_t chunk_begin = std::max(begin, base) - base;
+        uint64_t chunk_end = std::min(end - base, uint64_t(chunk_size));
+        getChunkWords(chunk, chunk_begin, chunk_end, dst + (base + chunk_begin - begin) / WordLen);
+    }
+}
+
+template <typename Op>
+void
+CompressedBitVector::applyInto(BitVector &bv, Op op) const
+{
+    (void) op;
+    Index start = bv.getStartIndex();
+    Index end = bv.size();
+    if (end <= start) {
+        return;
+    }
+    Word *dst = static_cast<Word *>(bv.getStart());
+    Index first_word = wordNum(start);
+    Index last_word = wordNum(end - 1);
+    std::vector<Word> scratch(chunk_words);
+    for (uint64_t word_num = first_word; word_num <= last_word; ) {
+        // Decode up to end of chunk containing word_num
+        uint32_t num_words = std::min(uint64_t(chunk_words - (word_num % chunk_words)), uint64_t(last_word) + 1 - word_num);
+        getWords(word_num, num_words, scratch.data());
+        for (uint32_t i = 0; i < num_words; ++i, ++word_num) {
+            Word src = scratch[i];
+            // Bits outside [start, end> are left untouched
+            Word inside = allBits();
+            if (word_num == first_word) {
+                inside &= ~startBits(start);
+            }
+            if (word_num == last_word) {
+                inside &= ~endBits(end - 1);
+            }
+            Word old_word = dst[word_num];
+            dst[word_num] = (Op::apply(old_word, src) & inside) | (old_word & ~inside);
+        }
+    }
+    bv.invalidateCachedCount();
+}
+
+void
+CompressedBitVector::orInto(BitVector &bv) const
+{
+    applyInto(bv, OrOp());
+}
+
+void
+CompressedBitVector::andInto(BitVector &bv) const
+{
+    applyInto(bv, AndOp());
+}
+
+void
+CompressedBitVector::andNotInto(BitVector &bv) const
+{
+    applyInto(bv, AndNotOp());
+}
+
+std::unique_ptr<BitVector>
+CompressedBitVector::createBitVector() const
+{
+    auto bv = BitVector::create(_size);
+    orInto(*bv);
+    return bv;
+}
+
+CompressedBitVector::UP
+CompressedBitVector::create(const BitVector &bv)
+{
+    Index sz = bv.size();
+    UP result(new CompressedBitVector(sz));
+    std::vector<Word> scratch(chunk_words);
+    Index start = bv.getStartIndex();
+    for (uint64_t base = 0; base < sz; base += chunk_size) {
+        uint32_t num_words = (std::min(uint64_t(sz) - base, uint64_t(chunk_size)) + WordLen - 1) / WordLen;
+        memset(scratch.data(), 0, num_words * sizeof(Word));
+        if (base + chunk_size > start) {
+            // Partial bit vectors only have words for the active range
+            Index first = std::max(uint64_t(start), base);
+            Index last = std::min(uint64_t(sz), base + chunk_size) - 1;
+            const Word *src = static_cast<const Word *>(bv.getStart());
+            for (Index word_num = wordNum(first); word_num <= wordNum(last); ++word_num) {
+                scratch[word_num - base / WordLen] = vespalib::atomic::load_ref_relaxed(src[word_num]);
+            }
+            // Mask away bits before start and the guard bit at the end
+            scratch[wordNum(first) - base / WordLen] &= ~startBits(first);
+            scratch[wordNum(last) - base / WordLen] &= ~endBits(last);
+        }
+        result->addChunk(scratch.data(), num_words);
+    }
+    result->shrink();
+    return result;
+}
+
+template <typename Op>
+CompressedBitVector::UP
+CompressedBitVector::combine(const CompressedBitVector &a, const CompressedBitVector &b, Op op)
+{
+    (void) op;
+    assert(a.size() == b.size());
+    Index sz = a.size();
+    UP result(new CompressedBitVector(sz));
+    std::vector<Word> a_words(chunk_words);
+    std::vector<Word> b_words(chunk_words);
+    for (uint64_t base = 0; base < sz; base += chunk_size) {
+        uint32_t num_words = (std::min(uint64_t(sz) - base, uint64_t(chunk_size)) + WordLen - 1) / WordLen;
+        a.getWords(base / WordLen, num_words, a_words.data());
+        b.getWords(base / WordLen, num_words, b_words.data());
+        for (uint32_t i = 0; i < num_words; ++i) {
+            a_words[i] = Op::apply(a_words[i], b_words[i]);
+        }
+        result->addChunk(a_words.data(), num_words);
+    }
+    result->shrink();
+    return result;
+}
+
+CompressedBitVector::UP
+CompressedBitVector::createIfCompact(const BitVector &bv, uint32_t min_ratio)
+{
+    size_t dense_bytes = bv.getFileBytes();
+    // Skip the encoding when even array chunks for all bits set are too large
+    if (uint64_t(bv.countTrueBits()) * sizeof(uint16_t) * min_ratio > dense_bytes) {
+        return UP();
+    }
+    UP result = create(bv);
+    if (result->sizeBytes() * min_ratio > dense_bytes) {
+        return UP();
+    }
+    return result;
+}
+
+CompressedBitVector::UP
+CompressedBitVector::createAnd(const CompressedBitVector &a, const CompressedBitVector &b)
+{
+    return combine(a, b, AndOp());
+}
+
+CompressedBitVector::UP
+CompressedBitVector::createOr(const CompressedBitVector &a, const CompressedBitVector &b)
+{
+    return combine(a, b, OrOp());
+}
+
+}
@@ -0,0 +1,183 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "bitword.h"
+#include <vespa/vespalib/util/optimized.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace search {
+
+class BitVector;
+
+/**
+ * Immutable compressed representation of a bit vector, using the same
+ * layout as roaring bitmaps. The bit space is split into chunks of
+ * 64Ki bits, and each chunk is stored in the smallest of three forms:
+ *
+ *   ARRAY:  sorted array of the 16-bit offsets of the bits set (sparse)
+ *   BITMAP: plain 8KiB bitmap (dense)
+ *   RUN:    sorted array of [first, last] 16-bit offset pairs (clustered)
+ *
+ * Memory usage follows the number of bits set (or runs) instead of the
+ * size, making this suitable for long lived bit vectors of low or
+ * medium density, e.g. cached posting lists and global filters.
+ */
+class CompressedBitVector : protected BitWord
+{
+public:
+    using Index = BitWord::Index;
+    using Word = BitWord::Word;
+    using UP = std::unique_ptr<CompressedBitVector>;
+    static constexpr uint32_t chunk_bits = 16;
+    static constexpr Index chunk_size = 1u << chunk_bits;
+    static constexpr uint32_t chunk_words = chunk_size / WordLen;
+
+    enum class ChunkType : uint8_t { ARRAY, BITMAP, RUN };
+
+private:
+    struct Chunk {
+        uint32_t  offset;  // Start of chunk in _values (ARRAY, RUN) or _words (BITMAP)
+        uint32_t  length;  // Number of values (ARRAY), runs (RUN) or words (BITMAP)
+        uint32_t  count;   // Number of bits set
+        ChunkType type;
+        Chunk(uint32_t offset_in, uint32_t length_in, uint32_t count_in, ChunkType type_in) noexcept
+            : offset(offset_in), length(length_in), count(count_in), type(type_in)
+        { }
+    };
+
+    Index                 _size;
+    Index                 _numTrueBits;
+    std::vector<Chunk>    _chunks;
+    std::vector<uint16_t> _values;
+    std::vector<Word>     _words;
+
+    explicit CompressedBitVector(Index sz);
+    static Index chunkNum(Index idx) { return idx >> chunk_bits; }
+    static uint32_t chunkOffset(Index idx) { return idx & (chunk_size - 1); }
+    static Index chunkStart(Index chunk_num) { return chunk_num << chunk_bits; }
+    const uint16_t *values(const Chunk &chunk) const { return _values.data() + chunk.offset; }
+    const Word *words(const Chunk &chunk) const { return _words.data() + chunk.offset; }
+    void addChunk(const Word *src, uint32_t num_words);
+    void shrink();
+    uint32_t nextTrueBitInChunk(const Chunk &chunk, uint32_t offset) const;
+    uint32_t nextFalseBitInChunk(const Chunk &chunk, uint32_t offset) const;
+    void getChunkWords(const Chunk &chunk, uint64_t begin, uint64_t end, Word *dst) const;
+    template <typename Op>
+    void applyInto(BitVector &bv, Op op) const;
+    template <typename Op>
+    static UP combine(const CompressedBitVector &a, const CompressedBitVector &b, Op op);
+
+public:
+    CompressedBitVector(const CompressedBitVector &) = delete;
+    CompressedBitVector& operator = (const CompressedBitVector &) = delete;
+    ~CompressedBitVector();
+
+    Index size() const { return _size; }
+    Index countTrueBits() const { return _numTrueBits; }
+    bool hasTrueBits() const { return _numTrueBits != 0; }
+    /**
+     * Memory used by this representation. Compare with
+     * BitVector::getFileBytes() for the dense representation.
+     */
+    size_t sizeBytes() const;
+    uint32_t numChunks() const { return _chunks.size(); }
+    ChunkType getChunkType(uint32_t chunk_num) const { return _chunks[chunk_num].type; }
+
+    bool testBit(Index idx) const;
+
+    /**
+     * Get next bit set (or cleared) in the bit vector (inclusive start).
+     * Returns size() if there is no such bit.
+     */
+    Index getNextTrueBit(Index start) const;
+    Index getNextFalseBit(Index start) const;
+
+    /**
+     * Iterate over all true bits in the range [start, end>.
+     */
+    template <typename FunctionType>
+    void foreach_truebit(FunctionType func, Index start = 0, Index end = std::numeric_limits<Index>::max()) const;
+
+    /**
+     * Decode num_words words of the dense representation, starting with
+     * word number word_idx. Words beyond size() are returned as 0.
+     */
+    void getWords(Index word_idx, uint32_t num_words, Word *dst) const;
+
+    /**
+     * Combine with a dense bit vector. Only the active range of the
+     * dense bit vector is modified.
+     */
+    void orInto(BitVector &bv) const;
+    void andInto(BitVector &bv) const;
+    void andNotInto(BitVector &bv) const;
+
+    std::unique_ptr<BitVector> createBitVector() const;
+
+    static UP create(const BitVector &bv);
+    /**
+     * Create a compressed bit vector only if it uses at most 1/min_ratio
+     * of the memory used by the dense bit vector, otherwise nullptr.
+     */
+    static UP createIfCompact(const BitVector &bv, uint32_t min_ratio = 4);
+    static UP createAnd(const CompressedBitVector &a, const CompressedBitVector &b);
+    static UP createOr(const CompressedBitVector &a, const CompressedBitVector &b);
+};
+
+template <typename FunctionType>
+void
+CompressedBitVector::foreach_truebit(FunctionType func, Index start, Index end) const
+{
+    end = std::min(end, _size);
+    for (uint64_t base = uint64_t(chunkNum(start)) << chunk_bits; base < end; base += chunk_size) {
+        const Chunk &chunk = _chunks[base >> chunk_bits];
+        uint32_t begin_offset = (start > base) ? chunkOffset(start) : 0;
+        uint64_t end_offset = std::min(uint64_t(end) - base, uint64_t(chunk_size));
+        if (chunk.count == 0) {
+            continue;
+        }
+        switch (chunk.type) {
+        case ChunkType::ARRAY: {
+            const uint16_t *v = values(chunk);
+            const uint16_t *v_end = v + chunk.length;
+            for (v = std::lower_bound(v, v_end, begin_offset); v != v_end && *v < end_offset; ++v) {
+                func(base + *v);
+            }
+            break;
+        }
+        case ChunkType::RUN: {
+            const uint16_t *v = values(chunk);
+            for (uint32_t run = 0; run < chunk.length; ++run) {
+                uint64_t last = std::min(uint64_t(v[2 * run + 1]), end_offset - 1);
+                for (uint64_t offset = std::max(uint32_t(v[2 * run]), begin_offset); offset <= last; ++offset) {
+                    func(base + offset);
+                }
+            }
+            break;
+        }
+        case ChunkType::BITMAP: {
+            const Word *w = words(chunk);
+            for (uint64_t word_num = begin_offset / WordLen; word_num * WordLen < end_offset; ++word_num) {
+                Word word = w[word_num];
+                if (word_num == begin_offset / WordLen) {
+                    word &= checkTab(begin_offset);
+                }
+                while (word != 0) {
+                    uint64_t offset = word_num * WordLen + vespalib::Optimized::lsbIdx(word);
+                    if (offset >= end_offset) {
+                        break;
+                    }
+                    func(base + offset);
+                    word &= word - 1;
+                }
+            }
+            break;
+        }
+        }
+    }
+}
+
+}
@@ -0,0 +1,185 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "compressedbitvectoriterator.h"
+#include "bitvector.h"
+#include <vespa/searchlib/queryeval/emptysearch.h>
+#include <vespa/vespalib/objects/visit.h>
+
+namespace search {
+
+using fef::TermFieldMatchData;
+using vespalib::Trinary;
+
+CompressedBitVectorIterator::CompressedBitVectorIterator(const CompressedBitVector & bv, uint32_t docIdLimit, TermFieldMatchData & matchData) :
+    _docIdLimit(std::min(docIdLimit, bv.size())),
+    _bv(bv),
+    _tfmd(matchData)
+{
+    _tfmd.reset(0);
+}
+
+void
+CompressedBitVectorIterator::initRange(uint32_t begin, uint32_t end)
+{
+    SearchIterator::initRange(begin, end);
+    if (begin >= _docIdLimit) {
+        setAtEnd();
+    }
+}
+
+void
+CompressedBitVectorIterator::visitMembers(vespalib::ObjectVisitor &visitor) const
+{
+    SearchIterator::visitMembers(visitor);
+    visit(visitor, "docIdLimit", _docIdLimit);
+    visit(visitor, "numTrueBits", _bv.countTrueBits());
+    visit(visitor, "sizeBytes", _bv.sizeBytes());
+    visit(visitor, "termfieldmatchdata.fieldId", _tfmd.getFieldId());
+    visit(visitor, "termfieldmatchdata.docid", _tfmd.getDocId());
+}
+
+namespace {
+
+template<bool inverse>
+class CompressedBitVectorIteratorT : public CompressedBitVectorIterator {
+public:
+    CompressedBitVectorIteratorT(const CompressedBitVector &other, uint32_t docIdLimit, TermFieldMatchData &matchData);
+
+    void doSeek(uint32_t docId) override;
+    BitVector::UP get_hits(uint32_t begin_id) override;
+    void or_hits_into(BitVector &result, uint32_t begin_id) override;
+    void and_hits_into(BitVector &result, uint32_t begin_id) override;
+    bool isInverted() const override { return inverse; }
+private:
+    bool isSet(uint32_t docId) const { return inverse == ! _bv.testBit(docId); }
+};
+
+template<bool inverse>
+CompressedBitVectorIteratorT<inverse>::CompressedBitVectorIteratorT(const CompressedBitVector & bv, uint32_t docIdLimit, TermFieldMatchData & matchData) :
+    CompressedBitVectorIterator(bv, docIdLimit, matchData)
+{
+}
+
+template<bool inverse>
+void
+CompressedBitVectorIteratorT<inverse>::doSeek(uint32_t docId)
+{
+    if (__builtin_expect(docId >= _docIdLimit, false)) {
+        setAtEnd();
+    } else if (isSet(docId)) {
+        setDocId(docId);
+    }
+}
+
+template<bool inverse>
+BitVector::UP
+CompressedBitVectorIteratorT<inverse>::get_hits(uint32_t begin_id) {
+    BitVector::UP result = BitVector::create(begin_id, getEndId());
+    _bv.orInto(*result);
+    if (inverse) {
+        result->notSelf();
+    }
+    if (begin_id < getDocId()) {
+        result->clearInterval(begin_id, getDocId());
+    }
+    return result;
+}
+
+template<bool inverse>
+void
+CompressedBitVectorIteratorT<inverse>::or_hits_into(BitVector &result, uint32_t) {
+    if (inverse) {
+        result.notSelf();
+        _bv.andInto(result);
+        result.notSelf();
+    } else {
+        _bv.orInto(result);
+    }
+}
+
+template<bool inverse>
+void
+CompressedBitVectorIteratorT<inverse>::and_hits_into(BitVector &result, uint32_t) {
+    if (inverse) {
+        _bv.andNotInto(result);
+    } else {
+        _bv.andInto(result);
+    }
+}
+
+template<bool inverse>
+class CompressedBitVectorIteratorStrictT : public CompressedBitVectorIteratorT<inverse>
+{
+public:
+    CompressedBitVectorIteratorStrictT(const CompressedBitVector & bv, uint32_t docIdLimit, TermFieldMatchData & matchData);
+private:
+    void initRange(uint32_t begin, uint32_t end) override;
+    void doSeek(uint32_t docId) override;
+    Trinary is_strict() const override { return Trinary::True; }
+    uint32_t getNextBit(uint32_t docId) const {
+        return inverse ? this->_bv.getNextFalseBit(docId) : this->_bv.getNextTrueBit(docId);
+    }
+};
+
+template<bool inverse>
+CompressedBitVectorIteratorStrictT<inverse>::CompressedBitVectorIteratorStrictT(const CompressedBitVector & bv, uint32_t docIdLimit, TermFieldMatchData & matchData) :
+    CompressedBitVectorIteratorT<inverse>(bv, docIdLimit, matchData)
+{
+}
+
+template<bool inverse>
+void
+CompressedBitVectorIteratorStrictT<inverse>::doSeek(uint32_t docId)
+{
+    if (__builtin_expect(docId >= this->_docIdLimit, false)) {
+        this->setAtEnd();
+        return;
+    }
+
+    docId = getNextBit(docId);
+    if (__builtin_expect(docId >= this->_docIdLimit, false)) {
+        this->setAtEnd();
+    } else {
+        this->setDocId(docId);
+    }
+}
+
+template<bool inverse>
+void
+CompressedBitVectorIteratorStrictT<inverse>::initRange(uint32_t begin, uint32_t end)
+{
+    CompressedBitVectorIterator::initRange(begin, end);
+    if (!this->isAtEnd()) {
+        uint32_t docId = getNextBit(begin);
+        if (docId >= this->_docIdLimit) {
+            this->setAtEnd();
+        } else {
+            this->setDocId(docId);
+        }
+    }
+}
+
+}
+
+queryeval::SearchIterator::UP
+CompressedBitVectorIterator::create(const CompressedBitVector *const bv, uint32_t docIdLimit,
+                                    TermFieldMatchData &matchData, bool strict, bool inverted)
+{
+    if (bv == nullptr) {
+        return std::make_unique<queryeval::EmptySearch>();
+    } else if (strict) {
+        if (inverted) {
+            return std::make_unique<CompressedBitVectorIteratorStrictT<true>>(*bv, docIdLimit, matchData);
+        } else {
+            return std::make_unique<CompressedBitVectorIteratorStrictT<false>>(*bv, docIdLimit, matchData);
+        }
+    } else {
+        if (inverted) {
+            return std::make_unique<CompressedBitVectorIteratorT<true>>(*bv, docIdLimit, matchData);
+        } else {
+            return std::make_unique<CompressedBitVectorIteratorT<false>>(*bv, docIdLimit, matchData);
+        }
+    }
+}
+
+} // namespace search
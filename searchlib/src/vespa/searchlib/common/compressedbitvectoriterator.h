@@ -0,0 +1,41 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "compressedbitvector.h"
+#include <vespa/searchlib/queryeval/searchiterator.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+
+namespace search {
+
+/**
+ * Search iterator over a compressed bit vector. Behaves like
+ * BitVectorIterator, and can also be stolen by
+ * queryeval::MultiBitVectorIterator.
+ */
+class CompressedBitVectorIterator : public queryeval::SearchIterator
+{
+protected:
+    CompressedBitVectorIterator(const CompressedBitVector & bv, uint32_t docIdLimit, fef::TermFieldMatchData &matchData);
+    void initRange(uint32_t begin, uint32_t end) override;
+
+    uint32_t                    _docIdLimit;
+    const CompressedBitVector & _bv;
+private:
+    void visitMembers(vespalib::ObjectVisitor &visitor) const override;
+    void doUnpack(uint32_t docId) override final {
+        _tfmd.resetOnlyDocId(docId);
+    }
+    bool isCompressedBitVector() const override { return true; }
+    fef::TermFieldMatchData  &_tfmd;
+public:
+    virtual bool isInverted() const = 0;
+    const CompressedBitVector &getCompressedBitVector() const { return _bv; }
+
+    Trinary is_strict() const override { return Trinary::False; }
+    uint32_t getDocIdLimit() const { return _docIdLimit; }
+    static UP create(const CompressedBitVector *const other, uint32_t docIdLimit,
+                     fef::TermFieldMatchData &matchData, bool strict, bool inverted = false);
+};
+
+} // namespace search
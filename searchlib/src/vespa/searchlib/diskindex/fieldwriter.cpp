@@ -4,6 +4,7 @@
 #include "zcposocc.h"
 #include "extposocc.h"
 #include "pagedict4file.h"
+#include <vespa/searchcommon/common/schema.h>
 #include <vespa/vespalib/util/error.h>
 #include <vespa/log/log.h>
 
@@ -64,6 +65,12 @@ FieldWriter::open(const vespalib::string &prefix,
     }
     if (encode_interleaved_features) {
         params.set("interleaved_features", encode_interleaved_features);
+        if (schema.getIndexField(indexId).use_block_max()) {
+            params.set("block_max", true);
+        }
+    }
+    if (schema.getIndexField(indexId).use_block_postings()) {
+        params.set("block_doc_ids", true);
     }
     
     _dictFile = std::make_unique<PageDict4FileSeqWrite>();
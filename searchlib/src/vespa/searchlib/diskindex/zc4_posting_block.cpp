@@ -0,0 +1,188 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "zc4_posting_block.h"
+#include <cassert>
+#include <cstddef>
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
+namespace search::diskindex {
+
+namespace {
+
+// Number of bytes used by value with given 2-bit length code
+inline uint32_t code_length(uint32_t code) { return code + 1; }
+
+inline uint32_t
+value_code(uint32_t value)
+{
+    return (value < (1u << 8)) ? 0 : ((value < (1u << 16)) ? 1 : ((value < (1u << 24)) ? 2 : 3));
+}
+
+/*
+ * Lookup tables for decoding 4 values controlled by one control byte:
+ * number of data bytes used and byte shuffle mask expanding the data
+ * bytes to 4 little endian 32-bit values.
+ */
+struct StreamVByteTables {
+    uint8_t lengths[256];
+    uint8_t shuffles[256][16];
+
+    StreamVByteTables() noexcept {
+        for (uint32_t control = 0; control < 256; ++control) {
+            uint32_t offset = 0;
+            for (uint32_t i = 0; i < 4; ++i) {
+                uint32_t length = code_length((control >> (2 * i)) & 3);
+                for (uint32_t j = 0; j < 4; ++j) {
+                    shuffles[control][4 * i + j] = (j < length) ? (offset + j) : 0xff;
+                }
+                offset += length;
+            }
+            lengths[control] = offset;
+        }
+    }
+};
+
+const StreamVByteTables tables;
+
+inline const uint8_t *
+decode_value(const uint8_t *data, uint32_t code, uint32_t &value)
+{
+    switch (code) {
+    case 0:
+        value = data[0];
+        break;
+    case 1:
+        value = data[0] | (data[1] << 8);
+        break;
+    case 2:
+        value = data[0] | (data[1] << 8) | (data[2] << 16);
+        break;
+    default:
+        value = data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24);
+    }
+    return data + code_length(code);
+}
+
+inline const uint8_t *
+decode_zc(const uint8_t *valI, uint32_t &value)
+{
+    uint32_t res = 0;
+    uint32_t shift = 0;
+    while (*valI >= (1 << 7)) {
+        res |= static_cast<uint32_t>(*valI & ((1 << 7) - 1)) << shift;
+        shift += 7;
+        ++valI;
+    }
+    value = res | (static_cast<uint32_t>(*valI) << shift);
+    return valI + 1;
+}
+
+}
+
+Zc4PostingBlock::Zc4PostingBlock()
+    : _num_docs(0),
+      _last_doc_id(0),
+      _max_num_occs(0),
+      _min_field_length(0),
+      _features_size(0),
+      _payload(nullptr),
+      _payload_end(nullptr),
+      _doc_ids(),
+      _field_lengths(),
+      _num_occs()
+{
+}
+
+const uint8_t *
+Zc4PostingBlock::read_header(const uint8_t *valI, uint32_t num_docs, uint32_t prev_doc_id,
+                             bool decode_block_max, bool decode_features)
+{
+    assert(num_docs > 0 && num_docs <= block_size);
+    _num_docs = num_docs;
+    uint32_t value;
+    valI = decode_zc(valI, value);
+    _last_doc_id = prev_doc_id + 1 + value;
+    if (decode_block_max) {
+        valI = decode_zc(valI, value);
+        _max_num_occs = value + 1;
+        valI = decode_zc(valI, value);
+        _min_field_length = value + 1;
+    }
+    if (decode_features) {
+        valI = decode_zc(valI, value);
+        _features_size = value;
+    } else {
+        _features_size = 0;
+    }
+    valI = decode_zc(valI, value);
+    _payload = valI;
+    _payload_end = valI + value;
+    return _payload_end;
+}
+
+void
+Zc4PostingBlock::decode_payload(uint32_t prev_doc_id, bool decode_interleaved_features)
+{
+    uint32_t values[3 * block_size];
+    uint32_t num_values = decode_interleaved_features ? 3 * _num_docs : _num_docs;
+    const uint8_t *payload_end = decode_values(_payload, _payload_end, values, num_values);
+    assert(payload_end == _payload_end);
+    (void) payload_end;
+    uint32_t doc_id = prev_doc_id;
+    for (uint32_t i = 0; i < _num_docs; ++i) {
+        doc_id += values[i] + 1;
+        _doc_ids[i] = doc_id;
+    }
+    assert(doc_id == _last_doc_id);
+    if (decode_interleaved_features) {
+        const uint32_t *field_lengths = values + _num_docs;
+        const uint32_t *num_occs = field_lengths + _num_docs;
+        for (uint32_t i = 0; i < _num_docs; ++i) {
+            _field_lengths[i] = field_lengths[i] + 1;
+            _num_occs[i] = num_occs[i] + 1;
+        }
+    }
+}
+
+void
+Zc4PostingBlock::encode_values(const uint32_t *values, uint32_t num_values, std::vector<uint8_t> &buf)
+{
+    size_t control_pos = buf.size();
+    buf.resize(control_pos + (num_values + 3) / 4, 0);
+    for (uint32_t i = 0; i < num_values; ++i) {
+        uint32_t value = values[i];
+        uint32_t code = value_code(value);
+        buf[control_pos + i / 4] |= (code << (2 * (i % 4)));
+        for (uint32_t j = 0; j < code_length(code); ++j) {
+            buf.push_back(value & 0xff);
+            value >>= 8;
+        }
+    }
+}
+
+const uint8_t *
+Zc4PostingBlock::decode_values(const uint8_t *src, const uint8_t *src_end, uint32_t *values, uint32_t num_values)
+{
+    const uint8_t *data = src + (num_values + 3) / 4;
+    uint32_t i = 0;
+#ifdef __SSSE3__
+    // Each 16 byte load covers the up to 16 data bytes used by 4 values
+    for (; i + 4 <= num_values && data + 16 <= src_end; i += 4) {
+        uint8_t c = src[i / 4];
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+        __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i *>(tables.shuffles[c]));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(values + i), _mm_shuffle_epi8(in, mask));
+        data += tables.lengths[c];
+    }
+#endif
+    for (; i < num_values; ++i) {
+        uint32_t code = (src[i / 4] >> (2 * (i % 4))) & 3;
+        data = decode_value(data, code, values[i]);
+    }
+    (void) src_end;
+    return data;
+}
+
+}
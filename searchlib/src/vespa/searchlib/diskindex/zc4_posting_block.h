@@ -0,0 +1,76 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace search::diskindex {
+
+/*
+ * Block of doc ids and interleaved features used by the block variant
+ * of the Zc4 posting list format, selected by the block_doc_ids posting
+ * list parameter. It replaces the zc encoded doc id deltas and the
+ * L1-L4 skip info for words with skip info.
+ *
+ * Each block covers up to block_size documents and is stored as
+ *
+ *   last doc id delta - 1                       (zc)
+ *   max num_occs - 1, min field_length - 1      (zc, only with block max)
+ *   feature bits used by the block              (zc, only with features)
+ *   payload size in bytes                       (zc)
+ *   payload
+ *
+ * The payload is a StreamVByte encoding (2-bit byte length codes packed
+ * into control bytes, followed by the value bytes) of the doc id deltas
+ * (- 1) for the block, followed by field lengths (- 1) and num occs (- 1)
+ * when interleaved features are present. This allows a whole block to be
+ * decoded using byte shuffles instead of one value at a time.
+ *
+ * The block headers form a single level skip list with a stride of
+ * block_size documents.
+ */
+class Zc4PostingBlock
+{
+public:
+    static constexpr uint32_t block_size = 128;
+private:
+    uint32_t       _num_docs;
+    uint32_t       _last_doc_id;
+    uint32_t       _max_num_occs;
+    uint32_t       _min_field_length;
+    uint64_t       _features_size;
+    const uint8_t *_payload;
+    const uint8_t *_payload_end;
+    uint32_t       _doc_ids[block_size];
+    uint32_t       _field_lengths[block_size];
+    uint32_t       _num_occs[block_size];
+
+public:
+    Zc4PostingBlock();
+
+    /*
+     * Read block header starting at valI. Payload is not decoded.
+     * Returns start of next block.
+     */
+    const uint8_t *read_header(const uint8_t *valI, uint32_t num_docs, uint32_t prev_doc_id,
+                               bool decode_block_max, bool decode_features);
+    // Decode doc ids (and interleaved features) for block, prev_doc_id is last doc id in previous block.
+    void decode_payload(uint32_t prev_doc_id, bool decode_interleaved_features);
+
+    uint32_t get_num_docs() const noexcept { return _num_docs; }
+    uint32_t get_last_doc_id() const noexcept { return _last_doc_id; }
+    uint32_t get_max_num_occs() const noexcept { return _max_num_occs; }
+    uint32_t get_min_field_length() const noexcept { return _min_field_length; }
+    uint64_t get_features_size() const noexcept { return _features_size; }
+    const uint32_t *get_doc_ids() const noexcept { return _doc_ids; }
+    const uint32_t *get_field_lengths() const noexcept { return _field_lengths; }
+    const uint32_t *get_num_occs() const noexcept { return _num_occs; }
+
+    // StreamVByte encoding of values, appended to buf.
+    static void encode_values(const uint32_t *values, uint32_t num_values, std::vector<uint8_t> &buf);
+    // StreamVByte decoding of values, returns end of encoded data.
+    static const uint8_t *decode_values(const uint8_t *src, const uint8_t *src_end, uint32_t *values, uint32_t num_values);
+};
+
+}
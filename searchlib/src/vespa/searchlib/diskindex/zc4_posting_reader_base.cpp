@@ -3,6 +3,8 @@
 #include "zc4_posting_reader_base.h"
 #include "zc4_posting_header.h"
 #include <vespa/searchlib/index/docidandfeatures.h>
+#include <algorithm>
+#include <limits>
 
 namespace search::diskindex {
 
@@ -62,6 +64,17 @@ Zc4PostingReaderBase::NoSkip::read(bool decode_interleaved_features)
     _doc_id_pos = _zc_buf.pos();
 }
 
+void
+Zc4PostingReaderBase::NoSkip::read_block(Zc4PostingBlock &block, uint32_t num_docs, const Zc4PostingParams &params)
+{
+    assert(_zc_buf._valI < _zc_buf._valE);
+    const uint8_t *block_end = block.read_header(_zc_buf._valI, num_docs, _doc_id, params._encode_block_max, params._encode_features);
+    assert(block_end <= _zc_buf._valE);
+    block.decode_payload(_doc_id, params._encode_interleaved_features);
+    _zc_buf._valI += (block_end - _zc_buf._valI);
+    _doc_id_pos = _zc_buf.pos();
+}
+
 void
 Zc4PostingReaderBase::NoSkip::check_not_end(uint32_t last_doc_id)
 {
@@ -71,7 +84,12 @@ Zc4PostingReaderBase::NoSkip::check_not_end(uint32_t last_doc_id)
 
 Zc4PostingReaderBase::L1Skip::L1Skip()
     : NoSkipBase(),
-      _l1_skip_pos(0)
+      _l1_skip_pos(0),
+      _has_block_max(false),
+      _block_max_num_occs(0),
+      _block_min_field_length(0),
+      _seen_max_num_occs(0),
+      _seen_min_field_length(0)
 {
 }
 
@@ -80,6 +98,7 @@ Zc4PostingReaderBase::L1Skip::setup(DecodeContext &decode_context, uint32_t size
 {
     NoSkipBase::setup(decode_context, size, doc_id);
     _l1_skip_pos = 0;
+    _has_block_max = false;
     if (size != 0) {
         next_skip_entry();
     } else {
@@ -108,6 +127,37 @@ Zc4PostingReaderBase::L1Skip::next_skip_entry()
     _doc_id += (_zc_buf.decode() + 1);
 }
 
+void
+Zc4PostingReaderBase::L1Skip::read_block_max()
+{
+    _has_block_max = true;
+    _block_max_num_occs = _zc_buf.decode() + 1;
+    _block_min_field_length = _zc_buf.decode() + 1;
+    _seen_max_num_occs = 0;
+    _seen_min_field_length = std::numeric_limits<uint32_t>::max();
+}
+
+void
+Zc4PostingReaderBase::L1Skip::check_block_max(const NoSkip &no_skip)
+{
+    if (_has_block_max) {
+        assert(no_skip.get_num_occs() <= _block_max_num_occs);
+        assert(no_skip.get_field_length() >= _block_min_field_length);
+        _seen_max_num_occs = std::max(_seen_max_num_occs, no_skip.get_num_occs());
+        _seen_min_field_length = std::min(_seen_min_field_length, no_skip.get_field_length());
+    }
+}
+
+void
+Zc4PostingReaderBase::L1Skip::check_block_max_end()
+{
+    if (_has_block_max) {
+        // Block max info should be tight, not just an upper bound
+        assert(_seen_max_num_occs == _block_max_num_occs);
+        assert(_seen_min_field_length == _block_min_field_length);
+    }
+}
+
 Zc4PostingReaderBase::L2Skip::L2Skip()
     : L1Skip(),
       _l2_skip_pos(0)
@@ -187,6 +237,10 @@ Zc4PostingReaderBase::Zc4PostingReaderBase(bool dynamic_k)
       _l2_skip(),
       _l3_skip(),
       _l4_skip(),
+      _block(),
+      _block_docs(0),
+      _block_idx(0),
+      _block_features_pos(0),
       _chunkNo(0),
       _features_size(0),
       _counts(),
@@ -201,6 +255,10 @@ Zc4PostingReaderBase::~Zc4PostingReaderBase()
 void
 Zc4PostingReaderBase::read_common_word_doc_id(DecodeContext64Base &decode_context)
 {
+    if (_posting_params._encode_block_doc_ids) {
+        read_block_word_doc_id(decode_context);
+        return;
+    }
     // Split docid & features.
     if (_no_skip.get_doc_id() >= _l1_skip.get_doc_id()) {
         _no_skip.set_features_pos(decode_context.getReadOffset());
@@ -217,10 +275,16 @@ Zc4PostingReaderBase::read_common_word_doc_id(DecodeContext64Base &decode_contex
             }
             _l2_skip.next_skip_entry();
         }
+        _l1_skip.check_block_max_end();
         _l1_skip.next_skip_entry();
+        if (_posting_params._encode_block_max) {
+            _l1_skip.read_block_max();
+        }
     }
     _no_skip.read(_posting_params._encode_interleaved_features);
+    _l1_skip.check_block_max(_no_skip);
     if (_residue == 1) {
+        _l1_skip.check_block_max_end();
         _no_skip.check_end(_last_doc_id);
         _l1_skip.check_end(_last_doc_id);
         _l2_skip.check_end(_last_doc_id);
@@ -231,6 +295,40 @@ Zc4PostingReaderBase::read_common_word_doc_id(DecodeContext64Base &decode_contex
     }
 }
 
+void
+Zc4PostingReaderBase::read_block_word_doc_id(DecodeContext64Base &decode_context)
+{
+    if (_block_idx == _block_docs) {
+        uint64_t features_pos = decode_context.getReadOffset();
+        if (_block_docs != 0 && _posting_params._encode_features) {
+            assert(features_pos == _block_features_pos + _block.get_features_size());
+        }
+        _block_features_pos = features_pos;
+        _block_docs = std::min(_residue, Zc4PostingBlock::block_size);
+        _block_idx = 0;
+        _no_skip.read_block(_block, _block_docs, _posting_params);
+        if (_posting_params._encode_block_max) {
+            // Block max info should be tight, not just an upper bound
+            const uint32_t *num_occs = _block.get_num_occs();
+            const uint32_t *field_lengths = _block.get_field_lengths();
+            assert(*std::max_element(num_occs, num_occs + _block_docs) == _block.get_max_num_occs());
+            assert(*std::min_element(field_lengths, field_lengths + _block_docs) == _block.get_min_field_length());
+        }
+    }
+    _no_skip.set_doc_id(_block.get_doc_ids()[_block_idx]);
+    if (_posting_params._encode_interleaved_features) {
+        _no_skip.set_field_length(_block.get_field_lengths()[_block_idx]);
+        _no_skip.set_num_occs(_block.get_num_occs()[_block_idx]);
+    }
+    ++_block_idx;
+    if (_residue == 1) {
+        assert(_block_idx == _block_docs);
+        _no_skip.check_end(_last_doc_id);
+    } else {
+        assert(_no_skip.get_doc_id() < _last_doc_id);
+    }
+}
+
 void
 Zc4PostingReaderBase::read_word_start_with_skip(DecodeContext64Base &decode_context, const Zc4PostingHeader &header)
 {
@@ -249,7 +347,15 @@ Zc4PostingReaderBase::read_word_start_with_skip(DecodeContext64Base &decode_cont
     }
     uint32_t prev_doc_id = _no_skip.get_doc_id();
     _no_skip.setup(decode_context, header._doc_ids_size, prev_doc_id);
+    if (_posting_params._encode_block_doc_ids) {
+        assert(header._l1_skip_size == 0);
+        _block_docs = 0;
+        _block_idx = 0;
+    }
     _l1_skip.setup(decode_context, header._l1_skip_size, prev_doc_id, _last_doc_id);
+    if (_posting_params._encode_block_max && header._l1_skip_size != 0) {
+        _l1_skip.read_block_max();
+    }
     _l2_skip.setup(decode_context, header._l2_skip_size, prev_doc_id, _last_doc_id);
     _l3_skip.setup(decode_context, header._l3_skip_size, prev_doc_id, _last_doc_id);
     _l4_skip.setup(decode_context, header._l4_skip_size, prev_doc_id, _last_doc_id);
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "zc4_posting_block.h"
 #include "zc4_posting_params.h"
 #include "zcbuf.h"
 #include <vespa/searchlib/bitcompression/compression.h>
@@ -46,6 +47,7 @@ protected:
         NoSkip();
         ~NoSkip();
         void read(bool decode_interleaved_features);
+        void read_block(Zc4PostingBlock &block, uint32_t num_docs, const Zc4PostingParams &params);
         void check_not_end(uint32_t last_doc_id);
         uint32_t get_field_length() const { return _field_length; }
         uint32_t get_num_occs()     const { return _num_occs; }
@@ -56,11 +58,19 @@ protected:
     class L1Skip : public NoSkipBase {
     protected:
         uint32_t _l1_skip_pos;
+        bool     _has_block_max;
+        uint32_t _block_max_num_occs;
+        uint32_t _block_min_field_length;
+        uint32_t _seen_max_num_occs;
+        uint32_t _seen_min_field_length;
     public:
         L1Skip();
         void setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id);
         void check(const NoSkipBase &no_skip, bool top_level, bool decode_features);
         void next_skip_entry();
+        void read_block_max();
+        void check_block_max(const NoSkip &no_skip);
+        void check_block_max_end();
         uint32_t get_l1_skip_pos() const { return _l1_skip_pos; }
     };
     class L2Skip : public L1Skip
@@ -103,6 +113,12 @@ protected:
     L3Skip _l3_skip;
     L4Skip _l4_skip;
 
+    // Current block when doc ids are stored in blocks
+    Zc4PostingBlock _block;
+    uint32_t _block_docs;         // Documents in current block
+    uint32_t _block_idx;          // Index of next document in current block
+    uint64_t _block_features_pos; // Start of features for current block
+
     uint64_t _numWords;     // Number of words in file
     uint32_t _chunkNo;      // Chunk number
 
@@ -112,6 +128,7 @@ protected:
 
     uint32_t _residue;            // Number of unread documents after word header
     void read_common_word_doc_id(bitcompression::DecodeContext64Base &decode_context);
+    void read_block_word_doc_id(bitcompression::DecodeContext64Base &decode_context);
     void read_word_start_with_skip(bitcompression::DecodeContext64Base &decode_context, const Zc4PostingHeader &header);
     void read_word_start(bitcompression::DecodeContext64Base &decode_context);
 public:
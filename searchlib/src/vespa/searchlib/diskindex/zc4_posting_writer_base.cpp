@@ -1,8 +1,12 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "zc4_posting_writer_base.h"
+#include "zc4_posting_block.h"
 #include <vespa/searchlib/index/postinglistcounts.h>
 #include <vespa/searchlib/index/postinglistparams.h>
+#include <algorithm>
+#include <cassert>
+#include <limits>
 
 using search::index::PostingListCounts;
 using search::index::PostingListParams;
@@ -38,16 +42,27 @@ protected:
     uint32_t _stride_check;
     uint32_t _l1_skip_pos;
     const bool _encode_features;
+    const bool _encode_block_max;
+    uint32_t _block_max_num_occs;
+    uint32_t _block_min_field_length;
 
+    void encode_block_max(ZcBuf &zc_buf);
 public:
-    L1SkipEncoder(bool encode_features)
+    L1SkipEncoder(bool encode_features, bool encode_block_max)
         : DocIdEncoder(),
           _stride_check(0u),
           _l1_skip_pos(0u),
-          _encode_features(encode_features)
+          _encode_features(encode_features),
+          _encode_block_max(encode_block_max),
+          _block_max_num_occs(0u),
+          _block_min_field_length(std::numeric_limits<uint32_t>::max())
     {
     }
 
+    void add_to_block(const DocIdAndFeatureSize &doc_id_and_feature_size) {
+        _block_max_num_occs = std::max(_block_max_num_occs, doc_id_and_feature_size._num_occs);
+        _block_min_field_length = std::min(_block_min_field_length, doc_id_and_feature_size._field_length);
+    }
     void encode_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder);
     void write_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder);
     bool should_write_skip(uint32_t stride) { return ++_stride_check >= stride; }
@@ -62,7 +77,7 @@ protected:
 
 public:
     L2SkipEncoder(bool encode_features)
-        : L1SkipEncoder(encode_features),
+        : L1SkipEncoder(encode_features, false),
           _l2_skip_pos(0u)
     {
     }
@@ -115,6 +130,20 @@ DocIdEncoder::write(ZcBuf &zc_buf, const DocIdAndFeatureSize &doc_id_and_feature
     _doc_id_pos = zc_buf.size();
 }
 
+void
+L1SkipEncoder::encode_block_max(ZcBuf &zc_buf)
+{
+    if (_encode_block_max) {
+        // Placed right after doc id delta, allowing iterator to read it when peeking at next skip doc id
+        assert(_block_max_num_occs > 0);
+        zc_buf.encode(_block_max_num_occs - 1);
+        assert(_block_min_field_length > 0 && _block_min_field_length != std::numeric_limits<uint32_t>::max());
+        zc_buf.encode(_block_min_field_length - 1);
+        _block_max_num_occs = 0u;
+        _block_min_field_length = std::numeric_limits<uint32_t>::max();
+    }
+}
+
 void
 L1SkipEncoder::encode_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder)
 {
@@ -124,6 +153,7 @@ L1SkipEncoder::encode_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder)
     assert(static_cast<int32_t>(doc_id_delta) > 0);
     zc_buf.encode(doc_id_delta - 1);
     _doc_id = doc_id_encoder.get_doc_id();
+    encode_block_max(zc_buf);
     // doc id pos
     zc_buf.encode(doc_id_encoder.get_doc_id_pos() - _doc_id_pos - 1);
     _doc_id_pos = doc_id_encoder.get_doc_id_pos();
@@ -146,6 +176,7 @@ L1SkipEncoder::write_partial_skip(ZcBuf &zc_buf, uint32_t doc_id)
 {
     if (zc_buf.size() > 0) {
         zc_buf.encode(doc_id - _doc_id - 1);
+        encode_block_max(zc_buf);
     }
 }
 
@@ -207,6 +238,8 @@ Zc4PostingWriterBase::Zc4PostingWriterBase(PostingListCounts &counts)
       _writePos(0),
       _dynamicK(false),
       _encode_interleaved_features(false),
+      _encode_block_max(false),
+      _encode_block_doc_ids(false),
       _zcDocIds(),
       _l1Skip(),
       _l2Skip(),
@@ -237,7 +270,7 @@ void
 Zc4PostingWriterBase::calc_skip_info(bool encode_features)
 {
     DocIdEncoder doc_id_encoder;
-    L1SkipEncoder l1_skip_encoder(encode_features);
+    L1SkipEncoder l1_skip_encoder(encode_features, get_encode_block_max());
     L2SkipEncoder l2_skip_encoder(encode_features);
     L3SkipEncoder l3_skip_encoder(encode_features);
     L4SkipEncoder l4_skip_encoder(encode_features);
@@ -264,6 +297,7 @@ Zc4PostingWriterBase::calc_skip_info(bool encode_features)
             }
         }
         doc_id_encoder.write(_zcDocIds, doc_id_and_feature_size, _encode_interleaved_features);
+        l1_skip_encoder.add_to_block(doc_id_and_feature_size);
     }
     // Extra partial entries for skip tables to simplify iterator during search
     l1_skip_encoder.write_partial_skip(_l1Skip, doc_id_encoder.get_doc_id());
@@ -272,6 +306,61 @@ Zc4PostingWriterBase::calc_skip_info(bool encode_features)
     l4_skip_encoder.write_partial_skip(_l4Skip, doc_id_encoder.get_doc_id());
 }
 
+void
+Zc4PostingWriterBase::calc_block_doc_ids(bool encode_features)
+{
+    bool encode_block_max = get_encode_block_max();
+    uint32_t prev_doc_id = _counts._segments.empty() ? 0u : _counts._segments.back()._lastDoc;
+    std::vector<uint32_t> values;
+    std::vector<uint8_t> payload;
+    values.reserve(3 * Zc4PostingBlock::block_size);
+    auto itr = _docIds.cbegin();
+    while (itr != _docIds.cend()) {
+        auto block_end = itr + std::min(static_cast<size_t>(Zc4PostingBlock::block_size), static_cast<size_t>(_docIds.cend() - itr));
+        uint32_t max_num_occs = 0u;
+        uint32_t min_field_length = std::numeric_limits<uint32_t>::max();
+        uint64_t features_size = 0u;
+        values.clear();
+        uint32_t doc_id = prev_doc_id;
+        for (auto it = itr; it != block_end; ++it) {
+            assert(it->_doc_id > doc_id);
+            values.push_back(it->_doc_id - doc_id - 1);
+            doc_id = it->_doc_id;
+            features_size += it->_features_size;
+            max_num_occs = std::max(max_num_occs, it->_num_occs);
+            min_field_length = std::min(min_field_length, it->_field_length);
+        }
+        if (_encode_interleaved_features) {
+            for (auto it = itr; it != block_end; ++it) {
+                assert(it->_field_length > 0);
+                values.push_back(it->_field_length - 1);
+            }
+            for (auto it = itr; it != block_end; ++it) {
+                assert(it->_num_occs > 0);
+                values.push_back(it->_num_occs - 1);
+            }
+        }
+        _zcDocIds.encode(doc_id - prev_doc_id - 1);
+        if (encode_block_max) {
+            _zcDocIds.encode(max_num_occs - 1);
+            _zcDocIds.encode(min_field_length - 1);
+        }
+        if (encode_features) {
+            assert(static_cast<uint32_t>(features_size) == features_size);
+            _zcDocIds.encode(features_size);
+        }
+        payload.clear();
+        Zc4PostingBlock::encode_values(values.data(), values.size(), payload);
+        _zcDocIds.encode(payload.size());
+        for (uint8_t byte : payload) {
+            *_zcDocIds._valI++ = byte;
+            _zcDocIds.maybeExpand();
+        }
+        prev_doc_id = doc_id;
+        itr = block_end;
+    }
+}
+
 void
 Zc4PostingWriterBase::clear_skip_info()
 {
@@ -289,6 +378,8 @@ Zc4PostingWriterBase::set_posting_list_params(const PostingListParams &params)
     params.get("minChunkDocs", _minChunkDocs);
     params.get("minSkipDocs", _minSkipDocs);
     params.get("interleaved_features", _encode_interleaved_features);
+    params.get("block_max", _encode_block_max);
+    params.get("block_doc_ids", _encode_block_doc_ids);
 }
 
 }
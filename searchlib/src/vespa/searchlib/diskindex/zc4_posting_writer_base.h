@@ -44,6 +44,8 @@ protected:
     uint64_t _writePos; // Bit position for start of current word
     bool _dynamicK;     // Caclulate EG compression parameters ?
     bool _encode_interleaved_features;
+    bool _encode_block_max; // Max num_occs and min field_length per L1 skip block ?
+    bool _encode_block_doc_ids; // Doc ids in Zc4PostingBlock blocks instead of zc deltas with skip info ?
     ZcBuf _zcDocIds;    // Document id deltas
     ZcBuf _l1Skip;      // L1 skip info
     ZcBuf _l2Skip;      // L2 skip info
@@ -62,6 +64,7 @@ protected:
     Zc4PostingWriterBase(index::PostingListCounts &counts);
     ~Zc4PostingWriterBase();
     void calc_skip_info(bool encode_features);
+    void calc_block_doc_ids(bool encode_features);
     void clear_skip_info();
 
 public:
@@ -73,8 +76,13 @@ public:
     uint64_t get_num_words() const { return _numWords; }
     bool get_dynamic_k() const { return _dynamicK; }
     bool get_encode_interleaved_features() const { return _encode_interleaved_features; }
+    // Block max info is derived from interleaved features and is only written together with them
+    bool get_encode_block_max() const { return _encode_block_max && _encode_interleaved_features; }
+    bool get_encode_block_doc_ids() const { return _encode_block_doc_ids; }
     void set_dynamic_k(bool dynamicK) { _dynamicK = dynamicK; }
     void set_encode_interleaved_features(bool encode_interleaved_features) { _encode_interleaved_features = encode_interleaved_features; }
+    void set_encode_block_max(bool encode_block_max) { _encode_block_max = encode_block_max; }
+    void set_encode_block_doc_ids(bool encode_block_doc_ids) { _encode_block_doc_ids = encode_block_doc_ids; }
     void set_posting_list_params(const index::PostingListParams &params);
 };
 
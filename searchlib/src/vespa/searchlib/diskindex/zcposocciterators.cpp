@@ -33,13 +33,13 @@ ZcRareWordPosOccIterator(Position start, uint64_t bitLength, uint32_t docIdLimit
 template <bool bigEndian, bool dynamic_k>
 ZcPosOccIterator<bigEndian, dynamic_k>::
 ZcPosOccIterator(Position start, uint64_t bitLength, uint32_t docIdLimit,
-                 bool decode_normal_features, bool decode_interleaved_features,
+                 bool decode_normal_features, bool decode_interleaved_features, bool decode_block_max,
                  bool unpack_normal_features, bool unpack_interleaved_features,
                  uint32_t minChunkDocs, const PostingListCounts &counts,
                  const PosOccFieldsParams *fieldsParams,
                  const TermFieldMatchDataArray &matchData)
     : ZcPostingIterator<bigEndian>(minChunkDocs, dynamic_k, counts, matchData, start, docIdLimit,
-                                   decode_normal_features, decode_interleaved_features,
+                                   decode_normal_features, decode_interleaved_features, decode_block_max,
                                    unpack_normal_features, unpack_interleaved_features),
       _decodeContextReal(start.getOccurences(), start.getBitOffset(), bitLength, fieldsParams)
 {
@@ -47,6 +47,23 @@ ZcPosOccIterator(Position start, uint64_t bitLength, uint32_t docIdLimit,
     _decodeContext = &_decodeContextReal;
 }
 
+template <bool bigEndian, bool dynamic_k>
+ZcBlockPosOccIterator<bigEndian, dynamic_k>::
+ZcBlockPosOccIterator(Position start, uint64_t bitLength, uint32_t docIdLimit,
+                      bool decode_normal_features, bool decode_interleaved_features, bool decode_block_max,
+                      bool unpack_normal_features, bool unpack_interleaved_features,
+                      uint32_t minChunkDocs, const PostingListCounts &counts,
+                      const PosOccFieldsParams *fieldsParams,
+                      const TermFieldMatchDataArray &matchData)
+    : ZcBlockPostingIterator<bigEndian>(minChunkDocs, dynamic_k, counts, matchData, start, docIdLimit,
+                                        decode_normal_features, decode_interleaved_features, decode_block_max,
+                                        unpack_normal_features, unpack_interleaved_features),
+      _decodeContextReal(start.getOccurences(), start.getBitOffset(), bitLength, fieldsParams)
+{
+    assert(!matchData.valid() || (fieldsParams->getNumFields() == matchData.size()));
+    _decodeContext = &_decodeContextReal;
+}
+
 template <bool bigEndian>
 std::unique_ptr<search::queryeval::SearchIterator>
 create_zc_posocc_iterator(const PostingListCounts &counts, bitcompression::Position start, uint64_t bit_length, const Zc4PostingParams &posting_params, const bitcompression::PosOccFieldsParams &fields_params, const fef::TermFieldMatchDataArray &match_data, bool unpack_normal_features, bool unpack_interleaved_features)
@@ -65,11 +82,17 @@ create_zc_posocc_iterator(const PostingListCounts &counts, bitcompression::Posit
         } else {
             return std::make_unique<ZcRareWordPosOccIterator<bigEndian, false>>(start, bit_length, posting_params._doc_id_limit, posting_params._encode_features, posting_params._encode_interleaved_features, unpack_normal_features, unpack_interleaved_features, &fields_params, match_data);
         }
+    } else if (posting_params._encode_block_doc_ids) {
+        if (posting_params._dynamic_k) {
+            return std::make_unique<ZcBlockPosOccIterator<bigEndian, true>>(start, bit_length, posting_params._doc_id_limit, posting_params._encode_features, posting_params._encode_interleaved_features, posting_params._encode_block_max, unpack_normal_features, unpack_interleaved_features, posting_params._min_chunk_docs, counts, &fields_params, match_data);
+        } else {
+            return std::make_unique<ZcBlockPosOccIterator<bigEndian, false>>(start, bit_length, posting_params._doc_id_limit, posting_params._encode_features, posting_params._encode_interleaved_features, posting_params._encode_block_max, unpack_normal_features, unpack_interleaved_features, posting_params._min_chunk_docs, counts, &fields_params, match_data);
+        }
     } else {
         if (posting_params._dynamic_k) {
-            return std::make_unique<ZcPosOccIterator<bigEndian, true>>(start, bit_length, posting_params._doc_id_limit, posting_params._encode_features, posting_params._encode_interleaved_features, unpack_normal_features, unpack_interleaved_features, posting_params._min_chunk_docs, counts, &fields_params, match_data);
+            return std::make_unique<ZcPosOccIterator<bigEndian, true>>(start, bit_length, posting_params._doc_id_limit, posting_params._encode_features, posting_params._encode_interleaved_features, posting_params._encode_block_max, unpack_normal_features, unpack_interleaved_features, posting_params._min_chunk_docs, counts, &fields_params, match_data);
         } else {
-            return std::make_unique<ZcPosOccIterator<bigEndian, false>>(start, bit_length, posting_params._doc_id_limit, posting_params._encode_features, posting_params._encode_interleaved_features, unpack_normal_features, unpack_interleaved_features, posting_params._min_chunk_docs, counts, &fields_params, match_data);
+            return std::make_unique<ZcPosOccIterator<bigEndian, false>>(start, bit_length, posting_params._doc_id_limit, posting_params._encode_features, posting_params._encode_interleaved_features, posting_params._encode_block_max, unpack_normal_features, unpack_interleaved_features, posting_params._min_chunk_docs, counts, &fields_params, match_data);
         }
     }
 }
@@ -96,4 +119,9 @@ template class ZcPosOccIterator<false, true>;
 template class ZcPosOccIterator<true, false>;
 template class ZcPosOccIterator<true, true>;
 
+template class ZcBlockPosOccIterator<false, false>;
+template class ZcBlockPosOccIterator<false, true>;
+template class ZcBlockPosOccIterator<true, false>;
+template class ZcBlockPosOccIterator<true, true>;
+
 }
@@ -1,9 +1,11 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "zcpostingiterators.h"
+#include "zc4_posting_header.h"
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
 #include <vespa/searchlib/fef/termfieldmatchdataarray.h>
 #include <vespa/searchlib/bitcompression/posocccompression.h>
+#include <algorithm>
 
 namespace search::diskindex {
 
@@ -188,7 +190,7 @@ ZcRareWordPostingIterator<bigEndian, dynamic_k>::readWordStart(uint32_t docIdLim
 }
 
 ZcPostingIteratorBase::ZcPostingIteratorBase(const TermFieldMatchDataArray &matchData, Position start, uint32_t docIdLimit,
-                                             bool decode_normal_features, bool decode_interleaved_features,
+                                             bool decode_normal_features, bool decode_interleaved_features, bool decode_block_max,
                                              bool unpack_normal_features, bool unpack_interleaved_features)
     : ZcIteratorBase(matchData, start, docIdLimit),
       _valI(nullptr),
@@ -205,12 +207,27 @@ ZcPostingIteratorBase::ZcPostingIteratorBase(const TermFieldMatchDataArray &matc
       _decode_interleaved_features(decode_interleaved_features),
       _unpack_normal_features(unpack_normal_features),
       _unpack_interleaved_features(unpack_interleaved_features),
+      _decode_block_max(decode_block_max),
       _chunkNo(0),
       _field_length(0),
-      _num_occs(0)
+      _num_occs(0),
+      _block_max_num_occs(0),
+      _block_min_field_length(0)
 {
 }
 
+bool
+ZcPostingIteratorBase::get_block_max_features(queryeval::BlockMaxFeatures &features) const
+{
+    if (!_decode_block_max || _l1._valIBase == nullptr || isAtEnd()) {
+        return false;
+    }
+    features.last_doc_id = _l1._skipDocId;
+    features.max_num_occs = _block_max_num_occs;
+    features.min_field_length = _block_min_field_length;
+    return true;
+}
+
 template <bool bigEndian>
 ZcPostingIterator<bigEndian>::
 ZcPostingIterator(uint32_t minChunkDocs,
@@ -218,10 +235,10 @@ ZcPostingIterator(uint32_t minChunkDocs,
                   const PostingListCounts &counts,
                   const search::fef::TermFieldMatchDataArray &matchData,
                   Position start, uint32_t docIdLimit,
-                  bool decode_normal_features, bool decode_interleaved_features,
+                  bool decode_normal_features, bool decode_interleaved_features, bool decode_block_max,
                   bool unpack_normal_features, bool unpack_interleaved_features)
     : ZcPostingIteratorBase(matchData, start, docIdLimit,
-                            decode_normal_features, decode_interleaved_features,
+                            decode_normal_features, decode_interleaved_features, decode_block_max,
                             unpack_normal_features, unpack_interleaved_features),
       _decodeContext(nullptr),
       _minChunkDocs(minChunkDocs),
@@ -235,8 +252,8 @@ ZcPostingIterator(uint32_t minChunkDocs,
 
 
 template <bool bigEndian>
-void
-ZcPostingIterator<bigEndian>::readWordStart(uint32_t docIdLimit)
+const uint8_t *
+ZcPostingIterator<bigEndian>::read_word_header(uint32_t docIdLimit, Zc4PostingHeader &header)
 {
     typedef FeatureEncodeContext<bigEndian> EC;
     DecodeContextBase &d = *_decodeContext;
@@ -244,7 +261,6 @@ ZcPostingIterator<bigEndian>::readWordStart(uint32_t docIdLimit)
     uint32_t length;
     uint64_t val64;
 
-    uint32_t prevDocId = _hasMore ? _chunk._lastDocId : 0u;
     UC64_DECODEEXPGOLOMB_NS(o, K_VALUE_ZCPOSTING_NUMDOCS, EC);
 
     _numDocs = static_cast<uint32_t>(val64) + 1;
@@ -307,19 +323,39 @@ ZcPostingIterator<bigEndian>::readWordStart(uint32_t docIdLimit)
 
     UC64_DECODECONTEXT_STORE(o, d._);
     assert((d.getBitOffset() & 7) == 0);
-    const uint8_t *bcompr = d.getByteCompr();
+    header._has_more = hasMore;
+    header._num_docs = _numDocs;
+    header._doc_ids_size = docIdsSize;
+    header._l1_skip_size = l1SkipSize;
+    header._l2_skip_size = l2SkipSize;
+    header._l3_skip_size = l3SkipSize;
+    header._l4_skip_size = l4SkipSize;
+    header._features_size = _featuresSize;
+    header._last_doc_id = _chunk._lastDocId;
+    return d.getByteCompr();
+}
+
+template <bool bigEndian>
+void
+ZcPostingIterator<bigEndian>::readWordStart(uint32_t docIdLimit)
+{
+    uint32_t prevDocId = _hasMore ? _chunk._lastDocId : 0u;
+    Zc4PostingHeader header;
+    const uint8_t *bcompr = read_word_header(docIdLimit, header);
     _valIBase = _valI = bcompr;
-    bcompr += docIdsSize;
-    _l1.setup(prevDocId, _chunk._lastDocId, bcompr, l1SkipSize);
-    _l2.setup(prevDocId, _chunk._lastDocId, bcompr, l2SkipSize);
-    _l3.setup(prevDocId, _chunk._lastDocId, bcompr, l3SkipSize);
-    _l4.setup(prevDocId, _chunk._lastDocId, bcompr, l4SkipSize);
+    bcompr += header._doc_ids_size;
+    _l1.setup(prevDocId, _chunk._lastDocId, bcompr, header._l1_skip_size);
+    decodeBlockMax();
+    _l2.setup(prevDocId, _chunk._lastDocId, bcompr, header._l2_skip_size);
+    _l3.setup(prevDocId, _chunk._lastDocId, bcompr, header._l3_skip_size);
+    _l4.setup(prevDocId, _chunk._lastDocId, bcompr, header._l4_skip_size);
     _l1.postSetup(*this);
     _l2.postSetup(_l1);
     _l3.postSetup(_l2);
     _l4.postSetup(_l3);
+    DecodeContextBase &d = *_decodeContext;
     d.setByteCompr(bcompr);
-    _hasMore = hasMore;
+    _hasMore = header._has_more;
     // Save information about start of next chunk
     _featuresValI = d.getCompr();
     _featuresBitOffset = d.getBitOffset();
@@ -385,7 +421,7 @@ ZcPostingIteratorBase::doL4SkipSeek(uint32_t docId)
     _l2._valI = _l3._l2Pos = _l4._l2Pos;
     _l3._valI = _l4._l3Pos;
     nextDocId(lastL4SkipDocId);
-    _l1.nextDocId();
+    nextL1SkipDocId();
     _l2.nextDocId();
     _l3.nextDocId();
 #if DEBUG_ZCPOSTING_PRINTF
@@ -434,7 +470,7 @@ ZcPostingIteratorBase::doL3SkipSeek(uint32_t docId)
     _l1._valI = _l2._l1Pos = _l3._l1Pos;
     _l2._valI = _l3._l2Pos;
     nextDocId(lastL3SkipDocId);
-    _l1.nextDocId();
+    nextL1SkipDocId();
     _l2.nextDocId();
 #if DEBUG_ZCPOSTING_PRINTF
     printf("L3Seek, docId %d docIdPos %d"
@@ -478,7 +514,7 @@ ZcPostingIteratorBase::doL2SkipSeek(uint32_t docId)
     _l1._skipDocId = lastL2SkipDocId;
     _l1._valI = _l2._l1Pos;
     nextDocId(lastL2SkipDocId);
-    _l1.nextDocId();
+    nextL1SkipDocId();
 #if DEBUG_ZCPOSTING_PRINTF
     printf("L2Seek, docId %d docIdPos %d L1SkipPos %d, nextDocId %d\n",
            lastL2SkipDocId,
@@ -504,7 +540,7 @@ ZcPostingIteratorBase::doL1SkipSeek(uint32_t docId)
     do {
         lastL1SkipDocId = _l1._skipDocId;
         _l1.decodeSkipEntry(_decode_normal_features);
-        _l1.nextDocId();
+        nextL1SkipDocId();
 #if DEBUG_ZCPOSTING_PRINTF
         printf("L1Decode docId %d, docIdPos %d, L1SkipPos %d, nextDocId %d\n",
                lastL1SkipDocId,
@@ -613,6 +649,127 @@ void ZcPostingIterator<bigEndian>::rewind(Position start)
     _chunkNo = 0;
 }
 
+template <bool bigEndian>
+ZcBlockPostingIterator<bigEndian>::
+ZcBlockPostingIterator(uint32_t minChunkDocs,
+                       bool dynamicK,
+                       const index::PostingListCounts &counts,
+                       const search::fef::TermFieldMatchDataArray &matchData,
+                       Position start, uint32_t docIdLimit,
+                       bool decode_normal_features, bool decode_interleaved_features, bool decode_block_max,
+                       bool unpack_normal_features, bool unpack_interleaved_features)
+    : ZcPostingIterator<bigEndian>(minChunkDocs, dynamicK, counts, matchData, start, docIdLimit,
+                                   decode_normal_features, decode_interleaved_features, decode_block_max,
+                                   unpack_normal_features, unpack_interleaved_features),
+      _block(),
+      _next_block(nullptr),
+      _block_idx(0),
+      _block_prev_doc_id(0),
+      _block_residue(0),
+      _block_feature_pos(0)
+{ }
+
+template <bool bigEndian>
+void
+ZcBlockPostingIterator<bigEndian>::read_block_header(uint32_t prev_doc_id)
+{
+    uint32_t num_docs = std::min(_block_residue, Zc4PostingBlock::block_size);
+    _block_prev_doc_id = prev_doc_id;
+    _next_block = _block.read_header(_next_block, num_docs, prev_doc_id, _decode_block_max, _decode_normal_features);
+    _block_residue -= num_docs;
+}
+
+template <bool bigEndian>
+void
+ZcBlockPostingIterator<bigEndian>::decode_block()
+{
+    _block.decode_payload(_block_prev_doc_id, _decode_interleaved_features);
+    set_block_doc(0);
+}
+
+template <bool bigEndian>
+void
+ZcBlockPostingIterator<bigEndian>::readWordStart(uint32_t docIdLimit)
+{
+    uint32_t prevDocId = _hasMore ? _chunk._lastDocId : 0u;
+    Zc4PostingHeader header;
+    const uint8_t *bcompr = this->read_word_header(docIdLimit, header);
+    assert(header._l1_skip_size == 0);
+    _valIBase = _valI = _next_block = bcompr;
+    bcompr += header._doc_ids_size;
+    DecodeContextBase &d = *_decodeContext;
+    d.setByteCompr(bcompr);
+    _hasMore = header._has_more;
+    // Save information about start of next chunk
+    _featuresValI = d.getCompr();
+    _featuresBitOffset = d.getBitOffset();
+    _featureSeekPos = 0;
+    _block_residue = header._num_docs;
+    _block_feature_pos = 0;
+    read_block_header(prevDocId);
+    decode_block();
+    clearUnpacked();
+}
+
+template <bool bigEndian>
+bool
+ZcBlockPostingIterator<bigEndian>::doBlockSeek(uint32_t docId)
+{
+    if (__builtin_expect(docId > _chunk._lastDocId, false)) {
+        doChunkSkipSeek(docId);
+        if (docId > _chunk._lastDocId) {
+            return false;
+        }
+        if (docId <= _block.get_last_doc_id()) {
+            return true;
+        }
+    }
+    // Skip blocks using only block headers
+    uint64_t feature_pos = _block_feature_pos;
+    do {
+        feature_pos += _block.get_features_size();
+        read_block_header(_block.get_last_doc_id());
+    } while (docId > _block.get_last_doc_id());
+    _block_feature_pos = feature_pos;
+    decode_block();
+    _featureSeekPos = feature_pos;
+    clearUnpacked();
+    return true;
+}
+
+template <bool bigEndian>
+void
+ZcBlockPostingIterator<bigEndian>::doSeek(uint32_t docId)
+{
+    if (docId > _block.get_last_doc_id()) {
+        if (!doBlockSeek(docId)) {
+            return;
+        }
+    }
+    const uint32_t *doc_ids = _block.get_doc_ids();
+    uint32_t block_idx = _block_idx;
+    while (__builtin_expect(doc_ids[block_idx] < docId, true)) {
+        ++block_idx;
+        incNeedUnpack();
+    }
+    if (block_idx != _block_idx) {
+        set_block_doc(block_idx);
+    }
+}
+
+template <bool bigEndian>
+bool
+ZcBlockPostingIterator<bigEndian>::get_block_max_features(queryeval::BlockMaxFeatures &features) const
+{
+    if (!_decode_block_max || this->isAtEnd()) {
+        return false;
+    }
+    features.last_doc_id = _block.get_last_doc_id();
+    features.max_num_occs = _block.get_max_num_occs();
+    features.min_field_length = _block.get_min_field_length();
+    return true;
+}
+
 template class ZcRareWordPostingIterator<false, false>;
 template class ZcRareWordPostingIterator<false, true>;
 template class ZcRareWordPostingIterator<true, false>;
@@ -621,4 +778,7 @@ template class ZcRareWordPostingIterator<true, true>;
 template class ZcPostingIterator<true>;
 template class ZcPostingIterator<false>;
 
+template class ZcBlockPostingIterator<true>;
+template class ZcBlockPostingIterator<false>;
+
 }
@@ -2,13 +2,16 @@
 
 #pragma once
 
+#include "zc4_posting_block.h"
 #include <vespa/searchlib/index/postinglistfile.h>
 #include <vespa/searchlib/bitcompression/compression.h>
+#include <vespa/searchlib/queryeval/block_max_features.h>
 #include <vespa/searchlib/queryeval/iterators.h>
 
 namespace search::diskindex {
 
 using bitcompression::Position;
+struct Zc4PostingHeader;
 
 #define ZCDECODE(valI, resop)                                \
 do {                                                         \
@@ -134,7 +137,8 @@ public:
     void readWordStart(uint32_t docIdLimit) override;
 };
 
-class ZcPostingIteratorBase : public ZcIteratorBase
+class ZcPostingIteratorBase : public ZcIteratorBase,
+                              public queryeval::IBlockMaxFeatures
 {
 protected:
     const uint8_t *_valI;     // docid deltas
@@ -278,10 +282,24 @@ protected:
     bool     _decode_interleaved_features;
     bool     _unpack_normal_features;
     bool     _unpack_interleaved_features;
+    bool     _decode_block_max;
     uint32_t _chunkNo;
     uint32_t _field_length;
     uint32_t _num_occs;
-
+    // Block max info for current L1 skip block, ending at _l1._skipDocId
+    uint32_t _block_max_num_occs;
+    uint32_t _block_min_field_length;
+
+    void decodeBlockMax() {
+        if (_decode_block_max && _l1._valI != nullptr) {
+            ZCDECODE(_l1._valI, _block_max_num_occs = 1 +);
+            ZCDECODE(_l1._valI, _block_min_field_length = 1 +);
+        }
+    }
+    void nextL1SkipDocId() {
+        _l1.nextDocId();
+        decodeBlockMax();
+    }
     void nextDocId(uint32_t prevDocId) {
         uint32_t docId = prevDocId + 1;
         ZCDECODE(_valI, docId +=);
@@ -300,8 +318,9 @@ protected:
     void doSeek(uint32_t docId) override;
 public:
     ZcPostingIteratorBase(const fef::TermFieldMatchDataArray &matchData, Position start, uint32_t docIdLimit,
-                          bool decode_normal_features, bool decode_interleaved_features,
+                          bool decode_normal_features, bool decode_interleaved_features, bool decode_block_max,
                           bool unpack_normal_features, bool unpack_interleaved_features);
+    bool get_block_max_features(queryeval::BlockMaxFeatures &features) const override;
 };
 
 template <bool bigEndian>
@@ -329,9 +348,11 @@ public:
 
     ZcPostingIterator(uint32_t minChunkDocs, bool dynamicK, const PostingListCounts &counts,
                       const search::fef::TermFieldMatchDataArray &matchData, Position start, uint32_t docIdLimit,
-                      bool decode_normal_features, bool decode_interleaved_features,
+                      bool decode_normal_features, bool decode_interleaved_features, bool decode_block_max,
                       bool unpack_normal_features, bool unpack_interleaved_features);
 
+    // Decode word or chunk header, returning start of doc ids
+    const uint8_t *read_word_header(uint32_t docIdLimit, Zc4PostingHeader &header);
 
     void doUnpack(uint32_t docId) override;
     void readWordStart(uint32_t docIdLimit) override;
@@ -343,6 +364,65 @@ public:
     }
 };
 
+/*
+ * Iterator for posting lists where doc ids and interleaved features are
+ * stored in blocks (cf. Zc4PostingBlock) instead of zc encoded deltas
+ * with L1-L4 skip info. Seeks step through the block headers and then
+ * decode the whole block containing the wanted document at once.
+ */
+template <bool bigEndian>
+class ZcBlockPostingIterator : public ZcPostingIterator<bigEndian>
+{
+protected:
+    using ParentClass = ZcPostingIterator<bigEndian>;
+    using ParentClass::setDocId;
+    using ParentClass::clearUnpacked;
+    using ParentClass::incNeedUnpack;
+    using ParentClass::doChunkSkipSeek;
+    using ParentClass::_valI;
+    using ParentClass::_valIBase;
+    using ParentClass::_featureSeekPos;
+    using ParentClass::_chunk;
+    using ParentClass::_hasMore;
+    using ParentClass::_decode_normal_features;
+    using ParentClass::_decode_interleaved_features;
+    using ParentClass::_decode_block_max;
+    using ParentClass::_field_length;
+    using ParentClass::_num_occs;
+    using ParentClass::_decodeContext;
+    using ParentClass::_featuresValI;
+    using ParentClass::_featuresBitOffset;
+    using DecodeContextBase = typename ParentClass::DecodeContextBase;
+
+private:
+    Zc4PostingBlock _block;
+    const uint8_t  *_next_block;        // Header of next block in chunk
+    uint32_t        _block_idx;         // Index of current document in block
+    uint32_t        _block_prev_doc_id; // Last document before current block
+    uint32_t        _block_residue;     // Documents in chunk after current block
+    uint64_t        _block_feature_pos; // Start of features for current block, relative to chunk
+
+    void read_block_header(uint32_t prev_doc_id);
+    void decode_block();
+    void set_block_doc(uint32_t block_idx) {
+        _block_idx = block_idx;
+        setDocId(_block.get_doc_ids()[block_idx]);
+        if (_decode_interleaved_features) {
+            _field_length = _block.get_field_lengths()[block_idx];
+            _num_occs = _block.get_num_occs()[block_idx];
+        }
+    }
+    VESPA_DLL_LOCAL bool doBlockSeek(uint32_t docId);
+public:
+    ZcBlockPostingIterator(uint32_t minChunkDocs, bool dynamicK, const index::PostingListCounts &counts,
+                           const search::fef::TermFieldMatchDataArray &matchData, Position start, uint32_t docIdLimit,
+                           bool decode_normal_features, bool decode_interleaved_features, bool decode_block_max,
+                           bool unpack_normal_features, bool unpack_interleaved_features);
+
+    void doSeek(uint32_t docId) override;
+    void readWordStart(uint32_t docIdLimit) override;
+    bool get_block_max_features(queryeval::BlockMaxFeatures &features) const override;
+};
 
 extern template class ZcRareWordPostingIterator<false, false>;
 extern template class ZcRareWordPostingIterator<false, true>;
@@ -352,4 +432,7 @@ extern template class ZcRareWordPostingIterator<true, true>;
 extern template class ZcPostingIterator<true>;
 extern template class ZcPostingIterator<false>;
 
+extern template class ZcBlockPostingIterator<true>;
+extern template class ZcBlockPostingIterator<false>;
+
 }
@@ -3,6 +3,7 @@
 #include "chunkformats.h"
 #include <vespa/vespalib/util/compressor.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 
 namespace search {
 
@@ -12,6 +13,7 @@ using vespalib::compression::compress;
 using vespalib::compression::decompress;
 using vespalib::compression::computeMaxCompressedsize;
 using vespalib::compression::CompressionConfig;
+using vespalib::compression::ZStdCompressor;
 
 ChunkException::ChunkException(const vespalib::string & msg, vespalib::stringref location) :
     Exception(make_string("Illegal chunk: %s", msg.c_str()), location)
@@ -19,7 +21,8 @@ ChunkException::ChunkException(const vespalib::string & msg, vespalib::stringref
 }
 
 void
-ChunkFormat::pack(uint64_t lastSerial, vespalib::DataBuffer & compressed, const CompressionConfig & compression)
+ChunkFormat::pack(uint64_t lastSerial, vespalib::DataBuffer & compressed, const CompressionConfig & compression,
+                  const ZStdDictionary * dictionary)
 {
     vespalib::nbostream & os = _dataBuf;
     os << lastSerial;
@@ -33,7 +36,14 @@ ChunkFormat::pack(uint64_t lastSerial, vespalib::DataBuffer & compressed, const
     const size_t oldPos(compressed.getDataLen());
     compressed.writeInt8(compression.type);
     compressed.writeInt32(os.size());
-    CompressionConfig::Type type(compress(compression, vespalib::ConstBufferRef(os.data(), os.size()), compressed, false));
+    vespalib::ConstBufferRef uncompressed(os.data(), os.size());
+    CompressionConfig::Type type;
+    if ((dictionary != nullptr) && (compression.type == CompressionConfig::ZSTD)) {
+        ZStdCompressor zstd(*dictionary);
+        type = compress(zstd, compression, uncompressed, compressed, false);
+    } else {
+        type = compress(compression, uncompressed, compressed, false);
+    }
     if (compression.type != type) {
         compressed.getData()[oldPos] = type;
     }
@@ -67,7 +77,7 @@ ChunkFormat::verifyCompression(uint8_t type)
 }
 
 ChunkFormat::UP
-ChunkFormat::deserialize(const void * buffer, size_t len, bool skipcrc)
+ChunkFormat::deserialize(const void * buffer, size_t len, bool skipcrc, const ZStdDictionary * dictionary)
 {
     uint8_t version(0);
     vespalib::nbostream raw(buffer, len);
@@ -83,15 +93,15 @@ ChunkFormat::deserialize(const void * buffer, size_t len, bool skipcrc)
     raw.rp(currPos);
     if (version == ChunkFormatV1::VERSION) {
         if (skipcrc) {
-            return std::make_unique<ChunkFormatV1>(raw);
+            return std::make_unique<ChunkFormatV1>(raw, dictionary);
         } else {
-            return std::make_unique<ChunkFormatV1>(raw, crc32);
+            return std::make_unique<ChunkFormatV1>(raw, crc32, dictionary);
         }
     } else if (version == ChunkFormatV2::VERSION) {
         if (skipcrc) {
-            return std::make_unique<ChunkFormatV2>(raw);
+            return std::make_unique<ChunkFormatV2>(raw, dictionary);
         } else {
-            return std::make_unique<ChunkFormatV2>(raw, crc32);
+            return std::make_unique<ChunkFormatV2>(raw, crc32, dictionary);
         }
     } else {
         throw ChunkException(make_string("Unknown version %d", version), VESPA_STRLOC);
@@ -117,7 +127,7 @@ ChunkFormat::verifyCrc(const vespalib::nbostream & is, uint32_t expectedCrc) con
 }
 
 void
-ChunkFormat::deserializeBody(vespalib::nbostream & is)
+ChunkFormat::deserializeBody(vespalib::nbostream & is, const ZStdDictionary * dictionary)
 {
     if (includeSerializedSize()) {
         uint32_t serializedSize(0);
@@ -136,7 +146,19 @@ ChunkFormat::deserializeBody(vespalib::nbostream & is)
     // This is a dirty trick to fool some odd sanity checking in DataBuffer::swap
     vespalib::DataBuffer uncompressed(const_cast<char *>(is.peek()), (size_t)0);
     vespalib::ConstBufferRef data(is.peek(), is.size() - sizeof(uint32_t));
-    decompress(CompressionConfig::Type(type), uncompressedLen, data, uncompressed, true);
+    uint32_t dictionaryId = (type == CompressionConfig::ZSTD)
+                            ? ZStdDictionary::getFrameDictionaryId(data.c_str(), data.size())
+                            : 0;
+    if (dictionaryId != 0) {
+        if ((dictionary == nullptr) || (dictionary->getId() != dictionaryId)) {
+            throw ChunkException(make_string("Compressed with zstd dictionary %u, which is not available", dictionaryId),
+                                 VESPA_STRLOC);
+        }
+        ZStdCompressor zstd(*dictionary);
+        decompress(zstd, uncompressedLen, data, uncompressed, true);
+    } else {
+        decompress(CompressionConfig::Type(type), uncompressedLen, data, uncompressed, true);
+    }
     assert(uncompressed.getData() == uncompressed.getDead());
     if (uncompressed.getData() != data.c_str()) {
         const size_t sz(uncompressed.getDataLen());
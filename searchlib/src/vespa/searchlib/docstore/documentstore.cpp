@@ -110,6 +110,45 @@ public:
     Cache(BackingStore & b, size_t maxBytes) : vespalib::cache<CacheParams>(b, maxBytes) { }
 };
 
+/**
+ * Adds documents read from the backing store to the cache, as a cache miss in read() would.
+ * The documents are kept for the caller to visit after the read guard is released.
+ */
+class CachePopulatingVisitorAdapter : public IBufferVisitor
+{
+public:
+    using Documents = std::vector<std::pair<uint32_t, std::unique_ptr<document::Document>>>;
+    CachePopulatingVisitorAdapter(Cache & cache, const Cache::ReadGuard & guard,
+                                  const CompressionConfig & compression, const DocumentTypeRepo & repo)
+        : _cache(cache),
+          _guard(guard),
+          _compression(compression),
+          _repo(repo),
+          _documents()
+    { }
+    void visit(uint32_t lid, vespalib::ConstBufferRef buf) override;
+    Documents stealDocuments() { return std::move(_documents); }
+private:
+    Cache                   & _cache;
+    const Cache::ReadGuard  & _guard;
+    const CompressionConfig & _compression;
+    const DocumentTypeRepo  & _repo;
+    Documents                 _documents;
+};
+
+void
+CachePopulatingVisitorAdapter::visit(uint32_t lid, vespalib::ConstBufferRef buf) {
+    if (buf.size() > 0) {
+        vespalib::DataBuffer copy(buf.size());
+        copy.writeBytes(buf.c_str(), buf.size());
+        Value value;
+        value.set(std::move(copy), buf.size(), _compression);
+        _cache.populate(_guard, lid, std::move(value));
+        vespalib::nbostream is(buf.c_str(), buf.size());
+        _documents.emplace_back(lid, std::make_unique<document::Document>(_repo, is));
+    }
+}
+
 }
 
 using docstore::Value;
@@ -166,6 +205,42 @@ DocumentStore::visit(const LidVector & lids, const DocumentTypeRepo &repo, IDocu
     }
 }
 
+void
+DocumentStore::readBatch(const LidVector & lids, const DocumentTypeRepo &repo, IDocumentVisitor & visitor) const
+{
+    if ( ! useCache()) {
+        _uncached_lookups.fetch_add(lids.size());
+        _store->visit(lids, repo, visitor);
+        return;
+    }
+    LidVector uncached;
+    for (DocumentIdT lid : lids) {
+        if (_cache->hasKey(lid)) {
+            DocumentUP doc = read(lid, repo);
+            if (doc) {
+                visitor.visit(lid, std::move(doc));
+            }
+        } else {
+            uncached.push_back(lid);
+        }
+    }
+    if ( ! uncached.empty()) {
+        // Read in one batch directly from the backing store, populating the cache.
+        // The cache locks for the lids are held while reading, as on a cache miss in read().
+        _uncached_lookups.fetch_add(uncached.size());
+        docstore::CachePopulatingVisitorAdapter::Documents documents;
+        {
+            docstore::Cache::ReadGuard guard = _cache->getReadGuard(uncached);
+            docstore::CachePopulatingVisitorAdapter adapter(*_cache, guard, _store->getCompression(), repo);
+            _backingStore.read(uncached, adapter);
+            documents = adapter.stealDocuments();
+        }
+        for (auto & entry : documents) {
+            visitor.visit(entry.first, std::move(entry.second));
+        }
+    }
+}
+
 std::unique_ptr<document::Document>
 DocumentStore::read(DocumentIdT lid, const DocumentTypeRepo &repo) const
 {
@@ -8,6 +8,7 @@
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/data/fileheader.h>
+#include <vespa/vespalib/encoding/base64.h>
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/objects/nbostream.h>
@@ -30,8 +31,11 @@ namespace search {
 namespace {
 
 constexpr size_t ALIGNMENT=0x1000;
+// Enough to keep the io_uring queue full with chunks of the default size.
+constexpr size_t MAX_BATCH_READ_BYTES=4_Mi;
 constexpr size_t ENTRY_BIAS_SIZE=8;
 const vespalib::string DOC_ID_LIMIT_KEY("docIdLimit");
+const vespalib::string DICTIONARY_KEY("compression.zstd.dictionary");
 
 }
 
@@ -86,6 +90,7 @@ FileChunk::FileChunk(FileId fileId, NameId nameId, const vespalib::string & base
       _idxHeaderLen(0u),
       _numLids(0),
       _docIdLimit(std::numeric_limits<uint32_t>::max()),
+      _dictionary(),
       _modificationTime()
 {
     FastOS_File dataFile(_dataFileName.c_str());
@@ -270,6 +275,9 @@ FileChunk::enableRead()
             LOG(debug, "enableRead(): MMapRandReadDynamic: file='%s'", _dataFileName.c_str());
             _file = std::make_unique<MMapRandReadDynamic>(_dataFileName, mmapFlags, fadviseOptions);
         }
+    } else if (_tune._randRead.getWantIoUring()) {
+        LOG(debug, "enableRead(): IoUringRandRead: file='%s'", _dataFileName.c_str());
+        _file = std::make_unique<IoUringRandRead>(_dataFileName);
     } else {
         LOG(debug, "enableRead(): NormalRandRead: file='%s'", _dataFileName.c_str());
         _file = std::make_unique<NormalRandRead>(_dataFileName);
@@ -278,6 +286,14 @@ FileChunk::enableRead()
     if (_dataHeaderLen == 0u) {
         throw std::runtime_error(make_string("bad file header: %s", _dataFileName.c_str()));
     }
+    if ( ! _dictionary) {
+        vespalib::DataBuffer h(_dataHeaderLen, ALIGNMENT);
+        FileRandRead::FSP keepAlive(_file->read(0, h, _dataHeaderLen));
+        GenericHeader::BufferReader rd(h);
+        GenericHeader header;
+        header.read(rd);
+        _dictionary = readDictionary(header);
+    }
 }
 
 size_t FileChunk::adjustSize(size_t sz) {
@@ -353,7 +369,7 @@ FileChunk::appendTo(vespalib::Executor & executor, const IGetLid & db, IWriteDat
             const ChunkInfo & cInfo(_chunkInfo[chunkId]);
             vespalib::DataBuffer whole(0ul, ALIGNMENT);
             FileRandRead::FSP keepAlive(_file->read(cInfo.getOffset(), whole, cInfo.getSize()));
-            promise.set_value(std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen()));
+            promise.set_value(std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen(), false, _dictionary.get()));
         });
         executor.execute(CpuUsage::wrap(std::move(task), cpu_category));
 
@@ -375,19 +391,61 @@ void
 FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor) const
 {
     if (count == 0) { return; }
+    std::vector<LidsInChunk> chunks;
     uint32_t prevChunk = begin->getChunkId();
     uint32_t start(0);
     for (size_t i(0); i < count; i++) {
         const LidInfoWithLid & li = *(begin + i);
         if (li.getChunkId() != prevChunk) {
-            ChunkInfo ci = _chunkInfo[prevChunk];
-            read(begin + start, i - start, ci, visitor);
+            chunks.push_back({_chunkInfo[prevChunk], begin + start, i - start});
             prevChunk = li.getChunkId();
             start = i;
         }
     }
-    ChunkInfo ci = _chunkInfo[prevChunk];
-    read(begin + start, count - start, ci, visitor);
+    chunks.push_back({_chunkInfo[prevChunk], begin + start, count - start});
+    read(chunks, visitor);
+}
+
+void
+FileChunk::read(const std::vector<LidsInChunk> & chunks, IBufferVisitor & visitor) const
+{
+    if ( ! _tune._randRead.getWantIoUring()) {
+        for (const LidsInChunk & lids : chunks) {
+            read(lids.begin, lids.count, lids.chunkInfo, visitor);
+        }
+        return;
+    }
+    // Bound the memory buffered for a batch, as there is no limit on the number of lids.
+    size_t first(0);
+    while (first < chunks.size()) {
+        size_t bytes(chunks[first].chunkInfo.getSize());
+        size_t last(first + 1);
+        while ((last < chunks.size()) && (bytes + chunks[last].chunkInfo.getSize() <= MAX_BATCH_READ_BYTES)) {
+            bytes += chunks[last].chunkInfo.getSize();
+            last++;
+        }
+        readBatch(vespalib::ConstArrayRef<LidsInChunk>(&chunks[first], last - first), visitor);
+        first = last;
+    }
+}
+
+void
+FileChunk::readBatch(vespalib::ConstArrayRef<LidsInChunk> chunks, IBufferVisitor & visitor) const
+{
+    std::vector<vespalib::DataBuffer> wholes;
+    std::vector<FileRandRead::ReadRequest> requests;
+    wholes.reserve(chunks.size());
+    requests.reserve(chunks.size());
+    for (const LidsInChunk & lids : chunks) {
+        wholes.emplace_back(0ul, ALIGNMENT);
+        requests.emplace_back(lids.chunkInfo.getOffset(), lids.chunkInfo.getSize(), wholes.back());
+    }
+    _file->readBatch(requests);
+    for (size_t c(0); c < chunks.size(); c++) {
+        const LidsInChunk & lids = chunks[c];
+        Chunk chunk(lids.begin->getChunkId(), wholes[c].getData(), wholes[c].getDataLen(), _skipCrcOnRead, _dictionary.get());
+        visit(chunk, lids.begin, lids.count, visitor);
+    }
 }
 
 void
@@ -395,7 +453,13 @@ FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo c
 {
     vespalib::DataBuffer whole(0ul, ALIGNMENT);
     FileRandRead::FSP keepAlive = _file->read(ci.getOffset(), whole, ci.getSize());
-    Chunk chunk(begin->getChunkId(), whole.getData(), whole.getDataLen(), _skipCrcOnRead);
+    Chunk chunk(begin->getChunkId(), whole.getData(), whole.getDataLen(), _skipCrcOnRead, _dictionary.get());
+    visit(chunk, begin, count, visitor);
+}
+
+void
+FileChunk::visit(const Chunk & chunk, LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor)
+{
     for (size_t i(0); i < count; i++) {
         const LidInfoWithLid & li = *(begin + i);
         vespalib::ConstBufferRef buf = chunk.getLid(li.getLid());
@@ -420,7 +484,7 @@ FileChunk::read(uint32_t lid, SubChunkId chunkId, const ChunkInfo & chunkInfo,
 {
     vespalib::DataBuffer whole(0ul, ALIGNMENT);
     FileRandRead::FSP keepAlive(_file->read(chunkInfo.getOffset(), whole, chunkInfo.getSize()));
-    Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead);
+    Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead, _dictionary.get());
     return chunk.read(lid, buffer);
 }
 
@@ -482,6 +546,23 @@ FileChunk::writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit)
     header.putTag(vespalib::GenericHeader::Tag(DOC_ID_LIMIT_KEY, docIdLimit));
 }
 
+FileChunk::ZStdDictionarySP
+FileChunk::readDictionary(const vespalib::GenericHeader &header)
+{
+    if (header.hasTag(DICTIONARY_KEY)) {
+        std::string content = vespalib::Base64::decode(header.getTag(DICTIONARY_KEY).asString());
+        return std::make_shared<ZStdDictionary>(vespalib::ConstBufferRef(content.data(), content.size()));
+    }
+    return ZStdDictionarySP();
+}
+
+void
+FileChunk::writeDictionary(vespalib::GenericHeader &header, const ZStdDictionary &dictionary)
+{
+    vespalib::ConstBufferRef content = dictionary.getContent();
+    header.putTag(vespalib::GenericHeader::Tag(DICTIONARY_KEY, vespalib::Base64::encode(content.c_str(), content.size())));
+}
+
 void
 FileChunk::verify(bool reportOnly) const
 {
@@ -496,7 +577,7 @@ FileChunk::verify(bool reportOnly) const
         vespalib::DataBuffer whole(0ul, ALIGNMENT);
         FileRandRead::FSP keepAlive(_file->read(ci.getOffset(), whole, ci.getSize()));
         try {
-            Chunk chunk(chunkId++, whole.getData(), whole.getDataLen());
+            Chunk chunk(chunkId++, whole.getData(), whole.getDataLen(), false, _dictionary.get());
             assert(chunk.getLastSerial() >= lastSerial);
             lastSerial = chunk.getLastSerial();
             if (errorInPrev) {
@@ -14,6 +14,7 @@
 #include <vespa/vespalib/util/memoryusage.h>
 #include <vespa/vespalib/util/ptrholder.h>
 #include <vespa/vespalib/util/time.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 
 class FastOS_FileInterface;
 
@@ -107,6 +108,8 @@ public:
     typedef vespalib::hash_map<uint32_t, std::unique_ptr<vespalib::DataBuffer>> LidBufferMap;
     typedef std::unique_ptr<FileChunk> UP;
     typedef uint32_t SubChunkId;
+    using ZStdDictionary = vespalib::compression::ZStdDictionary;
+    using ZStdDictionarySP = ZStdDictionary::SP;
     FileChunk(FileId fileId, NameId nameId, const vespalib::string &baseName, const TuneFileSummary &tune,
               const IBucketizer *bucketizer, bool skipCrcOnRead);
     virtual ~FileChunk();
@@ -185,6 +188,12 @@ public:
      */
     void verify(bool reportOnly) const;
 
+    /**
+     * The zstd dictionary stored in the '.dat' file header, if any.
+     * Available after enableRead() has been called.
+     */
+    const ZStdDictionarySP & getDictionary() const { return _dictionary; }
+
     uint32_t      getNumChunks() const;
     size_t       getNumBuckets() const { return _sumNumBuckets; }
     size_t getNumUniqueBuckets() const { return _numUniqueBuckets; }
@@ -237,9 +246,20 @@ protected:
 
     void setNumUniqueBuckets(size_t numUniqueBuckets) { _numUniqueBuckets = numUniqueBuckets; }
     ssize_t read(uint32_t lid, SubChunkId chunkId, const ChunkInfo & chunkInfo, vespalib::DataBuffer & buffer) const;
+    struct LidsInChunk {
+        ChunkInfo                       chunkInfo;
+        LidInfoWithLidV::const_iterator begin;
+        size_t                          count;
+    };
+    // Reads the chunks in bounded batches when using io_uring, otherwise one at a time, and visits their lids.
+    void read(const std::vector<LidsInChunk> & chunks, IBufferVisitor & visitor) const;
+    void readBatch(vespalib::ConstArrayRef<LidsInChunk> chunks, IBufferVisitor & visitor) const;
     void read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo ci, IBufferVisitor & visitor) const;
+    static void visit(const Chunk & chunk, LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor);
     static uint32_t readDocIdLimit(vespalib::GenericHeader &header);
     static void writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit);
+    static ZStdDictionarySP readDictionary(const vespalib::GenericHeader &header);
+    static void writeDictionary(vespalib::GenericHeader &header, const ZStdDictionary &dictionary);
 
     typedef vespalib::Array<ChunkInfo> ChunkInfoVector;
     const IBucketizer   * _bucketizer;
@@ -253,6 +273,7 @@ protected:
     uint32_t              _idxHeaderLen;
     uint32_t              _numLids;
     uint32_t              _docIdLimit; // Limit when the file was created. Stored in idx file header.
+    ZStdDictionarySP      _dictionary; // Used for compressing chunks. Stored in dat file header.
     vespalib::system_time  _modificationTime;
 };
 
@@ -8,9 +8,11 @@
 #include <vespa/vespalib/util/memoryusage.h>
 #include <vespa/vespalib/util/time.h>
 #include <atomic>
+#include <memory>
 #include <vector>
 
 namespace vespalib { class DataBuffer; }
+namespace vespalib::compression { class ZStdDictionary; }
 namespace search {
 
 class IBufferVisitor;
@@ -58,6 +60,15 @@ public:
      **/
     virtual ssize_t read(uint32_t lid, vespalib::DataBuffer & buffer) const = 0;
     virtual void read(const LidVector & lids, IBufferVisitor & visitor) const = 0;
+    /**
+     * Tell if reading multiple lids at once overlaps the reads, making it
+     * cheaper than reading them one at a time.
+     **/
+    virtual bool readsInBatches() const { return false; }
+    /**
+     * The zstd dictionary new data is compressed with, if any.
+     **/
+    virtual std::shared_ptr<const vespalib::compression::ZStdDictionary> getDictionary() const { return {}; }
 
     /**
      * Write data to the data store.
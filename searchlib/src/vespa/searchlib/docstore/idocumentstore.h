@@ -77,6 +77,18 @@ public:
     virtual DocumentUP read(DocumentIdT lid, const document::DocumentTypeRepo &repo) const = 0;
     virtual void visit(const LidVector & lidVector, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const;
 
+    /**
+     * Read the documents for multiple lids and give them to the visitor,
+     * in no particular order. Lids without a document are not visited.
+     * Unlike visit() this uses the document cache, and the store may
+     * overlap the reads for lids that are not cached.
+     **/
+    virtual void readBatch(const LidVector & lids, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const;
+    /**
+     * Tell if readBatch() overlaps the reads for lids that are not cached.
+     **/
+    virtual bool readsInBatches() const { return false; }
+
     /**
      * Serialize and store a document.
      * @param doc The document to store
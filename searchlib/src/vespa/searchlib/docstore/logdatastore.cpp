@@ -9,6 +9,8 @@
 #include <vespa/vespalib/util/benchmark_timer.h>
 #include <vespa/vespalib/util/cpu_usage.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/retain_guard.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <thread>
 
@@ -77,7 +79,10 @@ LogDataStore::LogDataStore(vespalib::Executor &executor, const vespalib::string
       _tlSyncer(tlSyncer),
       _bucketizer(std::move(bucketizer)),
       _currentlyCompacting(),
-      _compactLidSpaceGeneration()
+      _compactLidSpaceGeneration(),
+      _dictionary(),
+      _trainedDictionary(),
+      _pendingDictionaryTraining()
 {
     // Reserve space for 1TB summary in order to avoid locking.
     _fileChunks.reserve(LidInfo::getFileIdLimit());
@@ -106,6 +111,7 @@ LogDataStore::updateSerialNum()
 
 LogDataStore::~LogDataStore()
 {
+    _pendingDictionaryTraining.waitForZeroRefCount();
     // Must be called before ending threads as there are sanity checks.
     _fileChunks.clear();
     _genHandler.updateFirstUsedGeneration();
@@ -210,7 +216,16 @@ LogDataStore::requireSpace(MonitorGuard guard, WriteableFileChunk & active, CpuU
     size_t oldSz(active.getDiskFootprint());
     LOG(spam, "Checking file %s size %ld < %ld AND #lids %u < %u",
               active.getName().c_str(), oldSz, _config.getMaxFileSize(), active.getNumLids(), _config.getMaxNumLids());
-    if ((oldSz > _config.getMaxFileSize()) || (active.getNumLids() >= _config.getMaxNumLids())) {
+    if (active.hasDictionarySamples()) {
+        trainDictionary(guard, active.takeDictionarySamples(), cpu_category);
+    }
+    bool newDictionary(false);
+    if (_trainedDictionary) {
+        // Close the file early, so the rest of the documents are compressed with the new dictionary.
+        _dictionary = std::move(_trainedDictionary);
+        newDictionary = true;
+    }
+    if (newDictionary || (oldSz > _config.getMaxFileSize()) || (active.getNumLids() >= _config.getMaxNumLids())) {
         FileId fileId = allocateFileId(guard);
         setNewFileChunk(guard, createWritableFile(fileId, active.getSerialNum()));
         setActive(guard, fileId);
@@ -232,6 +247,28 @@ LogDataStore::requireSpace(MonitorGuard guard, WriteableFileChunk & active, CpuU
     }
 }
 
+void
+LogDataStore::trainDictionary(const MonitorGuard &, WriteableFileChunk::DictionarySamples samples,
+                              CpuUsage::Category cpu_category)
+{
+    auto task = vespalib::makeLambdaTask([this, samples = std::move(samples),
+                                          retainGuard = vespalib::RetainGuard(_pendingDictionaryTraining)]() {
+        FileChunk::ZStdDictionarySP dictionary = samples.train();
+        if (dictionary) {
+            MonitorGuard guard(_updateLock);
+            _trainedDictionary = std::move(dictionary);
+        }
+    });
+    _executor.execute(CpuUsage::wrap(std::move(task), cpu_category));
+}
+
+FileChunk::ZStdDictionarySP
+LogDataStore::getDictionary() const
+{
+    MonitorGuard guard(_updateLock);
+    return _dictionary;
+}
+
 uint64_t
 LogDataStore::lastSyncToken() const
 {
@@ -645,7 +682,7 @@ LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId name
     uint32_t docIdLimit = (getDocIdLimit() != 0) ? getDocIdLimit() : std::numeric_limits<uint32_t>::max();
     auto file = std::make_unique< WriteableFileChunk>(_executor, fileId, nameId, getBaseDir(), serialNum,docIdLimit,
                                                       _config.getFileConfig(), _tune, _fileHeaderContext,
-                                                      _bucketizer.get(), _config.crcOnReadDisabled());
+                                                      _bucketizer.get(), _config.crcOnReadDisabled(), _dictionary);
     file->enableRead();
     return file;
 }
@@ -777,10 +814,16 @@ LogDataStore::preload()
         typedef NameIdSet::const_iterator It;
         for (It it(partList.begin()), mt(--partList.end()); it != mt; it++) {
             _fileChunks.push_back(createReadOnlyFile(FileId(_fileChunks.size()), *it));
+            if (_fileChunks.back()->getDictionary()) {
+                _dictionary = _fileChunks.back()->getDictionary();
+            }
         }
         _fileChunks.push_back(isReadOnly()
             ? createReadOnlyFile(FileId(_fileChunks.size()), *partList.rbegin())
             : createWritableFile(FileId(_fileChunks.size()), getMinLastPersistedSerialNum(), *partList.rbegin()));
+        if (_fileChunks.back()->getDictionary()) {
+            _dictionary = _fileChunks.back()->getDictionary();
+        }
     } else {
         if ( ! isReadOnly() ) {
             _fileChunks.push_back(createWritableFile(FileId::first(), 0));
@@ -13,6 +13,7 @@
 #include <vespa/vespalib/util/compressionconfig.h>
 #include <vespa/vespalib/util/cpu_usage.h>
 #include <vespa/vespalib/util/executor.h>
+#include <vespa/vespalib/util/monitored_refcount.h>
 #include <vespa/vespalib/util/rcuvector.h>
 
 #include <set>
@@ -99,6 +100,8 @@ public:
     // Implements IDataStore API
     ssize_t read(uint32_t lid, vespalib::DataBuffer & buffer) const override;
     void read(const LidVector & lids, IBufferVisitor & visitor) const override;
+    bool readsInBatches() const override { return _tune._randRead.getWantIoUring(); }
+    FileChunk::ZStdDictionarySP getDictionary() const override;
     void write(uint64_t serialNum, uint32_t lid, const void * buffer, size_t len) override;
     void remove(uint64_t serialNum, uint32_t lid) override;
     void flush(uint64_t syncToken) override;
@@ -222,6 +225,12 @@ private:
     vespalib::string createIdxFileName(NameId id) const;
 
     void requireSpace(MonitorGuard guard, WriteableFileChunk & active, vespalib::CpuUsage::Category cpu_category);
+    /*
+     * Train a dictionary on the executor. When done it is picked up by
+     * requireSpace(), which rotates the active file to start using it.
+     */
+    void trainDictionary(const MonitorGuard & guard, WriteableFileChunk::DictionarySamples samples,
+                         vespalib::CpuUsage::Category cpu_category);
     bool isReadOnly() const { return _readOnly; }
     void updateSerialNum();
 
@@ -269,6 +278,9 @@ private:
     IBucketizer::SP                          _bucketizer;
     NameIdSet                                _currentlyCompacting;
     uint64_t                                 _compactLidSpaceGeneration;
+    FileChunk::ZStdDictionarySP              _dictionary;
+    FileChunk::ZStdDictionarySP              _trainedDictionary;
+    vespalib::MonitoredRefCount              _pendingDictionaryTraining;
 };
 
 } // namespace search
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <vespa/vespalib/util/arrayref.h>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -16,8 +17,34 @@ class FileRandRead
 {
 public:
     typedef std::shared_ptr<FastOS_FileInterface> FSP;
+
+    /**
+     * A single read in a batch of reads. The buffer is filled with sz
+     * bytes starting at offset, and keepAlive must be kept as long as
+     * the buffer is used.
+     **/
+    struct ReadRequest {
+        size_t                 offset;
+        size_t                 sz;
+        vespalib::DataBuffer * buffer;
+        FSP                    keepAlive;
+        ReadRequest(size_t offset_in, size_t sz_in, vespalib::DataBuffer & buffer_in) noexcept
+            : offset(offset_in), sz(sz_in), buffer(&buffer_in), keepAlive()
+        { }
+    };
+
     virtual ~FileRandRead() { }
     virtual FSP read(size_t offset, vespalib::DataBuffer & buffer, size_t sz) = 0;
+    /**
+     * Perform a batch of reads. The default implementation performs
+     * the reads one at a time, while implementations able to overlap
+     * multiple reads may submit all of them at once.
+     **/
+    virtual void readBatch(vespalib::ArrayRef<ReadRequest> requests) {
+        for (ReadRequest & request : requests) {
+            request.keepAlive = read(request.offset, *request.buffer, request.sz);
+        }
+    }
     virtual int64_t getSize() = 0;
 };
 
@@ -3,7 +3,22 @@
 #include "randreaders.h"
 #include "summaryexceptions.h"
 #include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/util/error.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/fastos/file.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define SEARCH_DOCSTORE_HAS_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
 
 #include <vespa/log/log.h>
 LOG_SETUP(".search.docstore.randreaders");
@@ -151,6 +166,311 @@ MMapRandReadDynamic::getSize() {
     return _holder.get()->GetSize();
 }
 
+/**
+ * A minimal io_uring instance used to perform batches of reads, talking
+ * directly to the kernel interface. Used by a single thread at a time.
+ **/
+class IoUringRandRead::Ring
+{
+public:
+    struct Read {
+        char   * buf;
+        size_t   sz;
+        size_t   offset;
+        int      result; // bytes read or -errno
+    };
+    static std::unique_ptr<Ring> create();
+    ~Ring();
+    // Submit all reads and wait for them to complete
+    void read(int fd, Read * reads, size_t count);
+private:
+#ifdef SEARCH_DOCSTORE_HAS_IO_URING
+    static constexpr unsigned NUM_ENTRIES = 64;
+
+    explicit Ring(int ringFd);
+    bool map(const io_uring_params & params);
+    unsigned submit(unsigned toSubmit);
+
+    int            _ringFd;
+    void         * _sqRing;
+    size_t         _sqRingSize;
+    void         * _cqRing;
+    size_t         _cqRingSize;
+    io_uring_sqe * _sqes;
+    size_t         _sqesSize;
+    unsigned       _sqEntries;
+    unsigned     * _sqTail;
+    unsigned       _sqMask;
+    unsigned     * _sqArray;
+    unsigned     * _cqHead;
+    unsigned     * _cqTail;
+    unsigned       _cqMask;
+    io_uring_cqe * _cqes;
+#endif
+};
+
+#ifdef SEARCH_DOCSTORE_HAS_IO_URING
+
+std::unique_ptr<IoUringRandRead::Ring>
+IoUringRandRead::Ring::create()
+{
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int ringFd = syscall(__NR_io_uring_setup, NUM_ENTRIES, &params);
+    if (ringFd < 0) {
+        LOG(debug, "io_uring_setup failed: %s", vespalib::getErrorString(errno).c_str());
+        return {};
+    }
+    std::unique_ptr<Ring> ring(new Ring(ringFd));
+    if ( ! ring->map(params)) {
+        LOG(debug, "Mapping io_uring failed: %s", vespalib::getErrorString(errno).c_str());
+        return {};
+    }
+    return ring;
+}
+
+IoUringRandRead::Ring::Ring(int ringFd)
+    : _ringFd(ringFd),
+      _sqRing(MAP_FAILED),
+      _sqRingSize(0),
+      _cqRing(MAP_FAILED),
+      _cqRingSize(0),
+      _sqes(static_cast<io_uring_sqe *>(MAP_FAILED)),
+      _sqesSize(0),
+      _sqEntries(0),
+      _sqTail(nullptr),
+      _sqMask(0),
+      _sqArray(nullptr),
+      _cqHead(nullptr),
+      _cqTail(nullptr),
+      _cqMask(0),
+      _cqes(nullptr)
+{
+}
+
+IoUringRandRead::Ring::~Ring()
+{
+    if (_sqes != MAP_FAILED) {
+        munmap(_sqes, _sqesSize);
+    }
+    if (_cqRing != MAP_FAILED) {
+        munmap(_cqRing, _cqRingSize);
+    }
+    if (_sqRing != MAP_FAILED) {
+        munmap(_sqRing, _sqRingSize);
+    }
+    close(_ringFd);
+}
+
+bool
+IoUringRandRead::Ring::map(const io_uring_params & params)
+{
+    _sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    _cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    _sqRing = mmap(nullptr, _sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ringFd, IORING_OFF_SQ_RING);
+    _cqRing = mmap(nullptr, _cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ringFd, IORING_OFF_CQ_RING);
+    _sqes = static_cast<io_uring_sqe *>(mmap(nullptr, _sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ringFd, IORING_OFF_SQES));
+    if ((_sqRing == MAP_FAILED) || (_cqRing == MAP_FAILED) || (_sqes == MAP_FAILED)) {
+        return false;
+    }
+    char * sq = static_cast<char *>(_sqRing);
+    char * cq = static_cast<char *>(_cqRing);
+    _sqEntries = params.sq_entries;
+    _sqTail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    _sqMask = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    _sqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    _cqHead = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    _cqTail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    _cqMask = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    _cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+    return true;
+}
+
+unsigned
+IoUringRandRead::Ring::submit(unsigned toSubmit)
+{
+    for (;;) {
+        int res = syscall(__NR_io_uring_enter, _ringFd, toSubmit, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+        if (res >= 0) {
+            return res;
+        }
+        if ((errno != EINTR) && (errno != EAGAIN) && (errno != EBUSY)) {
+            throw std::runtime_error(vespalib::make_string("io_uring_enter failed: %s", vespalib::getErrorString(errno).c_str()));
+        }
+    }
+}
+
+void
+IoUringRandRead::Ring::read(int fd, Read * reads, size_t count)
+{
+    // Each read has its own iovec, as it must stay valid until the read completes
+    std::vector<iovec> iovecs(count);
+    size_t queued = 0;
+    size_t completed = 0;
+    unsigned pending = 0; // queued, but not yet consumed by the kernel
+    while (completed < count) {
+        unsigned tail = *_sqTail;
+        while ((queued < count) && ((queued - completed) < _sqEntries)) {
+            Read & r = reads[queued];
+            unsigned idx = tail & _sqMask;
+            iovec & iov = iovecs[queued];
+            iov.iov_base = r.buf;
+            iov.iov_len = r.sz;
+            io_uring_sqe & sqe = _sqes[idx];
+            memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode = IORING_OP_READV;
+            sqe.fd = fd;
+            sqe.off = r.offset;
+            sqe.addr = reinterpret_cast<uint64_t>(&iov);
+            sqe.len = 1;
+            sqe.user_data = queued;
+            _sqArray[idx] = idx;
+            ++tail;
+            ++queued;
+            ++pending;
+        }
+        __atomic_store_n(_sqTail, tail, __ATOMIC_RELEASE);
+        pending -= submit(pending);
+        unsigned head = *_cqHead;
+        unsigned cqTail = __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE);
+        for (; head != cqTail; ++head, ++completed) {
+            const io_uring_cqe & cqe = _cqes[head & _cqMask];
+            reads[cqe.user_data].result = cqe.res;
+        }
+        __atomic_store_n(_cqHead, head, __ATOMIC_RELEASE);
+    }
+}
+
+#else
+
+std::unique_ptr<IoUringRandRead::Ring>
+IoUringRandRead::Ring::create()
+{
+    return {};
+}
+
+IoUringRandRead::Ring::~Ring() = default;
+
+void
+IoUringRandRead::Ring::read(int, Read *, size_t)
+{
+    abort();
+}
+
+#endif
+
+IoUringRandRead::IoUringRandRead(const vespalib::string & fileName)
+    : _fileName(fileName),
+      _fd(open(fileName.c_str(), O_RDONLY | O_CLOEXEC)),
+      _ringUnavailable(false),
+      _lock(),
+      _rings()
+{
+    if (_fd < 0) {
+        throw vespalib::IoException(vespalib::make_string("Failed opening data file '%s': %s",
+                                                          fileName.c_str(), vespalib::getErrorString(errno).c_str()),
+                                    vespalib::IoException::getErrorType(errno), VESPA_STRLOC);
+    }
+}
+
+IoUringRandRead::~IoUringRandRead()
+{
+    _rings.clear();
+    close(_fd);
+}
+
+std::unique_ptr<IoUringRandRead::Ring>
+IoUringRandRead::acquireRing()
+{
+    {
+        std::lock_guard guard(_lock);
+        if ( ! _rings.empty()) {
+            auto ring = std::move(_rings.back());
+            _rings.pop_back();
+            return ring;
+        }
+    }
+    auto ring = Ring::create();
+    if ( ! ring) {
+        LOG(info, "io_uring is not available, using pread for file '%s'", _fileName.c_str());
+        _ringUnavailable.store(true, std::memory_order_relaxed);
+    }
+    return ring;
+}
+
+void
+IoUringRandRead::releaseRing(std::unique_ptr<Ring> ring)
+{
+    constexpr size_t maxPooledRings = 16;
+    std::lock_guard guard(_lock);
+    if (_rings.size() < maxPooledRings) {
+        _rings.push_back(std::move(ring));
+    }
+}
+
+void
+IoUringRandRead::readRemaining(char * buf, size_t sz, size_t offset, size_t done)
+{
+    while (done < sz) {
+        ssize_t res = pread(_fd, buf + done, sz - done, offset + done);
+        if (res < 0 && errno == EINTR) {
+            continue;
+        }
+        if (res <= 0) {
+            vespalib::string error = (res == 0) ? "short read" : vespalib::getErrorString(errno);
+            throw std::runtime_error(vespalib::make_string("Fatal: Reading %zu bytes at offset %zu from '%s' failed: %s",
+                                                           sz, offset, _fileName.c_str(), error.c_str()));
+        }
+        done += res;
+    }
+}
+
+FileRandRead::FSP
+IoUringRandRead::read(size_t offset, vespalib::DataBuffer & buffer, size_t sz)
+{
+    ReadRequest request(offset, sz, buffer);
+    readBatch(vespalib::ArrayRef<ReadRequest>(&request, 1));
+    return FSP();
+}
+
+void
+IoUringRandRead::readBatch(vespalib::ArrayRef<ReadRequest> requests)
+{
+    std::vector<Ring::Read> reads;
+    reads.reserve(requests.size());
+    for (ReadRequest & request : requests) {
+        vespalib::DataBuffer & buffer = *request.buffer;
+        buffer.clear();
+        buffer.ensureFree(request.sz);
+        reads.push_back(Ring::Read{buffer.getFree(), request.sz, request.offset, 0});
+    }
+    std::unique_ptr<Ring> ring;
+    if (usesIoUring()) {
+        ring = acquireRing();
+    }
+    if (ring) {
+        ring->read(_fd, reads.data(), reads.size());
+        releaseRing(std::move(ring));
+    }
+    for (size_t i = 0; i < reads.size(); ++i) {
+        const Ring::Read & r = reads[i];
+        // Short reads and failed reads are retried with pread, which reports any persistent error
+        readRemaining(r.buf, r.sz, r.offset, (r.result > 0) ? r.result : 0);
+        requests[i].buffer->moveFreeToData(r.sz);
+    }
+}
+
+int64_t
+IoUringRandRead::getSize()
+{
+    struct stat st;
+    if (fstat(_fd, &st) != 0) {
+        return -1;
+    }
+    return st.st_size;
+}
+
 FileRandRead::FSP
 NormalRandRead::read(size_t offset, vespalib::DataBuffer & buffer, size_t sz)
 {
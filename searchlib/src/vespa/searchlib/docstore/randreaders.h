@@ -5,6 +5,9 @@
 #include "randread.h"
 #include <vespa/vespalib/util/ptrholder.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
 
 class FastOS_FileInterface;
 
@@ -50,6 +53,34 @@ private:
     std::mutex                                _lock;
 };
 
+/**
+ * Reads through the page cache using io_uring. A batch of reads is
+ * submitted at once, letting the device serve them in parallel instead
+ * of one at a time. Each concurrent reader uses its own ring, taken from
+ * a small pool. Falls back to pread if io_uring is not available.
+ **/
+class IoUringRandRead : public FileRandRead
+{
+public:
+    IoUringRandRead(const vespalib::string & fileName);
+    ~IoUringRandRead() override;
+    FSP read(size_t offset, vespalib::DataBuffer & buffer, size_t sz) override;
+    void readBatch(vespalib::ArrayRef<ReadRequest> requests) override;
+    int64_t getSize() override;
+    bool usesIoUring() const { return !_ringUnavailable.load(std::memory_order_relaxed); }
+private:
+    class Ring;
+    std::unique_ptr<Ring> acquireRing();
+    void releaseRing(std::unique_ptr<Ring> ring);
+    void readRemaining(char * buf, size_t sz, size_t offset, size_t done);
+
+    vespalib::string                   _fileName;
+    int                                _fd;
+    std::atomic<bool>                  _ringUnavailable;
+    std::mutex                         _lock;
+    std::vector<std::unique_ptr<Ring>> _rings;
+};
+
 class NormalRandRead : public FileRandRead
 {
 public:
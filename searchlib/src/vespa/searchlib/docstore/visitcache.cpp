@@ -7,6 +7,7 @@
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/util/compressor.h>
 #include <vespa/vespalib/util/memory_allocator.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <algorithm>
 
 namespace search::docstore {
@@ -16,6 +17,7 @@ using vespalib::ConstBufferRef;
 using vespalib::DataBuffer;
 using vespalib::alloc::Alloc;
 using vespalib::alloc::MemoryAllocator;
+using vespalib::compression::ZStdCompressor;
 
 KeySet::KeySet(uint32_t key) :
     _keys()
@@ -77,22 +79,33 @@ BlobSet::get(uint32_t lid) const
 CompressedBlobSet::CompressedBlobSet() :
     _compression(CompressionConfig::Type::LZ4),
     _positions(),
-    _buffer()
+    _buffer(),
+    _dictionary()
 {
 }
 
 CompressedBlobSet::~CompressedBlobSet() = default;
 
 
-CompressedBlobSet::CompressedBlobSet(const CompressionConfig &compression, const BlobSet & uncompressed) :
+CompressedBlobSet::CompressedBlobSet(const CompressionConfig &compression, const BlobSet & uncompressed,
+                                     ZStdDictionarySP dictionary) :
     _compression(compression.type),
     _positions(uncompressed.getPositions()),
-    _buffer()
+    _buffer(),
+    _dictionary()
 {
     if ( ! _positions.empty() ) {
         DataBuffer compressed;
         ConstBufferRef org = uncompressed.getBuffer();
-        _compression = vespalib::compression::compress(compression, org, compressed, false);
+        if (dictionary && (compression.type == CompressionConfig::ZSTD)) {
+            ZStdCompressor zstd(*dictionary);
+            _compression = vespalib::compression::compress(zstd, compression, org, compressed, false);
+            if (_compression == CompressionConfig::ZSTD) {
+                _dictionary = std::move(dictionary);
+            }
+        } else {
+            _compression = vespalib::compression::compress(compression, org, compressed, false);
+        }
         _buffer = std::make_shared<vespalib::MallocPtr>(compressed.getDataLen());
         memcpy(*_buffer, compressed.getData(), compressed.getDataLen());
     } else {
@@ -106,7 +119,11 @@ CompressedBlobSet::getBlobSet() const
     using vespalib::compression::decompress;
     // These are frequent lage allocations that are to expensive to mmap.
     DataBuffer uncompressed(0, 1, Alloc::alloc(0, 16 * MemoryAllocator::HUGEPAGE_SIZE));
-    if ( ! _positions.empty() ) {
+    if (_dictionary) {
+        ZStdCompressor zstd(*_dictionary);
+        decompress(zstd, getBufferSize(_positions),
+                   ConstBufferRef(_buffer->c_str(), _buffer->size()), uncompressed, false);
+    } else if ( ! _positions.empty() ) {
         decompress(_compression, getBufferSize(_positions),
                    ConstBufferRef(_buffer->c_str(), _buffer->size()), uncompressed, false);
     }
@@ -144,7 +161,7 @@ bool
 VisitCache::BackingStore::read(const KeySet &key, CompressedBlobSet &blobs) const {
     VisitCollector collector;
     _backingStore.read(key.getKeys(), collector);
-    blobs = CompressedBlobSet(_compression, collector.getBlobSet());
+    blobs = CompressedBlobSet(_compression, collector.getBlobSet(), _backingStore.getDictionary());
     return ! blobs.empty();
 }
 
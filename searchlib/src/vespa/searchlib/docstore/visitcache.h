@@ -12,6 +12,8 @@
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/document/util/bytebuffer.h>
 
+namespace vespalib::compression { class ZStdDictionary; }
+
 namespace search::docstore {
 
 /**
@@ -74,8 +76,13 @@ private:
 class CompressedBlobSet {
 public:
     using CompressionConfig = vespalib::compression::CompressionConfig;
+    using ZStdDictionarySP = std::shared_ptr<const vespalib::compression::ZStdDictionary>;
     CompressedBlobSet();
-    CompressedBlobSet(const CompressionConfig &compression, const BlobSet & uncompressed);
+    /**
+     * The dictionary, if any, is used with zstd compression and kept for decompressing.
+     **/
+    CompressedBlobSet(const CompressionConfig &compression, const BlobSet & uncompressed,
+                      ZStdDictionarySP dictionary = ZStdDictionarySP());
     CompressedBlobSet(CompressedBlobSet && rhs) = default;
     CompressedBlobSet & operator=(CompressedBlobSet && rhs) = default;
     CompressedBlobSet(const CompressedBlobSet & rhs) = default;
@@ -88,6 +95,7 @@ private:
     CompressionConfig::Type _compression;
     BlobSet::Positions      _positions;
     std::shared_ptr<vespalib::MallocPtr> _buffer;
+    ZStdDictionarySP        _dictionary;
 };
 
 /**
@@ -31,6 +31,8 @@ namespace search {
 namespace {
 
 const size_t Alignment = FileSettings::DIRECTIO_ALIGNMENT;
+// zstd recommends training dictionaries on around 100 times their size of samples.
+constexpr size_t DictionarySampleFactor = 100;
 
 }
 
@@ -84,7 +86,8 @@ WriteableFileChunk(vespalib::Executor &executor,
                    const TuneFileSummary &tune,
                    const FileHeaderContext &fileHeaderContext,
                    const IBucketizer * bucketizer,
-                   bool skipCrcOnRead)
+                   bool skipCrcOnRead,
+                   ZStdDictionarySP dictionary)
     : FileChunk(fileId, nameId, baseName, tune, bucketizer, skipCrcOnRead),
       _config(config),
       _serialNum(initialSerialNum),
@@ -110,7 +113,10 @@ WriteableFileChunk(vespalib::Executor &executor,
       _writeMonitor(),
       _writeCond(),
       _executor(executor),
-      _bucketMap(bucketizer)
+      _bucketMap(bucketizer),
+      _dictionarySampling(false),
+      _dictionarySamples(),
+      _dictionarySampleSizes()
 {
     _docIdLimit = docIdLimit;
     if (tune._write.getWantDirectIO()) {
@@ -122,6 +128,9 @@ WriteableFileChunk(vespalib::Executor &executor,
     if (_dataFile.OpenReadWrite()) {
         readDataHeader();
         if (_dataHeaderLen == 0) {
+            if (_config.useDictionary()) {
+                _dictionary = std::move(dictionary);
+            }
             writeDataHeader(fileHeaderContext);
         }
         _dataFile.SetPosition(_dataFile.GetSize());
@@ -143,6 +152,7 @@ WriteableFileChunk(vespalib::Executor &executor,
     } else {
         throw SummaryException("Failed opening data file", _dataFile, VESPA_STRLOC);
     }
+    _dictionarySampling = _config.useDictionary() && ! _dictionary;
     _firstChunkIdToBeWritten = _active->getId();
     updateCurrentDiskFootprint();
 }
@@ -255,11 +265,14 @@ WriteableFileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IB
             visitor.visit(entry._lid, vespalib::ConstBufferRef(entry._buf.get(), entry._size));
             entry._buf = vespalib::alloc::Alloc();
         }
+        std::vector<LidsInChunk> chunks;
+        chunks.reserve(chunksOnFile.size());
         for (auto & it : chunksOnFile) {
             auto first = find_first(begin, it.first);
             auto last = seek_past(first, begin + count, it.first);
-            FileChunk::read(first, last - first, it.second, visitor);
+            chunks.push_back({it.second, first, size_t(last - first)});
         }
+        FileChunk::read(chunks, visitor);
     } else {
         FileChunk::read(begin, count, visitor);
     }
@@ -300,7 +313,7 @@ WriteableFileChunk::internalFlush(uint32_t chunkId, uint64_t serialNum, CpuUsage
     if (_alignment > 1) {
         tmp->getBuf().ensureFree(active->getMaxPackSize(_config.getCompression()) + _alignment - 1);
     }
-    active->pack(serialNum, tmp->getBuf(), _config.getCompression());
+    active->pack(serialNum, tmp->getBuf(), _config.getCompression(), _dictionary.get());
     tmp->setPayLoad();
     if (_alignment > 1) {
         const size_t padAfter((_alignment - tmp->getPayLoad() % _alignment) % _alignment);
@@ -623,6 +636,7 @@ WriteableFileChunk::getMemoryFootprint() const
         sz += it.second->size();
     }
     sz += _pendingIdx + _pendingDat;
+    sz += _dictionarySamples.size();
     return sz + FileChunk::getMemoryFootprint();
 }
 
@@ -645,6 +659,8 @@ WriteableFileChunk::getMemoryUsage() const
     size_t pendingBytes = _pendingIdx + _pendingDat;
     result.incAllocatedBytes(pendingBytes);
     result.incUsedBytes(pendingBytes);
+    result.incAllocatedBytes(_dictionarySamples.capacity() + sizeof(size_t) * _dictionarySampleSizes.capacity());
+    result.incUsedBytes(_dictionarySamples.size() + sizeof(size_t) * _dictionarySampleSizes.size());
     result.merge(FileChunk::getMemoryUsage());
     return result;
 }
@@ -740,9 +756,74 @@ WriteableFileChunk::append(uint64_t serialNum, uint32_t lid, const void * buffer
     size_t oldSz(_active->size());
     LidMeta lm = _active->append(lid, buffer, len);
     setDiskFootprint(FileChunk::getDiskFootprint() - oldSz + _active->size());
+    if (_dictionarySampling) {
+        addDictionarySample(buffer, len);
+    }
     return LidInfo(getFileId().getId(), _active->getId(), lm.size());
 }
 
+void
+WriteableFileChunk::addDictionarySample(const void * buffer, size_t len)
+{
+    std::lock_guard guard(_lock);
+    if (_dictionarySamples.size() < _config.getMaxDictionaryBytes() * DictionarySampleFactor) {
+        const char * sample = static_cast<const char *>(buffer);
+        _dictionarySamples.insert(_dictionarySamples.end(), sample, sample + len);
+        _dictionarySampleSizes.push_back(len);
+    }
+}
+
+bool
+WriteableFileChunk::hasDictionarySamples() const
+{
+    std::lock_guard guard(_lock);
+    return _dictionarySampling &&
+           (_dictionarySamples.size() >= _config.getMaxDictionaryBytes() * DictionarySampleFactor);
+}
+
+WriteableFileChunk::DictionarySamples
+WriteableFileChunk::takeDictionarySamples()
+{
+    DictionarySamples samples;
+    samples.fileName = getName();
+    samples.maxDictionaryBytes = _config.getMaxDictionaryBytes();
+    std::lock_guard guard(_lock);
+    _dictionarySampling = false;
+    samples.data.swap(_dictionarySamples);
+    samples.sizes.swap(_dictionarySampleSizes);
+    return samples;
+}
+
+WriteableFileChunk::DictionarySamples::DictionarySamples()
+    : fileName(),
+      maxDictionaryBytes(0),
+      data(),
+      sizes()
+{ }
+
+WriteableFileChunk::DictionarySamples::DictionarySamples(DictionarySamples &&) noexcept = default;
+WriteableFileChunk::DictionarySamples &
+WriteableFileChunk::DictionarySamples::operator = (DictionarySamples &&) noexcept = default;
+WriteableFileChunk::DictionarySamples::~DictionarySamples() = default;
+
+FileChunk::ZStdDictionarySP
+WriteableFileChunk::DictionarySamples::train() const
+{
+    if (sizes.empty()) {
+        return ZStdDictionarySP();
+    }
+    ZStdDictionarySP dictionary = ZStdDictionary::train(vespalib::ConstBufferRef(data.data(), data.size()),
+                                                        sizes, maxDictionaryBytes);
+    if (dictionary) {
+        LOG(debug, "Trained zstd dictionary %u of %zu bytes from %zu documents of %zu bytes in file %s",
+            dictionary->getId(), dictionary->getContent().size(), sizes.size(), data.size(), fileName.c_str());
+    } else {
+        LOG(warning, "Failed training zstd dictionary from %zu documents of %zu bytes in file %s",
+            sizes.size(), data.size(), fileName.c_str());
+    }
+    return dictionary;
+}
+
 
 void
 WriteableFileChunk::readDataHeader()
@@ -752,6 +833,7 @@ WriteableFileChunk::readDataHeader()
         FileHeader h;
         _dataHeaderLen = h.readFile(_dataFile);
         _dataFile.SetPosition(_dataHeaderLen);
+        _dictionary = readDictionary(h);
     } catch (IllegalHeaderException &e) {
         _dataFile.SetPosition(0);
         try {
@@ -818,6 +900,9 @@ WriteableFileChunk::writeDataHeader(const FileHeaderContext &fileHeaderContext)
     assert(_dataFile.GetPosition() == 0);
     fileHeaderContext.addTags(h, _dataFile.GetFileName());
     h.putTag(Tag("desc", "Log data store chunk data"));
+    if (_dictionary) {
+        writeDictionary(h, *_dictionary);
+    }
     _dataHeaderLen = h.writeFile(_dataFile);
 }
 
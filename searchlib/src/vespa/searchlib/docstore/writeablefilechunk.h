@@ -27,18 +27,55 @@ public:
         Config() : Config({CompressionConfig::LZ4, 9, 60}, 0x10000) { }
 
         Config(const CompressionConfig &compression, size_t maxChunkBytes)
+            : Config(compression, maxChunkBytes, 0)
+        { }
+        Config(const CompressionConfig &compression, size_t maxChunkBytes, size_t maxDictionaryBytes)
             : _compression(compression),
-              _maxChunkBytes(maxChunkBytes)
+              _maxChunkBytes(maxChunkBytes),
+              _maxDictionaryBytes(maxDictionaryBytes)
         { }
 
         const CompressionConfig & getCompression() const { return _compression; }
         size_t getMaxChunkBytes() const { return _maxChunkBytes; }
+        /**
+         * Max size of a zstd dictionary trained from the documents written.
+         * 0 means no dictionary. Only used with zstd compression.
+         */
+        size_t getMaxDictionaryBytes() const { return _maxDictionaryBytes; }
+        bool useDictionary() const {
+            return (_maxDictionaryBytes > 0) && (_compression.type == CompressionConfig::ZSTD);
+        }
         bool operator == (const Config & rhs) const {
-            return (_compression == rhs._compression) && (_maxChunkBytes == rhs._maxChunkBytes);
+            return (_compression == rhs._compression) &&
+                   (_maxChunkBytes == rhs._maxChunkBytes) &&
+                   (_maxDictionaryBytes == rhs._maxDictionaryBytes);
         }
     private:
         CompressionConfig _compression;
         size_t _maxChunkBytes;
+        size_t _maxDictionaryBytes;
+    };
+
+    /**
+     * Documents sampled for training a zstd dictionary, handed over by
+     * takeDictionarySamples(). Training is expensive, so it is done
+     * outside the feed path.
+     */
+    struct DictionarySamples {
+        DictionarySamples();
+        DictionarySamples(DictionarySamples &&) noexcept;
+        DictionarySamples & operator = (DictionarySamples &&) noexcept;
+        ~DictionarySamples();
+        /**
+         * Train a dictionary from the samples.
+         * Returns an empty pointer if training failed.
+         */
+        ZStdDictionarySP train() const;
+
+        vespalib::string      fileName;
+        size_t                maxDictionaryBytes;
+        std::vector<char>     data;
+        std::vector<size_t>   sizes;
     };
 
 public:
@@ -47,7 +84,8 @@ public:
                        const vespalib::string & baseName, uint64_t initialSerialNum,
                        uint32_t docIdLimit, const Config & config,
                        const TuneFileSummary &tune, const common::FileHeaderContext &fileHeaderContext,
-                       const IBucketizer * bucketizer, bool crcOnReadDisabled);
+                       const IBucketizer * bucketizer, bool crcOnReadDisabled,
+                       ZStdDictionarySP dictionary = ZStdDictionarySP());
     ~WriteableFileChunk() override;
 
     ssize_t read(uint32_t lid, SubChunkId chunk, vespalib::DataBuffer & buffer) const override;
@@ -69,6 +107,16 @@ public:
     void waitForDiskToCatchUpToNow() const;
     void flushPendingChunks(uint64_t serialNum);
     DataStoreFileChunkStats getStats() const override;
+    /**
+     * Returns true when enough documents have been sampled to train a dictionary.
+     * Documents are only sampled when the config asks for a dictionary and the
+     * file was created without one, until takeDictionarySamples() is called.
+     */
+    bool hasDictionarySamples() const;
+    /**
+     * Hand over the sampled documents and stop sampling.
+     */
+    DictionarySamples takeDictionarySamples();
 
     static uint64_t writeIdxHeader(const common::FileHeaderContext &fileHeaderContext, uint32_t docIdLimit, FastOS_FileInterface &file);
 private:
@@ -90,6 +138,7 @@ private:
     void readDataHeader();
     void readIdxHeader(FastOS_FileInterface & idxFile);
     void writeDataHeader(const common::FileHeaderContext &fileHeaderContext);
+    void addDictionarySample(const void * buffer, size_t len);
     bool needFlushPendingChunks(uint64_t serialNum, uint64_t datFileLen);
     bool needFlushPendingChunks(const unique_lock & guard, uint64_t serialNum, uint64_t datFileLen);
     vespalib::system_time unconditionallyFlushPendingChunks(const unique_lock & flushGuard, uint64_t serialNum, uint64_t datFileLen);
@@ -136,6 +185,9 @@ private:
     vespalib::Executor  & _executor;
     ProcessedChunkMap     _orderedChunks;
     BucketDensityComputer _bucketMap;
+    bool                  _dictionarySampling;
+    std::vector<char>     _dictionarySamples;
+    std::vector<size_t>   _dictionarySampleSizes;
 };
 
 } // namespace search
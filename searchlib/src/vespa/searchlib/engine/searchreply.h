@@ -79,7 +79,7 @@ public:
 
     SearchReply();
     ~SearchReply();
-    SearchReply(const SearchReply &rhs); // for test only
+    SearchReply(const SearchReply &rhs); // does not copy request and issues
     
     void setDistributionKey(uint32_t key) { _distributionKey = key; }
     uint32_t getDistributionKey() const { return _distributionKey; }
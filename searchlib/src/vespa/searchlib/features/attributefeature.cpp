@@ -17,6 +17,7 @@
 #include <vespa/searchlib/attribute/multinumericattribute.h>
 #include <vespa/searchlib/attribute/singleboolattribute.h>
 #include <vespa/vespalib/util/issue.h>
+#include <algorithm>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".features.attributefeature");
@@ -122,6 +123,8 @@ public:
         o[3].as_number = 1;  // count
     }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids, BatchInputs inputs, BatchOutputs outputs) override;
 };
 
 class BoolAttributeExecutor final : public fef::FeatureExecutor {
@@ -134,6 +137,12 @@ public:
     void execute(uint32_t docId) override {
         outputs().set_number(0, _attribute.getFloat(docId));
     }
+    bool supports_batch() const override { return true; }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids, BatchInputs, BatchOutputs outputs) override {
+        for (size_t i = 0; i < docids.size(); ++i) {
+            outputs[0][i] = _attribute.getFloat(docids[i]);
+        }
+    }
 };
 
 /**
@@ -237,6 +246,22 @@ SingleAttributeExecutor<T>::execute(uint32_t docId)
                      : util::getAsFeature(v);
 }
 
+template <typename T>
+void
+SingleAttributeExecutor<T>::execute_batch(vespalib::ConstArrayRef<uint32_t> docids, BatchInputs, BatchOutputs outputs)
+{
+    feature_t *value = outputs[0];
+    for (size_t i = 0; i < docids.size(); ++i) {
+        typename T::LoadedValueType v = _attribute.getFast(docids[i]);
+        value[i] = __builtin_expect(attribute::isUndefined(v), false)
+                   ? attribute::getUndefined<feature_t>()
+                   : util::getAsFeature(v);
+    }
+    std::fill(outputs[1], outputs[1] + docids.size(), 0);  // weight
+    std::fill(outputs[2], outputs[2] + docids.size(), 0);  // contains
+    std::fill(outputs[3], outputs[3] + docids.size(), 1);  // count
+}
+
 template <typename BaseType>
 void
 ArrayAttributeExecutor<BaseType>::execute(uint32_t docId)
@@ -63,7 +63,7 @@ template <typename BaseType>
 DotProductExecutorBase<BaseType>::~DotProductExecutorBase() = default;
 
 template <typename BaseType>
-void DotProductExecutorBase<BaseType>::execute(uint32_t docId) {
+feature_t DotProductExecutorBase<BaseType>::calculate(uint32_t docId) {
     feature_t val = 0;
     auto values = getAttributeValues(docId);
     for (size_t i = 0; i < values.size(); ++i) {
@@ -72,7 +72,19 @@ void DotProductExecutorBase<BaseType>::execute(uint32_t docId) {
             val += values[i].weight() * itr->second;
         }
     }
-    outputs().set_number(0, val);
+    return val;
+}
+
+template <typename BaseType>
+void DotProductExecutorBase<BaseType>::execute(uint32_t docId) {
+    outputs().set_number(0, calculate(docId));
+}
+
+template <typename BaseType>
+void DotProductExecutorBase<BaseType>::execute_batch(vespalib::ConstArrayRef<uint32_t> docids, BatchInputs, BatchOutputs outputs) {
+    for (size_t i = 0; i < docids.size(); ++i) {
+        outputs[0][i] = calculate(docids[i]);
+    }
 }
 
 template <typename BaseType>
@@ -117,6 +129,10 @@ public:
     DotProductExecutorByEnum(const IWeightedSetEnumReadView* weighted_set_enum_read_view, std::unique_ptr<V> queryVector);
     ~DotProductExecutorByEnum() override;
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids, BatchInputs inputs, BatchOutputs outputs) override;
+private:
+    feature_t calculate(uint32_t docId);
 };
 
 DotProductExecutorByEnum::DotProductExecutorByEnum(const IWeightedSetEnumReadView* weighted_set_enum_read_view, const V & queryVector)
@@ -140,8 +156,8 @@ DotProductExecutorByEnum::DotProductExecutorByEnum(const IWeightedSetEnumReadVie
 
 DotProductExecutorByEnum::~DotProductExecutorByEnum() = default;
 
-void
-DotProductExecutorByEnum::execute(uint32_t docId) {
+feature_t
+DotProductExecutorByEnum::calculate(uint32_t docId) {
     feature_t val = 0;
     auto values = _weighted_set_enum_read_view->get_values(docId);
     for (size_t i = 0; i < values.size(); ++i) {
@@ -150,7 +166,19 @@ DotProductExecutorByEnum::execute(uint32_t docId) {
             val += values[i].weight() * itr->second;
         }
     }
-    outputs().set_number(0, val);
+    return val;
+}
+
+void
+DotProductExecutorByEnum::execute(uint32_t docId) {
+    outputs().set_number(0, calculate(docId));
+}
+
+void
+DotProductExecutorByEnum::execute_batch(vespalib::ConstArrayRef<uint32_t> docids, BatchInputs, BatchOutputs outputs) {
+    for (size_t i = 0; i < docids.size(); ++i) {
+        outputs[0][i] = calculate(docids[i]);
+    }
 }
 
 class SingleDotProductExecutorByEnum final : public fef::FeatureExecutor {
@@ -163,16 +191,25 @@ public:
     {}
 
     void execute(uint32_t docId) override {
+        outputs().set_number(0, calculate(docId));
+    }
+    bool supports_batch() const override { return true; }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids, BatchInputs, BatchOutputs outputs) override {
+        for (size_t i = 0; i < docids.size(); ++i) {
+            outputs[0][i] = calculate(docids[i]);
+        }
+    }
+private:
+    feature_t calculate(uint32_t docId) const {
         auto values = _weighted_set_enum_read_view->get_values(docId);
         for (size_t i = 0; i < values.size(); ++i) {
             if (values[i].value_ref().load_relaxed().ref() == _key) {
-                outputs().set_number(0, values[i].weight()*_value);
-                return;
+                return values[i].weight()*_value;
             }
         }
-        outputs().set_number(0, 0);
+        return 0;
     }
-private:
+
     const IWeightedSetEnumReadView * _weighted_set_enum_read_view;
     EnumHandle                   _key;
     feature_t                    _value;
@@ -190,16 +227,25 @@ public:
     {}
 
     void execute(uint32_t docId) override {
+        outputs().set_number(0, calculate(docId));
+    }
+    bool supports_batch() const override { return true; }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids, BatchInputs, BatchOutputs outputs) override {
+        for (size_t i = 0; i < docids.size(); ++i) {
+            outputs[0][i] = calculate(docids[i]);
+        }
+    }
+private:
+    feature_t calculate(uint32_t docId) const {
         auto values = _weighted_set_read_view->get_values(docId);
         for (size_t i = 0; i < values.size(); ++i) {
             if (values[i].value() == _key) {
-                outputs().set_number(0, values[i].weight() * _value);
-                return;
+                return values[i].weight() * _value;
             }
         }
-        outputs().set_number(0, 0);
+        return 0;
     }
-private:
+
     const WeightedSetReadView* _weighted_set_read_view;
     StoredKeyType              _key;
     feature_t                  _value;
@@ -223,11 +269,22 @@ template <typename BaseType>
 DotProductExecutorBase<BaseType>::~DotProductExecutorBase() = default;
 
 template <typename BaseType>
-void DotProductExecutorBase<BaseType>::execute(uint32_t docId) {
+feature_t DotProductExecutorBase<BaseType>::calculate(uint32_t docId) {
     auto values = getAttributeValues(docId);
     size_t commonRange = std::min(values.size(), _queryVector.size());
-    outputs().set_number(0, _multiplier.dotProduct(
-            &_queryVector[0], values.data(), commonRange));
+    return _multiplier.dotProduct(&_queryVector[0], values.data(), commonRange);
+}
+
+template <typename BaseType>
+void DotProductExecutorBase<BaseType>::execute(uint32_t docId) {
+    outputs().set_number(0, calculate(docId));
+}
+
+template <typename BaseType>
+void DotProductExecutorBase<BaseType>::execute_batch(vespalib::ConstArrayRef<uint32_t> docids, BatchInputs, BatchOutputs outputs) {
+    for (size_t i = 0; i < docids.size(); ++i) {
+        outputs[0][i] = calculate(docids[i]);
+    }
 }
 
 template <typename BaseType>
@@ -131,10 +131,13 @@ private:
     const V                                    & _queryVector;
     const typename V::HashMap::const_iterator    _end;
     virtual vespalib::ConstArrayRef<AT> getAttributeValues(uint32_t docid) = 0;
+    feature_t calculate(uint32_t docId);
 public:
     DotProductExecutorBase(const V & queryVector);
     ~DotProductExecutorBase() override;
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids, BatchInputs inputs, BatchOutputs outputs) override;
 };
 
 template <typename BaseType>
@@ -171,10 +174,13 @@ private:
     const vespalib::hwaccelrated::IAccelrated   & _multiplier;
     V                                             _queryVector;
     virtual vespalib::ConstArrayRef<BaseType> getAttributeValues(uint32_t docid) = 0;
+    feature_t calculate(uint32_t docId);
 public:
     DotProductExecutorBase(const V & queryVector);
     ~DotProductExecutorBase() override;
     void execute(uint32_t docId) final override;
+    bool supports_batch() const final override { return true; }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids, BatchInputs inputs, BatchOutputs outputs) final override;
 };
 
 /**
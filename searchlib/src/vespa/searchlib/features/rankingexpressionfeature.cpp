@@ -57,6 +57,8 @@ public:
     FastForestExecutor(ArrayRef<float> param_space, const FastForest &forest);
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(ConstArrayRef<uint32_t> docids, BatchInputs inputs, BatchOutputs outputs) override;
 };
 
 //-----------------------------------------------------------------------------
@@ -75,6 +77,8 @@ public:
     CompiledRankingExpressionExecutor(const CompiledFunction &compiled_function);
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(ConstArrayRef<uint32_t> docids, BatchInputs inputs, BatchOutputs outputs) override;
 };
 
 //-----------------------------------------------------------------------------
@@ -92,6 +96,8 @@ public:
     LazyCompiledRankingExpressionExecutor(const CompiledFunction &compiled_function);
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(ConstArrayRef<uint32_t> docids, BatchInputs inputs, BatchOutputs outputs) override;
 };
 
 //-----------------------------------------------------------------------------
@@ -170,6 +176,17 @@ FastForestExecutor::execute(uint32_t)
     outputs().set_number(0, _forest.eval(*_ctx, &_params[0]));
 }
 
+void
+FastForestExecutor::execute_batch(ConstArrayRef<uint32_t> docids, BatchInputs inputs, BatchOutputs outputs)
+{
+    for (size_t doc = 0; doc < docids.size(); ++doc) {
+        for (size_t i = 0; i < _params.size(); ++i) {
+            _params[i] = inputs[i][doc];
+        }
+        outputs[0][doc] = _forest.eval(*_ctx, &_params[0]);
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 CompiledRankingExpressionExecutor::CompiledRankingExpressionExecutor(const CompiledFunction &compiled_function)
@@ -194,6 +211,17 @@ CompiledRankingExpressionExecutor::execute(uint32_t)
     outputs().set_number(0, _ranking_function(&_params[0]));
 }
 
+void
+CompiledRankingExpressionExecutor::execute_batch(ConstArrayRef<uint32_t> docids, BatchInputs inputs, BatchOutputs outputs)
+{
+    for (size_t doc = 0; doc < docids.size(); ++doc) {
+        for (size_t i = 0; i < _params.size(); ++i) {
+            _params[i] = inputs[i][doc];
+        }
+        outputs[0][doc] = _ranking_function(&_params[0]);
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 namespace {
@@ -202,6 +230,15 @@ using Context = fef::FeatureExecutor::Inputs;
 double resolve_input(void *ctx, size_t idx) { return ((const Context *)(ctx))->get_number(idx); }
 Context *make_ctx(const Context &inputs) { return const_cast<Context *>(&inputs); }
 
+struct BatchContext {
+    fef::FeatureExecutor::BatchInputs inputs;
+    size_t doc;
+};
+double resolve_batch_input(void *ctx, size_t idx) {
+    const auto *batch = (const BatchContext *)(ctx);
+    return batch->inputs[idx][batch->doc];
+}
+
 }
 
 LazyCompiledRankingExpressionExecutor::LazyCompiledRankingExpressionExecutor(const CompiledFunction &compiled_function)
@@ -215,6 +252,15 @@ LazyCompiledRankingExpressionExecutor::execute(uint32_t)
     outputs().set_number(0, _ranking_function(resolve_input, make_ctx(inputs())));
 }
 
+void
+LazyCompiledRankingExpressionExecutor::execute_batch(ConstArrayRef<uint32_t> docids, BatchInputs inputs, BatchOutputs outputs)
+{
+    BatchContext ctx{inputs, 0};
+    for (; ctx.doc < docids.size(); ++ctx.doc) {
+        outputs[0][ctx.doc] = _ranking_function(resolve_batch_input, &ctx);
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 InterpretedRankingExpressionExecutor::InterpretedRankingExpressionExecutor(const InterpretedFunction &function,
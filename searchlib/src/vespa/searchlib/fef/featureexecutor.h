@@ -44,6 +44,14 @@ public:
 class FeatureExecutor
 {
 public:
+    /**
+     * Input and output columns used when executing for a batch of
+     * documents. Column i holds the values of input/output i for all
+     * documents in the batch, in the same order as the docids.
+     **/
+    using BatchInputs = vespalib::ConstArrayRef<const feature_t *>;
+    using BatchOutputs = vespalib::ConstArrayRef<feature_t *>;
+
     class Inputs {
         uint32_t _docid;
         vespalib::ConstArrayRef<LazyValue> _inputs;
@@ -150,6 +158,29 @@ public:
      **/
     virtual bool isPure();
 
+    /**
+     * Check if this feature executor is able to calculate its outputs
+     * for a batch of documents at once (see execute_batch). Only
+     * executors with number inputs and number outputs that do not
+     * use match data may support batch execution, since match data
+     * is only unpacked for a single document at a time. Returns false
+     * by default.
+     *
+     * @return true if this feature executor supports batch execution
+     **/
+    virtual bool supports_batch() const;
+
+    /**
+     * Execute this feature executor for a batch of documents. This
+     * will only be called for executors that support batch execution.
+     * Batch execution does not affect the per-document outputs.
+     *
+     * @param docids the local document ids being evaluated
+     * @param inputs one column of input values per input
+     * @param outputs one column of output values per output
+     **/
+    virtual void execute_batch(vespalib::ConstArrayRef<uint32_t> docids, BatchInputs inputs, BatchOutputs outputs);
+
     /**
      * Make sure this executor has been executed for the given
      * document.
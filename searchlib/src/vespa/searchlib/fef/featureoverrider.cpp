@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "featureoverrider.h"
+#include <algorithm>
 
 namespace search {
 namespace fef {
@@ -44,6 +45,21 @@ FeatureOverrider::execute(uint32_t docId)
     }
 }
 
+bool
+FeatureOverrider::supports_batch() const
+{
+    return (!_object && _executor.supports_batch());
+}
+
+void
+FeatureOverrider::execute_batch(vespalib::ConstArrayRef<uint32_t> docids, BatchInputs inputs, BatchOutputs outputs)
+{
+    _executor.execute_batch(docids, inputs, outputs);
+    if (_outputIdx < outputs.size()) {
+        std::fill(outputs[_outputIdx], outputs[_outputIdx] + docids.size(), _number);
+    }
+}
+
 void
 FeatureOverrider::handle_bind_match_data(const MatchData &md)
 {
@@ -35,6 +35,8 @@ public:
     FeatureOverrider(FeatureExecutor &executor, uint32_t outputIdx, feature_t number, Value::UP object);
     bool isPure() override;
     void execute(uint32_t docId) override;
+    bool supports_batch() const override;
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids, BatchInputs inputs, BatchOutputs outputs) override;
 };
 
 } // namespace fef
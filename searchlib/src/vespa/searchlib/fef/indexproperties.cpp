@@ -384,6 +384,10 @@ MinHitsPerThread::lookup(const Properties &props, uint32_t defaultValue)
     return lookupUint32(props, NAME, defaultValue);
 }
 
+const vespalib::string WorkStealing::NAME("vespa.matching.work_stealing");
+const bool WorkStealing::DEFAULT_VALUE(false);
+bool WorkStealing::check(const Properties &props) { return lookupBool(props, NAME, DEFAULT_VALUE); }
+
 const vespalib::string GlobalFilterLowerLimit::NAME("vespa.matching.global_filter.lower_limit");
 
 const double GlobalFilterLowerLimit::DEFAULT_VALUE(0.05);
@@ -416,6 +420,51 @@ GlobalFilterUpperLimit::lookup(const Properties &props, double defaultValue)
     return lookupDouble(props, NAME, defaultValue);
 }
 
+const vespalib::string WeakAndBm25::NAME("vespa.matching.weakand.bm25");
+const bool WeakAndBm25::DEFAULT_VALUE(false);
+
+bool
+WeakAndBm25::check(const Properties &props)
+{
+    return check(props, DEFAULT_VALUE);
+}
+
+bool
+WeakAndBm25::check(const Properties &props, bool defaultValue)
+{
+    return lookupBool(props, NAME, defaultValue);
+}
+
+const vespalib::string WeakAndBm25K1::NAME("vespa.matching.weakand.bm25.k1");
+const double WeakAndBm25K1::DEFAULT_VALUE(1.2);
+
+double
+WeakAndBm25K1::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+double
+WeakAndBm25K1::lookup(const Properties &props, double defaultValue)
+{
+    return lookupDouble(props, NAME, defaultValue);
+}
+
+const vespalib::string WeakAndBm25B::NAME("vespa.matching.weakand.bm25.b");
+const double WeakAndBm25B::DEFAULT_VALUE(0.75);
+
+double
+WeakAndBm25B::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+double
+WeakAndBm25B::lookup(const Properties &props, double defaultValue)
+{
+    return lookupDouble(props, NAME, defaultValue);
+}
+
 } // namespace matching
 
 namespace softtimeout {
@@ -293,6 +293,17 @@ namespace matching {
         static uint32_t lookup(const Properties &props, uint32_t defaultValue);
     };
 
+    /**
+     * When enabled, the search threads use a work-stealing docid range
+     * scheduler instead of the adaptive scheduler. This only applies
+     * when the number of search partitions is 0.
+     **/
+    struct WorkStealing {
+        static const vespalib::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool check(const Properties &props);
+    };
+
     /**
      * Property to control fallback to not building a global filter
      * for a query with a blueprint that wants a global filter. If the
@@ -320,6 +331,41 @@ namespace matching {
         static double lookup(const Properties &props);
         static double lookup(const Properties &props, double defaultValue);
     };
+
+    /**
+     * When enabled, WeakAnd scores matching documents with BM25 instead
+     * of the static pseudo term frequency score, and skips blocks of
+     * postings that can not make it into the result. Term frequency and
+     * field length are taken from the interleaved features of terms
+     * also used by the bm25 rank feature; other terms are scored as if
+     * occurring once in a field of average length.
+     **/
+    struct WeakAndBm25 {
+        static const vespalib::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool check(const Properties &props);
+        static bool check(const Properties &props, bool defaultValue);
+    };
+
+    /**
+     * The k1 parameter used when WeakAnd scores with BM25.
+     **/
+    struct WeakAndBm25K1 {
+        static const vespalib::string NAME;
+        static const double DEFAULT_VALUE;
+        static double lookup(const Properties &props);
+        static double lookup(const Properties &props, double defaultValue);
+    };
+
+    /**
+     * The b parameter used when WeakAnd scores with BM25.
+     **/
+    struct WeakAndBm25B {
+        static const vespalib::string NAME;
+        static const double DEFAULT_VALUE;
+        static double lookup(const Properties &props);
+        static double lookup(const Properties &props, double defaultValue);
+    };
 }
 
 namespace softtimeout {
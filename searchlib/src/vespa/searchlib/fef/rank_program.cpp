@@ -188,13 +188,30 @@ RankProgram::resolve(const BlueprintResolver::FeatureMap &features, bool unbox_s
     return result;
 }
 
+void
+RankProgram::clear_batch()
+{
+    _batch_size = 0;
+    _batch_columns.clear();
+    _batch_inputs.clear();
+    _batch_outputs.clear();
+    _batch_steps.clear();
+    _batch_seeds.clear();
+}
+
 RankProgram::RankProgram(BlueprintResolver::SP resolver)
     : _resolver(std::move(resolver)),
       _hot_stash(32_Ki),
       _cold_stash(),
       _executors(),
       _unboxed_seeds(),
-      _is_const()
+      _is_const(),
+      _batch_size(0),
+      _batch_columns(),
+      _batch_inputs(),
+      _batch_outputs(),
+      _batch_steps(),
+      _batch_seeds()
 {
 }
 
@@ -272,6 +289,95 @@ RankProgram::setup(const MatchData &md,
     }
 }
 
+bool
+RankProgram::setup_batch(size_t batch_size)
+{
+    const auto &specs = _resolver->getExecutorSpecs();
+    assert(_executors.size() == specs.size());
+    assert(batch_size > 0);
+    clear_batch();
+    auto is_const = [this](FeatureExecutor *executor) {
+        return (executor->outputs().size() > 0) && check_const(executor->outputs().get_raw(0));
+    };
+    std::vector<bool> needed(specs.size(), false);
+    for (const auto &seed_entry: _resolver->getSeedMap()) {
+        auto seed = seed_entry.second;
+        if (specs[seed.executor].output_types[seed.output].is_object()) {
+            return false;
+        }
+        needed[seed.executor] = true;
+    }
+    // executors only depend on executors created before them
+    for (size_t i = specs.size(); i-- > 0; ) {
+        if (!needed[i] || is_const(_executors[i])) {
+            continue;
+        }
+        if (!_executors[i]->supports_batch()) {
+            return false;
+        }
+        for (const auto &ref: specs[i].inputs) {
+            if (specs[ref.executor].output_types[ref.output].is_object()) {
+                return false;
+            }
+            needed[ref.executor] = true;
+        }
+    }
+    // one column per output of each needed executor
+    std::vector<size_t> first_column(specs.size(), 0);
+    size_t num_columns = 0;
+    for (size_t i = 0; i < specs.size(); ++i) {
+        if (needed[i]) {
+            first_column[i] = num_columns;
+            num_columns += specs[i].output_types.size();
+        }
+    }
+    _batch_size = batch_size;
+    _batch_columns.resize(num_columns * batch_size);
+    auto column = [&](BlueprintResolver::FeatureRef ref) {
+        return &_batch_columns[(first_column[ref.executor] + ref.output) * batch_size];
+    };
+    for (uint32_t i = 0; i < specs.size(); ++i) {
+        if (!needed[i]) {
+            continue;
+        }
+        const auto &outputs = _executors[i]->outputs();
+        if (is_const(_executors[i])) {
+            for (uint32_t out_idx = 0; out_idx < outputs.size(); ++out_idx) {
+                if (!specs[i].output_types[out_idx].is_object()) {
+                    feature_t *dst = column({i, out_idx});
+                    std::fill(dst, dst + batch_size, outputs.get_number(out_idx));
+                }
+            }
+            continue;
+        }
+        _batch_steps.push_back(BatchStep{_executors[i], _batch_inputs.size(), _batch_outputs.size()});
+        for (const auto &ref: specs[i].inputs) {
+            _batch_inputs.push_back(column(ref));
+        }
+        for (uint32_t out_idx = 0; out_idx < outputs.size(); ++out_idx) {
+            _batch_outputs.push_back(column({i, out_idx}));
+        }
+    }
+    for (const auto &seed_entry: _resolver->getSeedMap()) {
+        _batch_seeds.push_back(column(seed_entry.second));
+    }
+    return true;
+}
+
+void
+RankProgram::execute_batch(vespalib::ConstArrayRef<uint32_t> docids)
+{
+    assert(docids.size() <= _batch_size);
+    for (size_t i = 0; i < _batch_steps.size(); ++i) {
+        const BatchStep &step = _batch_steps[i];
+        size_t inputs_end = (i + 1 < _batch_steps.size()) ? _batch_steps[i + 1].inputs_begin : _batch_inputs.size();
+        size_t outputs_end = (i + 1 < _batch_steps.size()) ? _batch_steps[i + 1].outputs_begin : _batch_outputs.size();
+        FeatureExecutor::BatchInputs inputs(_batch_inputs.data() + step.inputs_begin, inputs_end - step.inputs_begin);
+        FeatureExecutor::BatchOutputs outputs(_batch_outputs.data() + step.outputs_begin, outputs_end - step.outputs_begin);
+        step.executor->execute_batch(docids, inputs, outputs);
+    }
+}
+
 FeatureResolver
 RankProgram::get_seeds(bool unbox_seeds) const
 {
@@ -41,10 +41,23 @@ private:
     MappedValues                     _unboxed_seeds;
     ValueSet                         _is_const;
 
+    struct BatchStep {
+        FeatureExecutor *executor;
+        size_t           inputs_begin;
+        size_t           outputs_begin;
+    };
+    size_t                           _batch_size;
+    std::vector<feature_t>           _batch_columns;
+    std::vector<const feature_t *>   _batch_inputs;
+    std::vector<feature_t *>         _batch_outputs;
+    std::vector<BatchStep>           _batch_steps;
+    std::vector<const feature_t *>   _batch_seeds;
+
     bool check_const(const NumberOrObject *value) const { return (_is_const.count(value) == 1); }
     bool check_const(FeatureExecutor *executor, const std::vector<BlueprintResolver::FeatureRef> &inputs) const;
     void run_const(FeatureExecutor *executor);
     void unbox(BlueprintResolver::FeatureRef seed, const MatchData &md);
+    void clear_batch();
     FeatureResolver resolve(const BlueprintResolver::FeatureMap &features, bool unbox_seeds) const;
 
 public:
@@ -88,6 +101,34 @@ public:
      * @params unbox_seeds make sure seeds values are numbers
      **/
     FeatureResolver get_all_features(bool unbox_seeds = true) const;
+
+    static constexpr size_t default_batch_size = 128;
+
+    /**
+     * Prepare for calculating the seeds of this rank program for
+     * batches of at most batch_size documents at a time. This is
+     * only possible if all seeds are numbers and all non-const
+     * executors needed to calculate them support batch execution
+     * (see FeatureExecutor::supports_batch). Must be called after
+     * setup.
+     *
+     * @return false if batch execution is not possible
+     **/
+    bool setup_batch(size_t batch_size = default_batch_size);
+
+    /**
+     * Calculate the seeds of this rank program for a batch of
+     * documents. setup_batch must have returned true before calling
+     * this function.
+     **/
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids);
+
+    /**
+     * Obtain the values calculated for a seed by the last call to
+     * execute_batch, one value per document in the batch. Seeds are
+     * indexed in the same order as the features returned by get_seeds.
+     **/
+    const feature_t *get_batch_seed(size_t seed_idx) const { return _batch_seeds[seed_idx]; }
 };
 
 }
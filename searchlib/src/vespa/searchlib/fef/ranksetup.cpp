@@ -67,6 +67,9 @@ RankSetup::RankSetup(const BlueprintFactory &factory, const IIndexEnvironment &i
       _softTimeoutFactor(0.5),
       _global_filter_lower_limit(0.0),
       _global_filter_upper_limit(1.0),
+      _weak_and_bm25(false),
+      _weak_and_bm25_k1(1.2),
+      _weak_and_bm25_b(0.75),
       _mutateOnMatch(),
       _mutateOnFirstPhase(),
       _mutateOnSecondPhase(),
@@ -121,6 +124,9 @@ RankSetup::configure()
     setSoftTimeoutFactor(softtimeout::Factor::lookup(_indexEnv.getProperties()));
     set_global_filter_lower_limit(matching::GlobalFilterLowerLimit::lookup(_indexEnv.getProperties()));
     set_global_filter_upper_limit(matching::GlobalFilterUpperLimit::lookup(_indexEnv.getProperties()));
+    set_weak_and_bm25(matching::WeakAndBm25::check(_indexEnv.getProperties()));
+    set_weak_and_bm25_k1(matching::WeakAndBm25K1::lookup(_indexEnv.getProperties()));
+    set_weak_and_bm25_b(matching::WeakAndBm25B::lookup(_indexEnv.getProperties()));
     _mutateOnMatch._attribute = mutate::on_match::Attribute::lookup(_indexEnv.getProperties());
     _mutateOnMatch._operation = mutate::on_match::Operation::lookup(_indexEnv.getProperties());
     _mutateOnFirstPhase._attribute = mutate::on_first_phase::Attribute::lookup(_indexEnv.getProperties());
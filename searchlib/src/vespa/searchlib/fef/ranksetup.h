@@ -76,6 +76,9 @@ private:
     double                   _softTimeoutFactor;
     double                   _global_filter_lower_limit;
     double                   _global_filter_upper_limit;
+    bool                     _weak_and_bm25;
+    double                   _weak_and_bm25_k1;
+    double                   _weak_and_bm25_b;
     MutateOperation          _mutateOnMatch;
     MutateOperation          _mutateOnFirstPhase;
     MutateOperation          _mutateOnSecondPhase;
@@ -411,6 +414,13 @@ public:
     void set_global_filter_upper_limit(double v) { _global_filter_upper_limit = v; }
     double get_global_filter_upper_limit() const { return _global_filter_upper_limit; }
 
+    void set_weak_and_bm25(bool v) { _weak_and_bm25 = v; }
+    bool get_weak_and_bm25() const { return _weak_and_bm25; }
+    void set_weak_and_bm25_k1(double v) { _weak_and_bm25_k1 = v; }
+    double get_weak_and_bm25_k1() const { return _weak_and_bm25_k1; }
+    void set_weak_and_bm25_b(double v) { _weak_and_bm25_b = v; }
+    double get_weak_and_bm25_b() const { return _weak_and_bm25_b; }
+
     /**
      * This method may be used to indicate that certain features
      * should be dumped during a full feature dump.
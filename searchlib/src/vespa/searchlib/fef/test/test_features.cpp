@@ -4,6 +4,7 @@
 #include "test_features.h"
 #include <vespa/vespalib/locale/c.h>
 #include <vespa/vespalib/util/stash.h>
+#include <algorithm>
 
 
 using vespalib::eval::DoubleValue;
@@ -17,6 +18,10 @@ struct ImpureValueExecutor : FeatureExecutor {
     double value;
     ImpureValueExecutor(double value_in) : value(value_in) {}
     void execute(uint32_t) override { outputs().set_number(0, value); }
+    bool supports_batch() const override { return true; }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids, BatchInputs, BatchOutputs outputs) override {
+        std::fill(outputs[0], outputs[0] + docids.size(), value);
+    }
 };
 
 bool
@@ -38,6 +43,12 @@ ImpureValueBlueprint::createExecutor(const IQueryEnvironment &, vespalib::Stash
 
 struct DocidExecutor : FeatureExecutor {
     void execute(uint32_t docid) override { outputs().set_number(0, docid); }
+    bool supports_batch() const override { return true; }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids, BatchInputs, BatchOutputs outputs) override {
+        for (size_t i = 0; i < docids.size(); ++i) {
+            outputs[0][i] = docids[i];
+        }
+    }
 };
 
 bool
@@ -0,0 +1,45 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+
+namespace search::queryeval {
+
+/**
+ * Bounds on the cheap term features (see fef::TermFieldMatchData
+ * num_occs and field_length) for all documents in the block of
+ * postings that contains the current document of a posting list
+ * iterator. The block ends at (and includes) last_doc_id.
+ **/
+struct BlockMaxFeatures {
+    uint32_t last_doc_id;
+    uint32_t max_num_occs;
+    uint32_t min_field_length;
+
+    BlockMaxFeatures() noexcept
+        : last_doc_id(0),
+          max_num_occs(0),
+          min_field_length(0)
+    {
+    }
+};
+
+/**
+ * Interface implemented by search iterators that can provide block
+ * max features, used for block-max pruning in wand.
+ **/
+class IBlockMaxFeatures
+{
+public:
+    virtual ~IBlockMaxFeatures() = default;
+
+    /**
+     * Fill in block max features for the block containing the
+     * current document. Returns false if not available, e.g. when
+     * the posting list has no skip info or the iterator is at end.
+     **/
+    virtual bool get_block_max_features(BlockMaxFeatures &features) const = 0;
+};
+
+}
@@ -12,7 +12,8 @@ FakeRequestContext::FakeRequestContext(attribute::IAttributeContext * context, v
       _attributeContext(context),
       _query_tensor_name(),
       _query_tensor(),
-      _attribute_blueprint_params()
+      _attribute_blueprint_params(),
+      _weak_and_bm25_params()
 {
 }
 
@@ -10,8 +10,10 @@
 #include <vespa/searchlib/attribute/attributevector.h>
 #include <vespa/searchlib/attribute/attribute_blueprint_params.h>
 #include <vespa/searchlib/queryeval/irequestcontext.h>
+#include <vespa/searchlib/queryeval/wand/bm25_params.h>
 #include <vespa/vespalib/util/doom.h>
 #include <limits>
+#include <optional>
 
 namespace vespalib { class TestClock; }
 namespace search::queryeval {
@@ -47,6 +49,11 @@ public:
 
     const search::attribute::AttributeBlueprintParams& get_attribute_blueprint_params() const override;
 
+    void set_weak_and_bm25_params(const wand::Bm25Params &params) { _weak_and_bm25_params = params; }
+    const wand::Bm25Params *get_weak_and_bm25_params() const override {
+        return _weak_and_bm25_params ? &_weak_and_bm25_params.value() : nullptr;
+    }
+
 private:
     std::unique_ptr<vespalib::TestClock> _clock;
     const vespalib::Doom _doom;
@@ -54,6 +61,7 @@ private:
     vespalib::string _query_tensor_name;
     std::unique_ptr<vespalib::eval::TensorSpec> _query_tensor;
     search::attribute::AttributeBlueprintParams _attribute_blueprint_params;
+    std::optional<wand::Bm25Params> _weak_and_bm25_params;
 };
 
 }
@@ -4,6 +4,7 @@
 
 #include <memory>
 #include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/common/compressedbitvector.h>
 
 namespace search::queryeval {
 
@@ -13,23 +14,32 @@ namespace search::queryeval {
  * bitvector should be a white-list (documents that may
  * possibly become hits have their bit set, documents
  * that are certain to be filtered away should have theirs
- * cleared).
+ * cleared). The white-list is either a plain or a compressed
+ * bitvector, use check() and count() to be independent of the
+ * representation.
  **/
 class GlobalFilter : public std::enable_shared_from_this<GlobalFilter>
 {
 private:
     struct ctor_tag {};
     std::unique_ptr<search::BitVector> bit_vector;
+    std::unique_ptr<search::CompressedBitVector> compressed_bit_vector;
 
 public:
     GlobalFilter(const GlobalFilter &) = delete;
     GlobalFilter(GlobalFilter &&) = delete;
 
     GlobalFilter(ctor_tag, std::unique_ptr<search::BitVector> bit_vector_in) noexcept
-      : bit_vector(std::move(bit_vector_in))
+      : bit_vector(std::move(bit_vector_in)),
+        compressed_bit_vector()
     {}
 
-    GlobalFilter(ctor_tag) noexcept : bit_vector() {}
+    GlobalFilter(ctor_tag, std::unique_ptr<search::CompressedBitVector> compressed_bit_vector_in) noexcept
+      : bit_vector(),
+        compressed_bit_vector(std::move(compressed_bit_vector_in))
+    {}
+
+    GlobalFilter(ctor_tag) noexcept : bit_vector(), compressed_bit_vector() {}
 
     ~GlobalFilter() {}
 
@@ -39,8 +49,20 @@ public:
     }
 
     const search::BitVector *filter() const { return bit_vector.get(); }
+    const search::CompressedBitVector *compressed_filter() const { return compressed_bit_vector.get(); }
+
+    bool has_filter() const { return bit_vector || compressed_bit_vector; }
 
-    bool has_filter() const { return bool(bit_vector); }
+    // The functions below require has_filter()
+    uint32_t size() const {
+        return bit_vector ? bit_vector->size() : compressed_bit_vector->size();
+    }
+    uint32_t count() const {
+        return bit_vector ? bit_vector->countTrueBits() : compressed_bit_vector->countTrueBits();
+    }
+    bool check(uint32_t docid) const {
+        return bit_vector ? bit_vector->testBit(docid) : compressed_bit_vector->testBit(docid);
+    }
 };
 
 } // namespace
@@ -423,16 +423,27 @@ WeakAndBlueprint::always_needs_unpack() const
 
 SearchIterator::UP
 WeakAndBlueprint::createIntermediateSearch(MultiSearch::Children sub_searches,
-                                           bool strict, search::fef::MatchData &) const
+                                           bool strict, search::fef::MatchData &md) const
 {
     WeakAndSearch::Terms terms;
     assert(sub_searches.size() == childCnt());
     assert(_weights.size() == childCnt());
     for (size_t i = 0; i < sub_searches.size(); ++i) {
+        const State &childState = getChild(i).getState();
         // TODO: pass ownership with unique_ptr
         terms.push_back(wand::Term(sub_searches[i].release(),
                                    _weights[i],
-                                   getChild(i).getState().estimate().estHits));
+                                   childState.estimate().estHits));
+        if (_bm25) {
+            // bm25 scoring uses the features unpacked for terms searching a single field
+            if (childState.numFields() == 1) {
+                terms.back().matchData = childState.field(0).resolve(md);
+            }
+            terms.back().avgFieldLength = _avgFieldLengths[i];
+        }
+    }
+    if (_bm25) {
+        return WeakAndSearch::create(terms, _n, strict, *_bm25);
     }
     return WeakAndSearch::create(terms, _n, strict);
 }
@@ -4,6 +4,8 @@
 
 #include "blueprint.h"
 #include "multisearch.h"
+#include <vespa/searchlib/queryeval/wand/bm25_params.h>
+#include <optional>
 
 namespace search::queryeval {
 
@@ -81,8 +83,10 @@ public:
 class WeakAndBlueprint : public IntermediateBlueprint
 {
 private:
-    uint32_t              _n;
-    std::vector<uint32_t> _weights;
+    uint32_t                        _n;
+    std::vector<uint32_t>           _weights;
+    std::optional<wand::Bm25Params> _bm25;
+    std::vector<double>             _avgFieldLengths;
 
 public:
     HitEstimate combine(const std::vector<HitEstimate> &data) const override;
@@ -96,13 +100,22 @@ public:
     SearchIterator::UP createFilterSearch(bool strict, FilterConstraint constraint) const override;
 
     WeakAndBlueprint(uint32_t n) : _n(n) {}
+    // Score matching documents with bm25, see WeakAndSearch
+    WeakAndBlueprint(uint32_t n, const wand::Bm25Params &bm25) : _n(n), _bm25(bm25) {}
     ~WeakAndBlueprint();
     void addTerm(Blueprint::UP bp, uint32_t weight) {
+        addTerm(std::move(bp), weight, 0.0);
+    }
+    // avgFieldLength is only used when scoring with bm25
+    void addTerm(Blueprint::UP bp, uint32_t weight, double avgFieldLength) {
         addChild(std::move(bp));
         _weights.push_back(weight);
+        _avgFieldLengths.push_back(avgFieldLength);
     }
     uint32_t getN() const { return _n; }
     const std::vector<uint32_t> &getWeights() const { return _weights; }
+    const wand::Bm25Params *getBm25Params() const { return _bm25 ? &_bm25.value() : nullptr; }
+    const std::vector<double> &getAvgFieldLengths() const { return _avgFieldLengths; }
 };
 
 //-----------------------------------------------------------------------------
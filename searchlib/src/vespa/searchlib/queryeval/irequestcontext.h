@@ -6,6 +6,7 @@
 
 namespace search::attribute { struct AttributeBlueprintParams; }
 namespace search::attribute { class IAttributeVector; }
+namespace search::queryeval::wand { struct Bm25Params; }
 namespace vespalib::eval { struct Value; }
 namespace vespalib { class Doom; }
 
@@ -39,6 +40,12 @@ public:
     virtual std::unique_ptr<vespalib::eval::Value> get_query_tensor(const vespalib::string& tensor_name) const = 0;
 
     virtual const search::attribute::AttributeBlueprintParams& get_attribute_blueprint_params() const = 0;
+
+    /**
+     * Returns the parameters used when WeakAnd should score matching
+     * documents with BM25, or nullptr to use the default WeakAnd scoring.
+     */
+    virtual const wand::Bm25Params *get_weak_and_bm25_params() const = 0;
 };
 
 }
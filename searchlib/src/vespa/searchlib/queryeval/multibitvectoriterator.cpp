@@ -5,6 +5,7 @@
 #include "andnotsearch.h"
 #include "sourceblendersearch.h"
 #include <vespa/searchlib/common/bitvectoriterator.h>
+#include <vespa/searchlib/common/compressedbitvectoriterator.h>
 #include <vespa/searchlib/fef/termfieldmatchdataarray.h>
 #include <vespa/vespalib/util/optimized.h>
 #include <vespa/vespalib/hwaccelrated/iaccelrated.h>
@@ -60,6 +61,8 @@ struct And {
     void operator () (const IAccelrated & accel, size_t offset, const std::vector<std::pair<const void *, bool>> & src, void *dest) {
         accel.and64(offset, src, dest);
     }
+    static Word identity() { return BitWord::allBits(); }
+    static Word combine(Word a, Word b) { return a & b; }
     static bool isAnd() { return true; }
 };
 
@@ -68,6 +71,8 @@ struct Or {
     void operator () (const IAccelrated & accel, size_t offset, const std::vector<std::pair<const void *, bool>> & src, void *dest) {
         accel.or64(offset, src, dest);
     }
+    static Word identity() { return 0; }
+    static Word combine(Word a, Word b) { return a | b; }
     static bool isAnd() { return false; }
 };
 
@@ -82,7 +87,18 @@ void MultiBitVectorIterator<Update>::updateLastValue(uint32_t docId)
         const uint32_t index(wordNum(docId));
         if (docId >= _lastMaxDocIdLimitRequireFetch) {
             uint32_t baseIndex = index & ~(NumWordsInBatch - 1);
-            _update(_accel, baseIndex*sizeof(Word), _bvs, _lastWords);
+            if (__builtin_expect(!_bvs.empty(), true)) {
+                _update(_accel, baseIndex*sizeof(Word), _bvs, _lastWords);
+            } else {
+                std::fill(std::begin(_lastWords), std::end(_lastWords), Update::identity());
+            }
+            for (const auto & compressed : _compressed_bvs) {
+                alignas(64) Word words[NumWordsInBatch];
+                compressed.first->getWords(baseIndex, NumWordsInBatch, words);
+                for (size_t i(0); i < NumWordsInBatch; i++) {
+                    _lastWords[i] = Update::combine(_lastWords[i], compressed.second ? ~words[i] : words[i]);
+                }
+            }
             _lastMaxDocIdLimitRequireFetch = (baseIndex + NumWordsInBatch) * WordLen;
         }
         _lastValue = _lastWords[index % NumWordsInBatch];
@@ -125,11 +141,16 @@ typedef MultiBitVectorIteratorStrict<And> AndBVIteratorStrict;
 typedef MultiBitVectorIterator<Or> OrBVIterator;
 typedef MultiBitVectorIteratorStrict<Or> OrBVIteratorStrict;
 
+bool isStealable(const SearchIterator & search)
+{
+    return search.isBitVector() || search.isCompressedBitVector();
+}
+
 bool hasAtLeast2Bitvectors(const MultiSearch::Children & children)
 {
     size_t count(0);
     for (const auto & search : children) {
-        if (search->isBitVector()) {
+        if (isStealable(*search)) {
             count++;
         }
     }
@@ -155,18 +176,31 @@ MultiBitVectorIteratorBase::MultiBitVectorIteratorBase(Children children) :
     _lastMaxDocIdLimit(0),
     _lastMaxDocIdLimitRequireFetch(0),
     _lastValue(0),
-    _bvs()
+    _bvs(),
+    _compressed_bvs()
 {
     _bvs.reserve(getChildren().size());
     for (const auto & child : getChildren()) {
-        const auto * bv = static_cast<const BitVectorIterator *>(child.get());
-        _bvs.emplace_back(bv->getBitValues(), bv->isInverted());
-        _numDocs = std::min(_numDocs, bv->getDocIdLimit());
+        addChild(*child);
     }
 }
 
 MultiBitVectorIteratorBase::~MultiBitVectorIteratorBase() = default;
 
+void
+MultiBitVectorIteratorBase::addChild(const SearchIterator &child)
+{
+    if (child.isCompressedBitVector()) {
+        const auto & bv = static_cast<const CompressedBitVectorIterator &>(child);
+        _compressed_bvs.emplace_back(&bv.getCompressedBitVector(), bv.isInverted());
+        _numDocs = std::min(_numDocs, bv.getDocIdLimit());
+    } else {
+        const auto & bv = static_cast<const BitVectorIterator &>(child);
+        _bvs.emplace_back(bv.getBitValues(), bv.isInverted());
+        _numDocs = std::min(_numDocs, bv.getDocIdLimit());
+    }
+}
+
 void
 MultiBitVectorIteratorBase::initRange(uint32_t beginId, uint32_t endId)
 {
@@ -179,9 +213,8 @@ SearchIterator::UP
 MultiBitVectorIteratorBase::andWith(UP filter, uint32_t estimate)
 {
     (void) estimate;
-    if (filter->isBitVector() && acceptExtraFilter()) {
-        const auto & bv = static_cast<const BitVectorIterator &>(*filter);
-        _bvs.emplace_back(bv.getBitValues(), bv.isInverted());
+    if (isStealable(*filter) && acceptExtraFilter()) {
+        addChild(*filter);
         insert(getChildren().size(), std::move(filter));
         _lastMaxDocIdLimit = 0;  // force reload
         _lastMaxDocIdLimitRequireFetch = 0;
@@ -197,7 +230,7 @@ MultiBitVectorIteratorBase::doUnpack(uint32_t docid)
     } else {
         auto &children = getChildren();
         _unpackInfo.each([&children,docid](size_t i) {
-                static_cast<BitVectorIterator *>(children[i].get())->unpack(docid);
+                children[i]->unpack(docid);
             }, children.size());
     }
 }
@@ -226,7 +259,7 @@ MultiBitVectorIteratorBase::optimizeMultiSearch(SearchIterator::UP parentIt)
         bool strict(false);
         size_t insertPosition(0);
         for (size_t it(firstStealable(parent)); it != parent.getChildren().size(); ) {
-            if (parent.getChildren()[it]->isBitVector()) {
+            if (isStealable(*parent.getChildren()[it])) {
                 if (stolen.empty()) {
                     insertPosition = it;
                 }
@@ -6,6 +6,8 @@
 #include "unpackinfo.h"
 #include <vespa/searchlib/common/bitword.h>
 
+namespace search { class CompressedBitVector; }
+
 namespace search::queryeval {
 
 class MultiBitVectorIteratorBase : public MultiSearch, protected BitWord
@@ -22,13 +24,17 @@ public:
 protected:
     MultiBitVectorIteratorBase(Children hildren);
     using MetaWord = std::pair<const void *, bool>;
+    using CompressedMetaWord = std::pair<const CompressedBitVector *, bool>;
 
     uint32_t                _numDocs;
     uint32_t                _lastMaxDocIdLimit; // next documentid requiring recomputation.
     uint32_t                _lastMaxDocIdLimitRequireFetch;
     Word                    _lastValue; // Last value computed
     std::vector<MetaWord>   _bvs;
+    // Compressed bitvectors are decoded one batch of words at a time
+    std::vector<CompressedMetaWord> _compressed_bvs;
 private:
+    void addChild(const SearchIterator &child);
     virtual bool acceptExtraFilter() const = 0;
     UP andWith(UP filter, uint32_t estimate) override;
     void doUnpack(uint32_t docid) override;
@@ -129,7 +129,7 @@ NearestNeighborBlueprint::set_global_filter(const GlobalFilter &global_filter, d
     if (_approximate && nns_index) {
         uint32_t est_hits = _attr_tensor.get_num_docs();
         if (_global_filter->has_filter()) { // pre-filtering case
-            _global_filter_hits = _global_filter->filter()->countTrueBits();
+            _global_filter_hits = _global_filter->count();
             _global_filter_hit_ratio = static_cast<double>(_global_filter_hits.value()) / est_hits;
             if (_global_filter_hit_ratio.value() < _global_filter_lower_limit) {
                 _algorithm = Algorithm::EXACT_FALLBACK;
@@ -157,8 +157,7 @@ NearestNeighborBlueprint::perform_top_k(const search::tensor::NearestNeighborInd
     auto lhs = _query_tensor->cells();
     uint32_t k = _adjusted_target_hits;
     if (_global_filter->has_filter()) {
-        auto filter = _global_filter->filter();
-        _found_hits = nns_index->find_top_k_with_filter(k, lhs, *filter, k + _explore_additional_hits, _distance_threshold);
+        _found_hits = nns_index->find_top_k_with_filter(k, lhs, *_global_filter, k + _explore_additional_hits, _distance_threshold);
         _algorithm = Algorithm::INDEX_TOP_K_WITH_FILTER;
     } else {
         _found_hits = nns_index->find_top_k(k, lhs, k + _explore_additional_hits, _distance_threshold);
@@ -180,7 +179,7 @@ NearestNeighborBlueprint::createLeafSearch(const search::fef::TermFieldMatchData
     }
     const Value &qT = *_query_tensor;
     return NearestNeighborIterator::create(strict, tfmd, qT, _attr_tensor,
-                                           _distance_heap, _global_filter->filter(), _dist_fun);
+                                           _distance_heap, _global_filter->has_filter() ? _global_filter.get() : nullptr, _dist_fun);
 }
 
 void
@@ -46,7 +46,7 @@ public:
     void doSeek(uint32_t docId) override {
         double distanceLimit = params().distanceHeap.distanceLimit();
         while (__builtin_expect((docId < getEndId()), true)) {
-            if ((!has_filter) || params().filter->testBit(docId)) {
+            if ((!has_filter) || params().filter->check(docId)) {
                 double d = computeDistance(docId, distanceLimit);
                 if (d <= distanceLimit) {
                     _lastScore = d;
@@ -108,7 +108,7 @@ NearestNeighborIterator::create(
         const vespalib::eval::Value &queryTensor,
         const search::tensor::ITensorAttribute &tensorAttribute,
         NearestNeighborDistanceHeap &distanceHeap,
-        const search::BitVector *filter,
+        const GlobalFilter *filter,
         const search::tensor::DistanceFunction *dist_fun)
 
 {
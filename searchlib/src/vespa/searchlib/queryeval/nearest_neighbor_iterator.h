@@ -3,6 +3,7 @@
 #pragma once
 
 #include "searchiterator.h"
+#include "global_filter.h"
 #include "nearest_neighbor_distance_heap.h"
 #include <vespa/eval/eval/value.h>
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
@@ -24,14 +25,14 @@ public:
         const Value &queryTensor;
         const ITensorAttribute &tensorAttribute;
         NearestNeighborDistanceHeap &distanceHeap;
-        const search::BitVector *filter;
+        const GlobalFilter *filter;
         const search::tensor::DistanceFunction *distanceFunction;
         
         Params(fef::TermFieldMatchData &tfmd_in,
                const Value &queryTensor_in,
                const ITensorAttribute &tensorAttribute_in,
                NearestNeighborDistanceHeap &distanceHeap_in,
-               const search::BitVector *filter_in,
+               const GlobalFilter *filter_in,
                const search::tensor::DistanceFunction *distanceFunction_in)
           : tfmd(tfmd_in),
             queryTensor(queryTensor_in),
@@ -52,7 +53,7 @@ public:
             const Value &queryTensor,
             const search::tensor::ITensorAttribute &tensorAttribute,
             NearestNeighborDistanceHeap &distanceHeap,
-            const search::BitVector *filter,
+            const GlobalFilter *filter,
             const search::tensor::DistanceFunction *dist_fun);
 
     const Params& params() const { return _params; }
@@ -332,6 +332,11 @@ public:
      * @return true if it is a bitvector
      */
     virtual bool isBitVector() const { return false; }
+
+    /**
+     * @return true if it is a compressed bitvector
+     */
+    virtual bool isCompressedBitVector() const { return false; }
     /**
      * @return true if it is a source blender
      */
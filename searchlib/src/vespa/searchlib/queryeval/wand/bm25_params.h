@@ -0,0 +1,22 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+
+namespace search::queryeval::wand {
+
+/**
+ * Parameters used when documents matched by WeakAnd are scored with
+ * BM25 instead of the static pseudo term frequency score.
+ **/
+struct Bm25Params
+{
+    double   k1;
+    double   b;
+    uint32_t docIdLimit;
+    Bm25Params(double k1_in, double b_in, uint32_t docIdLimit_in) noexcept
+        : k1(k1_in), b(b_in), docIdLimit(docIdLimit_in) {}
+};
+
+}
@@ -14,6 +14,49 @@ VectorizedIteratorTerms::VectorizedIteratorTerms(VectorizedIteratorTerms &&) noe
 VectorizedIteratorTerms & VectorizedIteratorTerms::operator=(VectorizedIteratorTerms &&) noexcept = default;
 VectorizedIteratorTerms::~VectorizedIteratorTerms() = default;
 
+Bm25Scorer::Bm25Scorer(const Bm25Params &params)
+    : _k1(params.k1),
+      _k1_mul_one_minus_b(params.k1 * (1.0 - params.b)),
+      _k1_mul_b(params.k1 * params.b),
+      _docIdLimit(params.docIdLimit),
+      _terms()
+{
+}
+
+Bm25Scorer::~Bm25Scorer() = default;
+
+double
+Bm25Scorer::calculate_idf(uint32_t estHits, uint32_t docIdLimit)
+{
+    double total_doc_count = std::max(docIdLimit, estHits + 1u) - 1.0;
+    return std::log(1.0 + ((total_doc_count - estHits + 0.5) / (estHits + 0.5)));
+}
+
+score_t
+Bm25Scorer::calculateMaxScore(const Term &term) const
+{
+    double weighted_idf = TermFrequencyScorer_TERM_SCORE_FACTOR * term.weight * calculate_idf(term.estHits, _docIdLimit);
+    return (score_t) (weighted_idf * (_k1 + 1.0)) + 1;
+}
+
+void
+Bm25Scorer::setup(const Terms &terms)
+{
+    _terms.clear();
+    _terms.reserve(terms.size());
+    for (const Term &term : terms) {
+        const fef::TermFieldMatchData *tfmd = term.matchData;
+        // block max bounds are only valid if actual scores are calculated from unpacked cheap features
+        const IBlockMaxFeatures *block_max = (tfmd != nullptr && tfmd->needs_interleaved_features())
+                                             ? dynamic_cast<const IBlockMaxFeatures *>(term.search)
+                                             : nullptr;
+        _terms.push_back({block_max, tfmd,
+                          TermFrequencyScorer_TERM_SCORE_FACTOR * term.weight * calculate_idf(term.estHits, _docIdLimit),
+                          std::max(term.avgFieldLength, 1.0),
+                          term.maxScore});
+    }
+}
+
 }
 
 void visit(vespalib::ObjectVisitor &self, const vespalib::string &name,
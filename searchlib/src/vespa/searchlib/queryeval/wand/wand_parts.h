@@ -6,6 +6,8 @@
 #include <cmath>
 #include <vespa/searchlib/fef/matchdata.h>
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/queryeval/wand/bm25_params.h>
+#include <vespa/searchlib/queryeval/block_max_features.h>
 #include <vespa/searchlib/queryeval/searchiterator.h>
 #include <vespa/searchlib/queryeval/iterator_pack.h>
 #include <vespa/searchlib/attribute/iterator_pack.h>
@@ -40,7 +42,8 @@ struct Term {
     int32_t                  weight;
     uint32_t                 estHits;
     fef::TermFieldMatchData *matchData;
-    score_t                  maxScore = 0.0; // <- only used by rise wand test
+    score_t                  maxScore = 0.0; // <- only used by rise wand test and bm25 scoring
+    double                   avgFieldLength = 0.0; // <- only used by bm25 scoring
     Term(SearchIterator *s, int32_t w, uint32_t e, fef::TermFieldMatchData *tfmd) noexcept
         : search(s), weight(w), estHits(e), matchData(tfmd)
     {}
@@ -90,6 +93,7 @@ struct TermInput {
     int32_t get_weight(ref_t ref) const { return terms[ref].weight; }
     uint32_t get_est_hits(ref_t ref) const { return terms[ref].estHits; }
     int32_t get_max_weight(ref_t ref) const { return ::search::queryeval::wand::get_max_weight(*(terms[ref].search)); }
+    score_t get_max_score(ref_t ref) const { return terms[ref].maxScore; }
     docid_t get_initial_docid(ref_t ref) const { return terms[ref].search->getDocId(); } 
 };
 
@@ -339,6 +343,8 @@ public:
     }
     ref_t *present_begin() const { return _present; }
     ref_t *present_end() const { return _past; }
+    ref_t *past_begin() const { return _past; }
+    ref_t *past_end() const { return _trash; }
     vespalib::string stringify() const;
 };
 
@@ -452,6 +458,76 @@ struct DotProductScorer
 
 //-----------------------------------------------------------------------------
 
+/**
+ * Scorer used with WeakAndAlgorithm that scores matching terms with
+ * BM25 (same formula as the bm25 rank feature) using the cheap
+ * (interleaved) term features. The max score of a term is the BM25
+ * limit for infinite term frequency, precalculated and stored in the
+ * term. Terms with iterators exposing block max features also get a
+ * tighter bound for the block of postings containing their current
+ * document, used for block-max pruning.
+ */
+class Bm25Scorer
+{
+private:
+    struct TermState {
+        const IBlockMaxFeatures       *blockMax;
+        const fef::TermFieldMatchData *matchData;
+        double                         weightedIdf;
+        double                         avgFieldLength;
+        score_t                        maxScore;
+    };
+    double                 _k1;
+    double                 _k1_mul_one_minus_b;
+    double                 _k1_mul_b;
+    uint32_t               _docIdLimit;
+    std::vector<TermState> _terms;
+
+    double calculate_score(const TermState &term, double num_occs, double field_length) const {
+        double norm_field_length = field_length / term.avgFieldLength;
+        return term.weightedIdf * (num_occs * (_k1 + 1.0)) /
+            (num_occs + _k1_mul_one_minus_b + _k1_mul_b * norm_field_length);
+    }
+
+public:
+    Bm25Scorer(const Bm25Params &params);
+    ~Bm25Scorer();
+
+    static double calculate_idf(uint32_t estHits, uint32_t docIdLimit);
+    score_t calculateMaxScore(const Term &term) const;
+
+    template <typename Input>
+    static score_t calculate_max_score(const Input &input, ref_t ref) {
+        return input.get_max_score(ref);
+    }
+
+    // setup state for terms, ordered as in vectorized terms
+    void setup(const Terms &terms);
+
+    // must be called after term has been unpacked for the document
+    score_t calculateScore(ref_t ref) const {
+        const TermState &term = _terms[ref];
+        const fef::TermFieldMatchData *tfmd = term.matchData;
+        if (tfmd == nullptr || tfmd->getNumOccs() == 0) {
+            return (score_t) calculate_score(term, 1.0, term.avgFieldLength);
+        }
+        return (score_t) calculate_score(term, tfmd->getNumOccs(), tfmd->getFieldLength());
+    }
+
+    bool calculate_block_max_score(ref_t ref, score_t &score, docid_t &lastDocId) const {
+        const TermState &term = _terms[ref];
+        BlockMaxFeatures features;
+        if (term.blockMax == nullptr || !term.blockMax->get_block_max_features(features)) {
+            return false;
+        }
+        score = std::min(term.maxScore, (score_t)calculate_score(term, features.max_num_occs, features.min_field_length) + 1);
+        lastDocId = features.last_doc_id;
+        return true;
+    }
+};
+
+//-----------------------------------------------------------------------------
+
 // used with parallel wand where we can safely discard hits based on score
 struct GreaterThan {
     score_t threshold;
@@ -645,6 +721,38 @@ public:
         return score;
     }
 
+    /**
+     * Block-max pruning: calculate a tighter upper bound for the
+     * current candidate, using block max scores for terms that may
+     * match it. If the candidate cannot reach the threshold, skip to
+     * the first document where any of the tightened bounds may
+     * change. Returns true if the candidate was skipped.
+     **/
+    template <typename VectorizedTerms, typename Heaps, typename BlockMaxScorer, typename AboveThreshold>
+    bool skip_block_max(VectorizedTerms &terms, Heaps &heaps, const BlockMaxScorer &scorer, AboveThreshold &&aboveThreshold) {
+        score_t bound = 0;
+        docid_t next = heaps.has_future() ? terms.docId(heaps.future()) : search::endDocId;
+        auto add_bound = [&](ref_t ref) {
+            score_t max_score = terms.maxScore(ref);
+            score_t block_max_score = 0;
+            docid_t last_doc_id = 0;
+            if (scorer.calculate_block_max_score(ref, block_max_score, last_doc_id) &&
+                last_doc_id >= _candidate && block_max_score < max_score)
+            {
+                max_score = block_max_score;
+                next = std::min(next, last_doc_id + 1);
+            }
+            bound += max_score;
+        };
+        std::for_each(heaps.present_begin(), heaps.present_end(), add_bound);
+        std::for_each(heaps.past_begin(), heaps.past_end(), add_bound);
+        if (aboveThreshold(bound) || next == search::endDocId) {
+            return false;
+        }
+        set_candidate(terms, heaps, next);
+        return true;
+    }
+
     template <typename VectorizedTerms, typename Heaps>
     void find_matching_terms(VectorizedTerms &terms, Heaps &heaps) {
         while (heaps.has_past()) {
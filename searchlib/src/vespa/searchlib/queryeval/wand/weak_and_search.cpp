@@ -17,6 +17,7 @@ class WeakAndSearchLR : public WeakAndSearch
 private:
     typedef vespalib::PriorityQueue<score_t> Scores;
 
+    std::unique_ptr<Bm25Scorer>    _bm25;      // only used when scoring with bm25
     VectorizedIteratorTerms        _terms;
     DualHeap<FutureHeap, PastHeap> _heaps;
     Algorithm                      _algo;
@@ -26,11 +27,28 @@ private:
 
     void seek_strict(uint32_t docid) {
         _algo.set_candidate(_terms, _heaps, docid);
-        if (_algo.solve_wand_constraint(_terms, _heaps, GreaterThanEqual(_threshold))) {
-            setDocId(_algo.get_candidate());
-        } else {
-            setAtEnd();
+        while (_algo.solve_wand_constraint(_terms, _heaps, GreaterThanEqual(_threshold))) {
+            if (!_bm25 || !_algo.skip_block_max(_terms, _heaps, *_bm25, GreaterThanEqual(_threshold))) {
+                setDocId(_algo.get_candidate());
+                return;
+            }
+        }
+        setAtEnd();
+    }
+
+    static Terms prepare_bm25_terms(const Terms &terms, const Bm25Scorer &bm25) {
+        Terms result(terms);
+        for (Term &term : result) {
+            term.maxScore = bm25.calculateMaxScore(term);
         }
+        return result;
+    }
+
+    static VectorizedIteratorTerms make_terms(const Terms &terms, const Bm25Scorer *bm25) {
+        if (bm25 != nullptr) {
+            return VectorizedIteratorTerms(prepare_bm25_terms(terms, *bm25), *bm25, 0, fef::MatchData::UP(nullptr));
+        }
+        return VectorizedIteratorTerms(terms, TermFrequencyScorer(), 0, fef::MatchData::UP(nullptr));
     }
 
     void seek_unstrict(uint32_t docid) {
@@ -43,17 +61,18 @@ private:
     }
 
 public:
-    WeakAndSearchLR(const Terms &terms, uint32_t n)
-        : _terms(terms,
-                 TermFrequencyScorer(),
-                 0,
-                 fef::MatchData::UP(nullptr)),
+    WeakAndSearchLR(const Terms &terms, uint32_t n, const Bm25Params *bm25)
+        : _bm25(bm25 ? std::make_unique<Bm25Scorer>(*bm25) : std::unique_ptr<Bm25Scorer>()),
+          _terms(make_terms(terms, _bm25.get())),
           _heaps(DocIdOrder(_terms.docId()), _terms.size()),
           _algo(),
           _threshold(1),
           _scores(),
           _n(n)
     {
+        if (_bm25) {
+            _bm25->setup(_terms.input_terms());
+        }
     }
     virtual size_t get_num_terms() const override { return _terms.size(); }
     virtual int32_t get_term_weight(size_t idx) const override { return _terms.weight(idx); }
@@ -69,17 +88,21 @@ public:
     }
     void doUnpack(uint32_t docid) override {
         _algo.find_matching_terms(_terms, _heaps);
-        _scores.push(_algo.get_upper_bound());
+        score_t score = _bm25 ? 0 : _algo.get_upper_bound();
+        ref_t *end = _heaps.present_end();
+        for (ref_t *ref = _heaps.present_begin(); ref != end; ++ref) {
+            _terms.unpack(*ref, docid);
+            if (_bm25) {
+                score += _bm25->calculateScore(*ref);
+            }
+        }
+        _scores.push(score);
         if (_scores.size() > _n) {
             _scores.pop_front();
         }
         if (_scores.size() == _n) {
             _threshold = _scores.front();
         }
-        ref_t *end = _heaps.present_end();
-        for (ref_t *ref = _heaps.present_begin(); ref != end; ++ref) {
-            _terms.unpack(*ref, docid);
-        }
     }
     void initRange(uint32_t begin, uint32_t end) override {
         WeakAndSearch::initRange(begin, end);
@@ -107,22 +130,22 @@ WeakAndSearch::visitMembers(vespalib::ObjectVisitor &visitor) const
 //-----------------------------------------------------------------------------
 
 SearchIterator::UP
-WeakAndSearch::createArrayWand(const Terms &terms, uint32_t n, bool strict)
+WeakAndSearch::createArrayWand(const Terms &terms, uint32_t n, bool strict, const wand::Bm25Params *bm25)
 {
     if (strict) {
-        return SearchIterator::UP(new wand::WeakAndSearchLR<vespalib::LeftArrayHeap, vespalib::RightArrayHeap, true>(terms, n));
+        return SearchIterator::UP(new wand::WeakAndSearchLR<vespalib::LeftArrayHeap, vespalib::RightArrayHeap, true>(terms, n, bm25));
     } else {
-        return SearchIterator::UP(new wand::WeakAndSearchLR<vespalib::LeftArrayHeap, vespalib::RightArrayHeap, false>(terms, n));
+        return SearchIterator::UP(new wand::WeakAndSearchLR<vespalib::LeftArrayHeap, vespalib::RightArrayHeap, false>(terms, n, bm25));
     }
 }
 
 SearchIterator::UP
-WeakAndSearch::createHeapWand(const Terms &terms, uint32_t n, bool strict)
+WeakAndSearch::createHeapWand(const Terms &terms, uint32_t n, bool strict, const wand::Bm25Params *bm25)
 {
     if (strict) {
-        return SearchIterator::UP(new wand::WeakAndSearchLR<vespalib::LeftHeap, vespalib::RightHeap, true>(terms, n));
+        return SearchIterator::UP(new wand::WeakAndSearchLR<vespalib::LeftHeap, vespalib::RightHeap, true>(terms, n, bm25));
     } else {
-        return SearchIterator::UP(new wand::WeakAndSearchLR<vespalib::LeftHeap, vespalib::RightHeap, false>(terms, n));
+        return SearchIterator::UP(new wand::WeakAndSearchLR<vespalib::LeftHeap, vespalib::RightHeap, false>(terms, n, bm25));
     }
 }
 
@@ -130,9 +153,19 @@ SearchIterator::UP
 WeakAndSearch::create(const Terms &terms, uint32_t n, bool strict)
 {
     if (terms.size() < 128) {
-        return createArrayWand(terms, n, strict);
+        return createArrayWand(terms, n, strict, nullptr);
+    } else {
+        return createHeapWand(terms, n, strict, nullptr);
+    }
+}
+
+SearchIterator::UP
+WeakAndSearch::create(const Terms &terms, uint32_t n, bool strict, const wand::Bm25Params &bm25)
+{
+    if (terms.size() < 128) {
+        return createArrayWand(terms, n, strict, &bm25);
     } else {
-        return createHeapWand(terms, n, strict);
+        return createHeapWand(terms, n, strict, &bm25);
     }
 }
 
@@ -16,9 +16,11 @@ struct WeakAndSearch : SearchIterator {
     virtual const Terms &getTerms() const = 0;
     virtual uint32_t getN() const = 0;
     void visitMembers(vespalib::ObjectVisitor &visitor) const override;
-    static SearchIterator::UP createArrayWand(const Terms &terms, uint32_t n, bool strict);
-    static SearchIterator::UP createHeapWand(const Terms &terms, uint32_t n, bool strict);
+    static SearchIterator::UP createArrayWand(const Terms &terms, uint32_t n, bool strict, const wand::Bm25Params *bm25);
+    static SearchIterator::UP createHeapWand(const Terms &terms, uint32_t n, bool strict, const wand::Bm25Params *bm25);
     static SearchIterator::UP create(const Terms &terms, uint32_t n, bool strict);
+    // Score matching documents with bm25, using block max features to skip postings when available
+    static SearchIterator::UP create(const Terms &terms, uint32_t n, bool strict, const wand::Bm25Params &bm25);
 };
 
 } // namespace queryeval
@@ -46,7 +46,47 @@ AngularDistance::calc(const vespalib::eval::TypedCells& lhs,
     return typify_invoke<2,TypifyCellType,CalcAngular>(lhs.type, rhs.type, lhs, rhs);
 }
 
+double
+AngularDistanceBFloat16::norm_sq(const vespalib::eval::TypedCells& cells) const
+{
+    if (cells.type == vespalib::eval::CellType::BFLOAT16) {
+        auto v = static_cast<const vespalib::BFloat16 *>(cells.data);
+        return _computer.dotProduct(v, v, cells.size);
+    }
+    auto v = static_cast<const float *>(cells.data);
+    return _computer.dotProduct(v, v, cells.size);
+}
+
+double
+AngularDistanceBFloat16::calc(const vespalib::eval::TypedCells& lhs,
+                              const vespalib::eval::TypedCells& rhs) const
+{
+    using vespalib::BFloat16;
+    using vespalib::eval::CellType;
+    size_t sz = lhs.size;
+    assert(sz == rhs.size);
+    double dot_product;
+    if ((lhs.type == CellType::BFLOAT16) && (rhs.type == CellType::BFLOAT16)) {
+        dot_product = _computer.dotProduct(static_cast<const BFloat16 *>(lhs.data),
+                                           static_cast<const BFloat16 *>(rhs.data), sz);
+    } else if ((lhs.type == CellType::BFLOAT16) && (rhs.type == CellType::FLOAT)) {
+        dot_product = _computer.dotProduct(static_cast<const BFloat16 *>(lhs.data),
+                                           static_cast<const float *>(rhs.data), sz);
+    } else if ((lhs.type == CellType::FLOAT) && (rhs.type == CellType::BFLOAT16)) {
+        dot_product = _computer.dotProduct(static_cast<const BFloat16 *>(rhs.data),
+                                           static_cast<const float *>(lhs.data), sz);
+    } else {
+        return AngularDistance::calc(lhs, rhs);
+    }
+    double squared_norms = norm_sq(lhs) * norm_sq(rhs);
+    double div = (squared_norms > 0) ? sqrt(squared_norms) : 1.0;
+    double cosine_similarity = dot_product / div;
+    double distance = 1.0 - cosine_similarity; // in range [0,2]
+    return std::max(0.0, distance);
+}
+
 template class AngularDistanceHW<float>;
 template class AngularDistanceHW<double>;
+template class AngularDistanceHW<vespalib::eval::Int8Float>;
 
 }
@@ -5,6 +5,7 @@
 #include "distance_function.h"
 #include <vespa/eval/eval/typed_cells.h>
 #include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+#include <vespa/vespalib/util/bfloat16.h>
 #include <cmath>
 
 namespace search::tensor {
@@ -58,8 +59,8 @@ public:
         auto rhs_vector = rhs.typify<FloatType>();
         size_t sz = lhs_vector.size();
         assert(sz == rhs_vector.size());
-        auto a = &lhs_vector[0];
-        auto b = &rhs_vector[0];
+        auto a = cast(&lhs_vector[0]);
+        auto b = cast(&rhs_vector[0]);
         double a_norm_sq = _computer.dotProduct(a, a, sz);
         double b_norm_sq = _computer.dotProduct(b, b, sz);
         double squared_norms = a_norm_sq * b_norm_sq;
@@ -70,6 +71,26 @@ public:
         return distance;
     }
 private:
+    static const double *cast(const double * p) { return p; }
+    static const float *cast(const float * p) { return p; }
+    static const int8_t *cast(const vespalib::eval::Int8Float * p) { return reinterpret_cast<const int8_t *>(p); }
+    const vespalib::hwaccelrated::IAccelrated & _computer;
+};
+
+/**
+ * Calculates angular distance between bfloat16 vectors.
+ * Query vectors are kept as float, and both bfloat16-bfloat16 and bfloat16-float
+ * are calculated using instructions optimal for the cpu it is running on.
+ */
+class AngularDistanceBFloat16 : public AngularDistance {
+public:
+    AngularDistanceBFloat16()
+      : AngularDistance(vespalib::eval::CellType::FLOAT),
+        _computer(vespalib::hwaccelrated::IAccelrated::getAccelerator())
+    {}
+    double calc(const vespalib::eval::TypedCells& lhs, const vespalib::eval::TypedCells& rhs) const override;
+private:
+    double norm_sq(const vespalib::eval::TypedCells& cells) const;
     const vespalib::hwaccelrated::IAccelrated & _computer;
 };
 
@@ -37,7 +37,10 @@ DefaultNearestNeighborIndexFactory::make(const DocVectorAccess& vectors,
                           m,
                           params.neighbors_to_explore_at_insert(),
                           10000,
-                          true);
+                          true,
+                          params.quantization(),
+                          QuantizedVectorStore::default_training_size,
+                          params.distance_metric());
     return std::make_unique<HnswIndex>(vectors,
                                        make_distance_function(params.distance_metric(), cell_type),
                                        make_random_level_generator(m),
@@ -45,6 +45,28 @@ SquaredEuclideanDistance::calc_with_limit(const vespalib::eval::TypedCells& lhs,
     return typify_invoke<2,TypifyCellType,CalcEuclidean>(lhs.type, rhs.type, lhs, rhs);
 }
 
+double
+SquaredEuclideanDistanceBFloat16::calc(const vespalib::eval::TypedCells& lhs,
+                                       const vespalib::eval::TypedCells& rhs) const
+{
+    using vespalib::BFloat16;
+    using vespalib::eval::CellType;
+    size_t sz = lhs.size;
+    assert(sz == rhs.size);
+    if (lhs.type == CellType::BFLOAT16) {
+        auto a = static_cast<const BFloat16 *>(lhs.data);
+        if (rhs.type == CellType::BFLOAT16) {
+            return _computer.squaredEuclideanDistance(a, static_cast<const BFloat16 *>(rhs.data), sz);
+        } else if (rhs.type == CellType::FLOAT) {
+            return _computer.squaredEuclideanDistance(a, static_cast<const float *>(rhs.data), sz);
+        }
+    } else if ((lhs.type == CellType::FLOAT) && (rhs.type == CellType::BFLOAT16)) {
+        return _computer.squaredEuclideanDistance(static_cast<const BFloat16 *>(rhs.data),
+                                                  static_cast<const float *>(lhs.data), sz);
+    }
+    return SquaredEuclideanDistance::calc(lhs, rhs);
+}
+
 template class SquaredEuclideanDistanceHW<float>;
 template class SquaredEuclideanDistanceHW<double>;
 
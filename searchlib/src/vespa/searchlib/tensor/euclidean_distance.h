@@ -5,6 +5,7 @@
 #include "distance_function.h"
 #include <vespa/eval/eval/typed_cells.h>
 #include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+#include <vespa/vespalib/util/bfloat16.h>
 #include <cmath>
 
 namespace search::tensor {
@@ -78,4 +79,26 @@ private:
     const vespalib::hwaccelrated::IAccelrated & _computer;
 };
 
+/**
+ * Calculates the square of the standard Euclidean distance for bfloat16 vectors.
+ * Query vectors are kept as float, and both bfloat16-bfloat16 and bfloat16-float
+ * are calculated using instructions optimal for the cpu it is running on.
+ */
+class SquaredEuclideanDistanceBFloat16 : public SquaredEuclideanDistance {
+public:
+    SquaredEuclideanDistanceBFloat16()
+      : SquaredEuclideanDistance(vespalib::eval::CellType::FLOAT),
+        _computer(vespalib::hwaccelrated::IAccelrated::getAccelerator())
+    {}
+    double calc(const vespalib::eval::TypedCells& lhs, const vespalib::eval::TypedCells& rhs) const override;
+    double calc_with_limit(const vespalib::eval::TypedCells& lhs,
+                           const vespalib::eval::TypedCells& rhs,
+                           double) const override
+    {
+        return calc(lhs, rhs);
+    }
+private:
+    const vespalib::hwaccelrated::IAccelrated & _computer;
+};
+
 }
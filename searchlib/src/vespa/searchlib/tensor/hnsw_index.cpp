@@ -28,6 +28,8 @@ namespace search::tensor {
 
 using search::AddressSpaceComponents;
 using search::StateExplorerUtils;
+using search::queryeval::GlobalFilter;
+using search::attribute::VectorQuantization;
 using vespalib::datastore::CompactionStrategy;
 using vespalib::datastore::EntryRef;
 
@@ -61,6 +63,26 @@ bool operator< (const PairDist &a, const PairDist &b) {
     return (a.distance < b.distance);
 }
 
+/**
+ * Populates the quantized vectors of the index when the graph has been loaded.
+ */
+class QuantizingLoader : public NearestNeighborIndexLoader {
+    std::unique_ptr<NearestNeighborIndexLoader> _loader;
+    HnswIndex& _index;
+public:
+    QuantizingLoader(std::unique_ptr<NearestNeighborIndexLoader> loader, HnswIndex& index)
+        : _loader(std::move(loader)),
+          _index(index)
+    {}
+    bool load_next() override {
+        bool more = _loader->load_next();
+        if (!more) {
+            _index.populate_quantized_vectors();
+        }
+        return more;
+    }
+};
+
 }
 
 vespalib::datastore::ArrayStoreConfig
@@ -214,7 +236,7 @@ HnswIndex::calc_distance(const TypedCells& lhs, uint32_t rhs_docid) const
 }
 
 uint32_t
-HnswIndex::estimate_visited_nodes(uint32_t level, uint32_t doc_id_limit, uint32_t neighbors_to_find, const search::BitVector* filter) const
+HnswIndex::estimate_visited_nodes(uint32_t level, uint32_t doc_id_limit, uint32_t neighbors_to_find, const GlobalFilter* filter) const
 {
     uint32_t m_for_level = max_links_for_level(level);
     uint64_t base_estimate = uint64_t(m_for_level) * neighbors_to_find + 100;
@@ -224,7 +246,7 @@ HnswIndex::estimate_visited_nodes(uint32_t level, uint32_t doc_id_limit, uint32_
     if (!filter) {
         return base_estimate;
     }
-    uint32_t true_bits = filter->countTrueBits();
+    uint32_t true_bits = filter->count();
     if (true_bits == 0) {
         return doc_id_limit;
     }
@@ -237,7 +259,7 @@ HnswIndex::estimate_visited_nodes(uint32_t level, uint32_t doc_id_limit, uint32_
 }
 
 HnswCandidate
-HnswIndex::find_nearest_in_layer(const TypedCells& input, const HnswCandidate& entry_point, uint32_t level) const
+HnswIndex::find_nearest_in_layer(const QueryDistance& input, const HnswCandidate& entry_point, uint32_t level) const
 {
     HnswCandidate nearest = entry_point;
     bool keep_searching = true;
@@ -245,7 +267,7 @@ HnswIndex::find_nearest_in_layer(const TypedCells& input, const HnswCandidate& e
         keep_searching = false;
         for (uint32_t neighbor_docid : _graph.get_link_array(nearest.node_ref, level)) {
             auto neighbor_ref = _graph.acquire_node_ref(neighbor_docid);
-            double dist = calc_distance(input, neighbor_docid);
+            double dist = input.calc(neighbor_docid);
             if (_graph.still_valid(neighbor_docid, neighbor_ref)
                 && dist < nearest.distance)
             {
@@ -259,8 +281,8 @@ HnswIndex::find_nearest_in_layer(const TypedCells& input, const HnswCandidate& e
 
 template <class VisitedTracker>
 void
-HnswIndex::search_layer_helper(const TypedCells& input, uint32_t neighbors_to_find,
-                               FurthestPriQ& best_neighbors, uint32_t level, const search::BitVector *filter,
+HnswIndex::search_layer_helper(const QueryDistance& input, uint32_t neighbors_to_find,
+                               FurthestPriQ& best_neighbors, uint32_t level, const GlobalFilter *filter,
                                uint32_t doc_id_limit, uint32_t estimated_visited_nodes) const
 {
     NearestPriQ candidates;
@@ -271,7 +293,7 @@ HnswIndex::search_layer_helper(const TypedCells& input, uint32_t neighbors_to_fi
         }
         candidates.push(entry);
         visited.mark(entry.docid);
-        if (filter && !filter->testBit(entry.docid)) {
+        if (filter && !filter->check(entry.docid)) {
             assert(best_neighbors.size() == 1);
             best_neighbors.pop();
         }
@@ -294,10 +316,10 @@ HnswIndex::search_layer_helper(const TypedCells& input, uint32_t neighbors_to_fi
             {
                 continue;
             }
-            double dist_to_input = calc_distance(input, neighbor_docid);
+            double dist_to_input = input.calc(neighbor_docid);
             if (dist_to_input < limit_dist) {
                 candidates.emplace(neighbor_docid, neighbor_ref, dist_to_input);
-                if ((!filter) || filter->testBit(neighbor_docid)) {
+                if ((!filter) || filter->check(neighbor_docid)) {
                     best_neighbors.emplace(neighbor_docid, neighbor_ref, dist_to_input);
                     if (best_neighbors.size() > neighbors_to_find) {
                         best_neighbors.pop();
@@ -310,8 +332,8 @@ HnswIndex::search_layer_helper(const TypedCells& input, uint32_t neighbors_to_fi
 }
 
 void
-HnswIndex::search_layer(const TypedCells& input, uint32_t neighbors_to_find,
-                        FurthestPriQ& best_neighbors, uint32_t level, const search::BitVector *filter) const
+HnswIndex::search_layer(const QueryDistance& input, uint32_t neighbors_to_find,
+                        FurthestPriQ& best_neighbors, uint32_t level, const GlobalFilter *filter) const
 {
     uint32_t doc_id_limit = _graph.node_refs_size.load(std::memory_order_acquire);
     if (filter) {
@@ -337,9 +359,16 @@ HnswIndex::HnswIndex(const DocVectorAccess& vectors, DistanceFunction::UP distan
       _level_generator(std::move(level_generator)),
       _cfg(cfg),
       _visited_set_pool(),
-      _compaction_spec()
+      _compaction_spec(),
+      _quantized_vectors(QuantizedVectorStore::make(cfg.quantization(), cfg.distance_metric(),
+                                                    _distance_func->expected_cell_type(),
+                                                    cfg.quantization_training_size()))
 {
     assert(_distance_func);
+    if (cfg.quantization() != VectorQuantization::None && !_quantized_vectors) {
+        LOG(warning, "Int8 vector quantization requires non-int8 vectors and euclidean, angular or innerproduct "
+                     "distance metric, using original vectors");
+    }
 }
 
 HnswIndex::~HnswIndex() = default;
@@ -364,11 +393,12 @@ HnswIndex::internal_prepare_add(uint32_t docid, TypedCells input_vector, vespali
         return op;
     }
     int search_level = entry.level;
-    double entry_dist = calc_distance(input_vector, entry.docid);
+    QueryDistance input(*this, input_vector);
+    double entry_dist = input.calc(entry.docid);
     // TODO: check if entry docid/node_ref is still valid here
     HnswCandidate entry_point(entry.docid, entry.node_ref, entry_dist);
     while (search_level > op.max_level) {
-        entry_point = find_nearest_in_layer(input_vector, entry_point, search_level);
+        entry_point = find_nearest_in_layer(input, entry_point, search_level);
         --search_level;
     }
 
@@ -378,7 +408,7 @@ HnswIndex::internal_prepare_add(uint32_t docid, TypedCells input_vector, vespali
 
     // Find neighbors of the added document in each level it should exist in.
     while (search_level >= 0) {
-        search_layer(input_vector, _cfg.neighbors_to_explore_at_construction(), best_neighbors, search_level);
+        search_layer(input, _cfg.neighbors_to_explore_at_construction(), best_neighbors, search_level);
         auto neighbors = select_neighbors(best_neighbors.peek(), _cfg.max_links_on_inserts());
         op.connections[search_level].reserve(neighbors.used.size());
         for (const auto & neighbor : neighbors.used) {
@@ -414,9 +444,36 @@ HnswIndex::filter_valid_docids(uint32_t level, const PreparedAddDoc::Links &neig
     return valid;
 }
 
+void
+HnswIndex::quantize_vector(uint32_t docid)
+{
+    if (!_quantized_vectors) {
+        return;
+    }
+    auto vector = get_vector(docid);
+    if (_quantized_vectors->ready()) {
+        _quantized_vectors->set(docid, vector);
+        return;
+    }
+    _quantized_vectors->add_sample(vector);
+    if (_quantized_vectors->has_enough_samples()) {
+        _quantized_vectors->train();
+        _quantized_vectors->set(docid, vector);
+        uint32_t doc_id_limit = _graph.node_refs_size.load(std::memory_order_relaxed);
+        for (uint32_t id = 1; id < doc_id_limit; ++id) {
+            if (_graph.get_node_ref(id).valid()) {
+                _quantized_vectors->set(id, get_vector(id));
+            }
+        }
+        _quantized_vectors->publish();
+    }
+}
+
 void
 HnswIndex::internal_complete_add(uint32_t docid, PreparedAddDoc &op)
 {
+    // The quantized vector must be in place before the node is reachable by searches
+    quantize_vector(docid);
     auto node_ref = _graph.make_node_for_document(docid, op.max_level + 1);
     for (int level = 0; level <= op.max_level; ++level) {
         auto neighbors = filter_valid_docids(level, op.connections[level], docid);
@@ -517,6 +574,9 @@ HnswIndex::transfer_hold_lists(generation_t current_gen)
     _graph.node_refs.setGeneration(current_gen + 1);
     _graph.nodes.transferHoldLists(current_gen);
     _graph.links.transferHoldLists(current_gen);
+    if (_quantized_vectors) {
+        _quantized_vectors->transfer_hold_lists(current_gen);
+    }
 }
 
 void
@@ -525,6 +585,9 @@ HnswIndex::trim_hold_lists(generation_t first_used_gen)
     _graph.node_refs.removeOldGenerations(first_used_gen);
     _graph.nodes.trimHoldLists(first_used_gen);
     _graph.links.trimHoldLists(first_used_gen);
+    if (_quantized_vectors) {
+        _quantized_vectors->trim_hold_lists(first_used_gen);
+    }
 }
 
 void
@@ -597,6 +660,9 @@ HnswIndex::update_stat(const CompactionStrategy& compaction_strategy)
                                                compaction_strategy.should_compact(link_arrays_memory_usage, link_arrays_address_space_usage));
     result.merge(link_arrays_memory_usage);
     result.merge(_visited_set_pool.memory_usage());
+    if (_quantized_vectors) {
+        result.merge(_quantized_vectors->memory_usage());
+    }
     return result;
 }
 
@@ -608,6 +674,9 @@ HnswIndex::memory_usage() const
     result.merge(_graph.nodes.getMemoryUsage());
     result.merge(_graph.links.getMemoryUsage());
     result.merge(_visited_set_pool.memory_usage());
+    if (_quantized_vectors) {
+        result.merge(_quantized_vectors->memory_usage());
+    }
     return result;
 }
 
@@ -628,6 +697,9 @@ HnswIndex::get_state(const vespalib::slime::Inserter& inserter) const
     StateExplorerUtils::memory_usage_to_slime(_graph.nodes.getMemoryUsage(), memUsageObj.setObject("nodes"));
     StateExplorerUtils::memory_usage_to_slime(_graph.links.getMemoryUsage(), memUsageObj.setObject("links"));
     StateExplorerUtils::memory_usage_to_slime(_visited_set_pool.memory_usage(), memUsageObj.setObject("visited_set_pool"));
+    if (_quantized_vectors) {
+        StateExplorerUtils::memory_usage_to_slime(_quantized_vectors->memory_usage(), memUsageObj.setObject("quantized_vectors"));
+    }
     auto& visitedObj = object.setObject("visited_set");
     visitedObj.setLong("create_count", _visited_set_pool.create_count());
     visitedObj.setLong("reuse_count", _visited_set_pool.reuse_count());
@@ -659,6 +731,13 @@ HnswIndex::get_state(const vespalib::slime::Inserter& inserter) const
     cfgObj.setLong("max_links_on_inserts", _cfg.max_links_on_inserts());
     cfgObj.setLong("neighbors_to_explore_at_construction",
                    _cfg.neighbors_to_explore_at_construction());
+    if (_quantized_vectors) {
+        auto& quantizedObj = object.setObject("quantized_vectors");
+        quantizedObj.setString("quantization",
+                               (_quantized_vectors->quantization() == VectorQuantization::Int8) ? "int8" : "binary");
+        quantizedObj.setBool("ready", _quantized_vectors->ready());
+        quantizedObj.setLong("samples", _quantized_vectors->num_samples());
+    }
 }
 
 void
@@ -685,7 +764,25 @@ HnswIndex::make_loader(FastOS_FileInterface& file)
     assert(get_entry_docid() == 0); // cannot load after index has data
     using ReaderType = FileReader<uint32_t>;
     using LoaderType = HnswIndexLoader<ReaderType>;
-    return std::make_unique<LoaderType>(_graph, std::make_unique<ReaderType>(file));
+    auto loader = std::make_unique<LoaderType>(_graph, std::make_unique<ReaderType>(file));
+    if (_quantized_vectors) {
+        return std::make_unique<QuantizingLoader>(std::move(loader), *this);
+    }
+    return loader;
+}
+
+void
+HnswIndex::populate_quantized_vectors()
+{
+    if (!_quantized_vectors) {
+        return;
+    }
+    uint32_t doc_id_limit = _graph.node_refs_size.load(std::memory_order_relaxed);
+    for (uint32_t docid = 1; docid < doc_id_limit; ++docid) {
+        if (_graph.get_node_ref(docid).valid()) {
+            quantize_vector(docid);
+        }
+    }
 }
 
 struct NeighborsByDocId {
@@ -698,7 +795,7 @@ struct NeighborsByDocId {
 
 std::vector<NearestNeighborIndex::Neighbor>
 HnswIndex::top_k_by_docid(uint32_t k, TypedCells vector,
-                          const BitVector *filter, uint32_t explore_k,
+                          const GlobalFilter *filter, uint32_t explore_k,
                           double distance_threshold) const
 {
     std::vector<Neighbor> result;
@@ -724,14 +821,14 @@ HnswIndex::find_top_k(uint32_t k, TypedCells vector, uint32_t explore_k,
 
 std::vector<NearestNeighborIndex::Neighbor>
 HnswIndex::find_top_k_with_filter(uint32_t k, TypedCells vector,
-                                  const BitVector &filter, uint32_t explore_k,
+                                  const GlobalFilter &filter, uint32_t explore_k,
                                   double distance_threshold) const
 {
     return top_k_by_docid(k, vector, &filter, explore_k, distance_threshold);
 }
 
 FurthestPriQ
-HnswIndex::top_k_candidates(const TypedCells &vector, uint32_t k, const BitVector *filter) const
+HnswIndex::search_graph(const QueryDistance& input, uint32_t k, const GlobalFilter *filter) const
 {
     FurthestPriQ best_neighbors;
     auto entry = _graph.get_entry_node();
@@ -740,18 +837,40 @@ HnswIndex::top_k_candidates(const TypedCells &vector, uint32_t k, const BitVecto
         return best_neighbors;
     }
     int search_level = entry.level;
-    double entry_dist = calc_distance(vector, entry.docid);
+    double entry_dist = input.calc(entry.docid);
     // TODO: check if entry docid/node_ref is still valid here
     HnswCandidate entry_point(entry.docid, entry.node_ref, entry_dist);
     while (search_level > 0) {
-        entry_point = find_nearest_in_layer(vector, entry_point, search_level);
+        entry_point = find_nearest_in_layer(input, entry_point, search_level);
         --search_level;
     }
     best_neighbors.push(entry_point);
-    search_layer(vector, k, best_neighbors, 0, filter);
+    search_layer(input, k, best_neighbors, 0, filter);
     return best_neighbors;
 }
 
+FurthestPriQ
+HnswIndex::rescore(const TypedCells& vector, const FurthestPriQ& candidates) const
+{
+    FurthestPriQ result;
+    for (const auto& candidate : candidates.peek()) {
+        result.emplace(candidate.docid, candidate.node_ref, calc_distance(vector, candidate.docid));
+    }
+    return result;
+}
+
+FurthestPriQ
+HnswIndex::top_k_candidates(const TypedCells &vector, uint32_t k, const GlobalFilter *filter) const
+{
+    if (_quantized_vectors && _quantized_vectors->ready()) {
+        // Traverse the graph using the quantized vectors, then rescore the candidates using the original vectors
+        auto query = _quantized_vectors->make_query(vector);
+        auto candidates = search_graph(QueryDistance(*this, vector, &query), k, filter);
+        return rescore(vector, candidates);
+    }
+    return search_graph(QueryDistance(*this, vector), k, filter);
+}
+
 HnswNode
 HnswIndex::get_node(uint32_t docid) const
 {
@@ -9,8 +9,9 @@
 #include "nearest_neighbor_index.h"
 #include "random_level_generator.h"
 #include "hnsw_graph.h"
+#include "quantized_vector_store.h"
 #include <vespa/eval/eval/typed_cells.h>
-#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/queryeval/global_filter.h>
 #include <vespa/vespalib/datastore/array_store.h>
 #include <vespa/vespalib/datastore/atomic_entry_ref.h>
 #include <vespa/vespalib/datastore/compaction_spec.h>
@@ -42,24 +43,37 @@ public:
         uint32_t _neighbors_to_explore_at_construction;
         uint32_t _min_size_before_two_phase;
         bool _heuristic_select_neighbors;
+        search::attribute::VectorQuantization _quantization;
+        uint32_t _quantization_training_size;
+        search::attribute::DistanceMetric _distance_metric;
 
     public:
         Config(uint32_t max_links_at_level_0_in,
                uint32_t max_links_on_inserts_in,
                uint32_t neighbors_to_explore_at_construction_in,
                uint32_t min_size_before_two_phase_in,
-               bool heuristic_select_neighbors_in)
+               bool heuristic_select_neighbors_in,
+               search::attribute::VectorQuantization quantization_in = search::attribute::VectorQuantization::None,
+               uint32_t quantization_training_size_in = QuantizedVectorStore::default_training_size,
+               search::attribute::DistanceMetric distance_metric_in = search::attribute::DistanceMetric::Euclidean)
             : _max_links_at_level_0(max_links_at_level_0_in),
               _max_links_on_inserts(max_links_on_inserts_in),
               _neighbors_to_explore_at_construction(neighbors_to_explore_at_construction_in),
               _min_size_before_two_phase(min_size_before_two_phase_in),
-              _heuristic_select_neighbors(heuristic_select_neighbors_in)
+              _heuristic_select_neighbors(heuristic_select_neighbors_in),
+              _quantization(quantization_in),
+              _quantization_training_size(quantization_training_size_in),
+              _distance_metric(distance_metric_in)
         {}
         uint32_t max_links_at_level_0() const { return _max_links_at_level_0; }
         uint32_t max_links_on_inserts() const { return _max_links_on_inserts; }
         uint32_t neighbors_to_explore_at_construction() const { return _neighbors_to_explore_at_construction; }
         uint32_t min_size_before_two_phase() const { return _min_size_before_two_phase; }
         bool heuristic_select_neighbors() const { return _heuristic_select_neighbors; }
+        search::attribute::VectorQuantization quantization() const { return _quantization; }
+        uint32_t quantization_training_size() const { return _quantization_training_size; }
+        // Must match the distance function of the index, used by the quantized vectors.
+        search::attribute::DistanceMetric distance_metric() const { return _distance_metric; }
     };
 
     class HnswIndexCompactionSpec {
@@ -93,6 +107,23 @@ protected:
 
     using TypedCells = vespalib::eval::TypedCells;
 
+    /**
+     * Calculates the distance between an input vector and the vectors of documents in the graph.
+     * Uses the quantized vectors if a quantized query is given, otherwise the original vectors.
+     */
+    class QueryDistance {
+        const HnswIndex& _index;
+        TypedCells _input;
+        const QuantizedVectorStore::Query* _quantized;
+    public:
+        QueryDistance(const HnswIndex& index, TypedCells input, const QuantizedVectorStore::Query* quantized = nullptr)
+            : _index(index), _input(input), _quantized(quantized)
+        {}
+        double calc(uint32_t docid) const {
+            return _quantized ? _quantized->calc(docid) : _index.calc_distance(_input, docid);
+        }
+    };
+
     HnswGraph _graph;
     const DocVectorAccess& _vectors;
     DistanceFunction::UP _distance_func;
@@ -100,6 +131,7 @@ protected:
     Config _cfg;
     mutable vespalib::ReusableSetPool _visited_set_pool;
     HnswIndexCompactionSpec _compaction_spec;
+    std::unique_ptr<QuantizedVectorStore> _quantized_vectors;
 
     uint32_t max_links_for_level(uint32_t level) const;
     void add_link_to(uint32_t docid, uint32_t level, const LinkArrayRef& old_links, uint32_t new_link) {
@@ -135,21 +167,24 @@ protected:
 
     double calc_distance(uint32_t lhs_docid, uint32_t rhs_docid) const;
     double calc_distance(const TypedCells& lhs, uint32_t rhs_docid) const;
-    uint32_t estimate_visited_nodes(uint32_t level, uint32_t doc_id_limit, uint32_t neighbors_to_find, const search::BitVector* filter) const;
+    uint32_t estimate_visited_nodes(uint32_t level, uint32_t doc_id_limit, uint32_t neighbors_to_find, const queryeval::GlobalFilter* filter) const;
 
     /**
      * Performs a greedy search in the given layer to find the candidate that is nearest the input vector.
      */
-    HnswCandidate find_nearest_in_layer(const TypedCells& input, const HnswCandidate& entry_point, uint32_t level) const;
+    HnswCandidate find_nearest_in_layer(const QueryDistance& input, const HnswCandidate& entry_point, uint32_t level) const;
     template <class VisitedTracker>
-    void search_layer_helper(const TypedCells& input, uint32_t neighbors_to_find, FurthestPriQ& found_neighbors,
-                             uint32_t level, const search::BitVector *filter,
+    void search_layer_helper(const QueryDistance& input, uint32_t neighbors_to_find, FurthestPriQ& found_neighbors,
+                             uint32_t level, const queryeval::GlobalFilter *filter,
                              uint32_t doc_id_limit,
                              uint32_t estimated_visited_nodes) const;
-    void search_layer(const TypedCells& input, uint32_t neighbors_to_find, FurthestPriQ& found_neighbors,
-                      uint32_t level, const search::BitVector *filter = nullptr) const;
+    void search_layer(const QueryDistance& input, uint32_t neighbors_to_find, FurthestPriQ& found_neighbors,
+                      uint32_t level, const queryeval::GlobalFilter *filter = nullptr) const;
+    FurthestPriQ search_graph(const QueryDistance& input, uint32_t k, const queryeval::GlobalFilter *filter) const;
+    FurthestPriQ rescore(const TypedCells& vector, const FurthestPriQ& candidates) const;
+    void quantize_vector(uint32_t docid);
     std::vector<Neighbor> top_k_by_docid(uint32_t k, TypedCells vector,
-                                         const BitVector *filter, uint32_t explore_k,
+                                         const queryeval::GlobalFilter *filter, uint32_t explore_k,
                                          double distance_threshold) const;
 
     struct PreparedAddDoc : public PrepareResult {
@@ -201,14 +236,21 @@ public:
     std::unique_ptr<NearestNeighborIndexSaver> make_saver() const override;
     std::unique_ptr<NearestNeighborIndexLoader> make_loader(FastOS_FileInterface& file) override;
 
+    /**
+     * Sets the quantized vectors for all documents in the graph.
+     * Called when the graph has been loaded from file.
+     */
+    void populate_quantized_vectors();
+    const QuantizedVectorStore* quantized_vectors() const { return _quantized_vectors.get(); }
+
     std::vector<Neighbor> find_top_k(uint32_t k, TypedCells vector, uint32_t explore_k,
                                      double distance_threshold) const override;
     std::vector<Neighbor> find_top_k_with_filter(uint32_t k, TypedCells vector,
-                                                 const BitVector &filter, uint32_t explore_k,
+                                                 const queryeval::GlobalFilter &filter, uint32_t explore_k,
                                                  double distance_threshold) const override;
     const DistanceFunction *distance_function() const override { return _distance_func.get(); }
 
-    FurthestPriQ top_k_candidates(const TypedCells &vector, uint32_t k, const BitVector *filter) const;
+    FurthestPriQ top_k_candidates(const TypedCells &vector, uint32_t k, const queryeval::GlobalFilter *filter) const;
 
     uint32_t get_entry_docid() const { return _graph.get_entry_node().docid; }
     int32_t get_entry_level() const { return _graph.get_entry_node().level; }
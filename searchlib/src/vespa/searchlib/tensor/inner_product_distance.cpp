@@ -38,7 +38,33 @@ InnerProductDistance::calc(const vespalib::eval::TypedCells& lhs,
     return typify_invoke<2,TypifyCellType,CalcInnerProduct>(lhs.type, rhs.type, lhs, rhs);
 }
 
+double
+InnerProductDistanceBFloat16::calc(const vespalib::eval::TypedCells& lhs,
+                                   const vespalib::eval::TypedCells& rhs) const
+{
+    using vespalib::BFloat16;
+    using vespalib::eval::CellType;
+    size_t sz = lhs.size;
+    assert(sz == rhs.size);
+    double dot_product;
+    if ((lhs.type == CellType::BFLOAT16) && (rhs.type == CellType::BFLOAT16)) {
+        dot_product = _computer.dotProduct(static_cast<const BFloat16 *>(lhs.data),
+                                           static_cast<const BFloat16 *>(rhs.data), sz);
+    } else if ((lhs.type == CellType::BFLOAT16) && (rhs.type == CellType::FLOAT)) {
+        dot_product = _computer.dotProduct(static_cast<const BFloat16 *>(lhs.data),
+                                           static_cast<const float *>(rhs.data), sz);
+    } else if ((lhs.type == CellType::FLOAT) && (rhs.type == CellType::BFLOAT16)) {
+        dot_product = _computer.dotProduct(static_cast<const BFloat16 *>(rhs.data),
+                                           static_cast<const float *>(lhs.data), sz);
+    } else {
+        return InnerProductDistance::calc(lhs, rhs);
+    }
+    double score = 1.0 - dot_product; // in range [0,2]
+    return std::max(0.0, score);
+}
+
 template class InnerProductDistanceHW<float>;
 template class InnerProductDistanceHW<double>;
+template class InnerProductDistanceHW<vespalib::eval::Int8Float>;
 
 }
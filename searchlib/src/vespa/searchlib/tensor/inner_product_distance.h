@@ -5,6 +5,7 @@
 #include "distance_function.h"
 #include <vespa/eval/eval/typed_cells.h>
 #include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+#include <vespa/vespalib/util/bfloat16.h>
 #include <cmath>
 
 namespace search::tensor {
@@ -54,9 +55,28 @@ public:
         auto rhs_vector = rhs.typify<FloatType>();
         size_t sz = lhs_vector.size();
         assert(sz == rhs_vector.size());
-        double score = 1.0 - _computer.dotProduct(&lhs_vector[0], &rhs_vector[0], sz);
+        double score = 1.0 - _computer.dotProduct(cast(&lhs_vector[0]), cast(&rhs_vector[0]), sz);
         return std::max(0.0, score);
     }
+private:
+    static const double *cast(const double * p) { return p; }
+    static const float *cast(const float * p) { return p; }
+    static const int8_t *cast(const vespalib::eval::Int8Float * p) { return reinterpret_cast<const int8_t *>(p); }
+    const vespalib::hwaccelrated::IAccelrated & _computer;
+};
+
+/**
+ * Calculates inner-product "distance" between bfloat16 vectors with assumed norm 1.
+ * Query vectors are kept as float, and both bfloat16-bfloat16 and bfloat16-float
+ * are calculated using instructions optimal for the cpu it is running on.
+ */
+class InnerProductDistanceBFloat16 : public InnerProductDistance {
+public:
+    InnerProductDistanceBFloat16()
+      : InnerProductDistance(vespalib::eval::CellType::FLOAT),
+        _computer(vespalib::hwaccelrated::IAccelrated::getAccelerator())
+    {}
+    double calc(const vespalib::eval::TypedCells& lhs, const vespalib::eval::TypedCells& rhs) const override;
 private:
     const vespalib::hwaccelrated::IAccelrated & _computer;
 };
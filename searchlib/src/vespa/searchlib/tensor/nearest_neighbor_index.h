@@ -22,9 +22,10 @@ namespace search::fileutil { class LoadedBuffer; }
 
 namespace search {
 class AddressSpaceUsage;
-class BitVector;
 }
 
+namespace search::queryeval { class GlobalFilter; }
+
 namespace search::tensor {
 
 class NearestNeighborIndexLoader;
@@ -98,10 +99,10 @@ public:
                                              uint32_t explore_k,
                                              double distance_threshold) const = 0;
 
-    // only return neighbors where the corresponding filter bit is set
+    // only return neighbors accepted by the filter
     virtual std::vector<Neighbor> find_top_k_with_filter(uint32_t k,
                                                          vespalib::eval::TypedCells vector,
-                                                         const BitVector &filter,
+                                                         const queryeval::GlobalFilter &filter,
                                                          uint32_t explore_k,
                                                          double distance_threshold) const = 0;
 
@@ -0,0 +1,250 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "quantized_vector_store.h"
+#include <vespa/eval/eval/int8float.h>
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+#include <vespa/vespalib/util/bfloat16.h>
+#include <vespa/vespalib/util/binary_hamming_distance.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace search::tensor {
+
+using vespalib::eval::CellType;
+using vespalib::hwaccelrated::IAccelrated;
+
+namespace {
+
+constexpr float max_level = 127.0f;
+
+template <typename Func>
+void
+for_each_cell(const vespalib::eval::TypedCells& cells, Func&& func)
+{
+    switch (cells.type) {
+    case CellType::DOUBLE:
+        for (size_t i = 0; i < cells.size; ++i) { func(i, float(cells.unsafe_typify<double>()[i])); }
+        break;
+    case CellType::FLOAT:
+        for (size_t i = 0; i < cells.size; ++i) { func(i, cells.unsafe_typify<float>()[i]); }
+        break;
+    case CellType::BFLOAT16:
+        for (size_t i = 0; i < cells.size; ++i) { func(i, cells.unsafe_typify<vespalib::BFloat16>()[i].to_float()); }
+        break;
+    case CellType::INT8:
+        for (size_t i = 0; i < cells.size; ++i) { func(i, cells.unsafe_typify<vespalib::eval::Int8Float>()[i].to_float()); }
+        break;
+    }
+}
+
+const int8_t*
+as_levels(const uint8_t* code) noexcept
+{
+    return reinterpret_cast<const int8_t*>(code);
+}
+
+}
+
+QuantizedVectorStore::Query::Query(const QuantizedVectorStore& store, TypedCells input)
+    : _store(store),
+      _input_code(store._code_size),
+      _input_norm_sq(0.0)
+{
+    _store.encode(input, _input_code.data());
+    if (_store._quantization == VectorQuantization::Int8 && _store._distance_metric == DistanceMetric::Angular) {
+        auto levels = as_levels(_input_code.data());
+        _input_norm_sq = _store._computer.dotProduct(levels, levels, _store._dims);
+    }
+}
+
+QuantizedVectorStore::Query::Query(Query&&) noexcept = default;
+QuantizedVectorStore::Query::~Query() = default;
+
+double
+QuantizedVectorStore::Query::calc(uint32_t docid) const
+{
+    const uint8_t* code = _store.get_code(docid);
+    if (_store._quantization == VectorQuantization::Binary) {
+        return vespalib::binary_hamming_distance(_input_code.data(), code, _store._code_size);
+    }
+    const IAccelrated& computer = _store._computer;
+    const int8_t* a = as_levels(_input_code.data());
+    const int8_t* b = as_levels(code);
+    double scale_sq = double(_store._scale) * _store._scale;
+    switch (_store._distance_metric) {
+    case DistanceMetric::Euclidean:
+        return scale_sq * computer.squaredEuclideanDistance(a, b, _store._dims);
+    case DistanceMetric::InnerProduct:
+        return std::max(0.0, 1.0 - scale_sq * computer.dotProduct(a, b, _store._dims));
+    default: {
+        // Angular, the scale does not affect the angle between the vectors
+        double squared_norms = _input_norm_sq * computer.dotProduct(b, b, _store._dims);
+        double div = (squared_norms > 0) ? std::sqrt(squared_norms) : 1.0;
+        return 1.0 - computer.dotProduct(a, b, _store._dims) / div;
+    }
+    }
+}
+
+QuantizedVectorStore::QuantizedVectorStore(VectorQuantization quantization, DistanceMetric distance_metric, uint32_t training_size)
+    : _quantization(quantization),
+      _distance_metric(distance_metric),
+      _training_size(std::max(training_size, 1u)),
+      _num_samples(0),
+      _dims(0),
+      _code_size(0),
+      _min(),
+      _max(),
+      _offset(),
+      _scale(1.0f),
+      _codes(),
+      _ready(false),
+      _computer(IAccelrated::getAccelerator())
+{
+    assert(_quantization != VectorQuantization::None);
+}
+
+QuantizedVectorStore::~QuantizedVectorStore() = default;
+
+std::unique_ptr<QuantizedVectorStore>
+QuantizedVectorStore::make(VectorQuantization quantization, DistanceMetric distance_metric, CellType cell_type, uint32_t training_size)
+{
+    switch (quantization) {
+    case VectorQuantization::None:
+        return {};
+    case VectorQuantization::Int8:
+        // Distances on the 8-bit levels are only calculated for these metrics, and int8 vectors are already compact
+        if (cell_type == CellType::INT8) {
+            return {};
+        }
+        if (distance_metric != DistanceMetric::Euclidean && distance_metric != DistanceMetric::Angular &&
+            distance_metric != DistanceMetric::InnerProduct)
+        {
+            return {};
+        }
+        break;
+    case VectorQuantization::Binary:
+        break;
+    }
+    return std::make_unique<QuantizedVectorStore>(quantization, distance_metric, training_size);
+}
+
+void
+QuantizedVectorStore::init_dims(uint32_t dims)
+{
+    if (_dims != 0) {
+        assert(dims == _dims);
+        return;
+    }
+    _dims = dims;
+    _code_size = (_quantization == VectorQuantization::Binary) ? (dims + 7) / 8 : dims;
+    _min.assign(dims, std::numeric_limits<float>::max());
+    _max.assign(dims, std::numeric_limits<float>::lowest());
+}
+
+void
+QuantizedVectorStore::add_sample(TypedCells vector)
+{
+    init_dims(vector.size);
+    if (_quantization == VectorQuantization::Int8) {
+        for_each_cell(vector, [this](size_t i, float value) {
+            _min[i] = std::min(_min[i], value);
+            _max[i] = std::max(_max[i], value);
+        });
+    }
+    ++_num_samples;
+}
+
+bool
+QuantizedVectorStore::has_enough_samples() const noexcept
+{
+    if (_quantization == VectorQuantization::Binary) {
+        return _num_samples > 0;
+    }
+    return _num_samples >= _training_size;
+}
+
+void
+QuantizedVectorStore::train()
+{
+    assert(_dims != 0);
+    if (_quantization != VectorQuantization::Int8) {
+        return;
+    }
+    // The scale is shared by all dimensions, so distances can be calculated directly on the levels
+    _offset.assign(_dims, 0.0f);
+    float max_extent = 0.0f;
+    for (uint32_t i = 0; i < _dims; ++i) {
+        float extent;
+        if (_distance_metric == DistanceMetric::Euclidean) {
+            extent = (_max[i] - _min[i]) / 2;
+            if (std::isfinite(extent)) {
+                _offset[i] = _min[i] + extent;
+            }
+        } else {
+            extent = std::max(std::abs(_min[i]), std::abs(_max[i]));
+        }
+        if (std::isfinite(extent)) {
+            max_extent = std::max(max_extent, extent);
+        }
+    }
+    _scale = (max_extent > 0.0f) ? (max_extent / max_level) : 1.0f;
+}
+
+void
+QuantizedVectorStore::encode(TypedCells vector, uint8_t* dst) const
+{
+    if (_quantization == VectorQuantization::Binary) {
+        std::fill(dst, dst + _code_size, 0);
+        for_each_cell(vector, [dst](size_t i, float value) {
+            if (value > 0.0f) {
+                dst[i / 8] |= uint8_t(1u << (i % 8));
+            }
+        });
+        return;
+    }
+    for_each_cell(vector, [this, dst](size_t i, float value) {
+        float level = std::nearbyint((value - _offset[i]) / _scale);
+        dst[i] = uint8_t(int8_t(std::clamp(level, -max_level, max_level)));
+    });
+}
+
+void
+QuantizedVectorStore::set(uint32_t docid, TypedCells vector)
+{
+    init_dims(vector.size);
+    size_t offset = size_t(docid) * _code_size;
+    _codes.ensure_size(offset + _code_size, 0);
+    encode(vector, &_codes[offset]);
+}
+
+QuantizedVectorStore::Query
+QuantizedVectorStore::make_query(TypedCells input) const
+{
+    return Query(*this, input);
+}
+
+void
+QuantizedVectorStore::transfer_hold_lists(generation_t current_gen)
+{
+    _codes.setGeneration(current_gen + 1);
+}
+
+void
+QuantizedVectorStore::trim_hold_lists(generation_t first_used_gen)
+{
+    _codes.removeOldGenerations(first_used_gen);
+}
+
+vespalib::MemoryUsage
+QuantizedVectorStore::memory_usage() const
+{
+    vespalib::MemoryUsage result = _codes.getMemoryUsage();
+    size_t ranges = sizeof(float) * (_min.capacity() + _max.capacity() + _offset.capacity());
+    result.incAllocatedBytes(ranges);
+    result.incUsedBytes(ranges);
+    return result;
+}
+
+}
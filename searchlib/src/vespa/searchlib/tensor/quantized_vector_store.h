@@ -0,0 +1,119 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/eval/typed_cells.h>
+#include <vespa/searchcommon/attribute/distance_metric.h>
+#include <vespa/searchcommon/attribute/vector_quantization.h>
+#include <vespa/vespalib/util/generationhandler.h>
+#include <vespa/vespalib/util/memoryusage.h>
+#include <vespa/vespalib/util/rcuvector.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace vespalib::hwaccelrated { class IAccelrated; }
+
+namespace search::tensor {
+
+/**
+ * Stores a compact, quantized copy of the vectors in a nearest neighbor index.
+ *
+ * The quantized vectors are used when traversing the graph during search, which
+ * reduces the memory bandwidth needed per distance calculation. The resulting
+ * candidates must be rescored using the original vectors.
+ *
+ * Int8: Each dimension is mapped to a signed 8-bit level using a per-dimension offset and
+ *       a scale shared by all dimensions. The ranges are trained on the first vectors added,
+ *       and values outside the trained range are clamped. The query vector is quantized the
+ *       same way, and distances are calculated directly on the 8-bit levels using the int8
+ *       kernels of IAccelrated. Supported for the euclidean, angular and innerproduct
+ *       distance metrics. The offset is 0 for angular and innerproduct, as the levels must
+ *       keep the direction of the vectors.
+ * Binary: Each dimension is stored as a single sign bit, and the distance is the
+ *         hamming distance between the sign bits of the query and the document.
+ *
+ * The quantized vectors are not used before the store is ready, which for Int8 happens
+ * after training. Supports 1 write thread and multiple search threads: the quantized
+ * vector for a document must be set before the document is linked into the graph.
+ */
+class QuantizedVectorStore {
+public:
+    using generation_t = vespalib::GenerationHandler::generation_t;
+    using TypedCells = vespalib::eval::TypedCells;
+    using DistanceMetric = search::attribute::DistanceMetric;
+    using VectorQuantization = search::attribute::VectorQuantization;
+
+    static constexpr uint32_t default_training_size = 1000;
+
+    /**
+     * Calculates distances between a query vector and quantized document vectors.
+     * An instance is used by a single search thread.
+     */
+    class Query {
+        const QuantizedVectorStore& _store;
+        std::vector<uint8_t>        _input_code;
+        double                      _input_norm_sq;
+    public:
+        Query(const QuantizedVectorStore& store, TypedCells input);
+        Query(Query&&) noexcept;
+        ~Query();
+        double calc(uint32_t docid) const;
+    };
+
+private:
+    using CodeVector = vespalib::RcuVector<uint8_t>;
+
+    VectorQuantization  _quantization;
+    DistanceMetric      _distance_metric;
+    uint32_t            _training_size;
+    uint32_t            _num_samples;
+    uint32_t            _dims;
+    size_t              _code_size;
+    std::vector<float>  _min;
+    std::vector<float>  _max;
+    std::vector<float>  _offset;
+    float               _scale;
+    CodeVector          _codes;
+    std::atomic<bool>   _ready;
+    const vespalib::hwaccelrated::IAccelrated& _computer;
+
+    void init_dims(uint32_t dims);
+    void encode(TypedCells vector, uint8_t* dst) const;
+    const uint8_t* get_code(uint32_t docid) const {
+        return &_codes.acquire_elem_ref(size_t(docid) * _code_size);
+    }
+
+public:
+    QuantizedVectorStore(VectorQuantization quantization, DistanceMetric distance_metric, uint32_t training_size);
+    ~QuantizedVectorStore();
+
+    /**
+     * Creates a store for the given quantization, or nullptr if quantization is
+     * disabled or not supported for the given distance metric and cell type.
+     */
+    static std::unique_ptr<QuantizedVectorStore> make(VectorQuantization quantization,
+                                                      DistanceMetric distance_metric,
+                                                      vespalib::eval::CellType cell_type,
+                                                      uint32_t training_size);
+
+    VectorQuantization quantization() const noexcept { return _quantization; }
+    bool ready() const noexcept { return _ready.load(std::memory_order_acquire); }
+    uint32_t num_samples() const noexcept { return _num_samples; }
+
+    // Used by the write thread before the store is ready.
+    void add_sample(TypedCells vector);
+    bool has_enough_samples() const noexcept;
+    void train();
+    // Marks the store as ready after all vectors in the graph have been set.
+    void publish() { _ready.store(true, std::memory_order_release); }
+
+    void set(uint32_t docid, TypedCells vector);
+    Query make_query(TypedCells input) const;
+
+    void transfer_hold_lists(generation_t current_gen);
+    void trim_hold_lists(generation_t first_used_gen);
+    vespalib::MemoryUsage memory_usage() const;
+};
+
+}
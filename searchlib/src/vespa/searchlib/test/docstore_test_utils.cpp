@@ -0,0 +1,33 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "docstore_test_utils.h"
+#include <vespa/vespalib/util/stringfmt.h>
+
+using vespalib::compression::ZStdDictionary;
+
+namespace search::test {
+
+vespalib::string
+makeDocument(uint32_t id)
+{
+    return vespalib::make_string("{\"id\":\"id:music:album::%u\",\"fields\":{\"title\":\"Album number %u\","
+                                 "\"artist\":\"Artist %u\",\"year\":%u,\"genre\":\"%s\",\"tracks\":%u,"
+                                 "\"label\":\"Label %u\",\"formats\":[\"cd\",\"vinyl\",\"stream\"]}}",
+                                 id, id, id % 97, 1950 + id % 70, (id % 3 == 0) ? "rock" : "jazz",
+                                 5 + id % 11, id % 13);
+}
+
+ZStdDictionary::SP
+trainDictionary(uint32_t firstId, size_t numDocs, size_t maxSize)
+{
+    vespalib::string samples;
+    std::vector<size_t> sampleSizes;
+    for (uint32_t id(firstId); id < firstId + numDocs; id++) {
+        vespalib::string doc = makeDocument(id);
+        samples.append(doc);
+        sampleSizes.push_back(doc.size());
+    }
+    return ZStdDictionary::train(vespalib::ConstBufferRef(samples.data(), samples.size()), sampleSizes, maxSize);
+}
+
+}
@@ -0,0 +1,22 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
+
+namespace search::test {
+
+/**
+ * Returns a small json document, similar to other documents with nearby ids.
+ * Used to test compression of document store chunks.
+ */
+vespalib::string makeDocument(uint32_t id);
+
+/**
+ * Train a zstd dictionary of at most maxSize bytes from the documents with
+ * ids in [firstId, firstId + numDocs).
+ */
+vespalib::compression::ZStdDictionary::SP trainDictionary(uint32_t firstId, size_t numDocs, size_t maxSize);
+
+}
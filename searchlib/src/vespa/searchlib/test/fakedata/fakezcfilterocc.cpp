@@ -173,6 +173,8 @@ FakeZcFilterOcc::setupT(const FakeWord &fw)
     params.set("minChunkDocs", _posting_params._min_chunk_docs); // Control chunking
     params.set("minSkipDocs", _posting_params._min_skip_docs);   // Control skip info
     params.set("interleaved_features", _posting_params._encode_interleaved_features);
+    params.set("block_max", _posting_params._encode_block_max);
+    params.set("block_doc_ids", _posting_params._encode_block_doc_ids);
     writer.set_posting_list_params(params);
     auto &writeContext = writer.get_write_context();
     search::ComprBuffer &cb = writeContext;
@@ -791,7 +793,7 @@ class FakeZc4SkipPosOccCf : public FakeZc4SkipPosOcc<bigEndian>
 {
 public:
     FakeZc4SkipPosOccCf(const FakeWord &fw)
-        : FakeZc4SkipPosOcc<bigEndian>(fw, Zc4PostingParams(force_skip, disable_chunking, fw._docIdLimit, false, true, true),
+        : FakeZc4SkipPosOcc<bigEndian>(fw, Zc4PostingParams(force_skip, disable_chunking, fw._docIdLimit, false, true, true, true),
                                        (bigEndian ? ".zc4skipposoccbe.cf" : ".zc4skipposoccle.cf"))
     {
     }
@@ -801,7 +803,7 @@ class FakeZc4SkipPosOccCfNoNormalUnpack : public FakeZc4SkipPosOcc<true>
 {
 public:
     FakeZc4SkipPosOccCfNoNormalUnpack(const FakeWord &fw)
-        : FakeZc4SkipPosOcc<true>(fw, Zc4PostingParams(force_skip, disable_chunking, fw._docIdLimit, false, true, true),
+        : FakeZc4SkipPosOcc<true>(fw, Zc4PostingParams(force_skip, disable_chunking, fw._docIdLimit, false, true, true, true),
                                   ".zc4skipposoccbe.cf.nnu")
     {
         _unpack_normal_features = false;
@@ -812,7 +814,7 @@ class FakeZc4SkipPosOccCfNoCheapUnpack : public FakeZc4SkipPosOcc<true>
 {
 public:
     FakeZc4SkipPosOccCfNoCheapUnpack(const FakeWord &fw)
-        : FakeZc4SkipPosOcc<true>(fw, Zc4PostingParams(force_skip, disable_chunking, fw._docIdLimit, false, true, true),
+        : FakeZc4SkipPosOcc<true>(fw, Zc4PostingParams(force_skip, disable_chunking, fw._docIdLimit, false, true, true, true),
                                   ".zc4skipposoccbe.cf.ncu")
     {
         _unpack_interleaved_features = false;
@@ -863,6 +865,39 @@ public:
     }
 };
 
+template <bool bigEndian>
+class FakeZc4BlockPosOcc : public FakeZc4SkipPosOcc<bigEndian>
+{
+public:
+    FakeZc4BlockPosOcc(const FakeWord &fw)
+        : FakeZc4SkipPosOcc<bigEndian>(fw, Zc4PostingParams(force_skip, disable_chunking, fw._docIdLimit, false, true, false, false, true),
+                                       (bigEndian ? ".zc4blockposoccbe" : ".zc4blockposoccle"))
+    {
+    }
+};
+
+template <bool bigEndian>
+class FakeZc4BlockPosOccCf : public FakeZc4SkipPosOcc<bigEndian>
+{
+public:
+    FakeZc4BlockPosOccCf(const FakeWord &fw)
+        : FakeZc4SkipPosOcc<bigEndian>(fw, Zc4PostingParams(force_skip, disable_chunking, fw._docIdLimit, false, true, true, true, true),
+                                       (bigEndian ? ".zc4blockposoccbe.cf" : ".zc4blockposoccle.cf"))
+    {
+    }
+};
+
+class FakeZc4BlockPosOccCfNoNormalUnpack : public FakeZc4SkipPosOcc<true>
+{
+public:
+    FakeZc4BlockPosOccCfNoNormalUnpack(const FakeWord &fw)
+        : FakeZc4SkipPosOcc<true>(fw, Zc4PostingParams(force_skip, disable_chunking, fw._docIdLimit, false, true, true, true, true),
+                                  ".zc4blockposoccbe.cf.nnu")
+    {
+        _unpack_normal_features = false;
+    }
+};
+
 static FPFactoryInit
 initPosbe(std::make_pair("EGCompr64PosOccBE",
                          makeFPFactory<FPFactoryT<FakeEGCompr64PosOcc<true> > >));
@@ -950,4 +985,24 @@ static FPFactoryInit
 initNoSkipPoslecf(std::make_pair("Zc5NoSkipPosOccLE.cf",
                                  makeFPFactory<FPFactoryT<FakeZc5NoSkipPosOccCf<false> > >));
 
+static FPFactoryInit
+initBlockPos0be(std::make_pair("Zc4BlockPosOccBE",
+                               makeFPFactory<FPFactoryT<FakeZc4BlockPosOcc<true> > >));
+
+static FPFactoryInit
+initBlockPos0le(std::make_pair("Zc4BlockPosOccLE",
+                               makeFPFactory<FPFactoryT<FakeZc4BlockPosOcc<false> > >));
+
+static FPFactoryInit
+initBlockPos0becf(std::make_pair("Zc4BlockPosOccBE.cf",
+                                 makeFPFactory<FPFactoryT<FakeZc4BlockPosOccCf<true> > >));
+
+static FPFactoryInit
+initBlockPos0lecf(std::make_pair("Zc4BlockPosOccLE.cf",
+                                 makeFPFactory<FPFactoryT<FakeZc4BlockPosOccCf<false> > >));
+
+static FPFactoryInit
+initBlockPos0becfnnu(std::make_pair("Zc4BlockPosOccBE.cf.nnu",
+                                    makeFPFactory<FPFactoryT<FakeZc4BlockPosOccCfNoNormalUnpack> >));
+
 }
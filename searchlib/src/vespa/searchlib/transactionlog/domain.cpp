@@ -2,6 +2,7 @@
 
 #include "domain.h"
 #include "domainpart.h"
+#include "groupcommitter.h"
 #include "session.h"
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/io/fileutil.h>
@@ -14,6 +15,7 @@
 #include <thread>
 #include <cassert>
 #include <future>
+#include <iterator>
 
 #include <vespa/log/log.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
@@ -37,11 +39,13 @@ createCommitChunk(const DomainConfig &cfg) {
 }
 
 Domain::Domain(const string &domainName, const string & baseDir, vespalib::Executor & executor,
-               const DomainConfig & cfg, const FileHeaderContext &fileHeaderContext)
+               const DomainConfig & cfg, const FileHeaderContext &fileHeaderContext,
+               std::shared_ptr<GroupCommitter> groupCommitter)
     : _config(cfg),
       _currentChunk(createCommitChunk(cfg)),
       _lastSerial(0),
       _singleCommitter(std::make_unique<vespalib::ThreadStackExecutor>(1, 128_Ki)),
+      _groupCommitter(std::move(groupCommitter)),
       _executor(executor),
       _sessionId(1),
       _name(domainName),
@@ -51,6 +55,7 @@ Domain::Domain(const string &domainName, const string & baseDir, vespalib::Execu
       _sessionMutex(),
       _sessions(),
       _maxSessionRunTime(),
+      _commitLatency(),
       _baseDir(baseDir),
       _fileHeaderContext(fileHeaderContext),
       _markedDeleted(false)
@@ -117,6 +122,9 @@ Domain::~Domain() {
     vespalib::Gate gate;
     _singleCommitter->execute(makeLambdaTask([callback=std::make_unique<vespalib::GateCallback>(gate)]() { (void) callback;}));
     gate.await();
+    if (_groupCommitter) {
+        _groupCommitter->drain();
+    }
 }
 
 DomainInfo
@@ -124,6 +132,7 @@ Domain::getDomainInfo() const
 {
     std::unique_lock guard(_partsMutex);
     DomainInfo info(SerialNumRange(begin(guard), end(guard)), size(guard), byteSize(guard), _maxSessionRunTime);
+    info.commitLatency = _commitLatency;
     for (const auto &entry: _parts) {
         const DomainPart &part = *entry.second;
         info.parts.emplace_back(PartInfo(part.range(), part.size(), part.byteSize(), part.fileName()));
@@ -214,9 +223,12 @@ Domain::triggerSyncNow(std::unique_ptr<vespalib::IDestructorCallback> after_sync
         std::unique_lock guard(_currentChunkMutex);
         commitAndTransferResponses(guard);
     }
-    _singleCommitter->execute(makeLambdaTask([this, after_sync=std::move(after_sync)]() {
-        (void) after_sync;
-        getActivePart()->sync();
+    _singleCommitter->execute(makeLambdaTask([this, after_sync=std::move(after_sync)]() mutable {
+        if (_groupCommitter) {
+            _groupCommitter->sync(*this, std::move(after_sync));
+        } else {
+            getActivePart()->sync();
+        }
     }));
 }
 
@@ -371,7 +383,11 @@ Domain::commitChunk(std::unique_ptr<CommitChunk> chunk, const UniqueLock & chunk
         promise.set_value(SerializedChunk(std::move(chunk), encoding, compressionLevel));
     }));
     _singleCommitter->execute( makeLambdaTask([this, future = std::move(future)]() mutable {
-        doCommit(future.get());
+        if (_groupCommitter) {
+            _groupCommitter->commit(*this, future.get());
+        } else {
+            doCommit(future.get());
+        }
     }));
 }
 
@@ -391,6 +407,37 @@ Domain::doCommit(const SerializedChunk & serialized) {
         serialized.getNumCallBacks(), serialized.getNumEntries(), serialized.getData().size());
 }
 
+void
+Domain::commitGroup(std::vector<SerializedChunk> chunks, const std::vector<vespalib::steady_time> & queued, bool forceSync)
+{
+    DomainPart::SP dp = getActivePart();
+    std::vector<SerializedChunk> committed;
+    committed.reserve(chunks.size());
+    for (size_t i = 0; i < chunks.size(); ) {
+        // Split the group where committing chunk by chunk would have rotated the file.
+        dp = optionallyRotateFile(chunks[i].range().from());
+        size_t partSize = dp->byteSize();
+        std::vector<SerializedChunk> batch;
+        do {
+            partSize += chunks[i].getData().size();
+            batch.push_back(std::move(chunks[i++]));
+        } while ((i < chunks.size()) && (partSize <= _config.getPartSizeLimit()));
+        dp->commit(batch);
+        std::move(batch.begin(), batch.end(), std::back_inserter(committed));
+    }
+    if (forceSync || (!committed.empty() && _config.getFSyncOnCommit())) {
+        dp->sync();
+    }
+    cleanSessions();
+    LOG(debug, "Releasing acks for %zu chunks.", committed.size());
+    committed.clear();
+    vespalib::steady_time now = vespalib::steady_clock::now();
+    std::lock_guard guard(_partsMutex);
+    for (vespalib::steady_time t : queued) {
+        _commitLatency.add(now - t);
+    }
+}
+
 bool
 Domain::erase(SerialNum to)
 {
@@ -11,6 +11,7 @@ namespace search::common { class FileHeaderContext; }
 namespace search::transactionlog {
 
 class DomainPart;
+class GroupCommitter;
 class Session;
 
 class Domain : public Writer
@@ -20,7 +21,8 @@ public:
     using DomainPartSP = std::shared_ptr<DomainPart>;
     using FileHeaderContext = common::FileHeaderContext;
     Domain(const vespalib::string &name, const vespalib::string &baseDir, vespalib::Executor & executor,
-           const DomainConfig & cfg, const FileHeaderContext &fileHeaderContext);
+           const DomainConfig & cfg, const FileHeaderContext &fileHeaderContext,
+           std::shared_ptr<GroupCommitter> groupCommitter);
 
     ~Domain() override;
 
@@ -54,6 +56,12 @@ public:
     }
     uint64_t size() const;
     Domain & setConfig(const DomainConfig & cfg);
+
+    /**
+     * Called by the group committer with the chunks queued for this domain
+     * since the previous round, in commit order.
+     */
+    void commitGroup(std::vector<SerializedChunk> chunks, const std::vector<vespalib::steady_time> & queued, bool forceSync);
 private:
     using UniqueLock = std::unique_lock<std::mutex>;
     DomainPartSP getActivePart();
@@ -86,6 +94,7 @@ private:
     std::unique_ptr<CommitChunk> _currentChunk;
     SerialNum                    _lastSerial;
     std::unique_ptr<Executor>    _singleCommitter;
+    std::shared_ptr<GroupCommitter> _groupCommitter;
     Executor                    &_executor;
     std::atomic<int>             _sessionId;
     vespalib::string             _name;
@@ -95,6 +104,7 @@ private:
     mutable std::mutex           _sessionMutex;
     SessionList                  _sessions;
     DurationSeconds              _maxSessionRunTime;
+    LatencyHistogram             _commitLatency;
     vespalib::string             _baseDir;
     const FileHeaderContext     &_fileHeaderContext;
     bool                         _markedDeleted;
@@ -2,6 +2,7 @@
 
 #include "domainconfig.h"
 #include <vespa/vespalib/util/exceptions.h>
+#include <algorithm>
 
 namespace search::transactionlog {
 
@@ -9,6 +10,8 @@ DomainConfig::DomainConfig()
     : _encoding(Encoding::Crc::xxh64, Encoding::Compression::zstd),
       _compressionLevel(9),
       _fSyncOnCommit(false),
+      _groupCommit(false),
+      _groupCommitInterval(vespalib::duration::zero()),
       _partSizeLimit(0x10000000), // 256M
       _chunkSizeLimit(0x40000)   // 256k
 { }
@@ -22,4 +25,34 @@ DomainConfig::setEncoding(Encoding v) {
     return *this;
 }
 
+LatencyHistogram::LatencyHistogram() noexcept
+    : _buckets(),
+      _count(0),
+      _total(duration::zero()),
+      _max(duration::zero())
+{ }
+
+void
+LatencyHistogram::add(duration latency) noexcept {
+    uint64_t us = std::max(int64_t(0), vespalib::count_us(latency));
+    size_t bucket = 0;
+    while ((bucket + 1 < num_buckets) && (us >= (uint64_t(1) << bucket))) {
+        ++bucket;
+    }
+    ++_buckets[bucket];
+    ++_count;
+    _total += latency;
+    _max = std::max(_max, latency);
+}
+
+void
+LatencyHistogram::merge(const LatencyHistogram & rhs) noexcept {
+    for (size_t i = 0; i < num_buckets; ++i) {
+        _buckets[i] += rhs._buckets[i];
+    }
+    _count += rhs._count;
+    _total += rhs._total;
+    _max = std::max(_max, rhs._max);
+}
+
 }
@@ -3,6 +3,7 @@
 
 #include "ichunk.h"
 #include <vespa/vespalib/util/time.h>
+#include <array>
 #include <map>
 
 namespace search::transactionlog {
@@ -16,15 +17,21 @@ public:
     DomainConfig & setChunkSizeLimit(size_t v)      { _chunkSizeLimit = v; return *this; }
     DomainConfig & setCompressionLevel(uint8_t v)   { _compressionLevel = v; return *this; }
     DomainConfig & setFSyncOnCommit(bool v)         { _fSyncOnCommit = v; return *this; }
+    DomainConfig & setGroupCommit(bool v)           { _groupCommit = v; return *this; }
+    DomainConfig & setGroupCommitInterval(duration v) { _groupCommitInterval = v; return *this; }
     Encoding          getEncoding() const { return _encoding; }
     size_t       getPartSizeLimit() const { return _partSizeLimit; }
     size_t      getChunkSizeLimit() const { return _chunkSizeLimit; }
     uint8_t   getCompressionlevel() const { return _compressionLevel; }
     bool         getFSyncOnCommit() const { return _fSyncOnCommit; }
+    bool           getGroupCommit() const { return _groupCommit; }
+    duration getGroupCommitInterval() const { return _groupCommitInterval; }
 private:
     Encoding     _encoding;
     uint8_t      _compressionLevel;
     bool         _fSyncOnCommit;
+    bool         _groupCommit;
+    duration     _groupCommitInterval;
     size_t       _partSizeLimit;
     size_t       _chunkSizeLimit;
 };
@@ -42,6 +49,32 @@ struct PartInfo {
     {}
 };
 
+/**
+ * Histogram of commit latencies using power of two buckets, where
+ * bucket i counts latencies below 2^i microseconds. The last bucket
+ * also counts everything above.
+ */
+class LatencyHistogram {
+public:
+    using duration = vespalib::duration;
+    static constexpr size_t num_buckets = 32;
+    LatencyHistogram() noexcept;
+    void add(duration latency) noexcept;
+    void merge(const LatencyHistogram & rhs) noexcept;
+    size_t count() const noexcept { return _count; }
+    duration total() const noexcept { return _total; }
+    duration max() const noexcept { return _max; }
+    size_t bucketCount(size_t bucket) const noexcept { return _buckets[bucket]; }
+    static duration bucketLimit(size_t bucket) noexcept {
+        return std::chrono::microseconds(uint64_t(1) << bucket);
+    }
+private:
+    std::array<size_t, num_buckets> _buckets;
+    size_t                          _count;
+    duration                        _total;
+    duration                        _max;
+};
+
 struct DomainInfo {
     using DurationSeconds = std::chrono::duration<double>;
     SerialNumRange range;
@@ -49,10 +82,11 @@ struct DomainInfo {
     size_t byteSize;
     DurationSeconds maxSessionRunTime;
     std::vector<PartInfo> parts;
+    LatencyHistogram commitLatency;
     DomainInfo(SerialNumRange range_in, size_t numEntries_in, size_t byteSize_in, DurationSeconds maxSessionRunTime_in)
-            : range(range_in), numEntries(numEntries_in), byteSize(byteSize_in), maxSessionRunTime(maxSessionRunTime_in), parts() {}
+            : range(range_in), numEntries(numEntries_in), byteSize(byteSize_in), maxSessionRunTime(maxSessionRunTime_in), parts(), commitLatency() {}
     DomainInfo()
-            : range(), numEntries(0), byteSize(0), maxSessionRunTime(), parts() {}
+            : range(), numEntries(0), byteSize(0), maxSessionRunTime(), parts(), commitLatency() {}
 };
 
 using DomainStats = std::map<vespalib::string, DomainInfo>;
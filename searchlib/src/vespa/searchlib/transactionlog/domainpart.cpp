@@ -399,6 +399,43 @@ DomainPart::commit(const SerializedChunk & serialized)
     _skipList.emplace_back(range.from(), firstPos);
 }
 
+void
+DomainPart::commit(const std::vector<SerializedChunk> & chunks)
+{
+    if (chunks.empty()) {
+        return;
+    }
+    SerialNumRange range(chunks.front().range().from(), chunks.back().range().to());
+    size_t numEntries(0);
+    size_t numBytes(0);
+    for (const SerializedChunk & chunk : chunks) {
+        numEntries += chunk.getNumEntries();
+        numBytes += chunk.getData().size();
+    }
+    // Coalesce all chunks into one buffer so they hit the file with a single write.
+    std::vector<char> buf;
+    buf.reserve(numBytes);
+    for (const SerializedChunk & chunk : chunks) {
+        vespalib::ConstBufferRef data = chunk.getData();
+        buf.insert(buf.end(), data.c_str(), data.c_str() + data.size());
+    }
+
+    int64_t firstPos(byteSize());
+    assert(get_range_to() < range.to());
+    set_size(size() + numEntries);
+    set_range_to(range.to());
+    if (get_range_from() == 0) {
+        set_range_from(range.from());
+    }
+
+    write(*_transLog, range, vespalib::ConstBufferRef(buf.data(), buf.size()));
+    std::lock_guard guard(_lock);
+    for (const SerializedChunk & chunk : chunks) {
+        _skipList.emplace_back(chunk.range().from(), firstPos);
+        firstPos += chunk.getData().size();
+    }
+}
+
 void
 DomainPart::sync()
 {
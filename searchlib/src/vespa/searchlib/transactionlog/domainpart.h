@@ -26,6 +26,10 @@ public:
 
     const vespalib::string &fileName() const { return _fileName; }
     void commit(const SerializedChunk & serialized);
+    /**
+     * Commits consecutive chunks with a single write to the file.
+     */
+    void commit(const std::vector<SerializedChunk> & chunks);
     bool erase(SerialNum to);
     bool visit(FastOS_FileInterface &file, SerialNumRange &r, Packet &packet);
     bool close();
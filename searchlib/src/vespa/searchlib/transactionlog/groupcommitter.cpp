@@ -0,0 +1,133 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "groupcommitter.h"
+#include "domain.h"
+#include <vespa/vespalib/util/idestructorcallback.h>
+#include <cassert>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".transactionlog.groupcommitter");
+
+namespace search::transactionlog {
+
+GroupCommitter::Pending::Pending(Domain & domain_in)
+    : domain(&domain_in),
+      chunks(),
+      queued(),
+      after_sync()
+{ }
+
+GroupCommitter::Pending::Pending(Pending &&) noexcept = default;
+GroupCommitter::Pending & GroupCommitter::Pending::operator=(Pending &&) noexcept = default;
+GroupCommitter::Pending::~Pending() = default;
+
+GroupCommitter::GroupCommitter(duration interval)
+    : _interval(interval),
+      _lock(),
+      _cond(),
+      _drainCond(),
+      _pending(),
+      _numQueued(0),
+      _numDone(0),
+      _numRounds(0),
+      _stopped(false),
+      _thread()
+{
+    _thread = std::thread([this]() { run(); });
+}
+
+GroupCommitter::~GroupCommitter()
+{
+    {
+        std::lock_guard guard(_lock);
+        _stopped = true;
+    }
+    _cond.notify_all();
+    _thread.join();
+    assert(_pending.empty());
+}
+
+GroupCommitter::Pending &
+GroupCommitter::pendingFor(const UniqueLock & guard, Domain & domain)
+{
+    assert(guard.mutex() == &_lock && guard.owns_lock());
+    for (Pending & pending : _pending) {
+        if (pending.domain == &domain) {
+            return pending;
+        }
+    }
+    return _pending.emplace_back(domain);
+}
+
+void
+GroupCommitter::commit(Domain & domain, SerializedChunk chunk)
+{
+    {
+        UniqueLock guard(_lock);
+        assert(!_stopped);
+        Pending & pending = pendingFor(guard, domain);
+        pending.chunks.push_back(std::move(chunk));
+        pending.queued.push_back(vespalib::steady_clock::now());
+        ++_numQueued;
+    }
+    _cond.notify_all();
+}
+
+void
+GroupCommitter::sync(Domain & domain, DoneCallback after_sync)
+{
+    {
+        UniqueLock guard(_lock);
+        assert(!_stopped);
+        pendingFor(guard, domain).after_sync.push_back(std::move(after_sync));
+        ++_numQueued;
+    }
+    _cond.notify_all();
+}
+
+void
+GroupCommitter::drain()
+{
+    assert(std::this_thread::get_id() != _thread.get_id());
+    UniqueLock guard(_lock);
+    uint64_t target = _numQueued;
+    _drainCond.wait(guard, [this, target]() { return _numDone >= target; });
+}
+
+size_t
+GroupCommitter::getNumRounds() const
+{
+    std::lock_guard guard(_lock);
+    return _numRounds;
+}
+
+void
+GroupCommitter::run()
+{
+    UniqueLock guard(_lock);
+    for (;;) {
+        _cond.wait(guard, [this]() { return _stopped || !_pending.empty(); });
+        if (_pending.empty()) {
+            break;
+        }
+        if ((_interval > duration::zero()) && !_stopped) {
+            // Give other domains a chance to join this round.
+            _cond.wait_for(guard, _interval, [this]() { return _stopped; });
+        }
+        std::vector<Pending> round;
+        round.swap(_pending);
+        uint64_t numQueued = _numQueued;
+        guard.unlock();
+        for (Pending & pending : round) {
+            pending.domain->commitGroup(std::move(pending.chunks), pending.queued, !pending.after_sync.empty());
+        }
+        LOG(debug, "Committed group for %zu domains.", round.size());
+        round.clear();
+        guard.lock();
+        ++_numRounds;
+        _numDone = numQueued;
+        _drainCond.notify_all();
+    }
+}
+
+}
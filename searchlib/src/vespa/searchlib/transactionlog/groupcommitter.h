@@ -0,0 +1,70 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "ichunk.h"
+#include <vespa/vespalib/util/time.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vespalib { class IDestructorCallback; }
+namespace search::transactionlog {
+
+class Domain;
+
+/**
+ * Commits serialized chunks for all domains of a transaction log server
+ * in rounds. Domains queue chunks in commit order, and a single thread
+ * drains the queue, optionally waiting a short interval for more work to
+ * arrive. In each round the chunks queued for a domain are written to its
+ * active part with one write, split only where the part is rotated, and
+ * each domain part is synced at most once. Commit callbacks are released when the chunks are destroyed after
+ * the round, as with the per domain committer.
+ */
+class GroupCommitter {
+public:
+    using duration = vespalib::duration;
+    using DoneCallback = std::unique_ptr<vespalib::IDestructorCallback>;
+    explicit GroupCommitter(duration interval);
+    GroupCommitter(const GroupCommitter &) = delete;
+    GroupCommitter & operator=(const GroupCommitter &) = delete;
+    ~GroupCommitter();
+
+    void commit(Domain & domain, SerializedChunk chunk);
+    void sync(Domain & domain, DoneCallback after_sync);
+    /**
+     * Waits until everything queued before this call has been committed.
+     * Must not be called from the committer thread.
+     */
+    void drain();
+    duration getInterval() const { return _interval; }
+    size_t getNumRounds() const;
+private:
+    struct Pending {
+        explicit Pending(Domain & domain_in);
+        Pending(Pending &&) noexcept;
+        Pending & operator=(Pending &&) noexcept;
+        ~Pending();
+        Domain                             *domain;
+        std::vector<SerializedChunk>        chunks;
+        std::vector<vespalib::steady_time>  queued;
+        std::vector<DoneCallback>           after_sync;
+    };
+    using UniqueLock = std::unique_lock<std::mutex>;
+    Pending & pendingFor(const UniqueLock & guard, Domain & domain);
+    void run();
+
+    const duration           _interval;
+    mutable std::mutex       _lock;
+    std::condition_variable  _cond;
+    std::condition_variable  _drainCond;
+    std::vector<Pending>     _pending;
+    uint64_t                 _numQueued;
+    uint64_t                 _numDone;
+    size_t                   _numRounds;
+    bool                     _stopped;
+    std::thread              _thread;
+};
+
+}
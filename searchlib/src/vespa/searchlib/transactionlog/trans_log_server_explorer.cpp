@@ -25,6 +25,23 @@ struct DomainExplorer : vespalib::StateExplorer {
         state.setLong("to", info.range.to());
         state.setLong("numEntries", info.numEntries);
         state.setLong("byteSize", info.byteSize);
+        const LatencyHistogram &latency = info.commitLatency;
+        if (latency.count() > 0) {
+            Cursor &commitLatency = state.setObject("commitLatency");
+            commitLatency.setLong("count", latency.count());
+            commitLatency.setDouble("averageMs", vespalib::count_ns(latency.total()) / (1000000.0 * latency.count()));
+            commitLatency.setDouble("maxMs", vespalib::count_ns(latency.max()) / 1000000.0);
+            if (full) {
+                Cursor &buckets = commitLatency.setArray("buckets");
+                for (size_t i = 0; i < LatencyHistogram::num_buckets; ++i) {
+                    if (latency.bucketCount(i) > 0) {
+                        Cursor &bucket = buckets.addObject();
+                        bucket.setLong("upperUs", vespalib::count_us(LatencyHistogram::bucketLimit(i)));
+                        bucket.setLong("count", latency.bucketCount(i));
+                    }
+                }
+            }
+        }
         if (full) {
             Cursor &array = state.setArray("parts");
             for (const PartInfo &part_in: info.parts) {
@@ -2,6 +2,7 @@
 #include "translogserver.h"
 #include "domain.h"
 #include "client_common.h"
+#include "groupcommitter.h"
 #include <vespa/fnet/frt/rpcrequest.h>
 #include <vespa/fnet/frt/supervisor.h>
 #include <vespa/fnet/transport.h>
@@ -100,6 +101,7 @@ TransLogServer::TransLogServer(FNET_Transport & transport, const vespalib::strin
       _executor(maxThreads, 128_Ki, CpuUsage::wrap(tls_executor, CpuUsage::Category::WRITE)),
       _threadPool(std::make_unique<FastOS_ThreadPool>(120_Ki)),
       _supervisor(std::make_unique<FRT_Supervisor>(&transport)),
+      _groupCommitter(cfg.getGroupCommit() ? std::make_shared<GroupCommitter>(cfg.getGroupCommitInterval()) : std::shared_ptr<GroupCommitter>()),
       _domains(),
       _reqQ(),
       _fileHeaderContext(fileHeaderContext),
@@ -114,7 +116,7 @@ TransLogServer::TransLogServer(FNET_Transport & transport, const vespalib::strin
                 domainDir >> domainName;
                 if ( ! domainName.empty()) {
                     try {
-                        auto domain = make_shared<Domain>(domainName, dir(), _executor, cfg, _fileHeaderContext);
+                        auto domain = make_shared<Domain>(domainName, dir(), _executor, cfg, _fileHeaderContext, _groupCommitter);
                         _domains[domain->name()] = domain;
                     } catch (const std::exception & e) {
                         LOG(warning, "Failed creating %s domain on startup. Exception = %s", domainName.c_str(), e.what());
@@ -439,7 +441,7 @@ TransLogServer::createDomain(FRT_RPCRequest *req)
     Domain::SP domain(findDomain(domainName));
     if ( !domain ) {
         try {
-            domain = std::make_shared<Domain>(domainName, dir(), _executor, _domainConfig, _fileHeaderContext);
+            domain = std::make_shared<Domain>(domainName, dir(), _executor, _domainConfig, _fileHeaderContext, _groupCommitter);
             {
                 WriteGuard domainGuard(_domainMutex);
                 _domains[domain->name()] = domain;
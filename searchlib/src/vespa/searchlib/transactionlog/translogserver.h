@@ -17,6 +17,7 @@ namespace search::transactionlog {
 
 class TransLogServerExplorer;
 class Domain;
+class GroupCommitter;
 
 class TransLogServer : public document::Runnable, private FRT_Invokable, public WriterFactory
 {
@@ -32,6 +33,8 @@ public:
                    const common::FileHeaderContext &fileHeaderContext);
     ~TransLogServer() override;
     DomainStats getDomainStats() const;
+    // Returns nullptr unless group commit is enabled.
+    const GroupCommitter * getGroupCommitter() const { return _groupCommitter.get(); }
     std::shared_ptr<Writer> getWriter(const vespalib::string & domainName) const override;
     TransLogServer & setDomainConfig(const DomainConfig & cfg);
 
@@ -69,6 +72,7 @@ private:
     vespalib::ThreadStackExecutor       _executor;
     std::unique_ptr<FastOS_ThreadPool>  _threadPool;
     std::unique_ptr<FRT_Supervisor>     _supervisor;
+    std::shared_ptr<GroupCommitter>     _groupCommitter;
     DomainList                          _domains;
     mutable std::shared_mutex           _domainMutex;;          // Protects _domains
     std::condition_variable             _domainCondition;
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "docsumstorevalue.h"
+#include <vespa/vespalib/util/arrayref.h>
 
 namespace search::docsummary {
 
@@ -38,6 +39,15 @@ public:
      **/
     virtual DocsumStoreValue getMappedDocsum(uint32_t docid) = 0;
 
+    /**
+     * Hint that docsums for the given documents will be requested
+     * shortly, letting the store fetch them in a single batch. The
+     * default implementation does nothing.
+     *
+     * @param docids local document ids
+     **/
+    virtual void prefetch(vespalib::ConstArrayRef<uint32_t> docids) { (void) docids; }
+
     /**
      * Will return default input class used.
      **/
@@ -18,6 +18,9 @@ std::shared_ptr<ClusterState> stable_state(std::make_shared<ClusterState>("distr
 std::shared_ptr<ClusterState> node_1_down_state(std::make_shared<ClusterState>("distributor:4 .1.s:d storage:4 .1.s:d bits:8"));
 std::shared_ptr<ClusterState> node_1_retired_state(std::make_shared<ClusterState>("distributor:4 .1.s:d storage:4 .1.s:r bits:8"));
 std::shared_ptr<ClusterState> node_1_maintenance_state(std::make_shared<ClusterState>("distributor:4 .1.s:d storage:4 .1.s:m bits:8"));
+std::shared_ptr<ClusterState> node_1_down_node_2_retired_state(std::make_shared<ClusterState>("distributor:4 .1.s:d storage:4 .1.s:d .2.s:r bits:8"));
+std::shared_ptr<ClusterState> node_2_capacity_state(std::make_shared<ClusterState>("distributor:4 storage:4 .2.c:2.5 bits:8"));
+std::shared_ptr<ClusterState> node_3_removed_state(std::make_shared<ClusterState>("distributor:4 storage:3 bits:8"));
 std::shared_ptr<Distribution> distribution_r1(std::make_shared<Distribution>(Distribution::getDefaultDistributionConfig(1, 4)));
 std::shared_ptr<Distribution> distribution_r2(std::make_shared<Distribution>(Distribution::getDefaultDistributionConfig(2, 4)));
 
@@ -190,6 +193,32 @@ TEST_F(DistributorBucketSpaceTest, check_available_nodes)
     EXPECT_EQ((std::vector<bool>{true, true, true, true}), bucket_space.get_available_nodes());
 }
 
+TEST_F(DistributorBucketSpaceTest, ideal_service_layer_nodes_are_updated_on_cluster_state_change)
+{
+    std::vector<std::shared_ptr<ClusterState>> states{stable_state, node_1_down_state, node_1_down_node_2_retired_state,
+                                                      node_1_down_state, node_1_maintenance_state, node_1_retired_state,
+                                                      stable_state, node_2_capacity_state, node_3_removed_state,
+                                                      node_1_down_state, stable_state};
+    bucket_space.setDistribution(distribution_r2);
+    for (const auto& state : states) {
+        bucket_space.setClusterState(state);
+        DistributorBucketSpace expected_bucket_space(0u);
+        expected_bucket_space.setDistribution(distribution_r2);
+        expected_bucket_space.setClusterState(state);
+        for (const auto& bucket : make_normal_buckets()) {
+            const auto& ideal_nodes_bundle = bucket_space.get_ideal_service_layer_nodes_bundle(bucket);
+            const auto& expected_ideal_nodes_bundle = expected_bucket_space.get_ideal_service_layer_nodes_bundle(bucket);
+            ASSERT_EQ(expected_ideal_nodes_bundle.get_available_nodes(), ideal_nodes_bundle.get_available_nodes())
+                << bucket << " in " << *state;
+            ASSERT_EQ(expected_ideal_nodes_bundle.get_available_nonretired_nodes(), ideal_nodes_bundle.get_available_nonretired_nodes())
+                << bucket << " in " << *state;
+            ASSERT_EQ(expected_ideal_nodes_bundle.get_available_nonretired_or_maintenance_nodes(),
+                      ideal_nodes_bundle.get_available_nonretired_or_maintenance_nodes())
+                << bucket << " in " << *state;
+        }
+    }
+}
+
 TEST_F(DistributorBucketSpaceTest, check_owned_deep_split_buckets)
 {
     bucket_space.setDistribution(distribution_r1);
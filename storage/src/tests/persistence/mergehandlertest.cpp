@@ -1439,4 +1439,63 @@ TEST_F(MergeHandlerTest, partially_filled_apply_bucket_diff_reply)
     LOG(debug, "got mergebucket reply");
 }
 
+TEST_F(MergeHandlerTest, local_writes_are_pipelined_with_next_apply_bucket_diff)
+{
+    _maxTimestamp = 30000;  // Extend timestamp range to include doc1 and doc2
+    auto doc1 = _env->_testDocMan.createRandomDocumentAtLocation(_location, 1);
+    auto doc2 = _env->_testDocMan.createRandomDocumentAtLocation(_location, 2);
+
+    MergeHandler handler = createHandler();
+    handler.set_pipeline_merge_local_writes(true);
+    auto cmd = std::make_shared<api::MergeBucketCommand>(_bucket, _nodes, _maxTimestamp);
+    handler.handleMergeBucket(*cmd, createTracker(cmd, _bucket));
+    size_t baseline_diff_size = 0;
+    {
+        auto get_bucket_diff_cmd = fetchSingleMessage<api::GetBucketDiffCommand>();
+        baseline_diff_size = get_bucket_diff_cmd->getDiff().size();
+        auto reply = std::make_unique<api::GetBucketDiffReply>(*get_bucket_diff_cmd);
+        // doc1 and doc2 is only present on node 1.
+        reply->getDiff().push_back(make_entry(20000, 2u));
+        reply->getDiff().push_back(make_entry(20100, 2u));
+        handler.handleGetBucketDiffReply(*reply, messageKeeper());
+    }
+    ASSERT_EQ(2u, messageKeeper()._msgs.size());
+    {
+        auto apply_bucket_diff_cmd = fetchSingleMessage<api::ApplyBucketDiffCommand>();
+        auto reply = std::make_shared<api::ApplyBucketDiffReply>(*apply_bucket_diff_cmd);
+        auto& diff = reply->getDiff();
+        ASSERT_EQ(baseline_diff_size + 2u, diff.size());
+        for (auto& e : diff) {
+            if (e._entry._hasMask == 1u) {
+                e._entry._hasMask |= 2u; // Simulate diff entry having been applied on node 1.
+            } else if (e._entry._timestamp == 20000u) {
+                fill_entry(e, *doc1, getEnv().getDocumentTypeRepo());
+            }
+        }
+        handler.handleApplyBucketDiffReply(*reply, messageKeeper(), createTracker(reply, _bucket));
+    }
+    ASSERT_EQ(3u, messageKeeper()._msgs.size());
+    {
+        // Next apply bucket diff is sent while doc1 is pending write, as no local data is needed.
+        auto s = getEnv()._fileStorHandler.editMergeStatus(_bucket);
+        EXPECT_TRUE(s->delayed_error.has_value());
+        EXPECT_EQ(1u, s->diff.size());
+        EXPECT_EQ(EntryCheck(20100, 2u), s->diff[0]);
+    }
+    {
+        auto apply_bucket_diff_cmd = fetchSingleMessage<api::ApplyBucketDiffCommand>();
+        auto reply = std::make_shared<api::ApplyBucketDiffReply>(*apply_bucket_diff_cmd);
+        auto& diff = reply->getDiff();
+        ASSERT_EQ(1u, diff.size());
+        fill_entry(diff[0], *doc2, getEnv().getDocumentTypeRepo());
+        handler.handleApplyBucketDiffReply(*reply, messageKeeper(), createTracker(reply, _bucket));
+    }
+    handler.drain_async_writes();
+    ASSERT_EQ(4u, messageKeeper()._msgs.size());
+    auto merge_reply = fetchSingleMessage<api::MergeBucketReply>();
+    EXPECT_TRUE(merge_reply->getResult().success());
+    EXPECT_TRUE(doGet(_bucket.getBucketId(), doc1->getId()).hasDocument());
+    EXPECT_TRUE(doGet(_bucket.getBucketId(), doc2->getId()).hasDocument());
+}
+
 } // storage
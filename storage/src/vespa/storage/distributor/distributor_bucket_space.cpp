@@ -15,6 +15,8 @@ const char *up_states = "uri";
 const char *nonretired_up_states = "ui";
 const char *nonretired_or_maintenance_up_states = "uim";
 
+const char *ideal_nodes_up_states[] = { up_states, nonretired_up_states, nonretired_or_maintenance_up_states };
+
 }
 
 DistributorBucketSpace::DistributorBucketSpace()
@@ -67,12 +69,70 @@ DistributorBucketSpace::enumerate_available_nodes()
     _available_nodes = std::move(nodes);
 }
 
+/*
+ * Ideal service layer nodes only depend on the distribution config, the
+ * distribution bit count and the storage nodes in each set of up states
+ * (with their capacity). A storage node leaving a set of up states can
+ * only change the ideal nodes of the buckets where it was an ideal node,
+ * since the score of each node is independent of the other nodes. Any
+ * other change may affect all buckets.
+ */
+void
+DistributorBucketSpace::invalidate_ideal_nodes(const lib::ClusterState& old_cluster_state)
+{
+    const auto& new_cluster_state = *_clusterState;
+    if (old_cluster_state.getDistributionBitCount() != new_cluster_state.getDistributionBitCount()) {
+        _ideal_nodes.clear();
+        return;
+    }
+    auto node_count = std::max(old_cluster_state.getNodeCount(lib::NodeType::STORAGE),
+                               new_cluster_state.getNodeCount(lib::NodeType::STORAGE));
+    std::vector<bool> removed_nodes(node_count);
+    bool has_removed_nodes = false;
+    for (uint32_t i = 0; i < node_count; ++i) {
+        lib::Node node_key(lib::NodeType::STORAGE, i);
+        const lib::NodeState& old_ns(old_cluster_state.getNodeState(node_key));
+        const lib::NodeState& new_ns(new_cluster_state.getNodeState(node_key));
+        for (const char* states : ideal_nodes_up_states) {
+            bool was_up = old_ns.getState().oneOf(states);
+            bool is_up = new_ns.getState().oneOf(states);
+            if (is_up && (!was_up || (old_ns.getCapacity() != new_ns.getCapacity()))) {
+                _ideal_nodes.clear();
+                return;
+            }
+            if (was_up && !is_up) {
+                removed_nodes[i] = true;
+                has_removed_nodes = true;
+            }
+        }
+    }
+    if (!has_removed_nodes) {
+        return;
+    }
+    std::vector<document::BucketId> invalid_buckets;
+    for (const auto& entry : _ideal_nodes) {
+        if (entry.second.has_any_node(removed_nodes)) {
+            invalid_buckets.push_back(entry.first);
+        }
+    }
+    for (const auto& bucket : invalid_buckets) {
+        _ideal_nodes.erase(bucket);
+    }
+}
+
 void
 DistributorBucketSpace::setClusterState(std::shared_ptr<const lib::ClusterState> clusterState)
 {
+    auto old_cluster_state = std::move(_clusterState);
+    auto old_distribution_bits = _distribution_bits;
     _clusterState = std::move(clusterState);
-    clear();
+    _ownerships.clear();
     enumerate_available_nodes();
+    if (old_cluster_state && (old_distribution_bits == _distribution_bits)) {
+        invalidate_ideal_nodes(*old_cluster_state);
+    } else {
+        _ideal_nodes.clear();
+    }
 }
 
 
@@ -85,9 +145,16 @@ DistributorBucketSpace::setDistribution(std::shared_ptr<const lib::Distribution>
 void
 DistributorBucketSpace::set_pending_cluster_state(std::shared_ptr<const lib::ClusterState> pending_cluster_state)
 {
+    // Ideal service layer nodes are calculated using the current cluster state, and
+    // are only affected by a pending cluster state through the distribution bit count
+    // used for cache lookups.
+    auto old_distribution_bits = _distribution_bits;
     _pending_cluster_state = std::move(pending_cluster_state);
-    clear();
+    _ownerships.clear();
     enumerate_available_nodes();
+    if (old_distribution_bits != _distribution_bits) {
+        _ideal_nodes.clear();
+    }
 }
 
 bool
@@ -30,6 +30,10 @@ namespace storage::distributor {
  *   Each bucket space _may_ operate with its own distribution config, in
  *   particular so that redundancy, ready copies etc can differ across
  *   bucket spaces.
+ * Ideal service layer nodes cache
+ *   Ideal service layer nodes per superbucket in the current cluster state.
+ *   The cache is kept across cluster state changes, only dropping the
+ *   entries that may be affected by the change (see invalidate_ideal_nodes).
  */
 class DistributorBucketSpace {
     std::unique_ptr<BucketDatabase>  _bucketDatabase;
@@ -45,6 +49,7 @@ class DistributorBucketSpace {
 
     void clear();
     void enumerate_available_nodes();
+    void invalidate_ideal_nodes(const lib::ClusterState& old_cluster_state);
     bool owns_bucket_in_state(const lib::Distribution& distribution, const lib::ClusterState& cluster_state, document::BucketId bucket) const;
 public:
     explicit DistributorBucketSpace();
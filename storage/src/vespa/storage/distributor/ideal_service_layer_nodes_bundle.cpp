@@ -14,4 +14,27 @@ IdealServiceLayerNodesBundle::IdealServiceLayerNodesBundle() noexcept
 
 IdealServiceLayerNodesBundle::~IdealServiceLayerNodesBundle() = default;
 
+namespace {
+
+bool
+contains_any_node(const std::vector<uint16_t>& ideal_nodes, const std::vector<bool>& nodes) noexcept
+{
+    for (auto node : ideal_nodes) {
+        if (node < nodes.size() && nodes[node]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+
+bool
+IdealServiceLayerNodesBundle::has_any_node(const std::vector<bool>& nodes) const noexcept
+{
+    return (contains_any_node(_available_nodes, nodes) ||
+            contains_any_node(_available_nonretired_nodes, nodes) ||
+            contains_any_node(_available_nonretired_or_maintenance_nodes, nodes));
+}
+
 }
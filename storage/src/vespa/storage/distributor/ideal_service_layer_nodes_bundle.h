@@ -23,6 +23,8 @@ public:
     std::vector<uint16_t> get_available_nodes() const { return _available_nodes; }
     std::vector<uint16_t> get_available_nonretired_nodes() const { return _available_nonretired_nodes; }
     std::vector<uint16_t> get_available_nonretired_or_maintenance_nodes() const { return _available_nonretired_or_maintenance_nodes; }
+    // Returns true if any of the given nodes (indexed by node index) is an ideal node
+    bool has_any_node(const std::vector<bool>& nodes) const noexcept;
 };
 
 }
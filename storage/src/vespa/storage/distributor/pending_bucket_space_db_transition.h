@@ -3,6 +3,7 @@
 
 #include "pending_bucket_space_db_transition_entry.h"
 #include "outdated_nodes.h"
+#include "superbucket_ideal_nodes_cache.h"
 #include <vespa/document/bucket/bucketspace.h>
 #include <vespa/storage/bucketdb/bucketdatabase.h>
 #include <unordered_map>
@@ -79,6 +80,7 @@ public:
         const std::unordered_set<uint16_t>& _outdated_nodes; // TODO hash_set
         const std::vector<dbtransition::Entry>& _entries;
         uint32_t _iter;
+        SuperbucketIdealNodesCache _ideal_nodes_cache;
     public:
         DbMerger(api::Timestamp creation_timestamp,
                  const lib::Distribution& distribution,
@@ -92,7 +94,8 @@ public:
               _storage_up_states(storage_up_states),
               _outdated_nodes(outdated_nodes),
               _entries(entries),
-              _iter(0)
+              _iter(0),
+              _ideal_nodes_cache(distribution, new_state, storage_up_states)
         {}
         ~DbMerger() override = default;
 
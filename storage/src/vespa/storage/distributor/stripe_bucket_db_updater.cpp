@@ -665,7 +665,8 @@ StripeBucketDBUpdater::MergingNodeRemover::MergingNodeRemover(
       _upStates(upStates),
       _track_non_owned_entries(track_non_owned_entries),
       _cachedDecisionSuperbucket(UINT64_MAX),
-      _cachedOwned(false)
+      _cachedOwned(false),
+      _ideal_nodes_cache(_distribution, _state, _upStates)
 {
     // TODO intersection of cluster state and distribution config
     const uint16_t storage_count = s.getNodeCount(lib::NodeType::STORAGE);
@@ -731,8 +732,7 @@ StripeBucketDBUpdater::MergingNodeRemover::setCopiesInEntry(
 {
     e->clear();
 
-    std::vector<uint16_t> order =
-            _distribution.getIdealStorageNodes(_state, e.getBucketId(), _upStates);
+    const auto& order = _ideal_nodes_cache.get(e.getBucketId());
 
     e->addNodes(copies, order);
 
@@ -9,6 +9,7 @@
 #include "outdated_nodes_map.h"
 #include "pendingclusterstate.h"
 #include "potential_data_loss_report.h"
+#include "superbucket_ideal_nodes_cache.h"
 #include <vespa/document/bucket/bucket.h>
 #include <vespa/storage/common/storagelink.h>
 #include <vespa/storageapi/message/bucket.h>
@@ -222,6 +223,7 @@ private:
         bool                               _track_non_owned_entries;
         mutable uint64_t                   _cachedDecisionSuperbucket;
         mutable bool                       _cachedOwned;
+        mutable SuperbucketIdealNodesCache _ideal_nodes_cache;
     };
 
     using DistributionContexts = std::unordered_map<document::BucketSpace,
@@ -0,0 +1,48 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "superbucket_ideal_nodes_cache.h"
+#include <vespa/vdslib/distribution/distribution.h>
+#include <vespa/vdslib/state/clusterstate.h>
+
+namespace storage::distributor {
+
+namespace {
+
+constexpr uint64_t no_superbucket = UINT64_MAX;
+
+}
+
+SuperbucketIdealNodesCache::SuperbucketIdealNodesCache(const lib::Distribution& distribution,
+                                                       const lib::ClusterState& state,
+                                                       const char* up_states)
+    : _distribution(distribution),
+      _state(state),
+      _up_states(up_states),
+      _superbucket(no_superbucket),
+      _ideal_nodes()
+{
+}
+
+SuperbucketIdealNodesCache::~SuperbucketIdealNodesCache() = default;
+
+const std::vector<uint16_t>&
+SuperbucketIdealNodesCache::get(const document::BucketId& bucket)
+{
+    const uint32_t bits = _state.getDistributionBitCount();
+    const uint32_t used_bits = bucket.getUsedBits();
+    if ((used_bits < bits) || (used_bits > 33)) {
+        _superbucket = no_superbucket;
+        _ideal_nodes = _distribution.getIdealStorageNodes(_state, bucket, _up_states);
+        return _ideal_nodes;
+    }
+    // The n LSBs of the bucket ID contain the superbucket number. Mask off the rest.
+    const uint64_t superbucket = bucket.getRawId() & ~(UINT64_MAX << bits);
+    if (superbucket != _superbucket) {
+        _superbucket = no_superbucket;
+        _ideal_nodes = _distribution.getIdealStorageNodes(_state, bucket, _up_states);
+        _superbucket = superbucket;
+    }
+    return _ideal_nodes;
+}
+
+}
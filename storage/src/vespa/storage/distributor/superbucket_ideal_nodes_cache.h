@@ -0,0 +1,40 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/document/bucket/bucketid.h>
+#include <cstdint>
+#include <vector>
+
+namespace storage::lib {
+    class ClusterState;
+    class Distribution;
+}
+
+namespace storage::distributor {
+
+/*
+ * Cache of the ideal storage nodes for the most recently used superbucket
+ * in a given cluster state.
+ *
+ * Ideal storage nodes are the same for all buckets in a superbucket unless
+ * the bucket is split beyond 33 bits (see lib::Distribution::getStorageSeed).
+ * Since the buckets of a superbucket are adjacent in bucket key order, a pass
+ * over the bucket database only needs to calculate them once per superbucket.
+ */
+class SuperbucketIdealNodesCache {
+    const lib::Distribution& _distribution;
+    const lib::ClusterState& _state;
+    const char*              _up_states;
+    uint64_t                 _superbucket;
+    std::vector<uint16_t>    _ideal_nodes;
+public:
+    SuperbucketIdealNodesCache(const lib::Distribution& distribution,
+                               const lib::ClusterState& state,
+                               const char* up_states);
+    ~SuperbucketIdealNodesCache();
+
+    // Might throw lib::TooFewBucketBitsInUseException, as for lib::Distribution::getIdealStorageNodes
+    const std::vector<uint16_t>& get(const document::BucketId& bucket);
+};
+
+}
@@ -214,6 +214,7 @@ FileStorManager::configure(std::unique_ptr<StorFilestorConfig> config)
     const bool use_dynamic_throttling = ((config->asyncOperationThrottlerType  == StorFilestorConfig::AsyncOperationThrottlerType::DYNAMIC) ||
                                          (config->asyncOperationThrottler.type == StorFilestorConfig::AsyncOperationThrottler::Type::DYNAMIC));
     const bool throttle_merge_feed_ops = config->asyncOperationThrottler.throttleIndividualMergeFeedOps;
+    const bool pipeline_merge_local_writes = config->pipelineMergeLocalWrites;
 
     if (!liveUpdate) {
         _config = std::move(config);
@@ -247,6 +248,7 @@ FileStorManager::configure(std::unique_ptr<StorFilestorConfig> config)
         std::lock_guard guard(_lock);
         for (auto& ph : _persistenceHandlers) {
             ph->set_throttle_merge_feed_ops(throttle_merge_feed_ops);
+            ph->set_pipeline_merge_local_writes(pipeline_merge_local_writes);
         }
     }
 }
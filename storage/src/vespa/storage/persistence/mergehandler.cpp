@@ -37,7 +37,8 @@ MergeHandler::MergeHandler(PersistenceUtil& env, spi::PersistenceProvider& spi,
       _maxChunkSize(maxChunkSize),
       _commonMergeChainOptimalizationMinimumSize(commonMergeChainOptimalizationMinimumSize),
       _executor(executor),
-      _throttle_merge_feed_ops(true)
+      _throttle_merge_feed_ops(true),
+      _pipeline_merge_local_writes(false)
 {
 }
 
@@ -827,11 +828,18 @@ MergeHandler::processBucketMerge(const spi::Bucket& bucket, MergeStatus& status,
     }
     cmd->setPriority(status.context.getPriority());
     cmd->setTimeout(status.timeout);
+    const bool need_local_data = applyDiffNeedLocalData(cmd->getDiff(), 0, true);
     if (async_results) {
-        // Check currently pending writes to local node before sending new command.
-        check_apply_diff_sync(std::move(async_results));
+        if (need_local_data || !pipeline_merge_local_writes()) {
+            // Check currently pending writes to local node before sending new command.
+            check_apply_diff_sync(std::move(async_results));
+        } else {
+            // Send new command while writes to local node are pending, as no local
+            // data is read for it. Pending writes are checked when the reply is handled.
+            status.set_delayed_error(async_results->get_future());
+        }
     }
-    if (applyDiffNeedLocalData(cmd->getDiff(), 0, true)) {
+    if (need_local_data) {
         framework::MilliSecTimer startTime(_clock);
         fetchLocalData(bucket, cmd->getDiff(), 0, context);
         _env._metrics.merge_handler_metrics.mergeDataReadLatency.addValue(startTime.getElapsedTimeAsDouble());
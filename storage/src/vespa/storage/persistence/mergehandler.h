@@ -89,6 +89,15 @@ public:
         return _throttle_merge_feed_ops.load(std::memory_order_relaxed);
     }
 
+    // Thread safe, as it's set during live reconfig from the main filestor manager.
+    void set_pipeline_merge_local_writes(bool pipeline) noexcept {
+        _pipeline_merge_local_writes.store(pipeline, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] bool pipeline_merge_local_writes() const noexcept {
+        return _pipeline_merge_local_writes.load(std::memory_order_relaxed);
+    }
+
 private:
     using DocEntryList = std::vector<std::unique_ptr<spi::DocEntry>>;
     const framework::Clock   &_clock;
@@ -100,6 +109,7 @@ private:
     const uint32_t            _commonMergeChainOptimalizationMinimumSize;
     vespalib::ISequencedTaskExecutor& _executor;
     std::atomic<bool>         _throttle_merge_feed_ops;
+    std::atomic<bool>         _pipeline_merge_local_writes;
 
     MessageTrackerUP handleGetBucketDiffStage2(api::GetBucketDiffCommand&, MessageTrackerUP) const;
     /** Returns a reply if merge is complete */
@@ -187,4 +187,10 @@ PersistenceHandler::set_throttle_merge_feed_ops(bool throttle) noexcept
     _mergeHandler.set_throttle_merge_feed_ops(throttle);
 }
 
+void
+PersistenceHandler::set_pipeline_merge_local_writes(bool pipeline) noexcept
+{
+    _mergeHandler.set_pipeline_merge_local_writes(pipeline);
+}
+
 }
@@ -0,0 +1,177 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/fuzzy/levenshtein_dfa.h>
+#include <vespa/vespalib/fuzzy/fuzzy_matcher.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <algorithm>
+#include <set>
+
+using namespace vespalib;
+using Casing = LevenshteinDfa::Casing;
+
+namespace {
+
+uint32_t edits(const LevenshteinDfa& dfa, std::string_view source) {
+    return dfa.match(source, nullptr).edits();
+}
+
+bool matches(const LevenshteinDfa& dfa, std::string_view source) {
+    return dfa.match(source, nullptr).matches();
+}
+
+// All strings over alphabet with length at most max_len, in sorted order
+std::vector<std::string> all_strings(std::string_view alphabet, size_t max_len) {
+    std::set<std::string> result;
+    std::vector<std::string> frontier{""};
+    result.emplace("");
+    for (size_t len = 1; len <= max_len; ++len) {
+        std::vector<std::string> next;
+        for (const auto& prefix : frontier) {
+            for (char ch : alphabet) {
+                next.push_back(prefix + ch);
+                result.insert(next.back());
+            }
+        }
+        frontier = std::move(next);
+    }
+    return {result.begin(), result.end()};
+}
+
+}
+
+TEST(LevenshteinDfaTest, exact_and_edit_matches_are_reported_with_edit_count) {
+    auto dfa = LevenshteinDfa::build("abc", 2, Casing::Cased);
+    EXPECT_EQ(edits(dfa, "abc"), 0);
+    EXPECT_EQ(edits(dfa, "ab"), 1);
+    EXPECT_EQ(edits(dfa, "abcd"), 1);
+    EXPECT_EQ(edits(dfa, "axc"), 1);
+    EXPECT_EQ(edits(dfa, "bc"), 1);
+    EXPECT_EQ(edits(dfa, "a"), 2);
+    EXPECT_EQ(edits(dfa, "xbcx"), 2);
+    EXPECT_FALSE(matches(dfa, "xyz"));
+    EXPECT_FALSE(matches(dfa, "abcdef"));
+    EXPECT_EQ(edits(dfa, "xyz"), 3);
+}
+
+TEST(LevenshteinDfaTest, max_edits_one) {
+    auto dfa = LevenshteinDfa::build("food", 1, Casing::Cased);
+    EXPECT_TRUE(matches(dfa, "food"));
+    EXPECT_TRUE(matches(dfa, "foo"));
+    EXPECT_TRUE(matches(dfa, "fold"));
+    EXPECT_TRUE(matches(dfa, "foods"));
+    EXPECT_FALSE(matches(dfa, "fo"));
+    EXPECT_FALSE(matches(dfa, "folds"));
+}
+
+TEST(LevenshteinDfaTest, uncased_matching_folds_both_target_and_source) {
+    auto dfa = LevenshteinDfa::build("FooBar", 1, Casing::Uncased);
+    EXPECT_TRUE(matches(dfa, "foobar"));
+    EXPECT_TRUE(matches(dfa, "FOOBAR"));
+    EXPECT_TRUE(matches(dfa, "FOOBAz"));
+    EXPECT_FALSE(matches(dfa, "FOOBzz"));
+    auto cased = LevenshteinDfa::build("FooBar", 1, Casing::Cased);
+    EXPECT_TRUE(matches(cased, "FooBar"));
+    EXPECT_TRUE(matches(cased, "fooBar"));
+    EXPECT_FALSE(matches(cased, "foobar"));
+}
+
+TEST(LevenshteinDfaTest, non_ascii_characters_count_as_single_edits) {
+    auto dfa = LevenshteinDfa::build("blåbær", 1, Casing::Uncased);
+    EXPECT_TRUE(matches(dfa, "BLÅBÆR"));
+    EXPECT_TRUE(matches(dfa, "blabær"));
+    EXPECT_FALSE(matches(dfa, "blabar"));
+}
+
+TEST(LevenshteinDfaTest, frozen_prefix_must_match_exactly) {
+    auto dfa = LevenshteinDfa::build("abcd", 2, Casing::Cased, 2);
+    EXPECT_TRUE(matches(dfa, "abcd"));
+    EXPECT_TRUE(matches(dfa, "ab"));
+    EXPECT_TRUE(matches(dfa, "abxyz") == false);
+    EXPECT_TRUE(matches(dfa, "abxy"));
+    EXPECT_FALSE(matches(dfa, "xbcd"));
+    EXPECT_FALSE(matches(dfa, "bcd"));
+    auto exact = LevenshteinDfa::build("ab", 2, Casing::Cased, 5);
+    EXPECT_TRUE(matches(exact, "ab"));
+    EXPECT_FALSE(matches(exact, "abc"));
+}
+
+TEST(LevenshteinDfaTest, max_edits_above_supported_limit_is_rejected) {
+    EXPECT_THROW((void) LevenshteinDfa::build("abc", 3, Casing::Cased), std::invalid_argument);
+}
+
+TEST(LevenshteinDfaTest, matching_is_consistent_with_fuzzy_matcher) {
+    auto dictionary = all_strings("abcx", 5);
+    for (uint8_t max_edits : {0, 1, 2}) {
+        for (uint32_t prefix : {0u, 1u, 3u}) {
+            for (std::string_view target : {"", "a", "abc", "cabba", "xxbc"}) {
+                auto dfa = LevenshteinDfa::build(target, max_edits, Casing::Cased, prefix);
+                FuzzyMatcher matcher(target, max_edits, prefix, true);
+                for (const auto& source : dictionary) {
+                    EXPECT_EQ(matches(dfa, source), matcher.isMatch(source))
+                        << "target='" << target << "' source='" << source << "' max_edits="
+                        << int(max_edits) << " prefix=" << prefix;
+                }
+            }
+        }
+    }
+}
+
+TEST(LevenshteinDfaTest, successor_is_smallest_possible_match_greater_than_source) {
+    auto dictionary = all_strings("abcx", 5);
+    for (uint8_t max_edits : {1, 2}) {
+        for (std::string_view target : {"abc", "cab", "xa"}) {
+            auto dfa = LevenshteinDfa::build(target, max_edits, Casing::Cased);
+            std::string successor;
+            for (size_t i = 0; i < dictionary.size(); ++i) {
+                if (dfa.match(dictionary[i], &successor).matches()) {
+                    continue;
+                }
+                ASSERT_TRUE(successor.empty() || successor > dictionary[i]);
+                // No dictionary entry between source and successor may match
+                auto end = successor.empty()
+                           ? dictionary.end()
+                           : std::lower_bound(dictionary.begin(), dictionary.end(), successor);
+                for (auto it = dictionary.begin() + i + 1; it < end; ++it) {
+                    EXPECT_FALSE(matches(dfa, *it)) << "skipped match '" << *it << "' from '"
+                                                    << dictionary[i] << "' to '" << successor << "'";
+                }
+                if (!successor.empty()) {
+                    EXPECT_TRUE(matches(dfa, successor));
+                }
+            }
+        }
+    }
+}
+
+TEST(LevenshteinDfaTest, successor_examples) {
+    auto dfa = LevenshteinDfa::build("food", 1, Casing::Uncased);
+    std::string successor;
+    EXPECT_FALSE(dfa.match("fa", &successor).matches());
+    EXPECT_EQ(successor, "faod");
+    EXPECT_FALSE(dfa.match("FOX", &successor).matches());
+    EXPECT_EQ(successor, "foxd");
+    EXPECT_FALSE(dfa.match("g", &successor).matches());
+    EXPECT_EQ(successor, "gfood");
+    EXPECT_FALSE(dfa.match("zzz", &successor).matches());
+    EXPECT_EQ(successor, "{food");
+}
+
+TEST(LevenshteinDfaTest, no_successor_when_all_matches_are_smaller) {
+    auto dfa = LevenshteinDfa::build("abc", 1, Casing::Cased);
+    std::string successor = "garbage";
+    // Two occurrences of the highest possible code point (U+10FFFF)
+    EXPECT_FALSE(dfa.match("\xf4\x8f\xbf\xbf\xf4\x8f\xbf\xbf", &successor).matches());
+    EXPECT_TRUE(successor.empty());
+}
+
+TEST(LevenshteinDfaTest, number_of_states_is_linear_in_target_length) {
+    std::string target(64, 'a');
+    for (size_t i = 0; i < target.size(); ++i) {
+        target[i] = 'a' + (i % 26);
+    }
+    auto dfa = LevenshteinDfa::build(target, 2, Casing::Uncased);
+    EXPECT_LT(dfa.num_states(), 64u * 32u);
+    EXPECT_GT(dfa.memory_usage(), 0u);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -3,6 +3,7 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/hwaccelrated/iaccelrated.h>
 #include <vespa/vespalib/hwaccelrated/generic.h>
+#include <vespa/vespalib/util/bfloat16.h>
 #include <vespa/log/log.h>
 LOG_SETUP("hwaccelrated_test");
 
@@ -47,4 +48,61 @@ TEST("test euclidean distance") {
     TEST_DO(verifyEuclideanDistance(hwaccelrated::IAccelrated::getAccelerator(), TEST_LENGTH));
 }
 
+template<typename B>
+void verifyBFloat16(const hwaccelrated::IAccelrated & accel, size_t testLength) {
+    srand(1);
+    std::vector<BFloat16> a;
+    std::vector<B> b;
+    for (size_t i(0); i < testLength; i++) {
+        a.emplace_back((rand()%2000 - 1000) / 64.0f);
+        b.emplace_back((rand()%2000 - 1000) / 64.0f);
+    }
+    for (size_t j(0); j < 0x20; j++) {
+        double dot(0);
+        double distance(0);
+        for (size_t i(j); i < testLength; i++) {
+            double d = double(a[i]) - double(b[i]);
+            dot += double(a[i]) * double(b[i]);
+            distance += d * d;
+        }
+        EXPECT_APPROX(dot, accel.dotProduct(&a[j], &b[j], testLength - j), std::abs(dot) * 0.0001 + 0.1);
+        EXPECT_APPROX(distance, accel.squaredEuclideanDistance(&a[j], &b[j], testLength - j), distance * 0.0001);
+    }
+}
+
+void
+verifyInt8DotProduct(const hwaccelrated::IAccelrated & accel, size_t testLength) {
+    srand(1);
+    std::vector<int8_t> a;
+    std::vector<int8_t> b;
+    for (size_t i(0); i < testLength; i++) {
+        a.push_back(rand()%256 - 128);
+        b.push_back(rand()%256 - 128);
+    }
+    for (size_t j(0); j < 0x20; j++) {
+        int64_t sum(0);
+        for (size_t i(j); i < testLength; i++) {
+            sum += int64_t(a[i]) * int64_t(b[i]);
+        }
+        EXPECT_EQUAL(sum, accel.dotProduct(&a[j], &b[j], testLength - j));
+    }
+    std::vector<int8_t> min(testLength, -128);
+    EXPECT_EQUAL(int64_t(testLength) * 128 * 128, accel.dotProduct(&min[0], &min[0], testLength));
+}
+
+TEST("test bfloat16 dot product and euclidean distance") {
+    for (size_t testLength : {33, 255, 1000}) {
+        TEST_DO(verifyBFloat16<BFloat16>(hwaccelrated::GenericAccelrator(), testLength));
+        TEST_DO(verifyBFloat16<float>(hwaccelrated::GenericAccelrator(), testLength));
+        TEST_DO(verifyBFloat16<BFloat16>(hwaccelrated::IAccelrated::getAccelerator(), testLength));
+        TEST_DO(verifyBFloat16<float>(hwaccelrated::IAccelrated::getAccelerator(), testLength));
+    }
+}
+
+TEST("test int8 dot product") {
+    constexpr size_t TEST_LENGTH = 140000; // must be longer than 64k
+    TEST_DO(verifyInt8DotProduct(hwaccelrated::GenericAccelrator(), TEST_LENGTH));
+    TEST_DO(verifyInt8DotProduct(hwaccelrated::IAccelrated::getAccelerator(), TEST_LENGTH));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
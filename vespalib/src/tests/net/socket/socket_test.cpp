@@ -12,6 +12,7 @@
 #include <functional>
 #include <unistd.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 
 using namespace vespalib;
 
@@ -393,6 +394,41 @@ TEST("require that tcp lingering can be adjusted") {
     TEST_DO(verifier.verify_linger(false, 0));
 }
 
+TEST_MT_FF("require that vectored and zero copy writes work", 2, ServerSocket("tcp/0"), TimeBomb(60)) {
+    vespalib::string head = "head:";
+    vespalib::string body(100000, 'x');
+    vespalib::string tail = ":tail";
+    if (thread_id == 0) {
+        SocketHandle socket = f1.accept();
+        EXPECT_EQUAL(read_bytes(socket, head.size() + body.size() + tail.size()), head + body + tail);
+        EXPECT_EQUAL(read_bytes(socket, body.size()), body);
+    } else {
+        SocketHandle socket = SocketSpec::from_port(f1.address().port()).client_address().connect();
+        struct iovec iov[3] = { { const_cast<char *>(head.data()), head.size() },
+                                { const_cast<char *>(body.data()), body.size() },
+                                { const_cast<char *>(tail.data()), tail.size() } };
+        ssize_t total = head.size() + body.size() + tail.size();
+        EXPECT_EQUAL(socket.writev(iov, 3), total);
+        bool zero_copy = socket.set_zero_copy(true);
+        fprintf(stderr, "zero copy %s\n", zero_copy ? "enabled" : "not supported");
+        size_t written = 0;
+        while (written < body.size()) {
+            ssize_t res = zero_copy ? socket.write_zero_copy(body.data() + written, body.size() - written)
+                                    : socket.write(body.data() + written, body.size() - written);
+            ASSERT_TRUE(res > 0);
+            written += res;
+        }
+        if (zero_copy) {
+            uint32_t lo = 1;
+            uint32_t hi = 0;
+            while (!socket.read_zero_copy_completion(lo, hi)) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            EXPECT_EQUAL(lo, 0u);
+        }
+    }
+}
+
 SocketHandle connect_async(const SocketAddress &addr) {
     struct ConnectContext {
         SocketHandle handle;
@@ -32,6 +32,64 @@ TEST("require that prefix detection sometimes underestimates the prefix size") {
     EXPECT_EQUAL("", RegexpUtil::get_prefix("^foo|^foobar"));
 }
 
+vespalib::string required_literals(vespalib::stringref re) {
+    vespalib::string result;
+    for (const auto &literal : RegexpUtil::get_required_literals(re)) {
+        result += result.empty() ? "" : ",";
+        result += literal;
+    }
+    return result;
+}
+
+TEST("require that required literals are detected") {
+    EXPECT_EQUAL("", required_literals(""));
+    EXPECT_EQUAL("foo", required_literals("foo"));
+    EXPECT_EQUAL("foo", required_literals("^foo$"));
+    EXPECT_EQUAL("foo,bar", required_literals("foo.*bar"));
+    EXPECT_EQUAL("fo,bar", required_literals("foo?bar"));
+    EXPECT_EQUAL("fo,bar", required_literals("foo*bar"));
+    EXPECT_EQUAL("fo,bar", required_literals("foo{0,2}bar"));
+    EXPECT_EQUAL("fo,bar", required_literals("foo{2}bar"));
+    EXPECT_EQUAL("foo,bar", required_literals("foo+bar"));
+    EXPECT_EQUAL("foo,bar", required_literals("foo[a-z]bar"));
+    EXPECT_EQUAL("foo,bar", required_literals("foo[]\\]]bar"));
+    EXPECT_EQUAL("foo,bar", required_literals("foo[[:digit:]]bar"));
+    EXPECT_EQUAL("foo,bar", required_literals("foo(xy)?bar"));
+    EXPECT_EQUAL("foo,bar", required_literals("foo\\d+bar"));
+    EXPECT_EQUAL("foo.bar", required_literals("foo\\.bar"));
+    EXPECT_EQUAL("foo", required_literals("foo\\.*"));
+    EXPECT_EQUAL("bl", required_literals("blå?"));
+}
+
+TEST("require that required literals are not detected for alternation and inline flags") {
+    EXPECT_EQUAL("", required_literals("foo|bar"));
+    EXPECT_EQUAL("", required_literals("(?i)foo"));
+}
+
+TEST("require that required literals are not detected for escapes with payload") {
+    EXPECT_EQUAL("", required_literals("\\x41foo"));
+    EXPECT_EQUAL("", required_literals("foo\\x{41}bar"));
+    EXPECT_EQUAL("", required_literals("\\101foo"));
+    EXPECT_EQUAL("", required_literals("\\pLfoo"));
+    EXPECT_EQUAL("", required_literals("\\p{Greek}foo"));
+    EXPECT_EQUAL("", required_literals("\\PLfoo"));
+    EXPECT_EQUAL("", required_literals("\\Qa.b\\Efoo"));
+    EXPECT_EQUAL("", required_literals("foo\\nbar"));
+    EXPECT_EQUAL("", required_literals("foo\\"));
+}
+
+TEST("require that escapes with payload are matched as expected") {
+    EXPECT_TRUE(Regex::from_pattern("\\x41foo").partial_match("xAfoox"));
+    EXPECT_TRUE(Regex::from_pattern("\\101foo").partial_match("xAfoox"));
+    EXPECT_TRUE(Regex::from_pattern("\\pLfoo").partial_match("xAfoox"));
+    EXPECT_TRUE(Regex::from_pattern("\\Qa.b\\Efoo").partial_match("xa.bfoox"));
+}
+
+TEST("require that required literals are detected for suffix and substring expressions") {
+    EXPECT_EQUAL("a.b", required_literals(RegexpUtil::make_from_suffix("a.b")));
+    EXPECT_EQUAL("a*b", required_literals(RegexpUtil::make_from_substring("a*b")));
+}
+
 const std::string special("^|()[]{}.*?+\\$");
 
 struct ExprFixture {
@@ -136,4 +136,21 @@ TEST("testThatMultipleRemoveOnOverflowIsFine") {
     EXPECT_EQUAL(2924u, cache.sizeBytes());
 }
 
+TEST("require that populate with read guard does not replace cached objects") {
+    B m;
+    cache< CacheParam<P, B> > cache(m, -1);
+    cache.write(1, "Written string");
+    {
+        // Keys 2 and 115 share a lock.
+        auto guard = cache.getReadGuard({3, 1, 2, 115, 2});
+        cache.populate(guard, 1, "Stale string");
+        cache.populate(guard, 2, "Populated string");
+        EXPECT_TRUE( ! m.count(2) );
+    }
+    EXPECT_EQUAL(2u, cache.size());
+    EXPECT_EQUAL(cache.read(1), "Written string");
+    EXPECT_EQUAL(cache.read(2), "Populated string");
+    EXPECT_TRUE( ! cache.hasKey(3) );
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,111 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/numa_topology.h>
+#include <cstdlib>
+#include <numeric>
+
+namespace vespalib {
+
+using CpuList = NumaTopology::CpuList;
+
+namespace {
+
+std::string get_source_dir() {
+    const char *dir = getenv("SOURCE_DIRECTORY");
+    return (dir ? dir : ".");
+}
+std::string source_dir = get_source_dir();
+
+CpuList
+make_cpus(uint32_t num_cpus)
+{
+    CpuList cpus(num_cpus);
+    std::iota(cpus.begin(), cpus.end(), 0);
+    return cpus;
+}
+
+}
+
+TEST(NumaTopologyTest, cpu_list_is_parsed)
+{
+    EXPECT_EQ((CpuList{}), NumaTopology::parse_cpu_list(""));
+    EXPECT_EQ((CpuList{3}), NumaTopology::parse_cpu_list("3"));
+    EXPECT_EQ((CpuList{0, 1, 2, 3, 8, 10, 11}), NumaTopology::parse_cpu_list("0-3,8,10-11"));
+    EXPECT_EQ((CpuList{1, 2, 3}), NumaTopology::parse_cpu_list("2-3,1,2"));
+}
+
+TEST(NumaTopologyTest, two_nodes)
+{
+    NumaTopology topology(source_dir + "/two_nodes", make_cpus(16));
+    ASSERT_EQ(2u, topology.num_nodes());
+    EXPECT_EQ((CpuList{0, 1, 2, 3, 8, 9, 10, 11}), topology.cpus(0));
+    EXPECT_EQ((CpuList{4, 5, 6, 7, 12, 13, 14, 15}), topology.cpus(1));
+    EXPECT_EQ(0u, topology.node_of_cpu(3));
+    EXPECT_EQ(1u, topology.node_of_cpu(4));
+    EXPECT_EQ(0u, topology.node_of_cpu(9));
+    EXPECT_EQ(1u, topology.node_of_cpu(15));
+    EXPECT_EQ(0u, topology.node_of_cpu(16));
+}
+
+TEST(NumaTopologyTest, sparse_nodes)
+{
+    NumaTopology topology(source_dir + "/sparse_nodes", make_cpus(4));
+    ASSERT_EQ(2u, topology.num_nodes());
+    EXPECT_EQ((CpuList{0, 1}), topology.cpus(0));
+    EXPECT_EQ((CpuList{2, 3}), topology.cpus(1));
+    EXPECT_EQ(1u, topology.node_of_cpu(2));
+}
+
+TEST(NumaTopologyTest, unusable_cpus_are_left_out)
+{
+    NumaTopology topology(source_dir + "/two_nodes", CpuList{2, 3, 4, 9});
+    ASSERT_EQ(2u, topology.num_nodes());
+    EXPECT_EQ((CpuList{2, 3, 9}), topology.cpus(0));
+    EXPECT_EQ((CpuList{4}), topology.cpus(1));
+}
+
+TEST(NumaTopologyTest, nodes_without_usable_cpus_are_dropped)
+{
+    NumaTopology topology(source_dir + "/two_nodes", CpuList{5, 6});
+    ASSERT_EQ(1u, topology.num_nodes());
+    EXPECT_EQ((CpuList{5, 6}), topology.cpus(0));
+    EXPECT_EQ(0u, topology.node_of_cpu(5));
+}
+
+TEST(NumaTopologyTest, single_node_without_topology)
+{
+    NumaTopology topology(source_dir + "/no_topology", make_cpus(4));
+    ASSERT_EQ(1u, topology.num_nodes());
+    EXPECT_EQ(make_cpus(4), topology.cpus(0));
+}
+
+TEST(NumaTopologyTest, host_topology_covers_current_affinity)
+{
+    NumaTopology topology;
+    auto affinity = NumaTopology::current_affinity();
+    ASSERT_LE(1u, topology.num_nodes());
+    CpuList cpus;
+    for (size_t node = 0; node < topology.num_nodes(); ++node) {
+        cpus.insert(cpus.end(), topology.cpus(node).begin(), topology.cpus(node).end());
+    }
+    std::sort(cpus.begin(), cpus.end());
+    EXPECT_EQ(affinity, cpus);
+    EXPECT_LT(topology.current_node(), topology.num_nodes());
+}
+
+TEST(NumaTopologyTest, bind_guard_restores_affinity)
+{
+    auto affinity = NumaTopology::current_affinity();
+    ASSERT_FALSE(affinity.empty());
+    {
+        NumaTopology::BindGuard guard(CpuList{affinity.front()});
+        EXPECT_EQ(affinity.size() > 1, guard.bound());
+        EXPECT_EQ((CpuList{affinity.front()}), NumaTopology::current_affinity());
+    }
+    EXPECT_EQ(affinity, NumaTopology::current_affinity());
+}
+
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,306 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "levenshtein_dfa.h"
+#include <vespa/vespalib/text/lowercase.h>
+#include <vespa/vespalib/text/utf8.h>
+#include <algorithm>
+#include <cassert>
+#include <map>
+#include <stdexcept>
+
+namespace vespalib {
+
+namespace {
+
+// Never produced by UTF-8 decoding, used to compute the shared transition
+// for all characters that are not present in the target string.
+constexpr uint32_t WILDCARD = 0xffffffffu;
+constexpr uint32_t MAX_CODE_POINT = 0x10ffffu;
+
+using Row = std::vector<uint8_t>;
+
+/**
+ * Computes rows of the Levenshtein matrix for a target string, capping
+ * all values at max_edits + 1. The first prefix_size target characters
+ * can only be matched exactly.
+ */
+class RowCalculator {
+    const std::vector<uint32_t>& _target;
+    uint32_t _prefix_size;
+    uint8_t  _cap;
+public:
+    RowCalculator(const std::vector<uint32_t>& target, uint32_t prefix_size, uint8_t max_edits)
+        : _target(target),
+          _prefix_size(prefix_size),
+          _cap(max_edits + 1)
+    {}
+    Row initial() const {
+        Row row(_target.size() + 1, _cap);
+        row[0] = 0;
+        for (uint32_t i = _prefix_size + 1; i <= _target.size(); ++i) {
+            row[i] = std::min<uint8_t>(_cap, row[i - 1] + 1);
+        }
+        return row;
+    }
+    Row next(const Row& row, uint32_t ch) const {
+        Row result(row.size(), _cap);
+        if (_prefix_size == 0) {
+            result[0] = std::min<uint8_t>(_cap, row[0] + 1);
+        }
+        for (uint32_t i = 1; i < row.size(); ++i) {
+            bool editable = (i > _prefix_size); // target character i - 1 is outside the exact prefix
+            uint32_t best = _cap;
+            if (_target[i - 1] == ch) {
+                best = row[i - 1];
+            } else if (editable) {
+                best = row[i - 1] + 1u; // substitution
+            }
+            if (i >= _prefix_size) {
+                best = std::min(best, row[i] + 1u); // insertion
+            }
+            if (editable) {
+                best = std::min(best, result[i - 1] + 1u); // deletion
+            }
+            result[i] = std::min<uint32_t>(best, _cap);
+        }
+        return result;
+    }
+    bool is_dead(const Row& row) const {
+        return std::all_of(row.begin(), row.end(), [cap = _cap](uint8_t v) { return v >= cap; });
+    }
+    // Target characters whose diagonal transition can differ from the wildcard transition
+    std::vector<uint32_t> relevant_chars(const Row& row) const {
+        std::vector<uint32_t> chars;
+        for (uint32_t i = 1; i < row.size(); ++i) {
+            if (row[i - 1] < _cap) {
+                chars.push_back(_target[i - 1]);
+            }
+        }
+        std::sort(chars.begin(), chars.end());
+        chars.erase(std::unique(chars.begin(), chars.end()), chars.end());
+        return chars;
+    }
+};
+
+std::vector<uint32_t>
+to_code_points(std::string_view str, LevenshteinDfa::Casing casing)
+{
+    if (casing == LevenshteinDfa::Casing::Uncased) {
+        return LowerCase::convert_to_ucs4(str);
+    }
+    std::vector<uint32_t> result;
+    result.reserve(str.size());
+    Utf8Reader reader(str.data(), str.size());
+    while (reader.hasMore()) {
+        result.emplace_back(reader.getChar());
+    }
+    return result;
+}
+
+bool
+is_surrogate(uint32_t ch) noexcept
+{
+    return (ch >= 0xd800u) && (ch <= 0xdfffu);
+}
+
+}
+
+LevenshteinDfa::LevenshteinDfa(std::vector<State> states, std::vector<Edge> edges, uint8_t max_edits, Casing casing)
+    : _states(std::move(states)),
+      _edges(std::move(edges)),
+      _max_edits(max_edits),
+      _casing(casing)
+{
+}
+
+LevenshteinDfa::LevenshteinDfa(LevenshteinDfa&&) noexcept = default;
+LevenshteinDfa& LevenshteinDfa::operator=(LevenshteinDfa&&) noexcept = default;
+LevenshteinDfa::~LevenshteinDfa() = default;
+
+LevenshteinDfa
+LevenshteinDfa::build(std::string_view target_string, uint8_t max_edits, Casing casing, uint32_t prefix_size)
+{
+    if (max_edits > MaxSupportedEdits) {
+        throw std::invalid_argument("LevenshteinDfa: max edits must be at most 2");
+    }
+    std::vector<uint32_t> target = to_code_points(target_string, casing);
+    uint8_t effective_max_edits = max_edits;
+    if (prefix_size > target.size()) {
+        // Matches FuzzyMatcher semantics; a prefix longer than the target only allows exact matches
+        prefix_size = target.size();
+        effective_max_edits = 0;
+    }
+    RowCalculator calc(target, prefix_size, effective_max_edits);
+    const uint8_t cap = effective_max_edits + 1;
+
+    std::map<Row, uint32_t> row_to_state;
+    std::vector<Row> rows;
+    auto intern = [&](Row row) -> uint32_t {
+        if (calc.is_dead(row)) {
+            return DEAD;
+        }
+        auto itr = row_to_state.find(row);
+        if (itr != row_to_state.end()) {
+            return itr->second;
+        }
+        uint32_t id = rows.size();
+        row_to_state.emplace(row, id);
+        rows.emplace_back(std::move(row));
+        return id;
+    };
+    rows.emplace_back(target.size() + 1, cap); // dead state
+    uint32_t start = intern(calc.initial());
+    (void) start;
+    assert(start == START);
+
+    std::vector<State> states;
+    std::vector<Edge> edges;
+    // rows grows while iterating, processing states in breadth-first order
+    for (uint32_t id = 0; id < rows.size(); ++id) {
+        State state;
+        state.edges_begin = edges.size();
+        if (id == DEAD) {
+            state.wildcard_next = DEAD;
+        } else {
+            const Row row = rows[id];
+            state.wildcard_next = intern(calc.next(row, WILDCARD));
+            for (uint32_t ch : calc.relevant_chars(row)) {
+                uint32_t next = intern(calc.next(row, ch));
+                if (next != state.wildcard_next) {
+                    edges.push_back(Edge{ch, next});
+                }
+            }
+        }
+        state.edges_end = edges.size();
+        uint8_t last = rows[id].back();
+        state.edits = (id != DEAD && last < cap) ? last : static_cast<uint8_t>(max_edits + 1);
+        states.push_back(state);
+    }
+    return LevenshteinDfa(std::move(states), std::move(edges), max_edits, casing);
+}
+
+uint32_t
+LevenshteinDfa::fold(uint32_t ch) const noexcept
+{
+    return (_casing == Casing::Uncased) ? LowerCase::convert(ch) : ch;
+}
+
+uint32_t
+LevenshteinDfa::step(uint32_t state, uint32_t ch) const noexcept
+{
+    const State& s = _states[state];
+    for (uint32_t i = s.edges_begin; i < s.edges_end; ++i) {
+        if (_edges[i].ch == ch) {
+            return _edges[i].next;
+        }
+    }
+    return s.wildcard_next;
+}
+
+LevenshteinDfa::CharAndState
+LevenshteinDfa::smallest_live_transition_above(uint32_t state, uint32_t ch) const noexcept
+{
+    const State& s = _states[state];
+    CharAndState best{0, DEAD};
+    for (uint32_t i = s.edges_begin; i < s.edges_end; ++i) {
+        if (_edges[i].ch > ch && _edges[i].next != DEAD) {
+            best = CharAndState{_edges[i].ch, _edges[i].next};
+            break; // edges are sorted on character
+        }
+    }
+    if (s.wildcard_next != DEAD) {
+        // Smallest character above ch that does not have an explicit transition
+        uint32_t candidate = ch + 1;
+        for (uint32_t i = s.edges_begin; i < s.edges_end; ++i) {
+            if (is_surrogate(candidate)) {
+                candidate = 0xe000u;
+            }
+            if (_edges[i].ch == candidate) {
+                ++candidate;
+            }
+        }
+        if (is_surrogate(candidate)) {
+            candidate = 0xe000u;
+        }
+        if (candidate <= MAX_CODE_POINT && (best.state == DEAD || candidate < best.ch)) {
+            best = CharAndState{candidate, s.wildcard_next};
+        }
+    }
+    return best;
+}
+
+void
+LevenshteinDfa::append_smallest_completion(uint32_t state, std::string& out) const
+{
+    // The accepted language is finite, so following the smallest live transition terminates
+    Utf8Writer<std::string> writer(out);
+    while (!accepting(state)) {
+        auto next = smallest_live_transition_above(state, 0);
+        writer.putChar(next.ch);
+        state = next.state;
+    }
+}
+
+void
+LevenshteinDfa::make_successor(std::span<const uint32_t> source, std::string& successor_out) const
+{
+    std::vector<uint32_t> path;
+    path.reserve(source.size() + 1);
+    path.push_back(START);
+    for (uint32_t ch : source) {
+        uint32_t next = step(path.back(), ch);
+        if (next == DEAD) {
+            break;
+        }
+        path.push_back(next);
+    }
+    successor_out.clear();
+    Utf8Writer<std::string> writer(successor_out);
+    size_t live_prefix = path.size() - 1;
+    if (live_prefix == source.size()) {
+        // All of source is a live prefix, the successor is its smallest accepted extension
+        for (uint32_t ch : source) {
+            writer.putChar(ch);
+        }
+        append_smallest_completion(path.back(), successor_out);
+        return;
+    }
+    for (size_t pos = live_prefix + 1; pos-- > 0; ) {
+        auto next = smallest_live_transition_above(path[pos], source[pos]);
+        if (next.state != DEAD) {
+            for (size_t i = 0; i < pos; ++i) {
+                writer.putChar(source[i]);
+            }
+            writer.putChar(next.ch);
+            append_smallest_completion(next.state, successor_out);
+            return;
+        }
+    }
+    successor_out.clear(); // no string greater than source can match
+}
+
+LevenshteinDfa::MatchResult
+LevenshteinDfa::match(std::string_view source, std::string* successor_out) const
+{
+    Utf8Reader reader(source.data(), source.size());
+    uint32_t state = START;
+    while (reader.hasMore() && state != DEAD) {
+        state = step(state, fold(reader.getChar()));
+    }
+    if (accepting(state)) {
+        return MatchResult::make_match(_max_edits, _states[state].edits);
+    }
+    if (successor_out != nullptr) {
+        std::vector<uint32_t> source_chars = to_code_points(source, _casing);
+        make_successor(source_chars, *successor_out);
+    }
+    return MatchResult::make_mismatch(_max_edits);
+}
+
+size_t
+LevenshteinDfa::memory_usage() const noexcept
+{
+    return sizeof(State) * _states.capacity() + sizeof(Edge) * _edges.capacity();
+}
+
+}
@@ -0,0 +1,119 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vespalib {
+
+/**
+ * Deterministic finite automaton that accepts all strings within a given maximum
+ * Levenshtein distance of a target string.
+ *
+ * The automaton is built up front from the target string. Each state corresponds
+ * to a (capped) row of the Levenshtein dynamic programming matrix, and only the
+ * characters of the target that can affect the next row get explicit transitions;
+ * all other characters share a single "wildcard" transition. For max edits 1 and 2
+ * the number of states is linear in the length of the target.
+ *
+ * In addition to matching, the automaton can compute the lexicographically smallest
+ * string (in code point order) that is greater than a non-matching source string
+ * and that is accepted by the automaton. When matching against a sorted dictionary
+ * this "successor" can be used to seek past all entries that cannot possibly match,
+ * instead of visiting every entry in the dictionary.
+ *
+ * When uncased, both the target and the source strings are lowercased before
+ * matching, and any produced successor string is lowercased as well. The successor
+ * is then ordered consistently with a dictionary that is sorted on folded values.
+ *
+ * An optional prefix length marks a leading part of the target that must be
+ * matched exactly, mirroring the semantics of FuzzyMatcher.
+ */
+class LevenshteinDfa {
+public:
+    enum class Casing { Uncased, Cased };
+
+    class MatchResult {
+        uint8_t _max_edits;
+        uint8_t _edits;
+    public:
+        constexpr MatchResult(uint8_t max_edits, uint8_t edits) noexcept
+            : _max_edits(max_edits),
+              _edits(edits)
+        {}
+        static constexpr MatchResult make_match(uint8_t max_edits, uint8_t edits) noexcept {
+            return {max_edits, edits};
+        }
+        static constexpr MatchResult make_mismatch(uint8_t max_edits) noexcept {
+            return {max_edits, static_cast<uint8_t>(max_edits + 1)};
+        }
+        [[nodiscard]] constexpr bool matches() const noexcept { return _edits <= _max_edits; }
+        [[nodiscard]] constexpr uint8_t edits() const noexcept { return _edits; }
+        [[nodiscard]] constexpr uint8_t max_edits() const noexcept { return _max_edits; }
+    };
+
+    static constexpr uint8_t MaxSupportedEdits = 2;
+
+private:
+    struct Edge {
+        uint32_t ch;
+        uint32_t next;
+    };
+    struct State {
+        uint32_t edges_begin;
+        uint32_t edges_end;
+        uint32_t wildcard_next;
+        uint8_t  edits; // edits needed if accepting, otherwise larger than max edits
+    };
+    struct CharAndState {
+        uint32_t ch;
+        uint32_t state;
+    };
+
+    static constexpr uint32_t DEAD = 0;
+    static constexpr uint32_t START = 1;
+
+    std::vector<State> _states;
+    std::vector<Edge>  _edges;
+    uint8_t            _max_edits;
+    Casing             _casing;
+
+    LevenshteinDfa(std::vector<State> states, std::vector<Edge> edges, uint8_t max_edits, Casing casing);
+
+    [[nodiscard]] uint32_t step(uint32_t state, uint32_t ch) const noexcept;
+    [[nodiscard]] bool accepting(uint32_t state) const noexcept { return _states[state].edits <= _max_edits; }
+    [[nodiscard]] CharAndState smallest_live_transition_above(uint32_t state, uint32_t ch) const noexcept;
+    void append_smallest_completion(uint32_t state, std::string& out) const;
+    void make_successor(std::span<const uint32_t> source, std::string& successor_out) const;
+    [[nodiscard]] uint32_t fold(uint32_t ch) const noexcept;
+public:
+    LevenshteinDfa(LevenshteinDfa&&) noexcept;
+    LevenshteinDfa& operator=(LevenshteinDfa&&) noexcept;
+    ~LevenshteinDfa();
+
+    /**
+     * Builds an automaton matching all strings within max_edits of target.
+     * The first prefix_size characters of target must match exactly. If the
+     * prefix size exceeds the length of the target, only exact matches are accepted.
+     *
+     * Throws std::invalid_argument if max_edits exceeds MaxSupportedEdits.
+     */
+    static LevenshteinDfa build(std::string_view target, uint8_t max_edits, Casing casing, uint32_t prefix_size = 0);
+
+    /**
+     * Matches source (UTF-8) against the automaton. If there is no match and
+     * successor_out is non-null, it is set to the smallest string greater than
+     * source that can match. If no such string exists, successor_out is cleared.
+     */
+    [[nodiscard]] MatchResult match(std::string_view source, std::string* successor_out) const;
+
+    [[nodiscard]] uint8_t max_edits() const noexcept { return _max_edits; }
+    [[nodiscard]] Casing casing() const noexcept { return _casing; }
+    [[nodiscard]] size_t num_states() const noexcept { return _states.size(); }
+    [[nodiscard]] size_t memory_usage() const noexcept;
+};
+
+}
@@ -5,6 +5,24 @@
 
 namespace vespalib::hwaccelrated {
 
+int64_t
+Avx2Accelrator::dotProduct(const int8_t * a, const int8_t * b, size_t sz) const
+{
+    return helper::dotProduct(a, b, sz);
+}
+
+float
+Avx2Accelrator::dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) const
+{
+    return avx::bfloat16DotProduct<BFloat16, BFloat16, 32>(a, b, sz);
+}
+
+float
+Avx2Accelrator::dotProduct(const BFloat16 * a, const float * b, size_t sz) const
+{
+    return avx::bfloat16DotProduct<BFloat16, float, 32>(a, b, sz);
+}
+
 size_t
 Avx2Accelrator::populationCount(const uint64_t *a, size_t sz) const {
     return helper::populationCount(a, sz);
@@ -25,6 +43,16 @@ Avx2Accelrator::squaredEuclideanDistance(const double * a, const double * b, siz
     return avx::euclideanDistanceSelectAlignment<double, 32>(a, b, sz);
 }
 
+double
+Avx2Accelrator::squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * b, size_t sz) const {
+    return avx::bfloat16EuclideanDistance<BFloat16, BFloat16, 32>(a, b, sz);
+}
+
+double
+Avx2Accelrator::squaredEuclideanDistance(const BFloat16 * a, const float * b, size_t sz) const {
+    return avx::bfloat16EuclideanDistance<BFloat16, float, 32>(a, b, sz);
+}
+
 void
 Avx2Accelrator::and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
     helper::andChunks<32u, 2u>(offset, src, dest);
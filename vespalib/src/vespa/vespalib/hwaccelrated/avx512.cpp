@@ -2,9 +2,51 @@
 
 #include "avx512.h"
 #include "avxprivate.hpp"
+#include <immintrin.h>
 
 namespace vespalib:: hwaccelrated {
 
+namespace {
+
+__attribute__((target("avx512bf16")))
+inline __m512bh
+loadBFloat16(const BFloat16 * p, __mmask32 mask) {
+    return (__m512bh)_mm512_maskz_loadu_epi16(mask, p);
+}
+
+// Note that the instruction treats denormals as zero, regardless of MXCSR
+__attribute__((target("avx512bf16")))
+float
+nativeBFloat16DotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz)
+{
+    constexpr __mmask32 all = ~__mmask32(0);
+    __m512 sum0 = _mm512_setzero_ps();
+    __m512 sum1 = _mm512_setzero_ps();
+    size_t i(0);
+    for (; i + 64 <= sz; i += 64) {
+        sum0 = _mm512_dpbf16_ps(sum0, loadBFloat16(a + i, all), loadBFloat16(b + i, all));
+        sum1 = _mm512_dpbf16_ps(sum1, loadBFloat16(a + i + 32, all), loadBFloat16(b + i + 32, all));
+    }
+    for (; i < sz; i += 32) {
+        __mmask32 mask = (sz - i >= 32) ? all : __mmask32((1u << (sz - i)) - 1);
+        sum0 = _mm512_dpbf16_ps(sum0, loadBFloat16(a + i, mask), loadBFloat16(b + i, mask));
+    }
+    alignas(64) float partial[16];
+    _mm512_store_ps(partial, _mm512_add_ps(sum0, sum1));
+    float sum(0);
+    for (float v : partial) {
+        sum += v;
+    }
+    return sum;
+}
+
+}
+
+Avx512Accelrator::Avx512Accelrator()
+    : _nativeBFloat16(__builtin_cpu_supports("avx512bf16"))
+{
+}
+
 float
 Avx512Accelrator::dotProduct(const float * af, const float * bf, size_t sz) const
 {
@@ -17,6 +59,27 @@ Avx512Accelrator::dotProduct(const double * af, const double * bf, size_t sz) co
     return avx::dotProductSelectAlignment<double, 64>(af, bf, sz);
 }
 
+int64_t
+Avx512Accelrator::dotProduct(const int8_t * a, const int8_t * b, size_t sz) const
+{
+    return helper::dotProduct(a, b, sz);
+}
+
+float
+Avx512Accelrator::dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) const
+{
+    if (_nativeBFloat16) {
+        return nativeBFloat16DotProduct(a, b, sz);
+    }
+    return avx::bfloat16DotProduct<BFloat16, BFloat16, 64>(a, b, sz);
+}
+
+float
+Avx512Accelrator::dotProduct(const BFloat16 * a, const float * b, size_t sz) const
+{
+    return avx::bfloat16DotProduct<BFloat16, float, 64>(a, b, sz);
+}
+
 size_t
 Avx512Accelrator::populationCount(const uint64_t *a, size_t sz) const {
     return helper::populationCount(a, sz);
@@ -37,6 +100,16 @@ Avx512Accelrator::squaredEuclideanDistance(const double * a, const double * b, s
     return avx::euclideanDistanceSelectAlignment<double, 64>(a, b, sz);
 }
 
+double
+Avx512Accelrator::squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * b, size_t sz) const {
+    return avx::bfloat16EuclideanDistance<BFloat16, BFloat16, 64>(a, b, sz);
+}
+
+double
+Avx512Accelrator::squaredEuclideanDistance(const BFloat16 * a, const float * b, size_t sz) const {
+    return avx::bfloat16EuclideanDistance<BFloat16, float, 64>(a, b, sz);
+}
+
 void
 Avx512Accelrator::and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
     helper::andChunks<64, 1>(offset, src, dest);
@@ -8,16 +8,25 @@ namespace vespalib::hwaccelrated {
 
 /**
  * Avx-512 implementation.
+ * Uses the AVX512_BF16 dot product instruction for bfloat16 vectors when available.
  */
 class Avx512Accelrator : public Avx2Accelrator
 {
+private:
+    bool _nativeBFloat16;
 public:
+    Avx512Accelrator();
     float dotProduct(const float * a, const float * b, size_t sz) const override;
     double dotProduct(const double * a, const double * b, size_t sz) const override;
+    int64_t dotProduct(const int8_t * a, const int8_t * b, size_t sz) const override;
+    float dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) const override;
+    float dotProduct(const BFloat16 * a, const float * b, size_t sz) const override;
     size_t populationCount(const uint64_t *a, size_t sz) const override;
     double squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const override;
     double squaredEuclideanDistance(const float * a, const float * b, size_t sz) const override;
     double squaredEuclideanDistance(const double * a, const double * b, size_t sz) const override;
+    double squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * b, size_t sz) const override;
+    double squaredEuclideanDistance(const BFloat16 * a, const float * b, size_t sz) const override;
     void and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const override;
     void or64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const override;
 };
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "private_helpers.hpp"
+#include <vespa/vespalib/util/bfloat16.h>
 #include <vespa/fastos/types.h>
 
 namespace vespalib::hwaccelrated::avx {
@@ -63,6 +64,92 @@ T computeDotProduct(const T * af, const T * bf, size_t sz)
     return sum + sumT<T, V>(partial[0]);
 }
 
+// gcc does not handle vector types with dependent sizes well, so widening is done by specializations
+typedef uint16_t U16x8 __attribute__ ((vector_size (16)));
+typedef uint16_t U16x16 __attribute__ ((vector_size (32)));
+typedef uint32_t U32x8 __attribute__ ((vector_size (32)));
+typedef uint32_t U32x16 __attribute__ ((vector_size (64)));
+
+template <unsigned VLEN> struct Widen;
+template <> struct Widen<32> {
+    using H = U16x8;
+    static void apply(const H & h, U32x8 & u) { u = __builtin_convertvector(h, U32x8); }
+};
+template <> struct Widen<64> {
+    using H = U16x16;
+    static void apply(const H & h, U32x16 & u) { u = __builtin_convertvector(h, U32x16); }
+};
+
+/**
+ * Loads VLEN bytes of float values, converting from bfloat16 as needed.
+ * A bfloat16 is the upper half of a float, so conversion is a shift.
+ */
+template <unsigned VLEN>
+struct FloatLoader {
+    typedef float V __attribute__ ((vector_size (VLEN)));
+    typedef float F __attribute__ ((vector_size (VLEN), aligned(1)));
+    typedef uint32_t U __attribute__ ((vector_size (VLEN)));
+    static constexpr size_t N = VLEN/sizeof(float);
+    static V load(const float * p) { return *reinterpret_cast<const F *>(p); }
+    static V load(const BFloat16 * p) {
+        typename Widen<VLEN>::H h;
+        memcpy(&h, p, sizeof(h));
+        U u;
+        Widen<VLEN>::apply(h, u);
+        return (V)(u << 16);
+    }
+};
+
+}
+
+template <typename TA, typename TB, unsigned VLEN>
+float
+bfloat16DotProduct(const TA * a, const TB * b, size_t sz)
+{
+    using L = FloatLoader<VLEN>;
+    constexpr size_t VectorsPerChunk = 4;
+    constexpr size_t ChunkSize = L::N*VectorsPerChunk;
+    typename L::V partial[VectorsPerChunk];
+    memset(partial, 0, sizeof(partial));
+    const size_t numChunks(sz/ChunkSize);
+    for (size_t i(0); i < numChunks; i++) {
+        for (size_t j(0); j < VectorsPerChunk; j++) {
+            size_t offset = i*ChunkSize + j*L::N;
+            partial[j] += L::load(a + offset) * L::load(b + offset);
+        }
+    }
+    float sum(0);
+    for (size_t i(numChunks*ChunkSize); i < sz; i++) {
+        sum += float(a[i]) * float(b[i]);
+    }
+    partial[0] = sumR<typename L::V, VectorsPerChunk>(partial);
+    return sum + sumT<float, typename L::V>(partial[0]);
+}
+
+template <typename TA, typename TB, unsigned VLEN>
+double
+bfloat16EuclideanDistance(const TA * a, const TB * b, size_t sz)
+{
+    using L = FloatLoader<VLEN>;
+    constexpr size_t VectorsPerChunk = 4;
+    constexpr size_t ChunkSize = L::N*VectorsPerChunk;
+    typename L::V partial[VectorsPerChunk];
+    memset(partial, 0, sizeof(partial));
+    const size_t numChunks(sz/ChunkSize);
+    for (size_t i(0); i < numChunks; i++) {
+        for (size_t j(0); j < VectorsPerChunk; j++) {
+            size_t offset = i*ChunkSize + j*L::N;
+            typename L::V d = L::load(a + offset) - L::load(b + offset);
+            partial[j] += d * d;
+        }
+    }
+    double sum(0);
+    for (size_t i(numChunks*ChunkSize); i < sz; i++) {
+        float d = float(a[i]) - float(b[i]);
+        sum += d * d;
+    }
+    partial[0] = sumR<typename L::V, VectorsPerChunk>(partial);
+    return sum + sumT<float, typename L::V>(partial[0]);
 }
 
 template <typename T, size_t VLEN, size_t VectorsPerChunk=4>
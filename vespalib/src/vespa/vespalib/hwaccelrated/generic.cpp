@@ -2,6 +2,7 @@
 
 #include "generic.h"
 #include "private_helpers.hpp"
+#include <vespa/vespalib/util/bfloat16.h>
 #include <cblas.h>
 
 namespace vespalib::hwaccelrated {
@@ -58,6 +59,56 @@ squaredEuclideanDistanceT(const T * a, const T * b, size_t sz)
     return sum;
 }
 
+template <typename TA, typename TB, size_t UNROLL>
+float
+bfloat16DotProduct(const TA * a, const TB * b, size_t sz)
+{
+    float partial[UNROLL];
+    for (size_t i(0); i < UNROLL; i++) {
+        partial[i] = 0;
+    }
+    size_t i(0);
+    for (; i + UNROLL <= sz; i += UNROLL) {
+        for (size_t j(0); j < UNROLL; j++) {
+            partial[j] += float(a[i+j]) * float(b[i+j]);
+        }
+    }
+    for (;i < sz; i++) {
+        partial[i%UNROLL] += float(a[i]) * float(b[i]);
+    }
+    float sum(0);
+    for (size_t j(0); j < UNROLL; j++) {
+        sum += partial[j];
+    }
+    return sum;
+}
+
+template <typename TA, typename TB, size_t UNROLL>
+double
+bfloat16SquaredEuclideanDistance(const TA * a, const TB * b, size_t sz)
+{
+    float partial[UNROLL];
+    for (size_t i(0); i < UNROLL; i++) {
+        partial[i] = 0;
+    }
+    size_t i(0);
+    for (; i + UNROLL <= sz; i += UNROLL) {
+        for (size_t j(0); j < UNROLL; j++) {
+            float d = float(a[i+j]) - float(b[i+j]);
+            partial[j] += d * d;
+        }
+    }
+    for (;i < sz; i++) {
+        float d = float(a[i]) - float(b[i]);
+        partial[i%UNROLL] += d * d;
+    }
+    double sum(0);
+    for (size_t j(0); j < UNROLL; j++) {
+        sum += partial[j];
+    }
+    return sum;
+}
+
 template<size_t UNROLL, typename Operation>
 void
 bitOperation(Operation operation, void * aOrg, const void * bOrg, size_t bytes) {
@@ -121,6 +172,18 @@ GenericAccelrator::dotProduct(const int64_t * a, const int64_t * b, size_t sz) c
     return multiplyAdd<long long, int64_t, 8>(a, b, sz);
 }
 
+float
+GenericAccelrator::dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) const
+{
+    return bfloat16DotProduct<BFloat16, BFloat16, 8>(a, b, sz);
+}
+
+float
+GenericAccelrator::dotProduct(const BFloat16 * a, const float * b, size_t sz) const
+{
+    return bfloat16DotProduct<BFloat16, float, 8>(a, b, sz);
+}
+
 void
 GenericAccelrator::orBit(void * aOrg, const void * bOrg, size_t bytes) const
 {
@@ -172,6 +235,16 @@ GenericAccelrator::squaredEuclideanDistance(const double * a, const double * b,
     return squaredEuclideanDistanceT<double, 2>(a, b, sz);
 }
 
+double
+GenericAccelrator::squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * b, size_t sz) const {
+    return bfloat16SquaredEuclideanDistance<BFloat16, BFloat16, 2>(a, b, sz);
+}
+
+double
+GenericAccelrator::squaredEuclideanDistance(const BFloat16 * a, const float * b, size_t sz) const {
+    return bfloat16SquaredEuclideanDistance<BFloat16, float, 2>(a, b, sz);
+}
+
 void
 GenericAccelrator::and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
     helper::andChunks<16, 4>(offset, src, dest);
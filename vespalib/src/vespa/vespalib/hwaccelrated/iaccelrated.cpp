@@ -6,6 +6,7 @@
 #include "avx2.h"
 #include "avx512.h"
 #endif
+#include <vespa/vespalib/util/bfloat16.h>
 #include <vespa/vespalib/util/memory.h>
 #include <cstdio>
 #include <vector>
@@ -80,6 +81,33 @@ verifyEuclideanDistance(const IAccelrated & accel) {
     }
 }
 
+// Small integers are exact in bfloat16, and all sums are exact in float
+template<typename B>
+void
+verifyBFloat16(const IAccelrated & accel)
+{
+    const size_t testLength(255);
+    srand(1);
+    std::vector<BFloat16> a = createAndFill<BFloat16>(testLength);
+    std::vector<B> b = createAndFill<B>(testLength);
+    for (size_t j(0); j < 0x20; j++) {
+        float dot(0);
+        float distance(0);
+        for (size_t i(j); i < testLength; i++) {
+            dot += float(a[i]) * float(b[i]);
+            distance += (float(a[i]) - float(b[i])) * (float(a[i]) - float(b[i]));
+        }
+        if (dot != accel.dotProduct(&a[j], &b[j], testLength - j)) {
+            fprintf(stderr, "Accelrator is not computing bfloat16 dotproduct correctly.\n");
+            LOG_ABORT("should not be reached");
+        }
+        if (distance != accel.squaredEuclideanDistance(&a[j], &b[j], testLength - j)) {
+            fprintf(stderr, "Accelrator is not computing bfloat16 euclidean distance correctly.\n");
+            LOG_ABORT("should not be reached");
+        }
+    }
+}
+
 void
 verifyPopulationCount(const IAccelrated & accel)
 {
@@ -222,6 +250,8 @@ private:
         verifyDotproduct<int64_t>(accelrated);
         verifyEuclideanDistance<float>(accelrated);
         verifyEuclideanDistance<double>(accelrated);
+        verifyBFloat16<BFloat16>(accelrated);
+        verifyBFloat16<float>(accelrated);
         verifyPopulationCount(accelrated);
         verifyAnd64(accelrated);
         verifyOr64(accelrated);
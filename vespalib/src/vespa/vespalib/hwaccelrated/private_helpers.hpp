@@ -90,6 +90,31 @@ double squaredEuclideanDistanceT(const int8_t * a, const int8_t * b, size_t sz)
     return sum;
 }
 
+template<typename TemporaryT=int32_t>
+int64_t dotProductT(const int8_t * a, const int8_t * b, size_t sz) __attribute__((noinline));
+template<typename TemporaryT>
+int64_t dotProductT(const int8_t * a, const int8_t * b, size_t sz)
+{
+    TemporaryT sum = 0;
+    for (size_t i(0); i < sz; i++) {
+        sum += int16_t(a[i]) * int16_t(b[i]);
+    }
+    return sum;
+}
+
+inline int64_t
+dotProduct(const int8_t * a, const int8_t * b, size_t sz) {
+    // 0x10000 products of at most 128*128 will not overflow the int32_t accumulator
+    constexpr size_t LOOP_COUNT = 0x10000;
+    int64_t sum(0);
+    size_t i=0;
+    for (; i + LOOP_COUNT <= sz; i += LOOP_COUNT) {
+        sum += dotProductT<int32_t>(a + i, b + i, LOOP_COUNT);
+    }
+    sum += dotProductT<int32_t>(a + i, b + i, sz - i);
+    return sum;
+}
+
 inline double
 squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) {
     constexpr size_t LOOP_COUNT = 0x10000;
@@ -51,6 +51,10 @@ public:
     ssize_t read(char *buf, size_t len) override { return _socket.read(buf, len); }
     ssize_t drain(char *, size_t) override { return 0; }
     ssize_t write(const char *buf, size_t len) override { return _socket.write(buf, len); }
+    ssize_t writev(const struct iovec *iov, int iovcnt) override { return _socket.writev(iov, iovcnt); }
+    bool enable_zero_copy() override { return _socket.set_zero_copy(true); }
+    ssize_t write_zero_copy(const char *buf, size_t len) override { return _socket.write_zero_copy(buf, len); }
+    bool read_zero_copy_completion(uint32_t &lo, uint32_t &hi) override { return _socket.read_zero_copy_completion(lo, hi); }
     ssize_t flush() override { return 0; }
     ssize_t half_close() override { return _socket.half_close(); }
     void drop_empty_buffers() override {}
@@ -1,9 +1,45 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "crypto_socket.h"
+#include <sys/uio.h>
 
 namespace vespalib {
 
 CryptoSocket::~CryptoSocket() = default;
 
+ssize_t
+CryptoSocket::writev(const struct iovec *iov, int iovcnt)
+{
+    ssize_t written = 0;
+    for (int i = 0; i < iovcnt; ++i) {
+        ssize_t res = write(static_cast<const char *>(iov[i].iov_base), iov[i].iov_len);
+        if (res < 0) {
+            return (written > 0) ? written : res;
+        }
+        written += res;
+        if (size_t(res) < iov[i].iov_len) {
+            break;
+        }
+    }
+    return written;
+}
+
+bool
+CryptoSocket::enable_zero_copy()
+{
+    return false;
+}
+
+ssize_t
+CryptoSocket::write_zero_copy(const char *buf, size_t len)
+{
+    return write(buf, len);
+}
+
+bool
+CryptoSocket::read_zero_copy_completion(uint32_t &, uint32_t &)
+{
+    return false;
+}
+
 } // namespace vespalib
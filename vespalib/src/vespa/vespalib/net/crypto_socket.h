@@ -3,8 +3,11 @@
 #pragma once
 
 #include <memory>
+#include <cstdint>
 #include <cstdlib>
 
+struct iovec;
+
 namespace vespalib {
 
 /**
@@ -85,6 +88,40 @@ struct CryptoSocket {
      **/
     virtual ssize_t write(const char *buf, size_t len) = 0;
 
+    /**
+     * Write data from multiple buffers. The semantics are the same as
+     * with a normal socket writev. The default implementation writes
+     * the buffers in order using the write function, stopping after
+     * the first partial write or error. Sockets that can pass data
+     * straight through to the underlying socket should override this
+     * to gather all buffers in a single system call.
+     **/
+    virtual ssize_t writev(const struct iovec *iov, int iovcnt);
+
+    /**
+     * Try to enable zero copy sending for this socket. Should only be
+     * called after the handshake is done. Returns false if zero copy
+     * is not supported, which is the default. When enabled, data
+     * written with write_zero_copy must be kept unchanged until it
+     * has been reported as completed by read_zero_copy_completion.
+     **/
+    virtual bool enable_zero_copy();
+
+    /**
+     * Write data using zero copy send if enabled. Each successful
+     * call is assigned the next sequence number, starting at 0. The
+     * default implementation is a normal write.
+     **/
+    virtual ssize_t write_zero_copy(const char *buf, size_t len);
+
+    /**
+     * Read a single zero copy completion notification. Returns false
+     * if there was none, otherwise the inclusive range of completed
+     * sequence numbers is returned in lo and hi. Should be called
+     * when the underlying socket signals an error condition.
+     **/
+    virtual bool read_zero_copy_completion(uint32_t &lo, uint32_t &hi);
+
     /**
      * Try to flush data in the write pipeline that is not dependent
      * on data not yet written by the application into the underlying
@@ -2,8 +2,13 @@
 
 #include "socket_handle.h"
 #include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
 #include <errno.h>
 #include <cassert>
+#ifdef __linux__
+#include <linux/errqueue.h>
+#endif
 
 namespace vespalib {
 
@@ -29,6 +34,68 @@ SocketHandle::write(const char *buf, size_t len)
     }
 }
 
+ssize_t
+SocketHandle::writev(const struct iovec *iov, int iovcnt)
+{
+    for (;;) {
+        ssize_t result = ::writev(_fd, iov, iovcnt);
+        if ((result >= 0) || (errno != EINTR)) {
+            return result;
+        }
+    }
+}
+
+ssize_t
+SocketHandle::write_zero_copy(const char *buf, size_t len)
+{
+#ifdef MSG_ZEROCOPY
+    for (;;) {
+        ssize_t result = ::send(_fd, buf, len, MSG_ZEROCOPY);
+        if ((result >= 0) || (errno != EINTR)) {
+            return result;
+        }
+    }
+#else
+    return write(buf, len);
+#endif
+}
+
+bool
+SocketHandle::read_zero_copy_completion(uint32_t &lo, uint32_t &hi)
+{
+#if defined(__linux__) && defined(SO_EE_ORIGIN_ZEROCOPY)
+    char control[128];
+    struct msghdr msg = {};
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    for (;;) {
+        if (::recvmsg(_fd, &msg, MSG_ERRQUEUE) >= 0) {
+            break;
+        }
+        if (errno != EINTR) {
+            return false;
+        }
+    }
+    for (struct cmsghdr *cm = CMSG_FIRSTHDR(&msg); cm != nullptr; cm = CMSG_NXTHDR(&msg, cm)) {
+        if (((cm->cmsg_level == SOL_IP) && (cm->cmsg_type == IP_RECVERR)) ||
+            ((cm->cmsg_level == SOL_IPV6) && (cm->cmsg_type == IPV6_RECVERR)))
+        {
+            const auto *err = reinterpret_cast<const struct sock_extended_err *>(CMSG_DATA(cm));
+            if ((err->ee_errno == 0) && (err->ee_origin == SO_EE_ORIGIN_ZEROCOPY)) {
+                lo = err->ee_info;
+                hi = err->ee_data;
+                return true;
+            }
+        }
+    }
+    return false;
+#else
+    (void) lo;
+    (void) hi;
+    return false;
+#endif
+}
+
 SocketHandle
 SocketHandle::accept()
 {
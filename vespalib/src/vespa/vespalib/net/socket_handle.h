@@ -3,8 +3,11 @@
 #pragma once
 
 #include "socket_options.h"
+#include <cstdint>
 #include <unistd.h>
 
+struct iovec;
+
 namespace vespalib {
 
 /**
@@ -54,9 +57,28 @@ public:
     bool set_ipv6_only(bool value) { return SocketOptions::set_ipv6_only(_fd, value); }
     bool set_keepalive(bool value) { return SocketOptions::set_keepalive(_fd, value); }
     bool set_linger(bool enable, int value) { return SocketOptions::set_linger(_fd, enable, value); }
+    bool set_zero_copy(bool value) { return SocketOptions::set_zero_copy(_fd, value); }
 
     ssize_t read(char *buf, size_t len);
     ssize_t write(const char *buf, size_t len);
+    ssize_t writev(const struct iovec *iov, int iovcnt);
+
+    /**
+     * Send data with MSG_ZEROCOPY. The data must be kept unchanged
+     * until the send is reported as completed by
+     * read_zero_copy_completion. Each successful call is assigned the
+     * next sequence number, starting at 0. Only valid after zero copy
+     * has been enabled for the socket.
+     **/
+    ssize_t write_zero_copy(const char *buf, size_t len);
+
+    /**
+     * Read a single zero copy completion notification from the socket
+     * error queue. Returns false if there was none, otherwise the
+     * range of completed send sequence numbers is returned in lo and
+     * hi (inclusive).
+     **/
+    bool read_zero_copy_completion(uint32_t &lo, uint32_t &hi);
     SocketHandle accept();
     void shutdown();
     int half_close();
@@ -3,26 +3,40 @@
 #include "wakeup_pipe.h"
 #include "socket_utils.h"
 #include <unistd.h>
+#include <cassert>
+#include <cstdint>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
 
 namespace vespalib {
 
 WakeupPipe::WakeupPipe()
     : _pipe()
 {
+#ifdef __linux__
+    _pipe[0] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    assert(_pipe[0] >= 0);
+    _pipe[1] = _pipe[0];
+#else
     socketutils::nonblocking_pipe(_pipe);
+#endif
 }
 
 WakeupPipe::~WakeupPipe()
 {
     close(_pipe[0]);
-    close(_pipe[1]);
+    if (_pipe[1] != _pipe[0]) {
+        close(_pipe[1]);
+    }
 }
 
 void
 WakeupPipe::write_token()
 {
-    char token = 'T';
-    [[maybe_unused]] ssize_t res = write(_pipe[1], &token, 1);
+    // eventfd needs 8 bytes, which also works fine for a pipe
+    uint64_t token = 1;
+    [[maybe_unused]] ssize_t res = write(_pipe[1], &token, sizeof(token));
 }
 
 void
@@ -11,7 +11,9 @@ namespace vespalib {
  * blocking call to epoll_wait. The pipe readability is part of the
  * selection set and a wakeup is triggered by writing to the
  * pipe. When a wakeup is detected, pending tokens will be read and
- * discarded to avoid spurious wakeups in the future.
+ * discarded to avoid spurious wakeups in the future. On linux an
+ * eventfd is used instead of an actual pipe, which needs a single
+ * file descriptor and never fills up.
  **/
 class WakeupPipe {
 private:
@@ -4,6 +4,7 @@
 #include "lrucache_map.h"
 #include <atomic>
 #include <mutex>
+#include <vector>
 
 namespace vespalib {
 
@@ -105,6 +106,28 @@ public:
      */
     void write(const K & key, V value);
 
+    /**
+     * Holds the locks that read() holds while consulting the backing store, for a set of keys.
+     * Hold it while reading the objects outside the cache and populating the cache with them.
+     */
+    class ReadGuard {
+    public:
+        ReadGuard(ReadGuard &&) noexcept = default;
+        ~ReadGuard() = default;
+    private:
+        friend class cache;
+        ReadGuard() : _guards() { }
+        std::vector<std::unique_lock<std::mutex>> _guards;
+    };
+    ReadGuard getReadGuard(const std::vector<K> & keys);
+
+    /**
+     * Insert an object read from the backing store while holding the read guard for its key,
+     * unless it is already cached.
+     * Object is then put at head of LRU list.
+     */
+    void populate(const ReadGuard & guard, const K & key, V value);
+
     /**
      * Tell if an object with given key exists in the cache.
      * Does not alter the LRU list.
@@ -137,10 +160,11 @@ private:
      */
     bool removeOldest(const value_type & v) override;
     size_t calcSize(const K & k, const V & v) const { return sizeof(value_type) + _sizeK(k) + _sizeV(v); }
-    std::mutex & getLock(const K & k) {
+    size_t getLockId(const K & k) const {
         size_t h(_hasher(k));
-        return _addLocks[h%(sizeof(_addLocks)/sizeof(_addLocks[0]))];
+        return h%(sizeof(_addLocks)/sizeof(_addLocks[0]));
     }
+    std::mutex & getLock(const K & k) { return _addLocks[getLockId(k)]; }
 
     template <typename V>
     static void increment_stat(std::atomic<V>& v, const std::lock_guard<std::mutex>&) {
@@ -4,6 +4,7 @@
 #include "cache.h"
 #include "cache_stats.h"
 #include "lrucache_map.hpp"
+#include <algorithm>
 
 namespace vespalib {
 
@@ -136,6 +137,39 @@ cache<P>::write(const K & key, V value)
     }
 }
 
+template< typename P >
+typename cache<P>::ReadGuard
+cache<P>::getReadGuard(const std::vector<K> & keys)
+{
+    std::vector<size_t> lockIds;
+    lockIds.reserve(keys.size());
+    for (const K & key : keys) {
+        lockIds.push_back(getLockId(key));
+    }
+    // Always lock in the same order to avoid deadlock between concurrent batches.
+    std::sort(lockIds.begin(), lockIds.end());
+    lockIds.erase(std::unique(lockIds.begin(), lockIds.end()), lockIds.end());
+    ReadGuard readGuard;
+    readGuard._guards.reserve(lockIds.size());
+    for (size_t lockId : lockIds) {
+        readGuard._guards.emplace_back(_addLocks[lockId]);
+    }
+    return readGuard;
+}
+
+template< typename P >
+void
+cache<P>::populate(const ReadGuard &, const K & key, V value)
+{
+    std::lock_guard guard(_hashLock);
+    if ( ! Lru::hasKey(key)) {
+        size_t newSize = calcSize(key, value);
+        Lru::insert(key, std::move(value));
+        _sizeBytes.store(sizeBytes() + newSize, std::memory_order_relaxed);
+        increment_stat(_insert, guard);
+    }
+}
+
 template< typename P >
 void
 cache<P>::erase(const K & key)
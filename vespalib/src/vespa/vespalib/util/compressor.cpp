@@ -80,13 +80,11 @@ CompressionConfig::Type
 compress(CompressionConfig::Type compression, const ConstBufferRef & org, DataBuffer & dest, bool allowSwap) {
     return compress(CompressionConfig(compression), org, dest, allowSwap);
 }
+namespace {
+
 CompressionConfig::Type
-compress(const CompressionConfig & compression, const ConstBufferRef & org, DataBuffer & dest, bool allowSwap)
+storeUncompressedIfNeeded(CompressionConfig::Type type, const ConstBufferRef & org, DataBuffer & dest, bool allowSwap)
 {
-    CompressionConfig::Type type(CompressionConfig::NONE);
-    if (org.size() >= compression.minSize) {
-        type = docompress(compression, org, dest);
-    }
     if ((type == CompressionConfig::NONE) || (type == CompressionConfig::NONE_MULTI)) {
         if (allowSwap) {
             DataBuffer tmp(const_cast<char *>(org.c_str()), org.size());
@@ -99,6 +97,28 @@ compress(const CompressionConfig & compression, const ConstBufferRef & org, Data
     return type;
 }
 
+}
+
+CompressionConfig::Type
+compress(const CompressionConfig & compression, const ConstBufferRef & org, DataBuffer & dest, bool allowSwap)
+{
+    CompressionConfig::Type type(CompressionConfig::NONE);
+    if (org.size() >= compression.minSize) {
+        type = docompress(compression, org, dest);
+    }
+    return storeUncompressedIfNeeded(type, org, dest, allowSwap);
+}
+
+CompressionConfig::Type
+compress(ICompressor & compressor, const CompressionConfig & compression, const ConstBufferRef & org, DataBuffer & dest, bool allowSwap)
+{
+    CompressionConfig::Type type(CompressionConfig::NONE);
+    if (compression.useCompression() && (org.size() >= compression.minSize)) {
+        type = compress(compressor, compression, org, dest);
+    }
+    return storeUncompressedIfNeeded(type, org, dest, allowSwap);
+}
+
 
 void
 decompress(ICompressor & decompressor, size_t uncompressedLen, const ConstBufferRef & org, DataBuffer & dest, bool allowSwap)
@@ -43,6 +43,14 @@ CompressionConfig::Type compress(const CompressionConfig & compression, const ve
  */
 void decompress(const CompressionConfig::Type & compression, size_t uncompressedLen, const vespalib::ConstBufferRef & org, vespalib::DataBuffer & dest, bool allowSwap);
 
+/**
+ * Same as above, but using the given compressor instead of one selected by
+ * the compression type. Used for compressors that need extra state, like a
+ * dictionary. The compression type in the config must match the compressor.
+ */
+CompressionConfig::Type compress(ICompressor & compressor, const CompressionConfig & compression, const ConstBufferRef & org, DataBuffer & dest, bool allowSwap);
+void decompress(ICompressor & decompressor, size_t uncompressedLen, const ConstBufferRef & org, DataBuffer & dest, bool allowSwap);
+
 size_t computeMaxCompressedsize(CompressionConfig::Type type, size_t uncompressedSize);
 
 //-----------------------------------------------------------------------------
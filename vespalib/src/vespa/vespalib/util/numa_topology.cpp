@@ -0,0 +1,166 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "numa_topology.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <pthread.h>
+#include <sched.h>
+
+namespace vespalib {
+
+namespace {
+
+std::string
+read_first_line(const std::string& path)
+{
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+NumaTopology::CpuList
+filter_cpus(const NumaTopology::CpuList& cpus, const NumaTopology::CpuList& usable_cpus)
+{
+    NumaTopology::CpuList result;
+    std::set_intersection(cpus.begin(), cpus.end(), usable_cpus.begin(), usable_cpus.end(), std::back_inserter(result));
+    return result;
+}
+
+}
+
+NumaTopology::BindGuard::BindGuard(const CpuList& cpus)
+    : _saved(current_affinity()),
+      _bound(!_saved.empty() && _saved != cpus && bind_current_thread(cpus))
+{
+}
+
+NumaTopology::BindGuard::~BindGuard()
+{
+    if (_bound) {
+        bind_current_thread(_saved);
+    }
+}
+
+NumaTopology::NumaTopology()
+    : NumaTopology("/sys/devices/system/node", current_affinity())
+{
+}
+
+NumaTopology::NumaTopology(const std::string& node_path, const CpuList& usable_cpus_in)
+    : _nodes(),
+      _cpu_to_node()
+{
+    CpuList usable_cpus(usable_cpus_in);
+    std::sort(usable_cpus.begin(), usable_cpus.end());
+    for (uint32_t node : parse_cpu_list(read_first_line(node_path + "/online"))) {
+        auto cpus = filter_cpus(parse_cpu_list(read_first_line(node_path + "/node" + std::to_string(node) + "/cpulist")), usable_cpus);
+        if (!cpus.empty()) {
+            _nodes.emplace_back(std::move(cpus));
+        }
+    }
+    if (_nodes.empty()) {
+        _nodes.emplace_back(std::move(usable_cpus));
+    }
+    for (size_t node = 0; node < _nodes.size(); ++node) {
+        for (uint32_t cpu : _nodes[node]) {
+            if (cpu >= _cpu_to_node.size()) {
+                _cpu_to_node.resize(cpu + 1, 0);
+            }
+            _cpu_to_node[cpu] = node;
+        }
+    }
+}
+
+NumaTopology::~NumaTopology() = default;
+
+size_t
+NumaTopology::node_of_cpu(uint32_t cpu) const noexcept
+{
+    return (cpu < _cpu_to_node.size()) ? _cpu_to_node[cpu] : 0;
+}
+
+size_t
+NumaTopology::current_node() const noexcept
+{
+#ifdef __linux__
+    int cpu = sched_getcpu();
+    if (cpu >= 0) {
+        return node_of_cpu(cpu);
+    }
+#endif
+    return 0;
+}
+
+NumaTopology::CpuList
+NumaTopology::parse_cpu_list(const std::string& str)
+{
+    CpuList result;
+    size_t pos = 0;
+    while (pos < str.size()) {
+        size_t end = std::min(str.find(',', pos), str.size());
+        auto range = str.substr(pos, end - pos);
+        pos = end + 1;
+        auto dash_pos = range.find('-');
+        try {
+            uint32_t first = std::stoul(range.substr(0, dash_pos));
+            uint32_t last = (dash_pos != std::string::npos) ? std::stoul(range.substr(dash_pos + 1)) : first;
+            for (uint32_t cpu = first; cpu <= last; ++cpu) {
+                result.push_back(cpu);
+            }
+        } catch (std::exception &) {
+            // Ignore malformed range (e.g. empty string or trailing newline)
+        }
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+NumaTopology::CpuList
+NumaTopology::current_affinity()
+{
+    CpuList result;
+#ifdef __linux__
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    if (pthread_getaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) == 0) {
+        for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &cpuset)) {
+                result.push_back(cpu);
+            }
+        }
+    }
+#endif
+    return result;
+}
+
+bool
+NumaTopology::bind_current_thread(const CpuList& cpus)
+{
+#ifdef __linux__
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    for (uint32_t cpu : cpus) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &cpuset);
+        }
+    }
+    return (CPU_COUNT(&cpuset) > 0) && (pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) == 0);
+#else
+    (void) cpus;
+    return false;
+#endif
+}
+
+Runnable::init_fun_t
+NumaTopology::wrap(Runnable::init_fun_t init, CpuList cpus)
+{
+    return [init = std::move(init), cpus = std::move(cpus)](Runnable &target) {
+        bind_current_thread(cpus);
+        return init(target);
+    };
+}
+
+}
@@ -0,0 +1,70 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "runnable.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vespalib {
+
+/*
+ * Class for getting the NUMA topology of the host (which cpus belong to
+ * which NUMA node) and for binding threads to the cpus of a single node.
+ *
+ * The topology is read from "/sys/devices/system/node" (cf. sysfs(5)
+ * manual page on Linux). Only cpus the process may run on are used
+ * (cf. sched_getaffinity(2)), thus cpus excluded by e.g. taskset or the
+ * --cpuset-cpus option for docker/podman create are left out, and nodes
+ * without any usable cpus are dropped. If no topology is found, all
+ * usable cpus are placed in a single node.
+ *
+ * No memory policy is set. The default memory policy on Linux places a
+ * page on the node of the thread first touching it, thus memory
+ * allocated and used by a bound thread is local to its node.
+ */
+class NumaTopology {
+public:
+    using CpuList = std::vector<uint32_t>;
+
+    /*
+     * Binds the current thread to the given cpus for the lifetime of
+     * this object, restoring the previous cpu affinity afterwards.
+     */
+    class BindGuard {
+        CpuList _saved;
+        bool    _bound;
+    public:
+        explicit BindGuard(const CpuList& cpus);
+        BindGuard(const BindGuard&) = delete;
+        BindGuard& operator=(const BindGuard&) = delete;
+        ~BindGuard();
+        bool bound() const noexcept { return _bound; }
+    };
+
+private:
+    std::vector<CpuList>  _nodes;       // usable cpus per node, in ascending order
+    std::vector<uint32_t> _cpu_to_node; // indexed by cpu, only valid for usable cpus
+
+public:
+    NumaTopology();
+    NumaTopology(const std::string& node_path, const CpuList& usable_cpus);
+    ~NumaTopology();
+    size_t num_nodes() const noexcept { return _nodes.size(); }
+    const CpuList& cpus(size_t node) const noexcept { return _nodes[node]; }
+    // Returns 0 for cpus not in the topology.
+    size_t node_of_cpu(uint32_t cpu) const noexcept;
+    // Returns the node of the cpu the current thread is running on.
+    size_t current_node() const noexcept;
+
+    // Parses cpu lists on the format used by sysfs, e.g. "0-3,8,10-11".
+    static CpuList parse_cpu_list(const std::string& str);
+    // Returns the cpus the current thread may run on.
+    static CpuList current_affinity();
+    static bool bind_current_thread(const CpuList& cpus);
+    // Wraps an init function to bind the thread to the given cpus before running it.
+    static Runnable::init_fun_t wrap(Runnable::init_fun_t init, CpuList cpus);
+};
+
+}
@@ -38,6 +38,77 @@ vespalib::string escape(vespalib::stringref str) {
     return result;
 }
 
+bool is_word_char(char c) {
+    return (((c >= 'a') && (c <= 'z')) ||
+            ((c >= 'A') && (c <= 'Z')) ||
+            ((c >= '0') && (c <= '9')));
+}
+
+// Remove the last (possibly multi-byte utf8) character
+void pop_last_char(vespalib::string &str) {
+    while (!str.empty() && ((static_cast<unsigned char>(str[str.size() - 1]) & 0xc0) == 0x80)) {
+        str.resize(str.size() - 1);
+    }
+    if (!str.empty()) {
+        str.resize(str.size() - 1);
+    }
+}
+
+// Skip past the end of a character class, pos is after the opening '['
+const char *skip_char_class(const char *pos, const char *end) {
+    if ((pos < end) && (*pos == '^')) {
+        ++pos;
+    }
+    if ((pos < end) && (*pos == ']')) {
+        ++pos;
+    }
+    while (pos < end) {
+        char c = *pos++;
+        if (c == '\\') {
+            if (pos < end) {
+                ++pos;
+            }
+        } else if ((c == '[') && (pos < end) && (*pos == ':')) {
+            auto posix_end = vespalib::stringref(pos, end - pos).find(":]"); // e.g. [[:alpha:]]
+            pos = (posix_end != vespalib::stringref::npos) ? (pos + posix_end + 2) : end;
+        } else if (c == ']') {
+            break;
+        }
+    }
+    return pos;
+}
+
+// Skip past the end of a group, pos is after the opening '('
+const char *skip_group(const char *pos, const char *end) {
+    int depth = 1;
+    while ((pos < end) && (depth > 0)) {
+        char c = *pos++;
+        if (c == '\\') {
+            if (pos < end) {
+                ++pos;
+            }
+        } else if (c == '[') {
+            pos = skip_char_class(pos, end);
+        } else if (c == '(') {
+            ++depth;
+        } else if (c == ')') {
+            --depth;
+        }
+    }
+    return pos;
+}
+
+bool is_single_char_escape(char c) {
+    // escapes matching a character class or an empty string, not followed by any payload
+    switch (c) {
+    case 'd': case 'D': case 's': case 'S': case 'w': case 'W':
+    case 'b': case 'B': case 'A': case 'z':
+        return true;
+    default:
+        return false;
+    }
+}
+
 } // namespace vespalib::<unnamed>
 
 vespalib::string
@@ -57,6 +128,57 @@ RegexpUtil::get_prefix(vespalib::stringref re)
     return prefix;
 }
 
+std::vector<vespalib::string>
+RegexpUtil::get_required_literals(vespalib::stringref re)
+{
+    std::vector<vespalib::string> literals;
+    if (has_option(re) || (re.find("(?") != re.npos)) {
+        return literals;
+    }
+    vespalib::string literal;
+    auto flush = [&]() {
+        if (!literal.empty()) {
+            literals.push_back(literal);
+            literal.clear();
+        }
+    };
+    const char *end = re.data() + re.size();
+    const char *pos = re.data();
+    while (pos < end) {
+        char c = *pos++;
+        if (c == '\\') {
+            if ((pos < end) && !is_word_char(*pos)) {
+                literal.push_back(*pos++);
+            } else if ((pos < end) && is_single_char_escape(*pos)) {
+                flush(); // character class escape or assertion
+                ++pos;
+            } else {
+                // trailing backslash or escape with payload (e.g. \x41, \101, \pL, \p{Greek}, \Q..\E)
+                return {};
+            }
+        } else if (c == '[') {
+            flush();
+            pos = skip_char_class(pos, end);
+        } else if (c == '(') {
+            flush();
+            pos = skip_group(pos, end);
+        } else if (maybe_none(c)) {
+            pop_last_char(literal);
+            flush();
+            if (c == '{') {
+                auto repeat_end = vespalib::stringref(pos, end - pos).find('}');
+                pos = (repeat_end != vespalib::stringref::npos) ? (pos + repeat_end + 1) : end;
+            }
+        } else if (is_special(c)) {
+            flush();
+        } else {
+            literal.push_back(c);
+        }
+    }
+    flush();
+    return literals;
+}
+
 vespalib::string
 RegexpUtil::make_from_suffix(vespalib::stringref suffix)
 {
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <vespa/vespalib/stllike/string.h>
+#include <vector>
 
 namespace vespalib {
 
@@ -23,6 +24,18 @@ public:
      **/
     static vespalib::string get_prefix(vespalib::stringref re);
 
+    /**
+     * Look at the given regular expression and identify literal
+     * strings that must all be present (as substrings) for a string
+     * to match it. Expressions with alternation or inline flags give
+     * no literals. Also note that this function is simple and might
+     * miss some of the required literals, e.g. those inside groups.
+     *
+     * @param re Regular expression.
+     * @return literals that must be present in matching strings
+     **/
+    static std::vector<vespalib::string> get_required_literals(vespalib::stringref re);
+
     /**
      * Make a regexp matching strings with the given suffix.
      *
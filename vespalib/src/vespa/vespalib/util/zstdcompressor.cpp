@@ -2,7 +2,10 @@
 
 #include "zstdcompressor.h"
 #include <vespa/vespalib/util/alloc.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <zstd.h>
+#include <zdict.h>
 #include <cassert>
 
 using vespalib::alloc::Alloc;
@@ -33,6 +36,63 @@ thread_local std::unique_ptr<DecompressContext> _tlDecompressState;
 
 }
 
+ZStdDictionary::ZStdDictionary(const ConstBufferRef & content)
+    : _content(content.c_str(), content.size()),
+      _id(ZDICT_getDictID(_content.data(), _content.size())),
+      _ddict(nullptr),
+      _lock(),
+      _cdicts()
+{
+    if (_id == 0) {
+        throw IllegalArgumentException(make_string("Not a valid zstd dictionary (%zu bytes)", _content.size()), VESPA_STRLOC);
+    }
+    _ddict = ZSTD_createDDict(_content.data(), _content.size());
+    if (_ddict == nullptr) {
+        throw IllegalArgumentException(make_string("Failed loading zstd dictionary with id %u", _id), VESPA_STRLOC);
+    }
+}
+
+ZStdDictionary::~ZStdDictionary()
+{
+    for (const auto & cdict : _cdicts) {
+        ZSTD_freeCDict(cdict.second);
+    }
+    ZSTD_freeDDict(_ddict);
+}
+
+ZStdDictionary::SP
+ZStdDictionary::train(const ConstBufferRef & samples, const std::vector<size_t> & sampleSizes, size_t maxSize)
+{
+    std::vector<char> dictionary(maxSize);
+    size_t sz = ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(), samples.c_str(),
+                                      sampleSizes.data(), sampleSizes.size());
+    if (ZDICT_isError(sz)) {
+        return SP();
+    }
+    return std::make_shared<ZStdDictionary>(ConstBufferRef(dictionary.data(), sz));
+}
+
+uint32_t
+ZStdDictionary::getFrameDictionaryId(const void * frame, size_t frameLen)
+{
+    return ZSTD_getDictID_fromFrame(frame, frameLen);
+}
+
+const ZSTD_CDict *
+ZStdDictionary::getCompressDictionary(int level) const
+{
+    std::lock_guard guard(_lock);
+    for (const auto & cdict : _cdicts) {
+        if (cdict.first == level) {
+            return cdict.second;
+        }
+    }
+    ZSTD_CDict * cdict = ZSTD_createCDict(_content.data(), _content.size(), level);
+    assert(cdict != nullptr);
+    _cdicts.emplace_back(level, cdict);
+    return cdict;
+}
+
 size_t ZStdCompressor::adjustProcessLen(uint16_t, size_t len)   const { return ZSTD_compressBound(len); }
 
 bool
@@ -42,7 +102,10 @@ ZStdCompressor::process(const CompressionConfig& config, const void * inputV, si
     if ( ! _tlCompressState) {
         _tlCompressState = std::make_unique<CompressContext>();
     }
-    size_t sz = ZSTD_compressCCtx(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen, config.compressionLevel);
+    size_t sz = (_dictionary != nullptr)
+        ? ZSTD_compress_usingCDict(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen,
+                                   _dictionary->getCompressDictionary(config.compressionLevel))
+        : ZSTD_compressCCtx(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen, config.compressionLevel);
     assert( ! ZSTD_isError(sz) );
     outputLenV = sz;
     return ! ZSTD_isError(sz);
@@ -54,7 +117,10 @@ ZStdCompressor::unprocess(const void * inputV, size_t inputLen, void * outputV,
     if ( ! _tlDecompressState) {
         _tlDecompressState = std::make_unique<DecompressContext>();
     }
-    size_t sz = ZSTD_decompressDCtx(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen);
+    size_t sz = (_dictionary != nullptr)
+        ? ZSTD_decompress_usingDDict(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen,
+                                     _dictionary->getDecompressDictionary())
+        : ZSTD_decompressDCtx(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen);
     assert( ! ZSTD_isError(sz) );
     outputLenV = sz;
     return ! ZSTD_isError(sz);
@@ -2,15 +2,75 @@
 #pragma once
 
 #include "compressor.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
 
 namespace vespalib::compression {
 
+/**
+ * A zstd dictionary, typically trained from samples of many small and
+ * similar records. Compressing small buffers with a dictionary gives a
+ * much better ratio than compressing them independently.
+ *
+ * Compressed frames carry the id of the dictionary used, which can be
+ * checked with getFrameDictionaryId() before decompressing.
+ **/
+class ZStdDictionary
+{
+public:
+    using SP = std::shared_ptr<const ZStdDictionary>;
+    /**
+     * Create a dictionary from its serialized content.
+     * Throws IllegalArgumentException if the content is not a valid dictionary.
+     */
+    explicit ZStdDictionary(const ConstBufferRef & content);
+    ZStdDictionary(const ZStdDictionary &) = delete;
+    ZStdDictionary & operator = (const ZStdDictionary &) = delete;
+    ~ZStdDictionary();
+
+    /**
+     * Train a dictionary of at most maxSize bytes from samples stored back to back,
+     * with the size of each sample given by sampleSizes.
+     * Returns an empty pointer if there are too few samples to train from.
+     */
+    static SP train(const ConstBufferRef & samples, const std::vector<size_t> & sampleSizes, size_t maxSize);
+    /**
+     * Returns the id of the dictionary needed to decompress the given frame,
+     * or 0 if no dictionary is needed.
+     */
+    static uint32_t getFrameDictionaryId(const void * frame, size_t frameLen);
+
+    uint32_t getId() const { return _id; }
+    ConstBufferRef getContent() const { return ConstBufferRef(_content.data(), _content.size()); }
+
+    const ZSTD_CDict_s * getCompressDictionary(int level) const;
+    const ZSTD_DDict_s * getDecompressDictionary() const { return _ddict; }
+private:
+    std::string                                             _content;
+    uint32_t                                                _id;
+    ZSTD_DDict_s                                          * _ddict;
+    mutable std::mutex                                      _lock;
+    mutable std::vector<std::pair<int, ZSTD_CDict_s *>>     _cdicts;
+};
+
 class ZStdCompressor : public ICompressor
 {
 public:
+    ZStdCompressor() noexcept : _dictionary(nullptr) { }
+    /**
+     * Compress and decompress using the given dictionary, which must outlive the compressor.
+     */
+    explicit ZStdCompressor(const ZStdDictionary & dictionary) noexcept : _dictionary(&dictionary) { }
     bool process(const CompressionConfig& config, const void * input, size_t inputLen, void * output, size_t & outputLen) override;
     bool unprocess(const void * input, size_t inputLen, void * output, size_t & outputLen) override;
     size_t adjustProcessLen(uint16_t options, size_t len)   const override;
+private:
+    const ZStdDictionary * _dictionary;
 };
 
 }